@@ -26,6 +26,7 @@
  * Section:  Includes                                                       
  ************************************************************************/
 #include <stdint.h>
+#include <stdbool.h>
 #include "system.h"
 #include "driver/spi/drv_spi.h"
 
@@ -41,6 +42,37 @@
     #define EEPROM_CMD_RDSR     (unsigned)0x05
     #define EEPROM_CMD_WRSR     (unsigned)0x01
 
+/************************************************************************
+* Write buffer configuration
+*
+* DRV_NVM_MCHP25LC256_BufferedWrite() keeps the data in RAM page buffers
+* that are programmed by DRV_NVM_MCHP25LC256_Tasks(). Override the
+* defaults in system_config.h if needed.
+************************************************************************/
+#ifndef DRV_NVM_MCHP25LC256_CONFIG_WRITE_BUFFER_PAGES
+    // number of pages that can wait in the write buffer
+    #define DRV_NVM_MCHP25LC256_CONFIG_WRITE_BUFFER_PAGES   2
+#endif
+
+#ifndef DRV_NVM_MCHP25LC256_CONFIG_WRITE_RETRIES
+    // number of times a buffered write is repeated after a failed verification
+    #define DRV_NVM_MCHP25LC256_CONFIG_WRITE_RETRIES        2
+#endif
+
+/************************************************************************
+* Enumeration DRV_NVM_MCHP25LC256_WRITE_STATUS
+*
+* Overview: state of the write buffer returned by
+*           DRV_NVM_MCHP25LC256_WriteStatusGet().
+*
+************************************************************************/
+typedef enum
+{
+    DRV_NVM_MCHP25LC256_WRITE_IDLE = 0,     // every buffered byte was programmed
+    DRV_NVM_MCHP25LC256_WRITE_BUSY,         // buffered data is being programmed
+    DRV_NVM_MCHP25LC256_WRITE_ERROR         // a buffered write failed the verification
+} DRV_NVM_MCHP25LC256_WRITE_STATUS;
+
 /************************************************************************
 * Structure STATREG and union _MCHP25LC256Status_                            
 *                                                                       
@@ -204,6 +236,98 @@ union _MCHP25LC256Status_ DRV_NVM_MCHP25LC256_ReadStatusRegister(void);
 ******************************************************************************/
 void DRV_NVM_MCHP25LC256_WriteStatusRegister(uint8_t newStatus);
 
+/******************************************************************************
+  Function:
+    uint8_t DRV_NVM_MCHP25LC256_BufferedWrite(    uint16_t address,
+                                                  uint8_t *pData,
+                                                  uint16_t nCount )
+
+  Summary:
+    Queues an array of bytes to be written to a specified address.
+
+  Description:
+    This routine copies the array to the write buffer and returns without
+    waiting for the device. Bytes written to the same 64 byte page are
+    merged and programmed with one write cycle by DRV_NVM_MCHP25LC256_Tasks().
+    DRV_NVM_MCHP25LC256_Read() returns the buffered data. The routine
+    blocks only when all DRV_NVM_MCHP25LC256_CONFIG_WRITE_BUFFER_PAGES
+    buffers hold other pages.
+
+    The buffer is not interrupt safe; call the buffered routines and
+    DRV_NVM_MCHP25LC256_Tasks() from the same context.
+
+  Parameters:
+    address - starting address of the array to be written
+    pData   - pointer to the source of the array
+    nCount  - specifies the number of bytes to be written
+
+  Returns:
+    1 - the data was queued
+******************************************************************************/
+uint8_t DRV_NVM_MCHP25LC256_BufferedWrite(uint16_t address, uint8_t *pData, uint16_t nCount);
+
+/******************************************************************************
+  Function:
+    void DRV_NVM_MCHP25LC256_Tasks( void )
+
+  Summary:
+    Programs the write buffer to the device.
+
+  Description:
+    This routine must be called periodically from the main loop while
+    DRV_NVM_MCHP25LC256_BufferedWrite() is used. It never waits for the
+    end of a write cycle; each call reads the status register once and
+    starts the next write cycle when the device is ready.
+
+  Parameters:
+    None
+
+  Returns:
+    None
+******************************************************************************/
+void DRV_NVM_MCHP25LC256_Tasks(void);
+
+/******************************************************************************
+  Function:
+    DRV_NVM_MCHP25LC256_WRITE_STATUS DRV_NVM_MCHP25LC256_WriteStatusGet( void )
+
+  Summary:
+    Returns the state of the write buffer.
+
+  Description:
+    This routine reports if buffered data is still waiting to be
+    programmed. A verification error is reported once and then cleared.
+
+  Parameters:
+    None
+
+  Returns:
+    DRV_NVM_MCHP25LC256_WRITE_IDLE  - every buffered byte was programmed
+    DRV_NVM_MCHP25LC256_WRITE_BUSY  - buffered data is being programmed
+    DRV_NVM_MCHP25LC256_WRITE_ERROR - a run of bytes failed the verification
+******************************************************************************/
+DRV_NVM_MCHP25LC256_WRITE_STATUS DRV_NVM_MCHP25LC256_WriteStatusGet(void);
+
+/******************************************************************************
+  Function:
+    void DRV_NVM_MCHP25LC256_Flush( void )
+
+  Summary:
+    Programs the whole write buffer.
+
+  Description:
+    This routine blocks until every buffered byte is programmed. It is
+    called by DRV_NVM_MCHP25LC256_Write() so that the direct write is not
+    overwritten by older buffered data, and should be called before the
+    device is powered down.
+
+  Parameters:
+    None
+
+  Returns:
+    None
+******************************************************************************/
+void DRV_NVM_MCHP25LC256_Flush(void);
 
 #endif //_MCHP25LC256_EEPROM_H
 
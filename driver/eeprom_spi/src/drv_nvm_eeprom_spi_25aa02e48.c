@@ -21,6 +21,8 @@
  *******************************************************************/
  
 #include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
 #include "system.h"
 #include "driver/eeprom_spi/drv_nvm_eeprom_spi_25aa02e48.h"
 
@@ -57,6 +59,48 @@ static DRV_SPI_INIT_DATA eepromInitData;
                                                 data = DRV_SPI_Get(ch); \
                                             }
 
+/************************************************************************
+* Write buffer
+*
+* Overview: DRV_NVM_MCHP25AA02E48_BufferedWrite() stores the data in one of
+*           the page buffers and marks the bytes as dirty. Writes to the
+*           same page are merged into the same buffer. DRV_NVM_MCHP25AA02E48_Tasks()
+*           programs each run of consecutive dirty bytes with one write
+*           cycle and polls the WIP bit without waiting for it.
+************************************************************************/
+typedef struct
+{
+    uint8_t     page;                               // address of the first byte of the page
+    uint8_t     data[EEPROM_PAGE_SIZE];             // new contents of the page
+    uint8_t     dirty[EEPROM_PAGE_SIZE / 8];        // one bit per byte waiting to be programmed
+    bool        used;                               // the buffer holds dirty bytes
+} MCHP25AA02E48_PAGE_BUFFER;
+
+typedef enum
+{
+    MCHP25AA02E48_TASK_IDLE = 0,                      // no write cycle in progress
+    MCHP25AA02E48_TASK_WRITE_WAIT                     // waiting for the end of the write cycle
+} MCHP25AA02E48_TASK_STATE;
+
+typedef struct
+{
+    MCHP25AA02E48_TASK_STATE  state;
+    uint8_t                 address;                // address of the run being programmed
+    uint8_t                 data[EEPROM_PAGE_SIZE]; // copy of the run for verification and retry
+    uint8_t                 count;                  // number of bytes in the run
+    uint8_t                 retry;                  // remaining retries of the run
+    bool                    error;                  // a run failed the verification
+} MCHP25AA02E48_TASK;
+
+static MCHP25AA02E48_PAGE_BUFFER  eepromPageBuffer[DRV_NVM_MCHP25AA02E48_CONFIG_WRITE_BUFFER_PAGES];
+static MCHP25AA02E48_TASK         eepromTask;
+
+// internal functions
+static void    DRV_NVM_MCHP25AA02E48_PageProgram(uint8_t address, uint8_t *pData, uint16_t nCount);
+static uint8_t DRV_NVM_MCHP25AA02E48_Verify(uint8_t address, uint8_t *pData, uint16_t nCount);
+static bool    DRV_NVM_MCHP25AA02E48_RunStart(void);
+
+
 /******************************************************************************
   Function:
     void DRV_NVM_MCHP25AA02E48_Initialize( const SYS_MODULE_INDEX index,
@@ -84,6 +128,9 @@ void DRV_NVM_MCHP25AA02E48_Initialize(DRV_SPI_INIT_DATA *pInitData)
     // initialize the SPI channel to be used
     SPIINITIALIZE(pInitData->channel, pInitData);
     memcpy(&eepromInitData, pInitData, sizeof(DRV_SPI_INIT_DATA));
+
+    memset(eepromPageBuffer, 0, sizeof(eepromPageBuffer));
+    memset(&eepromTask, 0, sizeof(eepromTask));
 }
 
 /******************************************************************************
@@ -108,7 +155,6 @@ void DRV_NVM_MCHP25AA02E48_WriteEnable(void)
     MCHP25AA02E48CSLow();
     PUTSPIBYTE(eepromInitData.channel, EEPROM_CMD_WREN);
     MCHP25AA02E48CSHigh();
-    
 }
 
 /******************************************************************************
@@ -177,8 +223,8 @@ union _MCHP25AA02E48Status_ DRV_NVM_MCHP25AA02E48_ReadStatusRegister(void)
 /******************************************************************************
   Function:
     uint8_t DRV_NVM_MCHP25AA02E48_Write(    uint8_t address,
-                                            uint8_t *pData, 
-                                            uint16_t nCount )
+                                          uint8_t *pData, 
+                                          uint16_t nCount )
 
   Summary:
     Writes an array of bytes to a specified address.
@@ -199,81 +245,126 @@ union _MCHP25AA02E48Status_ DRV_NVM_MCHP25AA02E48_ReadStatusRegister(void)
 ******************************************************************************/
 uint8_t DRV_NVM_MCHP25AA02E48_Write(uint8_t address, uint8_t *pData, uint16_t nCount)
 {
-    uint8_t  addr;
-    uint8_t  *pD, temp;
-    uint16_t counter, ret;
+    uint16_t    counter, sendCount;
+    uint8_t     ret;
 
-    addr = address;
-    pD = pData;
+    // buffered data is older than this write, program it first
+    DRV_NVM_MCHP25AA02E48_Flush();
 
-    // WRITE
-    DRV_NVM_MCHP25AA02E48_WriteEnable();
-    
     while(!SPILOCK(eepromInitData.channel));
 
     DRV_SPI_Initialize(eepromInitData.channel, (DRV_SPI_INIT_DATA *)&eepromInitData);
 
+    // WRITE
+    for(counter = 0; counter < nCount; counter += sendCount)
+    {
+        // a write command can not cross a page boundary
+        sendCount = EEPROM_PAGE_SIZE - ((uint8_t)(address + counter) & EEPROM_PAGE_MASK);
+        if(sendCount > (nCount - counter))
+            sendCount = nCount - counter;
+
+        DRV_NVM_MCHP25AA02E48_PageProgram(address + counter, pData + counter, sendCount);
+
+        // Wait for completion of the write operation
+        while(ReadStatusRegister().Bits.WIP);
+    }
+
+    // VERIFY
+    ret = DRV_NVM_MCHP25AA02E48_Verify(address, pData, nCount);
+
+    SPIUNLOCK(eepromInitData.channel);
+   
+    return (ret);
+}
+
+/******************************************************************************
+  Function:
+    static void DRV_NVM_MCHP25AA02E48_PageProgram( uint8_t address,
+                                                 uint8_t *pData,
+                                                 uint16_t nCount )
+
+  Summary:
+    Starts the write cycle of bytes inside one page.
+
+  Description:
+    This is an internal function called within the module. It sends the
+    write enable and the write command followed by the data and returns
+    without waiting for the end of the write cycle. The caller holds the
+    SPI lock and makes sure the array does not cross a page boundary.
+
+  Parameters:
+    address - starting address of the array to be written
+    pData   - pointer to the source of the array
+    nCount  - specifies the number of bytes to be written
+
+  Returns:
+    None
+******************************************************************************/
+static void DRV_NVM_MCHP25AA02E48_PageProgram(uint8_t address, uint8_t *pData, uint16_t nCount)
+{
+    DRV_NVM_MCHP25AA02E48_WriteEnable();
+
     MCHP25AA02E48CSLow();
 
     PUTSPIBYTE(eepromInitData.channel, EEPROM_CMD_WRITE);
-    PUTSPIBYTE(eepromInitData.channel, addr);
+    PUTSPIBYTE(eepromInitData.channel, address);
 
-    for(counter = 0; counter < nCount; counter++)
+    while(nCount--)
     {
-        PUTSPIBYTE(eepromInitData.channel, *pD++);
-        addr++;
+        PUTSPIBYTE(eepromInitData.channel, *pData++);
+    }
 
-        // check for page rollover
-        if((addr & EEPROM_PAGE_MASK) == 0)
-        {
-            MCHP25AA02E48CSHigh();
+    MCHP25AA02E48CSHigh();
+}
 
-            // Wait for completion of the write operation
-            while(ReadStatusRegister().Bits.WIP);
+/******************************************************************************
+  Function:
+    static uint8_t DRV_NVM_MCHP25AA02E48_Verify( uint8_t address,
+                                               uint8_t *pData,
+                                               uint16_t nCount )
 
-            // Start writing of the next page
-            DRV_NVM_MCHP25AA02E48_WriteEnable();
-            MCHP25AA02E48CSLow();
+  Summary:
+    Compares the memory contents with an array.
 
-            PUTSPIBYTE(eepromInitData.channel, EEPROM_CMD_WRITE);
-            PUTSPIBYTE(eepromInitData.channel, addr);
-        }
-    }
+  Description:
+    This is an internal function called within the module after the
+    end of a write cycle. The caller holds the SPI lock.
 
-    MCHP25AA02E48CSHigh();
+  Parameters:
+    address - starting address of the array to be compared
+    pData   - pointer to the expected data
+    nCount  - specifies the number of bytes to be compared
 
-    // Wait for write end
-    while(ReadStatusRegister().Bits.WIP);
+  Returns:
+    1 - if the memory holds the expected data
+    0 - if the memory contents differ
+******************************************************************************/
+static uint8_t DRV_NVM_MCHP25AA02E48_Verify(uint8_t address, uint8_t *pData, uint16_t nCount)
+{
+    uint8_t     temp, ret = 1;
 
-    // VERIFY
-    ret = 1;
-    for(counter = 0; counter < nCount; counter++)
+    MCHP25AA02E48CSLow();
+
+    PUTSPIBYTE(eepromInitData.channel, EEPROM_CMD_READ);
+    PUTSPIBYTE(eepromInitData.channel, address);
+
+    while(nCount--)
     {
-        MCHP25AA02E48CSLow();
-        PUTSPIBYTE(eepromInitData.channel, EEPROM_CMD_READ);
-        PUTSPIBYTE(eepromInitData.channel, addr);
         GETSPIBYTE(eepromInitData.channel, temp);
-        MCHP25AA02E48CSHigh();
-
-        if(*pData != temp)
-        {
+        if(*pData++ != temp)
             ret = 0;
-            break;
-        }
-        pData++;
-        address++;
     }
-   
-   SPIUNLOCK(eepromInitData.channel);
-   
+
+    MCHP25AA02E48CSHigh();
+
     return (ret);
 }
 
 /******************************************************************************
   Function:
-    void DRV_NVM_MCHP25AA02E48_Read(    uint8_t address, 
-                                        uint8_t *pData, 
-                                        uint16_t nCount )
+    void DRV_NVM_MCHP25AA02E48_Read(  uint8_t address, 
+                                    uint8_t *pData, 
+                                    uint16_t nCount )
 
   Summary:
     Reads an array of bytes from the specified address.
@@ -293,22 +384,49 @@ uint8_t DRV_NVM_MCHP25AA02E48_Write(uint8_t address, uint8_t *pData, uint16_t nC
 ******************************************************************************/
 void DRV_NVM_MCHP25AA02E48_Read(uint8_t address, uint8_t *pData, uint16_t nCount)
 {
+    uint8_t     *pD = pData;
+    uint16_t    counter, offset;
+    uint8_t     index;
+
     while(!SPILOCK(eepromInitData.channel));
 
     DRV_SPI_Initialize(eepromInitData.channel, (DRV_SPI_INIT_DATA *)&eepromInitData);
 
+    // the device ignores a read during a buffered write cycle
+    if(eepromTask.state == MCHP25AA02E48_TASK_WRITE_WAIT)
+    {
+        while(ReadStatusRegister().Bits.WIP);
+    }
+    
     MCHP25AA02E48CSLow();
 
     PUTSPIBYTE(eepromInitData.channel, EEPROM_CMD_READ);
     PUTSPIBYTE(eepromInitData.channel, address);
     
-    while(nCount--)
+    for(counter = 0; counter < nCount; counter++)
     {
-        GETSPIBYTE(eepromInitData.channel, *pData++);
+        GETSPIBYTE(eepromInitData.channel, *pD++);
     }
 
     MCHP25AA02E48CSHigh();
     SPIUNLOCK(eepromInitData.channel);
+
+    // replace the bytes that are still waiting in the write buffer
+    for(index = 0; index < DRV_NVM_MCHP25AA02E48_CONFIG_WRITE_BUFFER_PAGES; index++)
+    {
+        if(eepromPageBuffer[index].used == false)
+            continue;
+
+        for(counter = 0; counter < nCount; counter++)
+        {
+            offset = (uint8_t)((uint8_t)(address + counter) - eepromPageBuffer[index].page);
+            if(offset >= EEPROM_PAGE_SIZE)
+                continue;
+
+            if(eepromPageBuffer[index].dirty[offset >> 3] & (1 << (offset & 7)))
+                pData[counter] = eepromPageBuffer[index].data[offset];
+        }
+    }
 }
 
 /******************************************************************************
@@ -331,6 +449,8 @@ void DRV_NVM_MCHP25AA02E48_Read(uint8_t address, uint8_t *pData, uint16_t nCount
 ******************************************************************************/
 void DRV_NVM_MCHP25AA02E48_WriteStatusRegister(uint8_t newStatus)
 {
+    // the status register can not be written during a write cycle
+    DRV_NVM_MCHP25AA02E48_Flush();
 
     while(!SPILOCK(eepromInitData.channel));
     
@@ -354,6 +474,297 @@ void DRV_NVM_MCHP25AA02E48_WriteStatusRegister(uint8_t newStatus)
     SPIUNLOCK(eepromInitData.channel);
 }
 
+/******************************************************************************
+  Function:
+    uint8_t DRV_NVM_MCHP25AA02E48_BufferedWrite(    uint8_t address,
+                                                  uint8_t *pData,
+                                                  uint16_t nCount )
+
+  Summary:
+    Queues an array of bytes to be written to a specified address.
+
+  Description:
+    This routine copies the array to the write buffer and returns without
+    accessing the device. Bytes of the same page are merged, so small
+    writes of adjacent records are programmed with one write cycle by
+    DRV_NVM_MCHP25AA02E48_Tasks(). When every page buffer holds another
+    page, this routine runs DRV_NVM_MCHP25AA02E48_Tasks() until a buffer
+    is released.
+
+  Parameters:
+    address - starting address of the array to be written
+    pData   - pointer to the source of the array
+    nCount  - specifies the number of bytes to be written
+
+  Returns:
+    1 - the data was queued
+******************************************************************************/
+uint8_t DRV_NVM_MCHP25AA02E48_BufferedWrite(uint8_t address, uint8_t *pData, uint16_t nCount)
+{
+    MCHP25AA02E48_PAGE_BUFFER *pBuffer;
+    uint8_t                 page;
+    uint16_t                offset;
+    uint8_t                 index;
+
+    while(nCount)
+    {
+        page = address & ~EEPROM_PAGE_MASK;
+
+        // find the buffer of the page, or a free one
+        for(;;)
+        {
+            pBuffer = NULL;
+            for(index = 0; index < DRV_NVM_MCHP25AA02E48_CONFIG_WRITE_BUFFER_PAGES; index++)
+            {
+                if(eepromPageBuffer[index].used == true)
+                {
+                    if(eepromPageBuffer[index].page == page)
+                    {
+                        pBuffer = &eepromPageBuffer[index];
+                        break;
+                    }
+                }
+                else if(pBuffer == NULL)
+                {
+                    pBuffer = &eepromPageBuffer[index];
+                }
+            }
+
+            if(pBuffer != NULL)
+                break;
+
+            DRV_NVM_MCHP25AA02E48_Tasks();
+        }
+
+        if(pBuffer->used == false)
+        {
+            pBuffer->page = page;
+            pBuffer->used = true;
+        }
+
+        // copy the bytes of this page
+        for(offset = address & EEPROM_PAGE_MASK; (offset < EEPROM_PAGE_SIZE) && nCount; offset++, nCount--)
+        {
+            pBuffer->data[offset] = *pData++;
+            pBuffer->dirty[offset >> 3] |= (1 << (offset & 7));
+            address++;
+        }
+    }
+
+    return (1);
+}
+
+/******************************************************************************
+  Function:
+    static bool DRV_NVM_MCHP25AA02E48_RunStart( void )
+
+  Summary:
+    Starts the write cycle of the next run of dirty bytes.
+
+  Description:
+    This is an internal function called within the module. It takes the
+    first run of consecutive dirty bytes of the first used page buffer,
+    clears their dirty bits and starts the write cycle. Bytes written
+    again while the write cycle is in progress are marked dirty again and
+    programmed by a later cycle. The caller holds the SPI lock.
+
+  Parameters:
+    None
+
+  Returns:
+    true  - a write cycle was started
+    false - the write buffer is empty
+******************************************************************************/
+static bool DRV_NVM_MCHP25AA02E48_RunStart(void)
+{
+    MCHP25AA02E48_PAGE_BUFFER *pBuffer;
+    uint16_t                offset;
+    uint8_t                 index;
+
+    for(index = 0; index < DRV_NVM_MCHP25AA02E48_CONFIG_WRITE_BUFFER_PAGES; index++)
+    {
+        pBuffer = &eepromPageBuffer[index];
+
+        if(pBuffer->used == false)
+            continue;
+
+        // skip the clean bytes
+        for(offset = 0; offset < EEPROM_PAGE_SIZE; offset++)
+        {
+            if(pBuffer->dirty[offset >> 3] & (1 << (offset & 7)))
+                break;
+        }
+
+        eepromTask.address = pBuffer->page + offset;
+        eepromTask.count = 0;
+
+        // take the run of dirty bytes
+        for(; offset < EEPROM_PAGE_SIZE; offset++)
+        {
+            if((pBuffer->dirty[offset >> 3] & (1 << (offset & 7))) == 0)
+                break;
+
+            pBuffer->dirty[offset >> 3] &= ~(1 << (offset & 7));
+            eepromTask.data[eepromTask.count++] = pBuffer->data[offset];
+        }
+
+        // release the buffer when no dirty byte is left
+        pBuffer->used = false;
+        for(offset = 0; offset < (EEPROM_PAGE_SIZE / 8); offset++)
+        {
+            if(pBuffer->dirty[offset])
+            {
+                pBuffer->used = true;
+                break;
+            }
+        }
+
+        if(eepromTask.count == 0)
+            continue;
+
+        DRV_NVM_MCHP25AA02E48_PageProgram(eepromTask.address, eepromTask.data, eepromTask.count);
+        eepromTask.retry = DRV_NVM_MCHP25AA02E48_CONFIG_WRITE_RETRIES;
+        eepromTask.state = MCHP25AA02E48_TASK_WRITE_WAIT;
+        return (true);
+    }
+
+    return (false);
+}
+
+/******************************************************************************
+  Function:
+    void DRV_NVM_MCHP25AA02E48_Tasks( void )
+
+  Summary:
+    Programs the write buffer to the device.
+
+  Description:
+    This routine must be called periodically from the main loop. Each call
+    checks the WIP bit once; when the device is ready it verifies the last
+    run and starts the write cycle of the next one. It returns immediately
+    when the SPI channel is used by another driver.
+
+  Parameters:
+    None
+
+  Returns:
+    None
+******************************************************************************/
+void DRV_NVM_MCHP25AA02E48_Tasks(void)
+{
+    if(!SPILOCK(eepromInitData.channel))
+        return;
+
+    DRV_SPI_Initialize(eepromInitData.channel, (DRV_SPI_INIT_DATA *)&eepromInitData);
+
+    switch(eepromTask.state)
+    {
+        case MCHP25AA02E48_TASK_WRITE_WAIT:
+            if(ReadStatusRegister().Bits.WIP)
+                break;
+
+            if(DRV_NVM_MCHP25AA02E48_Verify(eepromTask.address, eepromTask.data, eepromTask.count) == 0)
+            {
+                if(eepromTask.retry)
+                {
+                    eepromTask.retry--;
+                    DRV_NVM_MCHP25AA02E48_PageProgram(eepromTask.address, eepromTask.data, eepromTask.count);
+                    break;
+                }
+                eepromTask.error = true;
+            }
+
+            eepromTask.state = MCHP25AA02E48_TASK_IDLE;
+            // fall through
+        case MCHP25AA02E48_TASK_IDLE:
+        default:
+            DRV_NVM_MCHP25AA02E48_RunStart();
+            break;
+    }
+
+    SPIUNLOCK(eepromInitData.channel);
+}
+
+/******************************************************************************
+  Function:
+    DRV_NVM_MCHP25AA02E48_WRITE_STATUS DRV_NVM_MCHP25AA02E48_WriteStatusGet( void )
+
+  Summary:
+    Returns the state of the write buffer.
+
+  Description:
+    This routine reports if buffered data is still waiting to be
+    programmed. A verification error is reported once and then cleared.
+
+  Parameters:
+    None
+
+  Returns:
+    DRV_NVM_MCHP25AA02E48_WRITE_IDLE  - every buffered byte was programmed
+    DRV_NVM_MCHP25AA02E48_WRITE_BUSY  - buffered data is being programmed
+    DRV_NVM_MCHP25AA02E48_WRITE_ERROR - a run of bytes failed the verification
+******************************************************************************/
+DRV_NVM_MCHP25AA02E48_WRITE_STATUS DRV_NVM_MCHP25AA02E48_WriteStatusGet(void)
+{
+    uint8_t index;
+
+    if(eepromTask.state != MCHP25AA02E48_TASK_IDLE)
+        return (DRV_NVM_MCHP25AA02E48_WRITE_BUSY);
+
+    for(index = 0; index < DRV_NVM_MCHP25AA02E48_CONFIG_WRITE_BUFFER_PAGES; index++)
+    {
+        if(eepromPageBuffer[index].used == true)
+            return (DRV_NVM_MCHP25AA02E48_WRITE_BUSY);
+    }
+
+    if(eepromTask.error == true)
+    {
+        eepromTask.error = false;
+        return (DRV_NVM_MCHP25AA02E48_WRITE_ERROR);
+    }
+
+    return (DRV_NVM_MCHP25AA02E48_WRITE_IDLE);
+}
+
+/******************************************************************************
+  Function:
+    void DRV_NVM_MCHP25AA02E48_Flush( void )
+
+  Summary:
+    Programs the whole write buffer.
+
+  Description:
+    This routine runs DRV_NVM_MCHP25AA02E48_Tasks() until every buffered
+    byte is programmed. It blocks for one write cycle per run of bytes.
+
+  Parameters:
+    None
+
+  Returns:
+    None
+******************************************************************************/
+void DRV_NVM_MCHP25AA02E48_Flush(void)
+{
+    uint8_t index;
+
+    for(;;)
+    {
+        if(eepromTask.state == MCHP25AA02E48_TASK_IDLE)
+        {
+            for(index = 0; index < DRV_NVM_MCHP25AA02E48_CONFIG_WRITE_BUFFER_PAGES; index++)
+            {
+                if(eepromPageBuffer[index].used == true)
+                    break;
+            }
+
+            if(index == DRV_NVM_MCHP25AA02E48_CONFIG_WRITE_BUFFER_PAGES)
+                return;
+        }
+
+        DRV_NVM_MCHP25AA02E48_Tasks();
+    }
+}
+
 /******************************************************************************
   Function:
     void MCHP25AA02E48GetEUI48NodeAddress(uint8_t *eui48NodeAddr)
@@ -0,0 +1,57 @@
+/******************************************************************************
+*
+*                        Microchip File I/O Library
+*
+******************************************************************************
+* FileName:           flash_ftl_config.h
+* Processor:          PIC24/dsPIC30/dsPIC33/PIC32
+* Compiler:           XC16/XC32
+* Company:            Microchip Technology, Inc.
+*
+* Software License Agreement
+*
+* The software supplied herewith by Microchip Technology Incorporated
+* (the "Company") for its PICmicro(R) Microcontroller is intended and
+* supplied to you, the Company's customer, for use solely and
+* exclusively on Microchip PICmicro Microcontroller products. The
+* software is owned by the Company and/or its supplier, and is
+* protected under applicable copyright laws. All rights are reserved.
+* Any use in violation of the foregoing restrictions may subject the
+* user to criminal sanctions under applicable laws, as well as to
+* civil liability for the breach of the terms and conditions of this
+* license.
+*
+* THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+* WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+* TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+* IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+* CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+*
+********************************************************************/
+
+//-------------Flash translation layer geometry---------------------------------
+// Size of the erase unit of the serial flash in bytes.  This is the size erased
+// by the SectorErase function of the driver/nvm driver in use (4 KB for the
+// SST25VF016/SST25VF064, 64 KB for the M25P80).
+#define DRV_FILEIO_CONFIG_FTL_BLOCK_SIZE            4096
+
+// Number of erase blocks managed by the translation layer.  The RAM used by the
+// mapping table grows with this value (two bytes per logical sector, six bytes
+// per erase block).
+#define DRV_FILEIO_CONFIG_FTL_BLOCK_COUNT           256
+
+// Number of erase blocks kept in reserve for garbage collection.  They are not
+// part of the reported capacity.  Must be at least 2.
+#define DRV_FILEIO_CONFIG_FTL_SPARE_BLOCKS          4
+
+//-------------Garbage collection and wear leveling-----------------------------
+// FILEIO_FTL_Tasks starts collecting in the background when fewer free blocks
+// than this value are available.  Writes collect in the foreground only when
+// the free block count drops below 2.
+#define DRV_FILEIO_CONFIG_FTL_GC_THRESHOLD          3
+
+// When the erase counts of the most and the least worn blocks differ by more
+// than this value, the block holding the coldest data is collected so that it
+// returns to the free pool (static wear leveling).
+#define DRV_FILEIO_CONFIG_FTL_WEAR_THRESHOLD        64
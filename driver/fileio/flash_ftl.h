@@ -0,0 +1,413 @@
+/******************************************************************************
+* Software License Agreement
+*
+* The software supplied herewith by Microchip Technology Incorporated
+* (the "Company") for its PICmicro(R) Microcontroller is intended and
+* supplied to you, the Company's customer, for use solely and
+* exclusively on Microchip PICmicro Microcontroller products. The
+* software is owned by the Company and/or its supplier, and is
+* protected under applicable copyright laws. All rights are reserved.
+* Any use in violation of the foregoing restrictions may subject the
+* user to criminal sanctions under applicable laws, as well as to
+* civil liability for the breach of the terms and conditions of this
+* license.
+*
+* THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+* WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+* TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+* IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+* CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+*
+********************************************************************/
+
+#ifndef FLASH_FTL_H
+#define FLASH_FTL_H
+
+#include "fileio_config.h"
+#include <fileio/fileio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*****************************************************************************/
+/*                              Configuration                                */
+/*****************************************************************************/
+
+#if !defined(DRV_FILEIO_CONFIG_FTL_BLOCK_SIZE)
+    #define DRV_FILEIO_CONFIG_FTL_BLOCK_SIZE        4096
+#endif
+
+#if !defined(DRV_FILEIO_CONFIG_FTL_BLOCK_COUNT)
+    #define DRV_FILEIO_CONFIG_FTL_BLOCK_COUNT       256
+#endif
+
+#if !defined(DRV_FILEIO_CONFIG_FTL_SPARE_BLOCKS)
+    #define DRV_FILEIO_CONFIG_FTL_SPARE_BLOCKS      4
+#endif
+
+#if !defined(DRV_FILEIO_CONFIG_FTL_GC_THRESHOLD)
+    #define DRV_FILEIO_CONFIG_FTL_GC_THRESHOLD      3
+#endif
+
+#if !defined(DRV_FILEIO_CONFIG_FTL_WEAR_THRESHOLD)
+    #define DRV_FILEIO_CONFIG_FTL_WEAR_THRESHOLD    64
+#endif
+
+// Every erase block holds one header slot followed by data slots.  The header
+// slot stores the block signature, the erase count and one tag per data slot.
+#define DRV_FILEIO_FTL_SLOTS_PER_BLOCK      (DRV_FILEIO_CONFIG_FTL_BLOCK_SIZE / FILEIO_CONFIG_MEDIA_SECTOR_SIZE)
+#define DRV_FILEIO_FTL_DATA_SLOTS_PER_BLOCK (DRV_FILEIO_FTL_SLOTS_PER_BLOCK - 1)
+#define DRV_FILEIO_FTL_SECTOR_COUNT         ((uint32_t)(DRV_FILEIO_CONFIG_FTL_BLOCK_COUNT - DRV_FILEIO_CONFIG_FTL_SPARE_BLOCKS) * DRV_FILEIO_FTL_DATA_SLOTS_PER_BLOCK)
+
+//---------------------------------------------------------
+//Do some build time error checking
+//---------------------------------------------------------
+#if (DRV_FILEIO_CONFIG_FTL_BLOCK_SIZE % FILEIO_CONFIG_MEDIA_SECTOR_SIZE)
+    #error "The FTL block size must be a multiple of the media sector size."
+#endif
+
+#if (DRV_FILEIO_FTL_SLOTS_PER_BLOCK < 2)
+    #error "The FTL block size must hold at least two media sectors."
+#endif
+
+#if (DRV_FILEIO_CONFIG_FTL_SPARE_BLOCKS < 2)
+    #error "The FTL needs at least two spare blocks for garbage collection."
+#endif
+
+#if ((8 + (DRV_FILEIO_FTL_DATA_SLOTS_PER_BLOCK * 12)) > FILEIO_CONFIG_MEDIA_SECTOR_SIZE)
+    #error "The FTL block header does not fit into one media sector.  Reduce DRV_FILEIO_CONFIG_FTL_BLOCK_SIZE."
+#endif
+
+#if ((DRV_FILEIO_CONFIG_FTL_BLOCK_COUNT * DRV_FILEIO_FTL_SLOTS_PER_BLOCK) >= 0xFFFF)
+    #error "The FTL mapping table uses 16-bit entries.  Reduce DRV_FILEIO_CONFIG_FTL_BLOCK_COUNT."
+#endif
+
+/*****************************************************************************/
+/*                         Function pointer types                            */
+/*****************************************************************************/
+
+/*************************************************************************************
+    Function:
+        typedef void (*FILEIO_FTL_FlashRead)(uint32_t address, uint8_t *pData, uint16_t nCount)
+
+    Summary:
+        Prototype of the flash read function of the serial flash driver.
+
+    Description:
+        Matches DRV_NVM_SST25VF064_Read, DRV_NVM_SST25VF016_Read,
+        DRV_NVM_M25P80_Read and DRV_NVM_FLASH_SIM_Read.
+  ***********************************************************************************/
+typedef void (*FILEIO_FTL_FlashRead)(uint32_t address, uint8_t *pData, uint16_t nCount);
+
+/*************************************************************************************
+    Function:
+        typedef uint8_t (*FILEIO_FTL_FlashWrite)(uint32_t address, uint8_t *pData, uint16_t nCount)
+
+    Summary:
+        Prototype of the flash program function of the serial flash driver.
+
+    Description:
+        Matches DRV_NVM_SST25VF064_Write, DRV_NVM_SST25VF016_Write,
+        DRV_NVM_M25P80_Write and DRV_NVM_FLASH_SIM_Write.  The function must
+        only program the given bytes (no erase before write) and return 1
+        on success.
+  ***********************************************************************************/
+typedef uint8_t (*FILEIO_FTL_FlashWrite)(uint32_t address, uint8_t *pData, uint16_t nCount);
+
+/*************************************************************************************
+    Function:
+        typedef void (*FILEIO_FTL_FlashErase)(uint32_t address)
+
+    Summary:
+        Prototype of the sector erase function of the serial flash driver.
+
+    Description:
+        Matches DRV_NVM_SST25VF064_SectorErase, DRV_NVM_SST25VF016_SectorErase,
+        DRV_NVM_M25P80_SectorErase and DRV_NVM_FLASH_SIM_SectorErase.  The
+        erased size must be DRV_FILEIO_CONFIG_FTL_BLOCK_SIZE.
+  ***********************************************************************************/
+typedef void (*FILEIO_FTL_FlashErase)(uint32_t address);
+
+// A configuration structure used by the flash translation layer functions to
+// access the serial flash device.
+typedef struct
+{
+    FILEIO_FTL_FlashRead readFunc;                  // Pointer to the read function of the flash driver
+    FILEIO_FTL_FlashWrite writeFunc;                // Pointer to the program function of the flash driver
+    FILEIO_FTL_FlashErase eraseFunc;                // Pointer to the sector erase function of the flash driver
+    uint32_t baseAddress;                           // Flash address of the first erase block used by the FTL
+} FILEIO_FTL_DRIVE_CONFIG;
+
+// Wear and garbage collection counters of the flash translation layer.
+typedef struct
+{
+    uint16_t freeBlocks;                            // Number of erased blocks ready for writing
+    uint32_t minEraseCount;                         // Erase count of the least worn block
+    uint32_t maxEraseCount;                         // Erase count of the most worn block
+    uint32_t sectorWrites;                          // Number of sector writes requested by the file system
+    uint32_t relocations;                           // Number of sectors copied by the garbage collector
+} FILEIO_FTL_STATISTICS;
+
+/*****************************************************************************/
+/*                                 Public Prototypes                         */
+/*****************************************************************************/
+
+/*********************************************************
+  Function:
+    void FILEIO_FTL_IOInitialize (FILEIO_FTL_DRIVE_CONFIG * config)
+  Summary:
+    Initializes the I/O used by the flash translation layer.
+  Conditions:
+    None
+  Input:
+    config - An FTL drive configuration structure pointer
+  Return:
+    None
+  Side Effects:
+    None.
+  Description:
+    The serial flash driver is initialized by the application
+    (DRV_NVM_SST25VF064_Initialize() or similar), so this function
+    has nothing to do.  It is provided for the FILEIO_DRIVE_CONFIG
+    function table.
+  Remarks:
+    None
+  *********************************************************/
+void FILEIO_FTL_IOInitialize(FILEIO_FTL_DRIVE_CONFIG * config);
+
+/*********************************************************
+  Function:
+    bool FILEIO_FTL_MediaDetect (FILEIO_FTL_DRIVE_CONFIG * config)
+  Summary:
+    Determines whether the flash is present.
+  Conditions:
+    None
+  Input:
+    config - An FTL drive configuration structure pointer
+  Return Values:
+    true -  The flash is always present
+  Side Effects:
+    None.
+  Description:
+    The serial flash is soldered on the board, so it is always
+    reported as present.
+  Remarks:
+    None
+  *********************************************************/
+bool FILEIO_FTL_MediaDetect(FILEIO_FTL_DRIVE_CONFIG * config);
+
+/*****************************************************************************
+  Function:
+    FILEIO_MEDIA_INFORMATION * FILEIO_FTL_MediaInitialize (FILEIO_FTL_DRIVE_CONFIG * config)
+  Summary:
+    Mounts the flash translation layer.
+  Conditions:
+    The serial flash driver is initialized.
+  Input:
+    config - An FTL drive configuration structure pointer
+  Return Values:
+    The function returns a pointer to the FILEIO_MEDIA_INFORMATION structure.  The
+    errorCode member may contain the following values:
+        * MEDIA_NO_ERROR - The translation layer was mounted
+        * MEDIA_CANNOT_INITIALIZE - The configuration is incomplete
+  Side Effects:
+    Blocks without a valid header are erased and formatted when
+    they are first needed.
+  Description:
+    This function reads the header of every erase block and rebuilds
+    the RAM mapping table from the sector tags.  When a logical sector
+    has more than one copy (the garbage collector or a write was
+    interrupted), the copy with the highest sequence number wins.
+    A slot is claimed by its tag before the data is programmed and
+    committed afterwards, so interrupted writes are never mapped and
+    are reclaimed by the garbage collector.
+  Remarks:
+    None
+  ***************************************************************************************/
+FILEIO_MEDIA_INFORMATION * FILEIO_FTL_MediaInitialize(FILEIO_FTL_DRIVE_CONFIG * config);
+
+/*********************************************************
+  Function:
+    bool FILEIO_FTL_MediaDeinitialize(FILEIO_FTL_DRIVE_CONFIG * config)
+  Summary:
+    Unmounts the flash translation layer.
+  Conditions:
+    None
+  Input:
+    config - An FTL drive configuration structure pointer
+  Return:
+    true
+  Side Effects:
+    None.
+  Description:
+    All data is stored in the flash as soon as it is written, so this
+    function only marks the translation layer as not mounted.
+  Remarks:
+    None
+  *********************************************************/
+bool FILEIO_FTL_MediaDeinitialize(FILEIO_FTL_DRIVE_CONFIG * config);
+
+/*********************************************************
+  Function:
+    uint32_t FILEIO_FTL_CapacityRead(FILEIO_FTL_DRIVE_CONFIG * config)
+  Summary:
+    Returns the last valid logical sector address.
+  Conditions:
+    FILEIO_FTL_MediaInitialize() is complete
+  Input:
+    config - An FTL drive configuration structure pointer
+  Return:
+    The number of logical sectors - 1
+  Side Effects:
+    None.
+  Description:
+    The capacity excludes the header slots and the spare blocks.
+  Remarks:
+    None
+  *********************************************************/
+uint32_t FILEIO_FTL_CapacityRead(FILEIO_FTL_DRIVE_CONFIG * config);
+
+/*********************************************************
+  Function:
+    uint16_t FILEIO_FTL_SectorSizeRead(FILEIO_FTL_DRIVE_CONFIG * config)
+  Summary:
+    Returns the logical sector size.
+  Conditions:
+    None
+  Input:
+    config - An FTL drive configuration structure pointer
+  Return:
+    FILEIO_CONFIG_MEDIA_SECTOR_SIZE
+  Side Effects:
+    None.
+  Description:
+    None
+  Remarks:
+    None
+  *********************************************************/
+uint16_t FILEIO_FTL_SectorSizeRead(FILEIO_FTL_DRIVE_CONFIG * config);
+
+/*****************************************************************************
+  Function:
+    bool FILEIO_FTL_SectorRead (FILEIO_FTL_DRIVE_CONFIG * config,
+        uint32_t sectorAddress, uint8_t * buffer)
+  Summary:
+    Reads a logical sector.
+  Conditions:
+    FILEIO_FTL_MediaInitialize() is complete
+  Input:
+    config -        An FTL drive configuration structure pointer
+    sectorAddress - The logical sector address.
+    buffer -        The buffer where the retrieved data will be stored.
+  Return Values:
+    true -  The sector was read successfully
+    false - The sector address is out of range
+  Side Effects:
+    None
+  Description:
+    The physical location of the sector is looked up in the RAM
+    mapping table.  Sectors that were never written read as zeros.
+  Remarks:
+    None
+  ***************************************************************************************/
+bool FILEIO_FTL_SectorRead(FILEIO_FTL_DRIVE_CONFIG * config, uint32_t sectorAddress, uint8_t * buffer);
+
+/*****************************************************************************
+  Function:
+    uint8_t FILEIO_FTL_SectorWrite (FILEIO_FTL_DRIVE_CONFIG * config,
+        uint32_t sectorAddress, uint8_t * buffer, bool allowWriteToZero)
+  Summary:
+    Writes a logical sector.
+  Conditions:
+    FILEIO_FTL_MediaInitialize() is complete
+  Input:
+    config -           An FTL drive configuration structure pointer
+    sectorAddress -    The logical sector address.
+    buffer -           The buffer with the data to write.
+    allowWriteToZero - true -  Writes to the 0 sector (MBR) are allowed
+                       false - Any write to the 0 sector will fail.
+  Return Values:
+    true -  The sector was written successfully.
+    false - The sector could not be written.
+  Side Effects:
+    May run the garbage collector in the foreground when the free
+    block pool is exhausted.
+  Description:
+    The data is appended to the next free slot of the active block and
+    the slot is tagged with the logical address and a sequence number.
+    The previous copy of the sector becomes stale; no erase is needed
+    for the update.
+  Remarks:
+    Call FILEIO_FTL_Tasks() periodically so that blocks are collected in
+    the background and writes rarely wait for an erase.
+  ***************************************************************************************/
+uint8_t FILEIO_FTL_SectorWrite(FILEIO_FTL_DRIVE_CONFIG * config, uint32_t sectorAddress, uint8_t * buffer, bool allowWriteToZero);
+
+/*********************************************************
+  Function:
+    bool FILEIO_FTL_WriteProtectStateGet(FILEIO_FTL_DRIVE_CONFIG * config)
+  Summary:
+    Determines if the media is write-protected.
+  Conditions:
+    None
+  Input:
+    config - An FTL drive configuration structure pointer
+  Return:
+    false
+  Side Effects:
+    None.
+  Description:
+    None
+  Remarks:
+    None
+  *********************************************************/
+bool FILEIO_FTL_WriteProtectStateGet(FILEIO_FTL_DRIVE_CONFIG * config);
+
+/*********************************************************
+  Function:
+    bool FILEIO_FTL_Tasks(FILEIO_FTL_DRIVE_CONFIG * config)
+  Summary:
+    Runs one step of the background garbage collector.
+  Conditions:
+    FILEIO_FTL_MediaInitialize() is complete
+  Input:
+    config - An FTL drive configuration structure pointer
+  Return:
+    true -  More garbage collection work is pending
+    false - The translation layer is idle
+  Side Effects:
+    None.
+  Description:
+    When fewer than DRV_FILEIO_CONFIG_FTL_GC_THRESHOLD blocks are free,
+    or the erase counts drift more than DRV_FILEIO_CONFIG_FTL_WEAR_THRESHOLD
+    apart, a victim block is selected.  Every call relocates one valid
+    sector of the victim or erases it once it is empty, so a call never
+    takes longer than one sector program or one block erase.
+  Remarks:
+    None
+  *********************************************************/
+bool FILEIO_FTL_Tasks(FILEIO_FTL_DRIVE_CONFIG * config);
+
+/*********************************************************
+  Function:
+    FILEIO_FTL_STATISTICS * FILEIO_FTL_StatisticsGet(FILEIO_FTL_DRIVE_CONFIG * config)
+  Summary:
+    Returns the wear and garbage collection counters.
+  Conditions:
+    FILEIO_FTL_MediaInitialize() is complete
+  Input:
+    config - An FTL drive configuration structure pointer
+  Return:
+    Pointer to the statistics structure
+  Side Effects:
+    None.
+  Description:
+    The counters describe the current mount only.  FILEIO_FTL_MediaInitialize()
+    clears sectorWrites and relocations, and rebuilds minEraseCount and
+    maxEraseCount from the erase counts stored in the block headers.
+  Remarks:
+    None
+  *********************************************************/
+FILEIO_FTL_STATISTICS * FILEIO_FTL_StatisticsGet(FILEIO_FTL_DRIVE_CONFIG * config);
+
+#endif
@@ -31,6 +31,46 @@ uint8_t FILEIO_InternalFlash_SectorWrite(void* config, uint32_t sector_addr, uin
 uint16_t FILEIO_InternalFlash_SectorSizeRead(void* config);
 uint32_t FILEIO_InternalFlash_CapacityRead(void* config);
 uint8_t FILEIO_InternalFlash_WriteProtectStateGet(void* config);
+bool FILEIO_InternalFlash_MediaDeinitialize(void* config);
+void FILEIO_InternalFlash_Flush(void* config);
+void FILEIO_InternalFlash_Tasks(void* config);
+
+//---------------------------------------------------------
+//Write combining
+//---------------------------------------------------------
+//Define DRV_FILEIO_CONFIG_INTERNAL_FLASH_WRITE_COMBINE to keep the erase page
+//that was written last in RAM.  Sectors written to the same erase page are
+//merged, and the page is erased and programmed once when a sector of another
+//page is written, or when FILEIO_InternalFlash_Flush(),
+//FILEIO_InternalFlash_MediaDeinitialize() or an idle FILEIO_InternalFlash_Tasks()
+//commits it.  Data that was not committed is lost on reset or power loss.
+#if !defined(DRV_FILEIO_CONFIG_INTERNAL_FLASH_WRITE_COMBINE_TIMEOUT)
+    //Number of FILEIO_InternalFlash_Tasks() calls without a sector write after
+    //which the buffered erase page is committed.  0 disables the timeout.
+    #define DRV_FILEIO_CONFIG_INTERNAL_FLASH_WRITE_COMBINE_TIMEOUT 100
+#endif
+
+//---------------------------------------------------------
+//Host flash model
+//---------------------------------------------------------
+//Define DRV_FILEIO_CONFIG_INTERNAL_FLASH_HOST_MODEL to build the byte organized
+//(PIC18/PIC32) version of this driver on a PC.  The flash memory is modeled by
+//a RAM array, EraseBlock() sets an erase page to 0xFF and programming can only
+//clear bits, like the real flash.
+#if defined(DRV_FILEIO_CONFIG_INTERNAL_FLASH_HOST_MODEL)
+    typedef struct
+    {
+        uint32_t eraseCount;        //Number of erase page erase operations
+        uint32_t programCount;      //Number of write block program operations
+    } FILEIO_INTERNAL_FLASH_HOST_STATISTICS;
+
+    extern uint8_t FILEIO_InternalFlash_HostMemory[];
+    extern FILEIO_INTERNAL_FLASH_HOST_STATISTICS internalFlashHostStatistics;
+
+    #if !defined(MASTER_BOOT_RECORD_ADDRESS)
+        #define MASTER_BOOT_RECORD_ADDRESS ((const uint8_t*)FILEIO_InternalFlash_HostMemory)
+    #endif
+#endif
 
 #if !defined(DRV_FILEIO_CONFIG_INTERNAL_FLASH_MAX_NUM_FILES_IN_ROOT)
     #define DRV_FILEIO_CONFIG_INTERNAL_FLASH_MAX_NUM_FILES_IN_ROOT 16
@@ -0,0 +1,671 @@
+/******************************************************************************
+*
+*                        Microchip File I/O Library
+*
+******************************************************************************
+* FileName:           flash_ftl.c
+* Dependencies:       See includes section.
+* Processor:          PIC24/dsPIC30/dsPIC33/PIC32
+* Compiler:           XC16/XC32
+* Company:            Microchip Technology, Inc.
+*
+* Software License Agreement
+*
+* The software supplied herewith by Microchip Technology Incorporated
+* (the "Company") for its PICmicro(R) Microcontroller is intended and
+* supplied to you, the Company's customer, for use solely and
+* exclusively on Microchip PICmicro Microcontroller products. The
+* software is owned by the Company and/or its supplier, and is
+* protected under applicable copyright laws. All rights are reserved.
+* Any use in violation of the foregoing restrictions may subject the
+* user to criminal sanctions under applicable laws, as well as to
+* civil liability for the breach of the terms and conditions of this
+* license.
+*
+* THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+* WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+* TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+* IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+* CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+*
+********************************************************************/
+
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "fileio_config.h"
+#include "fileio/fileio.h"
+#include "driver/fileio/flash_ftl.h"
+
+/******************************************************************************
+ * Flash layout
+ *
+ * The flash is divided into erase blocks of DRV_FILEIO_CONFIG_FTL_BLOCK_SIZE
+ * bytes.  Each block is divided into slots of one media sector.  Slot 0 holds
+ * the block header:
+ *
+ *      FTL_BLOCK_HEADER                    signature and erase count
+ *      FTL_SLOT_TAG[DATA_SLOTS_PER_BLOCK]  one tag per data slot
+ *
+ * Slots are written strictly in order.  A write first programs the logical
+ * sector and sequence number of the tag, then the data, then clears the
+ * commit word of the tag.  Only committed tags are mapped when mounting.
+ *****************************************************************************/
+
+#define FTL_BLOCK_SIGNATURE         0x314C5446ul        // "FTL1"
+#define FTL_TAG_EMPTY               0xFFFFFFFFul
+#define FTL_TAG_COMMITTED           0x00000000ul
+
+#define FTL_BLOCK_NONE              0xFFFF
+#define FTL_SLOT_UNMAPPED           0xFFFF
+
+typedef struct
+{
+    uint32_t signature;
+    uint32_t eraseCount;
+} FTL_BLOCK_HEADER;
+
+typedef struct
+{
+    uint32_t sector;
+    uint32_t sequence;
+    uint32_t commit;
+} FTL_SLOT_TAG;
+
+typedef enum
+{
+    FTL_BLOCK_UNFORMATTED = 0,      // content unknown, must be erased before use
+    FTL_BLOCK_FREE,                 // erased, header written, no slot used
+    FTL_BLOCK_USED                  // at least one slot used
+} FTL_BLOCK_STATE;
+
+/******************************************************************************
+ * Global Variables
+ *****************************************************************************/
+
+static FILEIO_MEDIA_INFORMATION mediaInformation;
+static FILEIO_FTL_STATISTICS ftlStatistics;
+
+// RAM mapping table, logical sector to physical slot (block * slots + slot)
+static uint16_t ftlMap[DRV_FILEIO_FTL_SECTOR_COUNT];
+
+static uint32_t ftlEraseCount[DRV_FILEIO_CONFIG_FTL_BLOCK_COUNT];
+static uint8_t  ftlValidCount[DRV_FILEIO_CONFIG_FTL_BLOCK_COUNT];
+static uint8_t  ftlBlockState[DRV_FILEIO_CONFIG_FTL_BLOCK_COUNT];
+
+static uint16_t ftlFreeBlocks;
+static uint16_t ftlActiveBlock;
+static uint8_t  ftlActiveSlot;
+static uint32_t ftlSequence;
+
+static uint16_t ftlVictimBlock;
+static uint8_t  ftlVictimSlot;
+
+static bool     ftlMounted = false;
+
+// sector buffer used for garbage collection and for the tag table on mount
+static uint8_t  ftlBuffer[FILEIO_CONFIG_MEDIA_SECTOR_SIZE];
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+static uint32_t FTL_BlockAddress(FILEIO_FTL_DRIVE_CONFIG * config, uint16_t block);
+static uint32_t FTL_TagAddress(FILEIO_FTL_DRIVE_CONFIG * config, uint16_t slot);
+static bool FTL_BlockFormat(FILEIO_FTL_DRIVE_CONFIG * config, uint16_t block);
+static bool FTL_BlockAllocate(FILEIO_FTL_DRIVE_CONFIG * config);
+static bool FTL_SlotProgram(FILEIO_FTL_DRIVE_CONFIG * config, uint32_t sector, uint8_t * buffer);
+static uint16_t FTL_VictimSelect(bool force);
+static bool FTL_GarbageCollectStep(FILEIO_FTL_DRIVE_CONFIG * config, bool force);
+static void FTL_WearUpdate(void);
+
+/*****************************************************************************
+  Function:
+    static uint32_t FTL_BlockAddress (FILEIO_FTL_DRIVE_CONFIG * config, uint16_t block)
+  Summary:
+    Returns the flash address of an erase block.
+  Input:
+    config - An FTL drive configuration structure pointer
+    block -  The erase block index
+  Return Values:
+    The flash address of the first byte of the block.
+  ***************************************************************************************/
+static uint32_t FTL_BlockAddress(FILEIO_FTL_DRIVE_CONFIG * config, uint16_t block)
+{
+    return config->baseAddress + ((uint32_t)block * DRV_FILEIO_CONFIG_FTL_BLOCK_SIZE);
+}
+
+/*****************************************************************************
+  Function:
+    static uint32_t FTL_TagAddress (FILEIO_FTL_DRIVE_CONFIG * config, uint16_t slot)
+  Summary:
+    Returns the flash address of the tag of a physical data slot.
+  Input:
+    config - An FTL drive configuration structure pointer
+    slot -   The physical slot (block * slots per block + slot in block)
+  Return Values:
+    The flash address of the FTL_SLOT_TAG in the block header.
+  ***************************************************************************************/
+static uint32_t FTL_TagAddress(FILEIO_FTL_DRIVE_CONFIG * config, uint16_t slot)
+{
+    return FTL_BlockAddress(config, slot / DRV_FILEIO_FTL_SLOTS_PER_BLOCK) + sizeof(FTL_BLOCK_HEADER) +
+           ((uint32_t)((slot % DRV_FILEIO_FTL_SLOTS_PER_BLOCK) - 1) * sizeof(FTL_SLOT_TAG));
+}
+
+/*****************************************************************************
+  Function:
+    static bool FTL_BlockFormat (FILEIO_FTL_DRIVE_CONFIG * config, uint16_t block)
+  Summary:
+    Erases a block and writes its header.
+  Input:
+    config - An FTL drive configuration structure pointer
+    block -  The erase block index
+  Return Values:
+    true -  The block is free
+    false - The header could not be programmed
+  Description:
+    The erase count is incremented and stored in the new header, so it
+    survives the erase and the next mount.
+  ***************************************************************************************/
+static bool FTL_BlockFormat(FILEIO_FTL_DRIVE_CONFIG * config, uint16_t block)
+{
+    FTL_BLOCK_HEADER header;
+    bool wasUsed = (ftlBlockState[block] == FTL_BLOCK_USED);
+
+    (*config->eraseFunc)(FTL_BlockAddress(config, block));
+
+    ftlEraseCount[block]++;
+
+    header.signature = FTL_BLOCK_SIGNATURE;
+    header.eraseCount = ftlEraseCount[block];
+
+    // unformatted blocks are counted as free as well
+    if (wasUsed)
+    {
+        ftlFreeBlocks++;
+    }
+
+    ftlValidCount[block] = 0;
+
+    if ((*config->writeFunc)(FTL_BlockAddress(config, block), (uint8_t *)&header, sizeof(header)) == 0)
+    {
+        ftlBlockState[block] = FTL_BLOCK_UNFORMATTED;
+        return false;
+    }
+
+    ftlBlockState[block] = FTL_BLOCK_FREE;
+
+    FTL_WearUpdate();
+
+    return true;
+}
+
+/*****************************************************************************
+  Function:
+    static bool FTL_BlockAllocate (FILEIO_FTL_DRIVE_CONFIG * config)
+  Summary:
+    Selects a new active block.
+  Input:
+    config - An FTL drive configuration structure pointer
+  Return Values:
+    true -  A new active block is available
+    false - No free block is left
+  Description:
+    The free block with the lowest erase count is selected (dynamic wear
+    leveling).  Unformatted blocks are erased first.
+  ***************************************************************************************/
+static bool FTL_BlockAllocate(FILEIO_FTL_DRIVE_CONFIG * config)
+{
+    uint16_t block, candidate = FTL_BLOCK_NONE;
+
+    for (block = 0; block < DRV_FILEIO_CONFIG_FTL_BLOCK_COUNT; block++)
+    {
+        if (ftlBlockState[block] == FTL_BLOCK_USED)
+            continue;
+
+        if ((candidate == FTL_BLOCK_NONE) || (ftlEraseCount[block] < ftlEraseCount[candidate]))
+            candidate = block;
+    }
+
+    if (candidate == FTL_BLOCK_NONE)
+        return false;
+
+    if (ftlBlockState[candidate] == FTL_BLOCK_UNFORMATTED)
+    {
+        if (FTL_BlockFormat(config, candidate) == false)
+            return false;
+    }
+
+    ftlBlockState[candidate] = FTL_BLOCK_USED;
+    ftlFreeBlocks--;
+
+    ftlActiveBlock = candidate;
+    ftlActiveSlot = 1;
+
+    return true;
+}
+
+/*****************************************************************************
+  Function:
+    static bool FTL_SlotProgram (FILEIO_FTL_DRIVE_CONFIG * config,
+        uint32_t sector, uint8_t * buffer)
+  Summary:
+    Appends one logical sector to the active block.
+  Input:
+    config - An FTL drive configuration structure pointer
+    sector - The logical sector address
+    buffer - The sector data
+  Return Values:
+    true -  The sector was programmed and mapped
+    false - The sector could not be programmed
+  ***************************************************************************************/
+static bool FTL_SlotProgram(FILEIO_FTL_DRIVE_CONFIG * config, uint32_t sector, uint8_t * buffer)
+{
+    FTL_SLOT_TAG tag;
+    uint16_t slot, old;
+    uint32_t commit = FTL_TAG_COMMITTED;
+
+    if (ftlActiveBlock == FTL_BLOCK_NONE)
+    {
+        if (FTL_BlockAllocate(config) == false)
+            return false;
+    }
+
+    slot = (ftlActiveBlock * DRV_FILEIO_FTL_SLOTS_PER_BLOCK) + ftlActiveSlot;
+
+    if (++ftlActiveSlot >= DRV_FILEIO_FTL_SLOTS_PER_BLOCK)
+    {
+        // a full block is an ordinary used block, it may become a victim
+        ftlActiveBlock = FTL_BLOCK_NONE;
+    }
+
+    // claim the slot, program the data, then commit it
+    tag.sector = sector;
+    tag.sequence = ftlSequence++;
+    tag.commit = FTL_TAG_EMPTY;
+
+    if ((*config->writeFunc)(FTL_TagAddress(config, slot), (uint8_t *)&tag, sizeof(tag)) == 0)
+        return false;
+
+    if ((*config->writeFunc)(FTL_BlockAddress(config, slot / DRV_FILEIO_FTL_SLOTS_PER_BLOCK) +
+                             ((uint32_t)(slot % DRV_FILEIO_FTL_SLOTS_PER_BLOCK) * FILEIO_CONFIG_MEDIA_SECTOR_SIZE),
+                             buffer, FILEIO_CONFIG_MEDIA_SECTOR_SIZE) == 0)
+        return false;
+
+    if ((*config->writeFunc)(FTL_TagAddress(config, slot) + (sizeof(tag) - sizeof(commit)), (uint8_t *)&commit, sizeof(commit)) == 0)
+        return false;
+
+    old = ftlMap[sector];
+    if (old != FTL_SLOT_UNMAPPED)
+    {
+        ftlValidCount[old / DRV_FILEIO_FTL_SLOTS_PER_BLOCK]--;
+    }
+
+    ftlMap[sector] = slot;
+    ftlValidCount[slot / DRV_FILEIO_FTL_SLOTS_PER_BLOCK]++;
+
+    return true;
+}
+
+/*****************************************************************************
+  Function:
+    static void FTL_WearUpdate (void)
+  Summary:
+    Updates the erase count range after an erase.
+  ***************************************************************************************/
+static void FTL_WearUpdate(void)
+{
+    uint16_t block;
+
+    ftlStatistics.minEraseCount = 0xFFFFFFFF;
+    ftlStatistics.maxEraseCount = 0;
+
+    for (block = 0; block < DRV_FILEIO_CONFIG_FTL_BLOCK_COUNT; block++)
+    {
+        if (ftlEraseCount[block] < ftlStatistics.minEraseCount)
+            ftlStatistics.minEraseCount = ftlEraseCount[block];
+        if (ftlEraseCount[block] > ftlStatistics.maxEraseCount)
+            ftlStatistics.maxEraseCount = ftlEraseCount[block];
+    }
+}
+
+/*****************************************************************************
+  Function:
+    static uint16_t FTL_VictimSelect (bool force)
+  Summary:
+    Selects the next block to be collected.
+  Input:
+    force - true when a write waits for the collection
+  Return Values:
+    The block index or FTL_BLOCK_NONE if nothing is worth collecting.
+  Description:
+    The used block with the fewest valid sectors is selected (greedy
+    policy), ties are broken by the lower erase count.  When the erase
+    counts drift more than DRV_FILEIO_CONFIG_FTL_WEAR_THRESHOLD apart,
+    the least worn used block is selected instead, so the cold data it
+    holds moves to a more worn block and the block returns to the pool.
+    This is only done in the background, as the block may hold no stale
+    sector at all, and only when a block besides the reserve is free: a
+    full block moved into the reserve cannot be finished after a reset
+    that wasted a slot of the reserve, and the next mount would find
+    neither a free block nor room in the active block.
+  ***************************************************************************************/
+static uint16_t FTL_VictimSelect(bool force)
+{
+    uint16_t block, greedy = FTL_BLOCK_NONE, coldest = FTL_BLOCK_NONE;
+
+    for (block = 0; block < DRV_FILEIO_CONFIG_FTL_BLOCK_COUNT; block++)
+    {
+        if ((ftlBlockState[block] != FTL_BLOCK_USED) || (block == ftlActiveBlock))
+            continue;
+
+        if ((greedy == FTL_BLOCK_NONE) ||
+            (ftlValidCount[block] < ftlValidCount[greedy]) ||
+            ((ftlValidCount[block] == ftlValidCount[greedy]) && (ftlEraseCount[block] < ftlEraseCount[greedy])))
+        {
+            greedy = block;
+        }
+
+        if ((coldest == FTL_BLOCK_NONE) || (ftlEraseCount[block] < ftlEraseCount[coldest]))
+            coldest = block;
+    }
+
+    if (coldest == FTL_BLOCK_NONE)
+        return FTL_BLOCK_NONE;
+
+    if (force == false)
+    {
+        // wear leveling moves a whole block, only do it in the background
+        // and only when a block besides the reserve is free
+        if (((ftlStatistics.maxEraseCount - ftlEraseCount[coldest]) > DRV_FILEIO_CONFIG_FTL_WEAR_THRESHOLD) &&
+            (ftlFreeBlocks >= 2))
+            return coldest;
+
+        if (ftlFreeBlocks >= DRV_FILEIO_CONFIG_FTL_GC_THRESHOLD)
+            return FTL_BLOCK_NONE;
+    }
+
+    // collecting a block without stale sectors gains nothing
+    if (ftlValidCount[greedy] >= DRV_FILEIO_FTL_DATA_SLOTS_PER_BLOCK)
+        return FTL_BLOCK_NONE;
+
+    return greedy;
+}
+
+/*****************************************************************************
+  Function:
+    static bool FTL_GarbageCollectStep (FILEIO_FTL_DRIVE_CONFIG * config, bool force)
+  Summary:
+    Performs one step of garbage collection.
+  Input:
+    config - An FTL drive configuration structure pointer
+    force -  true to collect even when the free pool is above the threshold
+  Return Values:
+    true -  A sector was relocated or a block was erased
+    false - There is nothing to collect or an error occurred
+  Description:
+    A step relocates one valid sector of the victim block, or erases the
+    victim once every valid sector has been moved.
+  ***************************************************************************************/
+static bool FTL_GarbageCollectStep(FILEIO_FTL_DRIVE_CONFIG * config, bool force)
+{
+    FTL_SLOT_TAG tag;
+    uint16_t slot;
+
+    if (ftlVictimBlock == FTL_BLOCK_NONE)
+    {
+        ftlVictimBlock = FTL_VictimSelect(force);
+        if (ftlVictimBlock == FTL_BLOCK_NONE)
+            return false;
+        ftlVictimSlot = 1;
+    }
+
+    while (ftlVictimSlot < DRV_FILEIO_FTL_SLOTS_PER_BLOCK)
+    {
+        slot = (ftlVictimBlock * DRV_FILEIO_FTL_SLOTS_PER_BLOCK) + ftlVictimSlot;
+        ftlVictimSlot++;
+
+        (*config->readFunc)(FTL_TagAddress(config, slot), (uint8_t *)&tag, sizeof(tag));
+
+        if ((tag.sector < DRV_FILEIO_FTL_SECTOR_COUNT) && (ftlMap[tag.sector] == slot))
+        {
+            (*config->readFunc)(FTL_BlockAddress(config, ftlVictimBlock) +
+                                ((uint32_t)(slot % DRV_FILEIO_FTL_SLOTS_PER_BLOCK) * FILEIO_CONFIG_MEDIA_SECTOR_SIZE),
+                                ftlBuffer, FILEIO_CONFIG_MEDIA_SECTOR_SIZE);
+
+            ftlStatistics.relocations++;
+
+            if (FTL_SlotProgram(config, tag.sector, ftlBuffer) == false)
+            {
+                ftlVictimBlock = FTL_BLOCK_NONE;
+                return false;
+            }
+            return true;
+        }
+    }
+
+    slot = ftlVictimBlock;
+    ftlVictimBlock = FTL_BLOCK_NONE;
+
+    return FTL_BlockFormat(config, slot);
+}
+
+void FILEIO_FTL_IOInitialize(FILEIO_FTL_DRIVE_CONFIG * config)
+{
+}
+
+bool FILEIO_FTL_MediaDetect(FILEIO_FTL_DRIVE_CONFIG * config)
+{
+    return true;
+}
+
+FILEIO_MEDIA_INFORMATION * FILEIO_FTL_MediaInitialize(FILEIO_FTL_DRIVE_CONFIG * config)
+{
+    FTL_BLOCK_HEADER header;
+    FTL_SLOT_TAG *pTag, previous;
+    uint32_t sector, maxEraseCount = 0;
+    uint16_t block, slot, lastSlot = FTL_SLOT_UNMAPPED;
+    uint8_t i;
+
+    mediaInformation.validityFlags.bits.sectorSize = true;
+    mediaInformation.sectorSize = FILEIO_CONFIG_MEDIA_SECTOR_SIZE;
+    mediaInformation.errorCode = MEDIA_NO_ERROR;
+
+    if ((config->readFunc == NULL) || (config->writeFunc == NULL) || (config->eraseFunc == NULL))
+    {
+        mediaInformation.errorCode = MEDIA_CANNOT_INITIALIZE;
+        return &mediaInformation;
+    }
+
+    memset(ftlMap, 0xFF, sizeof(ftlMap));
+    memset(ftlValidCount, 0x00, sizeof(ftlValidCount));
+    memset(&ftlStatistics, 0x00, sizeof(ftlStatistics));
+
+    ftlFreeBlocks = 0;
+    ftlSequence = 0;
+    ftlActiveBlock = FTL_BLOCK_NONE;
+    ftlVictimBlock = FTL_BLOCK_NONE;
+
+    // Rebuild the mapping table from the block headers.
+    for (block = 0; block < DRV_FILEIO_CONFIG_FTL_BLOCK_COUNT; block++)
+    {
+        (*config->readFunc)(FTL_BlockAddress(config, block), (uint8_t *)&header, sizeof(header));
+
+        ftlFreeBlocks++;
+
+        if (header.signature != FTL_BLOCK_SIGNATURE)
+        {
+            ftlBlockState[block] = FTL_BLOCK_UNFORMATTED;
+            ftlEraseCount[block] = 0;
+            continue;
+        }
+
+        ftlBlockState[block] = FTL_BLOCK_FREE;
+        ftlEraseCount[block] = header.eraseCount;
+        if (header.eraseCount > maxEraseCount)
+            maxEraseCount = header.eraseCount;
+
+        (*config->readFunc)(FTL_BlockAddress(config, block) + sizeof(header), ftlBuffer,
+                            DRV_FILEIO_FTL_DATA_SLOTS_PER_BLOCK * sizeof(FTL_SLOT_TAG));
+
+        pTag = (FTL_SLOT_TAG *)ftlBuffer;
+        for (i = 1; i < DRV_FILEIO_FTL_SLOTS_PER_BLOCK; i++, pTag++)
+        {
+            if (pTag->sector == FTL_TAG_EMPTY)
+                continue;
+
+            if (ftlBlockState[block] == FTL_BLOCK_FREE)
+            {
+                ftlBlockState[block] = FTL_BLOCK_USED;
+                ftlFreeBlocks--;
+            }
+
+            slot = (block * DRV_FILEIO_FTL_SLOTS_PER_BLOCK) + i;
+
+            if ((pTag->sequence != FTL_TAG_EMPTY) && (pTag->sequence >= ftlSequence))
+            {
+                ftlSequence = pTag->sequence + 1;
+                lastSlot = slot;
+            }
+
+            if ((pTag->commit != FTL_TAG_COMMITTED) || (pTag->sector >= DRV_FILEIO_FTL_SECTOR_COUNT))
+                continue;
+
+            sector = pTag->sector;
+
+            if (ftlMap[sector] != FTL_SLOT_UNMAPPED)
+            {
+                (*config->readFunc)(FTL_TagAddress(config, ftlMap[sector]), (uint8_t *)&previous, sizeof(previous));
+                if (previous.sequence > pTag->sequence)
+                    continue;
+            }
+
+            ftlMap[sector] = slot;
+        }
+    }
+
+    // Unformatted blocks lost their erase count; assume they are as worn
+    // as the most worn block so they are not preferred by the allocator.
+    for (block = 0; block < DRV_FILEIO_CONFIG_FTL_BLOCK_COUNT; block++)
+    {
+        if (ftlBlockState[block] == FTL_BLOCK_UNFORMATTED)
+            ftlEraseCount[block] = maxEraseCount;
+    }
+
+    for (sector = 0; sector < DRV_FILEIO_FTL_SECTOR_COUNT; sector++)
+    {
+        if (ftlMap[sector] != FTL_SLOT_UNMAPPED)
+            ftlValidCount[ftlMap[sector] / DRV_FILEIO_FTL_SLOTS_PER_BLOCK]++;
+    }
+
+    // The block holding the newest tag was the active block.  Its unclaimed
+    // slots were never programmed, so writing resumes behind the newest tag.
+    if ((lastSlot != FTL_SLOT_UNMAPPED) && (((lastSlot % DRV_FILEIO_FTL_SLOTS_PER_BLOCK) + 1) < DRV_FILEIO_FTL_SLOTS_PER_BLOCK))
+    {
+        ftlActiveBlock = lastSlot / DRV_FILEIO_FTL_SLOTS_PER_BLOCK;
+        ftlActiveSlot = (lastSlot % DRV_FILEIO_FTL_SLOTS_PER_BLOCK) + 1;
+    }
+
+    FTL_WearUpdate();
+
+    ftlMounted = true;
+
+    // A collection interrupted by a reset may have used the reserve block.
+    // Finish it now, the active block has room for the remaining sectors.
+    while (ftlFreeBlocks == 0)
+    {
+        if (FTL_GarbageCollectStep(config, true) == false)
+            break;
+    }
+
+    return &mediaInformation;
+}
+
+bool FILEIO_FTL_MediaDeinitialize(FILEIO_FTL_DRIVE_CONFIG * config)
+{
+    ftlMounted = false;
+    return true;
+}
+
+uint32_t FILEIO_FTL_CapacityRead(FILEIO_FTL_DRIVE_CONFIG * config)
+{
+    return (DRV_FILEIO_FTL_SECTOR_COUNT - 1);
+}
+
+uint16_t FILEIO_FTL_SectorSizeRead(FILEIO_FTL_DRIVE_CONFIG * config)
+{
+    return FILEIO_CONFIG_MEDIA_SECTOR_SIZE;
+}
+
+bool FILEIO_FTL_SectorRead(FILEIO_FTL_DRIVE_CONFIG * config, uint32_t sectorAddress, uint8_t * buffer)
+{
+    uint16_t slot;
+
+    if ((ftlMounted == false) || (sectorAddress >= DRV_FILEIO_FTL_SECTOR_COUNT))
+    {
+        return false;
+    }
+
+    slot = ftlMap[sectorAddress];
+
+    if (slot == FTL_SLOT_UNMAPPED)
+    {
+        memset(buffer, 0x00, FILEIO_CONFIG_MEDIA_SECTOR_SIZE);
+        return true;
+    }
+
+    (*config->readFunc)(FTL_BlockAddress(config, slot / DRV_FILEIO_FTL_SLOTS_PER_BLOCK) +
+                        ((uint32_t)(slot % DRV_FILEIO_FTL_SLOTS_PER_BLOCK) * FILEIO_CONFIG_MEDIA_SECTOR_SIZE),
+                        buffer, FILEIO_CONFIG_MEDIA_SECTOR_SIZE);
+
+    return true;
+}
+
+uint8_t FILEIO_FTL_SectorWrite(FILEIO_FTL_DRIVE_CONFIG * config, uint32_t sectorAddress, uint8_t * buffer, bool allowWriteToZero)
+{
+    if ((ftlMounted == false) || (sectorAddress >= DRV_FILEIO_FTL_SECTOR_COUNT))
+    {
+        return false;
+    }
+
+    if ((allowWriteToZero == false) && (sectorAddress == 0x00000000))
+    {
+        return false;
+    }
+
+    ftlStatistics.sectorWrites++;
+
+    // Keep one free block in reserve for the garbage collector.  A pending
+    // collection that already used the reserve is finished first; a write
+    // that needs a new block when only the reserve is left collects in the
+    // foreground.
+    while (((ftlVictimBlock != FTL_BLOCK_NONE) && (ftlFreeBlocks == 0)) ||
+           ((ftlActiveBlock == FTL_BLOCK_NONE) && (ftlFreeBlocks < 2)))
+    {
+        if (FTL_GarbageCollectStep(config, true) == false)
+            break;
+    }
+
+    return FTL_SlotProgram(config, sectorAddress, buffer);
+}
+
+bool FILEIO_FTL_WriteProtectStateGet(FILEIO_FTL_DRIVE_CONFIG * config)
+{
+    return false;
+}
+
+bool FILEIO_FTL_Tasks(FILEIO_FTL_DRIVE_CONFIG * config)
+{
+    if (ftlMounted == false)
+    {
+        return false;
+    }
+
+    return FTL_GarbageCollectStep(config, false);
+}
+
+FILEIO_FTL_STATISTICS * FILEIO_FTL_StatisticsGet(FILEIO_FTL_DRIVE_CONFIG * config)
+{
+    ftlStatistics.freeBlocks = ftlFreeBlocks;
+    return &ftlStatistics;
+}
@@ -45,6 +45,14 @@
 
 static FILEIO_MEDIA_INFORMATION mediaInformation;
 
+#if defined(DRV_FILEIO_CONFIG_INTERNAL_FLASH_HOST_MODEL)
+    //RAM model of the flash memory holding the MSD volume.  The application
+    //(or test) loads the volume image before calling MediaInitialize().
+    uint8_t FILEIO_InternalFlash_HostMemory[((DRV_FILEIO_INTERNAL_FLASH_TOTAL_DISK_SIZE * FILEIO_CONFIG_MEDIA_SECTOR_SIZE) + DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE - 1) / DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE * DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE]
+        __attribute__((aligned(DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE)));
+    FILEIO_INTERNAL_FLASH_HOST_STATISTICS internalFlashHostStatistics;
+#endif
+
 /******************************************************************************
  * Prototypes
  *****************************************************************************/
@@ -172,6 +180,99 @@ FILEIO_MEDIA_INFORMATION * FILEIO_InternalFlash_MediaInitialize(void* config)
 }//end MediaInitialize
 
 
+/******************************************************************************
+ * Erase page buffer
+ *
+ * file_buffer[] holds the RAM image of one flash erase page.  Without write
+ * combining it is only used inside FILEIO_InternalFlash_SectorWrite().  With
+ * DRV_FILEIO_CONFIG_INTERNAL_FLASH_WRITE_COMBINE defined it keeps the image
+ * of the last written erase page, and every sector written to that page is
+ * merged into it.  The page is erased and programmed once, when a sector of
+ * another page is written, when FILEIO_InternalFlash_Flush() is called or
+ * when FILEIO_InternalFlash_Tasks() detects that no write happened for
+ * DRV_FILEIO_CONFIG_INTERNAL_FLASH_WRITE_COMBINE_TIMEOUT calls.
+ *****************************************************************************/
+#if defined(DRV_FILEIO_CONFIG_INTERNAL_FLASH_HOST_MODEL)
+    static unsigned char file_buffer[DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE];
+#elif defined(__XC8) || defined(__18CXX)
+    #if defined(__18CXX)
+        #pragma udata myFileBuffer
+    #endif
+    volatile unsigned char file_buffer[DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE];
+#elif defined (__dsPIC33E__) || defined (__PIC24E__)
+    volatile unsigned int file_buffer[DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE] __attribute__((far));
+#else
+    volatile unsigned char file_buffer[DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE] __attribute__((far,aligned));
+#endif
+
+#if defined(__18CXX)
+    #pragma udata
+#endif
+
+#define INTERNAL_FLASH_PROGRAM_WORD        0x4003
+#define INTERNAL_FLASH_ERASE               0x4042
+#define INTERNAL_FLASH_PROGRAM_PAGE        0x4001
+
+
+#if defined(DRV_FILEIO_CONFIG_INTERNAL_FLASH_HOST_MODEL)
+    #define PTR_SIZE uintptr_t
+#elif defined(__C32__)
+    #define PTR_SIZE uint32_t
+#elif defined(__XC8)
+    #define PTR_SIZE uint32_t
+#elif defined(__18CXX)
+    #define PTR_SIZE UINT24
+#else
+    #define PTR_SIZE uint16_t
+#endif
+const uint8_t *FileAddress = 0;
+
+//Type of the flash address of an erase page
+#if defined(__C30__)
+    #define INTERNAL_FLASH_ADDRESS uint32_t
+#else
+    #define INTERNAL_FLASH_ADDRESS PTR_SIZE
+#endif
+
+#if defined(__C30__)
+    //The C30 erase page stores 2 bytes of MSD data per flash word address pair.
+    #if defined (__dsPIC33E__) || defined (__PIC24E__)
+        #define INTERNAL_FLASH_PAGE_MASK            (uint32_t)0xFFFFF800
+        #define INTERNAL_FLASH_SECTORS_PER_PAGE     4u
+    #else
+        #define INTERNAL_FLASH_PAGE_MASK            (uint32_t)0xFFFFFC00
+        #define INTERNAL_FLASH_SECTORS_PER_PAGE     2u
+    #endif
+
+    #define INTERNAL_FLASH_PageAddressGet(sector)   (((uint32_t)DRV_FILEIO_INTERNAL_FLASH_CONFIG_FILES_ADDRESS + (uint32_t)((sector)*FILEIO_CONFIG_MEDIA_SECTOR_SIZE)) & INTERNAL_FLASH_PAGE_MASK)
+    #define INTERNAL_FLASH_PageOffsetGet(sector)    ((uint16_t)FILEIO_CONFIG_MEDIA_SECTOR_SIZE * (uint16_t)((sector) % INTERNAL_FLASH_SECTORS_PER_PAGE))
+#elif (DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE >= FILEIO_CONFIG_MEDIA_SECTOR_SIZE)
+    #define INTERNAL_FLASH_PageAddressGet(sector)   ((PTR_SIZE)(MASTER_BOOT_RECORD_ADDRESS + ((sector) * FILEIO_CONFIG_MEDIA_SECTOR_SIZE)) & ~((PTR_SIZE)DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE - 1))
+    #define INTERNAL_FLASH_PageOffsetGet(sector)    ((PTR_SIZE)(MASTER_BOOT_RECORD_ADDRESS + ((sector) * FILEIO_CONFIG_MEDIA_SECTOR_SIZE)) & ((PTR_SIZE)DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE - 1))
+#endif
+
+#if defined(DRV_FILEIO_CONFIG_INTERNAL_FLASH_WRITE_PROTECT)
+    //Nothing is ever written.
+    #undef DRV_FILEIO_CONFIG_INTERNAL_FLASH_WRITE_COMBINE
+#elif !defined(__C30__) && (DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE < FILEIO_CONFIG_MEDIA_SECTOR_SIZE)
+    //When the erase page is smaller than a sector, every sector write already
+    //erases each page only once.  There is nothing to combine.
+    #undef DRV_FILEIO_CONFIG_INTERNAL_FLASH_WRITE_COMBINE
+#endif
+
+#if defined(DRV_FILEIO_CONFIG_INTERNAL_FLASH_WRITE_COMBINE)
+    static INTERNAL_FLASH_ADDRESS combinePageAddress;     //Flash address of the erase page held in file_buffer[]
+    static bool combinePageValid = false;   //file_buffer[] holds the image of combinePageAddress
+    static bool combinePageDirty = false;   //file_buffer[] differs from the flash contents
+    static uint16_t combineIdleCount = 0;   //FILEIO_InternalFlash_Tasks() calls since the last write
+#endif
+
+#if !defined(DRV_FILEIO_CONFIG_INTERNAL_FLASH_WRITE_PROTECT)
+static void InternalFlash_PageLoad(INTERNAL_FLASH_ADDRESS pageAddress);
+static void InternalFlash_PageProgram(INTERNAL_FLASH_ADDRESS pageAddress);
+#endif
+
+
 /******************************************************************************
  * Function:        uint8_t SectorRead(uint32_t sector_addr, uint8_t *buffer)
  *
@@ -213,6 +314,15 @@ uint8_t FILEIO_InternalFlash_SectorRead(void* config, uint32_t sector_addr, uint
     {
         return false;
     }    
+
+#if defined(DRV_FILEIO_CONFIG_INTERNAL_FLASH_WRITE_COMBINE)
+    //Sectors of the buffered erase page may not be programmed yet.
+    if((combinePageValid == true) && (INTERNAL_FLASH_PageAddressGet(sector_addr) == combinePageAddress))
+    {
+        memcpy(buffer, (uint8_t*)file_buffer + INTERNAL_FLASH_PageOffsetGet(sector_addr), FILEIO_CONFIG_MEDIA_SECTOR_SIZE);
+        return true;
+    }
+#endif
     
     //Save TBLPAG register
     TBLPAGSave = TBLPAG;
@@ -250,6 +360,15 @@ uint8_t FILEIO_InternalFlash_SectorRead(void* config, uint32_t sector_addr, uint
     {
         return false;
     }   
+
+#if defined(DRV_FILEIO_CONFIG_INTERNAL_FLASH_WRITE_COMBINE)
+    //Sectors of the buffered erase page may not be programmed yet.
+    if((combinePageValid == true) && (INTERNAL_FLASH_PageAddressGet(sector_addr) == combinePageAddress))
+    {
+        memcpy((void*)buffer, (const void*)&file_buffer[INTERNAL_FLASH_PageOffsetGet(sector_addr)], FILEIO_CONFIG_MEDIA_SECTOR_SIZE);
+        return true;
+    }
+#endif
     
     //Read a sector worth of data, and copy it to the specified RAM "buffer".
     memcpy
@@ -275,7 +394,8 @@ uint8_t FILEIO_InternalFlash_SectorRead(void* config, uint32_t sector_addr, uint
  *
  * Output:          Returns true if write successful, false otherwise
  *
- * Side Effects:    None
+ * Side Effects:    With write combining enabled, the data may stay in RAM
+ *                  until the erase page is committed.
  *
  * Overview:        SectorWrite sends 512 bytes of data from the location
  *                  pointed to by 'buffer' to the card starting
@@ -286,48 +406,11 @@ uint8_t FILEIO_InternalFlash_SectorRead(void* config, uint32_t sector_addr, uint
  *                  be converted to byte address. This is accomplished by
  *                  shifting the address left 9 times.
  *****************************************************************************/
-#if defined(__XC8) || defined(__18CXX)
-    #if defined(__18CXX)
-        #pragma udata myFileBuffer
-    #endif
-    volatile unsigned char file_buffer[DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE];
-#elif defined (__dsPIC33E__) || defined (__PIC24E__)
-    volatile unsigned int file_buffer[DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE] __attribute__((far));
-#else
-    volatile unsigned char file_buffer[DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE] __attribute__((far,aligned));
-#endif
-
-#if defined(__18CXX)
-    #pragma udata
-#endif
-
-#define INTERNAL_FLASH_PROGRAM_WORD        0x4003
-#define INTERNAL_FLASH_ERASE               0x4042
-#define INTERNAL_FLASH_PROGRAM_PAGE        0x4001
-
-
-#if defined(__C32__)
-    #define PTR_SIZE uint32_t
-#elif defined(__XC8)
-    #define PTR_SIZE uint32_t
-#elif defined(__18CXX)
-    #define PTR_SIZE UINT24
-#else
-    #define PTR_SIZE uint16_t
-#endif
-const uint8_t *FileAddress = 0;
-
-
 #if defined(__C30__)
 uint8_t FILEIO_InternalFlash_SectorWrite(void* config, uint32_t sector_addr, uint8_t* buffer, uint8_t allowWriteToZero)
 {
 #if !defined(DRV_FILEIO_CONFIG_INTERNAL_FLASH_WRITE_PROTECT)
-    uint16_t i;
-    uint8_t j;
-    uint16_t offset;
     uint32_t flashAddress;
-    uint16_t TBLPAGSave;
-
 
     //First, error check the resulting address, to make sure the MSD host isn't trying 
     //to erase/program illegal LBAs that are not part of the designated MSD volume space.
@@ -336,41 +419,70 @@ uint8_t FILEIO_InternalFlash_SectorWrite(void* config, uint32_t sector_addr, uin
         return false;
     }  
 
+    //Get a pointer to the start of the erase page.  The AND mask clears the
+    //lower bits, so we go back to the start of the erase page.
+    flashAddress = INTERNAL_FLASH_PageAddressGet(sector_addr);
+
+#if defined(DRV_FILEIO_CONFIG_INTERNAL_FLASH_WRITE_COMBINE)
+    //A sector of another erase page is buffered.  Commit it first.
+    if((combinePageValid == true) && (combinePageAddress != flashAddress))
+    {
+        FILEIO_InternalFlash_Flush(config);
+        combinePageValid = false;
+    }
+
+    if(combinePageValid == false)
+    {
+        InternalFlash_PageLoad(flashAddress);
+        combinePageAddress = flashAddress;
+        combinePageValid = true;
+    }
+#else
+    //First, save the contents of the entire erase page.
+    InternalFlash_PageLoad(flashAddress);
+#endif
+
+    //Now we want to overwrite the file_buffer[] contents for the sector that we are trying to write to.
+    memcpy((uint8_t*)file_buffer + INTERNAL_FLASH_PageOffsetGet(sector_addr), buffer, FILEIO_CONFIG_MEDIA_SECTOR_SIZE);
+
+#if defined(DRV_FILEIO_CONFIG_INTERNAL_FLASH_WRITE_COMBINE)
+    combinePageDirty = true;
+    combineIdleCount = 0;
+#else
+    InternalFlash_PageProgram(flashAddress);
+#endif
+
+    return true;
+#else
+    return true;
+#endif
+
+}    
+
+#if !defined(DRV_FILEIO_CONFIG_INTERNAL_FLASH_WRITE_PROTECT)
+/******************************************************************************
+ * Function:        static void InternalFlash_PageLoad(INTERNAL_FLASH_ADDRESS pageAddress)
+ *
+ * Input:           pageAddress - Flash address of the erase page
+ *
+ * Overview:        Copies the MSD data of an erase page into file_buffer[].
+ *****************************************************************************/
+static void InternalFlash_PageLoad(INTERNAL_FLASH_ADDRESS pageAddress)
+{
+    uint16_t i;
+    uint16_t TBLPAGSave;
+    uint32_t flashAddress = pageAddress;
+
     TBLPAGSave = TBLPAG;
-    
-#if defined (__dsPIC33E__) || defined (__PIC24E__)
-    
 
-    // First, save the contents of the entire erase page.  
-    // To do this, we need to get a pointer to the start of the erase page.
-    // AND mask 0xFFFFF800 is to clear the lower bits, 
-    // so we go back to the start of the erase page.
-    
-    flashAddress = ((uint32_t)DRV_FILEIO_INTERNAL_FLASH_CONFIG_FILES_ADDRESS + (uint32_t)(sector_addr*FILEIO_CONFIG_MEDIA_SECTOR_SIZE))
-                & (uint32_t)0xFFFFF800;
-    
+#if defined (__dsPIC33E__) || defined (__PIC24E__)
     //Now save all of the contents of the erase page.
     TBLPAG = (uint8_t)(flashAddress >> 16);
     for(i = 0; i < DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE;i++)
     {
         file_buffer[i] = __builtin_tblrdl((uint16_t)flashAddress + (2 * i));
     }    
-
-    // Now we want to overwrite the file_buffer[] contents 
-    // for the sector that we are trying to write to.
-    // The lower 2 bits of the helps to determine this.
-   
-    offset = 0x200 * (uint8_t)(sector_addr & 0x3);
-
-    //Overwrite the file_buffer[] RAM contents for the sector that we are trying to write to.
-    for(i = 0; i < FILEIO_CONFIG_MEDIA_SECTOR_SIZE; i++)
-    {
-        *((unsigned char *)file_buffer + offset + i) = *buffer++;
-    }
 #else
-
-     //First, save the contents of the entire erase page.  To do this, we need to get a pointer to the start of the erase page.
-    flashAddress = ((uint32_t)DRV_FILEIO_INTERNAL_FLASH_CONFIG_FILES_ADDRESS + (uint32_t)(sector_addr*FILEIO_CONFIG_MEDIA_SECTOR_SIZE)) & (uint32_t)0xFFFFFC00;  //AND mask 0xFFFFFC00 is to clear the lower bits, so we go back to the start of the erase page.
     //Now save all of the contents of the erase page.
     for(i = 0; i < DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE;)
     {
@@ -379,35 +491,32 @@ uint8_t FILEIO_InternalFlash_SectorWrite(void* config, uint32_t sector_addr, uin
         flashAddress += 2u;    //Skipping upper word.  Don't care about the implemented byte/don't use it when programming or reading from the sector.
         i += 2u;
     }    
+#endif
 
-    //Now we want to overwrite the file_buffer[] contents for the sector that we are trying to write to.
-    //Need to figure out if the buffer[] data goes in the upper sector or the lower sector of the file_buffer[]
-    if(sector_addr & 0x00000001)
-    {
-        //Odd sector address, must be the high file_buffer[] sector
-        offset = FILEIO_CONFIG_MEDIA_SECTOR_SIZE;
-    }
-    else
-    {
-        offset = 0;
-    }        
+    TBLPAG = TBLPAGSave;
+}
 
-    //Overwrite the file_buffer[] RAM contents for the sector that we are trying to write to.
-    for(i = 0; i < FILEIO_CONFIG_MEDIA_SECTOR_SIZE; i++)
-    {
-        file_buffer[offset + i] = *buffer++;
-    }
-    #endif
-    
+/******************************************************************************
+ * Function:        static void InternalFlash_PageProgram(INTERNAL_FLASH_ADDRESS pageAddress)
+ *
+ * Input:           pageAddress - Flash address of the erase page
+ *
+ * Overview:        Erases an erase page and programs it with file_buffer[].
+ *****************************************************************************/
+static void InternalFlash_PageProgram(INTERNAL_FLASH_ADDRESS pageAddress)
+{
+    uint16_t i;
+    uint8_t j;
+    uint16_t TBLPAGSave;
+    uint32_t flashAddress = pageAddress;
+
+    TBLPAGSave = TBLPAG;
 
 #if defined(__dsPIC33E__) || defined (__PIC24E__)
 
     int gieBkUp;
 
     //Now erase the entire erase page of flash memory.  
-    //First we need to calculate the actual flash memory 
-    //address of the erase page. 
-    
     gieBkUp = INTCON2bits.GIE;
     INTCON2bits.GIE = 0; // Disable interrupts
     NVMADRU = (uint16_t)(flashAddress >> 16);
@@ -449,10 +558,6 @@ uint8_t FILEIO_InternalFlash_SectorWrite(void* config, uint32_t sector_addr, uin
         }    
     } 
 #else 
-    //Now erase the entire erase page of flash memory.  
-    //First we need to calculate the actual flash memory address of the erase page.  The starting address of the erase page is as follows:
-    flashAddress = ((uint32_t)DRV_FILEIO_INTERNAL_FLASH_CONFIG_FILES_ADDRESS + (uint32_t)(sector_addr*FILEIO_CONFIG_MEDIA_SECTOR_SIZE)) & (uint32_t)0xFFFFFC00;
-
     //Peform NVM erase operation.
     NVMCON = INTERNAL_FLASH_ERASE;				    //Page erase on next WR
     __builtin_tblwtl((uint16_t)flashAddress, 0xFFFF);   //Perform dummy write to load address of erase page
@@ -488,24 +593,13 @@ uint8_t FILEIO_InternalFlash_SectorWrite(void* config, uint32_t sector_addr, uin
 #endif
 
     TBLPAG = TBLPAGSave;   
-    return true;
-#else
-    return true;
-#endif
-
-}    
+}
+#endif  //#if !defined(DRV_FILEIO_CONFIG_INTERNAL_FLASH_WRITE_PROTECT)
 #else   //else must be PIC18 or PIC32 device
 uint8_t FILEIO_InternalFlash_SectorWrite(void* config, uint32_t sector_addr, uint8_t* buffer, uint8_t allowWriteToZero)
 {
     #if !defined(DRV_FILEIO_CONFIG_INTERNAL_FLASH_WRITE_PROTECT)
         const uint8_t* dest;
-        bool foundDifference;
-        uint16_t blockCounter;
-        uint16_t sectorCounter;
-
-        #if defined(__XC8) || defined(__18CXX)
-            uint8_t* p;
-        #endif
 
         //First, error check the resulting address, to make sure the MSD host isn't trying 
         //to erase/program illegal LBAs that are not part of the designated MSD volume space.
@@ -517,158 +611,308 @@ uint8_t FILEIO_InternalFlash_SectorWrite(void* config, uint32_t sector_addr, uin
         //Compute pointer to location in flash memory we should modify
         dest = (const uint8_t*)(MASTER_BOOT_RECORD_ADDRESS + (sector_addr * FILEIO_CONFIG_MEDIA_SECTOR_SIZE));
 
-        sectorCounter = 0;
-        //Loop that actually does the flash programming, until all of the
-        //intended sector data has been programmed
-        while(sectorCounter < FILEIO_CONFIG_MEDIA_SECTOR_SIZE)
+        //Check to see which is bigger, the flash memory minimum erase page size, or the sector size.
+        #if (DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE >= FILEIO_CONFIG_MEDIA_SECTOR_SIZE)
         {
-            //First, read the contents of flash to see if they already match what the
-            //host is trying to write.  If every byte already matches perfectly,
-            //we can save flash endurance by not actually performing the reprogramming
-            //operation.
-            foundDifference = false;
-            for(blockCounter = 0; blockCounter < DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE; blockCounter++)
-            {
-                if(dest[sectorCounter] != buffer[sectorCounter])
+            PTR_SIZE address;
+
+            //The hardware erases more flash memory than the amount of a sector that
+            //we are programming.  Therefore, we will have to use a three step process:
+            //1. Read out the flash memory contents that are part of the erase page (but we don't need to modify)
+            //   and save it temporarily to a RAM buffer.
+            //2. Erase the flash memory page (which blows away multiple sectors worth of data in flash)
+            //3. Reprogram both the intended sector data, and the unmodified flash data that we didn't want to
+            //   modify, but had to temporarily erase (since it was sharing the erase page with our intended write location).
+            //With write combining, steps 2 and 3 are deferred until all sectors of the erase page are written.
+
+            //Compute a pointer to the first byte on the erase page of interest
+            address = INTERNAL_FLASH_PageAddressGet(sector_addr);
+
+            #if defined(DRV_FILEIO_CONFIG_INTERNAL_FLASH_WRITE_COMBINE)
+                //A sector of another erase page is buffered.  Commit it first.
+                if((combinePageValid == true) && (combinePageAddress != address))
                 {
-                    foundDifference = true;
-                    sectorCounter -= blockCounter;
-                    break;
+                    FILEIO_InternalFlash_Flush(config);
+                    combinePageValid = false;
                 }
-                sectorCounter++;
-            }
 
-            //If the existing flash memory contents are different from what is waiting
-            //in the RAM buffer to be programmed.  We will need to do some flash reprogramming.
-            if(foundDifference == true)
+                if(combinePageValid == false)
+            #endif
             {
-                uint8_t i;
-                PTR_SIZE address;
-
-                //Check to see which is bigger, the flash memory minimum erase page size, or the sector size.
-                #if (DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE >= FILEIO_CONFIG_MEDIA_SECTOR_SIZE)
-                    //The hardware erases more flash memory than the amount of a sector that
-                    //we are programming.  Therefore, we will have to use a three step process:
-                    //1. Read out the flash memory contents that are part of the erase page (but we don't need to modify)
-                    //   and save it temporarily to a RAM buffer.
-                    //2. Erase the flash memory page (which blows away multiple sectors worth of data in flash)
-                    //3. Reprogram both the intended sector data, and the unmodified flash data that we didn't want to
-                    //   modify, but had to temporarily erase (since it was sharing the erase page with our intended write location).
-
-                    //Compute a pointer to the first byte on the erase page of interest
-                    address = ((PTR_SIZE)(dest + sectorCounter) & ~((uint32_t)DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE - 1));
-
-                    //Read out the entire contents of the flash memory erase page of interest and save to RAM.
-                    memcpy
-                    (
-                        (void*)file_buffer,
-                        (const void*)address,
-                        DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE
-                    );
-
-                    //Now erase the flash memory page
-                    EraseBlock((const uint8_t*)address);
-
-                    //Compute a pointer into the RAM buffer with the erased flash contents,
-                    //to where we want to replace the existing data with the new data from the host.
-                    address = ((PTR_SIZE)(dest + sectorCounter) & ((uint32_t)DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE - 1));
-
-                    //Overwrite part of the erased page RAM buffer with the new data being
-                    //written from the host
-                    memcpy
-                    (
-                        (void*)(&file_buffer[address]),
-                        (void*)buffer,
-                        FILEIO_CONFIG_MEDIA_SECTOR_SIZE
-                    );
+                //First, read the contents of flash to see if they already match what the
+                //host is trying to write.  If every byte already matches perfectly,
+                //we can save flash endurance by not actually performing the reprogramming
+                //operation.
+                if(memcmp((const void*)dest, (const void*)buffer, FILEIO_CONFIG_MEDIA_SECTOR_SIZE) == 0)
+                {
+                    return true;
+                }
 
-                #else
-                    //The erase page size is small enough, we don't have to (temporarily) erase
-                    //any data, other than the specific flash region that we want to re-program with new data.
+                //Read out the entire contents of the flash memory erase page of interest and save to RAM.
+                InternalFlash_PageLoad(address);
 
-                    //Move sector counter to the first byte on the erase page of interest
-                    sectorCounter &= ~(DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE - 1);
+                #if defined(DRV_FILEIO_CONFIG_INTERNAL_FLASH_WRITE_COMBINE)
+                    combinePageAddress = address;
+                    combinePageValid = true;
+                #endif
+            }
 
-                    //Compute a pointer to the first byte of flash program memory on the erase page of interest
-                    address = (PTR_SIZE)dest + sectorCounter;
+            //Overwrite part of the erased page RAM buffer with the new data being
+            //written from the host
+            memcpy
+            (
+                (void*)(&file_buffer[INTERNAL_FLASH_PageOffsetGet(sector_addr)]),
+                (void*)buffer,
+                FILEIO_CONFIG_MEDIA_SECTOR_SIZE
+            );
+
+            #if defined(DRV_FILEIO_CONFIG_INTERNAL_FLASH_WRITE_COMBINE)
+                combinePageDirty = true;
+                combineIdleCount = 0;
+            #else
+                InternalFlash_PageProgram(address);
+            #endif
+        }
+        #else
+        {
+            uint16_t blockCounter;
+            uint16_t sectorCounter;
 
-                    //Erase a page of flash memory
-                    EraseBlock((const uint8_t*)address);
+            //The erase page size is small enough, we don't have to (temporarily) erase
+            //any data, other than the specific flash region that we want to re-program with new data.
+            for(sectorCounter = 0; sectorCounter < FILEIO_CONFIG_MEDIA_SECTOR_SIZE; sectorCounter += DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE)
+            {
+                //First, read the contents of flash to see if they already match what the
+                //host is trying to write.  If every byte already matches perfectly,
+                //we can save flash endurance by not actually performing the reprogramming
+                //operation.
+                for(blockCounter = 0; blockCounter < DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE; blockCounter++)
+                {
+                    if(dest[sectorCounter + blockCounter] != buffer[sectorCounter + blockCounter])
+                    {
+                        break;
+                    }
+                }
 
+                //If the existing flash memory contents are different from what is waiting
+                //in the RAM buffer to be programmed.  We will need to do some flash reprogramming.
+                if(blockCounter < DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE)
+                {
                     memcpy
                     (
                         (void*)&file_buffer[0],
                         (void*)(buffer+sectorCounter),
                         DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE
                     );
-                #endif
-
 
-                //Compute the number of write blocks that are in the erase page.
-                i = DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE / DRV_FILEIO_INTERNAL_FLASH_CONFIG_WRITE_BLOCK_SIZE;
-
-                #if defined(__XC8) || defined(__18CXX)
-                    p = (uint8_t*)&file_buffer[0];
-                    TBLPTR = ((PTR_SIZE)(dest + sectorCounter) & ~((uint32_t)DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE - 1));
-                #endif
-
-                //Commit each write block worth of data to the flash memory, one block at a time
-                while(i-- > 0)
-                {
-                    //Write a block of the RAM bufferred data to the programming latches
-                    for(blockCounter = 0; blockCounter < DRV_FILEIO_INTERNAL_FLASH_CONFIG_WRITE_BLOCK_SIZE; blockCounter++)
-                    {
-                        //Write the data
-                        #if defined(__XC8)
-                            TABLAT = *p++;
-                            #asm
-                                tblwtpostinc
-                            #endasm
-                            sectorCounter++;
-                        #elif defined(__18CXX)
-                            TABLAT = *p++;
-                            _asm tblwtpostinc _endasm
-                            sectorCounter++;
-                        #endif
-
-                        #if defined(__C32__)
-                            NVMWriteWord((uint32_t*)KVA_TO_PA(FileAddress), *((uint32_t*)&file_buffer[sectorCounter]));
-                            FileAddress += 4;
-                            sectorCounter += 4;
-                        #endif
-                    }
+                    InternalFlash_PageProgram((PTR_SIZE)dest + sectorCounter);
+                }
+            }
+        }
+        #endif
 
-                    //Now commit/write the block of data from the programming latches into the flash memory
-                    #if defined(__XC8)
-                        // Start the write process: for PIC18, first need to reposition tblptr back into memory block that we want to write to.
-                        #asm 
-                            tblrdpostdec 
-                        #endasm
-
-                        // Write flash memory, enable write control.
-                        EECON1 = 0x84;
-                        UnlockAndActivate(NVM_UNLOCK_KEY);
-                        TBLPTR++;                    
-                    #elif defined(__18CXX)
-                        // Start the write process: for PIC18, first need to reposition tblptr back into memory block that we want to write to.
-                         _asm tblrdpostdec _endasm
-
-                        // Write flash memory, enable write control.
-                        EECON1 = 0x84;
-                        UnlockAndActivate(NVM_UNLOCK_KEY);
-                        TBLPTR++;
-                    #endif
-                }//while(i-- > 0)
-            }//if(foundDifference == true)
-        }//while(sectorCounter < FILEIO_CONFIG_MEDIA_SECTOR_SIZE)
     	return true;
     #else
         return true;
     #endif
 } //end SectorWrite
+
+#if !defined(DRV_FILEIO_CONFIG_INTERNAL_FLASH_WRITE_PROTECT)
+/******************************************************************************
+ * Function:        static void InternalFlash_PageLoad(INTERNAL_FLASH_ADDRESS pageAddress)
+ *
+ * Input:           pageAddress - Flash address of the erase page
+ *
+ * Overview:        Copies an erase page into file_buffer[].
+ *****************************************************************************/
+static void InternalFlash_PageLoad(INTERNAL_FLASH_ADDRESS pageAddress)
+{
+    memcpy
+    (
+        (void*)file_buffer,
+        (const void*)(PTR_SIZE)pageAddress,
+        DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE
+    );
+}
+
+/******************************************************************************
+ * Function:        static void InternalFlash_PageProgram(INTERNAL_FLASH_ADDRESS pageAddress)
+ *
+ * Input:           pageAddress - Flash address of the erase page
+ *
+ * Overview:        Erases an erase page and programs it with file_buffer[],
+ *                  one write block at a time.
+ *****************************************************************************/
+static void InternalFlash_PageProgram(INTERNAL_FLASH_ADDRESS pageAddress)
+{
+    uint8_t i;
+    uint16_t blockCounter;
+    uint16_t bufferCounter = 0;
+
+    #if defined(__XC8) || defined(__18CXX)
+        uint8_t* p;
+    #endif
+
+    //Now erase the flash memory page
+    EraseBlock((const uint8_t*)(PTR_SIZE)pageAddress);
+
+    //Compute the number of write blocks that are in the erase page.
+    i = DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE / DRV_FILEIO_INTERNAL_FLASH_CONFIG_WRITE_BLOCK_SIZE;
+
+    #if defined(__XC8) || defined(__18CXX)
+        p = (uint8_t*)&file_buffer[0];
+        TBLPTR = (PTR_SIZE)pageAddress;
+    #endif
+
+    //Commit each write block worth of data to the flash memory, one block at a time
+    while(i-- > 0)
+    {
+        //Write a block of the RAM bufferred data to the programming latches
+        for(blockCounter = 0; blockCounter < DRV_FILEIO_INTERNAL_FLASH_CONFIG_WRITE_BLOCK_SIZE; blockCounter++)
+        {
+            //Write the data
+            #if defined(__XC8)
+                TABLAT = *p++;
+                #asm
+                    tblwtpostinc
+                #endasm
+            #elif defined(__18CXX)
+                TABLAT = *p++;
+                _asm tblwtpostinc _endasm
+            #endif
+
+            #if defined(__C32__)
+                if((blockCounter & 3u) == 0)
+                {
+                    NVMWriteWord((uint32_t*)KVA_TO_PA(FileAddress), *((uint32_t*)&file_buffer[bufferCounter]));
+                    FileAddress += 4;
+                }
+            #elif defined(DRV_FILEIO_CONFIG_INTERNAL_FLASH_HOST_MODEL)
+                ((uint8_t*)FileAddress)[bufferCounter] &= file_buffer[bufferCounter];
+            #endif
+
+            bufferCounter++;
+        }
+
+        #if defined(DRV_FILEIO_CONFIG_INTERNAL_FLASH_HOST_MODEL)
+            internalFlashHostStatistics.programCount++;
+        #endif
+
+        //Now commit/write the block of data from the programming latches into the flash memory
+        #if defined(__XC8)
+            // Start the write process: for PIC18, first need to reposition tblptr back into memory block that we want to write to.
+            #asm 
+                tblrdpostdec 
+            #endasm
+
+            // Write flash memory, enable write control.
+            EECON1 = 0x84;
+            UnlockAndActivate(NVM_UNLOCK_KEY);
+            TBLPTR++;                    
+        #elif defined(__18CXX)
+            // Start the write process: for PIC18, first need to reposition tblptr back into memory block that we want to write to.
+             _asm tblrdpostdec _endasm
+
+            // Write flash memory, enable write control.
+            EECON1 = 0x84;
+            UnlockAndActivate(NVM_UNLOCK_KEY);
+            TBLPTR++;
+        #endif
+    }//while(i-- > 0)
+}
+#endif  //#if !defined(DRV_FILEIO_CONFIG_INTERNAL_FLASH_WRITE_PROTECT)
 #endif  //#if defined(__C30__)
 
 
+/******************************************************************************
+ * Function:        void FILEIO_InternalFlash_Flush(void* config)
+ *
+ * PreCondition:    None
+ *
+ * Input:           config - Not used
+ *
+ * Output:          None
+ *
+ * Side Effects:    The buffered erase page is erased and programmed.
+ *
+ * Overview:        Commits the erase page buffered by write combining to the
+ *                  flash memory.  The page stays buffered, so further writes
+ *                  and reads to it are still served from RAM.
+ *
+ * Note:            Does nothing when write combining is not enabled.
+ *****************************************************************************/
+void FILEIO_InternalFlash_Flush(void* config)
+{
+#if defined(DRV_FILEIO_CONFIG_INTERNAL_FLASH_WRITE_COMBINE)
+    if((combinePageValid == true) && (combinePageDirty == true))
+    {
+        InternalFlash_PageProgram(combinePageAddress);
+        combinePageDirty = false;
+    }
+    combineIdleCount = 0;
+#endif
+}
+
+/******************************************************************************
+ * Function:        void FILEIO_InternalFlash_Tasks(void* config)
+ *
+ * PreCondition:    None
+ *
+ * Input:           config - Not used
+ *
+ * Output:          None
+ *
+ * Side Effects:    May erase and program the buffered erase page.
+ *
+ * Overview:        Should be called periodically from the main loop.  Commits
+ *                  the buffered erase page after
+ *                  DRV_FILEIO_CONFIG_INTERNAL_FLASH_WRITE_COMBINE_TIMEOUT
+ *                  calls without a sector write.
+ *
+ * Note:            Does nothing when write combining is not enabled.
+ *****************************************************************************/
+void FILEIO_InternalFlash_Tasks(void* config)
+{
+#if defined(DRV_FILEIO_CONFIG_INTERNAL_FLASH_WRITE_COMBINE) && (DRV_FILEIO_CONFIG_INTERNAL_FLASH_WRITE_COMBINE_TIMEOUT > 0)
+    if(combinePageDirty == false)
+    {
+        return;
+    }
+
+    if(++combineIdleCount >= DRV_FILEIO_CONFIG_INTERNAL_FLASH_WRITE_COMBINE_TIMEOUT)
+    {
+        FILEIO_InternalFlash_Flush(config);
+    }
+#endif
+}
+
+/******************************************************************************
+ * Function:        bool FILEIO_InternalFlash_MediaDeinitialize(void* config)
+ *
+ * PreCondition:    None
+ *
+ * Input:           config - Not used
+ *
+ * Output:          true - The media was deinitialized
+ *
+ * Side Effects:    The buffered erase page is committed and released.
+ *
+ * Overview:        Commits pending writes, so the volume can be unmounted or
+ *                  the device reset safely.
+ *
+ * Note:            None
+ *****************************************************************************/
+bool FILEIO_InternalFlash_MediaDeinitialize(void* config)
+{
+    FILEIO_InternalFlash_Flush(config);
+
+#if defined(DRV_FILEIO_CONFIG_INTERNAL_FLASH_WRITE_COMBINE)
+    combinePageValid = false;
+#endif
+
+    return true;
+}
+
 
 #if !defined(DRV_FILEIO_CONFIG_INTERNAL_FLASH_WRITE_PROTECT)
 void EraseBlock(const uint8_t* dest)
@@ -684,12 +928,18 @@ void EraseBlock(const uint8_t* dest)
     #if defined(__C32__)
         FileAddress = dest;
         NVMErasePage((uint8_t *)KVA_TO_PA(dest));
+    #elif defined(DRV_FILEIO_CONFIG_INTERNAL_FLASH_HOST_MODEL)
+        FileAddress = dest;
+        memset((void*)dest, 0xFF, DRV_FILEIO_INTERNAL_FLASH_CONFIG_ERASE_BLOCK_SIZE);
+        internalFlashHostStatistics.eraseCount++;
     #endif
 }
 
 
 //------------------------------------------------------------------------------
-#if defined(__XC16__)
+#if defined(DRV_FILEIO_CONFIG_INTERNAL_FLASH_HOST_MODEL)
+    //No unlock sequence on the host.
+#elif defined(__XC16__)
     #pragma message "Double click this message and read inline code comments.  For production designs, recommend adding application specific robustness features here."
 #else
     #warning "Double click this message and read inline code comments.  For production designs, recommend adding application specific robustness features here."
@@ -0,0 +1,61 @@
+/*******************************************************************************
+ Flash Translation Layer Test - File I/O Configuration
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    fileio_config.h
+
+  Summary:
+    File I/O configuration of the host flash translation layer test.
+
+  Description:
+    The test drives the flash translation layer directly, without the
+    file system, so only the media sector size is relevant.
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+Copyright (c) 2013 released Microchip Technology Inc.  All rights reserved.
+
+Microchip licenses to you the right to use, modify, copy and distribute
+Software only when embedded on a Microchip microcontroller or digital signal
+controller that is integrated into your product or third party product
+(pursuant to the sublicense terms in the accompanying license agreement).
+
+You should refer to the license agreement accompanying this Software for
+additional information regarding your rights and obligations.
+
+SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR PURPOSE.
+IN NO EVENT SHALL MICROCHIP OR ITS LICENSORS BE LIABLE OR OBLIGATED UNDER
+CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH OF WARRANTY, OR
+OTHER LEGAL EQUITABLE THEORY ANY DIRECT OR INDIRECT DAMAGES OR EXPENSES
+INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL, INDIRECT, PUNITIVE OR
+CONSEQUENTIAL DAMAGES, LOST PROFITS OR LOST DATA, COST OF PROCUREMENT OF
+SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
+(INCLUDING BUT NOT LIMITED TO ANY DEFENSE THEREOF), OR OTHER SIMILAR COSTS.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef _FILEIO_CONFIG_H
+#define _FILEIO_CONFIG_H
+
+// Macro indicating how many drives can be mounted simultaneously.
+#define FILEIO_CONFIG_MAX_DRIVES        1
+
+// Defines a character to use as a delimiter for directories.
+#define FILEIO_CONFIG_DELIMITER '/'
+
+// Size of the media sectors, the flash translation layer maps sectors of this size.
+#define FILEIO_CONFIG_MEDIA_SECTOR_SIZE         512
+
+#define FILEIO_CONFIG_SEARCH_DISABLE
+#define FILEIO_CONFIG_FORMAT_DISABLE
+#define FILEIO_CONFIG_DIRECTORY_DISABLE
+#define FILEIO_CONFIG_DRIVE_PROPERTIES_DISABLE
+#define FILEIO_CONFIG_MULTIPLE_BUFFER_MODE_DISABLE
+
+#endif
@@ -0,0 +1,562 @@
+/*******************************************************************************
+ Flash Translation Layer Test
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    flash_ftl_test.c
+
+  Summary:
+    Host test of the flash translation layer.
+
+  Description:
+    This program runs the flash translation layer on a host computer
+    against the simulated serial flash driver and checks:
+
+        - every logical sector reads back what was last written to it
+        - the erase counts of the blocks stay within the wear leveling
+          threshold while a few hot sectors are rewritten next to cold
+          data, and match the counts reported by FILEIO_FTL_StatisticsGet()
+        - a remount rebuilds the erase counts from the block headers and
+          clears the write and relocation counters
+        - after a power failure at any point of a write or of a garbage
+          collection step, a remount maps the old or the new data of the
+          sector being written and every other sector is intact
+
+    Build (from the root of the library):
+
+        gcc -O2 -I driver/fileio/utilities/ftl_test -I .
+            driver/fileio/utilities/ftl_test/flash_ftl_test.c
+            driver/fileio/src/flash_ftl.c
+            driver/nvm/src/drv_nvm_flash_sim.c
+            -o flash_ftl_test
+
+    The program prints one line per test and returns 0 when every test
+    passed.
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+Copyright (c) 2013 released Microchip Technology Inc.  All rights reserved.
+
+Microchip licenses to you the right to use, modify, copy and distribute
+Software only when embedded on a Microchip microcontroller or digital signal
+controller that is integrated into your product or third party product
+(pursuant to the sublicense terms in the accompanying license agreement).
+
+You should refer to the license agreement accompanying this Software for
+additional information regarding your rights and obligations.
+
+SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR PURPOSE.
+IN NO EVENT SHALL MICROCHIP OR ITS LICENSORS BE LIABLE OR OBLIGATED UNDER
+CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH OF WARRANTY, OR
+OTHER LEGAL EQUITABLE THEORY ANY DIRECT OR INDIRECT DAMAGES OR EXPENSES
+INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL, INDIRECT, PUNITIVE OR
+CONSEQUENTIAL DAMAGES, LOST PROFITS OR LOST DATA, COST OF PROCUREMENT OF
+SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
+(INCLUDING BUT NOT LIMITED TO ANY DEFENSE THEREOF), OR OTHER SIMILAR COSTS.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#include <stdio.h>
+#include <string.h>
+#include "system.h"
+#include "fileio_config.h"
+#include "driver/fileio/flash_ftl.h"
+#include "driver/nvm/drv_nvm_flash_sim.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Test Configuration
+// *****************************************************************************
+// *****************************************************************************
+#define TEST_SECTOR_COUNT           DRV_FILEIO_FTL_SECTOR_COUNT
+#define TEST_HOT_SECTORS            4           // sectors rewritten by the wear test
+#define TEST_HOT_WRITES             40000       // writes of the wear test
+#define TEST_POWER_FAIL_WRITES      3000        // interrupted writes of the power fail test
+#define TEST_POWER_FAIL_OPERATIONS  48          // flash commands before the power fails, at most
+
+// allowed erase count range, the collector starts at the threshold and
+// one block is collected at a time
+#define TEST_WEAR_LIMIT             (DRV_FILEIO_CONFIG_FTL_WEAR_THRESHOLD + 2)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Variables
+// *****************************************************************************
+// *****************************************************************************
+static FILEIO_FTL_DRIVE_CONFIG testDrive =
+{
+    DRV_NVM_FLASH_SIM_Read,
+    DRV_NVM_FLASH_SIM_Write,
+    DRV_NVM_FLASH_SIM_SectorErase,
+    0
+};
+
+// version of the data last written to each sector, 0 = never written
+static uint32_t testVersion[TEST_SECTOR_COUNT];
+
+static uint8_t  testBuffer[FILEIO_CONFIG_MEDIA_SECTOR_SIZE];
+static uint8_t  testExpected[FILEIO_CONFIG_MEDIA_SECTOR_SIZE];
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Helper Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*********************************************************************
+* Function: static void TestPatternFill(uint8_t *pBuffer, uint32_t sector,
+*                                       uint32_t version)
+*
+* Overview: Fills a buffer with the content of a sector version. The
+*           content differs between sectors and between versions.
+*           Version 0 is the content of a sector that was never
+*           written, which reads as zeros.
+*
+* PreCondition: none
+*
+* Input: pBuffer - sector buffer
+*        sector - logical sector
+*        version - data version
+*
+* Output: none
+*
+********************************************************************/
+static void TestPatternFill(uint8_t *pBuffer, uint32_t sector, uint32_t version)
+{
+    uint16_t i;
+    uint32_t seed = (sector * 2654435761ul) ^ (version * 40503ul);
+
+    for (i = 0; i < FILEIO_CONFIG_MEDIA_SECTOR_SIZE; i++)
+    {
+        if (version == 0)
+        {
+            pBuffer[i] = 0;
+        }
+        else
+        {
+            seed = (seed * 1103515245ul) + 12345ul;
+            pBuffer[i] = (uint8_t)(seed >> 16);
+        }
+    }
+}
+
+/*********************************************************************
+* Function: static bool TestSectorWrite(uint32_t sector)
+*
+* Overview: Writes the next version of a sector.
+*
+* PreCondition: The translation layer is mounted.
+*
+* Input: sector - logical sector
+*
+* Output: true if the write was successful
+*
+********************************************************************/
+static bool TestSectorWrite(uint32_t sector)
+{
+    TestPatternFill(testBuffer, sector, testVersion[sector] + 1);
+
+    if (FILEIO_FTL_SectorWrite(&testDrive, sector, testBuffer, true) == false)
+        return false;
+
+    testVersion[sector]++;
+    return true;
+}
+
+/*********************************************************************
+* Function: static bool TestSectorCheck(uint32_t sector, uint32_t version)
+*
+* Overview: Compares a sector with the content of a version.
+*
+* PreCondition: The translation layer is mounted.
+*
+* Input: sector - logical sector
+*        version - expected data version
+*
+* Output: true if the sector holds the version
+*
+********************************************************************/
+static bool TestSectorCheck(uint32_t sector, uint32_t version)
+{
+    if (FILEIO_FTL_SectorRead(&testDrive, sector, testBuffer) == false)
+        return false;
+
+    TestPatternFill(testExpected, sector, version);
+
+    return (memcmp(testBuffer, testExpected, FILEIO_CONFIG_MEDIA_SECTOR_SIZE) == 0);
+}
+
+/*********************************************************************
+* Function: static bool TestAllCheck(void)
+*
+* Overview: Checks every sector against its last written version.
+*
+* PreCondition: The translation layer is mounted.
+*
+* Input: none
+*
+* Output: true if every sector is intact, the first bad sector is
+*         reported otherwise.
+*
+********************************************************************/
+static bool TestAllCheck(void)
+{
+    uint32_t sector;
+
+    for (sector = 0; sector < TEST_SECTOR_COUNT; sector++)
+    {
+        if (TestSectorCheck(sector, testVersion[sector]) == false)
+        {
+            printf("    sector %lu does not hold version %lu\n", (unsigned long)sector, (unsigned long)testVersion[sector]);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*********************************************************************
+* Function: static bool TestMount(void)
+*
+* Overview: Unmounts and mounts the translation layer, as a reset of
+*           the device would.
+*
+* PreCondition: none
+*
+* Input: none
+*
+* Output: true if the mount was successful
+*
+********************************************************************/
+static bool TestMount(void)
+{
+    FILEIO_FTL_MediaDeinitialize(&testDrive);
+
+    return (FILEIO_FTL_MediaInitialize(&testDrive)->errorCode == MEDIA_NO_ERROR);
+}
+
+/*********************************************************************
+* Function: static void TestTasksRun(void)
+*
+* Overview: Runs the background garbage collector until it is idle.
+*
+* PreCondition: The translation layer is mounted.
+*
+* Input: none
+*
+* Output: none
+*
+********************************************************************/
+static void TestTasksRun(void)
+{
+    uint16_t steps = 0;
+
+    // bounded, a collector that never becomes idle fails the data checks
+    while ((FILEIO_FTL_Tasks(&testDrive) == true) && (++steps < 1000))
+        ;
+}
+
+/*********************************************************************
+* Function: static void TestEraseRangeGet(uint32_t *pMin, uint32_t *pMax)
+*
+* Overview: Reads the erase count range of the blocks from the
+*           simulated device.
+*
+* PreCondition: none
+*
+* Input: pMin - receives the lowest erase count
+*        pMax - receives the highest erase count
+*
+* Output: none
+*
+********************************************************************/
+static void TestEraseRangeGet(uint32_t *pMin, uint32_t *pMax)
+{
+    uint16_t block;
+    uint32_t count;
+
+    *pMin = 0xFFFFFFFF;
+    *pMax = 0;
+
+    for (block = 0; block < DRV_FILEIO_CONFIG_FTL_BLOCK_COUNT; block++)
+    {
+        count = DRV_NVM_FLASH_SIM_EraseCountGet(testDrive.baseAddress + ((uint32_t)block * DRV_FILEIO_CONFIG_FTL_BLOCK_SIZE));
+        if (count < *pMin)
+            *pMin = count;
+        if (count > *pMax)
+            *pMax = count;
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Tests
+// *****************************************************************************
+// *****************************************************************************
+
+/*********************************************************************
+* Function: static bool TestReadBack(void)
+*
+* Overview: Writes every sector twice and reads them back, before
+*           and after a remount.
+*
+* PreCondition: The simulated device is erased.
+*
+* Input: none
+*
+* Output: true if the test passed
+*
+********************************************************************/
+static bool TestReadBack(void)
+{
+    uint32_t sector;
+    uint8_t pass;
+
+    if (TestMount() == false)
+        return false;
+
+    // unwritten sectors read as zeros
+    if (TestAllCheck() == false)
+        return false;
+
+    for (pass = 0; pass < 2; pass++)
+    {
+        for (sector = 0; sector < TEST_SECTOR_COUNT; sector++)
+        {
+            if (TestSectorWrite(sector) == false)
+            {
+                printf("    write of sector %lu failed\n", (unsigned long)sector);
+                return false;
+            }
+        }
+
+        if (TestAllCheck() == false)
+            return false;
+    }
+
+    if (TestMount() == false)
+        return false;
+
+    return TestAllCheck();
+}
+
+/*********************************************************************
+* Function: static bool TestWearLeveling(void)
+*
+* Overview: Rewrites a few hot sectors while the other sectors hold
+*           cold data, and checks the spread of the erase counts.
+*
+* PreCondition: Every sector holds data (TestReadBack()).
+*
+* Input: none
+*
+* Output: true if the test passed
+*
+********************************************************************/
+static bool TestWearLeveling(void)
+{
+    FILEIO_FTL_STATISTICS *pStatistics;
+    uint32_t write, minErase, maxErase;
+
+    for (write = 0; write < TEST_HOT_WRITES; write++)
+    {
+        if (TestSectorWrite(write % TEST_HOT_SECTORS) == false)
+        {
+            printf("    write %lu failed\n", (unsigned long)write);
+            return false;
+        }
+
+        TestTasksRun();
+    }
+
+    TestEraseRangeGet(&minErase, &maxErase);
+    pStatistics = FILEIO_FTL_StatisticsGet(&testDrive);
+
+    printf("    erase counts %lu to %lu, %lu relocations for %lu writes\n",
+           (unsigned long)minErase, (unsigned long)maxErase,
+           (unsigned long)pStatistics->relocations, (unsigned long)pStatistics->sectorWrites);
+
+    if ((pStatistics->minEraseCount != minErase) || (pStatistics->maxEraseCount != maxErase))
+    {
+        printf("    statistics report erase counts %lu to %lu\n",
+               (unsigned long)pStatistics->minEraseCount, (unsigned long)pStatistics->maxEraseCount);
+        return false;
+    }
+
+    // the cold blocks must have been recycled, not only the spare blocks
+    if ((minErase < (TEST_HOT_WRITES / (DRV_FILEIO_CONFIG_FTL_BLOCK_COUNT * DRV_FILEIO_FTL_DATA_SLOTS_PER_BLOCK))) ||
+        ((maxErase - minErase) > TEST_WEAR_LIMIT))
+    {
+        printf("    erase counts are not leveled\n");
+        return false;
+    }
+
+    return TestAllCheck();
+}
+
+/*********************************************************************
+* Function: static bool TestRemount(void)
+*
+* Overview: Checks the statistics after a remount. The erase counts
+*           are rebuilt from the block headers, the counters of the
+*           previous session are cleared.
+*
+* PreCondition: The wear leveling test was run.
+*
+* Input: none
+*
+* Output: true if the test passed
+*
+********************************************************************/
+static bool TestRemount(void)
+{
+    FILEIO_FTL_STATISTICS *pStatistics, before;
+
+    before = *FILEIO_FTL_StatisticsGet(&testDrive);
+
+    if (TestMount() == false)
+        return false;
+
+    pStatistics = FILEIO_FTL_StatisticsGet(&testDrive);
+
+    if ((pStatistics->minEraseCount != before.minEraseCount) ||
+        (pStatistics->maxEraseCount != before.maxEraseCount) ||
+        (pStatistics->freeBlocks != before.freeBlocks))
+    {
+        printf("    erase counts %lu to %lu, %u free blocks after the remount, %lu to %lu, %u before\n",
+               (unsigned long)pStatistics->minEraseCount, (unsigned long)pStatistics->maxEraseCount,
+               pStatistics->freeBlocks,
+               (unsigned long)before.minEraseCount, (unsigned long)before.maxEraseCount,
+               before.freeBlocks);
+        return false;
+    }
+
+    if ((pStatistics->sectorWrites != 0) || (pStatistics->relocations != 0))
+    {
+        printf("    counters of the previous session were not cleared\n");
+        return false;
+    }
+
+    return TestAllCheck();
+}
+
+/*********************************************************************
+* Function: static bool TestPowerFail(void)
+*
+* Overview: Interrupts writes and garbage collection steps after a
+*           varying number of flash commands and remounts after each
+*           power failure.
+*
+* PreCondition: Every sector holds data (TestReadBack()).
+*
+* Input: none
+*
+* Output: true if the test passed
+*
+********************************************************************/
+static bool TestPowerFail(void)
+{
+    uint32_t write, sector, oldVersion;
+
+    for (write = 0; write < TEST_POWER_FAIL_WRITES; write++)
+    {
+        // mostly hot sectors, so garbage collection runs often
+        sector = ((write % 3) == 0) ? (write * 7) % TEST_SECTOR_COUNT : write % TEST_HOT_SECTORS;
+        oldVersion = testVersion[sector];
+
+        DRV_NVM_FLASH_SIM_PowerFailSet(write % TEST_POWER_FAIL_OPERATIONS);
+
+        TestSectorWrite(sector);
+        TestTasksRun();
+
+        DRV_NVM_FLASH_SIM_PowerFailSet(DRV_NVM_FLASH_SIM_POWER_FAIL_NEVER);
+
+        if (TestMount() == false)
+            return false;
+
+        // either version of the interrupted sector is correct
+        if (TestSectorCheck(sector, oldVersion + 1) == true)
+        {
+            testVersion[sector] = oldVersion + 1;
+        }
+        else if (TestSectorCheck(sector, oldVersion) == true)
+        {
+            testVersion[sector] = oldVersion;
+        }
+        else
+        {
+            printf("    sector %lu holds neither version after power fail %lu\n", (unsigned long)sector, (unsigned long)write);
+            return false;
+        }
+
+        if (TestAllCheck() == false)
+        {
+            printf("    after power fail %lu\n", (unsigned long)write);
+            return false;
+        }
+
+        // the translation layer must stay writable after the recovery
+        if (TestSectorWrite(sector) == false)
+        {
+            printf("    write after power fail %lu failed\n", (unsigned long)write);
+            return false;
+        }
+    }
+
+    if (DRV_NVM_FLASH_SIM_StatisticsGet()->programErrors != 0)
+    {
+        printf("    %lu writes programmed bits that were not erased\n", (unsigned long)DRV_NVM_FLASH_SIM_StatisticsGet()->programErrors);
+        return false;
+    }
+
+    return TestAllCheck();
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Main
+// *****************************************************************************
+// *****************************************************************************
+
+typedef struct
+{
+    const char  *pName;
+    bool        (*pTest)(void);
+} TEST_CASE;
+
+// the tests build on each other and run in this order
+static const TEST_CASE testCases[] =
+{
+    { "read_back",      TestReadBack },
+    { "wear_leveling",  TestWearLeveling },
+    { "remount",        TestRemount },
+    { "power_fail",     TestPowerFail },
+};
+
+int main(void)
+{
+    uint16_t i;
+    int failures = 0;
+
+    DRV_NVM_FLASH_SIM_Initialize();
+
+    for (i = 0; i < (sizeof(testCases) / sizeof(testCases[0])); i++)
+    {
+        if ((*testCases[i].pTest)() == true)
+        {
+            printf("%-16s passed\n", testCases[i].pName);
+        }
+        else
+        {
+            printf("%-16s FAILED\n", testCases[i].pName);
+            failures++;
+        }
+    }
+
+    return (failures != 0);
+}
@@ -0,0 +1,68 @@
+/*******************************************************************************
+ Flash Translation Layer Test - System Configuration
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    system_config.h
+
+  Summary:
+    Configuration of the host flash translation layer test.
+
+  Description:
+    This file sizes the simulated serial flash to the erase blocks used by
+    the flash translation layer, so the whole device is managed by the
+    layer. A small device makes every block go through many erase cycles
+    within the run time of the test.
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+Copyright (c) 2013 released Microchip Technology Inc.  All rights reserved.
+
+Microchip licenses to you the right to use, modify, copy and distribute
+Software only when embedded on a Microchip microcontroller or digital signal
+controller that is integrated into your product or third party product
+(pursuant to the sublicense terms in the accompanying license agreement).
+
+You should refer to the license agreement accompanying this Software for
+additional information regarding your rights and obligations.
+
+SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR PURPOSE.
+IN NO EVENT SHALL MICROCHIP OR ITS LICENSORS BE LIABLE OR OBLIGATED UNDER
+CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH OF WARRANTY, OR
+OTHER LEGAL EQUITABLE THEORY ANY DIRECT OR INDIRECT DAMAGES OR EXPENSES
+INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL, INDIRECT, PUNITIVE OR
+CONSEQUENTIAL DAMAGES, LOST PROFITS OR LOST DATA, COST OF PROCUREMENT OF
+SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
+(INCLUDING BUT NOT LIMITED TO ANY DEFENSE THEREOF), OR OTHER SIMILAR COSTS.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef _SYSTEM_CONFIG_H
+    #define _SYSTEM_CONFIG_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Flash Translation Layer Configuration
+// *****************************************************************************
+// *****************************************************************************
+#define DRV_FILEIO_CONFIG_FTL_BLOCK_SIZE            4096
+#define DRV_FILEIO_CONFIG_FTL_BLOCK_COUNT           32
+#define DRV_FILEIO_CONFIG_FTL_SPARE_BLOCKS          4
+#define DRV_FILEIO_CONFIG_FTL_GC_THRESHOLD          3
+#define DRV_FILEIO_CONFIG_FTL_WEAR_THRESHOLD        16
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Simulated Flash Configuration
+// *****************************************************************************
+// *****************************************************************************
+#define DRV_NVM_FLASH_SIM_CONFIG_SIZE               (DRV_FILEIO_CONFIG_FTL_BLOCK_SIZE * DRV_FILEIO_CONFIG_FTL_BLOCK_COUNT)
+#define DRV_NVM_FLASH_SIM_CONFIG_SECTOR_SIZE        DRV_FILEIO_CONFIG_FTL_BLOCK_SIZE
+#define DRV_NVM_FLASH_SIM_CONFIG_PAGE_SIZE          256ul
+
+#endif // _SYSTEM_CONFIG_H
@@ -0,0 +1,234 @@
+/*******************************************************************************
+ Display Driver for Microchip Graphics Library - Display Driver Layer
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    drv_gfx_framebuffer.h
+
+  Summary:
+    Display Driver header file for use with the Microchip Graphics Library.
+
+  Description:
+    This module implements a display driver that renders into a frame
+    buffer in RAM. It needs no display hardware and is intended for
+    running the Graphics Library on a host computer for profiling,
+    benchmarks and golden image tests. It supports 8 (RGB 3-3-2),
+    16 (RGB 5-6-5) and 24 (RGB 8-8-8) bpp color depths.
+
+    The driver is enabled by defining GFX_USE_DISPLAY_CONTROLLER_FRAMEBUFFER.
+    Define GFX_CONFIG_FRAMEBUFFER_STATISTICS_ENABLE to count the calls and
+    pixels of each driver function and GFX_CONFIG_FRAMEBUFFER_PPM_ENABLE
+    to be able to save the frame buffer as a PPM image (requires stdio).
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+Copyright (c) 2013 released Microchip Technology Inc.  All rights reserved.
+
+Microchip licenses to you the right to use, modify, copy and distribute
+Software only when embedded on a Microchip microcontroller or digital signal
+controller that is integrated into your product or third party product
+(pursuant to the sublicense terms in the accompanying license agreement).
+
+You should refer to the license agreement accompanying this Software for
+additional information regarding your rights and obligations.
+
+SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR PURPOSE.
+IN NO EVENT SHALL MICROCHIP OR ITS LICENSORS BE LIABLE OR OBLIGATED UNDER
+CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH OF WARRANTY, OR
+OTHER LEGAL EQUITABLE THEORY ANY DIRECT OR INDIRECT DAMAGES OR EXPENSES
+INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL, INDIRECT, PUNITIVE OR
+CONSEQUENTIAL DAMAGES, LOST PROFITS OR LOST DATA, COST OF PROCUREMENT OF
+SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
+(INCLUDING BUT NOT LIMITED TO ANY DEFENSE THEREOF), OR OTHER SIMILAR COSTS.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef _DRV_GFX_FRAMEBUFFER_H
+    #define _DRV_GFX_FRAMEBUFFER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "system_config.h"
+#include "gfx/gfx_types_macros.h"
+
+/*********************************************************************
+* Error Checking
+*********************************************************************/
+    #ifndef DISP_HOR_RESOLUTION
+        #error DISP_HOR_RESOLUTION must be defined in system.h
+    #endif
+    #ifndef DISP_VER_RESOLUTION
+        #error DISP_VER_RESOLUTION must be defined in system.h
+    #endif
+    #ifndef DISP_ORIENTATION
+        #error DISP_ORIENTATION must be defined in system.h
+    #endif
+    #ifndef GFX_CONFIG_COLOR_DEPTH
+        #error GFX_CONFIG_COLOR_DEPTH must be defined in GraphicsConfig.h
+    #endif
+
+/*********************************************************************
+* Overview: Color depth.
+*********************************************************************/
+    #if (GFX_CONFIG_COLOR_DEPTH != 8) && (GFX_CONFIG_COLOR_DEPTH != 16) && (GFX_CONFIG_COLOR_DEPTH != 24)
+        #error This driver supports 8, 16 and 24 BPP color depth only.
+    #endif
+
+// *****************************************************************************
+/*
+    <GROUP driver_framebuffer>
+
+    Typedef:
+        DRV_GFX_FRAMEBUFFER_COUNTER
+
+    Summary:
+        Number of calls and of rendered or read pixels of one driver
+        function.
+
+*/
+// *****************************************************************************
+typedef struct
+{
+    uint32_t    calls;                  // number of calls of the function
+    uint32_t    pixels;                 // number of pixels written or read
+} DRV_GFX_FRAMEBUFFER_COUNTER;
+
+// *****************************************************************************
+/*
+    <GROUP driver_framebuffer>
+
+    Typedef:
+        DRV_GFX_FRAMEBUFFER_STATISTICS
+
+    Summary:
+        Counters of the driver functions called by the primitive layer.
+
+    Description:
+        The counters are only updated when
+        GFX_CONFIG_FRAMEBUFFER_STATISTICS_ENABLE is defined.
+
+*/
+// *****************************************************************************
+typedef struct
+{
+    DRV_GFX_FRAMEBUFFER_COUNTER pixelPut;       // GFX_PixelPut()
+    DRV_GFX_FRAMEBUFFER_COUNTER pixelGet;       // GFX_PixelGet()
+    DRV_GFX_FRAMEBUFFER_COUNTER pixelArrayPut;  // GFX_PixelArrayPut()
+    DRV_GFX_FRAMEBUFFER_COUNTER pixelArrayGet;  // GFX_PixelArrayGet()
+    DRV_GFX_FRAMEBUFFER_COUNTER barDraw;        // GFX_BarDraw(), solid fills only
+    DRV_GFX_FRAMEBUFFER_COUNTER screenClear;    // GFX_ScreenClear()
+} DRV_GFX_FRAMEBUFFER_STATISTICS;
+
+// *****************************************************************************
+/*
+    <GROUP driver_framebuffer>
+
+    Function:
+        GFX_COLOR *DRV_GFX_FramebufferAddressGet(void)
+
+    Summary:
+        Returns the frame buffer of the driver.
+
+    Description:
+        The frame buffer is an array of (GFX_MaxXGet() + 1) *
+        (GFX_MaxYGet() + 1) GFX_COLOR values, stored row by row in
+        the orientation seen by the primitive layer.
+
+    Precondition:
+        None.
+
+    Parameters:
+        None.
+
+    Returns:
+        The address of the first pixel.
+
+*/
+// *****************************************************************************
+GFX_COLOR *DRV_GFX_FramebufferAddressGet(void);
+
+// *****************************************************************************
+/*
+    <GROUP driver_framebuffer>
+
+    Function:
+        DRV_GFX_FRAMEBUFFER_STATISTICS *DRV_GFX_FramebufferStatisticsGet(void)
+
+    Summary:
+        Returns the driver function counters.
+
+    Description:
+        The counters are accumulated until
+        DRV_GFX_FramebufferStatisticsClear() is called.
+
+    Precondition:
+        GFX_CONFIG_FRAMEBUFFER_STATISTICS_ENABLE must be defined.
+
+    Parameters:
+        None.
+
+    Returns:
+        The address of the counters.
+
+*/
+// *****************************************************************************
+DRV_GFX_FRAMEBUFFER_STATISTICS *DRV_GFX_FramebufferStatisticsGet(void);
+
+// *****************************************************************************
+/*
+    <GROUP driver_framebuffer>
+
+    Function:
+        void DRV_GFX_FramebufferStatisticsClear(void)
+
+    Summary:
+        Clears the driver function counters.
+
+    Precondition:
+        GFX_CONFIG_FRAMEBUFFER_STATISTICS_ENABLE must be defined.
+
+    Parameters:
+        None.
+
+    Returns:
+        None.
+
+*/
+// *****************************************************************************
+void DRV_GFX_FramebufferStatisticsClear(void);
+
+// *****************************************************************************
+/*
+    <GROUP driver_framebuffer>
+
+    Function:
+        bool DRV_GFX_FramebufferPPMWrite(const char *fileName)
+
+    Summary:
+        Saves the frame buffer as a binary PPM (P6) image.
+
+    Description:
+        The pixels are expanded to 8 bits per color component, so
+        frames of every color depth can be compared with the same
+        tools. The components are scaled by the level last set with
+        DRV_GFX_DisplayBrightness(), as the backlight would show them.
+
+    Precondition:
+        GFX_CONFIG_FRAMEBUFFER_PPM_ENABLE must be defined.
+
+    Parameters:
+        fileName - name of the file to create.
+
+    Returns:
+        true if the file was written, false otherwise.
+
+*/
+// *****************************************************************************
+bool DRV_GFX_FramebufferPPMWrite(const char *fileName);
+
+#endif // _DRV_GFX_FRAMEBUFFER_H
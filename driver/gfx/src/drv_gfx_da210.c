@@ -1104,6 +1104,17 @@ uint16_t DRV_GFX_BlockCopy(
 // *****************************************************************************
 GFX_STATUS GFX_PixelPut(uint16_t x, uint16_t y)
 {
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // the recorded commands are drawn before the pixels are written
+    GFX_DisplayListFlush();
+#endif
+
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+    // RAM surfaces are rendered by the primitive layer
+    if (GFX_SurfaceStatusGet() == GFX_FEATURE_ENABLED)
+        return (GFX_SurfacePixelPut(x, y));
+#endif
+
     // adjust (x,y) due to orientation set
     GFX_OrientationPixelAdjust(x,y);
 
@@ -1147,6 +1158,17 @@ GFX_COLOR GFX_PixelGet(uint16_t x, uint16_t y)
 {
     volatile uint16_t getcolor = 0;
     
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // the recorded commands are drawn before the pixels are read
+    GFX_DisplayListFlush();
+#endif
+
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+    // RAM surfaces are rendered by the primitive layer
+    if (GFX_SurfaceStatusGet() == GFX_FEATURE_ENABLED)
+        return (GFX_SurfacePixelGet(x, y));
+#endif
+
     if(x > GFX_MaxXGet() || y > GFX_MaxYGet())
     {
         return ((GFX_COLOR)0); /* return 1 */
@@ -1231,6 +1253,17 @@ uint16_t GFX_PixelArrayPut(
 {
     uint16_t    width, height;
 
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // the recorded commands are drawn before the pixels are written
+    GFX_DisplayListFlush();
+#endif
+
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+    // RAM surfaces are rendered by the primitive layer
+    if (GFX_SurfaceStatusGet() == GFX_FEATURE_ENABLED)
+        return (GFX_SurfacePixelArrayPut(x, y, pPixel, numPixels));
+#endif
+
 #if (DISP_ORIENTATION == 0) || (DISP_ORIENTATION == 180)
     width = numPixels;
     height = 1;
@@ -1320,6 +1353,17 @@ uint16_t GFX_PixelArrayGet(
 {
     uint16_t    width, height;
 
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // the recorded commands are drawn before the pixels are read
+    GFX_DisplayListFlush();
+#endif
+
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+    // RAM surfaces are rendered by the primitive layer
+    if (GFX_SurfaceStatusGet() == GFX_FEATURE_ENABLED)
+        return (GFX_SurfacePixelArrayGet(x, y, pPixel, numPixels));
+#endif
+
     while(GFX_RenderStatusGet() == GFX_STATUS_BUSY_BIT);
     
     #if (DISP_ORIENTATION == 0) || (DISP_ORIENTATION == 180)
@@ -1418,6 +1462,17 @@ GFX_STATUS GFX_BarDraw(uint16_t left, uint16_t top, uint16_t right, uint16_t bot
     uint16_t nRight, nBottom;
 #endif
 
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+    // only the part of the bar in the clip rectangle is rendered
+    if (GFX_ClipAreaAdjust(&left, &top, &right, &bottom) == GFX_STATUS_FAILURE)
+        return (GFX_STATUS_SUCCESS);
+#endif
+
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // recorded bars are drawn when the display list is drawn
+    if (GFX_DisplayListBarAdd(left, top, right, bottom) == GFX_STATUS_SUCCESS)
+        return (GFX_STATUS_SUCCESS);
+#endif
 
 #ifndef GFX_CONFIG_ALPHABLEND_DISABLE
     if (GFX_FillStyleGet() == GFX_FILL_STYLE_ALPHA_COLOR)
@@ -1434,6 +1489,12 @@ GFX_STATUS GFX_BarDraw(uint16_t left, uint16_t top, uint16_t right, uint16_t bot
     }
 #endif
 
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+    // RAM surfaces are rendered by the primitive layer
+    if (GFX_SurfaceStatusGet() == GFX_FEATURE_ENABLED)
+        return (GFX_SurfaceBarDraw(left, top, right, bottom));
+#endif
+
 #if (DISP_ORIENTATION == 0) || (DISP_ORIENTATION == 180)
     width   =   right - left + 1;
     height  =   bottom - top + 1;
@@ -1509,6 +1570,24 @@ GFX_STATUS GFX_ScreenClear(void)
 
     GFX_FILL_STYLE fillType;
 
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // the recorded clear hides all the commands recorded before it
+    if (GFX_DisplayListBarAdd(0, 0, GFX_MaxXGet(), GFX_MaxYGet()) == GFX_STATUS_SUCCESS)
+    {
+        GFX_LinePositionSet(0, 0);
+        return (GFX_STATUS_SUCCESS);
+    }
+#endif
+
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+    // RAM surfaces are cleared by the primitive layer
+    if (GFX_SurfaceStatusGet() == GFX_FEATURE_ENABLED)
+    {
+        GFX_LinePositionSet(0, 0);
+        return (GFX_SurfaceBarDraw(0, 0, GFX_MaxXGet(), GFX_MaxYGet()));
+    }
+#endif
+
     fillType = GFX_FillStyleGet();
     GFX_FillStyleSet(GFX_FILL_STYLE_COLOR);
 
@@ -1580,6 +1659,11 @@ GFX_STATUS GFX_StyledLineDraw(
     static uint16_t  left, top, right, bottom;
     static int16_t   temp;
 
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // the recorded commands are drawn before the line
+    GFX_DisplayListFlush();
+#endif
+
 #ifdef GFX_CONFIG_NONBLOCKING_DISABLE
     while(GFX_RenderStatusGet() == GFX_STATUS_BUSY_BIT)
         Nop();
@@ -0,0 +1,601 @@
+/*******************************************************************************
+ Display Driver for Microchip Graphics Library - Display Driver Layer
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    drv_gfx_framebuffer.c
+
+  Summary:
+    Display Driver for use with the Microchip Graphics Library.
+
+  Description:
+    This module implements a display driver that renders into a frame
+    buffer in RAM. It implements the basic Display Driver Layer API
+    required by the Microchip Graphics Library without any display
+    hardware, so the library can be run, profiled and tested on a host
+    computer.
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+Copyright (c) 2013 released Microchip Technology Inc.  All rights reserved.
+
+Microchip licenses to you the right to use, modify, copy and distribute
+Software only when embedded on a Microchip microcontroller or digital signal
+controller that is integrated into your product or third party product
+(pursuant to the sublicense terms in the accompanying license agreement).
+
+You should refer to the license agreement accompanying this Software for
+additional information regarding your rights and obligations.
+
+SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR PURPOSE.
+IN NO EVENT SHALL MICROCHIP OR ITS LICENSORS BE LIABLE OR OBLIGATED UNDER
+CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH OF WARRANTY, OR
+OTHER LEGAL EQUITABLE THEORY ANY DIRECT OR INDIRECT DAMAGES OR EXPENSES
+INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL, INDIRECT, PUNITIVE OR
+CONSEQUENTIAL DAMAGES, LOST PROFITS OR LOST DATA, COST OF PROCUREMENT OF
+SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
+(INCLUDING BUT NOT LIMITED TO ANY DEFENSE THEREOF), OR OTHER SIMILAR COSTS.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include "system.h"
+#include <stdint.h>
+
+#if defined (GFX_USE_DISPLAY_CONTROLLER_FRAMEBUFFER)
+
+#include <string.h>
+#if defined (GFX_CONFIG_FRAMEBUFFER_PPM_ENABLE)
+    #include <stdio.h>
+#endif
+
+#include "driver/gfx/drv_gfx_display.h"
+#include "driver/gfx/drv_gfx_framebuffer.h"
+#include "gfx/gfx_primitive.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Helper Macros and Variables
+// *****************************************************************************
+// *****************************************************************************
+
+#define DRV_GFX_FRAMEBUFFER_WIDTH   ((uint32_t)GFX_MaxXGet() + 1)
+#define DRV_GFX_FRAMEBUFFER_HEIGHT  ((uint32_t)GFX_MaxYGet() + 1)
+#define DRV_GFX_FRAMEBUFFER_SIZE    ((uint32_t)DISP_HOR_RESOLUTION * DISP_VER_RESOLUTION)
+
+/*********************************************************************
+* Macro:  DRV_GFX_FRAMEBUFFER_COUNT(counter, count)
+*
+* Overview: Adds one call and count pixels to the counter of a driver
+*           function when the statistics are enabled.
+*
+********************************************************************/
+#if defined (GFX_CONFIG_FRAMEBUFFER_STATISTICS_ENABLE)
+    #define DRV_GFX_FRAMEBUFFER_COUNT(counter, count)                  \
+                {                                                       \
+                    drvFramebufferStatistics.counter.calls++;           \
+                    drvFramebufferStatistics.counter.pixels += (count); \
+                }
+#else
+    #define DRV_GFX_FRAMEBUFFER_COUNT(counter, count)
+#endif
+
+static GFX_COLOR                        drvFramebuffer[DRV_GFX_FRAMEBUFFER_SIZE];
+
+// simulated backlight level, 0 (off) to 100
+static uint16_t                         drvFramebufferBrightness = 100;
+
+#if defined (GFX_CONFIG_FRAMEBUFFER_STATISTICS_ENABLE)
+static DRV_GFX_FRAMEBUFFER_STATISTICS   drvFramebufferStatistics;
+#endif
+
+/*********************************************************************
+* Function:  GFX_COLOR *DRV_GFX_FramebufferPixelAddressGet(x, y)
+*
+* Overview: Returns the address of the pixel at x, y.
+*
+********************************************************************/
+static inline GFX_COLOR *DRV_GFX_FramebufferPixelAddressGet(uint16_t x, uint16_t y)
+{
+    return (&drvFramebuffer[((uint32_t)y * DRV_GFX_FRAMEBUFFER_WIDTH) + x]);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Driver Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/*  Function:
+    void DRV_GFX_Initialize(void)
+
+    Summary:
+        Initialize the graphics display driver.
+
+    Description:
+        This function clears the frame buffer and the counters and
+        turns the simulated backlight fully on.
+
+*/
+// *****************************************************************************
+void DRV_GFX_Initialize(void)
+{
+    memset(drvFramebuffer, 0, sizeof(drvFramebuffer));
+    drvFramebufferBrightness = 100;
+
+#if defined (GFX_CONFIG_FRAMEBUFFER_STATISTICS_ENABLE)
+    DRV_GFX_FramebufferStatisticsClear();
+#endif
+}
+
+// *****************************************************************************
+/*  Function:
+    void DRV_GFX_DisplayBrightness(uint16_t level)
+
+    Summary:
+        Sets the brightness of the display.
+
+    Description:
+        The frame buffer has no backlight, the level (0 to 100, larger
+        values are limited to 100) is kept as a simulated backlight and
+        scales the colors saved by DRV_GFX_FramebufferPPMWrite(). The
+        frame buffer content is not changed.
+
+*/
+// *****************************************************************************
+void DRV_GFX_DisplayBrightness(uint16_t level)
+{
+    drvFramebufferBrightness = (level > 100) ? 100 : level;
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_PixelPut(
+                    uint16_t    x,
+                    uint16_t    y)
+
+    Summary:
+        Draw the pixel on the given position.
+
+    Description:
+        This routine draws the pixel on the given position.
+        The color used is the color set by the last call to
+        GFX_ColorSet(). Positions outside the frame buffer are
+        ignored.
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_PixelPut(uint16_t x, uint16_t y)
+{
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // the recorded commands are drawn before the pixels are written
+    GFX_DisplayListFlush();
+#endif
+
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+    // RAM surfaces are rendered by the primitive layer
+    if (GFX_SurfaceStatusGet() == GFX_FEATURE_ENABLED)
+        return (GFX_SurfacePixelPut(x, y));
+#endif
+
+    DRV_GFX_FRAMEBUFFER_COUNT(pixelPut, 1);
+
+    if((x < DRV_GFX_FRAMEBUFFER_WIDTH) && (y < DRV_GFX_FRAMEBUFFER_HEIGHT))
+    {
+        *DRV_GFX_FramebufferPixelAddressGet(x, y) = GFX_ColorGet();
+    }
+
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_COLOR GFX_PixelGet(
+                    uint16_t    x,
+                    uint16_t    y)
+
+    Summary:
+        Gets color of the pixel on the given position.
+
+    Description:
+        This routine gets the pixel on the given position.
+        Positions outside the frame buffer return 0.
+
+*/
+// *****************************************************************************
+GFX_COLOR GFX_PixelGet(uint16_t x, uint16_t y)
+{
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // the recorded commands are drawn before the pixels are read
+    GFX_DisplayListFlush();
+#endif
+
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+    // RAM surfaces are rendered by the primitive layer
+    if (GFX_SurfaceStatusGet() == GFX_FEATURE_ENABLED)
+        return (GFX_SurfacePixelGet(x, y));
+#endif
+
+    DRV_GFX_FRAMEBUFFER_COUNT(pixelGet, 1);
+
+    if((x < DRV_GFX_FRAMEBUFFER_WIDTH) && (y < DRV_GFX_FRAMEBUFFER_HEIGHT))
+    {
+        return (*DRV_GFX_FramebufferPixelAddressGet(x, y));
+    }
+
+    return (0);
+}
+
+// *****************************************************************************
+/*  Function:
+    uint16_t GFX_PixelArrayPut(
+                                uint16_t x,
+                                uint16_t y,
+                                GFX_COLOR *pPixel,
+                                uint16_t numPixels)
+
+    Summary:
+        Renders an array of pixels to the frame buffer.
+
+    Description:
+        This renders an array of pixels starting from the
+        location defined by x and y with the length
+        defined by numPixels. Pixels past the end of a line continue
+        on the next line; pixels past the end of the frame buffer are
+        dropped.
+
+        This function also supports transparent color feature.
+        When the feature is enabled the pixel with the transparent
+        color will not be rendered and will be skipped.
+
+*/
+// *****************************************************************************
+uint16_t GFX_PixelArrayPut(
+                                uint16_t x,
+                                uint16_t y,
+                                GFX_COLOR *pPixel,
+                                uint16_t numPixels)
+{
+    GFX_COLOR   *pDest;
+    uint32_t    offset, count;
+
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // the recorded commands are drawn before the pixels are written
+    GFX_DisplayListFlush();
+#endif
+
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+    // RAM surfaces are rendered by the primitive layer
+    if (GFX_SurfaceStatusGet() == GFX_FEATURE_ENABLED)
+        return (GFX_SurfacePixelArrayPut(x, y, pPixel, numPixels));
+#endif
+
+    DRV_GFX_FRAMEBUFFER_COUNT(pixelArrayPut, numPixels);
+
+    offset = ((uint32_t)y * DRV_GFX_FRAMEBUFFER_WIDTH) + x;
+    if(offset >= DRV_GFX_FRAMEBUFFER_SIZE)
+        return (0);
+
+    count = numPixels;
+    if(count > (DRV_GFX_FRAMEBUFFER_SIZE - offset))
+        count = DRV_GFX_FRAMEBUFFER_SIZE - offset;
+
+    pDest = &drvFramebuffer[offset];
+
+#ifndef GFX_CONFIG_TRANSPARENT_COLOR_DISABLE
+    if (GFX_TransparentColorStatusGet() == GFX_FEATURE_ENABLED)
+    {
+        GFX_COLOR   transparentColor = GFX_TransparentColorGet();
+        uint32_t    z;
+
+        for(z = 0; z < count; z++)
+        {
+            if(pPixel[z] != transparentColor)
+                pDest[z] = pPixel[z];
+        }
+    }
+    else
+#endif
+    {
+        memcpy(pDest, pPixel, count * sizeof(GFX_COLOR));
+    }
+
+    return (1);
+}
+
+// *****************************************************************************
+/*  Function:
+    uint16_t GFX_PixelArrayGet(
+                                uint16_t x,
+                                uint16_t y,
+                                GFX_COLOR *pPixel,
+                                uint16_t numPixels)
+
+    Summary:
+        Retrieves an array of pixels from the frame buffer.
+
+    Description:
+        This retrieves an array of pixels from the display buffer
+        starting from the location defined by x and y with
+        the length defined by numPixels. Pixels past the end of a
+        line are read from the next line.
+
+*/
+// *****************************************************************************
+uint16_t GFX_PixelArrayGet(
+                                uint16_t x,
+                                uint16_t y,
+                                GFX_COLOR *pPixel,
+                                uint16_t numPixels)
+{
+    uint32_t    offset, count;
+
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // the recorded commands are drawn before the pixels are read
+    GFX_DisplayListFlush();
+#endif
+
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+    // RAM surfaces are rendered by the primitive layer
+    if (GFX_SurfaceStatusGet() == GFX_FEATURE_ENABLED)
+        return (GFX_SurfacePixelArrayGet(x, y, pPixel, numPixels));
+#endif
+
+    DRV_GFX_FRAMEBUFFER_COUNT(pixelArrayGet, numPixels);
+
+    offset = ((uint32_t)y * DRV_GFX_FRAMEBUFFER_WIDTH) + x;
+    if(offset >= DRV_GFX_FRAMEBUFFER_SIZE)
+        return (0);
+
+    count = numPixels;
+    if(count > (DRV_GFX_FRAMEBUFFER_SIZE - offset))
+        count = DRV_GFX_FRAMEBUFFER_SIZE - offset;
+
+    memcpy(pPixel, &drvFramebuffer[offset], count * sizeof(GFX_COLOR));
+
+    return ((uint16_t)count);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_BarDraw(
+                                uint16_t left,
+                                uint16_t top,
+                                uint16_t right,
+                                uint16_t bottom)
+
+    Summary:
+        This function renders a bar shape using the currently set fill
+        style and color.
+
+    Description:
+        Solid bars are filled directly in the frame buffer, alpha
+        blended bars are passed to GFX_BarAlphaDraw(). The bar is
+        clipped to the frame buffer.
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_BarDraw(         uint16_t left,
+                                uint16_t top,
+                                uint16_t right,
+                                uint16_t bottom)
+{
+    GFX_COLOR   color, *pDest;
+    uint16_t    x, y, width;
+
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+    // only the part of the bar in the clip rectangle is rendered
+    if (GFX_ClipAreaAdjust(&left, &top, &right, &bottom) == GFX_STATUS_FAILURE)
+        return (GFX_STATUS_SUCCESS);
+#endif
+
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // recorded bars are drawn when the display list is drawn
+    if (GFX_DisplayListBarAdd(left, top, right, bottom) == GFX_STATUS_SUCCESS)
+        return (GFX_STATUS_SUCCESS);
+#endif
+
+#ifndef GFX_CONFIG_ALPHABLEND_DISABLE
+    if (GFX_FillStyleGet() == GFX_FILL_STYLE_ALPHA_COLOR)
+    {
+        if(GFX_AlphaBlendingValueGet() != 100)
+        {
+            if (GFX_BarAlphaDraw(left,top,right,bottom))
+                return (GFX_STATUS_SUCCESS);
+            else
+                return (GFX_STATUS_FAILURE);
+        }
+    }
+#endif
+
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+    // RAM surfaces are rendered by the primitive layer
+    if (GFX_SurfaceStatusGet() == GFX_FEATURE_ENABLED)
+        return (GFX_SurfaceBarDraw(left, top, right, bottom));
+#endif
+
+    if(right > GFX_MaxXGet())
+        right = GFX_MaxXGet();
+    if(bottom > GFX_MaxYGet())
+        bottom = GFX_MaxYGet();
+    if((left > right) || (top > bottom))
+    {
+        DRV_GFX_FRAMEBUFFER_COUNT(barDraw, 0);
+        return (GFX_STATUS_SUCCESS);
+    }
+
+    width = right - left + 1;
+    DRV_GFX_FRAMEBUFFER_COUNT(barDraw, (uint32_t)width * (bottom - top + 1));
+
+    color = GFX_ColorGet();
+    for(y = top; y <= bottom; y++)
+    {
+        pDest = DRV_GFX_FramebufferPixelAddressGet(left, y);
+        for(x = 0; x < width; x++)
+        {
+            pDest[x] = color;
+        }
+    }
+
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_ScreenClear(void)
+
+    Summary:
+        Clears the screen to the currently set color (GFX_ColorSet()).
+
+    Description:
+        This function clears the screen with the current color and sets
+        the line cursor position to (0, 0).
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_ScreenClear(void)
+{
+    GFX_COLOR   color = GFX_ColorGet();
+    uint32_t    counter;
+
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // the recorded clear hides all the commands recorded before it
+    if (GFX_DisplayListBarAdd(0, 0, GFX_MaxXGet(), GFX_MaxYGet()) == GFX_STATUS_SUCCESS)
+    {
+        GFX_LinePositionSet(0, 0);
+        return (GFX_STATUS_SUCCESS);
+    }
+#endif
+
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+    // RAM surfaces are cleared by the primitive layer
+    if (GFX_SurfaceStatusGet() == GFX_FEATURE_ENABLED)
+    {
+        GFX_LinePositionSet(0, 0);
+        return (GFX_SurfaceBarDraw(0, 0, GFX_MaxXGet(), GFX_MaxYGet()));
+    }
+#endif
+
+    DRV_GFX_FRAMEBUFFER_COUNT(screenClear, DRV_GFX_FRAMEBUFFER_SIZE);
+
+    for(counter = 0; counter < DRV_GFX_FRAMEBUFFER_SIZE; counter++)
+    {
+        drvFramebuffer[counter] = color;
+    }
+
+    GFX_LinePositionSet(0, 0);
+
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_RenderStatusGet()
+
+    Summary:
+        This function returns the driver's status on rendering.
+
+    Description:
+        The frame buffer is written synchronously, the driver is always
+        ready.
+
+*/
+// *****************************************************************************
+GFX_STATUS_BIT GFX_RenderStatusGet(void)
+{
+    return (GFX_STATUS_READY_BIT);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Frame Buffer Access Functions
+// *****************************************************************************
+// *****************************************************************************
+
+GFX_COLOR *DRV_GFX_FramebufferAddressGet(void)
+{
+    return (drvFramebuffer);
+}
+
+#if defined (GFX_CONFIG_FRAMEBUFFER_STATISTICS_ENABLE)
+
+DRV_GFX_FRAMEBUFFER_STATISTICS *DRV_GFX_FramebufferStatisticsGet(void)
+{
+    return (&drvFramebufferStatistics);
+}
+
+void DRV_GFX_FramebufferStatisticsClear(void)
+{
+    memset(&drvFramebufferStatistics, 0, sizeof(drvFramebufferStatistics));
+}
+
+#endif // #if defined (GFX_CONFIG_FRAMEBUFFER_STATISTICS_ENABLE)
+
+#if defined (GFX_CONFIG_FRAMEBUFFER_PPM_ENABLE)
+
+bool DRV_GFX_FramebufferPPMWrite(const char *fileName)
+{
+    FILE        *pFile;
+    GFX_COLOR   color;
+    uint8_t     rgb[3];
+    uint32_t    counter;
+    bool        result = true;
+
+    pFile = fopen(fileName, "wb");
+    if(pFile == NULL)
+        return (false);
+
+    fprintf(pFile, "P6\n%lu %lu\n255\n",
+            (unsigned long)DRV_GFX_FRAMEBUFFER_WIDTH, (unsigned long)DRV_GFX_FRAMEBUFFER_HEIGHT);
+
+    for(counter = 0; counter < DRV_GFX_FRAMEBUFFER_SIZE; counter++)
+    {
+        color = drvFramebuffer[counter];
+
+        // expand each component to 8 bits, replicating the upper bits
+#if (GFX_CONFIG_COLOR_DEPTH == 8)
+        rgb[0] = (color & 0xE0) | ((color & 0xE0) >> 3) | ((color & 0xE0) >> 6);
+        rgb[1] = ((color & 0x1C) << 3) | (color & 0x1C) | ((color & 0x1C) >> 3);
+        rgb[2] = (color & 0x03) * 0x55;
+#elif (GFX_CONFIG_COLOR_DEPTH == 16)
+        rgb[0] = ((color >> 8) & 0xF8) | ((color >> 13) & 0x07);
+        rgb[1] = ((color >> 3) & 0xFC) | ((color >> 9) & 0x03);
+        rgb[2] = ((color << 3) & 0xF8) | ((color >> 2) & 0x07);
+#else
+        rgb[0] = (uint8_t)(color >> 16);
+        rgb[1] = (uint8_t)(color >> 8);
+        rgb[2] = (uint8_t)color;
+#endif
+        if(drvFramebufferBrightness < 100)
+        {
+            rgb[0] = (uint8_t)(((uint16_t)rgb[0] * drvFramebufferBrightness) / 100);
+            rgb[1] = (uint8_t)(((uint16_t)rgb[1] * drvFramebufferBrightness) / 100);
+            rgb[2] = (uint8_t)(((uint16_t)rgb[2] * drvFramebufferBrightness) / 100);
+        }
+
+        if(fwrite(rgb, 1, 3, pFile) != 3)
+        {
+            result = false;
+            break;
+        }
+    }
+
+    if(fclose(pFile) != 0)
+        result = false;
+
+    return (result);
+}
+
+#endif // #if defined (GFX_CONFIG_FRAMEBUFFER_PPM_ENABLE)
+
+#endif // #if defined (GFX_USE_DISPLAY_CONTROLLER_FRAMEBUFFER)
@@ -592,6 +592,17 @@ GFX_STATUS GFX_PixelPut(uint16_t x, uint16_t y)
 {
     uint32_t   address;
 
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // the recorded commands are drawn before the pixels are written
+    GFX_DisplayListFlush();
+#endif
+
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+    // RAM surfaces are rendered by the primitive layer
+    if (GFX_SurfaceStatusGet() == GFX_FEATURE_ENABLED)
+        return (GFX_SurfacePixelPut(x, y));
+#endif
+
     address = (((uint32_t) (GFX_MaxXGet() + 1)) * y + x) << 1;
 
     DisplayEnable();      // enable SSD1926
@@ -624,6 +635,17 @@ GFX_COLOR GFX_PixelGet(uint16_t x, uint16_t y)
     uint32_t    address;
     DRIVER_UINT16_UNION value;
 
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // the recorded commands are drawn before the pixels are read
+    GFX_DisplayListFlush();
+#endif
+
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+    // RAM surfaces are rendered by the primitive layer
+    if (GFX_SurfaceStatusGet() == GFX_FEATURE_ENABLED)
+        return (GFX_SurfacePixelGet(x, y));
+#endif
+
     address = (((uint32_t) (GFX_MaxXGet() + 1)) * y + x) << 1;
     DisplayEnable();
     DRV_SSD1926_AddressSet(address);
@@ -710,6 +732,17 @@ uint16_t GFX_PixelArrayPut(
     uint16_t    newLeft, newTop, newRight, newBottom;
     uint32_t    address;
 
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // the recorded commands are drawn before the pixels are written
+    GFX_DisplayListFlush();
+#endif
+
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+    // RAM surfaces are rendered by the primitive layer
+    if (GFX_SurfaceStatusGet() == GFX_FEATURE_ENABLED)
+        return (GFX_SurfacePixelArrayPut(x, y, pPixel, numPixels));
+#endif
+
     newLeft   = x;
     newTop    = y;
     newRight  = x + numPixels - 1;
@@ -798,6 +831,17 @@ uint16_t GFX_PixelArrayGet(
     uint16_t            z;
     DRIVER_UINT16_UNION value;
 
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // the recorded commands are drawn before the pixels are read
+    GFX_DisplayListFlush();
+#endif
+
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+    // RAM surfaces are rendered by the primitive layer
+    if (GFX_SurfaceStatusGet() == GFX_FEATURE_ENABLED)
+        return (GFX_SurfacePixelArrayGet(x, y, pPixel, numPixels));
+#endif
+
     address = (((uint32_t) (GFX_MaxXGet() + 1)) * y + x) << 1;
 
     DisplayEnable();
@@ -977,6 +1021,11 @@ GFX_STATUS GFX_SolidLineDraw(   uint16_t x1, uint16_t y1,
     static uint16_t thickAdjustX, thickAdjustY, steep;
     static uint16_t lineType, lineThickness;
 
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // the recorded commands are drawn before the line
+    GFX_DisplayListFlush();
+#endif
+
     while(1)
     {
 
@@ -1130,6 +1179,18 @@ GFX_STATUS GFX_BarDraw(         uint16_t left,
                                 uint16_t bottom)
 {
 
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+    // only the part of the bar in the clip rectangle is rendered
+    if (GFX_ClipAreaAdjust(&left, &top, &right, &bottom) == GFX_STATUS_FAILURE)
+        return (GFX_STATUS_SUCCESS);
+#endif
+
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // recorded bars are drawn when the display list is drawn
+    if (GFX_DisplayListBarAdd(left, top, right, bottom) == GFX_STATUS_SUCCESS)
+        return (GFX_STATUS_SUCCESS);
+#endif
+
 #ifdef GFX_CONFIG_NONBLOCKING_DISABLE
     while(GFX_RenderStatusGet() == GFX_STATUS_BUSY_BIT);
 #else
@@ -1150,6 +1211,12 @@ GFX_STATUS GFX_BarDraw(         uint16_t left,
     }
 #endif
 
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+    // RAM surfaces are rendered by the primitive layer
+    if (GFX_SurfaceStatusGet() == GFX_FEATURE_ENABLED)
+        return (GFX_SurfaceBarDraw(left, top, right, bottom));
+#endif
+
     return (DRV_SSD1926_Bar2DDraw(left, top, right, bottom));
 
 }
@@ -1417,6 +1484,24 @@ GFX_STATUS  __attribute__ ((always_inline)) DRV_SSD1926_BarAlpha2DDraw(
 // *****************************************************************************
 GFX_STATUS GFX_ScreenClear(void)
 {
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // the recorded clear hides all the commands recorded before it
+    if (GFX_DisplayListBarAdd(0, 0, GFX_MaxXGet(), GFX_MaxYGet()) == GFX_STATUS_SUCCESS)
+    {
+        GFX_LinePositionSet(0, 0);
+        return (GFX_STATUS_SUCCESS);
+    }
+#endif
+
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+    // RAM surfaces are cleared by the primitive layer
+    if (GFX_SurfaceStatusGet() == GFX_FEATURE_ENABLED)
+    {
+        GFX_LinePositionSet(0, 0);
+        return (GFX_SurfaceBarDraw(0, 0, GFX_MaxXGet(), GFX_MaxYGet()));
+    }
+#endif
+
     // make sure the driver has no pending or ongoing rendering
     while(DRV_SSD1926_RegisterGet(REG_2D_220) == 0);
 
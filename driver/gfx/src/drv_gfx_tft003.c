@@ -364,6 +364,17 @@ void DRV_GFX_Initialize(void)
 // *****************************************************************************
 GFX_STATUS GFX_PixelPut(uint16_t x, uint16_t y)
 {
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // the recorded commands are drawn before the pixels are written
+    GFX_DisplayListFlush();
+#endif
+
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+    // RAM surfaces are rendered by the primitive layer
+    if (GFX_SurfaceStatusGet() == GFX_FEATURE_ENABLED)
+        return (GFX_SurfacePixelPut(x, y));
+#endif
+
     DisplayEnable();
     DRV_GFX_AddressSet(x, y);
 
@@ -401,6 +412,17 @@ GFX_COLOR GFX_PixelGet(uint16_t x, uint16_t y)
     GFX_COLOR result;
     uint8_t red, green, blue;
 
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // the recorded commands are drawn before the pixels are read
+    GFX_DisplayListFlush();
+#endif
+
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+    // RAM surfaces are rendered by the primitive layer
+    if (GFX_SurfaceStatusGet() == GFX_FEATURE_ENABLED)
+        return (GFX_SurfacePixelGet(x, y));
+#endif
+
     DisplayEnable();
     DRV_GFX_AddressSet(x, y);
 
@@ -478,6 +500,17 @@ uint16_t GFX_PixelArrayPut(
 {
     uint16_t    z;
 
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // the recorded commands are drawn before the pixels are written
+    GFX_DisplayListFlush();
+#endif
+
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+    // RAM surfaces are rendered by the primitive layer
+    if (GFX_SurfaceStatusGet() == GFX_FEATURE_ENABLED)
+        return (GFX_SurfacePixelArrayPut(x, y, pPixel, numPixels));
+#endif
+
     DisplayEnable();      
     DRV_GFX_AddressSet(x, y);
 
@@ -562,6 +595,17 @@ uint16_t GFX_PixelArrayGet(
     uint16_t            z;
     uint8_t             red, blue, green;
 
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // the recorded commands are drawn before the pixels are read
+    GFX_DisplayListFlush();
+#endif
+
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+    // RAM surfaces are rendered by the primitive layer
+    if (GFX_SurfaceStatusGet() == GFX_FEATURE_ENABLED)
+        return (GFX_SurfacePixelArrayGet(x, y, pPixel, numPixels));
+#endif
+
     DisplayEnable();
     DRV_GFX_AddressSet(x, y);
 
@@ -665,6 +709,18 @@ GFX_STATUS GFX_BarDraw(         uint16_t left,
 {
     register uint16_t x, y;
 
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+    // only the part of the bar in the clip rectangle is rendered
+    if (GFX_ClipAreaAdjust(&left, &top, &right, &bottom) == GFX_STATUS_FAILURE)
+        return (GFX_STATUS_SUCCESS);
+#endif
+
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // recorded bars are drawn when the display list is drawn
+    if (GFX_DisplayListBarAdd(left, top, right, bottom) == GFX_STATUS_SUCCESS)
+        return (GFX_STATUS_SUCCESS);
+#endif
+
 #if !defined(GFX_LIB_CFG_USE_NONBLOCKING)
     while (GFX_RenderStatusGet() != GFX_STATUS_READY_BIT);
 
@@ -687,6 +743,12 @@ GFX_STATUS GFX_BarDraw(         uint16_t left,
     }
 #endif
 
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+    // RAM surfaces are rendered by the primitive layer
+    if (GFX_SurfaceStatusGet() == GFX_FEATURE_ENABLED)
+        return (GFX_SurfaceBarDraw(left, top, right, bottom));
+#endif
+
     DisplayEnable();
     for(y = top; y < bottom + 1; y++)
     {
@@ -729,6 +791,24 @@ GFX_STATUS GFX_ScreenClear(void)
 {
     uint32_t   counter;
 
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // the recorded clear hides all the commands recorded before it
+    if (GFX_DisplayListBarAdd(0, 0, GFX_MaxXGet(), GFX_MaxYGet()) == GFX_STATUS_SUCCESS)
+    {
+        GFX_LinePositionSet(0, 0);
+        return (GFX_STATUS_SUCCESS);
+    }
+#endif
+
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+    // RAM surfaces are cleared by the primitive layer
+    if (GFX_SurfaceStatusGet() == GFX_FEATURE_ENABLED)
+    {
+        GFX_LinePositionSet(0, 0);
+        return (GFX_SurfaceBarDraw(0, 0, GFX_MaxXGet(), GFX_MaxYGet()));
+    }
+#endif
+
     DisplayEnable();
     DRV_GFX_AddressSet(0, 0);
 
@@ -0,0 +1,243 @@
+/********************************************************************
+ Software License Agreement:
+
+ The software supplied herewith by Microchip Technology Incorporated
+ (the "Company") for its PIC(R) Microcontroller is intended and
+ supplied to you, the Company's customer, for use solely and
+ exclusively on Microchip PIC Microcontroller products. The
+ software is owned by the Company and/or its supplier, and is
+ protected under applicable copyright laws. All rights are reserved.
+ Any use in violation of the foregoing restrictions may subject the
+ user to criminal sanctions under applicable laws, as well as to
+ civil liability for the breach of the terms and conditions of this
+ license.
+
+ THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+ WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+ IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+ CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *******************************************************************/
+#ifndef _DRV_NVM_FLASH_SIM_H
+#define _DRV_NVM_FLASH_SIM_H
+
+/************************************************************************
+ * Section:  Includes
+ ************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/************************************************************************
+ * Section:  Configuration
+ *
+ * The simulator models a serial NOR flash (SST25/M25P style) in RAM so
+ * that code layered on top of the driver/nvm drivers can be exercised
+ * on a host machine. The defaults match the SST25VF064 geometry but
+ * use a smaller array; override them in system_config.h if needed.
+ ************************************************************************/
+#ifndef DRV_NVM_FLASH_SIM_CONFIG_SIZE
+    // total size of the simulated device in bytes
+    #define DRV_NVM_FLASH_SIM_CONFIG_SIZE           (1024ul * 1024ul)
+#endif
+
+#ifndef DRV_NVM_FLASH_SIM_CONFIG_SECTOR_SIZE
+    // size of the smallest erasable unit in bytes
+    #define DRV_NVM_FLASH_SIM_CONFIG_SECTOR_SIZE    4096ul
+#endif
+
+#ifndef DRV_NVM_FLASH_SIM_CONFIG_PAGE_SIZE
+    // size of the program page, writes that cross a page are split into page writes
+    #define DRV_NVM_FLASH_SIM_CONFIG_PAGE_SIZE      256ul
+#endif
+
+#define DRV_NVM_FLASH_SIM_SECTOR_COUNT  (DRV_NVM_FLASH_SIM_CONFIG_SIZE / DRV_NVM_FLASH_SIM_CONFIG_SECTOR_SIZE)
+
+// value for DRV_NVM_FLASH_SIM_PowerFailSet() that keeps the power on
+#define DRV_NVM_FLASH_SIM_POWER_FAIL_NEVER  0xFFFFFFFFul
+
+/*********************************************************************
+* Overview: Operation counters of the simulated device. They are used
+*           to measure how much programming and erasing a layer on
+*           top of the driver causes.
+*********************************************************************/
+typedef struct
+{
+    uint32_t readCount;         // number of read commands
+    uint32_t readBytes;         // number of bytes read
+    uint32_t writeCount;        // number of write commands
+    uint32_t writeBytes;        // number of bytes programmed
+    uint32_t eraseCount;        // number of sector erase commands
+    uint32_t programErrors;     // writes that tried to program a 0 bit back to 1
+} DRV_NVM_FLASH_SIM_STATISTICS;
+
+/******************************************************************************
+  Function:
+    void DRV_NVM_FLASH_SIM_Initialize( void )
+
+  Summary:
+    Initializes the simulated flash device.
+
+  Description:
+    This routine sets the whole simulated memory to the erased state
+    (0xFF), clears the erase counters of every sector and resets the
+    operation statistics.
+
+  Parameters:
+    None
+
+  Returns:
+    None
+******************************************************************************/
+void    DRV_NVM_FLASH_SIM_Initialize(void);
+
+/******************************************************************************
+  Function:
+    uint8_t DRV_NVM_FLASH_SIM_Write(   uint32_t address,
+                                       uint8_t *pData,
+                                       uint16_t nCount )
+
+  Summary:
+    Writes an array of bytes to a specified address.
+
+  Description:
+    This routine programs the array of bytes from the location pointed
+    to by pData to the given address. Like on a NOR device, programming
+    can only clear bits; the stored value is the bitwise AND of the old
+    and the new data. Writes that cross a page boundary are split into
+    page writes the same way DRV_NVM_SST25VF064_Write() does.
+
+  Parameters:
+    address - starting address of the array to be written
+    pData   - pointer to the source of the array
+    nCount  - specifies the number of bytes to be written
+
+  Returns:
+    1 - if the write is successful (read back data matches pData)
+    0 - if the write was not successful
+******************************************************************************/
+uint8_t DRV_NVM_FLASH_SIM_Write(uint32_t address, uint8_t *pData, uint16_t nCount);
+
+/******************************************************************************
+  Function:
+    void DRV_NVM_FLASH_SIM_Read(   uint32_t address,
+                                   uint8_t *pData,
+                                   uint16_t nCount )
+
+  Summary:
+    Reads an array of bytes from the specified address.
+
+  Description:
+    This routine reads an array of bytes from the specified address
+    location. Reads past the end of the device wrap to address 0.
+
+  Parameters:
+    address - starting address of the array to be read
+    pData   - pointer to the destination of the read array
+    nCount  - specifies the number of bytes to be read
+
+  Returns:
+    None
+******************************************************************************/
+void    DRV_NVM_FLASH_SIM_Read(uint32_t address, uint8_t *pData, uint16_t nCount);
+
+/******************************************************************************
+  Function:
+    void DRV_NVM_FLASH_SIM_ChipErase( void )
+
+  Summary:
+    Erase the simulated flash device.
+
+  Description:
+    This routine erases the whole memory and increments the erase
+    counter of every sector.
+
+  Parameters:
+    None
+
+  Returns:
+    None
+ ******************************************************************************/
+void    DRV_NVM_FLASH_SIM_ChipErase(void);
+
+/******************************************************************************
+  Function:
+    void DRV_NVM_FLASH_SIM_SectorErase( uint32_t address )
+
+  Summary:
+    Erase the sector specified by the given address.
+
+  Description:
+    This routine erases the sector of where the given address resides
+    and increments the erase counter of the sector.
+
+  Parameters:
+    address - any address inside the sector to be erased
+
+  Returns:
+    None
+******************************************************************************/
+void    DRV_NVM_FLASH_SIM_SectorErase(uint32_t address);
+
+/******************************************************************************
+  Function:
+    uint32_t DRV_NVM_FLASH_SIM_EraseCountGet( uint32_t address )
+
+  Summary:
+    Returns the number of times a sector was erased.
+
+  Description:
+    This routine returns the erase counter of the sector of where the
+    given address resides. It is used to check wear leveling.
+
+  Parameters:
+    address - any address inside the sector
+
+  Returns:
+    Number of erase cycles of the sector.
+******************************************************************************/
+uint32_t DRV_NVM_FLASH_SIM_EraseCountGet(uint32_t address);
+
+/******************************************************************************
+  Function:
+    DRV_NVM_FLASH_SIM_STATISTICS * DRV_NVM_FLASH_SIM_StatisticsGet( void )
+
+  Summary:
+    Returns the operation counters of the simulated device.
+
+  Description:
+    This routine returns a pointer to the operation counters. The
+    counters may be cleared by the caller at any time.
+
+  Parameters:
+    None
+
+  Returns:
+    Pointer to the statistics structure.
+******************************************************************************/
+DRV_NVM_FLASH_SIM_STATISTICS * DRV_NVM_FLASH_SIM_StatisticsGet(void);
+
+/******************************************************************************
+  Function:
+    void DRV_NVM_FLASH_SIM_PowerFailSet( uint32_t operations )
+
+  Summary:
+    Simulates a power failure after a number of operations.
+
+  Description:
+    After the given number of write or erase commands every further
+    write and erase is ignored, as if power was removed from the
+    device. This is used to check the recovery of layers that keep
+    metadata in the flash. Passing DRV_NVM_FLASH_SIM_POWER_FAIL_NEVER
+    disables the simulation.
+
+  Parameters:
+    operations - number of write or erase commands that will still
+                 be executed.
+
+  Returns:
+    None
+******************************************************************************/
+void    DRV_NVM_FLASH_SIM_PowerFailSet(uint32_t operations);
+
+#endif //_DRV_NVM_FLASH_SIM_H
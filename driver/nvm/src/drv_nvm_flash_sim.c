@@ -0,0 +1,356 @@
+/********************************************************************
+ Software License Agreement:
+
+ The software supplied herewith by Microchip Technology Incorporated
+ (the "Company") for its PIC(R) Microcontroller is intended and
+ supplied to you, the Company's customer, for use solely and
+ exclusively on Microchip PIC Microcontroller products. The
+ software is owned by the Company and/or its supplier, and is
+ protected under applicable copyright laws. All rights are reserved.
+ Any use in violation of the foregoing restrictions may subject the
+ user to criminal sanctions under applicable laws, as well as to
+ civil liability for the breach of the terms and conditions of this
+ license.
+
+ THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+ WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+ IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+ CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *******************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+#include "driver/nvm/drv_nvm_flash_sim.h"
+
+#if (DRV_NVM_FLASH_SIM_CONFIG_SIZE % DRV_NVM_FLASH_SIM_CONFIG_SECTOR_SIZE)
+    #error "The simulated flash size must be a multiple of the sector size."
+#endif
+
+#if (DRV_NVM_FLASH_SIM_CONFIG_SECTOR_SIZE % DRV_NVM_FLASH_SIM_CONFIG_PAGE_SIZE)
+    #error "The simulated sector size must be a multiple of the page size."
+#endif
+
+// internal data
+static uint8_t                      flashMemory[DRV_NVM_FLASH_SIM_CONFIG_SIZE];
+static uint32_t                     flashEraseCount[DRV_NVM_FLASH_SIM_SECTOR_COUNT];
+static DRV_NVM_FLASH_SIM_STATISTICS flashStatistics;
+static uint32_t                     flashPowerLeft = DRV_NVM_FLASH_SIM_POWER_FAIL_NEVER;
+
+// internal functions
+static bool DRV_NVM_FLASH_SIM_PowerAvailable(void);
+static uint8_t DRV_NVM_FLASH_SIM_WritePage(uint32_t address, uint8_t *pData, uint16_t nCount);
+
+/******************************************************************************
+  Function:
+    void DRV_NVM_FLASH_SIM_Initialize( void )
+
+  Summary:
+    Initializes the simulated flash device.
+
+  Description:
+    This routine sets the whole simulated memory to the erased state
+    (0xFF), clears the erase counters of every sector and resets the
+    operation statistics.
+
+  Parameters:
+    None
+
+  Returns:
+    None
+******************************************************************************/
+void DRV_NVM_FLASH_SIM_Initialize(void)
+{
+    memset(flashMemory, 0xFF, sizeof(flashMemory));
+    memset(flashEraseCount, 0x00, sizeof(flashEraseCount));
+    memset(&flashStatistics, 0x00, sizeof(flashStatistics));
+    flashPowerLeft = DRV_NVM_FLASH_SIM_POWER_FAIL_NEVER;
+}
+
+/******************************************************************************
+  Function:
+    static bool DRV_NVM_FLASH_SIM_PowerAvailable( void )
+
+  Summary:
+    Checks the simulated power failure counter.
+
+  Description:
+    This is an internal function called before every write and erase
+    command. It consumes one operation of the power fail counter.
+
+  Parameters:
+    None
+
+  Returns:
+    true  - the command may be executed
+    false - the power has failed, the command must be ignored
+******************************************************************************/
+static bool DRV_NVM_FLASH_SIM_PowerAvailable(void)
+{
+    if (flashPowerLeft == DRV_NVM_FLASH_SIM_POWER_FAIL_NEVER)
+        return true;
+
+    if (flashPowerLeft == 0)
+        return false;
+
+    flashPowerLeft--;
+    return true;
+}
+
+/******************************************************************************
+  Function:
+    static uint8_t DRV_NVM_FLASH_SIM_WritePage( uint32_t address,
+                                                uint8_t *pData,
+                                                uint16_t nCount )
+
+  Summary:
+    Programs the bytes of one page.
+
+  Description:
+    This routine is internal to this module. The caller makes sure the
+    array does not cross a page boundary. Only 1 to 0 transitions are
+    performed, an attempt to set a bit is counted as a program error.
+
+  Parameters:
+    address - starting address of the array to be written
+    pData   - pointer to the source of the array
+    nCount  - specifies the number of bytes to be written
+
+  Returns:
+    1 - if the write is successful
+    0 - if the write was not successful
+******************************************************************************/
+static uint8_t DRV_NVM_FLASH_SIM_WritePage(uint32_t address, uint8_t *pData, uint16_t nCount)
+{
+    uint16_t    counter;
+    uint8_t     *pFlash, ret = 1;
+
+    if (DRV_NVM_FLASH_SIM_PowerAvailable() == false)
+        return (0);
+
+    flashStatistics.writeCount++;
+    flashStatistics.writeBytes += nCount;
+
+    pFlash = &flashMemory[address % DRV_NVM_FLASH_SIM_CONFIG_SIZE];
+
+    for (counter = 0; counter < nCount; counter++)
+    {
+        if ((~pFlash[counter]) & pData[counter])
+        {
+            flashStatistics.programErrors++;
+            ret = 0;
+        }
+        pFlash[counter] &= pData[counter];
+    }
+
+    return (ret);
+}
+
+/******************************************************************************
+  Function:
+    uint8_t DRV_NVM_FLASH_SIM_Write(   uint32_t address,
+                                       uint8_t *pData,
+                                       uint16_t nCount )
+
+  Summary:
+    Writes an array of bytes to a specified address.
+
+  Description:
+    This routine programs the array of bytes from the location pointed
+    to by pData to the given address. Writes that cross a page boundary
+    are split into page writes.
+
+  Parameters:
+    address - starting address of the array to be written
+    pData   - pointer to the source of the array
+    nCount  - specifies the number of bytes to be written
+
+  Returns:
+    1 - if the write is successful
+    0 - if the write was not successful
+******************************************************************************/
+uint8_t DRV_NVM_FLASH_SIM_Write(uint32_t address, uint8_t *pData, uint16_t nCount)
+{
+    uint16_t    counter, sendCount;
+    uint8_t     ret = 1;
+
+    for (counter = 0; counter < nCount; )
+    {
+        sendCount = DRV_NVM_FLASH_SIM_CONFIG_PAGE_SIZE - (address & (DRV_NVM_FLASH_SIM_CONFIG_PAGE_SIZE - 1));
+        if (sendCount > (nCount - counter))
+            sendCount = (nCount - counter);
+
+        if (DRV_NVM_FLASH_SIM_WritePage(address, pData, sendCount) == 0)
+            ret = 0;
+
+        address += sendCount;
+        pData   += sendCount;
+        counter += sendCount;
+    }
+
+    return (ret);
+}
+
+/******************************************************************************
+  Function:
+    void DRV_NVM_FLASH_SIM_Read(   uint32_t address,
+                                   uint8_t *pData,
+                                   uint16_t nCount )
+
+  Summary:
+    Reads an array of bytes from the specified address.
+
+  Description:
+    This routine reads an array of bytes from the specified address
+    location. Reads past the end of the device wrap to address 0.
+
+  Parameters:
+    address - starting address of the array to be read
+    pData   - pointer to the destination of the read array
+    nCount  - specifies the number of bytes to be read
+
+  Returns:
+    None
+******************************************************************************/
+void DRV_NVM_FLASH_SIM_Read(uint32_t address, uint8_t *pData, uint16_t nCount)
+{
+    flashStatistics.readCount++;
+    flashStatistics.readBytes += nCount;
+
+    while (nCount--)
+    {
+        *pData++ = flashMemory[address % DRV_NVM_FLASH_SIM_CONFIG_SIZE];
+        address++;
+    }
+}
+
+/******************************************************************************
+  Function:
+    void DRV_NVM_FLASH_SIM_ChipErase( void )
+
+  Summary:
+    Erase the simulated flash device.
+
+  Description:
+    This routine erases the whole memory and increments the erase
+    counter of every sector.
+
+  Parameters:
+    None
+
+  Returns:
+    None
+ ******************************************************************************/
+void DRV_NVM_FLASH_SIM_ChipErase(void)
+{
+    uint32_t    sector;
+
+    if (DRV_NVM_FLASH_SIM_PowerAvailable() == false)
+        return;
+
+    memset(flashMemory, 0xFF, sizeof(flashMemory));
+
+    for (sector = 0; sector < DRV_NVM_FLASH_SIM_SECTOR_COUNT; sector++)
+        flashEraseCount[sector]++;
+
+    flashStatistics.eraseCount += DRV_NVM_FLASH_SIM_SECTOR_COUNT;
+}
+
+/******************************************************************************
+  Function:
+    void DRV_NVM_FLASH_SIM_SectorErase( uint32_t address )
+
+  Summary:
+    Erase the sector specified by the given address.
+
+  Description:
+    This routine erases the sector of where the given address resides
+    and increments the erase counter of the sector.
+
+  Parameters:
+    address - any address inside the sector to be erased
+
+  Returns:
+    None
+******************************************************************************/
+void DRV_NVM_FLASH_SIM_SectorErase(uint32_t address)
+{
+    uint32_t    sector;
+
+    if (DRV_NVM_FLASH_SIM_PowerAvailable() == false)
+        return;
+
+    sector = (address % DRV_NVM_FLASH_SIM_CONFIG_SIZE) / DRV_NVM_FLASH_SIM_CONFIG_SECTOR_SIZE;
+
+    memset(&flashMemory[sector * DRV_NVM_FLASH_SIM_CONFIG_SECTOR_SIZE], 0xFF, DRV_NVM_FLASH_SIM_CONFIG_SECTOR_SIZE);
+
+    flashEraseCount[sector]++;
+    flashStatistics.eraseCount++;
+}
+
+/******************************************************************************
+  Function:
+    uint32_t DRV_NVM_FLASH_SIM_EraseCountGet( uint32_t address )
+
+  Summary:
+    Returns the number of times a sector was erased.
+
+  Description:
+    This routine returns the erase counter of the sector of where the
+    given address resides.
+
+  Parameters:
+    address - any address inside the sector
+
+  Returns:
+    Number of erase cycles of the sector.
+******************************************************************************/
+uint32_t DRV_NVM_FLASH_SIM_EraseCountGet(uint32_t address)
+{
+    return flashEraseCount[(address % DRV_NVM_FLASH_SIM_CONFIG_SIZE) / DRV_NVM_FLASH_SIM_CONFIG_SECTOR_SIZE];
+}
+
+/******************************************************************************
+  Function:
+    DRV_NVM_FLASH_SIM_STATISTICS * DRV_NVM_FLASH_SIM_StatisticsGet( void )
+
+  Summary:
+    Returns the operation counters of the simulated device.
+
+  Description:
+    This routine returns a pointer to the operation counters.
+
+  Parameters:
+    None
+
+  Returns:
+    Pointer to the statistics structure.
+******************************************************************************/
+DRV_NVM_FLASH_SIM_STATISTICS * DRV_NVM_FLASH_SIM_StatisticsGet(void)
+{
+    return &flashStatistics;
+}
+
+/******************************************************************************
+  Function:
+    void DRV_NVM_FLASH_SIM_PowerFailSet( uint32_t operations )
+
+  Summary:
+    Simulates a power failure after a number of operations.
+
+  Description:
+    After the given number of write or erase commands every further
+    write and erase is ignored.
+
+  Parameters:
+    operations - number of write or erase commands that will still
+                 be executed.
+
+  Returns:
+    None
+******************************************************************************/
+void DRV_NVM_FLASH_SIM_PowerFailSet(uint32_t operations)
+{
+    flashPowerLeft = operations;
+}
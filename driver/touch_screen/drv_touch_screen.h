@@ -178,6 +178,72 @@ int16_t TouchGetRawY(void);
 ********************************************************************/
 void TouchGetMsg(GFX_GOL_MESSAGE *pMsg);
 
+/*********************************************************************
+* Function: void TouchGetCoalescedMsg(GFX_GOL_MESSAGE* pMsg)
+*
+* PreCondition: none
+*
+* Input: pointer to the message structure to be populated
+*
+* Output: none
+*
+* Side Effects: none
+*
+* Overview: populates GOL message structure like TouchGetMsg(). When
+*           TOUCHSCREEN_SAMPLE_BUFFER_ENABLE is defined, consecutive
+*           queued EVENT_MOVE messages are merged into the last one so
+*           GFX_GOL_ObjectMessage() is called once per drag step.
+*
+* Note: none
+*
+********************************************************************/
+void TouchGetCoalescedMsg(GFX_GOL_MESSAGE *pMsg);
+
+/*********************************************************************
+* Function: void TouchSampleTasks(void)
+*
+* PreCondition: TouchInit() must be called before
+*
+* Input: none
+*
+* Output: none
+*
+* Side Effects: none
+*
+* Overview: Runs the touch acquisition and queues filtered press, move
+*           and release messages for TouchGetMsg(). Call it from a
+*           periodic timer interrupt instead of TouchDetectPosition().
+*           The positions are filtered with a median of three and an
+*           IIR low pass (TOUCHSCREEN_SAMPLE_IIR_SHIFT). The acquisition
+*           rate is set by the timer and by
+*           TOUCHSCREEN_SAMPLE_PRESSED_DIVIDER and
+*           TOUCHSCREEN_SAMPLE_IDLE_DIVIDER.
+*
+* Note: Only available when TOUCHSCREEN_SAMPLE_BUFFER_ENABLE is defined.
+*
+********************************************************************/
+void TouchSampleTasks(void);
+
+/*********************************************************************
+* Function: void TouchSampleBufferFlush(void)
+*
+* PreCondition: none
+*
+* Input: none
+*
+* Output: none
+*
+* Side Effects: none
+*
+* Overview: Drops the queued touch screen messages. A touch that is
+*           still held is reported again with EVENT_PRESS, a touch
+*           released after the flush is not reported.
+*
+* Note: Only available when TOUCHSCREEN_SAMPLE_BUFFER_ENABLE is defined.
+*
+********************************************************************/
+void TouchSampleBufferFlush(void);
+
 /*********************************************************************
 * Function: void TouchCalibration()
 *
@@ -87,6 +87,60 @@ NVM_SECTORERASE_FUNC    pCalDataSectorErase = NULL;         // function pointer
 //////////////////////// GLOBAL VARIABLES ////////////////////////////
 #define CALIBRATION_DELAY   300                             // delay between calibration touch points
 
+//////////////////////// BUFFERED SAMPLING ///////////////////////////
+// Define TOUCHSCREEN_SAMPLE_BUFFER_ENABLE in system_config.h and call
+// TouchSampleTasks() from a periodic timer interrupt instead of calling
+// TouchDetectPosition(). Filtered samples are queued as GOL messages and
+// TouchGetMsg() returns them in order.
+#ifdef TOUCHSCREEN_SAMPLE_BUFFER_ENABLE
+
+#ifndef TOUCHSCREEN_SAMPLE_BUFFER_SIZE
+    #define TOUCHSCREEN_SAMPLE_BUFFER_SIZE      16      // number of queued messages, power of 2 between 4 and 256
+#endif
+#if (TOUCHSCREEN_SAMPLE_BUFFER_SIZE < 4) || (TOUCHSCREEN_SAMPLE_BUFFER_SIZE > 256) || \
+    (TOUCHSCREEN_SAMPLE_BUFFER_SIZE & (TOUCHSCREEN_SAMPLE_BUFFER_SIZE - 1))
+    #error TOUCHSCREEN_SAMPLE_BUFFER_SIZE must be a power of 2 between 4 and 256.
+#endif
+
+#ifndef TOUCHSCREEN_SAMPLE_IIR_SHIFT
+    #define TOUCHSCREEN_SAMPLE_IIR_SHIFT        2       // filter = filter + (sample - filter) / 2^shift, 0 disables the IIR
+#endif
+
+// the sampling rate is the timer rate divided by the steps of one acquisition
+// plus the divider, so the ADC is sampled less often while nothing is touched
+#ifndef TOUCHSCREEN_SAMPLE_PRESSED_DIVIDER
+    #define TOUCHSCREEN_SAMPLE_PRESSED_DIVIDER  1       // timer ticks between acquisitions while pressed
+#endif
+#ifndef TOUCHSCREEN_SAMPLE_IDLE_DIVIDER
+    #define TOUCHSCREEN_SAMPLE_IDLE_DIVIDER     8       // timer ticks between acquisitions while released
+#endif
+
+#define TOUCH_SAMPLE_MASK           (TOUCHSCREEN_SAMPLE_BUFFER_SIZE - 1)
+#define TOUCH_SAMPLE_FRACTION_BITS  4                   // fraction bits of the IIR state
+#define TOUCH_SAMPLE_MOVE_RESERVE   2                   // entries kept free for press and release
+
+// written by TouchSampleTasks() only
+static GFX_GOL_MESSAGE      touchSampleQueue[TOUCHSCREEN_SAMPLE_BUFFER_SIZE];
+static volatile uint8_t     touchSampleHead = 0;
+static int16_t              touchMedianX[3], touchMedianY[3];
+static uint8_t              touchMedianIndex;
+static int32_t              touchFilterX, touchFilterY;
+static bool                 touchFilterValid = false;
+static bool                 touchReportedPressed = false;
+static int16_t              touchReportedX, touchReportedY;
+static int16_t              touchLastX, touchLastY;
+static uint16_t             touchSampleDelay = 0;
+
+// set by TouchSampleBufferFlush(), cleared by TouchSampleTasks()
+static volatile bool        touchSampleFlush = false;
+
+// written by TouchGetMsg() only
+static volatile uint8_t     touchSampleTail = 0;
+static bool                 touchMsgPressed = false;
+static int16_t              touchMsgX, touchMsgY;
+
+#endif // #ifdef TOUCHSCREEN_SAMPLE_BUFFER_ENABLE
+
 #if (GFX_CONFIG_COLOR_DEPTH == 8) || (GFX_CONFIG_COLOR_DEPTH == 16) || (GFX_CONFIG_COLOR_DEPTH == 24)
     #define RESISTIVETOUCH_MSG_BACKGROUND_COLOR     WHITE
     #define RESISTIVETOUCH_MSG_FOREGROUND1_COLOR    BRIGHTRED
@@ -166,6 +220,11 @@ void TouchInit(NVM_WRITE_FUNC pWriteFunc, NVM_READ_FUNC pReadFunc, NVM_SECTORERA
         TouchCalibration();
     }
 
+#ifdef TOUCHSCREEN_SAMPLE_BUFFER_ENABLE
+    // drop the touches of the calibration screens
+    TouchSampleBufferFlush();
+#endif
+
 }
 
 /*********************************************************************
@@ -186,6 +245,46 @@ void TouchInit(NVM_WRITE_FUNC pWriteFunc, NVM_READ_FUNC pReadFunc, NVM_SECTORERA
 ********************************************************************/
 void TouchGetMsg(GFX_GOL_MESSAGE *pMsg)
 {
+#ifdef TOUCHSCREEN_SAMPLE_BUFFER_ENABLE
+    uint8_t           tail = touchSampleTail;
+
+    if(tail == touchSampleHead)
+    {
+        // nothing queued, the touch is unchanged since the last message
+        pMsg->type = TYPE_TOUCHSCREEN;
+        pMsg->uiEvent = (touchMsgPressed) ? EVENT_STILLPRESS : EVENT_INVALID;
+        pMsg->param1 = (touchMsgPressed) ? touchMsgX : -1;
+        pMsg->param2 = (touchMsgPressed) ? touchMsgY : -1;
+        return;
+    }
+
+    *pMsg = touchSampleQueue[tail];
+    touchSampleTail = (tail + 1) & TOUCH_SAMPLE_MASK;
+
+    // TouchSampleBufferFlush() may have dropped the press or release of a
+    // touch, keep the press, move, release order the objects rely on
+    if(touchMsgPressed == false)
+    {
+        if(pMsg->uiEvent == EVENT_MOVE)
+        {
+            pMsg->uiEvent = EVENT_PRESS;
+        }
+        else if(pMsg->uiEvent == EVENT_RELEASE)
+        {
+            pMsg->uiEvent = EVENT_INVALID;
+            pMsg->param1 = -1;
+            pMsg->param2 = -1;
+        }
+    }
+    else if(pMsg->uiEvent == EVENT_PRESS)
+    {
+        pMsg->uiEvent = EVENT_MOVE;
+    }
+
+    touchMsgPressed = (pMsg->uiEvent == EVENT_PRESS) || (pMsg->uiEvent == EVENT_MOVE);
+    touchMsgX = pMsg->param1;
+    touchMsgY = pMsg->param2;
+#else
     static int16_t    prevX = -1;
     static int16_t    prevY = -1;
 
@@ -250,7 +349,273 @@ void TouchGetMsg(GFX_GOL_MESSAGE *pMsg)
     pMsg->param2 = y;
     prevX = x;
     prevY = y;
+#endif
 }
+
+/*********************************************************************
+* Function: void TouchGetCoalescedMsg(GFX_GOL_MESSAGE* pMsg)
+*
+* PreCondition: none
+*
+* Input: pointer to the message structure to be populated
+*
+* Output: none
+*
+* Side Effects: none
+*
+* Overview: populates GOL message structure, merging consecutive
+*           queued EVENT_MOVE messages into the last one
+*
+* Note: none
+*
+********************************************************************/
+void TouchGetCoalescedMsg(GFX_GOL_MESSAGE *pMsg)
+{
+    TouchGetMsg(pMsg);
+
+#ifdef TOUCHSCREEN_SAMPLE_BUFFER_ENABLE
+    while((pMsg->uiEvent == EVENT_MOVE) &&
+          (touchSampleTail != touchSampleHead) &&
+          (touchSampleQueue[touchSampleTail].uiEvent == EVENT_MOVE))
+    {
+        TouchGetMsg(pMsg);
+    }
+#endif
+}
+
+#ifdef TOUCHSCREEN_SAMPLE_BUFFER_ENABLE
+/*********************************************************************
+* Function: static bool TouchSamplePut(uint8_t event, int16_t x, int16_t y, uint8_t reserve)
+*
+* PreCondition: none
+*
+* Input: event - the message event
+*        x, y - the message position
+*        reserve - number of entries that must stay free
+*
+* Output: Returns true if the message was queued.
+*
+* Side Effects: none
+*
+* Overview: Queues a touch screen message. Called by TouchSampleTasks()
+*           only, TouchGetMsg() is the only reader.
+*
+* Note: none
+*
+********************************************************************/
+static bool TouchSamplePut(uint8_t event, int16_t x, int16_t y, uint8_t reserve)
+{
+    uint8_t           head = touchSampleHead;
+    uint8_t           used = (head - touchSampleTail) & TOUCH_SAMPLE_MASK;
+    GFX_GOL_MESSAGE   *pMsg;
+
+    if((TOUCH_SAMPLE_MASK - used) <= reserve)
+    {
+        return (false);
+    }
+
+    pMsg = &touchSampleQueue[head];
+    pMsg->type = TYPE_TOUCHSCREEN;
+    pMsg->uiEvent = event;
+    pMsg->param1 = x;
+    pMsg->param2 = y;
+
+    // publish the entry after it is written
+    touchSampleHead = (head + 1) & TOUCH_SAMPLE_MASK;
+    return (true);
+}
+
+/*********************************************************************
+* Function: static int16_t TouchSampleMedian(const int16_t *pSamples)
+*
+* PreCondition: none
+*
+* Input: pSamples - the last three samples
+*
+* Output: the median of the three samples
+*
+* Side Effects: none
+*
+* Overview: Removes single sample spikes of the resistive panel.
+*
+* Note: none
+*
+********************************************************************/
+static int16_t TouchSampleMedian(const int16_t *pSamples)
+{
+    int16_t a = pSamples[0], b = pSamples[1], c = pSamples[2];
+
+    if(a > b)
+    {
+        int16_t t = a; a = b; b = t;
+    }
+    if(b > c)
+    {
+        b = c;
+    }
+    return ((a > b) ? a : b);
+}
+
+/*********************************************************************
+* Function: static void TouchSampleFilter(int16_t *pX, int16_t *pY)
+*
+* PreCondition: none
+*
+* Input: pX, pY - the calibrated position, replaced by the filtered one
+*
+* Output: none
+*
+* Side Effects: none
+*
+* Overview: Median of three followed by a first order IIR low pass.
+*           The first sample of a press initializes both filters so the
+*           position does not lag behind from the previous touch.
+*
+* Note: none
+*
+********************************************************************/
+static void TouchSampleFilter(int16_t *pX, int16_t *pY)
+{
+    int32_t x, y;
+
+    if(touchFilterValid == false)
+    {
+        touchMedianX[0] = touchMedianX[1] = touchMedianX[2] = *pX;
+        touchMedianY[0] = touchMedianY[1] = touchMedianY[2] = *pY;
+        touchMedianIndex = 0;
+        touchFilterX = (int32_t)*pX << TOUCH_SAMPLE_FRACTION_BITS;
+        touchFilterY = (int32_t)*pY << TOUCH_SAMPLE_FRACTION_BITS;
+        touchFilterValid = true;
+        return;
+    }
+
+    touchMedianX[touchMedianIndex] = *pX;
+    touchMedianY[touchMedianIndex] = *pY;
+    if(++touchMedianIndex == 3)
+        touchMedianIndex = 0;
+
+    x = (int32_t)TouchSampleMedian(touchMedianX) << TOUCH_SAMPLE_FRACTION_BITS;
+    y = (int32_t)TouchSampleMedian(touchMedianY) << TOUCH_SAMPLE_FRACTION_BITS;
+
+    touchFilterX += (x - touchFilterX) >> TOUCHSCREEN_SAMPLE_IIR_SHIFT;
+    touchFilterY += (y - touchFilterY) >> TOUCHSCREEN_SAMPLE_IIR_SHIFT;
+
+    *pX = (int16_t)((touchFilterX + (1 << (TOUCH_SAMPLE_FRACTION_BITS - 1))) >> TOUCH_SAMPLE_FRACTION_BITS);
+    *pY = (int16_t)((touchFilterY + (1 << (TOUCH_SAMPLE_FRACTION_BITS - 1))) >> TOUCH_SAMPLE_FRACTION_BITS);
+}
+
+/*********************************************************************
+* Function: void TouchSampleTasks(void)
+*
+* PreCondition: TouchInit() must be called before
+*
+* Input: none
+*
+* Output: none
+*
+* Side Effects: none
+*
+* Overview: Runs the touch acquisition and queues press, move and
+*           release messages. Call it from a periodic timer interrupt.
+*
+* Note: none
+*
+********************************************************************/
+void TouchSampleTasks(void)
+{
+    int16_t           x, y;
+
+    if(touchSampleFlush)
+    {
+        // the reader dropped the queue, a touch still held is pressed again
+        touchSampleFlush = false;
+        touchReportedPressed = false;
+    }
+
+    if(touchSampleDelay != 0)
+    {
+        touchSampleDelay--;
+        return;
+    }
+
+    if(TouchDetectPosition() == 0)
+        return;
+
+    x = TouchGetX();
+    y = TouchGetY();
+
+    if((x == -1) || (y == -1))
+    {
+        touchSampleDelay = TOUCHSCREEN_SAMPLE_IDLE_DIVIDER - 1;
+        touchFilterValid = false;
+
+        // released at the last filtered position, the last moves may have been
+        // dropped; retried on the next acquisition if the queue is full
+        if(touchReportedPressed && TouchSamplePut(EVENT_RELEASE, touchLastX, touchLastY, 0))
+            touchReportedPressed = false;
+        return;
+    }
+
+    touchSampleDelay = TOUCHSCREEN_SAMPLE_PRESSED_DIVIDER - 1;
+
+    // a new touch started before the release of the previous one could be
+    // queued, release it first and keep an entry free for the press
+    if(touchReportedPressed && (touchFilterValid == false))
+    {
+        if(TouchSamplePut(EVENT_RELEASE, touchLastX, touchLastY, 1) == false)
+            return;
+        touchReportedPressed = false;
+    }
+
+    TouchSampleFilter(&x, &y);
+    touchLastX = x;
+    touchLastY = y;
+
+    if(touchReportedPressed == false)
+    {
+        if(TouchSamplePut(EVENT_PRESS, x, y, 0) == false)
+            return;
+        touchReportedPressed = true;
+    }
+    else
+    {
+        // moves are dropped rather than taking the entries of press and release
+        if((x == touchReportedX) && (y == touchReportedY))
+            return;
+        if(TouchSamplePut(EVENT_MOVE, x, y, TOUCH_SAMPLE_MOVE_RESERVE) == false)
+            return;
+    }
+
+    touchReportedX = x;
+    touchReportedY = y;
+}
+
+/*********************************************************************
+* Function: void TouchSampleBufferFlush(void)
+*
+* PreCondition: none
+*
+* Input: none
+*
+* Output: none
+*
+* Side Effects: none
+*
+* Overview: Drops the queued messages. TouchSampleTasks() is asked to
+*           forget the reported touch, so a touch still held is queued
+*           again as EVENT_PRESS instead of continuing with EVENT_MOVE.
+*
+* Note: Called by the reader of the messages only.
+*
+********************************************************************/
+void TouchSampleBufferFlush(void)
+{
+    touchSampleTail = touchSampleHead;
+    touchMsgPressed = false;
+    touchSampleFlush = true;
+}
+#endif // #ifdef TOUCHSCREEN_SAMPLE_BUFFER_ENABLE
+
 /*********************************************************************
 * Function: void TouchCheckForCalibration()
 *
@@ -47,6 +47,23 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 // *****************************************************************************
 // *****************************************************************************
 
+/*************************************************************************
+  Summary:
+    Macro selects how the driver moves the data of each UART
+  Description:
+    UART driver mode configuration
+
+    DRV_UART_MODE_INTERRUPT (default) uses the UART receive and transmit
+    interrupts, DRV_UART_MODE_POLL requires DRV_UARTn_TasksRX,
+    DRV_UARTn_TasksTX and DRV_UARTn_TasksError to be called from the main
+    loop and DRV_UART_MODE_DMA uses the DMA channels configured below.
+*/
+
+#define DRV_UART1_CONFIG_MODE                   DRV_UART_MODE_INTERRUPT
+#define DRV_UART2_CONFIG_MODE                   DRV_UART_MODE_INTERRUPT
+#define DRV_UART3_CONFIG_MODE                   DRV_UART_MODE_INTERRUPT
+#define DRV_UART4_CONFIG_MODE                   DRV_UART_MODE_INTERRUPT
+
 /*************************************************************************
   Summary:
     Macro controls operation of the driver for defining the size of the TX
@@ -233,6 +250,54 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 #define DRV_UART4_CONFIG_9N2
 
 
+// *****************************************************************************
+// *****************************************************************************
+// Section: DMA Driver Configuration Options
+// *****************************************************************************
+// *****************************************************************************
+
+/*************************************************************************
+  Summary:
+    Macros select the DMA channels used in DRV_UART_MODE_DMA
+  Description:
+    UART DMA channel configuration
+
+    The receive channel runs continuously over the RX buffer and the
+    transmit channel sends the TX buffer, so the buffer lengths above
+    should be sized for the DMA driver (for example 256 bytes at 921600
+    baud). Each UART needs two channels of its own.
+*/
+
+#define DRV_UART1_CONFIG_DMA_RX_CHANNEL         0
+#define DRV_UART1_CONFIG_DMA_TX_CHANNEL         1
+#define DRV_UART2_CONFIG_DMA_RX_CHANNEL         2
+#define DRV_UART2_CONFIG_DMA_TX_CHANNEL         3
+#define DRV_UART3_CONFIG_DMA_RX_CHANNEL         4
+#define DRV_UART3_CONFIG_DMA_TX_CHANNEL         5
+#define DRV_UART4_CONFIG_DMA_RX_CHANNEL
+#define DRV_UART4_CONFIG_DMA_TX_CHANNEL
+
+
+/*************************************************************************
+  Summary:
+    Macros select the DMA trigger sources of the UART DMA channels
+  Description:
+    UART DMA trigger configuration
+
+    The values are the CHSEL codes of the UART receive and transmit
+    interrupts in the DMA trigger source table of the device data sheet.
+*/
+
+#define DRV_UART1_CONFIG_DMA_RX_TRIGGER
+#define DRV_UART1_CONFIG_DMA_TX_TRIGGER
+#define DRV_UART2_CONFIG_DMA_RX_TRIGGER
+#define DRV_UART2_CONFIG_DMA_TX_TRIGGER
+#define DRV_UART3_CONFIG_DMA_RX_TRIGGER
+#define DRV_UART3_CONFIG_DMA_TX_TRIGGER
+#define DRV_UART4_CONFIG_DMA_RX_TRIGGER
+#define DRV_UART4_CONFIG_DMA_TX_TRIGGER
+
+
 #endif // #ifndef _DRV_UART_CONFIG_TEMPLATE_H
 
 /*******************************************************************************
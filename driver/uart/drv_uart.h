@@ -0,0 +1,409 @@
+/*******************************************************************************
+  UART Driver API Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    drv_uart.h
+
+  Summary:
+    This is the header file for the instance based UART driver
+
+  Description:
+    This header file provides the UART driver shared by every UART port.
+    A port is described by a DRV_UART_DESCRIPTOR (registers, buffers, baud
+    rate and mode) and its state is kept in a DRV_UART_OBJECT, so one copy
+    of the code serves all ports in interrupt, polled or DMA mode.
+
+    The DRV_UART1_* to DRV_UART4_* APIs of drv_uart1.h to drv_uart4.h are
+    thin wrappers around this driver, implemented in drv_uart1.c to
+    drv_uart4.c. Each of them sets the defaults of its DRV_UARTn_CONFIG_*
+    options and includes the port template src/drv_uart_port.h.
+*******************************************************************************/
+
+//This will be the disclaimer
+
+#ifndef _DRV_UART_H
+#define _DRV_UART_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <xc.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "driver/uart/drv_uart_dma.h"
+
+#ifdef __cplusplus  // Provide C++ Compatability
+
+    extern "C" {
+
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* UART Driver Modes
+
+  Summary:
+    Selects how the data is moved between the UART and the buffers.
+
+  Description:
+    The values are macros so that the port wrappers can select their
+    interrupt service routines with the preprocessor.
+*/
+
+/* The UART receive and transmit interrupts move one byte per interrupt */
+#define DRV_UART_MODE_INTERRUPT         0
+
+/* DRV_UART_TasksRX and DRV_UART_TasksTX are called from the main loop */
+#define DRV_UART_MODE_POLL              1
+
+/* Two DMA channels move the data, see drv_uart_dma.h */
+#define DRV_UART_MODE_DMA               2
+
+// *****************************************************************************
+/* UART Driver Transfer Flags
+
+  Summary
+    Specifies the status of the receive or transmit
+
+  Description
+    The values match DRV_UART1_TRANSFER_STATUS to DRV_UART4_TRANSFER_STATUS.
+*/
+
+typedef enum
+{
+    /* Indicates that the core driver buffer is full */
+    DRV_UART_TRANSFER_STATUS_RX_FULL
+        /*DOM-IGNORE-BEGIN*/  = (1 << 0) /*DOM-IGNORE-END*/,
+
+    /* Indicates that at least one byte of Data has been received */
+    DRV_UART_TRANSFER_STATUS_RX_DATA_PRESENT
+        /*DOM-IGNORE-BEGIN*/  = (1 << 1) /*DOM-IGNORE-END*/,
+
+    /* Indicates that the core driver receiver buffer is empty */
+    DRV_UART_TRANSFER_STATUS_RX_EMPTY
+        /*DOM-IGNORE-BEGIN*/  = (1 << 2) /*DOM-IGNORE-END*/,
+
+    /* Indicates that the core driver transmitter buffer is full */
+    DRV_UART_TRANSFER_STATUS_TX_FULL
+        /*DOM-IGNORE-BEGIN*/  = (1 << 3) /*DOM-IGNORE-END*/,
+
+    /* Indicates that the core driver transmitter buffer is empty */
+    DRV_UART_TRANSFER_STATUS_TX_EMPTY
+        /*DOM-IGNORE-BEGIN*/  = (1 << 4) /*DOM-IGNORE-END*/,
+
+    /* Indicates that the receive line went idle after data was received */
+    DRV_UART_TRANSFER_STATUS_RX_IDLE
+        /*DOM-IGNORE-BEGIN*/  = (1 << 5) /*DOM-IGNORE-END*/
+
+} DRV_UART_TRANSFER_STATUS;
+
+// *****************************************************************************
+/* UART Port Descriptor
+
+  Summary:
+    Describes the hardware and the buffers of one UART port.
+
+  Description:
+    The descriptor is constant; the port wrapper defines one per port.
+    txInterruptEnable is only used in DRV_UART_MODE_INTERRUPT and the DMA
+    channels only in DRV_UART_MODE_DMA.
+*/
+
+typedef struct
+{
+    uint8_t                 mode ;                  // DRV_UART_MODE_xxx
+
+    volatile uint16_t       *uartMode ;             // UxMODE
+
+    volatile uint16_t       *uartStatus ;           // UxSTA
+
+    volatile uint16_t       *uartBaud ;             // UxBRG
+
+    volatile uint16_t       *uartReceive ;          // UxRXREG
+
+    volatile uint16_t       *uartTransmit ;         // UxTXREG
+
+    /* enables or disables the UART transmit interrupt */
+    void                    (*txInterruptEnable)(bool enable) ;
+
+    uint8_t                 *rxBuffer ;
+
+    uint16_t                rxSize ;
+
+    uint8_t                 *txBuffer ;
+
+    uint16_t                txSize ;
+
+    uint32_t                baudRate ;
+
+    /* PDSEL and STSEL bits of UxMODE */
+    uint16_t                pds ;
+
+    DRV_UART_DMA_CHANNEL    rxChannel ;
+
+    DRV_UART_DMA_CHANNEL    txChannel ;
+
+} DRV_UART_DESCRIPTOR ;
+
+// *****************************************************************************
+/* UART Driver Instance Object
+
+  Summary:
+    Defines the object required for the maintenance of one UART port.
+
+  Description:
+    The rings, the idle detection and the DMA state are kept in the
+    DRV_UART_DMA_OBJECT in every mode.
+*/
+
+typedef struct
+{
+    const DRV_UART_DESCRIPTOR   *descriptor ;
+
+    DRV_UART_DMA_OBJECT         data ;
+
+} DRV_UART_OBJECT ;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: UART Driver Routines
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void DRV_UART_Initialize(DRV_UART_OBJECT *object, const DRV_UART_DESCRIPTOR *descriptor)
+
+  Summary:
+    Initializes a UART port.
+
+  Description:
+    This routine configures the UART registers, empties the buffers and,
+    in DMA mode, starts the receive DMA channel. The UART and DMA
+    interrupt enable bits are set by the port wrapper afterwards.
+
+  Parameters:
+    object      - instance object of the port
+    descriptor  - constant description of the port
+
+  Returns:
+    None.
+*/
+void DRV_UART_Initialize(DRV_UART_OBJECT *object, const DRV_UART_DESCRIPTOR *descriptor);
+
+// *****************************************************************************
+/* Function:
+    void DRV_UART_TasksTX(DRV_UART_OBJECT *object)
+
+  Summary:
+    Moves queued bytes to the UART transmitter.
+
+  Description:
+    Called by the transmit interrupt in interrupt mode and from the main
+    loop in polled mode. In interrupt mode the transmit interrupt is
+    disabled when the buffer is empty.
+*/
+void DRV_UART_TasksTX(DRV_UART_OBJECT *object);
+
+// *****************************************************************************
+/* Function:
+    void DRV_UART_TasksRX(DRV_UART_OBJECT *object)
+
+  Summary:
+    Moves received bytes from the UART to the receive buffer.
+
+  Description:
+    Called by the receive interrupt in interrupt mode and from the main
+    loop in polled mode. Bytes received while the buffer is full are
+    dropped.
+*/
+void DRV_UART_TasksRX(DRV_UART_OBJECT *object);
+
+// *****************************************************************************
+/* Function:
+    void DRV_UART_TasksError(DRV_UART_OBJECT *object)
+
+  Summary:
+    Clears a receive overrun so that the UART keeps receiving.
+*/
+void DRV_UART_TasksError(DRV_UART_OBJECT *object);
+
+// *****************************************************************************
+/* Function:
+    void DRV_UART_TasksDMA(DRV_UART_OBJECT *object)
+
+  Summary:
+    Publishes received DMA data and detects the idle line.
+
+  Description:
+    Only used in DMA mode, see DRV_UART_DMA_Tasks().
+*/
+void DRV_UART_TasksDMA(DRV_UART_OBJECT *object);
+
+// *****************************************************************************
+/* Function:
+    uint8_t DRV_UART_ReadByte(DRV_UART_OBJECT *object)
+
+  Summary:
+    Reads a byte of data. The receive buffer must not be empty.
+*/
+uint8_t DRV_UART_ReadByte(DRV_UART_OBJECT *object);
+
+// *****************************************************************************
+/* Function:
+    unsigned int DRV_UART_Read(DRV_UART_OBJECT *object, uint8_t *buffer, const unsigned int numbytes)
+
+  Summary:
+    Copies up to numbytes received bytes to buffer.
+
+  Returns:
+    Number of bytes copied.
+*/
+unsigned int DRV_UART_Read(DRV_UART_OBJECT *object, uint8_t *buffer, const unsigned int numbytes);
+
+// *****************************************************************************
+/* Function:
+    void DRV_UART_WriteByte(DRV_UART_OBJECT *object, const uint8_t byte)
+
+  Summary:
+    Queues a byte of data. The byte is dropped when the buffer is full.
+*/
+void DRV_UART_WriteByte(DRV_UART_OBJECT *object, const uint8_t byte);
+
+// *****************************************************************************
+/* Function:
+    unsigned int DRV_UART_Write(DRV_UART_OBJECT *object, const uint8_t *buffer, const unsigned int numbytes)
+
+  Summary:
+    Queues up to numbytes bytes and starts the transmission.
+
+  Returns:
+    Number of bytes queued.
+*/
+unsigned int DRV_UART_Write(DRV_UART_OBJECT *object, const uint8_t *buffer, const unsigned int numbytes);
+
+// *****************************************************************************
+/* Function:
+    unsigned int DRV_UART_ReadAcquire(DRV_UART_OBJECT *object, uint8_t **ppData)
+
+  Summary:
+    Returns the contiguous region of received data without copying it.
+
+  Description:
+    The data is released by DRV_UART_ReadCommit(). When the data wraps
+    around the end of the buffer, the rest is returned by the next call.
+*/
+unsigned int DRV_UART_ReadAcquire(DRV_UART_OBJECT *object, uint8_t **ppData);
+
+// *****************************************************************************
+/* Function:
+    void DRV_UART_ReadCommit(DRV_UART_OBJECT *object, const unsigned int numbytes)
+
+  Summary:
+    Releases bytes returned by DRV_UART_ReadAcquire().
+*/
+void DRV_UART_ReadCommit(DRV_UART_OBJECT *object, const unsigned int numbytes);
+
+// *****************************************************************************
+/* Function:
+    unsigned int DRV_UART_WriteAcquire(DRV_UART_OBJECT *object, uint8_t **ppData)
+
+  Summary:
+    Returns the contiguous free region of the transmit buffer.
+*/
+unsigned int DRV_UART_WriteAcquire(DRV_UART_OBJECT *object, uint8_t **ppData);
+
+// *****************************************************************************
+/* Function:
+    void DRV_UART_WriteCommit(DRV_UART_OBJECT *object, const unsigned int numbytes)
+
+  Summary:
+    Queues bytes stored in the region returned by DRV_UART_WriteAcquire()
+    and starts the transmission.
+*/
+void DRV_UART_WriteCommit(DRV_UART_OBJECT *object, const unsigned int numbytes);
+
+// *****************************************************************************
+/* Function:
+    DRV_UART_TRANSFER_STATUS DRV_UART_TransferStatus(DRV_UART_OBJECT *object)
+
+  Summary:
+    Returns the transmitter and receiver transfer status.
+
+  Description:
+    DRV_UART_TRANSFER_STATUS_RX_IDLE is reported once per idle period.
+*/
+DRV_UART_TRANSFER_STATUS DRV_UART_TransferStatus(DRV_UART_OBJECT *object);
+
+// *****************************************************************************
+/* Function:
+    uint8_t DRV_UART_Peek(DRV_UART_OBJECT *object, uint16_t offset)
+
+  Summary:
+    Returns the received byte at the offset without extracting it.
+*/
+uint8_t DRV_UART_Peek(DRV_UART_OBJECT *object, uint16_t offset);
+
+// *****************************************************************************
+/* Function:
+    unsigned int DRV_UART_RXBufferSizeGet(DRV_UART_OBJECT *object)
+
+  Summary:
+    Returns the number of bytes in the receive buffer.
+*/
+unsigned int DRV_UART_RXBufferSizeGet(DRV_UART_OBJECT *object);
+
+// *****************************************************************************
+/* Function:
+    unsigned int DRV_UART_TXBufferSizeGet(DRV_UART_OBJECT *object)
+
+  Summary:
+    Returns the number of bytes waiting in the transmit buffer.
+*/
+unsigned int DRV_UART_TXBufferSizeGet(DRV_UART_OBJECT *object);
+
+// *****************************************************************************
+/* Function:
+    bool DRV_UART_RXBufferIsEmpty(DRV_UART_OBJECT *object)
+
+  Summary:
+    Returns true when no received byte is waiting.
+*/
+bool DRV_UART_RXBufferIsEmpty(DRV_UART_OBJECT *object);
+
+// *****************************************************************************
+/* Function:
+    bool DRV_UART_TXBufferIsFull(DRV_UART_OBJECT *object)
+
+  Summary:
+    Returns true when no byte can be queued.
+*/
+bool DRV_UART_TXBufferIsFull(DRV_UART_OBJECT *object);
+
+// *****************************************************************************
+/* Function:
+    uint16_t DRV_UART_Status(DRV_UART_OBJECT *object)
+
+  Summary:
+    Returns the UxSTA register of the port.
+*/
+uint16_t DRV_UART_Status(DRV_UART_OBJECT *object);
+
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+
+#endif  // _DRV_UART_H
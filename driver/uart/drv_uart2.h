@@ -133,7 +133,12 @@ typedef enum
 
     /* Indicates that the core driver transmitter buffer is empty */
     DRV_UART2_TRANSFER_STATUS_TX_EMPTY
-        /*DOM-IGNORE-BEGIN*/  = (1 << 4) /*DOM-IGNORE-END*/
+        /*DOM-IGNORE-BEGIN*/  = (1 << 4) /*DOM-IGNORE-END*/,
+
+    /* Indicates that the receive line went idle after data was received.
+       Only reported by the DMA driver, once per idle period */
+    DRV_UART2_TRANSFER_STATUS_RX_IDLE
+        /*DOM-IGNORE-BEGIN*/  = (1 << 5) /*DOM-IGNORE-END*/
 
 } DRV_UART2_TRANSFER_STATUS;
 
@@ -376,6 +381,48 @@ void __attribute__ ( ( interrupt, no_auto_psv ) ) _U2ErrInterrupt ( void );
 void DRV_UART2_TasksError ( void );
 
 
+// *****************************************************************************
+/* Function:
+    void DRV_UART2_TasksDMA ( void );
+
+  Summary:
+    Detects the end of received messages when the DMA driver is used.
+
+  Description:
+    This routine is only provided in DRV_UART_MODE_DMA. The DMA
+    channels move the data without this routine; it publishes the bytes
+    received since the last DMA interrupt and reports
+    DRV_UART2_TRANSFER_STATUS_RX_IDLE when the receiver went idle after
+    data was received.
+
+  Precondition:
+    DRV_UART2_InitializerDefault function should have been called 
+    before calling this function in a polled loop.
+
+  Parameters:
+    None.
+
+  Returns:
+    None.
+
+  Example:
+    <code>
+    while (true)
+    {
+        DRV_UART2_TasksDMA ();
+
+        if (DRV_UART2_TransferStatus() & DRV_UART2_TRANSFER_STATUS_RX_IDLE)
+        {
+            // a complete message is in the receive buffer
+        }
+
+        // Do other tasks
+    }
+    </code>
+*/
+void DRV_UART2_TasksDMA ( void );
+
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: UART Driver Client Routines
@@ -582,6 +629,123 @@ void DRV_UART2_WriteByte( const uint8_t byte);
 
 unsigned int DRV_UART2_Write( const uint8_t *buffer , const unsigned int numbytes );
 
+// *****************************************************************************
+/* Function:
+    unsigned int DRV_UART2_ReadAcquire( uint8_t **ppData )
+
+  Summary:
+    Returns the received data in place, without copying it.
+
+  Description:
+    This routine is available in every mode. It returns the
+    address and the length of the contiguous region of received data in the
+    receive buffer. When the data wraps around the end of the buffer, the
+    rest is returned by the next call after DRV_UART2_ReadCommit.
+
+  Precondition:
+    DRV_UART2_InitializerDefault function should have been called 
+    before calling this function.
+
+  Parameters:
+    ppData  - receives the address of the first received byte
+
+  Returns:
+    Number of bytes that can be read at *ppData.
+
+  Example:
+    <code>
+    uint8_t         *pData;
+    unsigned int    numBytes;
+
+    while ((numBytes = DRV_UART2_ReadAcquire(&pData)) != 0)
+    {
+        ProcessData(pData, numBytes);
+        DRV_UART2_ReadCommit(numBytes);
+    }
+    </code>
+*/
+unsigned int DRV_UART2_ReadAcquire( uint8_t **ppData );
+
+// *****************************************************************************
+/* Function:
+    void DRV_UART2_ReadCommit( const unsigned int numbytes )
+
+  Summary:
+    Releases received bytes returned by DRV_UART2_ReadAcquire.
+
+  Description:
+    The released part of the receive buffer is reused by the driver.
+
+  Precondition:
+    DRV_UART2_ReadAcquire should have returned at least numbytes bytes.
+
+  Parameters:
+    numbytes - number of bytes processed
+
+  Returns:
+    None.
+*/
+void DRV_UART2_ReadCommit( const unsigned int numbytes );
+
+// *****************************************************************************
+/* Function:
+    unsigned int DRV_UART2_WriteAcquire( uint8_t **ppData )
+
+  Summary:
+    Returns free space of the transmit buffer to build data in place.
+
+  Description:
+    This routine is available in every mode. It returns the
+    address and the length of the contiguous free region of the transmit
+    buffer. Nothing is sent until DRV_UART2_WriteCommit is called.
+
+  Precondition:
+    DRV_UART2_InitializerDefault function should have been called 
+    before calling this function.
+
+  Parameters:
+    ppData  - receives the address of the first free byte
+
+  Returns:
+    Number of bytes that can be stored at *ppData.
+
+  Example:
+    <code>
+    uint8_t         *pData;
+    unsigned int    numBytes;
+
+    numBytes = DRV_UART2_WriteAcquire(&pData);
+    if (numBytes >= MESSAGE_SIZE)
+    {
+        BuildMessage(pData);
+        DRV_UART2_WriteCommit(MESSAGE_SIZE);
+    }
+    </code>
+*/
+unsigned int DRV_UART2_WriteAcquire( uint8_t **ppData );
+
+// *****************************************************************************
+/* Function:
+    void DRV_UART2_WriteCommit( const unsigned int numbytes )
+
+  Summary:
+    Transmits bytes stored in the region returned by DRV_UART2_WriteAcquire.
+
+  Description:
+    It starts the transmit interrupt or, in DRV_UART_MODE_DMA, the
+    transmit DMA channel if it is idle.
+
+  Precondition:
+    DRV_UART2_WriteAcquire should have returned at least numbytes bytes.
+
+  Parameters:
+    numbytes - number of bytes stored
+
+  Returns:
+    None.
+*/
+void DRV_UART2_WriteCommit( const unsigned int numbytes );
+
 // *****************************************************************************
 /* Function:
     DRV_UART2_TRANSFER_STATUS DRV_UART2_TransferStatus (void)
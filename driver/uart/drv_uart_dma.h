@@ -0,0 +1,468 @@
+/*******************************************************************************
+  UART DMA Ring Buffer Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    drv_uart_dma.h
+
+  Summary:
+    This is the header file for the DMA ring buffers shared by the UART drivers
+
+  Description:
+    This header file provides the ring buffer used by every mode of the UART
+    driver of drv_uart.h and the DMA engine used by DRV_UART_MODE_DMA. The receive DMA channel writes the UART
+    data into a circular buffer without CPU intervention and the transmit
+    DMA channel sends contiguous regions of the transmit ring. One
+    implementation serves every UART instance; each port descriptor only
+    provides the buffers and the register addresses of its UART and DMA
+    channels.
+
+    The DMA engine targets the PIC24F DMA controller (DMACON, DMACHn,
+    DMAINTn, DMASRCn, DMADSTn and DMACNTn registers).
+*******************************************************************************/
+
+//This will be the disclaimer
+
+#ifndef _DRV_UART_DMA_H
+#define _DRV_UART_DMA_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <xc.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus  // Provide C++ Compatability
+
+    extern "C" {
+
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: DMA Register Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* DMACON bits */
+#define DRV_UART_DMA_CON_DMAEN          0x8000
+
+/* DMACHn bits */
+#define DRV_UART_DMA_CH_CHEN            0x0001      // channel enable
+#define DRV_UART_DMA_CH_SIZE_BYTE       0x0002      // byte transfers
+#define DRV_UART_DMA_CH_TRMODE_ONESHOT  0x0000      // one-shot, stops at the end of the block
+#define DRV_UART_DMA_CH_TRMODE_REPEATED 0x0004      // repeated one-shot, reloads at the end of the block
+#define DRV_UART_DMA_CH_DAMODE_INC      0x0010      // destination address incremented
+#define DRV_UART_DMA_CH_SAMODE_INC      0x0040      // source address incremented
+#define DRV_UART_DMA_CH_CHREQ           0x0100      // software transfer request
+#define DRV_UART_DMA_CH_RELOAD          0x0200      // reload address and count at the end of the block
+
+/* DMAINTn bits */
+#define DRV_UART_DMA_INT_CHSEL_SHIFT    8           // trigger source selection
+#define DRV_UART_DMA_INT_DONEIF         0x0020      // block transfer complete
+#define DRV_UART_DMA_INT_HALFIF         0x0010      // half of the block transferred
+#define DRV_UART_DMA_INT_OVRUNIF        0x0008      // trigger while the channel was busy
+#define DRV_UART_DMA_INT_HALFEN         0x0001      // interrupt at half of the block
+
+/* UxSTA bits */
+#define DRV_UART_DMA_STA_RIDLE          0x0010      // receiver idle
+#define DRV_UART_DMA_STA_TRMT           0x0100      // transmit shift register empty
+
+// *****************************************************************************
+/* DMA Channel Helpers
+
+  Summary:
+    Map a DMA channel number to its registers, interrupt flag and vector.
+
+  Description:
+    The channel number is usually a configuration macro, so the helpers
+    expand it before pasting it into the register names.
+*/
+
+#define DRV_UART_DMA_CHANNEL_DEFINE(n, trigger) DRV_UART_DMA_CHANNEL_DEFINE_(n, trigger)
+#define DRV_UART_DMA_CHANNEL_DEFINE_(n, trigger) \
+            { &DMACH##n, &DMAINT##n, &DMASRC##n, &DMADST##n, &DMACNT##n, (trigger) }
+
+#define DRV_UART_DMA_IF(n)              DRV_UART_DMA_IF_(n)
+#define DRV_UART_DMA_IF_(n)             _DMA##n##IF
+#define DRV_UART_DMA_IE(n)              DRV_UART_DMA_IE_(n)
+#define DRV_UART_DMA_IE_(n)             _DMA##n##IE
+#define DRV_UART_DMA_ISR(n)             DRV_UART_DMA_ISR_(n)
+#define DRV_UART_DMA_ISR_(n)            void __attribute__ ( ( interrupt, no_auto_psv ) ) _DMA##n##Interrupt ( void )
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* UART Ring Buffer
+
+  Summary:
+    Defines a single producer, single consumer circular buffer.
+
+  Description:
+    One byte of the buffer is always left unused so that a full ring can be
+    told apart from an empty one. The producer only moves head and the
+    consumer only moves tail, so an interrupt and the main loop can use the
+    ring without locking.
+*/
+
+typedef struct
+{
+    uint8_t                 *buffer ;
+
+    uint16_t                size ;
+
+    /* index of the next byte written by the producer */
+    volatile uint16_t       head ;
+
+    /* index of the next byte read by the consumer */
+    volatile uint16_t       tail ;
+
+} DRV_UART_RING ;
+
+// *****************************************************************************
+/* UART DMA Channel
+
+  Summary:
+    Defines the registers of one DMA channel.
+
+  Description:
+    Use DRV_UART_DMA_CHANNEL_DEFINE() to initialize it.
+*/
+
+typedef struct
+{
+    volatile uint16_t       *control ;          // DMACHn
+
+    volatile uint16_t       *interrupt ;        // DMAINTn
+
+    volatile uint16_t       *source ;           // DMASRCn
+
+    volatile uint16_t       *destination ;      // DMADSTn
+
+    volatile uint16_t       *count ;            // DMACNTn
+
+    uint16_t                trigger ;           // CHSEL value of the UART interrupt
+
+} DRV_UART_DMA_CHANNEL ;
+
+// *****************************************************************************
+/* UART DMA Object
+
+  Summary:
+    Defines the object required for the maintenance of one UART instance.
+
+  Description:
+    The driver initializes the rings, the channels and the UART register
+    addresses statically; the remaining members are maintained by the
+    engine.
+*/
+
+typedef struct
+{
+    DRV_UART_RING           rx ;
+
+    DRV_UART_RING           tx ;
+
+    DRV_UART_DMA_CHANNEL    rxChannel ;
+
+    DRV_UART_DMA_CHANNEL    txChannel ;
+
+    volatile uint16_t       *uartStatus ;       // UxSTA
+
+    volatile uint16_t       *uartReceive ;      // UxRXREG
+
+    volatile uint16_t       *uartTransmit ;     // UxTXREG
+
+    /* bytes of the transmit transfer in progress, 0 when the channel is idle */
+    volatile uint16_t       txLength ;
+
+    /* data was received since the line was last seen idle */
+    volatile bool           rxActive ;
+
+    /* the line went idle after data was received */
+    volatile bool           rxIdle ;
+
+    /* received data was overwritten before it was read */
+    volatile bool           rxOverrun ;
+
+} DRV_UART_DMA_OBJECT ;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Ring Buffer Routines
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void DRV_UART_RING_Initialize(DRV_UART_RING *ring, uint8_t *buffer, uint16_t size)
+
+  Summary:
+    Initializes an empty ring on the given buffer.
+
+  Parameters:
+    ring    - ring to initialize
+    buffer  - storage of the ring
+    size    - size of the storage in bytes, the ring holds size - 1 bytes
+
+  Returns:
+    None.
+*/
+void DRV_UART_RING_Initialize(DRV_UART_RING *ring, uint8_t *buffer, uint16_t size);
+
+// *****************************************************************************
+/* Function:
+    uint16_t DRV_UART_RING_CountGet(const DRV_UART_RING *ring)
+
+  Summary:
+    Returns the number of bytes that can be read from the ring.
+*/
+uint16_t DRV_UART_RING_CountGet(const DRV_UART_RING *ring);
+
+// *****************************************************************************
+/* Function:
+    uint16_t DRV_UART_RING_FreeGet(const DRV_UART_RING *ring)
+
+  Summary:
+    Returns the number of bytes that can be written to the ring.
+*/
+uint16_t DRV_UART_RING_FreeGet(const DRV_UART_RING *ring);
+
+// *****************************************************************************
+/* Function:
+    uint16_t DRV_UART_RING_ReadAcquire(const DRV_UART_RING *ring, uint8_t **ppData)
+
+  Summary:
+    Returns the contiguous readable region of the ring.
+
+  Description:
+    The region starts at the tail and ends at the head or at the end of the
+    buffer, whichever comes first. A second call after DRV_UART_RING_ReadCommit()
+    returns the part that wrapped around.
+
+  Parameters:
+    ring    - ring to read from
+    ppData  - receives the address of the first readable byte
+
+  Returns:
+    Number of bytes in the region.
+*/
+uint16_t DRV_UART_RING_ReadAcquire(const DRV_UART_RING *ring, uint8_t **ppData);
+
+// *****************************************************************************
+/* Function:
+    void DRV_UART_RING_ReadCommit(DRV_UART_RING *ring, uint16_t count)
+
+  Summary:
+    Releases bytes returned by DRV_UART_RING_ReadAcquire().
+
+  Parameters:
+    ring    - ring to read from
+    count   - number of bytes consumed, at most the acquired count
+
+  Returns:
+    None.
+*/
+void DRV_UART_RING_ReadCommit(DRV_UART_RING *ring, uint16_t count);
+
+// *****************************************************************************
+/* Function:
+    uint16_t DRV_UART_RING_WriteAcquire(const DRV_UART_RING *ring, uint8_t **ppData)
+
+  Summary:
+    Returns the contiguous writable region of the ring.
+
+  Parameters:
+    ring    - ring to write to
+    ppData  - receives the address of the first writable byte
+
+  Returns:
+    Number of bytes in the region.
+*/
+uint16_t DRV_UART_RING_WriteAcquire(const DRV_UART_RING *ring, uint8_t **ppData);
+
+// *****************************************************************************
+/* Function:
+    void DRV_UART_RING_WriteCommit(DRV_UART_RING *ring, uint16_t count)
+
+  Summary:
+    Publishes bytes stored in the region returned by DRV_UART_RING_WriteAcquire().
+
+  Parameters:
+    ring    - ring to write to
+    count   - number of bytes stored, at most the acquired count
+
+  Returns:
+    None.
+*/
+void DRV_UART_RING_WriteCommit(DRV_UART_RING *ring, uint16_t count);
+
+// *****************************************************************************
+/* Function:
+    uint8_t DRV_UART_RING_Peek(const DRV_UART_RING *ring, uint16_t offset)
+
+  Summary:
+    Returns the byte at the given offset from the tail without removing it.
+*/
+uint8_t DRV_UART_RING_Peek(const DRV_UART_RING *ring, uint16_t offset);
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: DMA Engine Routines
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void DRV_UART_DMA_Initialize(DRV_UART_DMA_OBJECT *object)
+
+  Summary:
+    Starts the receive DMA channel and prepares the transmit channel.
+
+  Description:
+    The receive channel runs in repeated one-shot mode over the whole
+    receive buffer, one byte per UART receive trigger, and interrupts at
+    the half and at the end of the buffer. The UART must be configured
+    before this routine is called; its receive and transmit interrupts
+    must stay disabled, only their flags trigger the DMA channels.
+
+  Parameters:
+    object  - statically initialized object of the UART instance
+
+  Returns:
+    None.
+*/
+void DRV_UART_DMA_Initialize(DRV_UART_DMA_OBJECT *object);
+
+// *****************************************************************************
+/* Function:
+    void DRV_UART_DMA_ReceiveUpdate(DRV_UART_DMA_OBJECT *object)
+
+  Summary:
+    Moves the head of the receive ring to the position of the DMA channel.
+
+  Description:
+    Called by the receive DMA interrupt and by the read routines. When the
+    channel overtook the tail, the oldest bytes are dropped and the
+    overrun is recorded.
+*/
+void DRV_UART_DMA_ReceiveUpdate(DRV_UART_DMA_OBJECT *object);
+
+// *****************************************************************************
+/* Function:
+    void DRV_UART_DMA_TransmitDone(DRV_UART_DMA_OBJECT *object)
+
+  Summary:
+    Releases the transmitted region and starts the next one.
+
+  Description:
+    Called by the transmit DMA interrupt.
+*/
+void DRV_UART_DMA_TransmitDone(DRV_UART_DMA_OBJECT *object);
+
+// *****************************************************************************
+/* Function:
+    void DRV_UART_DMA_Tasks(DRV_UART_DMA_OBJECT *object)
+
+  Summary:
+    Detects the end of a received message.
+
+  Description:
+    Updates the receive ring and, when data was received and the UART
+    receiver is idle, reports the idle line through DRV_UART_DMA_RxIdleGet().
+    Call it periodically from the main loop.
+*/
+void DRV_UART_DMA_Tasks(DRV_UART_DMA_OBJECT *object);
+
+// *****************************************************************************
+/* Function:
+    bool DRV_UART_DMA_RxIdleGet(DRV_UART_DMA_OBJECT *object)
+
+  Summary:
+    Returns true once after the line went idle following received data.
+*/
+bool DRV_UART_DMA_RxIdleGet(DRV_UART_DMA_OBJECT *object);
+
+// *****************************************************************************
+/* Function:
+    uint16_t DRV_UART_DMA_ReadAcquire(DRV_UART_DMA_OBJECT *object, uint8_t **ppData)
+
+  Summary:
+    Returns the contiguous region of received data.
+
+  Description:
+    The data stays in the receive buffer; it is released by
+    DRV_UART_DMA_ReadCommit(). The receive buffer must be large enough to
+    hold the data that arrives while the region is being processed.
+*/
+uint16_t DRV_UART_DMA_ReadAcquire(DRV_UART_DMA_OBJECT *object, uint8_t **ppData);
+
+// *****************************************************************************
+/* Function:
+    void DRV_UART_DMA_ReadCommit(DRV_UART_DMA_OBJECT *object, uint16_t count)
+
+  Summary:
+    Releases received bytes returned by DRV_UART_DMA_ReadAcquire().
+*/
+void DRV_UART_DMA_ReadCommit(DRV_UART_DMA_OBJECT *object, uint16_t count);
+
+// *****************************************************************************
+/* Function:
+    uint16_t DRV_UART_DMA_WriteAcquire(DRV_UART_DMA_OBJECT *object, uint8_t **ppData)
+
+  Summary:
+    Returns the contiguous free region of the transmit buffer.
+*/
+uint16_t DRV_UART_DMA_WriteAcquire(DRV_UART_DMA_OBJECT *object, uint8_t **ppData);
+
+// *****************************************************************************
+/* Function:
+    void DRV_UART_DMA_WriteCommit(DRV_UART_DMA_OBJECT *object, uint16_t count)
+
+  Summary:
+    Queues bytes stored in the region returned by DRV_UART_DMA_WriteAcquire()
+    and starts the transmit channel if it is idle.
+*/
+void DRV_UART_DMA_WriteCommit(DRV_UART_DMA_OBJECT *object, uint16_t count);
+
+// *****************************************************************************
+/* Function:
+    unsigned int DRV_UART_DMA_Read(DRV_UART_DMA_OBJECT *object, uint8_t *buffer, unsigned int numbytes)
+
+  Summary:
+    Copies up to numbytes received bytes to buffer.
+
+  Returns:
+    Number of bytes copied.
+*/
+unsigned int DRV_UART_DMA_Read(DRV_UART_DMA_OBJECT *object, uint8_t *buffer, unsigned int numbytes);
+
+// *****************************************************************************
+/* Function:
+    unsigned int DRV_UART_DMA_Write(DRV_UART_DMA_OBJECT *object, const uint8_t *buffer, unsigned int numbytes)
+
+  Summary:
+    Copies up to numbytes bytes to the transmit buffer and starts the transfer.
+
+  Returns:
+    Number of bytes queued.
+*/
+unsigned int DRV_UART_DMA_Write(DRV_UART_DMA_OBJECT *object, const uint8_t *buffer, unsigned int numbytes);
+
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+
+#endif  // _DRV_UART_DMA_H
@@ -0,0 +1,350 @@
+/*******************************************************************************
+  UART Driver Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    drv_uart.c
+
+  Summary:
+    This is the source file for the instance based UART driver
+
+  Description:
+    This source file implements the UART driver for every port and mode.
+    The port wrappers drv_uart1.c to drv_uart4.c provide the descriptors,
+    the interrupt service routines and the DRV_UARTn_* API, all built from
+    the port template drv_uart_port.h.
+*******************************************************************************/
+
+//This will be the disclaimer
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "system.h"
+#include "driver/uart/drv_uart.h"
+
+// *****************************************************************************
+/* UART Register Bits
+
+  Summary:
+    UxMODE and UxSTA bits used by the driver.
+*/
+
+#define DRV_UART_MODE_DEFAULT           (0x8008 & 0xFFFC)   // UARTEN, BRGH
+#define DRV_UART_STA_UTXEN              0x0400
+#define DRV_UART_STA_UTXBF              0x0200
+#define DRV_UART_STA_OERR               0x0002
+#define DRV_UART_STA_URXDA              0x0001
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: UART Driver Routines
+// *****************************************************************************
+// *****************************************************************************
+
+void DRV_UART_Initialize(DRV_UART_OBJECT *object, const DRV_UART_DESCRIPTOR *descriptor)
+{
+    DRV_UART_DMA_OBJECT *data = &object->data;
+    unsigned long       brg = SYS_CLK_FrequencyPeripheralGet() / (4 * descriptor->baudRate);
+    unsigned long       brg10 = SYS_CLK_FrequencyPeripheralGet() * 10 / (4 * descriptor->baudRate);
+
+    object->descriptor = descriptor;
+
+    *descriptor->uartMode = DRV_UART_MODE_DEFAULT | descriptor->pds;
+    // UTXEN disabled; URXISEL RX_ONE_CHAR; UTXISEL0 TX_ONE_CHAR; OERR NO_ERROR_cleared
+    *descriptor->uartStatus = 0x0000;
+    *descriptor->uartBaud = brg - 1 + ((brg10 - brg * 10) + 5) / 10;
+
+    *descriptor->uartStatus |= DRV_UART_STA_UTXEN;
+
+    data->rx.buffer = descriptor->rxBuffer;
+    data->rx.size = descriptor->rxSize;
+    data->tx.buffer = descriptor->txBuffer;
+    data->tx.size = descriptor->txSize;
+    data->rxChannel = descriptor->rxChannel;
+    data->txChannel = descriptor->txChannel;
+    data->uartStatus = descriptor->uartStatus;
+    data->uartReceive = descriptor->uartReceive;
+    data->uartTransmit = descriptor->uartTransmit;
+
+    if(descriptor->mode == DRV_UART_MODE_DMA)
+    {
+        DRV_UART_DMA_Initialize(data);
+        return;
+    }
+
+    DRV_UART_RING_Initialize(&data->rx, data->rx.buffer, data->rx.size);
+    DRV_UART_RING_Initialize(&data->tx, data->tx.buffer, data->tx.size);
+
+    data->txLength = 0;
+    data->rxActive = false;
+    data->rxIdle = false;
+    data->rxOverrun = false;
+}
+
+void DRV_UART_TasksTX(DRV_UART_OBJECT *object)
+{
+    const DRV_UART_DESCRIPTOR   *descriptor = object->descriptor;
+    DRV_UART_RING               *ring = &object->data.tx;
+
+    if(DRV_UART_RING_CountGet(ring) == 0)
+    {
+        if(descriptor->mode == DRV_UART_MODE_INTERRUPT)
+        {
+            descriptor->txInterruptEnable(false);
+        }
+        return;
+    }
+
+    while(!(*descriptor->uartStatus & DRV_UART_STA_UTXBF) && (ring->head != ring->tail))
+    {
+        *descriptor->uartTransmit = ring->buffer[ring->tail];
+        DRV_UART_RING_ReadCommit(ring, 1);
+    }
+}
+
+void DRV_UART_TasksRX(DRV_UART_OBJECT *object)
+{
+    const DRV_UART_DESCRIPTOR   *descriptor = object->descriptor;
+    DRV_UART_RING               *ring = &object->data.rx;
+    uint8_t                     *pData;
+
+    while(*descriptor->uartStatus & DRV_UART_STA_URXDA)
+    {
+        // the byte must leave the FIFO even when it is dropped
+        if(DRV_UART_RING_WriteAcquire(ring, &pData) == 0)
+        {
+            (void)*descriptor->uartReceive;
+            object->data.rxOverrun = true;
+            continue;
+        }
+
+        *pData = *descriptor->uartReceive;
+        DRV_UART_RING_WriteCommit(ring, 1);
+    }
+}
+
+void DRV_UART_TasksError(DRV_UART_OBJECT *object)
+{
+    if(*object->descriptor->uartStatus & DRV_UART_STA_OERR)
+    {
+        *object->descriptor->uartStatus &= ~DRV_UART_STA_OERR;
+    }
+}
+
+void DRV_UART_TasksDMA(DRV_UART_OBJECT *object)
+{
+    DRV_UART_DMA_Tasks(&object->data);
+}
+
+uint8_t DRV_UART_ReadByte(DRV_UART_OBJECT *object)
+{
+    uint8_t data = 0;
+
+    DRV_UART_Read(object, &data, 1);
+
+    return(data);
+}
+
+unsigned int DRV_UART_Read(DRV_UART_OBJECT *object, uint8_t *buffer, const unsigned int numbytes)
+{
+    unsigned int    numBytesRead = 0;
+    uint8_t         *pData;
+    unsigned int    length;
+
+    if(object->descriptor->mode == DRV_UART_MODE_DMA)
+    {
+        return(DRV_UART_DMA_Read(&object->data, buffer, numbytes));
+    }
+
+    while(numBytesRead < numbytes)
+    {
+        length = DRV_UART_RING_ReadAcquire(&object->data.rx, &pData);
+        if(length == 0)
+        {
+            break;
+        }
+
+        if(length > (numbytes - numBytesRead))
+        {
+            length = numbytes - numBytesRead;
+        }
+
+        memcpy(buffer + numBytesRead, pData, length);
+        DRV_UART_RING_ReadCommit(&object->data.rx, length);
+        numBytesRead += length;
+    }
+
+    return(numBytesRead);
+}
+
+void DRV_UART_WriteByte(DRV_UART_OBJECT *object, const uint8_t byte)
+{
+    DRV_UART_Write(object, &byte, 1);
+}
+
+unsigned int DRV_UART_Write(DRV_UART_OBJECT *object, const uint8_t *buffer, const unsigned int numbytes)
+{
+    unsigned int    numBytesWritten = 0;
+    uint8_t         *pData;
+    unsigned int    length;
+
+    if(object->descriptor->mode == DRV_UART_MODE_DMA)
+    {
+        return(DRV_UART_DMA_Write(&object->data, buffer, numbytes));
+    }
+
+    while(numBytesWritten < numbytes)
+    {
+        length = DRV_UART_RING_WriteAcquire(&object->data.tx, &pData);
+        if(length == 0)
+        {
+            break;
+        }
+
+        if(length > (numbytes - numBytesWritten))
+        {
+            length = numbytes - numBytesWritten;
+        }
+
+        memcpy(pData, buffer + numBytesWritten, length);
+        DRV_UART_RING_WriteCommit(&object->data.tx, length);
+        numBytesWritten += length;
+    }
+
+    if((numBytesWritten != 0) && (object->descriptor->mode == DRV_UART_MODE_INTERRUPT))
+    {
+        object->descriptor->txInterruptEnable(true);
+    }
+
+    return(numBytesWritten);
+}
+
+unsigned int DRV_UART_ReadAcquire(DRV_UART_OBJECT *object, uint8_t **ppData)
+{
+    if(object->descriptor->mode == DRV_UART_MODE_DMA)
+    {
+        return(DRV_UART_DMA_ReadAcquire(&object->data, ppData));
+    }
+
+    return(DRV_UART_RING_ReadAcquire(&object->data.rx, ppData));
+}
+
+void DRV_UART_ReadCommit(DRV_UART_OBJECT *object, const unsigned int numbytes)
+{
+    if(object->descriptor->mode == DRV_UART_MODE_DMA)
+    {
+        DRV_UART_DMA_ReadCommit(&object->data, numbytes);
+        return;
+    }
+
+    DRV_UART_RING_ReadCommit(&object->data.rx, numbytes);
+}
+
+unsigned int DRV_UART_WriteAcquire(DRV_UART_OBJECT *object, uint8_t **ppData)
+{
+    return(DRV_UART_RING_WriteAcquire(&object->data.tx, ppData));
+}
+
+void DRV_UART_WriteCommit(DRV_UART_OBJECT *object, const unsigned int numbytes)
+{
+    switch(object->descriptor->mode)
+    {
+        case DRV_UART_MODE_DMA:
+            DRV_UART_DMA_WriteCommit(&object->data, numbytes);
+            break;
+
+        case DRV_UART_MODE_INTERRUPT:
+            DRV_UART_RING_WriteCommit(&object->data.tx, numbytes);
+            object->descriptor->txInterruptEnable(true);
+            break;
+
+        default:
+            DRV_UART_RING_WriteCommit(&object->data.tx, numbytes);
+            break;
+    }
+}
+
+DRV_UART_TRANSFER_STATUS DRV_UART_TransferStatus(DRV_UART_OBJECT *object)
+{
+    DRV_UART_TRANSFER_STATUS    status = 0;
+    uint8_t                     *pData;
+
+    if(DRV_UART_RING_FreeGet(&object->data.tx) == 0)
+    {
+        status |= DRV_UART_TRANSFER_STATUS_TX_FULL;
+    }
+
+    if(DRV_UART_RING_CountGet(&object->data.tx) == 0)
+    {
+        status |= DRV_UART_TRANSFER_STATUS_TX_EMPTY;
+    }
+
+    if(DRV_UART_ReadAcquire(object, &pData) == 0)
+    {
+        status |= DRV_UART_TRANSFER_STATUS_RX_EMPTY;
+    }
+    else
+    {
+        status |= DRV_UART_TRANSFER_STATUS_RX_DATA_PRESENT;
+
+        if(DRV_UART_RING_FreeGet(&object->data.rx) == 0)
+        {
+            status |= DRV_UART_TRANSFER_STATUS_RX_FULL;
+        }
+    }
+
+    if(DRV_UART_DMA_RxIdleGet(&object->data))
+    {
+        status |= DRV_UART_TRANSFER_STATUS_RX_IDLE;
+    }
+
+    return(status);
+}
+
+uint8_t DRV_UART_Peek(DRV_UART_OBJECT *object, uint16_t offset)
+{
+    return(DRV_UART_RING_Peek(&object->data.rx, offset));
+}
+
+unsigned int DRV_UART_RXBufferSizeGet(DRV_UART_OBJECT *object)
+{
+    uint8_t *pData;
+
+    // publishes the bytes received by the DMA channel
+    DRV_UART_ReadAcquire(object, &pData);
+
+    return(DRV_UART_RING_CountGet(&object->data.rx));
+}
+
+unsigned int DRV_UART_TXBufferSizeGet(DRV_UART_OBJECT *object)
+{
+    return(DRV_UART_RING_CountGet(&object->data.tx));
+}
+
+bool DRV_UART_RXBufferIsEmpty(DRV_UART_OBJECT *object)
+{
+    return(DRV_UART_RXBufferSizeGet(object) == 0);
+}
+
+bool DRV_UART_TXBufferIsFull(DRV_UART_OBJECT *object)
+{
+    return(DRV_UART_RING_FreeGet(&object->data.tx) == 0);
+}
+
+uint16_t DRV_UART_Status(DRV_UART_OBJECT *object)
+{
+    return(*object->descriptor->uartStatus);
+}
+
+//*******************************************************************************
+/*
+  End of File
+*/
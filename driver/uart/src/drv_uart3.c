@@ -0,0 +1,118 @@
+/*******************************************************************************
+  UART3 Generated Driver API Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    drv_uart3.c
+
+  Summary:
+    This is the source file for the UART3 driver
+
+  Description:
+    This source file provides the DRV_UART3_* APIs. It sets the defaults of
+    the DRV_UART3_CONFIG_* options and includes the port template
+    drv_uart_port.h, which describes UART3 to the instance based driver of
+    drv_uart.h and forwards every call to it. DRV_UART3_CONFIG_MODE selects
+    the interrupt, polled or DMA mode.
+*******************************************************************************/
+
+//This will be the disclaimer
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "driver/uart/drv_uart3.h"
+#include "driver/uart/drv_uart.h"
+
+// *****************************************************************************
+/* UART Driver Mode
+
+  Summary:
+    Defines the mode of the UART3 driver
+
+*/
+
+#ifndef DRV_UART3_CONFIG_MODE
+        #define DRV_UART3_CONFIG_MODE DRV_UART_MODE_INTERRUPT
+#endif
+
+#if (DRV_UART3_CONFIG_MODE == DRV_UART_MODE_DMA)
+    #if !defined(DRV_UART3_CONFIG_DMA_RX_CHANNEL) || !defined(DRV_UART3_CONFIG_DMA_TX_CHANNEL)
+            #error "Define DRV_UART3_CONFIG_DMA_RX_CHANNEL and DRV_UART3_CONFIG_DMA_TX_CHANNEL to use the UART3 DMA driver."
+    #endif
+    #if !defined(DRV_UART3_CONFIG_DMA_RX_TRIGGER) || !defined(DRV_UART3_CONFIG_DMA_TX_TRIGGER)
+            #error "Define DRV_UART3_CONFIG_DMA_RX_TRIGGER and DRV_UART3_CONFIG_DMA_TX_TRIGGER to use the UART3 DMA driver."
+    #endif
+#endif
+
+// *****************************************************************************
+/* UART Driver Queue Length
+
+  Summary:
+    Defines the length of the Transmit and Receive Buffers
+
+*/
+
+#ifndef DRV_UART3_CONFIG_TX_BYTEQ_LENGTH
+        #define DRV_UART3_CONFIG_TX_BYTEQ_LENGTH 4
+#endif
+#ifndef DRV_UART3_CONFIG_RX_BYTEQ_LENGTH
+        #define DRV_UART3_CONFIG_RX_BYTEQ_LENGTH 4
+#endif
+
+// *****************************************************************************
+/* Default values of the static overrides
+
+  Summary:
+   Checks for the definitions, if definitions found for stop bits, data bits,
+   parity and baud rate those definitions are used, otherwise default values are
+   used.
+
+*/
+
+#if defined(DRV_UART3_CONFIG_8N1)
+        #define DRV_UART3_PDS 0
+#elif defined(DRV_UART3_CONFIG_8N2)
+        #define DRV_UART3_PDS 1
+#elif defined(DRV_UART3_CONFIG_8E1)
+        #define DRV_UART3_PDS 2
+#elif defined(DRV_UART3_CONFIG_8E2)
+        #define DRV_UART3_PDS 3
+#elif defined(DRV_UART3_CONFIG_8O1)
+        #define DRV_UART3_PDS 4
+#elif defined(DRV_UART3_CONFIG_8O2)
+        #define DRV_UART3_PDS 5
+#elif defined(DRV_UART3_CONFIG_9N1)
+        #define DRV_UART3_PDS 6
+#elif defined(DRV_UART3_CONFIG_9N2)
+        #define DRV_UART3_PDS 7
+#else
+        #define DRV_UART3_PDS 0
+#endif
+
+#if !defined(DRV_UART3_CONFIG_BAUD_RATE)
+        #define DRV_UART3_CONFIG_BAUD_RATE 9600
+#endif
+
+// *****************************************************************************
+/* UART Driver Port
+
+  Summary:
+    Builds the UART3 driver from the port template.
+
+*/
+
+#define DRV_UART_PORT   3
+
+#include "drv_uart_port.h"
+
+//*******************************************************************************
+/*
+  End of File
+*/
@@ -0,0 +1,386 @@
+/*******************************************************************************
+  UART DMA Ring Buffer Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    drv_uart_dma.c
+
+  Summary:
+    This is the source file for the DMA ring buffers shared by the UART drivers
+
+  Description:
+    This source file provides the ring buffer and the DMA engine used by
+    the UART driver of drv_uart.c.
+*******************************************************************************/
+
+//This will be the disclaimer
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "driver/uart/drv_uart_dma.h"
+
+// *****************************************************************************
+/* Critical Section
+
+  Summary:
+    Keeps the DMA interrupts out while the main loop updates shared state.
+*/
+
+#ifndef DRV_UART_DMA_CRITICAL_ENTER
+    #define DRV_UART_DMA_CRITICAL_ENTER()   __builtin_disi(0x3FFF)
+    #define DRV_UART_DMA_CRITICAL_EXIT()    __builtin_disi(0x0000)
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Ring Buffer Routines
+// *****************************************************************************
+// *****************************************************************************
+
+void DRV_UART_RING_Initialize(DRV_UART_RING *ring, uint8_t *buffer, uint16_t size)
+{
+    ring->buffer = buffer;
+    ring->size = size;
+    ring->head = 0;
+    ring->tail = 0;
+}
+
+uint16_t DRV_UART_RING_CountGet(const DRV_UART_RING *ring)
+{
+    uint16_t head = ring->head;
+    uint16_t tail = ring->tail;
+
+    if(head >= tail)
+    {
+        return(head - tail);
+    }
+
+    return(ring->size - tail + head);
+}
+
+uint16_t DRV_UART_RING_FreeGet(const DRV_UART_RING *ring)
+{
+    return(ring->size - 1 - DRV_UART_RING_CountGet(ring));
+}
+
+uint16_t DRV_UART_RING_ReadAcquire(const DRV_UART_RING *ring, uint8_t **ppData)
+{
+    uint16_t head = ring->head;
+    uint16_t tail = ring->tail;
+
+    *ppData = ring->buffer + tail;
+
+    if(head >= tail)
+    {
+        return(head - tail);
+    }
+
+    return(ring->size - tail);
+}
+
+void DRV_UART_RING_ReadCommit(DRV_UART_RING *ring, uint16_t count)
+{
+    uint16_t tail = ring->tail + count;
+
+    if(tail >= ring->size)
+    {
+        tail -= ring->size;
+    }
+
+    ring->tail = tail;
+}
+
+uint16_t DRV_UART_RING_WriteAcquire(const DRV_UART_RING *ring, uint8_t **ppData)
+{
+    uint16_t head = ring->head;
+    uint16_t tail = ring->tail;
+
+    *ppData = ring->buffer + head;
+
+    if(tail > head)
+    {
+        return(tail - head - 1);
+    }
+
+    // up to the end of the buffer, keeping one byte free when the tail is at 0
+    if(tail == 0)
+    {
+        return(ring->size - head - 1);
+    }
+
+    return(ring->size - head);
+}
+
+void DRV_UART_RING_WriteCommit(DRV_UART_RING *ring, uint16_t count)
+{
+    uint16_t head = ring->head + count;
+
+    if(head >= ring->size)
+    {
+        head -= ring->size;
+    }
+
+    ring->head = head;
+}
+
+uint8_t DRV_UART_RING_Peek(const DRV_UART_RING *ring, uint16_t offset)
+{
+    uint16_t index = ring->tail + offset;
+
+    if(index >= ring->size)
+    {
+        index -= ring->size;
+    }
+
+    return(ring->buffer[index]);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: DMA Engine Routines
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    static void DRV_UART_DMA_TransmitStart(DRV_UART_DMA_OBJECT *object)
+
+  Summary:
+    Starts a one-shot transfer of the contiguous queued region.
+
+  Description:
+    Called with the DMA interrupts masked or from the transmit DMA
+    interrupt. Does nothing when a transfer is in progress.
+*/
+static void DRV_UART_DMA_TransmitStart(DRV_UART_DMA_OBJECT *object)
+{
+    DRV_UART_DMA_CHANNEL    *channel = &object->txChannel;
+    uint8_t                 *pData;
+    uint16_t                length;
+
+    if(object->txLength != 0)
+    {
+        return;
+    }
+
+    length = DRV_UART_RING_ReadAcquire(&object->tx, &pData);
+
+    if(length == 0)
+    {
+        return;
+    }
+
+    object->txLength = length;
+
+    *channel->control = 0;
+    *channel->source = (uint16_t)pData;
+    *channel->destination = (uint16_t)object->uartTransmit;
+    *channel->count = length;
+    *channel->interrupt = (channel->trigger << DRV_UART_DMA_INT_CHSEL_SHIFT);
+    *channel->control = DRV_UART_DMA_CH_SIZE_BYTE | DRV_UART_DMA_CH_TRMODE_ONESHOT |
+                        DRV_UART_DMA_CH_SAMODE_INC | DRV_UART_DMA_CH_CHEN;
+
+    // the transmit trigger is an edge of the UART flag, send the first byte by hand
+    *channel->control |= DRV_UART_DMA_CH_CHREQ;
+}
+
+void DRV_UART_DMA_Initialize(DRV_UART_DMA_OBJECT *object)
+{
+    DRV_UART_DMA_CHANNEL    *channel = &object->rxChannel;
+
+    DRV_UART_RING_Initialize(&object->rx, object->rx.buffer, object->rx.size);
+    DRV_UART_RING_Initialize(&object->tx, object->tx.buffer, object->tx.size);
+
+    object->txLength = 0;
+    object->rxActive = false;
+    object->rxIdle = false;
+    object->rxOverrun = false;
+
+    DMACON |= DRV_UART_DMA_CON_DMAEN;
+
+    *object->txChannel.control = 0;
+
+    *channel->control = 0;
+    *channel->source = (uint16_t)object->uartReceive;
+    *channel->destination = (uint16_t)object->rx.buffer;
+    *channel->count = object->rx.size;
+    *channel->interrupt = (channel->trigger << DRV_UART_DMA_INT_CHSEL_SHIFT) | DRV_UART_DMA_INT_HALFEN;
+    *channel->control = DRV_UART_DMA_CH_SIZE_BYTE | DRV_UART_DMA_CH_TRMODE_REPEATED |
+                        DRV_UART_DMA_CH_DAMODE_INC | DRV_UART_DMA_CH_RELOAD |
+                        DRV_UART_DMA_CH_CHEN;
+}
+
+void DRV_UART_DMA_ReceiveUpdate(DRV_UART_DMA_OBJECT *object)
+{
+    DRV_UART_RING   *ring = &object->rx;
+    uint16_t        head, received;
+
+    // clear the interrupt sources, the position is read from the count
+    *object->rxChannel.interrupt &= ~(DRV_UART_DMA_INT_DONEIF | DRV_UART_DMA_INT_HALFIF | DRV_UART_DMA_INT_OVRUNIF);
+
+    head = ring->size - *object->rxChannel.count;
+    if(head >= ring->size)
+    {
+        head = 0;
+    }
+
+    if(head == ring->head)
+    {
+        return;
+    }
+
+    received = (head >= ring->head) ? (head - ring->head) : (ring->size - ring->head + head);
+
+    if(received > DRV_UART_RING_FreeGet(ring))
+    {
+        // the channel overtook the reader, keep the newest size - 1 bytes
+        object->rxOverrun = true;
+        ring->tail = (head + 1 < ring->size) ? (head + 1) : 0;
+    }
+
+    ring->head = head;
+    object->rxActive = true;
+}
+
+void DRV_UART_DMA_TransmitDone(DRV_UART_DMA_OBJECT *object)
+{
+    *object->txChannel.interrupt &= ~(DRV_UART_DMA_INT_DONEIF | DRV_UART_DMA_INT_HALFIF | DRV_UART_DMA_INT_OVRUNIF);
+
+    DRV_UART_RING_ReadCommit(&object->tx, object->txLength);
+    object->txLength = 0;
+
+    DRV_UART_DMA_TransmitStart(object);
+}
+
+void DRV_UART_DMA_Tasks(DRV_UART_DMA_OBJECT *object)
+{
+    DRV_UART_DMA_CRITICAL_ENTER();
+    DRV_UART_DMA_ReceiveUpdate(object);
+    DRV_UART_DMA_CRITICAL_EXIT();
+
+    // a byte may still be in the receive shift register, RIDLE covers it
+    if(object->rxActive && (*object->uartStatus & DRV_UART_DMA_STA_RIDLE))
+    {
+        DRV_UART_DMA_CRITICAL_ENTER();
+        DRV_UART_DMA_ReceiveUpdate(object);
+        DRV_UART_DMA_CRITICAL_EXIT();
+
+        object->rxActive = false;
+        object->rxIdle = true;
+    }
+}
+
+bool DRV_UART_DMA_RxIdleGet(DRV_UART_DMA_OBJECT *object)
+{
+    bool idle = object->rxIdle;
+
+    object->rxIdle = false;
+
+    return(idle);
+}
+
+uint16_t DRV_UART_DMA_ReadAcquire(DRV_UART_DMA_OBJECT *object, uint8_t **ppData)
+{
+    uint16_t length;
+
+    DRV_UART_DMA_CRITICAL_ENTER();
+    DRV_UART_DMA_ReceiveUpdate(object);
+    length = DRV_UART_RING_ReadAcquire(&object->rx, ppData);
+    DRV_UART_DMA_CRITICAL_EXIT();
+
+    return(length);
+}
+
+void DRV_UART_DMA_ReadCommit(DRV_UART_DMA_OBJECT *object, uint16_t count)
+{
+    // the receive interrupt moves the tail on an overrun
+    DRV_UART_DMA_CRITICAL_ENTER();
+    DRV_UART_RING_ReadCommit(&object->rx, count);
+    DRV_UART_DMA_CRITICAL_EXIT();
+}
+
+uint16_t DRV_UART_DMA_WriteAcquire(DRV_UART_DMA_OBJECT *object, uint8_t **ppData)
+{
+    return(DRV_UART_RING_WriteAcquire(&object->tx, ppData));
+}
+
+void DRV_UART_DMA_WriteCommit(DRV_UART_DMA_OBJECT *object, uint16_t count)
+{
+    DRV_UART_RING_WriteCommit(&object->tx, count);
+
+    DRV_UART_DMA_CRITICAL_ENTER();
+    DRV_UART_DMA_TransmitStart(object);
+    DRV_UART_DMA_CRITICAL_EXIT();
+}
+
+unsigned int DRV_UART_DMA_Read(DRV_UART_DMA_OBJECT *object, uint8_t *buffer, unsigned int numbytes)
+{
+    unsigned int    numBytesRead = 0;
+    uint8_t         *pData;
+    uint16_t        length;
+
+    while(numBytesRead < numbytes)
+    {
+        length = DRV_UART_DMA_ReadAcquire(object, &pData);
+        if(length == 0)
+        {
+            break;
+        }
+
+        if(length > (numbytes - numBytesRead))
+        {
+            length = numbytes - numBytesRead;
+        }
+
+        memcpy(buffer + numBytesRead, pData, length);
+        DRV_UART_DMA_ReadCommit(object, length);
+        numBytesRead += length;
+    }
+
+    return(numBytesRead);
+}
+
+unsigned int DRV_UART_DMA_Write(DRV_UART_DMA_OBJECT *object, const uint8_t *buffer, unsigned int numbytes)
+{
+    unsigned int    numBytesWritten = 0;
+    uint8_t         *pData;
+    uint16_t        length;
+
+    while(numBytesWritten < numbytes)
+    {
+        length = DRV_UART_DMA_WriteAcquire(object, &pData);
+        if(length == 0)
+        {
+            break;
+        }
+
+        if(length > (numbytes - numBytesWritten))
+        {
+            length = numbytes - numBytesWritten;
+        }
+
+        memcpy(pData, buffer + numBytesWritten, length);
+        DRV_UART_RING_WriteCommit(&object->tx, length);
+        numBytesWritten += length;
+    }
+
+    // one start for the whole copy
+    DRV_UART_DMA_CRITICAL_ENTER();
+    DRV_UART_DMA_TransmitStart(object);
+    DRV_UART_DMA_CRITICAL_EXIT();
+
+    return(numBytesWritten);
+}
+
+//*******************************************************************************
+/*
+  End of File
+*/
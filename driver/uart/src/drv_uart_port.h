@@ -0,0 +1,382 @@
+/*******************************************************************************
+  UART Driver Port Template
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    drv_uart_port.h
+
+  Summary:
+    This is the port template of the instance based UART driver
+
+  Description:
+    This file is included once by each of the port wrappers drv_uart1.c to
+    drv_uart4.c, after the wrapper has defined DRV_UART_PORT to its port
+    number and the defaults of its DRV_UARTn_CONFIG_* options. It defines
+    the buffers, the port descriptor and the instance object of the port,
+    its interrupt service routines or Tasks functions, and the DRV_UARTn_*
+    API forwarding to drv_uart.c. The register, interrupt bit and API
+    names of the port are built from DRV_UART_PORT, so the four ports
+    share one copy of this code.
+
+    The file is not a header of its own and must not be compiled alone.
+*******************************************************************************/
+
+//This will be the disclaimer
+
+#ifndef DRV_UART_PORT
+        #error "Define DRV_UART_PORT before including drv_uart_port.h."
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "driver/uart/drv_uart.h"
+
+// *****************************************************************************
+/* Port Names
+
+  Summary:
+    Builds the names of the registers, interrupts and API of the port.
+
+  Description:
+    DRV_UART_PORT_NAME(U, MODE) is U1MODE for port 1, the extra level of
+    macros expands DRV_UART_PORT before the tokens are pasted.
+*/
+
+#define DRV_UART_PORT_NAME(prefix, suffix)          DRV_UART_PORT_NAME_(prefix, DRV_UART_PORT, suffix)
+#define DRV_UART_PORT_NAME_(prefix, port, suffix)   DRV_UART_PORT_NAME__(prefix, port, suffix)
+#define DRV_UART_PORT_NAME__(prefix, port, suffix)  prefix##port##suffix
+
+#define DRV_UART_PORT_API(suffix)                   DRV_UART_PORT_NAME(DRV_UART, _##suffix)
+#define DRV_UART_PORT_ISR(suffix)                   void __attribute__ ( ( interrupt, no_auto_psv ) ) DRV_UART_PORT_NAME(_U, suffix) ( void )
+
+#define DRV_UART_PORT_MODE                          DRV_UART_PORT_API(CONFIG_MODE)
+#define DRV_UART_PORT_TX_BYTEQ_LENGTH               DRV_UART_PORT_API(CONFIG_TX_BYTEQ_LENGTH)
+#define DRV_UART_PORT_RX_BYTEQ_LENGTH               DRV_UART_PORT_API(CONFIG_RX_BYTEQ_LENGTH)
+#define DRV_UART_PORT_DMA_RX_CHANNEL                DRV_UART_PORT_API(CONFIG_DMA_RX_CHANNEL)
+#define DRV_UART_PORT_DMA_TX_CHANNEL                DRV_UART_PORT_API(CONFIG_DMA_TX_CHANNEL)
+
+#if (DRV_UART_PORT_MODE != DRV_UART_MODE_INTERRUPT) && (DRV_UART_PORT_MODE != DRV_UART_MODE_POLL) && (DRV_UART_PORT_MODE != DRV_UART_MODE_DMA)
+        #error "DRV_UARTn_CONFIG_MODE must be DRV_UART_MODE_INTERRUPT, DRV_UART_MODE_POLL or DRV_UART_MODE_DMA."
+#endif
+
+// *****************************************************************************
+
+/* UART Driver Queue
+
+  Summary:
+    Defines the Transmit and Receive Buffers
+
+  Description:
+    The ring buffers leave one byte unused, each buffer has one more byte
+    than the queue length so the queues hold the configured number of bytes.
+
+*/
+
+static uint8_t drv_uart_txByteQ[DRV_UART_PORT_TX_BYTEQ_LENGTH + 1] ;
+static uint8_t drv_uart_rxByteQ[DRV_UART_PORT_RX_BYTEQ_LENGTH + 1] ;
+
+#if (DRV_UART_PORT_MODE == DRV_UART_MODE_INTERRUPT)
+static void DRV_UART_PORT_TXInterruptEnable(bool enable)
+{
+    DRV_UART_PORT_NAME(_U, TXIE) = enable;
+}
+#endif
+
+// *****************************************************************************
+/* UART Driver Port Descriptor and Instance Object
+
+  Summary:
+    Describes the port to the driver and holds its state.
+
+*/
+
+static const DRV_UART_DESCRIPTOR drv_uart_descriptor =
+{
+    .mode               = DRV_UART_PORT_MODE,
+    .uartMode           = &DRV_UART_PORT_NAME(U, MODE),
+    .uartStatus         = &DRV_UART_PORT_NAME(U, STA),
+    .uartBaud           = &DRV_UART_PORT_NAME(U, BRG),
+    .uartReceive        = &DRV_UART_PORT_NAME(U, RXREG),
+    .uartTransmit       = &DRV_UART_PORT_NAME(U, TXREG),
+#if (DRV_UART_PORT_MODE == DRV_UART_MODE_INTERRUPT)
+    .txInterruptEnable  = DRV_UART_PORT_TXInterruptEnable,
+#endif
+    .rxBuffer           = drv_uart_rxByteQ,
+    .rxSize             = DRV_UART_PORT_RX_BYTEQ_LENGTH + 1,
+    .txBuffer           = drv_uart_txByteQ,
+    .txSize             = DRV_UART_PORT_TX_BYTEQ_LENGTH + 1,
+    .baudRate           = DRV_UART_PORT_API(CONFIG_BAUD_RATE),
+    .pds                = DRV_UART_PORT_API(PDS),
+#if (DRV_UART_PORT_MODE == DRV_UART_MODE_DMA)
+    .rxChannel          = DRV_UART_DMA_CHANNEL_DEFINE(DRV_UART_PORT_DMA_RX_CHANNEL, DRV_UART_PORT_API(CONFIG_DMA_RX_TRIGGER)),
+    .txChannel          = DRV_UART_DMA_CHANNEL_DEFINE(DRV_UART_PORT_DMA_TX_CHANNEL, DRV_UART_PORT_API(CONFIG_DMA_TX_TRIGGER)),
+#endif
+};
+
+static DRV_UART_OBJECT drv_uart_obj ;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Driver Interface Function Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function: void DRV_UARTn_InitializerDefault(void)
+
+  Summary:
+    Initializes the UART instance : n
+
+*/
+
+void DRV_UART_PORT_API(InitializerDefault) (void)
+{
+   DRV_UART_Initialize(&drv_uart_obj, &drv_uart_descriptor);
+
+#if (DRV_UART_PORT_MODE == DRV_UART_MODE_INTERRUPT)
+   DRV_UART_PORT_NAME(_U, RXIE) = 1;
+#elif (DRV_UART_PORT_MODE == DRV_UART_MODE_DMA)
+   // the UART interrupt flags only trigger the DMA channels
+   DRV_UART_DMA_IF(DRV_UART_PORT_DMA_RX_CHANNEL) = false;
+   DRV_UART_DMA_IF(DRV_UART_PORT_DMA_TX_CHANNEL) = false;
+   DRV_UART_DMA_IE(DRV_UART_PORT_DMA_RX_CHANNEL) = true;
+   DRV_UART_DMA_IE(DRV_UART_PORT_DMA_TX_CHANNEL) = true;
+#endif
+}
+
+#if (DRV_UART_PORT_MODE == DRV_UART_MODE_INTERRUPT)
+
+// *****************************************************************************
+/* Function:
+    void __attribute__ ( ( interrupt, no_auto_psv ) ) _UnTXInterrupt ( void )
+
+  Summary:
+    Maintains the driver's transmitter state machine and implements its ISR
+
+*/
+DRV_UART_PORT_ISR(TXInterrupt)
+{
+    DRV_UART_PORT_NAME(_U, TXIF) = false;
+
+    DRV_UART_TasksTX(&drv_uart_obj);
+}
+
+// *****************************************************************************
+/* Function:
+    void __attribute__ ( ( interrupt, no_auto_psv ) ) _UnRXInterrupt ( void )
+
+  Summary:
+    Maintains the driver's receiver state machine and implements its ISR
+
+*/
+DRV_UART_PORT_ISR(RXInterrupt)
+{
+    DRV_UART_TasksRX(&drv_uart_obj);
+
+    DRV_UART_PORT_NAME(_U, RXIF) = false;
+}
+
+#elif (DRV_UART_PORT_MODE == DRV_UART_MODE_POLL)
+
+// *****************************************************************************
+/* Function:
+    void DRV_UARTn_TasksTX ( void )
+
+  Summary:
+    Maintains the driver's transmitter state machine in a polled manner
+
+*/
+void DRV_UART_PORT_API(TasksTX) ( void )
+{
+    DRV_UART_PORT_NAME(_U, TXIF) = false;
+
+    DRV_UART_TasksTX(&drv_uart_obj);
+}
+
+// *****************************************************************************
+/* Function:
+    void DRV_UARTn_TasksRX ( void )
+
+  Summary:
+    Maintains the driver's receiver state machine in a polled manner
+
+*/
+void DRV_UART_PORT_API(TasksRX) ( void )
+{
+    DRV_UART_TasksRX(&drv_uart_obj);
+
+    DRV_UART_PORT_NAME(_U, RXIF) = false;
+}
+
+// *****************************************************************************
+/* Function:
+    void DRV_UARTn_TasksError ( void )
+
+  Summary:
+    Maintains the driver's error-handling state machine in a polled manner
+
+*/
+void DRV_UART_PORT_API(TasksError) ( void )
+{
+    DRV_UART_TasksError(&drv_uart_obj);
+
+    DRV_UART_PORT_NAME(_U, ERIF) = false;
+}
+
+#else
+
+// *****************************************************************************
+/* Function:
+    void __attribute__ ( ( interrupt, no_auto_psv ) ) _DMAxInterrupt ( void )
+
+  Summary:
+    Updates the receive ring at the half and at the end of the receive buffer
+
+*/
+DRV_UART_DMA_ISR(DRV_UART_PORT_DMA_RX_CHANNEL)
+{
+    DRV_UART_DMA_ReceiveUpdate(&drv_uart_obj.data);
+
+    DRV_UART_DMA_IF(DRV_UART_PORT_DMA_RX_CHANNEL) = false;
+}
+
+// *****************************************************************************
+/* Function:
+    void __attribute__ ( ( interrupt, no_auto_psv ) ) _DMAxInterrupt ( void )
+
+  Summary:
+    Starts the transfer of the next queued region when a transfer completes
+
+*/
+DRV_UART_DMA_ISR(DRV_UART_PORT_DMA_TX_CHANNEL)
+{
+    DRV_UART_DMA_TransmitDone(&drv_uart_obj.data);
+
+    DRV_UART_DMA_IF(DRV_UART_PORT_DMA_TX_CHANNEL) = false;
+}
+
+// *****************************************************************************
+/* Function:
+    void DRV_UARTn_TasksDMA ( void )
+
+  Summary:
+    Updates the receive ring and detects the idle line
+
+*/
+void DRV_UART_PORT_API(TasksDMA) ( void )
+{
+    DRV_UART_TasksDMA(&drv_uart_obj);
+}
+
+#endif
+
+#if (DRV_UART_PORT_MODE != DRV_UART_MODE_POLL)
+
+// *****************************************************************************
+/* Function:
+    void __attribute__ ( ( interrupt, no_auto_psv ) ) _UnErrInterrupt ( void );
+
+  Summary:
+    Maintains the driver's error-handling state machine and implements its ISR
+
+*/
+DRV_UART_PORT_ISR(ErrInterrupt)
+{
+    DRV_UART_TasksError(&drv_uart_obj);
+
+    DRV_UART_PORT_NAME(_U, ERIF) = false;
+}
+
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: UART Driver Client Routines
+// *****************************************************************************
+// *****************************************************************************
+
+uint8_t DRV_UART_PORT_API(ReadByte)( void)
+{
+    return DRV_UART_ReadByte(&drv_uart_obj);
+}
+
+unsigned int DRV_UART_PORT_API(Read)( uint8_t *buffer ,  const unsigned int numbytes)
+{
+    return DRV_UART_Read(&drv_uart_obj, buffer, numbytes);
+}
+
+void DRV_UART_PORT_API(WriteByte)( const uint8_t byte)
+{
+    DRV_UART_WriteByte(&drv_uart_obj, byte);
+}
+
+unsigned int DRV_UART_PORT_API(Write)( const uint8_t *buffer , const unsigned int numbytes )
+{
+    return DRV_UART_Write(&drv_uart_obj, buffer, numbytes);
+}
+
+unsigned int DRV_UART_PORT_API(ReadAcquire)( uint8_t **ppData )
+{
+    return DRV_UART_ReadAcquire(&drv_uart_obj, ppData);
+}
+
+void DRV_UART_PORT_API(ReadCommit)( const unsigned int numbytes )
+{
+    DRV_UART_ReadCommit(&drv_uart_obj, numbytes);
+}
+
+unsigned int DRV_UART_PORT_API(WriteAcquire)( uint8_t **ppData )
+{
+    return DRV_UART_WriteAcquire(&drv_uart_obj, ppData);
+}
+
+void DRV_UART_PORT_API(WriteCommit)( const unsigned int numbytes )
+{
+    DRV_UART_WriteCommit(&drv_uart_obj, numbytes);
+}
+
+DRV_UART_PORT_API(TRANSFER_STATUS) DRV_UART_PORT_API(TransferStatus) (void )
+{
+    return (DRV_UART_PORT_API(TRANSFER_STATUS))DRV_UART_TransferStatus(&drv_uart_obj);
+}
+
+uint8_t DRV_UART_PORT_API(Peek)(uint16_t offset)
+{
+    return DRV_UART_Peek(&drv_uart_obj, offset);
+}
+
+unsigned int DRV_UART_PORT_API(RXBufferSizeGet)(void)
+{
+    return DRV_UART_RXBufferSizeGet(&drv_uart_obj);
+}
+
+unsigned int DRV_UART_PORT_API(TXBufferSizeGet)(void)
+{
+    return DRV_UART_TXBufferSizeGet(&drv_uart_obj);
+}
+
+bool DRV_UART_PORT_API(RXBufferIsEmpty) (void)
+{
+    return DRV_UART_RXBufferIsEmpty(&drv_uart_obj);
+}
+
+bool DRV_UART_PORT_API(TXBufferIsFull) (void)
+{
+    return DRV_UART_TXBufferIsFull(&drv_uart_obj);
+}
+
+DRV_UART_PORT_API(STATUS) DRV_UART_PORT_API(Status) (void)
+{
+    return DRV_UART_Status(&drv_uart_obj);
+}
+
+//*******************************************************************************
+/*
+  End of File
+*/
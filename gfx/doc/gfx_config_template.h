@@ -216,6 +216,33 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 // *****************************************************************************
 #define GFX_CONFIG_GRADIENT_DISABLE
 
+// *****************************************************************************
+/*
+    <GROUP  configuring_options_graphics_library_doc>
+
+    Macro:
+        GFX_CONFIG_GRADIENT_DITHER_ENABLE
+
+    Summary:
+        Macro enables the dithering of gradient fills.
+
+    Description:
+        When this macro is defined, the colors of gradient fills are
+        rendered with a 4x4 ordered dither. This removes the visible
+        bands of slow gradients on large panels.
+
+        To enable this feature, add this macro in the configuration.
+        This macro has no effect when the color depth is not 16 bpp.
+        Dithered gradients that change from row to row are rendered
+        one row at a time instead of one bar per color.
+
+    Remarks:
+        None.
+
+*/
+// *****************************************************************************
+#define   GFX_CONFIG_GRADIENT_DITHER_ENABLE
+
 // *****************************************************************************
 /* 
     <GROUP  configuring_options_graphics_library_doc>
@@ -597,6 +624,68 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 // *****************************************************************************
 #define GFX_CONFIG_RLE_DECODE_DISABLE
 
+// *****************************************************************************
+/*
+    <GROUP  configuring_options_graphics_library_doc>
+
+    Macro:
+        GFX_CONFIG_RLE_ROW_INDEX_SIZE
+
+    Summary:
+        Macro enables the RLE row indexes and sets the number of
+        images with an index.
+
+    Description:
+        A portion of an RLE compressed image that does not start at
+        the first row of the image is found by skipping the compressed
+        rows before it. When this macro is defined, the offsets of the
+        skipped rows are kept in a row index of the image, so the
+        next portions of the image are found by skipping at most the
+        rows between two index entries. This is useful when a large
+        RLE image is scrolled or rendered one portion at a time.
+        When more images than indexes are rendered, the indexes are
+        reused in turn.
+
+        Each index uses GFX_CONFIG_RLE_ROW_INDEX_ENTRIES offsets of
+        4 bytes of RAM.
+
+        <code>
+            // keep the row index of the scrolled background image
+            #define GFX_CONFIG_RLE_ROW_INDEX_SIZE 1
+        </code>
+
+    Remarks:
+        None.
+
+*/
+// *****************************************************************************
+#define GFX_CONFIG_RLE_ROW_INDEX_SIZE  /* DOM-IGNORE-BEGIN */ 1 /* DOM-IGNORE-END */
+
+// *****************************************************************************
+/*
+    <GROUP  configuring_options_graphics_library_doc>
+
+    Macro:
+        GFX_CONFIG_RLE_ROW_INDEX_ENTRIES
+
+    Summary:
+        Macro sets the number of entries of an RLE row index.
+
+    Description:
+        This macro sets the number of row offsets kept in the index
+        of an RLE image. The entries are spread evenly over the rows
+        of the image. When not defined, 32 entries are kept.
+
+        This macro will have no effect when GFX_CONFIG_RLE_ROW_INDEX_SIZE
+        is not defined.
+
+    Remarks:
+        None.
+
+*/
+// *****************************************************************************
+#define GFX_CONFIG_RLE_ROW_INDEX_ENTRIES  /* DOM-IGNORE-BEGIN */ 32 /* DOM-IGNORE-END */
+
 // *****************************************************************************
 /* 
     <GROUP  configuring_options_graphics_library_doc>
@@ -611,7 +700,8 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
         Images can also be compressed using the DEFLATE algorithm. Using the 
         drivers that supports DEFLATE (IPU of PIC24FJ256DA210 Family of devices), 
         GFX_ImageDraw() will be able to render these images. 
-        This feature is enabled by default.
+        Other drivers render them when GFX_CONFIG_IPU_DECODE_WINDOW_SIZE
+        is defined. This feature is enabled by default.
                 
         To disable this feature, add this macro in the configuration.
         
@@ -622,6 +712,99 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 // *****************************************************************************
 #define GFX_CONFIG_IPU_DECODE_DISABLE
 
+// *****************************************************************************
+/* 
+    <GROUP  configuring_options_graphics_library_doc>
+
+    Macro:
+        GFX_CONFIG_IPU_DECODE_WINDOW_SIZE
+
+    Summary:
+        Macro that enables the software decoder of IPU images.
+
+    Description:
+        When this macro is defined and GFX_CONFIG_IPU_DECODE_DISABLE is 
+        not defined, drivers without an inflate unit render the DEFLATE 
+        compressed images in software, one row at a time. The value is 
+        the number of decoded bytes kept for the matches of the DEFLATE 
+        data and must be a power of 2. An image compressed with matches 
+        farther than the window stops rendering at the first such match, 
+        compress the images with a window of the same size or smaller.
+
+        The decoder uses the window and about 800 bytes of RAM.
+
+        <code>
+            #define GFX_CONFIG_IPU_DECODE_WINDOW_SIZE 4096
+        </code>
+
+    Remarks:
+        The PIC24FJ256DA210 driver always uses the IPU.
+
+*/
+// *****************************************************************************
+#define GFX_CONFIG_IPU_DECODE_WINDOW_SIZE  /* DOM-IGNORE-BEGIN */ 4096 /* DOM-IGNORE-END */
+
+// *****************************************************************************
+/* 
+    <GROUP  configuring_options_graphics_library_doc>
+
+    Macro:
+        GFX_CONFIG_JPEG_DECODE_ENABLE
+
+    Summary:
+        Macro that enables the decoding of JPEG image files.
+
+    Description:
+        When this macro is defined, GFX_ImageFileCreate() accepts 
+        baseline JPEG files and GFX_ImageDraw() decodes them from the 
+        file one MCU at a time. The decoder uses about 2 KBytes of RAM.
+        
+        The color depth must be 8 bits or more and the palette must 
+        be disabled.
+
+    Remarks:
+        None.
+
+*/
+// *****************************************************************************
+#define GFX_CONFIG_JPEG_DECODE_ENABLE
+
+// *****************************************************************************
+/* 
+    <GROUP  configuring_options_graphics_library_doc>
+
+    Macro:
+        GFX_CONFIG_PNG_DECODE_ROW_SIZE
+
+    Summary:
+        Macro that enables the decoding of PNG image files.
+
+    Description:
+        When this macro is defined, GFX_ImageFileCreate() accepts 
+        non interlaced PNG files and GFX_ImageDraw() decodes them 
+        from the file one row at a time. The value is the largest 
+        number of bytes in a row of the images (the width times the 
+        bytes per pixel), two rows are kept in RAM.
+        
+        The data is decompressed with the software decoder of the IPU 
+        images, GFX_CONFIG_IPU_DECODE_WINDOW_SIZE must be defined. PNG 
+        encoders use a window of 32768 bytes, a smaller window works 
+        only with images encoded with that window or smaller.
+
+        The color depth must be 8 bits or more and the palette must 
+        be disabled.
+
+        <code>
+            #define GFX_CONFIG_PNG_DECODE_ROW_SIZE 960
+        </code>
+
+    Remarks:
+        None.
+
+*/
+// *****************************************************************************
+#define GFX_CONFIG_PNG_DECODE_ROW_SIZE  /* DOM-IGNORE-BEGIN */ 960 /* DOM-IGNORE-END */
+
 // *****************************************************************************
 /* 
     <GROUP  configuring_options_graphics_library_doc>
@@ -721,6 +904,318 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 // *****************************************************************************
 #define GFX_EXTERNAL_FONT_RASTER_BUFFER_SIZE  /* DOM-IGNORE-BEGIN */ 51 /* DOM-IGNORE-END */
 
+// *****************************************************************************
+/*
+    <GROUP  configuring_options_graphics_library_doc>
+
+    Macro:
+        GFX_CONFIG_EXTERNAL_CACHE_BLOCKS
+
+    Summary:
+        Macro enables the external resource cache and sets the number
+        of cached blocks.
+
+    Description:
+        When this macro is defined, the image and font functions read
+        external resources through a cache of aligned blocks. Each
+        block is read with one call to GFX_ExternalResourceCallback(),
+        so the many small reads of RLE images, image rows and font
+        glyphs cost one external memory transfer per block. When all
+        the blocks are used, the least recently used block is replaced.
+
+        Each block uses GFX_CONFIG_EXTERNAL_CACHE_BLOCK_SIZE bytes of RAM.
+
+        <code>
+            // keep the font header and the image being decoded
+            #define GFX_CONFIG_EXTERNAL_CACHE_BLOCKS 4
+        </code>
+
+    Remarks:
+        None.
+
+*/
+// *****************************************************************************
+#define GFX_CONFIG_EXTERNAL_CACHE_BLOCKS  /* DOM-IGNORE-BEGIN */ 4 /* DOM-IGNORE-END */
+
+// *****************************************************************************
+/*
+    <GROUP  configuring_options_graphics_library_doc>
+
+    Macro:
+        GFX_CONFIG_EXTERNAL_CACHE_BLOCK_SIZE
+
+    Summary:
+        Macro sets the size in bytes of an external resource cache block.
+
+    Description:
+        This macro sets the size of the blocks of the external resource
+        cache. Blocks start at multiples of the size in the resource.
+        Reads of a block size or more are not cached. A size that is
+        a multiple of the page size of the external memory is
+        recommended, 256 or 512 bytes for most serial flash devices.
+        When not defined, the blocks are 256 bytes.
+
+        This macro will have no effect when GFX_CONFIG_EXTERNAL_CACHE_BLOCKS
+        is not defined.
+
+    Remarks:
+        None.
+
+*/
+// *****************************************************************************
+#define GFX_CONFIG_EXTERNAL_CACHE_BLOCK_SIZE  /* DOM-IGNORE-BEGIN */ 256 /* DOM-IGNORE-END */
+
+// *****************************************************************************
+/* 
+    <GROUP  configuring_options_graphics_library_doc>
+
+    Macro:
+        GFX_CONFIG_FONT_GLYPH_CACHE_SIZE
+
+    Summary:
+        Macro enables the glyph cache and sets the number of cached
+        glyphs.
+        
+    Description:
+        When this macro is defined, the characters rendered with fonts
+        in flash or external memory are decoded into a RAM cache of
+        pixel rows. Characters that are drawn again with the same font
+        and colors are rendered from the cache without reading the
+        font resource. When the cache is full the least recently used
+        glyph is replaced.
+
+        Each cached glyph uses GFX_CONFIG_FONT_GLYPH_CACHE_PIXELS bytes
+        plus GFX_CONFIG_FONT_GLYPH_CACHE_PIXELS colors of RAM.
+
+        <code>
+            // cache the digits and symbols of a meter
+            #define GFX_CONFIG_FONT_GLYPH_CACHE_SIZE 16
+        </code>
+
+    Remarks:
+        None.
+        
+*/
+// *****************************************************************************
+#define GFX_CONFIG_FONT_GLYPH_CACHE_SIZE  /* DOM-IGNORE-BEGIN */ 16 /* DOM-IGNORE-END */
+
+// *****************************************************************************
+/* 
+    <GROUP  configuring_options_graphics_library_doc>
+
+    Macro:
+        GFX_CONFIG_FONT_GLYPH_CACHE_PIXELS
+
+    Summary:
+        Macro sets the maximum size in pixels of a cached glyph.
+        
+    Description:
+        This macro sets the maximum number of pixels (glyph width times
+        font height) of a glyph that can be stored in the glyph cache.
+        Larger glyphs are rendered directly from the font resource.
+        When not defined, the size is set to 256 pixels.
+
+        This macro will have no effect when GFX_CONFIG_FONT_GLYPH_CACHE_SIZE
+        is not defined.
+        
+    Remarks:
+        None.
+        
+*/
+// *****************************************************************************
+#define GFX_CONFIG_FONT_GLYPH_CACHE_PIXELS  /* DOM-IGNORE-BEGIN */ 256 /* DOM-IGNORE-END */
+
+// *****************************************************************************
+/* 
+    <GROUP  configuring_options_graphics_library_doc>
+
+    Macro:
+        GFX_CONFIG_FONT_WIDTH_TABLE_SIZE
+
+    Summary:
+        Macro enables the font width tables and sets the number of
+        fonts with a table.
+        
+    Description:
+        When this macro is defined, GFX_TextStringWidthGet() keeps a
+        table of the character widths of fonts located in flash or
+        external memory. Each width is read from the font once, after
+        that the width of a string is the sum of the table entries.
+        When more fonts than tables are measured, the tables are
+        reused in turn.
+
+        Each table uses GFX_CONFIG_FONT_WIDTH_TABLE_CHARS bytes of RAM.
+
+        <code>
+            // keep the widths of the three fonts of the application
+            #define GFX_CONFIG_FONT_WIDTH_TABLE_SIZE 3
+        </code>
+
+    Remarks:
+        None.
+        
+*/
+// *****************************************************************************
+#define GFX_CONFIG_FONT_WIDTH_TABLE_SIZE  /* DOM-IGNORE-BEGIN */ 3 /* DOM-IGNORE-END */
+
+// *****************************************************************************
+/* 
+    <GROUP  configuring_options_graphics_library_doc>
+
+    Macro:
+        GFX_CONFIG_FONT_WIDTH_TABLE_CHARS
+
+    Summary:
+        Macro sets the number of characters in a font width table.
+        
+    Description:
+        This macro sets the number of characters, counted from the
+        first character of the font, that are kept in a font width
+        table. The widths of the other characters are read from the
+        font every time. When not defined, 96 characters are kept.
+
+        This macro will have no effect when GFX_CONFIG_FONT_WIDTH_TABLE_SIZE
+        is not defined.
+        
+    Remarks:
+        None.
+        
+*/
+// *****************************************************************************
+#define GFX_CONFIG_FONT_WIDTH_TABLE_CHARS  /* DOM-IGNORE-BEGIN */ 96 /* DOM-IGNORE-END */
+
+// *****************************************************************************
+/* 
+    <GROUP  configuring_options_graphics_library_doc>
+
+    Macro:
+        GFX_CONFIG_DISPLAY_LIST_SIZE
+
+    Summary:
+        Macro enables the display list and sets the number of
+        recorded commands.
+        
+    Description:
+        When this macro is defined, the bars and images drawn between
+        GFX_DisplayListBegin() and GFX_DisplayListEnd() are recorded
+        and drawn when the list ends. GFX_GOL_ObjectListDraw() records
+        the objects it redraws. A recorded command that is fully
+        covered by a later bar or image is not drawn, and adjacent
+        bars of the same color are drawn as one bar. The recorded
+        commands are drawn when the list is full.
+
+        Each command uses about 24 bytes of RAM.
+
+        <code>
+            // record the redraw of a screen of objects
+            #define GFX_CONFIG_DISPLAY_LIST_SIZE 64
+        </code>
+        
+    Remarks:
+        None.
+        
+*/
+// *****************************************************************************
+#define GFX_CONFIG_DISPLAY_LIST_SIZE  /* DOM-IGNORE-BEGIN */ 64 /* DOM-IGNORE-END */
+
+// *****************************************************************************
+/*
+    <GROUP  configuring_options_graphics_library_doc>
+
+    Macro:
+        GFX_CONFIG_CLIP_STACK_SIZE
+
+    Summary:
+        Macro enables the clip rectangle and sets the number of
+        clip rectangles that can be pushed.
+
+    Description:
+        When this macro is defined, bars, lines, text and images are
+        only rendered inside the clip rectangle set by GFX_ClipPush().
+        Each push intersects the current clip rectangle with the
+        given area and GFX_ClipPop() restores the previous one.
+
+        GFX_GOL_ObjectRectangleRedraw() uses the clip rectangle to
+        redraw the objects in the area only inside the area.
+
+        Each level uses 8 bytes of RAM.
+
+        <code>
+            // allow the GOL redraw and the application to each push two areas
+            #define GFX_CONFIG_CLIP_STACK_SIZE 4
+        </code>
+
+    Remarks:
+        None.
+
+*/
+// *****************************************************************************
+#define GFX_CONFIG_CLIP_STACK_SIZE  /* DOM-IGNORE-BEGIN */ 4 /* DOM-IGNORE-END */
+
+// *****************************************************************************
+/*
+    <GROUP  configuring_options_graphics_library_doc>
+
+    Macro:
+        GFX_CONFIG_POLYGON_FILL_POINTS
+
+    Summary:
+        Macro enables GFX_PolygonFillDraw() and sets the maximum number
+        of points of a filled polygon.
+
+    Description:
+        When this macro is defined, GFX_PolygonFillDraw() renders filled
+        polygons of up to GFX_CONFIG_POLYGON_FILL_POINTS points as
+        horizontal spans. A polygon of n sides is given by n + 1 points
+        (see GFX_PolygonDraw()).
+
+        The edge and span tables use about 24 bytes of RAM per point in
+        each rendering context (see GFX_CONTEXT).
+
+        <code>
+            // fill meter needles and chart areas of up to 32 points
+            #define GFX_CONFIG_POLYGON_FILL_POINTS 32
+        </code>
+
+    Remarks:
+        None.
+
+*/
+// *****************************************************************************
+#define GFX_CONFIG_POLYGON_FILL_POINTS  /* DOM-IGNORE-BEGIN */ 32 /* DOM-IGNORE-END */
+
+// *****************************************************************************
+/* 
+    <GROUP  configuring_options_graphics_library_doc>
+
+    Macro:
+        GFX_CONFIG_SURFACE_ENABLE
+
+    Summary:
+        Macro enables off-screen surfaces.
+
+    Description:
+        When this macro is defined, the primitives can render to a
+        surface in RAM or to a draw buffer of the display driver
+        (see GFX_SurfaceSet()), and surfaces can be drawn to the
+        display with color key and alpha blending (see
+        GFX_SurfacePartialDraw()). Static content such as meter dials
+        can then be rendered once and copied on each update.
+
+        The library uses one line buffer of RAM, the pixels of the
+        surfaces are provided by the application.
+
+        <code>
+            #define GFX_CONFIG_SURFACE_ENABLE
+        </code>
+
+    Remarks:
+        None.
+
+*/
+// *****************************************************************************
+#define   GFX_CONFIG_SURFACE_ENABLE
+
 // *****************************************************************************
 /* 
     <GROUP  configuring_options_graphics_library_doc>
@@ -1735,6 +1735,12 @@ GFX_STATUS GFX_GOL_ObjectListDraw(void);
         After calling this function, the next call to GFX_GOL_ObjectListDraw()
         will redraw all objects that are marked for redraw.
 
+        When GFX_CONFIG_CLIP_STACK_SIZE is defined, the area is kept
+        instead and the next pass of GFX_GOL_ObjectListDraw() redraws
+        the objects intersected by the area. An object that has nothing
+        else to redraw is only redrawn inside the area (see GFX_ClipPush()).
+        Areas marked before the pass starts are merged into one area.
+
     Precondition:
         None.
 
@@ -169,6 +169,143 @@ void GFX_Initialize(void);
 extern inline void GFX_Primitive_Initialize(void);
 // DOM-IGNORE-END
 
+// *****************************************************************************
+/*  
+    <GROUP init_functions>
+
+    Function:
+        void GFX_ContextInitialize(GFX_CONTEXT *pContext)
+
+    Summary:
+        This function initializes a rendering context.
+
+    Description:
+        This function sets the given rendering context (see GFX_CONTEXT)
+        to the default settings of GFX_Initialize() and sets all the
+        primitives of the context to idle. The color is not assigned.
+        The active context is not changed.
+
+        A context must be initialized before it is set by
+        GFX_ContextSet().
+
+    Precondition:
+        None.
+
+    Parameters:
+        pContext - pointer to the context to initialize.
+
+    Returns:
+        None.
+
+    Example:
+        None.
+
+*/
+// *****************************************************************************
+void GFX_ContextInitialize(GFX_CONTEXT *pContext);
+
+// *****************************************************************************
+/*  
+    <GROUP init_functions>
+
+    Function:
+        GFX_STATUS GFX_ContextSet(GFX_CONTEXT *pContext)
+
+    Summary:
+        This function sets the rendering context used by the primitive
+        layer.
+
+    Description:
+        This function sets the rendering context (see GFX_CONTEXT) used
+        by the primitive layer. The style set functions (for example
+        GFX_ColorSet() and GFX_FontSet()) change the active context
+        and the primitives render with the style of the active context.
+
+        Each context keeps the progress of its own non-blocking
+        primitives. When a primitive returns GFX_STATUS_FAILURE, another
+        context can be set and used for rendering. The unfinished
+        primitive continues when the first context is set again and
+        the primitive is called again with the same parameters.
+        This applies to the primitive layer only; the GOL object
+        list and panel draws must not be interleaved between contexts
+        (see GFX_CONTEXT).
+
+        GFX_Initialize() sets the default context. Passing NULL also
+        sets the default context.
+
+    Precondition:
+        The context must be initialized by GFX_ContextInitialize().
+
+    Parameters:
+        pContext - pointer to the context to use, NULL for the
+                   default context.
+
+    Returns:
+        GFX_STATUS_SUCCESS - the context is set.
+
+    Example:
+        <code>
+            GFX_CONTEXT meterContext;
+
+            GFX_ContextInitialize(&meterContext);
+
+            // the meter is drawn in white
+            GFX_ContextSet(&meterContext);
+            GFX_ColorSet(WHITE);
+
+            // the default context still draws in black
+            GFX_ContextSet(NULL);
+            GFX_ColorSet(BLACK);
+
+            while(1)
+            {
+                GFX_ContextSet(&meterContext);
+                status1 = GFX_CircleDraw(60, 60, 40);
+
+                GFX_ContextSet(NULL);
+                status2 = GFX_LineDraw(0, 0, 100, 50);
+
+                if ((status1 == GFX_STATUS_SUCCESS) &&
+                    (status2 == GFX_STATUS_SUCCESS))
+                    break;
+            }
+        </code>
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_ContextSet(GFX_CONTEXT *pContext);
+
+// *****************************************************************************
+/*  
+    <GROUP init_functions>
+
+    Function:
+        GFX_CONTEXT *GFX_ContextGet(void)
+
+    Summary:
+        This function returns the rendering context used by the
+        primitive layer.
+
+    Description:
+        This function returns the rendering context (see GFX_CONTEXT)
+        used by the primitive layer.
+
+    Precondition:
+        None.
+
+    Parameters:
+        None.
+
+    Returns:
+        Pointer to the active context.
+
+    Example:
+        None.
+
+*/
+// *****************************************************************************
+GFX_CONTEXT *GFX_ContextGet(void);
+
 // *****************************************************************************
 /*  
     <GROUP init_functions>
@@ -401,6 +538,8 @@ GFX_STATUS GFX_LinePositionRelativeSet(int16_t x, int16_t y);
         - GFX_LINE_STYLE_THICK_SOLID
         - GFX_LINE_STYLE_THICK_DOTTED
         - GFX_LINE_STYLE_THICK_DASHED
+        - GFX_LINE_STYLE_ANTI_ALIASED
+        - GFX_LINE_STYLE_THICK_ANTI_ALIASED
         
         GFX_FILL_STYLE:
         - GFX_FILL_STYLE_COLOR
@@ -1639,6 +1778,97 @@ GFX_STATUS GFX_FontAntiAliasSet(GFX_FONT_ANTIALIAS_TYPE type);
 // *****************************************************************************
 GFX_FONT_ANTIALIAS_TYPE GFX_FontAntiAliasGet(void);
 
+#ifdef GFX_CONFIG_FONT_GLYPH_CACHE_SIZE
+// *****************************************************************************
+/*  
+    <GROUP text_functions>
+
+    Function:
+        void GFX_FontGlyphCacheClear(void)
+
+    Summary:
+        This function removes all the glyphs from the glyph cache.
+
+    Description:
+        When GFX_CONFIG_FONT_GLYPH_CACHE_SIZE is defined, rendered
+        characters are kept in a cache of decoded glyphs keyed by
+        font, character, color and (for anti-aliased fonts) the
+        background color. Characters found in the cache are rendered
+        without reading the font resource again. Each glyph has a
+        single cache entry selected by a hash of its key. A glyph that
+        misses is rendered from the font resource and is only decoded
+        into the cache when its entry is free or when it is drawn again
+        before another glyph misses the same entry.
+
+        The cache cannot detect changes to the contents of a font
+        resource. This function must be called when a font that was
+        already rendered is modified or reprogrammed in external memory.
+
+    Precondition:
+        None.
+
+    Parameters:
+        None.
+
+    Returns:
+        None.
+
+    Example:
+        <code>
+            // external font memory was reprogrammed
+            GFX_FontGlyphCacheClear();
+        </code>
+
+*/
+// *****************************************************************************
+void GFX_FontGlyphCacheClear(void);
+#endif
+
+#ifdef GFX_CONFIG_FONT_WIDTH_TABLE_SIZE
+// *****************************************************************************
+/*  
+    <GROUP text_functions>
+
+    Function:
+        void GFX_FontWidthTableClear(void)
+
+    Summary:
+        This function removes all the character widths from the font
+        width tables.
+
+    Description:
+        When GFX_CONFIG_FONT_WIDTH_TABLE_SIZE is defined,
+        GFX_TextStringWidthGet() keeps a table of character widths for
+        each font located in flash or external memory. The width of a
+        character is read from the font the first time the character
+        is measured, so later string widths are calculated without
+        reading the font.
+
+        The tables cannot detect changes to the contents of a font
+        resource. This function must be called when a font that was
+        already measured is modified or reprogrammed in external memory.
+
+    Precondition:
+        None.
+
+    Parameters:
+        None.
+
+    Returns:
+        None.
+
+    Example:
+        <code>
+            // external font memory was reprogrammed
+            GFX_FontWidthTableClear();
+            GFX_FontGlyphCacheClear();
+        </code>
+
+*/
+// *****************************************************************************
+void GFX_FontWidthTableClear(void);
+#endif
+
 // *****************************************************************************
 /*  
     <GROUP style_functions>
@@ -1663,6 +1893,18 @@ GFX_FONT_ANTIALIAS_TYPE GFX_FontAntiAliasGet(void);
         all unfilled shapes that does specify the line style to be used
         will use the line style specified by this function.
 
+        The anti-aliased styles blend the edge pixels of lines, circles
+        and rounded rectangles with the pixels of the frame buffer.
+        They are rendered as the solid styles when
+        GFX_CONFIG_ALPHABLEND_DISABLE is defined.
+
+        Anti-aliased diagonal lines are always rendered by the library,
+        also with drivers that render the solid lines in hardware (for
+        example the SSD1926 driver). They read the frame buffer and
+        are not non-blocking: when the hardware is busy GFX_LineDraw()
+        returns GFX_STATUS_FAILURE without rendering, otherwise the
+        whole line is rendered in one call.
+
     Precondition:
         None.
 
@@ -2003,7 +2245,11 @@ GFX_STATUS GFX_StyledLineDraw(
         style (see GFX_LineStyleSet()) and color (see GFX_ColorSet()). The
         shape of the polygon is determined by the polygon points (an
         ordered array of x,y pairs) where the pair count is equal to the
-        parameter sides.
+        parameter sides plus one. Each point is joined to the next point,
+        the last point is not joined to the first point. To draw a closed
+        shape, the first point is repeated at the end of the array. The
+        same sides and points render the filled shape with
+        GFX_PolygonFillDraw().
 
         If any of the x,y pairs do not lie on the frame buffer, then the
         behavior is undefined. If color is not set, before this function
@@ -2032,15 +2278,94 @@ GFX_STATUS GFX_StyledLineDraw(
 
             GFX_ColorSet(WHITE);                        // set color
             SetLineType(GFX_LINE_STYLE_THIN_DOTTED);    // set line style
-            GFX_PolygonDraw(3, OpenShapeXYPoints);	// draw an open shape
-            GFX_PolygonDraw(4, ClosedShapeXYPoints);    // draw a  closed shape
+            GFX_PolygonDraw(2, OpenShapeXYPoints);	// draw an open shape
+            GFX_PolygonDraw(3, ClosedShapeXYPoints);    // draw a  closed shape
         </code>
 
 */
 // *****************************************************************************
 GFX_STATUS GFX_PolygonDraw(
-                                uint16_t numPoints,
-                                uint16_t *polyPoints);
+                                uint16_t sides,
+                                uint16_t *pPoints);
+
+#ifdef GFX_CONFIG_POLYGON_FILL_POINTS
+
+// *****************************************************************************
+/*
+    <GROUP polygon_functions>
+
+    Function:
+        GFX_STATUS GFX_PolygonFillDraw(
+                                uint16_t sides,
+                                uint16_t *pPoints)
+
+    Summary:
+        This function renders a filled polygon using the currently
+        set fill style and colors.
+
+    Description:
+        This function renders a filled polygon using the currently set
+        fill style (see GFX_FillStyleSet()) and colors. The shape of the
+        polygon is determined by the polygon points (an ordered array of
+        x,y pairs) where the pair count is equal to the parameter sides
+        plus one, as in GFX_PolygonDraw(). The shape is always closed:
+        when the last point is not the first point repeated, it is
+        joined to the first point. The points that render a closed
+        outline with GFX_PolygonDraw() render the filled shape.
+
+        Each row of the polygon is rendered as horizontal spans with
+        GFX_BarDraw(). A pixel is rendered when its center is inside the
+        polygon (even-odd rule) or on a side of the polygon, and no
+        pixel is rendered twice. With GFX_FILL_STYLE_ALPHA_COLOR the
+        spans are alpha blended (see GFX_BarDraw()). The gradient fill
+        styles spread the gradient over the bounds of the polygon.
+
+        Nothing is rendered when sides is 0, when sides plus one is
+        greater than GFX_CONFIG_POLYGON_FILL_POINTS, or when the fill style is
+        GFX_FILL_STYLE_NONE (use GFX_PolygonDraw() to render the
+        outline). The edge and span tables are kept in the rendering
+        context (see GFX_CONTEXT), each context can have a polygon
+        fill in progress.
+
+        If any of the x,y pairs do not lie on the frame buffer, then the
+        behavior is undefined.
+
+    Precondition:
+        GFX_CONFIG_POLYGON_FILL_POINTS must be defined.
+        Fill style must be set by GFX_FillStyleSet().
+        Color must be set by GFX_ColorSet() or GFX_GradientColorSet().
+
+    Parameters:
+        sides - the number of sides of the polygon outline.
+        pPoints - Pointer to the array of polygon points. The sequence
+                  is x0, y0, x1, y1, ... xn, yn where n is sides.
+
+    Returns:
+        Status of the polygon rendering.
+        GFX_STATUS_SUCCESS - polygon rendering done.
+        GFX_STATUS_FAILURE - polygon rendering is not done.
+
+    Example:
+        <code>
+            // meter needle pointing to the upper right
+            uint16_t needle[10] = {100, 100, 96, 104, 150, 40, 104, 96, 100, 100};
+
+            GFX_ColorSet(RED);
+            GFX_FillStyleSet(GFX_FILL_STYLE_COLOR);
+            while(GFX_PolygonFillDraw(4, needle) == GFX_STATUS_FAILURE);
+
+            GFX_ColorSet(BLACK);
+            GFX_LineStyleSet(GFX_LINE_STYLE_THIN_SOLID);
+            while(GFX_PolygonDraw(4, needle) == GFX_STATUS_FAILURE);
+        </code>
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_PolygonFillDraw(
+                                uint16_t sides,
+                                uint16_t *pPoints);
+
+#endif // #ifdef GFX_CONFIG_POLYGON_FILL_POINTS
 
 // DOM-IGNORE-BEGIN
 // *****************************************************************************
@@ -2986,12 +3311,13 @@ uint16_t GFX_BarAlphaDraw(      uint16_t left,
     Description:
         This function sets the alpha value for alpha blending rendering.
         Accepted values are dependent on the used alpha blending routines
-        at build time. When using the software routines in the Primitive
-        Layer, accepted values are 0, 25, 50, 75 and 100.
+        at build time. The software routines in the Primitive Layer
+        support the full range (0-100). The values 25, 50 and 75 are
+        rendered with the fastest routines.
 
         If using a specific implementation in the display driver used,
-        implementation may support the full range (0-100). When this is
-        the case, refer to the driver alpha blending solution for details.
+        refer to the driver alpha blending solution for the supported
+        values.
 
         Function operation will ignore unsupported values of alpha.
 
@@ -3002,7 +3328,7 @@ uint16_t GFX_BarAlphaDraw(      uint16_t left,
         alpha - Defines the alpha blending percentage to be used for
                 alpha blending routines. Accepted values are dependent
                 on the alpha blending routines used. For Primitive Layer
-                implementation accepted values are:
+                implementation accepted values are 0 to 100, for example:
                 - 100 : no alpha blending, last color set by GFX_ColorSet()
                         will replace the pixels.
                 - 75  : 75% of the last color set by GFX_ColorSet() will be
@@ -3169,107 +3495,369 @@ GFX_STATUS GFX_ImagePartialDraw(uint16_t destination_x,
                                 GFX_RESOURCE_HDR *pImage);
 
 // *****************************************************************************
-/*  
+/*
     <GROUP image_functions>
 
     Function:
-        GFX_STATUS GFX_ImageDraw(
-                                uint16_t left,
-                                uint16_t top,
-                                GFX_RESOURCE_HDR *pImage)
+        GFX_STATUS GFX_ImagePartialLinesGet(
+                                uint16_t destination_x,
+                                uint16_t destination_y,
+                                uint16_t source_x_offset,
+                                uint16_t source_y_offset,
+                                uint16_t source_width,
+                                uint16_t source_height,
+                                GFX_RESOURCE_HDR *pImage,
+                                GFX_IMAGE_LINE_CALLBACK pCallback)
 
     Summary:
-        This function renders an image to the frame buffer.
+        This function decodes a portion of an image and passes each
+        decoded line to a callback function.
 
     Description:
-        This function renders an image to the frame buffer with the
-        left-top corner of the image located at given left, top parameters.
-
-        The rendering of this shape becomes undefined when any one of the
-        following is true:
-        - left, top pixel position falls outside
-          the frame buffer.
-        - pointer is not properly initialized to a GFX_RESOURCE_HDR object.
+        This function decodes the same portion of the image as
+        GFX_ImagePartialDraw() but the lines are not rendered to the
+        frame buffer. Each decoded line is passed to pCallback along
+        with the frame buffer position (destination_x, destination_y
+        plus the line number) where GFX_ImagePartialDraw() would have
+        rendered it. The callback can modify the line and render it,
+        this is how the alpha blended bars are rendered over a
+        background image (see GFX_BarAlphaDraw()).
+
+        All the lines are decoded in one call so the image header and
+        palette are read only once and RLE compressed images are
+        decoded sequentially instead of being searched for each line.
+
+        Only uncompressed and RLE compressed images located in flash
+        or external memory, IPU images decoded in software and PNG
+        files are supported. Images decoded by the display driver (the
+        1, 4 and 8 bpp, IPU and EDS images of the DA210 driver) and
+        JPEG files, which are decoded in pieces of lines, are not
+        decoded and GFX_STATUS_FAILURE is returned.
 
     Precondition:
         None.
 
     Parameters:
-        left - Horizontal starting position of the image.
-        top  - Vertical starting position of the image.
-        pImage - Pointer to the image to be rendered.
+        destination_x - Horizontal position passed with the first pixel
+                        of each line.
+        destination_y - Vertical position passed with the first line.
+        source_x_offset - See GFX_ImagePartialDraw().
+        source_y_offset - See GFX_ImagePartialDraw().
+        source_width - See GFX_ImagePartialDraw().
+        source_height - See GFX_ImagePartialDraw().
+        pImage - Pointer to the image to be decoded.
+        pCallback - Function called for each decoded line.
 
     Returns:
-        Status of the image rendering.
-        GFX_STATUS_SUCCESS - image rendering done.
-        GFX_STATUS_FAILURE - image rendering failed.
+        Status of the image decoding.
+        GFX_STATUS_SUCCESS - all the lines are decoded.
+        GFX_STATUS_FAILURE - the image type is not supported or
+                             rendering is busy.
 
     Example:
         <code>
-            // assume the backgroundImage has dimension of 320x240 pixels.
-            GFX_RESOURCE_HDR *pBackgroundImage;
-
-            pBackgroundImage = (GFX_RESOURCE_HDR *)&backgroundImage;
+            // darken each line of the image before rendering it
+            void DarkLineRender(uint16_t x, uint16_t y, GFX_COLOR *pLine, uint16_t width)
+            {
+                uint16_t i;
 
-            // Render the image starting from (10,10) x,y position
+                for(i = 0; i < width; i++)
+                    pLine[i] = GFX_Color50Convert(pLine[i]);
+                GFX_PixelArrayPut(x, y, pLine, width);
+            }
 
-            // corner of the image
-            GFX_ImageDraw(  10, 10,
-                            pBackgroundImage);
+            GFX_ImagePartialLinesGet(10, 10, 0, 0, 0, 0, pImage, DarkLineRender);
         </code>
 
 */
 // *****************************************************************************
-GFX_STATUS GFX_ImageDraw(       uint16_t left,
-                                uint16_t top,
-                                GFX_RESOURCE_HDR *pImage);
+GFX_STATUS GFX_ImagePartialLinesGet(
+                                uint16_t destination_x,
+                                uint16_t destination_y,
+                                uint16_t source_x_offset,
+                                uint16_t source_y_offset,
+                                uint16_t source_width,
+                                uint16_t source_height,
+                                GFX_RESOURCE_HDR *pImage,
+                                GFX_IMAGE_LINE_CALLBACK pCallback);
 
+#if !defined (GFX_CONFIG_IMAGE_FLASH_DISABLE) || !defined (GFX_CONFIG_IMAGE_EXTERNAL_DISABLE)
 // *****************************************************************************
-/*  
+/*
     <GROUP image_functions>
 
     Function:
-        GFX_STATUS GFX_ImageWidthGet(
-                                GFX_RESOURCE_HDR *pImage)
+        void GFX_ImagePaletteCacheClear(void)
 
     Summary:
-        This function returns the width of the given image.
+        This function removes the cached image palette.
 
     Description:
-        This function returns the width of the given image in pixels.
-        This function results in an undefined behavior if the pointer to the
-        image is invalid.
+        The palette of an uncompressed image located in flash or
+        external memory is kept in RAM after the image is rendered.
+        Rendering the same image again, or another portion of it,
+        does not read the palette again. The cached palette is
+        identified by the pointer to the image resource header.
 
-        This function return value is undefined if the given pointer does
-        not point to a valid image resource.
+        The cache cannot detect changes to the contents of an image
+        resource. This function must be called when an image that was
+        already rendered is modified, reprogrammed in external memory,
+        or when its GFX_RESOURCE_HDR is reused for another image.
 
     Precondition:
         None.
 
     Parameters:
-        pImage - Pointer to the image.
+        None.
 
     Returns:
-        The image width in pixels.
+        None.
 
     Example:
-        None.
+        <code>
+            // external image memory was reprogrammed
+            GFX_ImagePaletteCacheClear();
+        </code>
 
 */
 // *****************************************************************************
-extern inline int16_t __attribute__ ((always_inline)) GFX_ImageWidthGet(
-                                GFX_RESOURCE_HDR *pImage)
-{
-    return pImage->resource.image.width;
-}
+void GFX_ImagePaletteCacheClear(void);
+#endif
 
+#if !defined (GFX_CONFIG_RLE_DECODE_DISABLE) && defined (GFX_CONFIG_RLE_ROW_INDEX_SIZE)
 // *****************************************************************************
-/*  
+/*
     <GROUP image_functions>
 
     Function:
-        GFX_STATUS GFX_ImageHeightGet(
-                                GFX_RESOURCE_HDR *pImage)
+        void GFX_ImageRLERowIndexClear(void)
+
+    Summary:
+        This function removes all the RLE row indexes.
+
+    Description:
+        When GFX_CONFIG_RLE_ROW_INDEX_SIZE is defined, the offsets of
+        the compressed rows of RLE images are kept in row indexes
+        identified by the pointer to the image resource header. The
+        indexes are filled as the rows are skipped to render portions
+        of the images, so GFX_ImagePartialDraw() seeks to the first
+        row of a portion without decoding the whole image above it.
+
+        The indexes cannot detect changes to the contents of an image
+        resource. This function must be called when an RLE image that
+        was already rendered is modified, reprogrammed in external
+        memory, or when its GFX_RESOURCE_HDR is reused for another image.
+
+    Precondition:
+        None.
+
+    Parameters:
+        None.
+
+    Returns:
+        None.
+
+    Example:
+        <code>
+            // external image memory was reprogrammed
+            GFX_ImageRLERowIndexClear();
+            GFX_ImagePaletteCacheClear();
+        </code>
+
+*/
+// *****************************************************************************
+void GFX_ImageRLERowIndexClear(void);
+#endif
+
+#if defined (GFX_CONFIG_JPEG_DECODE_ENABLE) || defined (GFX_CONFIG_PNG_DECODE_ROW_SIZE)
+// *****************************************************************************
+/*
+    <GROUP image_functions>
+
+    Function:
+        GFX_STATUS GFX_ImageFileCreate(
+                                GFX_RESOURCE_HDR *pImage,
+                                FILEIO_OBJECT *pFile,
+                                uint16_t scale)
+
+    Summary:
+        This function initializes an image resource for a JPEG or PNG
+        image in a file.
+
+    Description:
+        This function reads the header of the JPEG or PNG image that
+        starts at the current position of the open file pFile and
+        initializes pImage so the image is rendered with
+        GFX_ImageDraw() and GFX_ImagePartialDraw(). 
+
+        The image is decoded from the file each time it is rendered.
+        JPEG images are rendered one MCU (a block of 8x8 to 16x16 
+        pixels) at a time and PNG images one row at a time, so the RAM
+        used does not depend on the height of the image. The file must
+        stay open while the image is used and its position is changed
+        when the image is rendered.
+
+        The image can be rendered at 1/2, 1/4 or 1/8 of its size to
+        show thumbnails, the width and height of pImage are the size
+        of the rendered image and the portions of GFX_ImagePartialDraw()
+        are given in this size. JPEG images are reduced by averaging
+        each block of the image and at 1/8 only the DC coefficients are
+        used, PNG images are reduced by sampling the pixels.
+
+        Baseline JPEG images with 1 (grayscale) or 3 (YCbCr) components
+        and sampling factors of 1 or 2 are supported, this includes the
+        4:4:4, 4:2:2 and 4:2:0 sampling of most cameras. Progressive 
+        JPEG images are not supported.
+
+        PNG images of all the color types and bit depths are supported
+        when they are not interlaced. The alpha channel is not used.
+        The bytes of a row of the image must fit in 
+        GFX_CONFIG_PNG_DECODE_ROW_SIZE and the DEFLATE data must not 
+        refer to bytes farther than GFX_CONFIG_IPU_DECODE_WINDOW_SIZE.
+
+        JPEG images are supported when GFX_CONFIG_JPEG_DECODE_ENABLE is
+        defined and PNG images when GFX_CONFIG_PNG_DECODE_ROW_SIZE is
+        defined.
+
+    Precondition:
+        The file is opened for reading with FILEIO_Open().
+
+    Parameters:
+        pImage - Pointer to the image resource to initialize.
+        pFile - The open file.
+        scale - The image is rendered at 1/(2^scale) of its size,
+                0 to 3.
+
+    Returns:
+        Status of the image header reading.
+        GFX_STATUS_SUCCESS - pImage is initialized.
+        GFX_STATUS_FAILURE - the file does not contain a supported
+                             JPEG or PNG image.
+
+    Example:
+        <code>
+            FILEIO_OBJECT       file;
+            GFX_RESOURCE_HDR    photo;
+
+            if (FILEIO_Open(&file, "PHOTO.JPG", FILEIO_OPEN_READ) == FILEIO_RESULT_SUCCESS)
+            {
+                // render a thumbnail of the photo at 1/4 of its size
+                if (GFX_ImageFileCreate(&photo, &file, 2) == GFX_STATUS_SUCCESS)
+                    GFX_ImageDraw(10, 10, &photo);
+                FILEIO_Close(&file);
+            }
+        </code>
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_ImageFileCreate(
+                                GFX_RESOURCE_HDR *pImage,
+                                FILEIO_OBJECT *pFile,
+                                uint16_t scale);
+#endif
+
+// *****************************************************************************
+/*  
+    <GROUP image_functions>
+
+    Function:
+        GFX_STATUS GFX_ImageDraw(
+                                uint16_t left,
+                                uint16_t top,
+                                GFX_RESOURCE_HDR *pImage)
+
+    Summary:
+        This function renders an image to the frame buffer.
+
+    Description:
+        This function renders an image to the frame buffer with the
+        left-top corner of the image located at given left, top parameters.
+
+        The rendering of this shape becomes undefined when any one of the
+        following is true:
+        - left, top pixel position falls outside
+          the frame buffer.
+        - pointer is not properly initialized to a GFX_RESOURCE_HDR object.
+
+    Precondition:
+        None.
+
+    Parameters:
+        left - Horizontal starting position of the image.
+        top  - Vertical starting position of the image.
+        pImage - Pointer to the image to be rendered.
+
+    Returns:
+        Status of the image rendering.
+        GFX_STATUS_SUCCESS - image rendering done.
+        GFX_STATUS_FAILURE - image rendering failed.
+
+    Example:
+        <code>
+            // assume the backgroundImage has dimension of 320x240 pixels.
+            GFX_RESOURCE_HDR *pBackgroundImage;
+
+            pBackgroundImage = (GFX_RESOURCE_HDR *)&backgroundImage;
+
+            // Render the image starting from (10,10) x,y position
+
+            // corner of the image
+            GFX_ImageDraw(  10, 10,
+                            pBackgroundImage);
+        </code>
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_ImageDraw(       uint16_t left,
+                                uint16_t top,
+                                GFX_RESOURCE_HDR *pImage);
+
+// *****************************************************************************
+/*  
+    <GROUP image_functions>
+
+    Function:
+        GFX_STATUS GFX_ImageWidthGet(
+                                GFX_RESOURCE_HDR *pImage)
+
+    Summary:
+        This function returns the width of the given image.
+
+    Description:
+        This function returns the width of the given image in pixels.
+        This function results in an undefined behavior if the pointer to the
+        image is invalid.
+
+        This function return value is undefined if the given pointer does
+        not point to a valid image resource.
+
+    Precondition:
+        None.
+
+    Parameters:
+        pImage - Pointer to the image.
+
+    Returns:
+        The image width in pixels.
+
+    Example:
+        None.
+
+*/
+// *****************************************************************************
+extern inline int16_t __attribute__ ((always_inline)) GFX_ImageWidthGet(
+                                GFX_RESOURCE_HDR *pImage)
+{
+    return pImage->resource.image.width;
+}
+
+// *****************************************************************************
+/*  
+    <GROUP image_functions>
+
+    Function:
+        GFX_STATUS GFX_ImageHeightGet(
+                                GFX_RESOURCE_HDR *pImage)
 
     Summary:
         This function returns the height of the given image.
@@ -4234,6 +4822,13 @@ GFX_FEATURE_STATUS GFX_DoubleBufferSyncAllStatusGet(void);
         area is assumed to contain new pixel information and is added
         into the list of areas to be synchronized.
 
+        Areas are merged when copying their bounding rectangle costs no
+        more than copying them separately. The cost of an area is its
+        pixel count plus GFX_INVALIDATE_AREA_COST. When the list is full
+        the new area is merged with the area that adds the fewest pixels.
+        Full frame synchronization is scheduled when it costs no more
+        than copying the areas in the list.
+
         Synchronization can be scheduled using the
         GFX_DoubleBufferSynchronizeRequest() or immediately performed
         using GFX_DoubleBufferSynchronize().
@@ -4289,7 +4884,8 @@ void GFX_DoubleBufferAreaMark(
 
     Parameters:
         index - the index of the rectangular area located in the array of
-                areas that needs synchronization.
+                areas that needs synchronization. The index ranges from
+                1 to GFX_DoubleBufferSyncAreaCountGet().
 
     Returns:
         The location of the rectangular area specified by the
@@ -4302,173 +4898,900 @@ void GFX_DoubleBufferAreaMark(
 // *****************************************************************************
 GFX_RECTANGULAR_AREA *GFX_DoubleBufferAreaGet(uint16_t index);
 
-// DOM-IGNORE-BEGIN
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
 // *****************************************************************************
 /*  
-    <GROUP misc_functions>
+    <GROUP display_list_functions>
 
     Function:
-        int16_t GFX_SineCosineGet(
-                               int16_t v,
-                               GFX_TRIG_FUNCTION_TYPE type)
+        void GFX_DisplayListBegin(void)
 
     Summary:
-        This function returns sine or cosine of an angle.
+        This function starts recording the bars and images into
+        the display list.
 
     Description:
-        This function returns sine or cosine of an angle. The angle
-        range is -360 to 360 degrees. This function uses the Graphics
-        Library look up table of 0-90 degrees. Depending on the
-        given angle, the appropriate sign of the result is calculated.
+        This function starts recording the bars and images into the
+        display list. A recorded bar or image is not drawn until
+        GFX_DisplayListEnd() or GFX_DisplayListFlush() is called.
+        GFX_GOL_ObjectListDraw() records the objects it redraws.
+
+        When a bar or image is recorded, the recorded commands it
+        fully covers are removed, since they would be overdrawn.
+        A bar that extends the last recorded bar of the same color
+        into a larger rectangle is merged with it. Up to
+        GFX_CONFIG_DISPLAY_LIST_SIZE commands are recorded, the
+        list is drawn when it is full.
+
+        Only solid bars and opaque images decoded by the library are
+        recorded. The recorded commands are drawn first when a
+        primitive that reads or writes pixels is called, including
+        GFX_PixelPut(), GFX_PixelGet(), GFX_PixelArrayPut() and
+        GFX_PixelArrayGet(), so the output is the same as without
+        the display list.
+
+        The bars and images are limited to the clip rectangle (see
+        GFX_ClipPush()) when they are recorded. The list can be drawn
+        while a smaller clip rectangle is pushed, the commands are
+        still drawn as they were recorded.
+
+        Calls can be nested. The recorded commands are drawn when the
+        outermost GFX_DisplayListEnd() is called.
 
     Precondition:
-        None.
+        GFX_CONFIG_DISPLAY_LIST_SIZE must be defined.
 
     Parameters:
-        v - the angle used to retrieve the sine or cosine value.
-            The angle must be in the range of -360 to 360 degrees.
-        type - sets if the angle calculation is for a sine or cosine
-            - GFX_TRIG_SINE_TYPE   - get the value of sine(v).
-            - GFX_TRIG_COSINE_TYPE - return the value of cosine(v).
+        None.
 
     Returns:
-        Value of the sine or cosine of the given angle.
+        None.
 
     Example:
-        None.
+        <code>
+            GFX_DisplayListBegin();
+
+            // the background bar is removed by the image covering it
+            GFX_ColorSet(WHITE);
+            GFX_BarDraw(0, 0, 99, 99);
+            GFX_ImageDraw(0, 0, (void *)&myImage_100x100);
+
+            GFX_DisplayListEnd();
+        </code>
 
 */
 // *****************************************************************************
-int16_t GFX_SineCosineGet(int16_t v, GFX_TRIG_FUNCTION_TYPE type);
-// DOM-IGNORE-END
+void GFX_DisplayListBegin(void);
 
-// DOM-IGNORE-BEGIN
 // *****************************************************************************
 /*  
-    <GROUP misc_functions>
+    <GROUP display_list_functions>
 
     Function:
-        int16_t GFX_SineGet(int16_t angle)
+        GFX_STATUS GFX_DisplayListEnd(void)
 
     Summary:
-        This function returns sine of an angle.
+        This function stops recording and draws the recorded commands.
 
     Description:
-        This function returns sine of an angle. The angle range is
-        -360 to 360 degrees. This function uses the Graphics
-        Library look up table of 0-90 degrees. Depending on the
-        given angle, the appropriate sign of the result is calculated.
+        This function stops recording and draws the recorded commands
+        (see GFX_DisplayListBegin()). When calls are nested, only the
+        outermost call draws the recorded commands.
 
     Precondition:
-        None.
+        GFX_DisplayListBegin() must be called first.
 
     Parameters:
-        v - the angle used to retrieve the sine value.
-            The angle must be in the range of -360 to 360 degrees.
+        None.
 
     Returns:
-        Sine value of the given angle.
+        The status of the drawing.
+        - GFX_STATUS_SUCCESS - the recorded commands are drawn.
 
     Example:
-        None.
+        See GFX_DisplayListBegin().
 
 */
 // *****************************************************************************
-#define GFX_SineGet(angle) GFX_SineCosineGet(angle, GFX_TRIG_SINE_TYPE)
-// DOM-IGNORE-END
+GFX_STATUS GFX_DisplayListEnd(void);
 
-// DOM-IGNORE-BEGIN
 // *****************************************************************************
 /*  
-    <GROUP misc_functions>
+    <GROUP display_list_functions>
 
     Function:
-        int16_t GFX_CosineGet(int16_t angle)
+        GFX_STATUS GFX_DisplayListFlush(void)
 
     Summary:
-        This function returns cosine of an angle.
+        This function draws the recorded commands.
 
     Description:
-        This function returns cosine of an angle. The angle range is
-        -360 to 360 degrees. This function uses the Graphics
-        Library look up table of 0-90 degrees. Depending on the
-        given angle, the appropriate sign of the result is calculated.
+        This function draws the recorded commands in the order they
+        were recorded and empties the display list. Recording continues
+        if it was started. The color, fill style, transparent color and
+        image rendering settings are kept.
+
+        The application must call this function before it reads or
+        writes pixels with the driver functions while recording.
 
     Precondition:
         None.
 
     Parameters:
-        v - the angle used to retrieve the cosine value.
-            The angle must be in the range of -360 to 360 degrees.
+        None.
 
     Returns:
-        Cosine value of the given angle.
+        The status of the drawing.
+        - GFX_STATUS_SUCCESS - the recorded commands are drawn.
 
     Example:
-        None.
+        <code>
+            GFX_DisplayListFlush();
+            GFX_PixelPut(10, 10);
+        </code>
 
 */
 // *****************************************************************************
-#define GFX_CosineGet(angle) GFX_SineCosineGet(angle, GFX_TRIG_COSINE_TYPE)
-// DOM-IGNORE-END
+GFX_STATUS GFX_DisplayListFlush(void);
 
 // DOM-IGNORE-BEGIN
 // *****************************************************************************
 /*  
-    <GROUP misc_functions>
+    <GROUP display_list_functions>
 
     Function:
-        void GFX_CirclePointGet(
-                                int16_t radius,
-                                int16_t angle,
-                                int16_t *pX,
-                                int16_t *pY)
+        GFX_STATUS GFX_DisplayListBarAdd(
+                                uint16_t left,
+                                uint16_t top,
+                                uint16_t right,
+                                uint16_t bottom)
 
     Summary:
-        This function sets the x,y position of the point on a
-        circle given the angle and the radius.
+        This function records a bar in the display list. This is an
+        internal function and should not be called by the application.
 
     Description:
-        This function sets the x,y position of the point on a
-        circle given the angle and the radius. This function is
-        an internal function for the Graphics Library.
-        Application should not call this function.
+        This function is called by the GFX_BarDraw() implementations.
+        It records the bar with the current color in the display list.
 
     Precondition:
         None.
 
     Parameters:
-        radius - radius of the circle
-        angle - the angle of the point in the circle in degrees.
-        pX - the address of the variable that will hold the
-             x-coordinate position of the point.
-        pY - the address of the variable that will hold the
-             y-coordinate position of the point.
+        left - left position of the bar.
+        top - top position of the bar.
+        right - right position of the bar.
+        bottom - bottom position of the bar.
 
     Returns:
-        The x,y position of the point in the circle. The values are
-        placed in the address pointed to by pX and pY.
+        The status of the recording.
+        - GFX_STATUS_SUCCESS - the bar is recorded, the caller must not
+                               draw it.
+        - GFX_STATUS_FAILURE - the bar is not recorded, the caller must
+                               draw it.
 
     Example:
         None.
 
 */
 // *****************************************************************************
-void GFX_CirclePointGet(
-                                int16_t radius,
-                                int16_t angle,
-                                int16_t *pX,
-                                int16_t *pY);
+GFX_STATUS GFX_DisplayListBarAdd(
+                                uint16_t left,
+                                uint16_t top,
+                                uint16_t right,
+                                uint16_t bottom);
 // DOM-IGNORE-END
+#endif
 
-#ifndef GFX_CONFIG_GRADIENT_DISABLE
-
-// DOM-IGNORE-BEGIN
-
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
 // *****************************************************************************
 /*  
-    <GROUP polygon_fill_functions>
-    
+    <GROUP clip_functions>
+
+    Function:
+        GFX_STATUS GFX_ClipPush(
+                                uint16_t left,
+                                uint16_t top,
+                                uint16_t right,
+                                uint16_t bottom)
+
+    Summary:
+        This function saves the clip rectangle and limits it to the
+        given area.
+
+    Description:
+        This function saves the current clip rectangle on the clip stack
+        of the active context and sets the clip rectangle to the part of
+        the current clip rectangle inside the given area. Nested areas
+        can only shrink the clip rectangle. GFX_ClipPop() restores the
+        saved clip rectangle.
+
+        Pixels outside the clip rectangle are not rendered by bars,
+        lines, bevels, text and images. Images and text are only decoded
+        for the part inside the clip rectangle. GFX_ScreenClear() and
+        the driver pixel functions called by the application are not
+        clipped. Lines accelerated by the display controller are only
+        skipped when they are entirely outside the clip rectangle.
+
+        The clip rectangle is the whole screen after
+        GFX_ContextInitialize(). Up to GFX_CONFIG_CLIP_STACK_SIZE clip
+        rectangles can be saved.
+
+    Precondition:
+        GFX_CONFIG_CLIP_STACK_SIZE must be defined.
+
+    Parameters:
+        left - left most pixel of the area.
+        top - top most pixel of the area.
+        right - right most pixel of the area.
+        bottom - bottom most pixel of the area.
+
+    Returns:
+        The status of the clip rectangle change.
+        - GFX_STATUS_SUCCESS - the clip rectangle is changed.
+        - GFX_STATUS_FAILURE - the clip stack is full.
+
+    Example:
+        <code>
+            // redraw the panel only where the cursor was
+            GFX_ClipPush(cursorLeft, cursorTop, cursorRight, cursorBottom);
+            GFX_ColorSet(panelColor);
+            GFX_BarDraw(panelLeft, panelTop, panelRight, panelBottom);
+            GFX_TextStringDraw(panelLeft, panelTop, panelText, 0);
+            GFX_ClipPop();
+        </code>
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_ClipPush(
+                                uint16_t left,
+                                uint16_t top,
+                                uint16_t right,
+                                uint16_t bottom);
+
+// *****************************************************************************
+/*  
+    <GROUP clip_functions>
+
+    Function:
+        GFX_STATUS GFX_ClipPop(void)
+
+    Summary:
+        This function restores the clip rectangle saved by GFX_ClipPush().
+
+    Description:
+        This function restores the clip rectangle saved by the last
+        call to GFX_ClipPush().
+
+    Precondition:
+        GFX_CONFIG_CLIP_STACK_SIZE must be defined.
+
+    Parameters:
+        None.
+
+    Returns:
+        The status of the clip rectangle change.
+        - GFX_STATUS_SUCCESS - the clip rectangle is restored.
+        - GFX_STATUS_FAILURE - the clip stack is empty.
+
+    Example:
+        See GFX_ClipPush().
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_ClipPop(void);
+
+// *****************************************************************************
+/*  
+    <GROUP clip_functions>
+
+    Function:
+        GFX_RECTANGULAR_AREA *GFX_ClipGet(void)
+
+    Summary:
+        This function returns the current clip rectangle.
+
+    Description:
+        This function returns the clip rectangle of the active context.
+        The clip rectangle is empty when its left is greater than its
+        right or its top is greater than its bottom. The returned
+        rectangle must not be modified, use GFX_ClipPush() to change it.
+
+    Precondition:
+        GFX_CONFIG_CLIP_STACK_SIZE must be defined.
+
+    Parameters:
+        None.
+
+    Returns:
+        The current clip rectangle.
+
+    Example:
+        None.
+
+*/
+// *****************************************************************************
+GFX_RECTANGULAR_AREA *GFX_ClipGet(void);
+
+// DOM-IGNORE-BEGIN
+// *****************************************************************************
+/*  
+    <GROUP clip_functions>
+
+    Function:
+        GFX_STATUS GFX_ClipAreaAdjust(
+                                uint16_t *pLeft,
+                                uint16_t *pTop,
+                                uint16_t *pRight,
+                                uint16_t *pBottom)
+
+    Summary:
+        This function limits an area to the clip rectangle. This is an
+        internal function and should not be called by the application.
+
+    Description:
+        This function is called by the GFX_BarDraw() implementations.
+        It limits the given area to the clip rectangle.
+
+    Precondition:
+        None.
+
+    Parameters:
+        pLeft - left most pixel of the area.
+        pTop - top most pixel of the area.
+        pRight - right most pixel of the area.
+        pBottom - bottom most pixel of the area.
+
+    Returns:
+        The status of the area.
+        - GFX_STATUS_SUCCESS - a part of the area is inside the clip
+                               rectangle.
+        - GFX_STATUS_FAILURE - the area is outside the clip rectangle.
+
+    Example:
+        None.
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_ClipAreaAdjust(
+                                uint16_t *pLeft,
+                                uint16_t *pTop,
+                                uint16_t *pRight,
+                                uint16_t *pBottom);
+// DOM-IGNORE-END
+#endif
+
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+// *****************************************************************************
+/*  
+    <GROUP surface_functions>
+
+    Function:
+        GFX_STATUS GFX_SurfaceCreate(
+                                GFX_SURFACE *pSurface,
+                                GFX_COLOR *pBuffer,
+                                uint16_t width,
+                                uint16_t height)
+
+    Summary:
+        This function initializes a surface in RAM.
+
+    Description:
+        This function initializes a surface whose pixels are stored
+        row by row in the given buffer. The buffer is provided by the
+        application and must hold width * height pixels. The content
+        of the buffer is not changed, use GFX_ScreenClear() after
+        GFX_SurfaceSet() to clear the surface.
+
+        The primitives render the rows of a surface through the line
+        buffer of the library, which holds the larger of
+        DISP_HOR_RESOLUTION and DISP_VER_RESOLUTION pixels. The width
+        and the height of a surface cannot be larger.
+
+    Precondition:
+        GFX_CONFIG_SURFACE_ENABLE must be defined.
+
+    Parameters:
+        pSurface - the surface to initialize.
+        pBuffer - the pixels of the surface.
+        width - width of the surface in pixels.
+        height - height of the surface in pixels.
+
+    Returns:
+        The status of the initialization.
+        - GFX_STATUS_SUCCESS - the surface is initialized.
+        - GFX_STATUS_FAILURE - the buffer is NULL, the size is 0 or
+                               the surface is larger than the line
+                               buffer.
+
+    Example:
+        See GFX_SurfaceSet().
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_SurfaceCreate(
+                                GFX_SURFACE *pSurface,
+                                GFX_COLOR *pBuffer,
+                                uint16_t width,
+                                uint16_t height);
+
+// *****************************************************************************
+/*  
+    <GROUP surface_functions>
+
+    Function:
+        GFX_STATUS GFX_SurfaceDrawBufferCreate(
+                                GFX_SURFACE *pSurface,
+                                uint16_t index)
+
+    Summary:
+        This function initializes a surface on a draw buffer of the
+        display driver.
+
+    Description:
+        This function initializes a surface on the draw buffer of the
+        display driver with the given index (see GFX_DrawBufferSet()).
+        The surface has the size of the screen. All the primitives,
+        including the ones accelerated by the display controller,
+        render to the draw buffer while the surface is set.
+
+        The draw buffer of the driver is shared by all the contexts.
+
+    Precondition:
+        GFX_CONFIG_SURFACE_ENABLE must be defined. The draw buffer
+        must be initialized (see GFX_DrawBufferInitialize()).
+
+    Parameters:
+        pSurface - the surface to initialize.
+        index - index of the draw buffer.
+
+    Returns:
+        The status of the initialization.
+        - GFX_STATUS_SUCCESS - the surface is initialized.
+
+    Example:
+        None.
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_SurfaceDrawBufferCreate(
+                                GFX_SURFACE *pSurface,
+                                uint16_t index);
+
+// *****************************************************************************
+/*  
+    <GROUP surface_functions>
+
+    Function:
+        GFX_STATUS GFX_SurfaceSet(GFX_SURFACE *pSurface)
+
+    Summary:
+        This function sets the surface the primitives render to.
+
+    Description:
+        This function sets the target of the primitives of the active
+        context. NULL sets the display back as the target. The
+        coordinates of the primitives are relative to the left, top
+        corner of the surface and pixels outside the surface are
+        not rendered.
+
+        The commands recorded in the display list are drawn to the
+        previous target before the target is changed. The clip
+        rectangle is not changed.
+
+        RAM surfaces are rendered by the GFX_SurfaceXXX() functions
+        called from the pixel, bar and screen clear functions of the
+        display driver. Primitives accelerated by the display
+        controller that write the frame buffer directly (for example
+        the lines, text and images of the DA210 driver) are not
+        redirected; use a draw buffer surface (see
+        GFX_SurfaceDrawBufferCreate()) with these drivers.
+
+    Precondition:
+        GFX_CONFIG_SURFACE_ENABLE must be defined.
+
+    Parameters:
+        pSurface - the target surface, NULL for the display.
+
+    Returns:
+        The status of the change.
+        - GFX_STATUS_SUCCESS - the target is changed.
+        - GFX_STATUS_FAILURE - the display list or the driver is busy,
+                               call the function again.
+
+    Example:
+        <code>
+            static GFX_COLOR    dialPixels[96 * 96];
+            static GFX_SURFACE  dial;
+
+            // render the static part of the meter once
+            GFX_SurfaceCreate(&dial, dialPixels, 96, 96);
+            GFX_SurfaceSet(&dial);
+            GFX_ColorSet(backgroundColor);
+            GFX_ScreenClear();
+            GFX_ColorSet(scaleColor);
+            GFX_CircleDraw(48, 48, 44);
+            GFX_SurfaceSet(NULL);
+
+            // on each update draw the dial and the needle
+            GFX_SurfaceDraw(meterLeft, meterTop, &dial);
+            GFX_LineDraw(meterLeft + 48, meterTop + 48, needleX, needleY);
+        </code>
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_SurfaceSet(GFX_SURFACE *pSurface);
+
+// *****************************************************************************
+/*  
+    <GROUP surface_functions>
+
+    Function:
+        GFX_SURFACE *GFX_SurfaceGet(void)
+
+    Summary:
+        This function returns the surface the primitives render to.
+
+    Description:
+        This function returns the target of the primitives of the
+        active context, NULL when the primitives render to the display.
+
+    Precondition:
+        GFX_CONFIG_SURFACE_ENABLE must be defined.
+
+    Parameters:
+        None.
+
+    Returns:
+        The target surface.
+
+    Example:
+        None.
+
+*/
+// *****************************************************************************
+GFX_SURFACE *GFX_SurfaceGet(void);
+
+// *****************************************************************************
+/*  
+    <GROUP surface_functions>
+
+    Function:
+        GFX_STATUS GFX_SurfaceDraw(
+                                uint16_t left,
+                                uint16_t top,
+                                GFX_SURFACE *pSurface)
+
+    Summary:
+        This function draws a surface to the current target.
+
+    Description:
+        This function draws the whole surface with its left, top
+        corner at the given position of the current target (see
+        GFX_SurfacePartialDraw()).
+
+    Precondition:
+        GFX_CONFIG_SURFACE_ENABLE must be defined.
+
+    Parameters:
+        left - horizontal position of the left, top corner.
+        top - vertical position of the left, top corner.
+        pSurface - the surface to draw.
+
+    Returns:
+        The status of the drawing.
+        - GFX_STATUS_SUCCESS - the surface is drawn.
+
+    Example:
+        See GFX_SurfaceSet().
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_SurfaceDraw(
+                                uint16_t left,
+                                uint16_t top,
+                                GFX_SURFACE *pSurface);
+
+// *****************************************************************************
+/*  
+    <GROUP surface_functions>
+
+    Function:
+        GFX_STATUS GFX_SurfacePartialDraw(
+                                uint16_t left,
+                                uint16_t top,
+                                uint16_t xOffset,
+                                uint16_t yOffset,
+                                uint16_t width,
+                                uint16_t height,
+                                GFX_SURFACE *pSurface)
+
+    Summary:
+        This function draws a part of a surface to the current target.
+
+    Description:
+        This function copies the width x height pixels of the surface
+        at xOffset, yOffset to the given position of the current target
+        (the display or the surface set by GFX_SurfaceSet()), one row
+        at a time. Only the part inside the target and the clip
+        rectangle is drawn.
+
+        When the transparent color is enabled (see
+        GFX_TransparentColorEnable()) the pixels of the surface with
+        the transparent color are skipped. When the fill style is
+        GFX_FILL_STYLE_ALPHA_COLOR the pixels are blended with the
+        pixels of the target using the alpha value set by
+        GFX_AlphaBlendingValueSet().
+
+        The surface must not be the current target.
+
+    Precondition:
+        GFX_CONFIG_SURFACE_ENABLE must be defined.
+
+    Parameters:
+        left - horizontal position of the left, top corner.
+        top - vertical position of the left, top corner.
+        xOffset - horizontal position of the part in the surface.
+        yOffset - vertical position of the part in the surface.
+        width - width of the part.
+        height - height of the part.
+        pSurface - the surface to draw.
+
+    Returns:
+        The status of the drawing.
+        - GFX_STATUS_SUCCESS - the surface is drawn.
+
+    Example:
+        <code>
+            // draw the cached list background at half intensity
+            GFX_FillStyleSet(GFX_FILL_STYLE_ALPHA_COLOR);
+            GFX_AlphaBlendingValueSet(50);
+            GFX_SurfacePartialDraw(left, top, 0, scroll, width, height, &listBackground);
+        </code>
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_SurfacePartialDraw(
+                                uint16_t left,
+                                uint16_t top,
+                                uint16_t xOffset,
+                                uint16_t yOffset,
+                                uint16_t width,
+                                uint16_t height,
+                                GFX_SURFACE *pSurface);
+
+// DOM-IGNORE-BEGIN
+// *****************************************************************************
+/*  
+    <GROUP surface_functions>
+
+    Function:
+        GFX_FEATURE_STATUS GFX_SurfaceStatusGet(void)
+
+    Summary:
+        This function returns GFX_FEATURE_ENABLED when the primitives
+        render to a RAM surface. This is an internal function and
+        should not be called by the application.
+
+    Description:
+        This function is called by the display drivers. When a RAM
+        surface is the target, GFX_PixelPut(), GFX_PixelGet(),
+        GFX_PixelArrayPut(), GFX_PixelArrayGet(), GFX_BarDraw() and
+        GFX_ScreenClear() pass the pixels to GFX_SurfacePixelPut(),
+        GFX_SurfacePixelGet(), GFX_SurfacePixelArrayPut(),
+        GFX_SurfacePixelArrayGet() and GFX_SurfaceBarDraw(). These
+        functions render the pixels inside the surface, pixels past
+        the end of a row of the surface are dropped.
+
+    Precondition:
+        None.
+
+    Parameters:
+        None.
+
+    Returns:
+        The status of the RAM surface.
+        - GFX_FEATURE_ENABLED - the primitives render to a RAM surface.
+        - GFX_FEATURE_DISABLED - the primitives render to the driver.
+
+    Example:
+        None.
+
+*/
+// *****************************************************************************
+GFX_FEATURE_STATUS GFX_SurfaceStatusGet(void);
+
+GFX_STATUS GFX_SurfacePixelPut(uint16_t x, uint16_t y);
+
+GFX_COLOR GFX_SurfacePixelGet(uint16_t x, uint16_t y);
+
+uint16_t GFX_SurfacePixelArrayPut(
+                                uint16_t x,
+                                uint16_t y,
+                                GFX_COLOR *pPixel,
+                                uint16_t numPixels);
+
+uint16_t GFX_SurfacePixelArrayGet(
+                                uint16_t x,
+                                uint16_t y,
+                                GFX_COLOR *pPixel,
+                                uint16_t numPixels);
+
+GFX_STATUS GFX_SurfaceBarDraw(
+                                uint16_t left,
+                                uint16_t top,
+                                uint16_t right,
+                                uint16_t bottom);
+// DOM-IGNORE-END
+#endif
+
+// DOM-IGNORE-BEGIN
+// *****************************************************************************
+/*  
+    <GROUP misc_functions>
+
+    Function:
+        int16_t GFX_SineCosineGet(
+                               int16_t v,
+                               GFX_TRIG_FUNCTION_TYPE type)
+
+    Summary:
+        This function returns sine or cosine of an angle.
+
+    Description:
+        This function returns sine or cosine of an angle. The angle
+        range is -360 to 360 degrees. This function uses the Graphics
+        Library look up table of 0-90 degrees. Depending on the
+        given angle, the appropriate sign of the result is calculated.
+
+    Precondition:
+        None.
+
+    Parameters:
+        v - the angle used to retrieve the sine or cosine value.
+            The angle must be in the range of -360 to 360 degrees.
+        type - sets if the angle calculation is for a sine or cosine
+            - GFX_TRIG_SINE_TYPE   - get the value of sine(v).
+            - GFX_TRIG_COSINE_TYPE - return the value of cosine(v).
+
+    Returns:
+        Value of the sine or cosine of the given angle.
+
+    Example:
+        None.
+
+*/
+// *****************************************************************************
+int16_t GFX_SineCosineGet(int16_t v, GFX_TRIG_FUNCTION_TYPE type);
+// DOM-IGNORE-END
+
+// DOM-IGNORE-BEGIN
+// *****************************************************************************
+/*  
+    <GROUP misc_functions>
+
+    Function:
+        int16_t GFX_SineGet(int16_t angle)
+
+    Summary:
+        This function returns sine of an angle.
+
+    Description:
+        This function returns sine of an angle. The angle range is
+        -360 to 360 degrees. This function uses the Graphics
+        Library look up table of 0-90 degrees. Depending on the
+        given angle, the appropriate sign of the result is calculated.
+
+    Precondition:
+        None.
+
+    Parameters:
+        v - the angle used to retrieve the sine value.
+            The angle must be in the range of -360 to 360 degrees.
+
+    Returns:
+        Sine value of the given angle.
+
+    Example:
+        None.
+
+*/
+// *****************************************************************************
+#define GFX_SineGet(angle) GFX_SineCosineGet(angle, GFX_TRIG_SINE_TYPE)
+// DOM-IGNORE-END
+
+// DOM-IGNORE-BEGIN
+// *****************************************************************************
+/*  
+    <GROUP misc_functions>
+
+    Function:
+        int16_t GFX_CosineGet(int16_t angle)
+
+    Summary:
+        This function returns cosine of an angle.
+
+    Description:
+        This function returns cosine of an angle. The angle range is
+        -360 to 360 degrees. This function uses the Graphics
+        Library look up table of 0-90 degrees. Depending on the
+        given angle, the appropriate sign of the result is calculated.
+
+    Precondition:
+        None.
+
+    Parameters:
+        v - the angle used to retrieve the cosine value.
+            The angle must be in the range of -360 to 360 degrees.
+
+    Returns:
+        Cosine value of the given angle.
+
+    Example:
+        None.
+
+*/
+// *****************************************************************************
+#define GFX_CosineGet(angle) GFX_SineCosineGet(angle, GFX_TRIG_COSINE_TYPE)
+// DOM-IGNORE-END
+
+// DOM-IGNORE-BEGIN
+// *****************************************************************************
+/*  
+    <GROUP misc_functions>
+
+    Function:
+        void GFX_CirclePointGet(
+                                int16_t radius,
+                                int16_t angle,
+                                int16_t *pX,
+                                int16_t *pY)
+
+    Summary:
+        This function sets the x,y position of the point on a
+        circle given the angle and the radius.
+
+    Description:
+        This function sets the x,y position of the point on a
+        circle given the angle and the radius. This function is
+        an internal function for the Graphics Library.
+        Application should not call this function.
+
+    Precondition:
+        None.
+
+    Parameters:
+        radius - radius of the circle
+        angle - the angle of the point in the circle in degrees.
+        pX - the address of the variable that will hold the
+             x-coordinate position of the point.
+        pY - the address of the variable that will hold the
+             y-coordinate position of the point.
+
+    Returns:
+        The x,y position of the point in the circle. The values are
+        placed in the address pointed to by pX and pY.
+
+    Example:
+        None.
+
+*/
+// *****************************************************************************
+void GFX_CirclePointGet(
+                                int16_t radius,
+                                int16_t angle,
+                                int16_t *pX,
+                                int16_t *pY);
+// DOM-IGNORE-END
+
+#ifndef GFX_CONFIG_GRADIENT_DISABLE
+
+// DOM-IGNORE-BEGIN
+
+// *****************************************************************************
+/*  
+    <GROUP polygon_fill_functions>
+    
     Function:
         GFX_STATUS GFX_BarGradientDraw(
                                 uint16_t left,
@@ -4650,6 +5973,52 @@ GFX_STATUS GFX_ExternalResourceCallback(
                                 uint16_t nCount,
                                 void     *pBuffer);
 
+#ifdef GFX_CONFIG_EXTERNAL_CACHE_BLOCKS
+// *****************************************************************************
+/*
+    <GROUP external_resources_functions>
+
+    Function:
+        void GFX_ExternalResourceCacheClear(void)
+
+    Summary:
+        This function removes all the blocks from the external
+        resource cache.
+
+    Description:
+        When GFX_CONFIG_EXTERNAL_CACHE_BLOCKS is defined, the image and
+        font functions read external resources through a cache of
+        GFX_CONFIG_EXTERNAL_CACHE_BLOCK_SIZE byte blocks. A block is
+        read with one call to GFX_ExternalResourceCallback() and the
+        small reads of the decoders (RLE codes, image rows, glyph
+        entries) are then copied from RAM. Reads of a block size or
+        more are passed to GFX_ExternalResourceCallback() directly.
+
+        The blocks are identified by the pointer to the resource
+        header and the offset in the resource. This function must be
+        called when the external memory is reprogrammed or when a
+        GFX_RESOURCE_HDR is reused for another resource.
+
+    Precondition:
+        None.
+
+    Parameters:
+        None.
+
+    Returns:
+        None.
+
+    Example:
+        <code>
+            // external memory was reprogrammed
+            GFX_ExternalResourceCacheClear();
+        </code>
+
+*/
+// *****************************************************************************
+void GFX_ExternalResourceCacheClear(void);
+#endif
+
 /* &&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&& */
 //                         INTERNAL FUNCTIONS/MACROS
 /* &&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&& */
@@ -107,6 +107,7 @@ typedef enum
     /*DOM-IGNORE-BEGIN*/
     GFX_LINE_TYPE_MASK          = 0x0007, // DO NOT document, mask for line type
     GFX_LINE_THICKNESS_MASK     = 0x0010, // DO NOT document, mask for thickness
+    GFX_LINE_ANTIALIAS_MASK     = 0x0020, // DO NOT document, mask for anti-aliasing
     /*DOM-IGNORE-END*/
     
     // solid line, 1 pixel wide (default)
@@ -127,10 +128,12 @@ typedef enum
     // dashed line, 3 pixel wide
     GFX_LINE_STYLE_THICK_DASHED /*DOM-IGNORE-BEGIN*/ = 0x0A14
                                 /*DOM-IGNORE-END*/, 
-    /*DOM-IGNORE-BEGIN*/
-    // anti-aliased line (future feature)
-    GFX_LINE_STYLE_ANTI_ALIASED = 0x0A20, 
-    /*DOM-IGNORE-END*/
+    // anti-aliased solid line, 1 pixel wide
+    GFX_LINE_STYLE_ANTI_ALIASED /*DOM-IGNORE-BEGIN*/ = 0x0A20
+                                /*DOM-IGNORE-END*/, 
+    // anti-aliased solid line, 3 pixel wide
+    GFX_LINE_STYLE_THICK_ANTI_ALIASED /*DOM-IGNORE-BEGIN*/ = 0x0A30
+                                /*DOM-IGNORE-END*/, 
 } GFX_LINE_STYLE;
 
 // *****************************************************************************
@@ -488,6 +491,33 @@ typedef struct
                             // (with respect to the image vertical origin).
 } GFX_PARTIAL_IMAGE_PARAM;
 
+// *****************************************************************************
+/*
+    <GROUP primitive_types>
+
+    Typedef:
+        GFX_IMAGE_LINE_CALLBACK
+
+    Summary:
+        Image line callback function.
+
+    Description:
+        Function called by GFX_ImagePartialLinesGet() for each decoded
+        line of the image. x and y are the frame buffer position of the
+        first pixel of the line, pLine points to the width pixels of
+        the line.
+
+    Remarks:
+        The pixels in pLine can be modified by the function.
+
+*/
+// *****************************************************************************
+typedef void (*GFX_IMAGE_LINE_CALLBACK)(
+                                uint16_t x,
+                                uint16_t y,
+                                GFX_COLOR *pLine,
+                                uint16_t width);
+
 // *****************************************************************************
 /* 
     <GROUP primitive_types>
@@ -515,6 +545,39 @@ typedef struct
     uint16_t bottom;        // bottom most pixel of the area.
 } GFX_RECTANGULAR_AREA;
 
+// *****************************************************************************
+/* 
+    <GROUP surface_functions>
+
+    Typedef:
+        GFX_SURFACE
+
+    Summary:
+        An off-screen surface that the primitives can render to.
+        
+    Description:
+        Structure describing an off-screen surface. The pixels of a RAM
+        surface are stored row by row in pBuffer. A surface with pBuffer
+        set to NULL is the draw buffer of the display driver with the
+        given index (see GFX_DrawBufferSet()).
+
+        Surfaces are initialized by GFX_SurfaceCreate() or
+        GFX_SurfaceDrawBufferCreate(), selected as the target of the
+        primitives by GFX_SurfaceSet() and drawn by GFX_SurfaceDraw().
+        
+    Remarks:
+        GFX_CONFIG_SURFACE_ENABLE must be defined.
+        
+*/
+// *****************************************************************************
+typedef struct
+{
+    GFX_COLOR   *pBuffer;   // pixels of a RAM surface, NULL for a driver draw buffer
+    uint16_t    index;      // index of the driver draw buffer
+    uint16_t    width;      // width of the surface in pixels
+    uint16_t    height;     // height of the surface in pixels
+} GFX_SURFACE;
+
 // DOM-IGNORE-BEGIN
 /*********************************************************************
 * Overview: Defines the maximum number of invalidated areas when
@@ -523,6 +586,16 @@ typedef struct
 #ifndef GFX_MAX_INVALIDATE_AREAS
 #define GFX_MAX_INVALIDATE_AREAS 5
 #endif
+
+/*********************************************************************
+* Overview: Defines the cost of one area copy during double buffer
+            synchronization in pixels. This is added to the pixel
+            count of each area when deciding if areas are merged or
+            if the whole frame is copied.
+*********************************************************************/
+#ifndef GFX_INVALIDATE_AREA_COST
+#define GFX_INVALIDATE_AREA_COST 128
+#endif
 // DOM-IGNORE-END
 
 // *****************************************************************************
@@ -560,6 +633,266 @@ typedef struct
     uint16_t                gfxUnsyncedAreaCount;
 } GFX_DOUBLE_BUFFERING_MODE;
 
+// DOM-IGNORE-BEGIN
+/*********************************************************************
+* Overview: The following structures keep the progress of the
+            non-blocking primitives. They are members of GFX_CONTEXT
+            and are used only internally by the primitive layer.
+*********************************************************************/
+typedef struct
+{
+    uint16_t                state;
+    int16_t                 deltaX, deltaY;
+    int16_t                 error, stepErrorLT, stepErrorGE;
+    int16_t                 stepX, stepY, steep;
+    uint16_t                left, top, right, bottom, thickAdjustX, thickAdjustY;
+    uint16_t                lineThickness, lineType;
+    int16_t                 runFirst, runLast, runRow;  // pixels of the line on one row
+    uint16_t                runCount;
+    int16_t                 spanFirst[3], spanLast[3];  // last runs of the line, the newest first
+    int16_t                 spanRow;                    // row of the newest run
+    uint16_t                spanValid, spanPending;
+} GFX_SOLID_LINE_DRAW_PARAM;
+
+typedef struct
+{
+    uint16_t                state;
+    int16_t                 counter, segmentCount;
+} GFX_POLYGON_DRAW_PARAM;
+
+#ifdef GFX_CONFIG_POLYGON_FILL_POINTS
+// side of a polygon crossed by the rows, the side crosses the
+// current row at x + (fraction / dy)
+typedef struct
+{
+    int16_t                 yTop;           // first row crossed by the side
+    int16_t                 yBottom;        // the side ends on this row, the row is not crossed
+    int16_t                 x;              // crossing on the current row, rounded down
+    int16_t                 fraction;       // 0 <= fraction < dy
+    int16_t                 xStep;          // change of x from row to row, rounded down
+    int16_t                 fractionStep;   // 0 <= fractionStep < dy
+    int16_t                 dy;
+} GFX_POLYGON_EDGE;
+
+// pixels of a row inside the polygon
+typedef struct
+{
+    int16_t                 left;
+    int16_t                 right;
+} GFX_POLYGON_SPAN;
+
+typedef struct
+{
+    uint16_t                state;
+    int16_t                 y;                          // row being rendered
+    int16_t                 left, top, right, bottom;   // bounds of the polygon
+    uint16_t                span, spanCount;            // spans of the row left to render
+    GFX_POLYGON_EDGE        edge[GFX_CONFIG_POLYGON_FILL_POINTS];       // sides sorted by first row
+    uint16_t                edgeCount;
+    uint16_t                edgeNext;                   // next side to cross the rows
+    uint16_t                active[GFX_CONFIG_POLYGON_FILL_POINTS];     // sides crossing the current row
+    uint16_t                activeCount;
+    GFX_POLYGON_SPAN        rowSpan[GFX_CONFIG_POLYGON_FILL_POINTS * 2]; // spans of the current row
+} GFX_POLYGON_FILL_DRAW_PARAM;
+#endif
+
+typedef struct
+{
+    uint16_t                state;
+    uint16_t                lineType, lineThickness;
+    int16_t                 style, type, xLimit, xPos, yPos, error;
+} GFX_BEVEL_DRAW_PARAM;
+
+typedef struct
+{
+    uint16_t                state;
+    int16_t                 err;
+    int16_t                 yLimit, xPos, yPos;
+    int16_t                 xCur, yCur, yNew;
+    int16_t                 last54Y, last18Y;
+} GFX_BEVEL_FILL_DRAW_PARAM;
+
+#ifndef GFX_CONFIG_GRADIENT_DISABLE
+// color components of a gradient as 8 bit values with 16 fraction bits
+typedef struct
+{
+    int32_t                 red;
+    int32_t                 green;
+    int32_t                 blue;
+    int32_t                 redStep;        // change of the components from step to step
+    int32_t                 greenStep;
+    int32_t                 blueStep;
+} GFX_GRADIENT_DDA;
+
+typedef struct
+{
+    uint16_t                state;
+    int32_t                 err;
+    int16_t                 yLimit, xPos, yPos;
+    int16_t                 xCur, yCur, yNew;
+    int16_t                 x1, y1, x2, y2, doDouble;
+    GFX_GRADIENT_DDA        dda;
+    uint16_t                extent;
+    GFX_FILL_STYLE          direction;
+    GFX_COLOR               color1, color2;
+    GFX_COLOR               sStart, sEnd;   // gradient colors restored at the end
+} GFX_BEVEL_GRADIENT_DRAW_PARAM;
+#endif
+
+typedef struct
+{
+    uint16_t                state;
+    uint16_t                y1Limit, y2Limit;
+    uint16_t                x1, x2, y1, y2, ovrlap;
+    int16_t                 err1, err2;
+    uint16_t                x1Cur, y1Cur, y1New;
+    uint16_t                x2Cur, y2Cur, y2New;
+    int16_t                 width, height;
+} GFX_THICK_BEVEL_DRAW_PARAM;
+
+typedef struct
+{
+    uint16_t                state, renderState;
+    GFX_FONT_OUTCHAR        OutCharParam;
+    GFX_STATUS              status;
+    GFX_STATUS_BIT          statusBit;
+    GFX_RESOURCE_HDR        *pFont;
+    void                    *pCacheEntry;
+} GFX_TEXT_CHAR_DRAW_PARAM;
+
+typedef struct
+{
+    uint8_t                 start;
+    uint16_t                counter;
+} GFX_TEXT_STRING_DRAW_PARAM;
+
+typedef struct
+{
+    uint16_t                state;
+    GFX_STATUS              status;
+    uint16_t                numLines;
+    GFX_XCHAR               *pChar;
+    uint16_t                left, top, right, bottom;
+    uint16_t                textHeight, textWidth, count;
+    uint16_t                ignoreCount;
+    int16_t                 lineXPos, lineYPos;
+} GFX_TEXT_STRING_BOX_DRAW_PARAM;
+// DOM-IGNORE-END
+
+// *****************************************************************************
+/* 
+    <GROUP primitive_types>
+
+    Typedef:
+        GFX_CONTEXT
+
+    Summary:
+        Structure used for the rendering state of the primitive layer.
+        
+    Description:
+        Structure that holds the current rendering state of the primitive
+        layer. This includes the style used by the primitives (color,
+        font, line and fill style, alpha, background, text area,
+        clip rectangle and target surface) and
+        the progress of the non-blocking primitives that have not
+        finished rendering.
+
+        The primitive layer renders using the active context (see
+        GFX_ContextSet()). Each context keeps its own style and the
+        progress of its own primitives. A non-blocking primitive of one
+        context can be left unfinished while primitives of another
+        context are rendered. Calling the primitive again after the
+        context is set back continues the rendering.
+
+        The members of the structure are managed by the library and
+        must not be modified directly. Use GFX_ContextInitialize() to
+        initialize a context and the primitive layer functions (for
+        example GFX_ColorSet()) to change the style.
+        
+    Remarks:
+        The line buffer, image palette and resource caches are shared
+        by all the contexts.
+
+        The Graphics Object Layer keeps a single state for the object
+        list and the panels (GFX_GOL_ObjectListDraw(),
+        GFX_GOL_PanelDraw() and GFX_GOL_TwoTonePanelDraw()). A GOL
+        draw that returned GFX_STATUS_FAILURE must be finished before
+        the GOL is drawn with another context.
+        
+*/
+// *****************************************************************************
+typedef struct
+{
+    GFX_COLOR               color;                  // foreground color for rendering shapes
+    GFX_LINE_STYLE          lineStyle;              // line style (see GFX_LINE_STYLE)
+    GFX_FILL_STYLE          fillStyle;              // fill style (see GFX_FILL_STYLE)
+    GFX_COLOR               gradientStartColor;     // gradient fill start color
+    GFX_COLOR               gradientEndColor;       // gradient fill end color
+
+    int16_t                 lineCursorX;
+    int16_t                 lineCursorY;
+
+    GFX_COLOR               colorTransparent;       // transparent color
+    GFX_FEATURE_STATUS      colorTransparentFlag;   // transparent color feature flag
+
+    GFX_RESOURCE_HDR        *pFont;                 // current active font
+    int16_t                 textPositionX;          // location where the next character will be rendered in the x coordinate
+    int16_t                 textPositionY;          // location where the next character will be rendered in the y coordinate
+#ifndef GFX_CONFIG_FONT_ANTIALIASED_DISABLE
+    // text foreground and background colors for use with anti-aliased fonts
+    GFX_COLOR               textForegroundColor100;
+    GFX_COLOR               textForegroundColor25;
+    GFX_COLOR               textForegroundColor75;
+    GFX_COLOR               textBackgroundColor100;
+    GFX_COLOR               textBackgroundColor25;
+    GFX_COLOR               textBackgroundColor75;
+#endif
+    GFX_FONT_ANTIALIAS_TYPE textAntiAliasType;      // font anti-aliasing transparency type (see GFX_FONT_ANTIALIAS_TYPE)
+
+#ifndef GFX_CONFIG_ALPHABLEND_DISABLE
+    uint8_t                 alphaValue;             // alpha value used when rendering with alpha blending
+#endif
+
+    GFX_BACKGROUND          background;             // background information (see GFX_BackgroundSet())
+    uint16_t                imageDrawRenderDisableFlag; // render to the line buffer instead of the display buffer
+    GFX_BEVEL_RENDER_TYPE   bevelDrawType;          // bevel drawing type (see GFX_BevelDrawTypeSet())
+
+    // window where text rendering is allowed (see GFX_TextStringBoxDraw())
+    uint16_t                textClipLeft;
+    uint16_t                textClipTop;
+    uint16_t                textClipRight;
+    uint16_t                textClipBottom;
+
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+    // pixels outside the clip rectangle are not rendered (see GFX_ClipPush())
+    GFX_RECTANGULAR_AREA    clip;
+    GFX_RECTANGULAR_AREA    clipStack[GFX_CONFIG_CLIP_STACK_SIZE];
+    uint16_t                clipCount;
+#endif
+
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+    // target of the primitives, NULL for the display (see GFX_SurfaceSet())
+    GFX_SURFACE             *pSurface;
+    uint16_t                surfaceDrawBuffer;      // draw buffer of the display
+#endif
+
+    // progress of the non-blocking primitives
+    GFX_SOLID_LINE_DRAW_PARAM       solidLine;
+    GFX_POLYGON_DRAW_PARAM          polygon;
+#ifdef GFX_CONFIG_POLYGON_FILL_POINTS
+    GFX_POLYGON_FILL_DRAW_PARAM     polygonFill;
+#endif
+    GFX_BEVEL_DRAW_PARAM            bevel;
+    GFX_BEVEL_FILL_DRAW_PARAM       bevelFill;
+#ifndef GFX_CONFIG_GRADIENT_DISABLE
+    GFX_BEVEL_GRADIENT_DRAW_PARAM   bevelGradient;
+#endif
+    GFX_THICK_BEVEL_DRAW_PARAM      thickBevel;
+    GFX_TEXT_CHAR_DRAW_PARAM        textChar;
+    GFX_TEXT_STRING_DRAW_PARAM      textString;
+    GFX_TEXT_STRING_BOX_DRAW_PARAM  textStringBox;
+} GFX_CONTEXT;
+
 
 #if (GFX_CONFIG_COLOR_DEPTH == 16)
 
@@ -720,6 +1053,10 @@ typedef struct
    #define ConvertColor25(color)  (GFX_COLOR)((color & (0x00FCFCFCul))>>2)
    #define ConvertColor75(color)  (GFX_COLOR)(ConvertColor50(color) + ConvertColor25(color))
 
+   #define GFX_Color50Convert(color)  ConvertColor50(color)
+   #define GFX_Color25Convert(color)  ConvertColor25(color)
+   #define GFX_Color75Convert(color)  ConvertColor75(color)
+
 #elif (GFX_CONFIG_COLOR_DEPTH == 8)
 #ifndef GFX_RGBConvert
     #define GFX_RGBConvert(red, green, blue)    (GFX_COLOR) (((GFX_COLOR)(red) & 0xE0) | (((GFX_COLOR)(green) & 0xE0) >> 3) | (((GFX_COLOR)(blue)) >> 6))
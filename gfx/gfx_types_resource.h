@@ -57,6 +57,10 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 #include "gfx/gfx_types_font.h"
 #include "gfx/gfx_types_image.h"
 
+#if defined (GFX_CONFIG_JPEG_DECODE_ENABLE) || defined (GFX_CONFIG_PNG_DECODE_ROW_SIZE)
+#include "fileio/fileio.h"
+#endif
+
 // *****************************************************************************
 /* 
     <GROUP primitive_types>
@@ -79,9 +83,10 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
                     - internal RAM type
                     - external memory type 
                     - external EDS memory type  
+                    - file type (opened with the fileio library)
         2. Data types of the resource - The following are the supported types of
                 resources:
-                - image
+                - image (Microchip bitmap, JPEG or PNG)
                 - font
                 - palette 
                 - binary data
@@ -94,8 +99,8 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
                         algorithm with fixed Huffman codes; dynamic 
                         Huffman codes are not supported.
         
-        The first four types indicates the location of the resource.
-        The next five types indicates which kind of resource and the next
+        The first five types indicates the location of the resource.
+        The next six types indicates which kind of resource and the next
         3 types indicates if the resource data is compressed or not.
         
         By combining these three groups, a resource can be described fully 
@@ -126,6 +131,11 @@ typedef enum
     // A location type: External memory.
     GFX_RESOURCE_MEMORY_EXTERNAL         
             /*DOM-IGNORE-BEGIN*/  = 0x0001 /*DOM-IGNORE-END*/,  
+    // A location type: File opened with the fileio library, the
+    // image is read from the current position when it is created
+    // (see GFX_ImageFileCreate()).
+    GFX_RESOURCE_MEMORY_FILE
+            /*DOM-IGNORE-BEGIN*/  = 0x0002 /*DOM-IGNORE-END*/,  
     // A location type: Random Access Memory (RAM).
     GFX_RESOURCE_MEMORY_RAM              
             /*DOM-IGNORE-BEGIN*/  = 0x0004 /*DOM-IGNORE-END*/,  
@@ -150,6 +160,9 @@ typedef enum
     // A data type: Palette type of data
     GFX_RESOURCE_TYPE_PALETTE            
             /*DOM-IGNORE-BEGIN*/  = 0x0400 /*DOM-IGNORE-END*/,  
+    // A data type: Image of type PNG.
+    GFX_RESOURCE_TYPE_PNG
+            /*DOM-IGNORE-BEGIN*/  = 0x0500 /*DOM-IGNORE-END*/,  
 
     // A compression type: Data resource has no compression.
     GFX_RESOURCE_COMP_NONE               
@@ -192,6 +205,11 @@ typedef enum
     GFX_RESOURCE_JPEG_EXTERNAL_NONE      = (GFX_RESOURCE_TYPE_JPEG | GFX_RESOURCE_MEMORY_EXTERNAL | GFX_RESOURCE_COMP_NONE),
     // JPEG image type, located in EDS memory and no compression.
     GFX_RESOURCE_JPEG_EDS_EPMP_NONE      = (GFX_RESOURCE_TYPE_JPEG | GFX_RESOURCE_MEMORY_EDS_EPMP | GFX_RESOURCE_COMP_NONE),
+    // JPEG image type, located in a file and no compression.
+    GFX_RESOURCE_JPEG_FILE_NONE          = (GFX_RESOURCE_TYPE_JPEG | GFX_RESOURCE_MEMORY_FILE | GFX_RESOURCE_COMP_NONE),
+
+    // PNG image type, located in a file and no compression.
+    GFX_RESOURCE_PNG_FILE_NONE           = (GFX_RESOURCE_TYPE_PNG | GFX_RESOURCE_MEMORY_FILE | GFX_RESOURCE_COMP_NONE),
 
     // Binary image type, located in flash and no compression.
     GFX_RESOURCE_BINARY_FLASH_NONE       = (GFX_RESOURCE_TYPE_BINARY | GFX_RESOURCE_MEMORY_FLASH | GFX_RESOURCE_COMP_NONE),
@@ -271,6 +289,9 @@ typedef struct
         char                    *ramAddress;        // An addresses in RAM.
 #if defined(__PIC24F__)
         __eds__ char            *edsAddress;        // An addresses in EDS.
+#endif
+#if defined (GFX_CONFIG_JPEG_DECODE_ENABLE) || defined (GFX_CONFIG_PNG_DECODE_ROW_SIZE)
+        FILEIO_OBJECT           *pFile;             // An open file.
 #endif
     }location;
     
@@ -286,6 +307,8 @@ typedef struct
                                                     // definition of param1 can change. For
                                                     // IPU and RLE compressed images, param1
                                                     // indicates the compressed size of the image.
+        uint32_t        fileOffset;                 // For JPEG and PNG files, the position
+                                                    // of the image in the file.
         uint32_t        reserved;
     } parameter1;
 
@@ -298,6 +321,8 @@ typedef struct
                                                     // definition of param2 can change. For
                                                     // IPU and RLE compressed images, param2
                                                     // indicates the uncompressed size of the image.
+        uint32_t        scale;                      // For JPEG and PNG files, the image is
+                                                    // rendered at 1/(2^scale) of its size.
         uint32_t        reserved;
     } parameter2;
 
@@ -72,6 +72,12 @@ static GFX_GOL_OBJ_HEADER               *pGfxObjectFocused = NULL;
 // Variables for panel drawing. Used by GFX_GOL_PanelDraw
 static GOL_PANEL_PARAM                  GfxPanel;
 
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+// Area to redraw in the next pass of GFX_GOL_ObjectListDraw()
+static GFX_RECTANGULAR_AREA             gfxGolRedrawArea;
+static bool                             gfxGolRedrawAreaSet = false;
+#endif
+
 // *****************************************************************************
 /*  Function:
     void GFX_GOL_MessageCallbackSet(
@@ -712,6 +718,13 @@ GFX_STATUS GFX_GOL_ObjectListDraw(void)
     static GFX_GOL_OBJ_HEADER  *pCurrentObj = NULL;
            GFX_STATUS          status;
 
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+    static GFX_RECTANGULAR_AREA drawArea;               // area redrawn in this pass
+    static bool                drawAreaSet = false;
+    static GFX_GOL_OBJ_HEADER  *pClippedObj = NULL;     // object redrawn only in the area
+           GFX_STATUS          clipStatus;
+#endif
+
 #ifndef GFX_CONFIG_DOUBLE_BUFFERING_DISABLE
     static uint8_t         DisplayUpdated = 0;
 
@@ -734,6 +747,14 @@ GFX_STATUS GFX_GOL_ObjectListDraw(void)
                 // It's last object jump to head
                 pCurrentObj = pGfxGolObjectList;
 
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+                // the area marked since the last pass is redrawn in this pass
+                drawArea = gfxGolRedrawArea;
+                drawAreaSet = gfxGolRedrawAreaSet;
+                gfxGolRedrawAreaSet = false;
+                pClippedObj = NULL;
+#endif
+
 #ifndef GFX_CONFIG_DOUBLE_BUFFERING_DISABLE
                 if(DisplayUpdated)
                 {
@@ -753,19 +774,68 @@ GFX_STATUS GFX_GOL_ObjectListDraw(void)
 
     status = GFX_STATUS_FAILURE;
 
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // the objects are recorded and drawn when the list is parsed, an
+    // object hidden by the objects drawn after it is not drawn
+    GFX_DisplayListBegin();
+#endif
+
     // this is the loop that parses the list and redraws any
     // object that needs to be redrawn.
     while(pCurrentObj != NULL)
     {
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+        // an object in the redrawn area is redrawn, only inside the
+        // area when nothing else of the object has to be redrawn
+        if ((drawAreaSet == true) && (pCurrentObj != pClippedObj) &&
+            (pCurrentObj->left <= drawArea.right) &&
+            (pCurrentObj->right >= drawArea.left) &&
+            (pCurrentObj->top <= drawArea.bottom) &&
+            (pCurrentObj->bottom >= drawArea.top))
+        {
+            if(GFX_GOL_ObjectIsRedrawSet(pCurrentObj) == false)
+                pClippedObj = pCurrentObj;
+            GFX_GOL_ObjectDrawEnable(pCurrentObj);
+        }
+#endif
+
         if(GFX_GOL_ObjectIsRedrawSet(pCurrentObj) == true)
         {
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+            clipStatus = GFX_STATUS_FAILURE;
+            if(pCurrentObj == pClippedObj)
+            {
+                clipStatus = GFX_ClipPush(  drawArea.left,
+                                            drawArea.top,
+                                            drawArea.right,
+                                            drawArea.bottom);
+            }
+
+            status = pCurrentObj->DrawObj(pCurrentObj);
+
+            if(clipStatus == GFX_STATUS_SUCCESS)
+                GFX_ClipPop();
+#else
             status = pCurrentObj->DrawObj(pCurrentObj);
+#endif
             
             if(status == GFX_STATUS_SUCCESS)
             {
                 GFX_GOL_ObjectDrawDisable(pCurrentObj);
 
 #ifndef GFX_CONFIG_DOUBLE_BUFFERING_DISABLE
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+                if(pCurrentObj == pClippedObj)
+                {
+                    // only the part of the object in the area is changed
+                    GFX_DoubleBufferAreaMark(
+                        (pCurrentObj->left   > drawArea.left)   ? pCurrentObj->left   : drawArea.left,
+                        (pCurrentObj->top    > drawArea.top)    ? pCurrentObj->top    : drawArea.top,
+                        (pCurrentObj->right  < drawArea.right)  ? pCurrentObj->right  : drawArea.right,
+                        (pCurrentObj->bottom < drawArea.bottom) ? pCurrentObj->bottom : drawArea.bottom);
+                }
+                else
+#endif
                 GFX_DoubleBufferAreaMark(   pCurrentObj->left,          \
                                             pCurrentObj->top,           \
                                             pCurrentObj->right,         \
@@ -775,6 +845,9 @@ GFX_STATUS GFX_GOL_ObjectListDraw(void)
             }
             else
             {
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+                GFX_DisplayListEnd();
+#endif
                 // drawing is not done
                 return (GFX_STATUS_FAILURE);
             }
@@ -782,6 +855,10 @@ GFX_STATUS GFX_GOL_ObjectListDraw(void)
         pCurrentObj = (GFX_GOL_OBJ_HEADER *)pCurrentObj->pNxtObj;
     }
 
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    GFX_DisplayListEnd();
+#endif
+
 return (GFX_STATUS_SUCCESS);             // drawing is completed
 
 }
@@ -804,6 +881,11 @@ return (GFX_STATUS_SUCCESS);             // drawing is completed
 
         After calling this function, the next call to GFX_GOL_ObjectListDraw()
         will redraw all objects that are marked for redraw.
+
+        When GFX_CONFIG_CLIP_STACK_SIZE is defined, the area is kept
+        instead and the next pass of GFX_GOL_ObjectListDraw() redraws
+        the objects intersected by the area. An object that has nothing
+        else to redraw is only redrawn inside the area.
     
 */
 // *****************************************************************************
@@ -814,6 +896,32 @@ void GFX_GOL_ObjectRectangleRedraw(
                                 uint16_t bottom)
 {
 
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+
+    // the objects in the area are redrawn by the next pass of
+    // GFX_GOL_ObjectListDraw(), areas marked before the pass are merged
+    if(gfxGolRedrawAreaSet == false)
+    {
+        gfxGolRedrawArea.left   = left;
+        gfxGolRedrawArea.top    = top;
+        gfxGolRedrawArea.right  = right;
+        gfxGolRedrawArea.bottom = bottom;
+        gfxGolRedrawAreaSet = true;
+    }
+    else
+    {
+        if(gfxGolRedrawArea.left > left)
+            gfxGolRedrawArea.left = left;
+        if(gfxGolRedrawArea.top > top)
+            gfxGolRedrawArea.top = top;
+        if(gfxGolRedrawArea.right < right)
+            gfxGolRedrawArea.right = right;
+        if(gfxGolRedrawArea.bottom < bottom)
+            gfxGolRedrawArea.bottom = bottom;
+    }
+
+#else
+
     GFX_GOL_OBJ_HEADER  *pCurrentObj;
     int                 overlapX, overlapY;
 
@@ -848,6 +956,7 @@ void GFX_GOL_ObjectRectangleRedraw(
         pCurrentObj = (GFX_GOL_OBJ_HEADER *)pCurrentObj->pNxtObj;
     }   //end of while
 
+#endif // #ifdef GFX_CONFIG_CLIP_STACK_SIZE
 }
 
 // *****************************************************************************
@@ -96,42 +96,451 @@ typedef union
     uint32_t uint32Value;
 }PRIMITIVE_UINT32_UNION;
 
+// states of the non-blocking primitives (see GFX_CONTEXT)
+typedef enum
+{
+    GFX_SOLID_LINE_IDLE_STATE = 0x0D90,
+    GFX_SOLID_LINE_VERHOR_DRAW_STATE,
+    GFX_SOLID_LINE_DIAGONAL_INITIALIZE_STATE,
+    GFX_SOLID_LINE_UPDATE_DRAW_STATE,
+    GFX_SOLID_LINE_SPAN_DRAW_STATE,
+    GFX_SOLID_LINE_EXIT_STATE,
+} GFX_SOLID_LINE_DRAW_STATE;
+
+typedef enum
+{
+    POLYGON_BEGIN,
+    POLYGON_DRAWING,
+} DRAWPOLY_STATES;
+
+typedef enum
+{
+    POLYGON_FILL_BEGIN,
+    POLYGON_FILL_ROW,
+    POLYGON_FILL_DRAW,
+} POLYGON_FILL_STATES;
+
+typedef enum
+{
+    GFX_BEVEL_IDLE_STATE = 0x0DA0,
+    GFX_BEVEL_RADIUS_EVAL_STATE,
+    GFX_BEVEL_RADIUS_ERROR_EVAL_STATE,
+    GFX_BEVEL_RADIUS_DRAW_STATE,
+    GFX_BEVEL_LINE_TOP_DRAW_STATE,
+    GFX_BEVEL_LINE_BOTTOM_DRAW_STATE,
+    GFX_BEVEL_LINE_RIGHT_DRAW_STATE,
+    GFX_BEVEL_LINE_LEFT_DRAW_STATE,
+    GFX_BEVEL_SPAN_DRAW_STATE,
+} GFX_BEVEL_DRAW_STATE;
+
+typedef enum
+{
+    FB_BEGIN,
+    FB_INIT_FILL,
+    FB_CHECK,
+    FB_Q8TOQ1,
+    FB_Q7TOQ2,
+    FB_Q6TOQ3,
+    FB_Q5TOQ4,
+    FB_DRAW_MISSING_1,
+    FB_DRAW_MISSING_2,
+    FB_WAITFORDONE,
+} FB_FILLCIRCLE_STATES;
+
+typedef enum
+{
+    BEVEL_GRADIENT_IDLE,
+    BEVEL_GRADIENT_BEGIN,
+    BEVEL_GRADIENT_CHECK,
+    BEVEL_GRADIENT_CALC_Q8TOQ1,
+    BEVEL_GRADIENT_Q8TOQ1,
+    BEVEL_GRADIENT_CALC_Q7TOQ2,
+    BEVEL_GRADIENT_Q7TOQ2,
+    BEVEL_GRADIENT_CALC_Q6TOQ3,
+    BEVEL_GRADIENT_Q6TOQ3,
+    BEVEL_GRADIENT_CALC_Q5TOQ4,
+    BEVEL_GRADIENT_Q5TOQ4,
+    BEVEL_GRADIENT_FACE_CHECK,
+    BEVEL_GRADIENT_FACE,
+} BEVEL_GRADIENT_FILL_STATES;
+
+typedef enum
+{
+    BEGIN,
+    QUAD11,
+    BARRIGHT1,
+    QUAD12,
+    BARRIGHT2,
+    QUAD21,
+    BARLEFT1,
+    QUAD22,
+    BARLEFT2,
+    QUAD31,
+    BARTOP1,
+    QUAD32,
+    BARTOP2,
+    QUAD41,
+    BARBOTTOM1,
+    QUAD42,
+    BARBOTTOM2,
+    CHECK,
+} OCTANTARC_STATES;
+
+typedef enum
+{
+    TC_IDLE,
+    TC_GET_INFO,
+    TC_CHECK_RENDER_STATUS,
+    TC_RENDER_CHAR,
+    TC_RENDER_CHAR_CACHE,
+    TC_RENDER_CHAR_DRIVER,
+    TC_RENDER_STATUS_CHECK,
+    TC_RENDER_NEWLINE_CHAR,
+} TEXTCHAR_RENDER_STATES;
+
+typedef enum
+{
+    TB_IDLE,
+    TB_GET_LINE_INFO,
+    TB_CHECK_NEWLINE_OR_END,
+    TB_RENDER_CHARS,
+    TB_EXIT,
+} TEXTSTRINGBOX_RENDER_STATES;
+
+#ifdef GFX_CONFIG_FONT_GLYPH_CACHE_SIZE
+
+#ifndef GFX_CONFIG_FONT_GLYPH_CACHE_PIXELS
+    #define GFX_CONFIG_FONT_GLYPH_CACHE_PIXELS      256
+#endif
+
+// glyph decoded into pixel rows that are ready to be rendered
+typedef struct
+{
+    GFX_RESOURCE_HDR    *pFont;         // font of the glyph, NULL when the entry is free
+    GFX_XCHAR           ch;             // character code of the glyph
+    GFX_COLOR           foreground;     // text color used to render the pixels
+    GFX_COLOR           background;     // background color used to render anti-aliased pixels
+    uint16_t            candidate;      // key of the last glyph that missed this entry
+    uint8_t             bpp;            // color depth of the font
+    int16_t             width;          // glyph width in pixels
+    int16_t             height;         // number of glyph rows
+    int16_t             xAdjust;
+    int16_t             yAdjust;
+    int16_t             xWidthAdjust;
+    uint8_t             coverage[GFX_CONFIG_FONT_GLYPH_CACHE_PIXELS];   // 0 when the pixel is not rendered, 1 to 3 anti-aliasing level
+    GFX_COLOR           pixel[GFX_CONFIG_FONT_GLYPH_CACHE_PIXELS];      // rendered color of the pixel
+} GFX_FONT_GLYPH_CACHE_ENTRY;
+
+#endif
+
+#ifdef GFX_CONFIG_FONT_WIDTH_TABLE_SIZE
+
+#ifndef GFX_CONFIG_FONT_WIDTH_TABLE_CHARS
+    #define GFX_CONFIG_FONT_WIDTH_TABLE_CHARS       96
+#endif
+
+// marks a character width that is not yet in the table
+#define GFX_FONT_WIDTH_UNKNOWN                      0xFF
+
+// advance widths of the characters of a font
+typedef struct
+{
+    GFX_RESOURCE_HDR    *pFont;         // font of the table, NULL when the table is free
+    uint8_t             width[GFX_CONFIG_FONT_WIDTH_TABLE_CHARS];   // width from the first character of the font
+} GFX_FONT_WIDTH_TABLE;
+
+#endif
+
+#ifdef GFX_CONFIG_EXTERNAL_CACHE_BLOCKS
+
+#ifndef GFX_CONFIG_EXTERNAL_CACHE_BLOCK_SIZE
+    #define GFX_CONFIG_EXTERNAL_CACHE_BLOCK_SIZE    256
+#endif
+
+// copy of an aligned block of an external resource
+typedef struct
+{
+    GFX_RESOURCE_HDR    *pResource;     // resource of the block, NULL when the block is free
+    uint32_t            offset;         // resource offset of the first byte of data
+    uint16_t            age;            // time of last use, oldest block is replaced first
+    uint8_t             data[GFX_CONFIG_EXTERNAL_CACHE_BLOCK_SIZE];
+} GFX_EXTERNAL_CACHE_BLOCK;
+
+#endif
+
+#ifndef GFX_CONFIG_RLE_DECODE_DISABLE
+
+// number of bytes read at once from an RLE image in external memory
+#define GFX_RLE_STREAM_BLOCK_SIZE                   32
+
+// reader of the compressed data of an RLE image
+typedef struct
+{
+    GFX_RESOURCE_HDR    *pImage;        // image being read
+    uint32_t            blockAddress;   // image offset of the first byte in block
+    uint16_t            blockLength;    // number of valid bytes in block
+    uint8_t             block[GFX_RLE_STREAM_BLOCK_SIZE];
+} GFX_RLE_STREAM;
+
+#ifdef GFX_CONFIG_RLE_ROW_INDEX_SIZE
+
+#ifndef GFX_CONFIG_RLE_ROW_INDEX_ENTRIES
+    #define GFX_CONFIG_RLE_ROW_INDEX_ENTRIES        32
+#endif
+
+// offsets of the compressed rows of an RLE image
+typedef struct
+{
+    GFX_RESOURCE_HDR    *pImage;        // image of the index, NULL when the index is free
+    uint16_t            step;           // number of rows between two entries
+    uint16_t            entries;        // number of known entries
+    uint32_t            offset[GFX_CONFIG_RLE_ROW_INDEX_ENTRIES];   // offset of row (entry * step)
+} GFX_RLE_ROW_INDEX;
+
+#endif
+
+#endif
+
+#if !defined (GFX_CONFIG_IPU_DECODE_DISABLE) && defined (GFX_CONFIG_IPU_DECODE_WINDOW_SIZE) && \
+    !defined (GFX_USE_DISPLAY_CONTROLLER_MCHP_DA210)
+    // IPU images are decoded in software
+    #define GFX_IMAGE_IPU_SOFTWARE_DECODE
+#endif
+
+#if defined (GFX_CONFIG_PNG_DECODE_ROW_SIZE) && !defined (GFX_CONFIG_IPU_DECODE_WINDOW_SIZE)
+    #error "PNG decoding uses the DEFLATE window, GFX_CONFIG_IPU_DECODE_WINDOW_SIZE must be defined."
+#endif
+
+#if defined (GFX_IMAGE_IPU_SOFTWARE_DECODE) || defined (GFX_CONFIG_PNG_DECODE_ROW_SIZE)
+    // the DEFLATE decoder is used by the IPU or PNG images
+    #define GFX_IMAGE_INFLATE
+#endif
+
+#ifdef GFX_IMAGE_INFLATE
+
+#if (GFX_CONFIG_IPU_DECODE_WINDOW_SIZE & (GFX_CONFIG_IPU_DECODE_WINDOW_SIZE - 1))
+    #error "GFX_CONFIG_IPU_DECODE_WINDOW_SIZE must be a power of 2"
+#endif
+
+// number of bytes read at once from an IPU image in external memory
+#define GFX_INFLATE_STREAM_BLOCK_SIZE               32
+
+// number of bytes of an image row decoded at once
+#define GFX_INFLATE_ROW_CHUNK_SIZE                  32
+
+// state of the DEFLATE stream between two blocks or inside a block
+typedef enum
+{
+    GFX_INFLATE_BLOCK_HEADER = 0,
+    GFX_INFLATE_BLOCK_STORED,
+    GFX_INFLATE_BLOCK_HUFFMAN,
+    GFX_INFLATE_DONE,
+    GFX_INFLATE_ERROR,
+} GFX_INFLATE_STATE;
+
+// decoder of the DEFLATE data of an IPU or PNG image, the output is
+// produced a few bytes at a time and only the last window of bytes is kept
+typedef struct
+{
+    GFX_RESOURCE_HDR    *pImage;        // image being decoded
+    uint32_t            address;        // image offset of the next compressed byte
+    uint32_t            blockAddress;   // image offset of the first byte in block
+    uint16_t            blockLength;    // number of valid bytes in block
+    uint8_t             block[GFX_INFLATE_STREAM_BLOCK_SIZE];
+    uint32_t            bitBuffer;      // compressed bits not used yet, first bit in bit 0
+    uint16_t            bitCount;
+    GFX_INFLATE_STATE   state;
+    uint16_t            lastBlock;      // set while the last block is decoded
+    uint16_t            storedLength;   // bytes left in a stored block
+    uint16_t            copyLength;     // bytes left to copy from the window
+    uint16_t            copyDistance;
+    uint32_t            total;          // number of bytes produced
+    uint16_t            lengthCount[16];        // number of literal/length codes of each size
+    uint16_t            lengthSymbol[288];      // literal/length symbols sorted by code
+    uint16_t            distanceCount[16];      // number of distance codes of each size
+    uint16_t            distanceSymbol[32];     // distance symbols sorted by code
+    uint8_t             window[GFX_CONFIG_IPU_DECODE_WINDOW_SIZE];
+} GFX_INFLATE_STREAM;
+
+#endif
+
+#if defined (GFX_CONFIG_JPEG_DECODE_ENABLE) || defined (GFX_CONFIG_PNG_DECODE_ROW_SIZE)
+
+#if (GFX_CONFIG_COLOR_DEPTH < 8)
+    #error "JPEG and PNG decoding can currently support the COLOR_DEPTH of 8, 16 and 24 only."
+#endif
+
+#ifndef GFX_CONFIG_PALETTE_DISABLE
+    #error "JPEG and PNG decoding is not currently supported when palette is enabled."
+#endif
+
+// number of bytes read at once from an image file
+#define GFX_IMAGE_FILE_BUFFER_SIZE                  64
+
+// reader of the JPEG and PNG image files
+typedef struct
+{
+    FILEIO_OBJECT       *pFile;
+    uint16_t            position;       // index of the next byte in buffer
+    uint16_t            length;         // number of valid bytes in buffer
+    uint16_t            error;          // set when the file ends before the image
+    uint8_t             buffer[GFX_IMAGE_FILE_BUFFER_SIZE];
+} GFX_IMAGE_FILE_STREAM;
+
+#endif
+
+#ifdef GFX_CONFIG_JPEG_DECODE_ENABLE
+
+// maximum number of 8x8 blocks in a JPEG MCU
+#define GFX_JPEG_MCU_BLOCKS                         10
+
+// maximum number of symbols of a baseline JPEG Huffman table
+#define GFX_JPEG_HUFFMAN_SYMBOLS                    162
+
+// JPEG Huffman table, the symbols are sorted by code
+typedef struct
+{
+    uint16_t            count[17];      // number of codes of each length
+    uint8_t             symbol[GFX_JPEG_HUFFMAN_SYMBOLS];
+} GFX_JPEG_HUFFMAN_TABLE;
+
+// JPEG image component (Y, Cb or Cr)
+typedef struct
+{
+    uint8_t             id;
+    uint8_t             horizontal;     // sampling factors, 1 or 2
+    uint8_t             vertical;
+    uint8_t             quantTable;
+    uint8_t             dcTable;
+    uint8_t             acTable;
+    int16_t             dcPrevious;     // DC coefficient of the previous block
+} GFX_JPEG_COMPONENT;
+
+// decoder of baseline JPEG images
+typedef struct
+{
+    uint16_t            width;          // size of the image in the file
+    uint16_t            height;
+    uint16_t            componentCount; // 1 (grayscale) or 3 (YCbCr)
+    uint16_t            horizontalMax;  // largest sampling factors
+    uint16_t            verticalMax;
+    uint16_t            restartInterval;    // number of MCUs between restart markers
+    GFX_JPEG_COMPONENT  component[3];
+    uint8_t             quant[4][64];   // quantization tables in zigzag order
+    GFX_JPEG_HUFFMAN_TABLE  dcTable[2];
+    GFX_JPEG_HUFFMAN_TABLE  acTable[2];
+    uint32_t            bitBuffer;      // entropy coded bits not used yet, first bit in bit 31
+    uint16_t            bitCount;
+    uint16_t            marker;         // marker found in the entropy coded data
+    int16_t             coefficient[64];
+    uint8_t             sample[GFX_JPEG_MCU_BLOCKS][64];    // samples of the MCU, 
+                                                            // (8 >> scale) by (8 >> scale) per block
+} GFX_JPEG_DECODER;
+
+#endif
+
+#ifdef GFX_CONFIG_PNG_DECODE_ROW_SIZE
+
+// decoder of PNG images
+typedef struct
+{
+    uint16_t            width;
+    uint16_t            height;
+    uint8_t             bitDepth;       // bits per sample
+    uint8_t             colorType;
+    uint8_t             channels;       // samples per pixel
+    uint8_t             pixelBytes;     // bytes per pixel used by the filters, at least 1
+    uint16_t            rowLength;      // bytes of a row without the filter type
+    uint32_t            chunkLength;    // bytes left in the current IDAT chunk
+    uint16_t            paletteEntries;
+    GFX_COLOR           palette[256];
+    uint8_t             row[2][GFX_CONFIG_PNG_DECODE_ROW_SIZE];     // current and previous rows
+} GFX_PNG_DECODER;
+
+#endif
+
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+
+// primitive recorded in the display list
+typedef enum
+{
+    GFX_DISPLAY_LIST_BAR = 0,
+    GFX_DISPLAY_LIST_IMAGE,
+} GFX_DISPLAY_LIST_COMMAND_TYPE;
+
+// command recorded in the display list
+typedef struct
+{
+    GFX_DISPLAY_LIST_COMMAND_TYPE type;
+    uint16_t            cover;          // set when the command hides everything in its area
+    uint16_t            left;           // area drawn by the command
+    uint16_t            top;
+    uint16_t            right;
+    uint16_t            bottom;
+    GFX_COLOR           color;          // color of a bar
+    GFX_RESOURCE_HDR    *pImage;        // image and image portion of an image
+    uint16_t            xOffset;
+    uint16_t            yOffset;
+    uint16_t            width;
+    uint16_t            height;
+} GFX_DISPLAY_LIST_COMMAND;
+
+#endif
+
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Global Variables
 // *****************************************************************************
 // *****************************************************************************
-    static GFX_LINE_STYLE       gfxLineStyle;               // line style (see GFX_LINE_STYLE)
-    static GFX_FILL_STYLE       gfxFillStyle;               // fill style (see GFX_FILL_STYLE)
+    // the style and the progress of the primitives are kept in the active
+    // context, the default context is active after GFX_Initialize()
+    static GFX_CONTEXT          gfxContextDefault;
+    static GFX_CONTEXT          *pGfxContext = &gfxContextDefault;
 
-    static GFX_COLOR            gfxGradientStartColor;      // gradient fill start color
-    static GFX_COLOR            gfxGradientEndColor;        // gradient fill end color
-    static GFX_COLOR            gfxColor;                   // foreground color for rendering shapes
+#ifdef GFX_CONFIG_FONT_GLYPH_CACHE_SIZE
+    static GFX_FONT_GLYPH_CACHE_ENTRY gfxGlyphCache[GFX_CONFIG_FONT_GLYPH_CACHE_SIZE];
+    static uint16_t             gfxGlyphCacheKey;           // key of the glyph being looked up
+    static GFX_COLOR            gfxGlyphCacheBackground;    // background color of the glyph being looked up
+#endif
 
-    static int16_t              gfxLineCursorX;
-    static int16_t              gfxLineCursorY;
+#ifdef GFX_CONFIG_FONT_WIDTH_TABLE_SIZE
+    static GFX_FONT_WIDTH_TABLE gfxFontWidthTable[GFX_CONFIG_FONT_WIDTH_TABLE_SIZE];
+    static uint16_t             gfxFontWidthTableNext;      // table replaced when all the tables are used
+#endif
 
-    static GFX_COLOR            gfxColorTransparent;        // transparent color
-    static GFX_FEATURE_STATUS   gfxColorTransparentFlag;    // transparent color feature flag
+#if defined (GFX_CONFIG_EXTERNAL_CACHE_BLOCKS) && (!defined (GFX_CONFIG_IMAGE_EXTERNAL_DISABLE) || !defined (GFX_CONFIG_FONT_EXTERNAL_DISABLE))
+    static GFX_EXTERNAL_CACHE_BLOCK gfxExternalCache[GFX_CONFIG_EXTERNAL_CACHE_BLOCKS];
+    static uint16_t             gfxExternalCacheAge;        // incremented on every use of a cached block
+#endif
 
-    static GFX_RESOURCE_HDR     *pGfxCurrentFont;           // current active font
-    static int16_t              gfxTextPositionX;           // used only internally to locate where the character will be rendered in the x coordinate
-    static int16_t              gfxTextPositionY;           // used only internally to locate where the character will be rendered in the y coordinate
-#ifndef GFX_CONFIG_FONT_ANTIALIASED_DISABLE
-    // text foreground colors for use with anti-aliased fonts
-    static GFX_COLOR            gfx_TextForegroundColor100;
-    static GFX_COLOR            gfx_TextForegroundColor25;
-    static GFX_COLOR            gfx_TextForegroundColor75;
-    // text background colors for use with anti-aliased fonts
-    static GFX_COLOR            gfx_TextBackgroundColor100;
-    static GFX_COLOR            gfx_TextBackgroundColor25;
-    static GFX_COLOR            gfx_TextBackgroundColor75;
-    static GFX_FONT_ANTIALIAS_TYPE gfxTextAntiAliasType;    // Font anti-aliasing transparency type (see GFX_FONT_ANTIALIAS_TYPE)
+#if !defined (GFX_CONFIG_RLE_DECODE_DISABLE) && defined (GFX_CONFIG_RLE_ROW_INDEX_SIZE)
+    static GFX_RLE_ROW_INDEX    gfxRLERowIndex[GFX_CONFIG_RLE_ROW_INDEX_SIZE];
+    static uint16_t             gfxRLERowIndexNext;         // index replaced when all the indexes are used
+#endif
 
+#ifdef GFX_IMAGE_INFLATE
+    // the decoder is shared by the contexts, one IPU or PNG image is decoded at a time
+    static GFX_INFLATE_STREAM   gfxInflateStream;
 #endif
 
-#ifndef GFX_CONFIG_ALPHABLEND_DISABLE
-    static uint8_t              gfxAlphaValue;              // alpha value used when rendering with alpha blending
+#if defined (GFX_CONFIG_JPEG_DECODE_ENABLE) || defined (GFX_CONFIG_PNG_DECODE_ROW_SIZE)
+    static GFX_IMAGE_FILE_STREAM gfxImageFile;
+#endif
+
+#ifdef GFX_CONFIG_JPEG_DECODE_ENABLE
+    static GFX_JPEG_DECODER     gfxJpeg;
+#endif
+
+#ifdef GFX_CONFIG_PNG_DECODE_ROW_SIZE
+    static GFX_PNG_DECODER      gfxPng;
+#endif
+
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    static GFX_DISPLAY_LIST_COMMAND gfxDisplayList[GFX_CONFIG_DISPLAY_LIST_SIZE];
+    static uint16_t             gfxDisplayListCount;        // number of recorded commands
+    static uint16_t             gfxDisplayListNesting;      // primitives are recorded when not 0
+    static uint16_t             gfxDisplayListReplay;       // set while the recorded commands are drawn
 #endif
 
     // allocate buffer for rendering and/or retrieval of arrays of pixels
@@ -142,23 +551,30 @@ typedef union
     static GFX_COLOR            gfxLineBuffer0[DISP_HOR_RESOLUTION];
 #endif
 
-    // parameters for the background information used
-    GFX_BACKGROUND              gfxBackground;
-    static uint16_t             gfxImageDrawRenderDisableFlag;
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+    // rows read from a draw buffer of the driver when a surface is drawn
+#if (DISP_VER_RESOLUTION > DISP_HOR_RESOLUTION)
+    static GFX_COLOR            gfxSurfaceLineBuffer[DISP_VER_RESOLUTION];
+#else
+    static GFX_COLOR            gfxSurfaceLineBuffer[DISP_HOR_RESOLUTION];
+#endif
+#endif
 
-    // bevel drawing type (0 = full bevel, 0xF0 - top bevel only, 0x0F - bottom bevel only
-    static GFX_BEVEL_RENDER_TYPE gfxBevelDrawType;
+    static GFX_IMAGE_LINE_CALLBACK gfxImageLineCallback;    // receives the decoded image lines (see GFX_ImagePartialLinesGet())
 
-    // The following are internally used for the primitive text box
-    // function. These defines the window where text rendering will
-    // be allowed. Values of these are set by the GFX_TextStringBoxDraw()
-    // function. Since GFX_TextStringBoxDraw() calls the GFX_TextCharDraw()
-    // to render each character, GFX_TextCharDraw() must know if the character
-    // is within the clipping region.
-    static uint16_t             gfxTextClipLeft;            // used internally to define the left limit for text rendering
-    static uint16_t             gfxTextClipTop;             // used internally to define the top limit for text rendering
-    static uint16_t             gfxTextClipRight;           // used internally to define the right limit for text rendering
-    static uint16_t             gfxTextClipBottom;          // used internally to define the bottom limit for text rendering
+#if !defined (GFX_CONFIG_IMAGE_FLASH_DISABLE) || !defined (GFX_CONFIG_IMAGE_EXTERNAL_DISABLE)
+    // the palette of the last rendered image is kept until another image is rendered
+#if (GFX_CONFIG_COLOR_DEPTH >= 8)
+    #define GFX_IMAGE_PALETTE_ENTRIES   256
+#elif (GFX_CONFIG_COLOR_DEPTH >= 4)
+    #define GFX_IMAGE_PALETTE_ENTRIES   16
+#else
+    #define GFX_IMAGE_PALETTE_ENTRIES   2
+#endif
+    static uint16_t             gfxImagePalette[GFX_IMAGE_PALETTE_ENTRIES];
+    static GFX_RESOURCE_HDR     *pGfxImagePaletteImage;     // image of the cached palette
+    static uint16_t             gfxImagePaletteEntries;     // number of entries of the cached palette
+#endif
 
 #ifndef GFX_CONFIG_DOUBLE_BUFFERING_DISABLE
     // double buffering feature variable
@@ -275,6 +691,31 @@ typedef union
                                 uint16_t rleType);
 #endif // end of #ifndef GFX_CONFIG_RLE_DECODE_DISABLE
 
+#ifdef GFX_IMAGE_IPU_SOFTWARE_DECODE
+    static void GFX_ImageInflateDraw(
+                                uint16_t left,
+                                uint16_t top,
+                                GFX_RESOURCE_HDR *pImage,
+                                GFX_PARTIAL_IMAGE_PARAM *pPartialImageData);
+#endif
+
+#ifdef GFX_CONFIG_JPEG_DECODE_ENABLE
+    static void GFX_ImageJpegDraw(
+                                uint16_t left,
+                                uint16_t top,
+                                GFX_RESOURCE_HDR *pImage,
+                                GFX_PARTIAL_IMAGE_PARAM *pPartialImageData);
+#endif
+
+#ifdef GFX_CONFIG_PNG_DECODE_ROW_SIZE
+    static void GFX_ImagePngDraw(
+                                uint16_t left,
+                                uint16_t top,
+                                GFX_RESOURCE_HDR *pImage,
+                                GFX_PARTIAL_IMAGE_PARAM *pPartialImageData);
+    static uint8_t GFX_PngDataByteGet(GFX_INFLATE_STREAM *pStream);
+#endif
+
     uint16_t GFX_TextStringWidthRamGet(
                                 GFX_XCHAR* textString,
                                 GFX_RESOURCE_HDR* pFont);
@@ -292,9 +733,190 @@ typedef union
                                 uint16_t y2,
                                 uint16_t rad);
 
+#ifndef GFX_CONFIG_ALPHABLEND_DISABLE
+    static void GFX_AntiAliasedLineDraw(
+                                int16_t x1,
+                                int16_t y1,
+                                int16_t x2,
+                                int16_t y2,
+                                uint16_t lineThickness);
+#endif
+
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    static GFX_STATUS GFX_DisplayListImageAdd(
+                                uint16_t destination_x,
+                                uint16_t destination_y,
+                                uint16_t source_x_offset,
+                                uint16_t source_y_offset,
+                                uint16_t source_width,
+                                uint16_t source_height,
+                                GFX_RESOURCE_HDR *pImage);
+#endif
+
 
 /*DOM-IGNORE-END*/
 
+#if !defined (GFX_CONFIG_IMAGE_EXTERNAL_DISABLE) || !defined (GFX_CONFIG_FONT_EXTERNAL_DISABLE)
+
+#ifdef GFX_CONFIG_EXTERNAL_CACHE_BLOCKS
+
+// *****************************************************************************
+/*  Function:
+    void GFX_ExternalResourceCacheClear(void)
+
+    Summary:
+        Removes all the blocks from the external resource cache.
+
+    Description:
+        Removes all the blocks from the external resource cache.
+        Blocks are cached by resource pointer and offset. The
+        application must call this function when the contents of
+        the external memory are changed.
+
+*/
+// *****************************************************************************
+void GFX_ExternalResourceCacheClear(void)
+{
+    uint16_t    i;
+
+    for(i = 0; i < GFX_CONFIG_EXTERNAL_CACHE_BLOCKS; i++)
+    {
+        gfxExternalCache[i].pResource = NULL;
+        gfxExternalCache[i].age = 0;
+    }
+    gfxExternalCacheAge = 0;
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_EXTERNAL_CACHE_BLOCK *GFX_ExternalCacheBlockGet(
+                                GFX_RESOURCE_HDR *pResource,
+                                uint32_t offset)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Returns the cached block that holds the given resource offset.
+        When the block is not cached, it replaces the least recently
+        used block and is read with one call to
+        GFX_ExternalResourceCallback(). Returns NULL when the block
+        cannot be read, for example past the end of the external memory.
+
+*/
+// *****************************************************************************
+static GFX_EXTERNAL_CACHE_BLOCK *GFX_ExternalCacheBlockGet(
+                                GFX_RESOURCE_HDR *pResource,
+                                uint32_t offset)
+{
+    GFX_EXTERNAL_CACHE_BLOCK    *pBlock = &gfxExternalCache[0];
+    uint16_t                    i;
+
+    offset -= offset % GFX_CONFIG_EXTERNAL_CACHE_BLOCK_SIZE;
+
+    for(i = 0; i < GFX_CONFIG_EXTERNAL_CACHE_BLOCKS; i++)
+    {
+        if ((gfxExternalCache[i].pResource == pResource) &&
+            (gfxExternalCache[i].offset == offset))
+        {
+            pBlock = &gfxExternalCache[i];
+            break;
+        }
+        if (gfxExternalCache[i].age < pBlock->age)
+            pBlock = &gfxExternalCache[i];
+    }
+
+    if (i == GFX_CONFIG_EXTERNAL_CACHE_BLOCKS)
+    {
+        // the bytes after the requested ones are read ahead
+        if (GFX_ExternalResourceCallback(
+                    pResource,
+                    offset,
+                    GFX_CONFIG_EXTERNAL_CACHE_BLOCK_SIZE,
+                    pBlock->data) != GFX_STATUS_SUCCESS)
+        {
+            pBlock->pResource = NULL;
+            pBlock->age = 0;
+            return (NULL);
+        }
+        pBlock->pResource = pResource;
+        pBlock->offset = offset;
+    }
+
+    if (++gfxExternalCacheAge == 0)
+    {
+        for(i = 0; i < GFX_CONFIG_EXTERNAL_CACHE_BLOCKS; i++)
+            gfxExternalCache[i].age = 0;
+        gfxExternalCacheAge = 1;
+    }
+    pBlock->age = gfxExternalCacheAge;
+
+    return (pBlock);
+}
+
+#endif // #ifdef GFX_CONFIG_EXTERNAL_CACHE_BLOCKS
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_ExternalResourceRead(
+                                GFX_RESOURCE_HDR *pResource,
+                                uint32_t offset,
+                                uint16_t nCount,
+                                void *pBuffer)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Reads data of an external resource for the image and font
+        functions. When GFX_CONFIG_EXTERNAL_CACHE_BLOCKS is defined,
+        reads smaller than a cache block are copied from the cached
+        blocks, otherwise the data is read with
+        GFX_ExternalResourceCallback().
+
+*/
+// *****************************************************************************
+static GFX_STATUS GFX_ExternalResourceRead(
+                                GFX_RESOURCE_HDR *pResource,
+                                uint32_t offset,
+                                uint16_t nCount,
+                                void *pBuffer)
+{
+#ifdef GFX_CONFIG_EXTERNAL_CACHE_BLOCKS
+    GFX_EXTERNAL_CACHE_BLOCK    *pBlock;
+    uint8_t                     *pData = (uint8_t *)pBuffer;
+    uint16_t                    start, count;
+
+    if (nCount < GFX_CONFIG_EXTERNAL_CACHE_BLOCK_SIZE)
+    {
+        while(nCount)
+        {
+            pBlock = GFX_ExternalCacheBlockGet(pResource, offset);
+            if (pBlock == NULL)
+                break;
+
+            start = offset - pBlock->offset;
+            count = GFX_CONFIG_EXTERNAL_CACHE_BLOCK_SIZE - start;
+            if (count > nCount)
+                count = nCount;
+
+            for(nCount -= count, offset += count; count > 0; count--)
+                *pData++ = pBlock->data[start++];
+        }
+
+        if (nCount == 0)
+            return (GFX_STATUS_SUCCESS);
+        pBuffer = pData;
+    }
+#endif
+
+    return (GFX_ExternalResourceCallback(pResource, offset, nCount, pBuffer));
+}
+
+#endif // #if !defined (GFX_CONFIG_IMAGE_EXTERNAL_DISABLE) || ...
+
 // *****************************************************************************
 /*  Function:
     GFX_COLOR *GFX_RenderingBufferGet(void)
@@ -366,6 +988,8 @@ inline GFX_STATUS_BIT __attribute__ ((always_inline)) GFX_RenderStatusCheck()
         - GFX_LINE_STYLE_THICK_SOLID
         - GFX_LINE_STYLE_THICK_DOTTED
         - GFX_LINE_STYLE_THICK_DASHED
+        - GFX_LINE_STYLE_ANTI_ALIASED
+        - GFX_LINE_STYLE_THICK_ANTI_ALIASED
         GFX_FILL_STYLE
         - GFX_FILL_STYLE_COLOR
         will be rendered using the set color.
@@ -377,7 +1001,7 @@ inline GFX_STATUS_BIT __attribute__ ((always_inline)) GFX_RenderStatusCheck()
 // *****************************************************************************
 inline void __attribute__ ((always_inline)) GFX_ColorSet(GFX_COLOR newColor)
 {
-    gfxColor = newColor;
+    pGfxContext->color = newColor;
 }
 
 // *****************************************************************************
@@ -396,7 +1020,7 @@ inline void __attribute__ ((always_inline)) GFX_ColorSet(GFX_COLOR newColor)
 // *****************************************************************************
 inline GFX_COLOR __attribute__ ((always_inline)) GFX_ColorGet()
 {
-    return (gfxColor);
+    return (pGfxContext->color);
 }
 
 // *****************************************************************************
@@ -424,8 +1048,8 @@ inline GFX_COLOR __attribute__ ((always_inline)) GFX_ColorGet()
 inline GFX_STATUS __attribute__ ((always_inline)) GFX_TransparentColorEnable(
                                 GFX_COLOR color)
 {
-    gfxColorTransparent     = color;
-    gfxColorTransparentFlag = GFX_FEATURE_ENABLED;
+    pGfxContext->colorTransparent     = color;
+    pGfxContext->colorTransparentFlag = GFX_FEATURE_ENABLED;
     return (GFX_STATUS_SUCCESS);
 }
 
@@ -448,7 +1072,7 @@ inline GFX_STATUS __attribute__ ((always_inline)) GFX_TransparentColorEnable(
 // *****************************************************************************
 inline GFX_STATUS __attribute__ ((always_inline)) GFX_TransparentColorDisable(void)
 {
-    gfxColorTransparentFlag = GFX_FEATURE_DISABLED;
+    pGfxContext->colorTransparentFlag = GFX_FEATURE_DISABLED;
     return (GFX_STATUS_SUCCESS);
 }
 
@@ -473,7 +1097,7 @@ inline GFX_STATUS __attribute__ ((always_inline)) GFX_TransparentColorDisable(vo
 // *****************************************************************************
 inline GFX_COLOR __attribute__ ((always_inline)) GFX_TransparentColorGet(void)
 {
-    return (gfxColorTransparent);
+    return (pGfxContext->colorTransparent);
 }
 
 // *****************************************************************************
@@ -496,7 +1120,7 @@ inline GFX_COLOR __attribute__ ((always_inline)) GFX_TransparentColorGet(void)
 // *****************************************************************************
 inline GFX_FEATURE_STATUS __attribute__ ((always_inline)) GFX_TransparentColorStatusGet(void)
 {
-    return (gfxColorTransparentFlag);
+    return (pGfxContext->colorTransparentFlag);
 }
 
 // *****************************************************************************
@@ -517,7 +1141,7 @@ inline GFX_FEATURE_STATUS __attribute__ ((always_inline)) GFX_TransparentColorSt
 // *****************************************************************************
 inline void __attribute__ ((always_inline)) GFX_TextAreaLeftSet(uint16_t left)
 {
-    gfxTextClipLeft = left;
+    pGfxContext->textClipLeft = left;
 }
 
 // *****************************************************************************
@@ -538,7 +1162,7 @@ inline void __attribute__ ((always_inline)) GFX_TextAreaLeftSet(uint16_t left)
 // *****************************************************************************
 inline void __attribute__ ((always_inline)) GFX_TextAreaTopSet(uint16_t top)
 {
-    gfxTextClipTop = top;
+    pGfxContext->textClipTop = top;
 }
 
 // *****************************************************************************
@@ -559,7 +1183,7 @@ inline void __attribute__ ((always_inline)) GFX_TextAreaTopSet(uint16_t top)
 // *****************************************************************************
 inline void __attribute__ ((always_inline)) GFX_TextAreaRightSet(uint16_t right)
 {
-    gfxTextClipRight = right;
+    pGfxContext->textClipRight = right;
 }
 
 // *****************************************************************************
@@ -582,7 +1206,7 @@ inline void __attribute__ ((always_inline)) GFX_TextAreaRightSet(uint16_t right)
 inline void __attribute__ ((always_inline)) GFX_TextAreaBottomSet(
                                 uint16_t bottom)
 {
-    gfxTextClipBottom = bottom;
+    pGfxContext->textClipBottom = bottom;
 }
 
 // *****************************************************************************
@@ -603,7 +1227,7 @@ inline void __attribute__ ((always_inline)) GFX_TextAreaBottomSet(
 // *****************************************************************************
 inline uint16_t __attribute__ ((always_inline)) GFX_TextAreaLeftGet(void)
 {
-    return (gfxTextClipLeft);
+    return (pGfxContext->textClipLeft);
 }
 
 // *****************************************************************************
@@ -624,7 +1248,7 @@ inline uint16_t __attribute__ ((always_inline)) GFX_TextAreaLeftGet(void)
 // *****************************************************************************
 inline uint16_t __attribute__ ((always_inline)) GFX_TextAreaTopGet(void)
 {
-    return (gfxTextClipTop);
+    return (pGfxContext->textClipTop);
 }
 
 // *****************************************************************************
@@ -645,7 +1269,7 @@ inline uint16_t __attribute__ ((always_inline)) GFX_TextAreaTopGet(void)
 // *****************************************************************************
 inline uint16_t __attribute__ ((always_inline)) GFX_TextAreaRightGet(void)
 {
-    return (gfxTextClipRight);
+    return (pGfxContext->textClipRight);
 }
 
 // *****************************************************************************
@@ -666,61 +1290,371 @@ inline uint16_t __attribute__ ((always_inline)) GFX_TextAreaRightGet(void)
 // *****************************************************************************
 inline uint16_t __attribute__ ((always_inline)) GFX_TextAreaBottomGet(void)
 {
-    return (gfxTextClipBottom);
+    return (pGfxContext->textClipBottom);
 }
 
 
-#ifndef GFX_CONFIG_ALPHABLEND_DISABLE
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
 
 // *****************************************************************************
 /*  Function:
-    GFX_STATUS GFX_AlphaBlendingValueSet(
-                                uint16_t alpha)
+    GFX_STATUS GFX_ClipPush(
+                                uint16_t left,
+                                uint16_t top,
+                                uint16_t right,
+                                uint16_t bottom)
 
     Summary:
-        This function sets the alpha value for alpha blending rendering.
+        Saves the clip rectangle and limits it to the given area.
 
     Description:
-        This function sets the alpha value for alpha blending rendering.
-        Accepted values are dependent on the used alpha blending routines
-        at build time. When using the software routines in the Primitive
-        Layer, accepted values are 0, 25, 50, 75 and 100.
-
-        If using a specific implementation in the display driver used,
-        implementation may support the full range (0-100). When this is
-        the case, refer to the driver alpha blending solution for details.
-
-        Function operation will ignore unsupported values of alpha.
+        This function saves the current clip rectangle on the clip
+        stack of the active context and sets the clip rectangle to
+        the part of the current clip rectangle inside the given area.
+        The previous clip rectangle is restored with GFX_ClipPop().
+        GFX_STATUS_FAILURE is returned when the stack is full.
 
 */
 // *****************************************************************************
-GFX_STATUS __attribute__ ((weak)) GFX_AlphaBlendingValueSet(
-                                uint16_t alpha)
+GFX_STATUS GFX_ClipPush(
+                                uint16_t left,
+                                uint16_t top,
+                                uint16_t right,
+                                uint16_t bottom)
 {
-    gfxAlphaValue = alpha;
+    GFX_RECTANGULAR_AREA *pClip = &(pGfxContext->clip);
+
+    if (pGfxContext->clipCount >= GFX_CONFIG_CLIP_STACK_SIZE)
+        return (GFX_STATUS_FAILURE);
+
+    pGfxContext->clipStack[pGfxContext->clipCount++] = *pClip;
+
+    // an empty clip rectangle (left > right or top > bottom) hides all
+    if (pClip->left < left)
+        pClip->left = left;
+    if (pClip->top < top)
+        pClip->top = top;
+    if (pClip->right > right)
+        pClip->right = right;
+    if (pClip->bottom > bottom)
+        pClip->bottom = bottom;
+
     return (GFX_STATUS_SUCCESS);
 }
 
 // *****************************************************************************
 /*  Function:
-    uint16_t GFX_AlphaBlendingValueGet()
+    GFX_STATUS GFX_ClipPop(void)
 
     Summary:
-        This function returns the current alpha value set for
-        alpha blending rendering.
+        Restores the clip rectangle saved by GFX_ClipPush().
 
     Description:
-        This function returns the current alpha value set for
-        alpha blending rendering. See GFX_AlphaBlendingValueSet() for
+        This function restores the clip rectangle saved by the last
+        call to GFX_ClipPush(). GFX_STATUS_FAILURE is returned when the
+        stack is empty.
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_ClipPop(void)
+{
+    if (pGfxContext->clipCount == 0)
+        return (GFX_STATUS_FAILURE);
+
+    pGfxContext->clip = pGfxContext->clipStack[--pGfxContext->clipCount];
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_RECTANGULAR_AREA *GFX_ClipGet(void)
+
+    Summary:
+        Returns the current clip rectangle.
+
+    Description:
+        This function returns the clip rectangle of the active context.
+        The rectangle is empty when its left is greater than its right
+        or its top is greater than its bottom.
+
+*/
+// *****************************************************************************
+inline GFX_RECTANGULAR_AREA * __attribute__ ((always_inline)) GFX_ClipGet(void)
+{
+    return (&(pGfxContext->clip));
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_ClipAreaAdjust(
+                                uint16_t *pLeft,
+                                uint16_t *pTop,
+                                uint16_t *pRight,
+                                uint16_t *pBottom)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Limits the given area to the clip rectangle. Returns
+        GFX_STATUS_FAILURE when no part of the area is inside the
+        clip rectangle.
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_ClipAreaAdjust(
+                                uint16_t *pLeft,
+                                uint16_t *pTop,
+                                uint16_t *pRight,
+                                uint16_t *pBottom)
+{
+    GFX_RECTANGULAR_AREA *pClip = &(pGfxContext->clip);
+
+    if (*pLeft < pClip->left)
+        *pLeft = pClip->left;
+    if (*pTop < pClip->top)
+        *pTop = pClip->top;
+    if (*pRight > pClip->right)
+        *pRight = pClip->right;
+    if (*pBottom > pClip->bottom)
+        *pBottom = pClip->bottom;
+
+    if ((*pLeft > *pRight) || (*pTop > *pBottom))
+        return (GFX_STATUS_FAILURE);
+
+    return (GFX_STATUS_SUCCESS);
+}
+
+#endif // #ifdef GFX_CONFIG_CLIP_STACK_SIZE
+
+// *****************************************************************************
+/*  Function:
+    void GFX_ClippedPixelPut(uint16_t x, uint16_t y)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Renders the pixel with GFX_PixelPut() when it is inside the
+        clip rectangle.
+
+*/
+// *****************************************************************************
+static inline void __attribute__ ((always_inline)) GFX_ClippedPixelPut(
+                                uint16_t x,
+                                uint16_t y)
+{
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+    if ((x < pGfxContext->clip.left)  || (x > pGfxContext->clip.right) ||
+        (y < pGfxContext->clip.top)   || (y > pGfxContext->clip.bottom))
+        return;
+#endif
+    GFX_PixelPut(x, y);
+}
+
+
+#ifndef GFX_CONFIG_ALPHABLEND_DISABLE
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_AlphaBlendingValueSet(
+                                uint16_t alpha)
+
+    Summary:
+        This function sets the alpha value for alpha blending rendering.
+
+    Description:
+        This function sets the alpha value for alpha blending rendering.
+        Accepted values are dependent on the used alpha blending routines
+        at build time. When using the software routines in the Primitive
+        Layer, accepted values are 0, 25, 50, 75 and 100.
+
+        If using a specific implementation in the display driver used,
+        implementation may support the full range (0-100). When this is
+        the case, refer to the driver alpha blending solution for details.
+
+        Function operation will ignore unsupported values of alpha.
+
+*/
+// *****************************************************************************
+GFX_STATUS __attribute__ ((weak)) GFX_AlphaBlendingValueSet(
+                                uint16_t alpha)
+{
+    pGfxContext->alphaValue = alpha;
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    uint16_t GFX_AlphaBlendingValueGet()
+
+    Summary:
+        This function returns the current alpha value set for
+        alpha blending rendering.
+
+    Description:
+        This function returns the current alpha value set for
+        alpha blending rendering. See GFX_AlphaBlendingValueSet() for
         details of alpha blending values.
 
 */
 // *****************************************************************************
 uint16_t __attribute__ ((weak)) GFX_AlphaBlendingValueGet(void)
 {
-    return (gfxAlphaValue);
+    return (pGfxContext->alphaValue);
+}
+
+
+// *****************************************************************************
+/*  Function:
+    void GFX_AlphaLineBlend(
+                                GFX_COLOR *pPixel,
+                                GFX_COLOR color,
+                                uint16_t alpha,
+                                uint16_t width)
+
+    Summary:
+        Blends a color into a line of pixels.
+
+    Description:
+        This function blends the given color with the given alpha
+        value (in percent, 1 to 99) into a line of width pixels.
+
+        The 25, 50 and 75 percent values use the GFX_ColorXXConvert()
+        macros when these are available for the color depth. Other
+        values are blended with a weight of 1/32 steps (1/256 steps at
+        24 bpp). The color channels of a pixel are spread into one
+        32 bit word so all the channels are blended with a single
+        multiplication.
+
+*/
+// *****************************************************************************
+static void GFX_AlphaLineBlend(
+                                GFX_COLOR *pPixel,
+                                GFX_COLOR color,
+                                uint16_t alpha,
+                                uint16_t width)
+{
+    uint32_t    fg, bg, weight;
+#if (GFX_CONFIG_COLOR_DEPTH == 24)
+    uint32_t    fgG, bgG;
+#endif
+
+#ifdef GFX_Color50Convert
+    switch(alpha)
+    {
+        case 25:
+            fg = GFX_Color25Convert(color);
+            while(width--)
+            {
+                *pPixel = GFX_Color75Convert(*pPixel) + fg;
+                pPixel++;
+            }
+            return;
+        case 50:
+            fg = GFX_Color50Convert(color);
+            while(width--)
+            {
+                *pPixel = GFX_Color50Convert(*pPixel) + fg;
+                pPixel++;
+            }
+            return;
+        case 75:
+            fg = GFX_Color75Convert(color);
+            while(width--)
+            {
+                *pPixel = GFX_Color25Convert(*pPixel) + fg;
+                pPixel++;
+            }
+            return;
+        default:
+            break;
+    }
+#endif
+
+#if (GFX_CONFIG_COLOR_DEPTH == 24)
+
+    // 0x00RRGGBB: red and blue are blended in one word, green in another
+    weight = (((uint32_t)alpha << 8) + 50) / 100;
+    fg  = (color & 0x00FF00FFul) * weight;
+    fgG = (color & 0x0000FF00ul) * weight;
+    weight = 256 - weight;
+    while(width--)
+    {
+        bg  = *pPixel & 0x00FF00FFul;
+        bgG = *pPixel & 0x0000FF00ul;
+        *pPixel++ = (GFX_COLOR)(
+                    (((fg  + bg  * weight) >> 8) & 0x00FF00FFul) |
+                    (((fgG + bgG * weight) >> 8) & 0x0000FF00ul));
+    }
+
+#else
+
+    weight = (((uint32_t)alpha << 5) + 50) / 100;
+
+#if (GFX_CONFIG_COLOR_DEPTH == 16)
+    // RGB565 is spread to 00000GGGGGG00000RRRRR000000BBBBB
+    #define GFX_ALPHA_SPREAD(c)     ((((uint32_t)(c) << 16) | (c)) & 0x07E0F81Ful)
+    #define GFX_ALPHA_PACK(c)       (GFX_COLOR)(((c) >> 16) | ((c) & 0xFFFF))
+    #define GFX_ALPHA_MASK          0x07E0F81Ful
+#elif (GFX_CONFIG_COLOR_DEPTH == 8)
+    // RGB332 is spread to RRR00000000GGG00000000BB
+    #define GFX_ALPHA_SPREAD(c)     ((((uint32_t)(c) & 0xE0) << 16) | (((uint32_t)(c) & 0x1C) << 8) | ((c) & 0x03))
+    #define GFX_ALPHA_PACK(c)       (GFX_COLOR)((((c) >> 16) & 0xE0) | (((c) >> 8) & 0x1C) | ((c) & 0x03))
+    #define GFX_ALPHA_MASK          0x00E01C03ul
+#else
+    // gray scale levels
+    #define GFX_ALPHA_SPREAD(c)     ((uint32_t)(c))
+    #define GFX_ALPHA_PACK(c)       (GFX_COLOR)(c)
+    #define GFX_ALPHA_MASK          0x000000FFul
+#endif
+
+    fg = GFX_ALPHA_SPREAD(color) * weight;
+    weight = 32 - weight;
+    while(width--)
+    {
+        bg = GFX_ALPHA_SPREAD(*pPixel);
+        bg = ((fg + bg * weight) >> 5) & GFX_ALPHA_MASK;
+        *pPixel++ = GFX_ALPHA_PACK(bg);
+    }
+
+    #undef GFX_ALPHA_SPREAD
+    #undef GFX_ALPHA_PACK
+    #undef GFX_ALPHA_MASK
+
+#endif
 }
 
+// *****************************************************************************
+/*  Function:
+    void GFX_AlphaImageLineBlend(
+                                uint16_t x,
+                                uint16_t y,
+                                GFX_COLOR *pLine,
+                                uint16_t width)
+
+    Summary:
+        Blends the current color into a line of the background image.
+
+    Description:
+        This function is the GFX_IMAGE_LINE_CALLBACK used by
+        GFX_BarAlphaDraw() to blend the current color with the
+        current alpha value into each decoded line of the background
+        image and render the blended line.
+
+*/
+// *****************************************************************************
+static void GFX_AlphaImageLineBlend(
+                                uint16_t x,
+                                uint16_t y,
+                                GFX_COLOR *pLine,
+                                uint16_t width)
+{
+    GFX_AlphaLineBlend(pLine, GFX_ColorGet(), GFX_AlphaBlendingValueGet(), width);
+    GFX_PixelArrayPut(x, y, pLine, width);
+}
 
 // *****************************************************************************
 /*  Function:
@@ -755,6 +1689,13 @@ uint16_t __attribute__ ((weak)) GFX_AlphaBlendingValueGet(void)
 
         The background type is set by the GFX_BackgroundTypeSet().
 
+        The bar is rendered one line at a time. Each line of the
+        background is blended by GFX_AlphaLineBlend() and rendered
+        with GFX_PixelArrayPut(). Since a background color gives the
+        same blended line for all the lines, it is blended only once.
+        A background image is decoded in one pass by
+        GFX_ImagePartialLinesGet() when the image type allows it.
+
         The rendering of this shape becomes undefined when any one of the
         following is true:
         - Any of the following pixel locations left,top or right,bottom
@@ -775,126 +1716,104 @@ uint16_t __attribute__((weak)) GFX_BarAlphaDraw(
 {
 
     int16_t             bgxOffset, bgyOffset;
-    uint16_t            x, y, width, fgFromBuffer;
-    GFX_COLOR           fgPixel, bgPixel = 0x00;
-    GFX_COLOR           *pBuffer = NULL, *pPixel = NULL;
+    uint16_t            x, y, width, alpha;
+    GFX_COLOR           *pBuffer;
     GFX_RESOURCE_HDR    *pImage = NULL;
+    GFX_BACKGROUND_TYPE backgroundType;
 
-    if (GFX_AlphaBlendingValueGet() == 0)
+    alpha = GFX_AlphaBlendingValueGet();
+    if (alpha == 0)
     {
         // if alpha is 0, then do nothing
         return (GFX_STATUS_SUCCESS);
     }
-    else if (GFX_AlphaBlendingValueGet() != 100)
+
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+    // only the part of the bar in the clip rectangle is rendered
+    if (GFX_ClipAreaAdjust(&left, &top, &right, &bottom) == GFX_STATUS_FAILURE)
+        return (GFX_STATUS_SUCCESS);
+#endif
+
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // the recorded commands are drawn before the pixels are read or written
+    GFX_DisplayListFlush();
+#endif
+
+    bgxOffset = 0;
+    bgyOffset = 0;
+    width   = (uint16_t)(right - left) + 1;
+    pBuffer = GFX_RenderingBufferGet();
+
+    backgroundType = GFX_BackgroundTypeGet();
+    if (alpha >= 100)
+        backgroundType = GFX_BACKGROUND_NONE;
+
+    switch (backgroundType)
     {
-        bgxOffset = 0;
-        bgyOffset = 0;
-    
-        switch (GFX_BackgroundTypeGet())
+        case GFX_BACKGROUND_COLOR:
+            // all the lines are the same, blend the line only once
+            for(x = 0; x < width; x++)
+                pBuffer[x] = GFX_BackgroundColorGet();
+            GFX_AlphaLineBlend(pBuffer, GFX_ColorGet(), alpha, width);
+            break;
+        case GFX_BACKGROUND_IMAGE:
+            pImage = GFX_BackgroundImageGet();
+            // note that the assumption here is that the background image is larger and 
+            // the bar location is within the image on the screen.
+            bgxOffset =  left - GFX_BackgroundImageLeftGet();
+            bgyOffset =  top  - GFX_BackgroundImageTopGet();
+
+            // decode all the lines in one pass, each line is blended and
+            // rendered by GFX_AlphaImageLineBlend()
+            if (GFX_ImagePartialLinesGet(
+                        left, top,
+                        bgxOffset, bgyOffset,
+                        width, (bottom - top) + 1,
+                        pImage,
+                        GFX_AlphaImageLineBlend) == GFX_STATUS_SUCCESS)
+            {
+                return (GFX_STATUS_SUCCESS);
+            }
+            break;
+        case GFX_BACKGROUND_DISPLAY_BUFFER:
+            break;
+        case GFX_BACKGROUND_NONE:
+        default: 
+            // no background to blend with, render the color
+            backgroundType = GFX_BACKGROUND_NONE;
+            for(x = 0; x < width; x++)
+                pBuffer[x] = GFX_ColorGet();
+            break;
+    }
+
+    // process one line at a time to perform alpha blending 
+    for(y = top; y <= bottom; y++)
+    {
+        switch (backgroundType)
         {
-            case GFX_BACKGROUND_COLOR:
-                bgPixel = GFX_BackgroundColorGet();
-                pBuffer = GFX_RenderingBufferGet();
-                fgFromBuffer = 0;
-                break;
             case GFX_BACKGROUND_IMAGE:
-                pImage = GFX_BackgroundImageGet();
-                // note that the assumption here is that the background image is larger and 
-                // the bar location is within the image on the screen.
-                bgxOffset =  left - GFX_BackgroundImageLeftGet();
-                bgyOffset =  top  - GFX_BackgroundImageTopGet();
-                pBuffer = GFX_RenderingBufferGet();
-                fgFromBuffer = 1;
+                // GFX_ImagePartialDraw() will renders the current line of the image into the buffer (gfxLineBuffer0)
+                GFX_RenderToDisplayBufferDisable();
+                GFX_ImagePartialDraw(
+                        left, y,
+                        bgxOffset, bgyOffset,
+                        width, 1,
+                        pImage);
+                GFX_RenderToDisplayBufferEnable();
+                bgyOffset++; 
+                GFX_AlphaLineBlend(pBuffer, GFX_ColorGet(), alpha, width);
                 break;
             case GFX_BACKGROUND_DISPLAY_BUFFER:
-                pBuffer = GFX_RenderingBufferGet();
-                fgFromBuffer = 1;
+                // grab the current line from the display buffer
+                GFX_PixelArrayGet(left, y, pBuffer, width);
+                GFX_AlphaLineBlend(pBuffer, GFX_ColorGet(), alpha, width);
                 break;
-            case GFX_BACKGROUND_NONE:
             default: 
-                bgPixel = 0x00;
-                fgFromBuffer = 0;
-                break;
-        }
- 
-        // pre calculate the foreground color since this is faster
-        switch(GFX_AlphaBlendingValueGet())
-        {
-            case 50:
-                fgPixel = GFX_Color50Convert(GFX_ColorGet());
-                break;
-            case 25:
-                fgPixel = GFX_Color25Convert(GFX_ColorGet());
-                break;
-            case 75:
-                fgPixel = GFX_Color75Convert(GFX_ColorGet());
-                break;
-            default:
-                fgPixel = 0;
+                // the line is already in the buffer
                 break;
         }
-
-        width   = (uint16_t)(right - left) + 1;
-
-        // process one line at a time to perform alpha blending 
-        for(y = top; y <= bottom; y++)
-        {
-
-            switch (GFX_BackgroundTypeGet())
-            {
-                case GFX_BACKGROUND_COLOR:
-                    // do nothing, background pixel is already set
-                    break;
-                case GFX_BACKGROUND_IMAGE:
-                    // GFX_ImagePartialDraw() will renders the current line of the image into the buffer (gfxLineBuffer0)
-                    GFX_RenderToDisplayBufferDisable();
-                    GFX_ImagePartialDraw(
-                            left, y,
-                            bgxOffset, bgyOffset,
-                            width, 1,
-                            pImage);
-                    GFX_RenderToDisplayBufferEnable();
-                    bgyOffset++; 
-                    break;
-                case GFX_BACKGROUND_DISPLAY_BUFFER:
-                    // grab the current line from the display buffer
-                    GFX_PixelArrayGet(left, y, pBuffer, width);
-                    break;
-                case GFX_BACKGROUND_NONE:
-                default: 
-                    // do nothing here
-                    break;
-            }
-
-            pPixel = pBuffer;
-            for(x = 0; x < width; x++)
-            {
-                if (fgFromBuffer)
-                {
-                    bgPixel = *pPixel;
-                }
-
-                switch(GFX_AlphaBlendingValueGet())
-                {
-                    case 50: 
-                        *pPixel = GFX_Color50Convert(bgPixel);
-                        break;
-                    case 25: 
-                        *pPixel = GFX_Color75Convert(bgPixel);
-                        break;
-                    case 75: 
-                        *pPixel = GFX_Color25Convert(bgPixel);
-                        break;
-                    default: 
-                        // unsupported alpha level don't do anything
-                        return 1;
-                } 
-                *pPixel += fgPixel;
-                pPixel++;
-            } // end of for loop...
-            GFX_PixelArrayPut(left, y, pBuffer, width);
-        }   
-    }
+        GFX_PixelArrayPut(left, y, pBuffer, width);
+    }   
     return (GFX_STATUS_SUCCESS);
 
 }
@@ -958,6 +1877,17 @@ GFX_STATUS __attribute__((weak)) GFX_BarDraw(
 {
     uint16_t   x, y;
 
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+    // only the part of the bar in the clip rectangle is rendered
+    if (GFX_ClipAreaAdjust(&left, &top, &right, &bottom) == GFX_STATUS_FAILURE)
+        return (GFX_STATUS_SUCCESS);
+#endif
+
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    if (GFX_DisplayListBarAdd(left, top, right, bottom) == GFX_STATUS_SUCCESS)
+        return (GFX_STATUS_SUCCESS);
+#endif
+
     if (GFX_RenderStatusCheck() == GFX_STATUS_BUSY_BIT)
         return (GFX_STATUS_FAILURE);
 
@@ -1001,7 +1931,7 @@ GFX_STATUS __attribute__((weak)) GFX_BarDraw(
 inline GFX_STATUS __attribute__ ((always_inline)) GFX_LineStyleSet(
                                 GFX_LINE_STYLE style)
 {
-    gfxLineStyle = style;
+    pGfxContext->lineStyle = style;
     return GFX_STATUS_SUCCESS;
 }
 
@@ -1020,7 +1950,7 @@ inline GFX_STATUS __attribute__ ((always_inline)) GFX_LineStyleSet(
 // *****************************************************************************
 inline GFX_LINE_STYLE __attribute__ ((always_inline)) GFX_LineStyleGet(void)
 {
-    return gfxLineStyle;
+    return pGfxContext->lineStyle;
 }
 
 // *****************************************************************************
@@ -1055,6 +1985,38 @@ GFX_STATUS __attribute__((weak)) GFX_LineDraw(
 
     GFX_STATUS status;
 
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+    // a line outside the clip rectangle is not rendered, thick lines
+    // are one pixel wider on each side
+    if ((((x1 > x2) ? x1 : x2) + 1 < GFX_ClipGet()->left)  ||
+        (((x1 < x2) ? x1 : x2) > GFX_ClipGet()->right + 1) ||
+        (((y1 > y2) ? y1 : y2) + 1 < GFX_ClipGet()->top)   ||
+        (((y1 < y2) ? y1 : y2) > GFX_ClipGet()->bottom + 1))
+    {
+        GFX_LinePositionSet(x2, y2);
+        return (GFX_STATUS_SUCCESS);
+    }
+#endif
+
+#ifndef GFX_CONFIG_ALPHABLEND_DISABLE
+    // anti-aliased diagonal lines are rendered here and not by
+    // GFX_SolidLineDraw(), which can be replaced by the driver
+    if ((GFX_LineStyleGet() & GFX_LINE_ANTIALIAS_MASK) &&
+        (x1 != x2) && (y1 != y2))
+    {
+        // the line is rendered in one call once the hardware is idle
+        if (GFX_RenderStatusGet() == GFX_STATUS_BUSY_BIT)
+            return (GFX_STATUS_FAILURE);
+
+        // lines do not support alpha blending
+        GFX_AlphaBlendingValueSet(100);
+        GFX_AntiAliasedLineDraw(x1, y1, x2, y2,
+                (GFX_LineStyleGet() & GFX_LINE_THICKNESS_MASK));
+        GFX_LinePositionSet(x2, y2);
+        return (GFX_STATUS_SUCCESS);
+    }
+#endif
+
     if ((GFX_LineStyleGet() & GFX_LINE_TYPE_MASK) == 0)
         status = GFX_SolidLineDraw(x1, y1, x2, y2);
     else
@@ -1148,7 +2110,7 @@ GFX_STATUS __attribute__ ((always_inline)) GFX_LineToDraw(
 // *****************************************************************************
 int16_t __attribute__ ((always_inline)) GFX_LinePositionXGet(void)
 {
-    return gfxLineCursorX;
+    return pGfxContext->lineCursorX;
 }
 
 // *****************************************************************************
@@ -1167,7 +2129,7 @@ int16_t __attribute__ ((always_inline)) GFX_LinePositionXGet(void)
 // *****************************************************************************
 int16_t __attribute__ ((always_inline)) GFX_LinePositionYGet(void)
 {
-    return gfxLineCursorY;
+    return pGfxContext->lineCursorY;
 }
 
 // *****************************************************************************
@@ -1194,8 +2156,8 @@ GFX_STATUS __attribute__ ((always_inline)) GFX_LinePositionSet(
                                 uint16_t x,
                                 uint16_t y)
 {
-    gfxLineCursorX = x;
-    gfxLineCursorY = y;
+    pGfxContext->lineCursorX = x;
+    pGfxContext->lineCursorY = y;
     return (GFX_STATUS_SUCCESS);
 }
 
@@ -1231,68 +2193,437 @@ GFX_STATUS __attribute__ ((always_inline)) GFX_LinePositionRelativeSet(
                                 int16_t dX,
                                 int16_t dY)
 {
-    gfxLineCursorX += dX;
-    gfxLineCursorY += dY;
+    pGfxContext->lineCursorX += dX;
+    pGfxContext->lineCursorY += dY;
     return (GFX_STATUS_SUCCESS);
 }
 
 
 // *****************************************************************************
 /*  Function:
-    GFX_STATUS GFX_SolidLineDraw(
-                                uint16_t x1,
-                                uint16_t y1,
-                                uint16_t x2,
-                                uint16_t y2)
+    GFX_STATUS GFX_SpanBarDraw(
+                                int16_t left,
+                                int16_t top,
+                                int16_t right,
+                                int16_t bottom)
 
     Summary:
-        This function renders the thin and thick solid line.
-        This is an internal function and should not be called by the application.
+        This function is an internal function and should not
+        be called by the application.
 
     Description:
-        This function renders the thin and thick solid lines
-        (see GFX_LINE_STYLE).
+        Renders a run of pixels of a line or outline with GFX_BarDraw().
+        Thick and anti-aliased shapes reach one or two pixels past their
+        points, the part of the run outside the screen is not rendered.
 
 */
 // *****************************************************************************
-GFX_STATUS __attribute__((weak)) GFX_SolidLineDraw(
-                                uint16_t x1,
-                                uint16_t y1,
-                                uint16_t x2,
-                                uint16_t y2)
+static GFX_STATUS GFX_SpanBarDraw(
+                                int16_t left,
+                                int16_t top,
+                                int16_t right,
+                                int16_t bottom)
+{
+    if (left < 0)
+        left = 0;
+    if (top < 0)
+        top = 0;
+    if (right > (int16_t)GFX_MaxXGet())
+        right = GFX_MaxXGet();
+    if (bottom > (int16_t)GFX_MaxYGet())
+        bottom = GFX_MaxYGet();
+
+    if ((left > right) || (top > bottom))
+        return (GFX_STATUS_SUCCESS);
+
+    return (GFX_BarDraw(left, top, right, bottom));
+}
+
+// *****************************************************************************
+/*  Function:
+    void GFX_SolidLineRunPush(
+                                GFX_SOLID_LINE_DRAW_PARAM *pState,
+                                uint16_t valid)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Adds the run of pixels walked on the current row to the last
+        runs of the line. An empty run is added when valid is 0, this
+        renders the rows after the end of a thick line.
+
+*/
+// *****************************************************************************
+static void GFX_SolidLineRunPush(
+                                GFX_SOLID_LINE_DRAW_PARAM *pState,
+                                uint16_t valid)
+{
+    pState->spanFirst[2] = pState->spanFirst[1];
+    pState->spanLast[2]  = pState->spanLast[1];
+    pState->spanFirst[1] = pState->spanFirst[0];
+    pState->spanLast[1]  = pState->spanLast[0];
+    pState->spanFirst[0] = pState->runFirst;
+    pState->spanLast[0]  = pState->runLast;
+    pState->spanValid    = ((pState->spanValid << 1) | valid) & 0x07;
+
+    if (valid)
+        pState->spanRow = pState->runRow;
+    else
+        pState->spanRow += pState->stepY;
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_SolidLineSpanDraw(
+                                GFX_SOLID_LINE_DRAW_PARAM *pState)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Renders the pixels of a row of the line as one bar. A thin line
+        renders the newest run. A row of a thick line also covers the
+        runs of the rows next to it, the row before the newest run is
+        rendered.
+
+*/
+// *****************************************************************************
+static GFX_STATUS GFX_SolidLineSpanDraw(
+                                GFX_SOLID_LINE_DRAW_PARAM *pState)
+{
+    int16_t     first = 0x7FFF, last = -0x7FFF, row;
+    uint16_t    i, count;
+
+    count = (pState->lineThickness) ? 3 : 1;
+    for(i = 0; i < count; i++)
+    {
+        if ((pState->spanValid & (1 << i)) == 0)
+            continue;
+        if (first > pState->spanFirst[i])
+            first = pState->spanFirst[i];
+        if (first > pState->spanLast[i])
+            first = pState->spanLast[i];
+        if (last < pState->spanFirst[i])
+            last = pState->spanFirst[i];
+        if (last < pState->spanLast[i])
+            last = pState->spanLast[i];
+    }
+
+    if (first > last)
+        return (GFX_STATUS_SUCCESS);
+
+    row = pState->spanRow;
+    if (pState->lineThickness)
+        row -= pState->stepY;
+
+    // the runs of steep lines are columns
+    if (pState->steep)
+        return (GFX_SpanBarDraw(row, first, row, last));
+    else
+        return (GFX_SpanBarDraw(first, row, last, row));
+}
+
+#ifndef GFX_CONFIG_ALPHABLEND_DISABLE
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_CoverageRowGet(
+                                int16_t *pLeft,
+                                int16_t *pRight,
+                                int16_t y)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Limits a run of anti-aliased pixels to the screen and to the
+        clip rectangle and reads the pixels of the run into the line
+        buffer. Returns GFX_STATUS_FAILURE when no pixel of the run
+        is visible.
+
+*/
+// *****************************************************************************
+static GFX_STATUS GFX_CoverageRowGet(
+                                int16_t *pLeft,
+                                int16_t *pRight,
+                                int16_t y)
+{
+    uint16_t    left, top, right, bottom;
+
+    if ((y < 0) || (y > (int16_t)GFX_MaxYGet()))
+        return (GFX_STATUS_FAILURE);
+    if (*pLeft < 0)
+        *pLeft = 0;
+    if (*pRight > (int16_t)GFX_MaxXGet())
+        *pRight = GFX_MaxXGet();
+    if (*pLeft > *pRight)
+        return (GFX_STATUS_FAILURE);
+
+    left = *pLeft;
+    right = *pRight;
+    top = bottom = y;
+
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+    if (GFX_ClipAreaAdjust(&left, &top, &right, &bottom) == GFX_STATUS_FAILURE)
+        return (GFX_STATUS_FAILURE);
+    *pLeft = left;
+    *pRight = right;
+#endif
+
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // the recorded commands are drawn before the pixels are read
+    GFX_DisplayListFlush();
+#endif
+
+    GFX_PixelArrayGet(left, top, gfxLineBuffer0, right - left + 1);
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    void GFX_CoveragePixelBlend(
+                                GFX_COLOR *pPixel,
+                                uint16_t coverage)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Blends the current color into the pixel. coverage is the part
+        of the pixel covered by the shape, from 0 (none) to 64 (all).
+
+*/
+// *****************************************************************************
+static void GFX_CoveragePixelBlend(
+                                GFX_COLOR *pPixel,
+                                uint16_t coverage)
+{
+    uint16_t    alpha;
+
+    alpha = ((coverage * 100) + 32) >> 6;
+    if (alpha >= 100)
+        *pPixel = GFX_ColorGet();
+    else if (alpha)
+        GFX_AlphaLineBlend(pPixel, GFX_ColorGet(), alpha, 1);
+}
+
+// *****************************************************************************
+/*  Function:
+    uint16_t GFX_LineCoverageGet(
+                                int32_t center,
+                                int16_t position,
+                                int32_t halfWidth)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Returns the part of pixel row (or column) position covered by
+        a line of halfWidth on each side of center, from 0 to 64.
+        center and halfWidth have 16 fraction bits.
+
+*/
+// *****************************************************************************
+static uint16_t GFX_LineCoverageGet(
+                                int32_t center,
+                                int16_t position,
+                                int32_t halfWidth)
+{
+    int32_t     low, high;
+
+    low  = ((int32_t)position * 65536) - 0x8000;
+    high = ((int32_t)position * 65536) + 0x8000;
+    if (low < center - halfWidth)
+        low = center - halfWidth;
+    if (high > center + halfWidth)
+        high = center + halfWidth;
+
+    if (high <= low)
+        return (0);
+    return ((uint16_t)((high - low) >> 10));
+}
+
+// *****************************************************************************
+/*  Function:
+    void GFX_AntiAliasedLineDraw(
+                                int16_t x1,
+                                int16_t y1,
+                                int16_t x2,
+                                int16_t y2,
+                                uint16_t lineThickness)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Renders a diagonal anti-aliased line row by row. The line is 1
+        pixel (3 pixels when lineThickness is set) wide across its major
+        axis. The pixels of a row are read, blended with the coverage of
+        the line and written back as one run. As for the solid lines,
+        the first point x1,y1 is not rendered so that connected lines
+        do not blend their shared points twice.
+
+*/
+// *****************************************************************************
+static void GFX_AntiAliasedLineDraw(
+                                int16_t x1,
+                                int16_t y1,
+                                int16_t x2,
+                                int16_t y2,
+                                uint16_t lineThickness)
+{
+    int16_t     a1, b1, a2, b2, aFirst, aLast, aStart, aEnd;
+    int16_t     left, right, row, position, direction, steep;
+    int32_t     slope, center, halfWidth, reach;
+    GFX_COLOR   *pPixel;
+
+    // a is the major axis, b the minor axis
+    steep = (((y2 > y1) ? (y2 - y1) : (y1 - y2)) > ((x2 > x1) ? (x2 - x1) : (x1 - x2)));
+    if (steep)
+    {
+        a1 = y1;    b1 = x1;
+        a2 = y2;    b2 = x2;
+    }
+    else
+    {
+        a1 = x1;    b1 = y1;
+        a2 = x2;    b2 = y2;
+    }
+
+    slope = ((int32_t)(b2 - b1) * 65536) / (a2 - a1);
+    halfWidth = (lineThickness) ? 0x18000 : 0x8000;
+    reach = halfWidth + 0x8000;
+
+    // the first point is not rendered
+    aFirst = (a2 > a1) ? (a1 + 1) : a2;
+    aLast  = (a2 > a1) ? a2 : (a1 - 1);
+
+    #define GFX_LINE_CENTER(a)  (((int32_t)b1 * 65536) + (((int32_t)(a) - a1) * slope))
+
+    if (steep)
+    {
+        // each row crosses the line once
+        for(row = aFirst; row <= aLast; row++)
+        {
+            center = GFX_LINE_CENTER(row);
+            left  = (int16_t)((center - reach) >> 16) + 1;
+            right = (int16_t)((center + reach - 1) >> 16);
+
+            if (GFX_CoverageRowGet(&left, &right, row) == GFX_STATUS_FAILURE)
+                continue;
+
+            pPixel = gfxLineBuffer0;
+            for(position = left; position <= right; position++)
+                GFX_CoveragePixelBlend(pPixel++, GFX_LineCoverageGet(center, position, halfWidth));
+            GFX_PixelArrayPut(left, row, gfxLineBuffer0, right - left + 1);
+        }
+    }
+    else
+    {
+        // the rows are visited in the direction the line moves to,
+        // the columns crossing a row follow the columns of the row before
+        direction = (slope > 0) ? 1 : -1;
+        center = GFX_LINE_CENTER(aFirst);
+        if (direction > 0)
+            row = (int16_t)((center - reach) >> 16) + 1;
+        else
+            row = (int16_t)((center + reach - 1) >> 16);
+
+        aStart = aFirst;
+        while(1)
+        {
+            // skip the columns that do not reach this row
+            while(aStart <= aLast)
+            {
+                center = GFX_LINE_CENTER(aStart) - ((int32_t)row * 65536);
+                if (direction < 0)
+                    center = -center;
+                if (center > -reach)
+                    break;
+                aStart++;
+            }
+            if (aStart > aLast)
+                break;
+
+            aEnd = aStart;
+            while(aEnd < aLast)
+            {
+                center = GFX_LINE_CENTER(aEnd + 1) - ((int32_t)row * 65536);
+                if (direction < 0)
+                    center = -center;
+                if (center >= reach)
+                    break;
+                aEnd++;
+            }
+
+            left  = aStart;
+            right = aEnd;
+            if (GFX_CoverageRowGet(&left, &right, row) == GFX_STATUS_SUCCESS)
+            {
+                pPixel = gfxLineBuffer0;
+                for(position = left; position <= right; position++)
+                    GFX_CoveragePixelBlend(pPixel++, GFX_LineCoverageGet(GFX_LINE_CENTER(position), row, halfWidth));
+                GFX_PixelArrayPut(left, row, gfxLineBuffer0, right - left + 1);
+            }
+            row += direction;
+        }
+    }
+
+    #undef GFX_LINE_CENTER
+}
+
+#endif // #ifndef GFX_CONFIG_ALPHABLEND_DISABLE
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_SolidLineDraw(
+                                uint16_t x1,
+                                uint16_t y1,
+                                uint16_t x2,
+                                uint16_t y2)
+
+    Summary:
+        This function renders the thin and thick solid line.
+        This is an internal function and should not be called by the application.
+
+    Description:
+        This function renders the thin and thick solid lines
+        (see GFX_LINE_STYLE). The pixels of a diagonal line on one row
+        (one column for steep lines) are rendered as one bar.
+        Anti-aliased diagonal lines are rendered by GFX_LineDraw()
+        with GFX_AntiAliasedLineDraw() and do not reach this function.
+
+*/
+// *****************************************************************************
+GFX_STATUS __attribute__((weak)) GFX_SolidLineDraw(
+                                uint16_t x1,
+                                uint16_t y1,
+                                uint16_t x2,
+                                uint16_t y2)
 {
     /*
      * NOTE: This function is an internal function and should not
      *       be called by the application.
      */
 
-    typedef enum
-    {
-        GFX_SOLID_LINE_IDLE_STATE = 0x0D90,
-        GFX_SOLID_LINE_VERHOR_DRAW_STATE,
-        GFX_SOLID_LINE_DIAGONAL_INITIALIZE_STATE,
-        GFX_SOLID_LINE_UPDATE_DRAW_STATE,
-        GFX_SOLID_LINE_DIAGONAL_DRAW_STATE,
-        GFX_SOLID_LINE_EXIT_STATE,
-    } GFX_SOLID_LINE_DRAW_STATE;
-
-    static GFX_SOLID_LINE_DRAW_STATE state = GFX_SOLID_LINE_IDLE_STATE;
-
-    static int16_t   deltaX, deltaY;
-    static int16_t   error, stepErrorLT, stepErrorGE;
-    static int16_t   stepX, stepY, steep;
-    static uint16_t  left, top, right, bottom, thickAdjustX, thickAdjustY;
-    static uint16_t  lineThickness, lineType;
-           int16_t   temp;
+    GFX_SOLID_LINE_DRAW_PARAM   *pState = &(pGfxContext->solidLine);
+    int16_t                     temp;
 
     while(1)
     {
-        switch(state)
+        switch(pState->state)
         {
             case GFX_SOLID_LINE_IDLE_STATE:
 
-                lineType      = (GFX_LineStyleGet() & GFX_LINE_TYPE_MASK);
-                lineThickness = (GFX_LineStyleGet() & GFX_LINE_THICKNESS_MASK);
+                pState->lineType      = (GFX_LineStyleGet() & GFX_LINE_TYPE_MASK);
+                pState->lineThickness = (GFX_LineStyleGet() & GFX_LINE_THICKNESS_MASK);
 
                 // line do not support alpha blending
 #ifndef GFX_CONFIG_ALPHABLEND_DISABLE
@@ -1303,61 +2634,61 @@ GFX_STATUS __attribute__((weak)) GFX_SolidLineDraw(
                 {
                     if(x1 > x2)
                     {
-                        left = x2;
-                        right = x1;
+                        pState->left = x2;
+                        pState->right = x1;
                     }
                     else
                     {
-                        left = x1;
-                        right = x2;
+                        pState->left = x1;
+                        pState->right = x2;
                     }
 
                     if(y1 > y2)
                     {
-                        top = y2;
-                        bottom = y1;
+                        pState->top = y2;
+                        pState->bottom = y1;
                     }
                     else
                     {
-                        top = y1;
-                        bottom = y2;
+                        pState->top = y1;
+                        pState->bottom = y2;
                     }
 
                     // adjust the dimension for thicklines
-                    if (lineThickness)
+                    if (pState->lineThickness)
                     {
                         if(x1 == x2)
                         {
-                            thickAdjustX = 1;
-                            thickAdjustY = 0;
+                            pState->thickAdjustX = 1;
+                            pState->thickAdjustY = 0;
                         }
                         else
                         {
-                            thickAdjustX = 0;
-                            thickAdjustY = 1;
+                            pState->thickAdjustX = 0;
+                            pState->thickAdjustY = 1;
                         }
 
-                        left   -= thickAdjustX;
-                        right  += thickAdjustX;
-                        top    -= thickAdjustY;
-                        bottom += thickAdjustY;
+                        pState->left   -= pState->thickAdjustX;
+                        pState->right  += pState->thickAdjustX;
+                        pState->top    -= pState->thickAdjustY;
+                        pState->bottom += pState->thickAdjustY;
                     }
-                    state = GFX_SOLID_LINE_VERHOR_DRAW_STATE;
+                    pState->state = GFX_SOLID_LINE_VERHOR_DRAW_STATE;
                 }
                 else
                 {
-                    state = GFX_SOLID_LINE_DIAGONAL_INITIALIZE_STATE;
+                    pState->state = GFX_SOLID_LINE_DIAGONAL_INITIALIZE_STATE;
                 }
                 break;
                 
             case GFX_SOLID_LINE_VERHOR_DRAW_STATE:
                 // Draw the line
-                if(GFX_BarDraw(left, top, right, bottom) == GFX_STATUS_FAILURE)
+                if(GFX_BarDraw(pState->left, pState->top, pState->right, pState->bottom) == GFX_STATUS_FAILURE)
                     return GFX_STATUS_FAILURE;
                 else
                 {
                     // it is done!
-                    state = GFX_SOLID_LINE_EXIT_STATE;
+                    pState->state = GFX_SOLID_LINE_EXIT_STATE;
                 }
                 // no break here since the next state is the state
                 // that we want.
@@ -1367,129 +2698,136 @@ GFX_STATUS __attribute__((weak)) GFX_SolidLineDraw(
                 // else it is done exit gracefully
                 // Move cursor
                 GFX_LinePositionSet(x2, y2);
-                state = GFX_SOLID_LINE_IDLE_STATE;
+                pState->state = GFX_SOLID_LINE_IDLE_STATE;
                 return GFX_STATUS_SUCCESS;
 
             case GFX_SOLID_LINE_DIAGONAL_INITIALIZE_STATE:
-                stepX = 0;
-                deltaX = x2 - x1;
-                if(deltaX < 0)
+                pState->stepX = 0;
+                pState->deltaX = x2 - x1;
+                if(pState->deltaX < 0)
                 {
-                    deltaX = -deltaX;
-                    --stepX;
+                    pState->deltaX = -pState->deltaX;
+                    --pState->stepX;
                 }
                 else
                 {
-                    ++stepX;
+                    ++pState->stepX;
                 }
 
-                stepY = 0;
-                deltaY = y2 - y1;
-                if(deltaY < 0)
+                pState->stepY = 0;
+                pState->deltaY = y2 - y1;
+                if(pState->deltaY < 0)
                 {
-                    deltaY = -deltaY;
-                    --stepY;
+                    pState->deltaY = -pState->deltaY;
+                    --pState->stepY;
                 }
                 else
                 {
-                    ++stepY;
+                    ++pState->stepY;
                 }
 
-                steep = 0;
-                if(deltaX < deltaY)
+                pState->steep = 0;
+                if(pState->deltaX < pState->deltaY)
                 {
-                    ++steep;
-                    temp = deltaX;
-                    deltaX = deltaY;
-                    deltaY = temp;
-                    left = y1;
-                    top  = x1;
-
-                    temp = stepX;
-                    stepX = stepY;
-                    stepY = temp;
-                    thickAdjustX = 1;
-                    thickAdjustY = 0;
+                    ++pState->steep;
+                    temp = pState->deltaX;
+                    pState->deltaX = pState->deltaY;
+                    pState->deltaY = temp;
+                    pState->left = y1;
+                    pState->top  = x1;
+
+                    temp = pState->stepX;
+                    pState->stepX = pState->stepY;
+                    pState->stepY = temp;
+                    pState->thickAdjustX = 1;
+                    pState->thickAdjustY = 0;
 
                 }
                 else
                 {
-                    left = x1;
-                    top  = y1;
-                    thickAdjustX = 0;
-                    thickAdjustY = 1;
+                    pState->left = x1;
+                    pState->top  = y1;
+                    pState->thickAdjustX = 0;
+                    pState->thickAdjustY = 1;
                 }
 
                 // If the current error greater or equal zero
-                stepErrorGE = deltaX << 1;
+                pState->stepErrorGE = pState->deltaX << 1;
 
                 // If the current error less than zero
-                stepErrorLT = deltaY << 1;
+                pState->stepErrorLT = pState->deltaY << 1;
 
                 // Error for the first pixel
-                error = stepErrorLT - deltaX;
-                state = GFX_SOLID_LINE_UPDATE_DRAW_STATE;
+                pState->error = pState->stepErrorLT - pState->deltaX;
+
+                // the pixels of a row are collected into one run, thick
+                // lines render two rows past the last run
+                pState->runCount    = 0;
+                pState->spanValid   = 0;
+                pState->spanPending = (pState->lineThickness) ? 2 : 0;
+                pState->state = GFX_SOLID_LINE_UPDATE_DRAW_STATE;
                 // no break here since this is the next step anyway
 
             case GFX_SOLID_LINE_UPDATE_DRAW_STATE:
-                if (--deltaX >= 0)
+                if (--pState->deltaX >= 0)
                 {
-                    if(error >= 0)
+                    temp = 0;
+                    if(pState->error >= 0)
+                    {
+                        pState->top += pState->stepY;
+                        pState->error -= pState->stepErrorGE;
+
+                        // the run of the previous row is complete
+                        if (pState->runCount)
+                        {
+                            GFX_SolidLineRunPush(pState, 1);
+                            pState->runCount = 0;
+                            temp = 1;
+                        }
+                    }
+
+                    pState->left += pState->stepX;
+                    pState->error += pState->stepErrorLT;
+
+                    if (pState->runCount++ == 0)
                     {
-                        top += stepY;
-                        error -= stepErrorGE;
+                        pState->runFirst = pState->left;
+                        pState->runRow   = pState->top;
                     }
+                    pState->runLast = pState->left;
 
-                    left += stepX;
-                    error += stepErrorLT;
-                    state = GFX_SOLID_LINE_DIAGONAL_DRAW_STATE;
+                    if (temp == 0)
+                        break;
                 }
                 else
                 {
-                    // it is done!
-                    state = GFX_SOLID_LINE_EXIT_STATE;
-                    break;
+                    // the last run
+                    GFX_SolidLineRunPush(pState, 1);
+                    pState->runCount = 0;
                 }
+                pState->state = GFX_SOLID_LINE_SPAN_DRAW_STATE;
                 // no break here since the next step is the same state where we
                 // want to go to
 
-            case GFX_SOLID_LINE_DIAGONAL_DRAW_STATE:
-                if (lineThickness)
-                {
-                    if (steep)
-                    {
-                        if (GFX_BarDraw(
-                            top - thickAdjustY,
-                            left  - thickAdjustX,
-                            top + thickAdjustY,
-                            left  + thickAdjustX) == GFX_STATUS_FAILURE)
-                        {
-                            return GFX_STATUS_FAILURE;
-                        }
-                    }
-                    else
-                    {
-                        if (GFX_BarDraw(
-                            left - thickAdjustX,
-                            top  - thickAdjustY,
-                            left + thickAdjustX,
-                            top  + thickAdjustY) == GFX_STATUS_FAILURE)
-                        {
-                            return GFX_STATUS_FAILURE;
-                        }
-                    }
+            case GFX_SOLID_LINE_SPAN_DRAW_STATE:
+                if (GFX_SolidLineSpanDraw(pState) == GFX_STATUS_FAILURE)
+                    return GFX_STATUS_FAILURE;
 
+                if (pState->deltaX >= 0)
+                {
+                    pState->state = GFX_SOLID_LINE_UPDATE_DRAW_STATE;
+                }
+                else if (pState->spanPending)
+                {
+                    // rows after the end of a thick line
+                    pState->spanPending--;
+                    GFX_SolidLineRunPush(pState, 0);
                 }
                 else
                 {
-                    // since pixel rendering is blocking no need to check
-                    // status here
-                    if (steep)
-                        GFX_PixelPut(top, left);
-                    else
-                        GFX_PixelPut(left, top);
+                    // it is done!
+                    pState->state = GFX_SOLID_LINE_EXIT_STATE;
                 }
-                state = GFX_SOLID_LINE_UPDATE_DRAW_STATE;
                 break;
 
             default:
@@ -1544,6 +2882,11 @@ GFX_STATUS __attribute__((weak)) GFX_StyledLineDraw(
     lineType      = (GFX_LineStyleGet() & GFX_LINE_TYPE_MASK);
     lineThickness = (GFX_LineStyleGet() & GFX_LINE_THICKNESS_MASK);
 
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // the recorded commands are drawn before the pixels are read or written
+    GFX_DisplayListFlush();
+#endif
+
     if (x1 == x2)
     {
         // &&&&&&&&&&&&&&&&&&&&&&
@@ -1573,11 +2916,11 @@ GFX_STATUS __attribute__((weak)) GFX_StyledLineDraw(
             }
             if(type)
             {
-                GFX_PixelPut(left, temp);
+                GFX_ClippedPixelPut(left, temp);
                 if(lineThickness)
                 {
-                    GFX_PixelPut(left-1, temp);
-                    GFX_PixelPut(left+1, temp);
+                    GFX_ClippedPixelPut(left-1, temp);
+                    GFX_ClippedPixelPut(left+1, temp);
                 }
             }
         } // end of for loop
@@ -1611,11 +2954,11 @@ GFX_STATUS __attribute__((weak)) GFX_StyledLineDraw(
             }
             if(type)
             {
-                GFX_PixelPut(temp, top);
+                GFX_ClippedPixelPut(temp, top);
                 if(lineThickness)
                 {
-                    GFX_PixelPut(temp, top-1);
-                    GFX_PixelPut(temp, top+1);
+                    GFX_ClippedPixelPut(temp, top-1);
+                    GFX_ClippedPixelPut(temp, top+1);
                 }
             }
         } // end of for loop
@@ -1686,20 +3029,20 @@ GFX_STATUS __attribute__((weak)) GFX_StyledLineDraw(
             {
                 if(steep)
                 {
-                    GFX_PixelPut(top, left);
+                    GFX_ClippedPixelPut(top, left);
                     if(lineThickness)
                     {
-                        GFX_PixelPut(top-1, left);
-                        GFX_PixelPut(top+1, left);
+                        GFX_ClippedPixelPut(top-1, left);
+                        GFX_ClippedPixelPut(top+1, left);
                     }
                 }
                 else
                 {
-                    GFX_PixelPut(left, top);
+                    GFX_ClippedPixelPut(left, top);
                     if(lineThickness)
                     {
-                        GFX_PixelPut(left, top-1);
-                        GFX_PixelPut(left, top+1);
+                        GFX_ClippedPixelPut(left, top-1);
+                        GFX_ClippedPixelPut(left, top+1);
                     }
                 }
             }
@@ -1741,7 +3084,8 @@ GFX_STATUS __attribute__((weak)) GFX_StyledLineDraw(
         style (see GFX_LineStyleSet()) and color (see GFX_ColorSet()). The
         shape of the polygon is determined by the polygon points (an
         ordered array of x,y pairs) where the pair count is equal to the
-        parameter sides.
+        parameter sides plus one. The last point is not joined to the
+        first point.
 
         If any of the x,y pairs do not lie on the frame buffer, then the
         behavior is undefined. If color is not set, before this function
@@ -1754,14 +3098,7 @@ GFX_STATUS __attribute__((weak)) GFX_PolygonDraw(
                                 uint16_t *pPoints)
 {
 
-    typedef enum
-    {
-        POLYGON_BEGIN,
-        POLYGON_DRAWING,
-    } DRAWPOLY_STATES;
-
-    static DRAWPOLY_STATES state = POLYGON_BEGIN;
-    static int16_t counter, segmentCount;
+    GFX_POLYGON_DRAW_PARAM *pState = &(pGfxContext->polygon);
     uint16_t sx, sy, ex, ey;
 
     while(1)
@@ -1769,34 +3106,34 @@ GFX_STATUS __attribute__((weak)) GFX_PolygonDraw(
         if(GFX_RenderStatusGet() == GFX_STATUS_BUSY_BIT)
             return (GFX_STATUS_FAILURE);
 
-        switch(state)
+        switch(pState->state)
         {
             case POLYGON_BEGIN:
-                counter = 0;
-                segmentCount = sides << 1;
-                state = POLYGON_DRAWING;
+                pState->counter = 0;
+                pState->segmentCount = sides << 1;
+                pState->state = POLYGON_DRAWING;
 
             case POLYGON_DRAWING:
 
-                while(counter < segmentCount)
+                while(pState->counter < pState->segmentCount)
                 {
-                    sx = pPoints[counter    ];
-                    sy = pPoints[counter + 1];
-                    ex = pPoints[counter + 2];
-                    ey = pPoints[counter + 3];
+                    sx = pPoints[pState->counter    ];
+                    sy = pPoints[pState->counter + 1];
+                    ex = pPoints[pState->counter + 2];
+                    ey = pPoints[pState->counter + 3];
 
                     if(GFX_LineDraw(sx, sy, ex, ey) == GFX_STATUS_FAILURE)
                         return (GFX_STATUS_FAILURE);
 
-                    counter += 2;
+                    pState->counter += 2;
                 }
 
-                state = POLYGON_BEGIN;
+                pState->state = POLYGON_BEGIN;
                 return (GFX_STATUS_SUCCESS);
 
             default :
                 // this should never happen
-                state = POLYGON_BEGIN;
+                pState->state = POLYGON_BEGIN;
                 return (GFX_STATUS_FAILURE);
 
         } // end of switch...
@@ -1805,50 +3142,495 @@ GFX_STATUS __attribute__((weak)) GFX_PolygonDraw(
     return (GFX_STATUS_SUCCESS);
 }
 
+#ifdef GFX_CONFIG_POLYGON_FILL_POINTS
+
 // *****************************************************************************
 /*  Function:
-    GFX_STATUS GFX_FillStyleSet(
-                                GFX_FILL_STYLE style)
+    void GFX_PolygonEdgeTableBuild(
+                                uint16_t numPoints,
+                                uint16_t *pPoints)
 
     Summary:
-        Set the fill style to be used when rendering filled shapes.
+        This function is an internal function and should not
+        be called by the application.
 
     Description:
-        This function sets the fill style to be used (see GFX_FILL_STYLE)
-        when rendering filled shapes. All subsequent calls to the following:
-        - GFX_RectangleFillDraw()
-        - GFX_RectangleRoundFillDraw()
-        - GFX_CircleFillDraw()
-        will use the fill style set by this function.
+        Fills the edge table with the sides of the polygon that are not
+        horizontal, sorted by their first row, and sets the bounds of
+        the polygon in the context.
 
 */
 // *****************************************************************************
-GFX_STATUS __attribute__ ((always_inline)) GFX_FillStyleSet(
-                                GFX_FILL_STYLE style)
+static void GFX_PolygonEdgeTableBuild(
+                                uint16_t numPoints,
+                                uint16_t *pPoints)
 {
-    gfxFillStyle = style;
-    return (GFX_STATUS_SUCCESS);
+    GFX_POLYGON_FILL_DRAW_PARAM *pState = &(pGfxContext->polygonFill);
+    GFX_POLYGON_EDGE            edge;
+    uint16_t                    i, next, count = 0;
+    int16_t                     x1, y1, x2, y2, temp;
+
+    pState->left  = pState->right  = pPoints[0];
+    pState->top   = pState->bottom = pPoints[1];
+
+    for(i = 0; i < numPoints; i++)
+    {
+        // the last point is joined to the first point
+        next = ((i + 1) == numPoints) ? 0 : (i + 1);
+
+        x1 = pPoints[(i << 1)];
+        y1 = pPoints[(i << 1) + 1];
+        x2 = pPoints[(next << 1)];
+        y2 = pPoints[(next << 1) + 1];
+
+        if (x1 < pState->left)
+            pState->left = x1;
+        if (x1 > pState->right)
+            pState->right = x1;
+        if (y1 < pState->top)
+            pState->top = y1;
+        if (y1 > pState->bottom)
+            pState->bottom = y1;
+
+        // horizontal sides are added to the spans of their row
+        if (y1 == y2)
+            continue;
+
+        // the sides are followed top to bottom
+        if (y1 > y2)
+        {
+            temp = x1;
+            x1   = x2;
+            x2   = temp;
+            temp = y1;
+            y1   = y2;
+            y2   = temp;
+        }
+
+        edge.yTop         = y1;
+        edge.yBottom      = y2;
+        edge.x            = x1;
+        edge.fraction     = 0;
+        edge.dy           = y2 - y1;
+        edge.xStep        = (x2 - x1) / edge.dy;
+        edge.fractionStep = (x2 - x1) % edge.dy;
+        if (edge.fractionStep < 0)
+        {
+            edge.xStep--;
+            edge.fractionStep += edge.dy;
+        }
+
+        // insert the side after the sides starting on the same or a previous row
+        for(next = count; (next > 0) && (pState->edge[next - 1].yTop > edge.yTop); next--)
+            pState->edge[next] = pState->edge[next - 1];
+        pState->edge[next] = edge;
+        count++;
+    }
+
+    pState->edgeCount   = count;
+    pState->edgeNext    = 0;
+    pState->activeCount = 0;
 }
 
 // *****************************************************************************
 /*  Function:
-    GFX_FILL_STYLE GFX_FillStyleGet(void)
+    uint16_t GFX_PolygonRowSpansGet(
+                                int16_t y,
+                                uint16_t numPoints,
+                                uint16_t *pPoints)
 
     Summary:
-        Return the fill style used when rendering filled shapes.
+        This function is an internal function and should not
+        be called by the application.
 
     Description:
-        This function returns the fill style used (see GFX_FILL_STYLE)
-        when rendering filled shapes.
+        Fills the row spans of the context with the spans of row y that are inside
+        the polygon, sorted left to right and without overlaps, and
+        moves the crossings of the sides to row y + 1. Returns the
+        number of spans. The rows must be given top to bottom.
+
+        A pixel is inside when its center is inside the polygon
+        (even-odd rule) or on a side of the polygon.
 
 */
 // *****************************************************************************
-GFX_FILL_STYLE __attribute__ ((always_inline)) GFX_FillStyleGet(void)
+static uint16_t GFX_PolygonRowSpansGet(
+                                int16_t y,
+                                uint16_t numPoints,
+                                uint16_t *pPoints)
 {
-    return (gfxFillStyle);
-}
+    GFX_POLYGON_FILL_DRAW_PARAM *pState = &(pGfxContext->polygonFill);
+    GFX_POLYGON_EDGE    *pEdge, *pNext;
+    GFX_POLYGON_SPAN    span;
+    uint16_t            i, j, next, count = 0;
+
+    // the sides starting on the row cross the rows from now on
+    while ((pState->edgeNext < pState->edgeCount) &&
+           (pState->edge[pState->edgeNext].yTop == y))
+    {
+        pState->active[pState->activeCount++] = pState->edgeNext++;
+    }
 
-// *****************************************************************************
+    // sort the crossings left to right, the order changes little from row to row
+    for(i = 1; i < pState->activeCount; i++)
+    {
+        next  = pState->active[i];
+        pEdge = &pState->edge[next];
+        for(j = i; j > 0; j--)
+        {
+            pNext = &pState->edge[pState->active[j - 1]];
+            if ((pNext->x < pEdge->x) ||
+                ((pNext->x == pEdge->x) &&
+                 ((int32_t)pNext->fraction * pEdge->dy <= (int32_t)pEdge->fraction * pNext->dy)))
+                break;
+            pState->active[j] = pState->active[j - 1];
+        }
+        pState->active[j] = next;
+    }
+
+    // the pixels between a pair of crossings are inside
+    for(i = 0; (i + 1) < pState->activeCount; i += 2)
+    {
+        pEdge = &pState->edge[pState->active[i]];
+        pNext = &pState->edge[pState->active[i + 1]];
+
+        span.left  = pEdge->x + ((pEdge->fraction != 0) ? 1 : 0);
+        span.right = pNext->x;
+        if (span.left <= span.right)
+            pState->rowSpan[count++] = span;
+    }
+
+    // the points and the horizontal sides on the row are inside
+    for(i = 0; i < numPoints; i++)
+    {
+        if (pPoints[(i << 1) + 1] != (uint16_t)y)
+            continue;
+
+        next = ((i + 1) == numPoints) ? 0 : (i + 1);
+
+        span.left = span.right = pPoints[(i << 1)];
+        if (pPoints[(next << 1) + 1] == (uint16_t)y)
+        {
+            if ((int16_t)pPoints[(next << 1)] < span.left)
+                span.left = pPoints[(next << 1)];
+            else
+                span.right = pPoints[(next << 1)];
+        }
+
+        // keep the spans sorted by left
+        for(j = count; (j > 0) && (pState->rowSpan[j - 1].left > span.left); j--)
+            pState->rowSpan[j] = pState->rowSpan[j - 1];
+        pState->rowSpan[j] = span;
+        count++;
+    }
+
+    // join the spans that overlap or touch, no pixel is rendered twice
+    for(i = 1, j = 0; i < count; i++)
+    {
+        if (pState->rowSpan[i].left <= (pState->rowSpan[j].right + 1))
+        {
+            if (pState->rowSpan[i].right > pState->rowSpan[j].right)
+                pState->rowSpan[j].right = pState->rowSpan[i].right;
+        }
+        else
+        {
+            pState->rowSpan[++j] = pState->rowSpan[i];
+        }
+    }
+    if (count)
+        count = j + 1;
+
+    // move the crossings to the next row, the sides ending there are removed
+    for(i = 0, j = 0; i < pState->activeCount; i++)
+    {
+        pEdge = &pState->edge[pState->active[i]];
+        if (pEdge->yBottom == (y + 1))
+            continue;
+
+        pEdge->x        += pEdge->xStep;
+        pEdge->fraction += pEdge->fractionStep;
+        if (pEdge->fraction >= pEdge->dy)
+        {
+            pEdge->x++;
+            pEdge->fraction -= pEdge->dy;
+        }
+        pState->active[j++] = pState->active[i];
+    }
+    pState->activeCount = j;
+
+    return (count);
+}
+
+#ifndef GFX_CONFIG_GRADIENT_DISABLE
+
+// *****************************************************************************
+/*  Function:
+    GFX_COLOR GFX_PolygonGradientColorGet(
+                                int16_t x,
+                                int16_t y)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Returns the gradient color of pixel x,y of the polygon. The
+        gradient spans the bounds of the polygon in the direction given
+        by the fill style.
+
+*/
+// *****************************************************************************
+static GFX_COLOR GFX_PolygonGradientColorGet(
+                                int16_t x,
+                                int16_t y)
+{
+    GFX_POLYGON_FILL_DRAW_PARAM *pState = &(pGfxContext->polygonFill);
+    GFX_COLOR                   start, end;
+    int32_t                     position, steps;
+
+    switch(GFX_FillStyleGet())
+    {
+        case GFX_FILL_STYLE_GRADIENT_DOWN:
+            position = y - pState->top;
+            steps    = pState->bottom - pState->top;
+            break;
+        case GFX_FILL_STYLE_GRADIENT_UP:
+            position = pState->bottom - y;
+            steps    = pState->bottom - pState->top;
+            break;
+        case GFX_FILL_STYLE_GRADIENT_RIGHT:
+            position = x - pState->left;
+            steps    = pState->right - pState->left;
+            break;
+        case GFX_FILL_STYLE_GRADIENT_LEFT:
+            position = pState->right - x;
+            steps    = pState->right - pState->left;
+            break;
+        case GFX_FILL_STYLE_GRADIENT_DOUBLE_VER:
+            // start color on the left and right, end color in the middle
+            position = x - pState->left;
+            if ((pState->right - x) < position)
+                position = pState->right - x;
+            steps    = (pState->right - pState->left) >> 1;
+            break;
+        case GFX_FILL_STYLE_GRADIENT_DOUBLE_HOR:
+        default:
+            // start color on the top and bottom, end color in the middle
+            position = y - pState->top;
+            if ((pState->bottom - y) < position)
+                position = pState->bottom - y;
+            steps    = (pState->bottom - pState->top) >> 1;
+            break;
+    }
+
+    start = GFX_GradientStartColorGet();
+    if (steps == 0)
+        return (start);
+
+    end = GFX_GradientEndColorGet();
+    return (GFX_RGBConvert(
+        (int32_t)GFX_ComponentRedGet(start) +
+            ((((int32_t)GFX_ComponentRedGet(end) - (int32_t)GFX_ComponentRedGet(start)) * position) / steps),
+        (int32_t)GFX_ComponentGreenGet(start) +
+            ((((int32_t)GFX_ComponentGreenGet(end) - (int32_t)GFX_ComponentGreenGet(start)) * position) / steps),
+        (int32_t)GFX_ComponentBlueGet(start) +
+            ((((int32_t)GFX_ComponentBlueGet(end) - (int32_t)GFX_ComponentBlueGet(start)) * position) / steps)));
+}
+
+#endif // #ifndef GFX_CONFIG_GRADIENT_DISABLE
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_PolygonSpanDraw(
+                                GFX_POLYGON_SPAN *pSpan,
+                                int16_t y)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Renders a span of row y with the fill style.
+
+*/
+// *****************************************************************************
+static GFX_STATUS GFX_PolygonSpanDraw(
+                                GFX_POLYGON_SPAN *pSpan,
+                                int16_t y)
+{
+#ifndef GFX_CONFIG_GRADIENT_DISABLE
+    GFX_COLOR   color;
+    int16_t     x, left;
+
+    switch(GFX_FillStyleGet())
+    {
+        // the color changes from row to row
+        case GFX_FILL_STYLE_GRADIENT_DOWN:
+        case GFX_FILL_STYLE_GRADIENT_UP:
+        case GFX_FILL_STYLE_GRADIENT_DOUBLE_HOR:
+            GFX_ColorSet(GFX_PolygonGradientColorGet(pSpan->left, y));
+            break;
+
+        // the color changes from column to column, each run of one
+        // color is rendered as a bar
+        case GFX_FILL_STYLE_GRADIENT_RIGHT:
+        case GFX_FILL_STYLE_GRADIENT_LEFT:
+        case GFX_FILL_STYLE_GRADIENT_DOUBLE_VER:
+            x = pSpan->left;
+            while(x <= pSpan->right)
+            {
+                left  = x;
+                color = GFX_PolygonGradientColorGet(x, y);
+                while((x < pSpan->right) && (GFX_PolygonGradientColorGet(x + 1, y) == color))
+                    x++;
+
+                GFX_ColorSet(color);
+                while(GFX_BarDraw(left, y, x, y) == GFX_STATUS_FAILURE);
+                x++;
+            }
+            return (GFX_STATUS_SUCCESS);
+
+        default:
+            break;
+    }
+#endif
+
+    return (GFX_BarDraw(pSpan->left, y, pSpan->right, y));
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_PolygonFillDraw(
+                                uint16_t sides,
+                                uint16_t *pPoints)
+
+    Summary:
+        This function renders a filled polygon using the currently set
+        fill style and colors.
+
+    Description:
+        This function renders a filled polygon using the currently set
+        fill style (see GFX_FillStyleSet()) and colors. The polygon is
+        given by sides + 1 x,y pairs as in GFX_PolygonDraw(), the last
+        point is joined to the first point. Each row of the polygon is rendered as spans with
+        GFX_BarDraw(), so the spans are alpha blended with the
+        GFX_FILL_STYLE_ALPHA_COLOR fill style. The gradient fill styles
+        spread the gradient over the bounds of the polygon.
+
+        A pixel is rendered when its center is inside the polygon
+        (even-odd rule) or on a side of the polygon, no pixel is
+        rendered twice. Nothing is rendered when sides is 0, when
+        sides + 1 is greater than GFX_CONFIG_POLYGON_FILL_POINTS, or
+        when the fill style is GFX_FILL_STYLE_NONE.
+
+*/
+// *****************************************************************************
+GFX_STATUS __attribute__((weak)) GFX_PolygonFillDraw(
+                                uint16_t sides,
+                                uint16_t *pPoints)
+{
+    GFX_POLYGON_FILL_DRAW_PARAM *pState = &(pGfxContext->polygonFill);
+
+    while(1)
+    {
+        if(GFX_RenderStatusGet() == GFX_STATUS_BUSY_BIT)
+            return (GFX_STATUS_FAILURE);
+
+        switch(pState->state)
+        {
+            case POLYGON_FILL_BEGIN:
+
+                if ((sides == 0) ||
+                    (sides >= GFX_CONFIG_POLYGON_FILL_POINTS) ||
+                    (GFX_FillStyleGet() == GFX_FILL_STYLE_NONE))
+                {
+                    return (GFX_STATUS_SUCCESS);
+                }
+
+                GFX_PolygonEdgeTableBuild(sides + 1, pPoints);
+                pState->y = pState->top;
+                pState->state = POLYGON_FILL_ROW;
+
+            case POLYGON_FILL_ROW:
+
+                pState->spanCount = GFX_PolygonRowSpansGet(pState->y, sides + 1, pPoints);
+                pState->span = 0;
+                pState->state = POLYGON_FILL_DRAW;
+
+            case POLYGON_FILL_DRAW:
+
+                while(pState->span < pState->spanCount)
+                {
+                    if (GFX_PolygonSpanDraw(&pState->rowSpan[pState->span], pState->y) == GFX_STATUS_FAILURE)
+                        return (GFX_STATUS_FAILURE);
+                    pState->span++;
+                }
+
+                if (pState->y == pState->bottom)
+                {
+                    pState->state = POLYGON_FILL_BEGIN;
+                    return (GFX_STATUS_SUCCESS);
+                }
+
+                pState->y++;
+                pState->state = POLYGON_FILL_ROW;
+                break;
+
+            default :
+                // this should never happen
+                pState->state = POLYGON_FILL_BEGIN;
+                return (GFX_STATUS_FAILURE);
+
+        } // end of switch...
+    } // end of while(1)...
+}
+
+#endif // #ifdef GFX_CONFIG_POLYGON_FILL_POINTS
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_FillStyleSet(
+                                GFX_FILL_STYLE style)
+
+    Summary:
+        Set the fill style to be used when rendering filled shapes.
+
+    Description:
+        This function sets the fill style to be used (see GFX_FILL_STYLE)
+        when rendering filled shapes. All subsequent calls to the following:
+        - GFX_RectangleFillDraw()
+        - GFX_RectangleRoundFillDraw()
+        - GFX_CircleFillDraw()
+        will use the fill style set by this function.
+
+*/
+// *****************************************************************************
+GFX_STATUS __attribute__ ((always_inline)) GFX_FillStyleSet(
+                                GFX_FILL_STYLE style)
+{
+    pGfxContext->fillStyle = style;
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_FILL_STYLE GFX_FillStyleGet(void)
+
+    Summary:
+        Return the fill style used when rendering filled shapes.
+
+    Description:
+        This function returns the fill style used (see GFX_FILL_STYLE)
+        when rendering filled shapes.
+
+*/
+// *****************************************************************************
+GFX_FILL_STYLE __attribute__ ((always_inline)) GFX_FillStyleGet(void)
+{
+    return (pGfxContext->fillStyle);
+}
+
+// *****************************************************************************
 /*  Function:
     GFX_STATUS GFX_GradientColorSet(
                                 GFX_COLOR startColor,
@@ -1872,8 +3654,8 @@ GFX_STATUS __attribute__ ((always_inline)) GFX_GradientColorSet(
                                 GFX_COLOR startColor,
                                 GFX_COLOR endColor)
 {
-    gfxGradientStartColor = startColor;
-    gfxGradientEndColor = endColor;
+    pGfxContext->gradientStartColor = startColor;
+    pGfxContext->gradientEndColor = endColor;
     return (GFX_STATUS_SUCCESS);
 }
 
@@ -1892,7 +3674,7 @@ GFX_STATUS __attribute__ ((always_inline)) GFX_GradientColorSet(
 // *****************************************************************************
 GFX_COLOR __attribute__ ((always_inline)) GFX_GradientStartColorGet(void)
 {
-    return (gfxGradientStartColor);
+    return (pGfxContext->gradientStartColor);
 }
 
 // *****************************************************************************
@@ -1910,7 +3692,7 @@ GFX_COLOR __attribute__ ((always_inline)) GFX_GradientStartColorGet(void)
 // *****************************************************************************
 GFX_COLOR __attribute__ ((always_inline)) GFX_GradientEndColorGet(void)
 {
-    return (gfxGradientEndColor);
+    return (pGfxContext->gradientEndColor);
 }
 
 // *****************************************************************************
@@ -2121,7 +3903,7 @@ GFX_STATUS __attribute__ ((always_inline)) GFX_CircleFillDraw(
 // *****************************************************************************
 int16_t __attribute__ ((always_inline)) GFX_TextCursorPositionXGet(void)
 {
-    return gfxTextPositionX;
+    return pGfxContext->textPositionX;
 }
 
 // *****************************************************************************
@@ -2140,7 +3922,7 @@ int16_t __attribute__ ((always_inline)) GFX_TextCursorPositionXGet(void)
 // *****************************************************************************
 int16_t __attribute__ ((always_inline)) GFX_TextCursorPositionYGet(void)
 {
-    return gfxTextPositionY;
+    return pGfxContext->textPositionY;
 }
 
 // *****************************************************************************
@@ -2166,8 +3948,8 @@ GFX_STATUS __attribute__ ((weak)) GFX_TextCursorPositionSet(
                                 int16_t x,
                                 int16_t y)
 {
-    gfxTextPositionX = x;
-    gfxTextPositionY = y;
+    pGfxContext->textPositionX = x;
+    pGfxContext->textPositionY = y;
 
     return (GFX_STATUS_SUCCESS);
 }
@@ -2387,6 +4169,46 @@ void  __attribute__((weak)) GFX_Initialize(void)
 // *****************************************************************************
 inline void GFX_Primitive_Initialize(void)
 {
+    // the default settings are kept in the default context
+    GFX_ContextInitialize(&gfxContextDefault);
+    pGfxContext = &gfxContextDefault;
+
+#ifndef GFX_CONFIG_DOUBLE_BUFFERING_DISABLE
+
+    GFX_DoubleBufferDisable();
+    GFX_DoubleBufferSyncAllStatusClear();
+    GFX_DoubleBufferSyncAreaCountSet(0);
+    GFX_DoubleBufferSynchronizeCancel();
+
+#endif
+}
+
+// *****************************************************************************
+/*  Function:
+    void GFX_ContextInitialize(GFX_CONTEXT *pContext)
+
+    Summary:
+        This function initializes a rendering context.
+
+    Description:
+        This function sets the given context to the default settings
+        listed in GFX_Primitive_Initialize() and sets all the primitives
+        of the context to idle. The active context is not changed.
+
+*/
+// *****************************************************************************
+void GFX_ContextInitialize(GFX_CONTEXT *pContext)
+{
+    GFX_CONTEXT *pActiveContext = pGfxContext;
+
+    // use the set functions on the given context
+    pGfxContext = pContext;
+
+    pContext->pFont = NULL;
+    pContext->textPositionX = 0;
+    pContext->textPositionY = 0;
+
+    GFX_FontAntiAliasSet(GFX_FONT_ANTIALIAS_OPAQUE);
 
     // Current line type
     GFX_LineStyleSet(GFX_LINE_STYLE_THIN_SOLID);
@@ -2411,43 +4233,320 @@ inline void GFX_Primitive_Initialize(void)
     // initialize the PutImage() render disable flag
     GFX_RenderToDisplayBufferEnable();
 
-#ifndef GFX_CONFIG_DOUBLE_BUFFERING_DISABLE
-
-    GFX_DoubleBufferDisable();
-    GFX_DoubleBufferSyncAllStatusClear();
-    GFX_DoubleBufferSyncAreaCountSet(0);
-    GFX_DoubleBufferSynchronizeCancel();
-
-#endif
-
     // Initialize the text region (used only by GFX_TextStringBoxDraw()
     GFX_TextAreaLeftSet(0);
     GFX_TextAreaTopSet(0);
     GFX_TextAreaRightSet(GFX_MaxXGet());
     GFX_TextAreaBottomSet(GFX_MaxYGet());
+
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+    // render the whole screen
+    pContext->clip.left = 0;
+    pContext->clip.top = 0;
+    pContext->clip.right = GFX_MaxXGet();
+    pContext->clip.bottom = GFX_MaxYGet();
+    pContext->clipCount = 0;
+#endif
+
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+    // render to the display
+    pContext->pSurface = NULL;
+    pContext->surfaceDrawBuffer = 0;
+#endif
     
     // set Bevel drawing 
     GFX_BevelDrawTypeSet(GFX_DRAW_FULLBEVEL);
+
+    // no primitive is in progress
+    pContext->solidLine.state     = GFX_SOLID_LINE_IDLE_STATE;
+    pContext->polygon.state       = POLYGON_BEGIN;
+#ifdef GFX_CONFIG_POLYGON_FILL_POINTS
+    pContext->polygonFill.state   = POLYGON_FILL_BEGIN;
+#endif
+    pContext->bevel.state         = GFX_BEVEL_IDLE_STATE;
+    pContext->bevelFill.state     = FB_BEGIN;
+#ifndef GFX_CONFIG_GRADIENT_DISABLE
+    pContext->bevelGradient.state = BEVEL_GRADIENT_IDLE;
+#endif
+    pContext->thickBevel.state    = BEGIN;
+    pContext->textChar.state      = TC_IDLE;
+    pContext->textString.start    = 1;
+    pContext->textString.counter  = 0;
+    pContext->textStringBox.state = TB_IDLE;
+
+    pGfxContext = pActiveContext;
 }
 
 // *****************************************************************************
 /*  Function:
-    GFX_STATUS GFX_BevelDraw(
-                    uint16_t x1,
-                    uint16_t y1,
-                    uint16_t x2,
-                    uint16_t y2,
-                    uint16_t rad)
+    GFX_STATUS GFX_ContextSet(GFX_CONTEXT *pContext)
 
     Summary:
-        This function renders an unfilled bevel shape using the currently
-        set line style (see GFX_LineStyleSet()).
+        This function sets the context used by the primitive layer.
 
     Description:
-        This is an internal function. Application should not call this
-        function directly.
+        This function sets the context used by the primitive layer.
+        Passing NULL sets the default context. The font of the
+        context is set to the driver since some drivers render text
+        in hardware.
 
-        This function renders an unfilled bevel shape using the given
+*/
+// *****************************************************************************
+GFX_STATUS GFX_ContextSet(GFX_CONTEXT *pContext)
+{
+    if (pContext == NULL)
+        pContext = &gfxContextDefault;
+
+    pGfxContext = pContext;
+
+    if (pContext->pFont != NULL)
+        GFX_DRV_FontSet(pContext->pFont);
+
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_CONTEXT *GFX_ContextGet(void)
+
+    Summary:
+        This function returns the context used by the primitive layer.
+
+    Description:
+        This function returns the context used by the primitive layer.
+
+*/
+// *****************************************************************************
+inline GFX_CONTEXT * __attribute__ ((always_inline)) GFX_ContextGet(void)
+{
+    return (pGfxContext);
+}
+
+// *****************************************************************************
+/*  Function:
+    uint16_t GFX_SquareRootGet(uint32_t value)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Returns the integer square root of value, rounded down.
+
+*/
+// *****************************************************************************
+static uint16_t GFX_SquareRootGet(uint32_t value)
+{
+    uint32_t    root = 0, bit = 0x40000000;
+
+    while (bit > value)
+        bit >>= 2;
+
+    while (bit)
+    {
+        if (value >= root + bit)
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return ((uint16_t)root);
+}
+
+// *****************************************************************************
+/*  Function:
+    uint16_t GFX_BevelRowRunsGet(
+                                int16_t x1,
+                                int16_t y1,
+                                int16_t x2,
+                                int16_t y2,
+                                int16_t rad,
+                                int16_t y,
+                                int16_t *pRun)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Returns the runs of pixels of row y of a thick or anti-aliased
+        bevel outline. The outline is a ring around the rectangle
+        x1,y1,x2,y2 at a distance of rad pixels. The ring is 3 pixels
+        wide for the thick styles; the anti-aliased styles also include
+        the pixels partially covered by the ring. Up to two runs are
+        returned in pRun as left,right pairs.
+
+*/
+// *****************************************************************************
+static uint16_t GFX_BevelRowRunsGet(
+                                int16_t x1,
+                                int16_t y1,
+                                int16_t x2,
+                                int16_t y2,
+                                int16_t rad,
+                                int16_t y,
+                                int16_t *pRun)
+{
+    int32_t     outer, inner, dy2;
+    int16_t     xo, xi, reach, hole;
+
+    // ring limits are compared with twice the distance squared
+    reach = (GFX_LineStyleGet() & GFX_LINE_THICKNESS_MASK) ? 2 : 1;
+    if ((GFX_LineStyleGet() & GFX_LINE_ANTIALIAS_MASK) == 0)
+    {
+        outer = ((int32_t)rad << 1) + 3;
+        outer *= outer;
+        inner = ((int32_t)rad << 1) - 3;
+        inner *= inner;
+    }
+    else
+    {
+        outer = ((int32_t)rad + reach);
+        outer = (outer * outer << 2) - 1;
+        inner = ((int32_t)rad - reach);
+        inner = (inner * inner << 2) + 1;
+    }
+
+    if (y < y1)
+        dy2 = (int32_t)(y1 - y);
+    else if (y > y2)
+        dy2 = (int32_t)(y - y2);
+    else
+        dy2 = 0;
+    dy2 = (dy2 * dy2) << 2;
+
+    if (outer < dy2)
+        return (0);
+    xo = GFX_SquareRootGet(outer - dy2) >> 1;
+
+    if (rad >= reach)
+    {
+        // the hole follows the ring
+        inner -= dy2 + 1;
+        hole = (inner >= 0);
+        xi = (hole) ? -(int16_t)(GFX_SquareRootGet(inner) >> 1) : 0;
+    }
+    else
+    {
+        // the ring covers the edges of the rectangle, the hole is
+        // the rectangle without its edges
+        xi = reach - rad;
+        hole = ((y >= y1 + xi) && (y <= y2 - xi));
+    }
+
+    // the hole starts xi pixels inside x1 and x2
+    pRun[0] = x1 - xo;
+    if ((hole == 0) || (x1 + xi > x2 - xi))
+    {
+        pRun[1] = x2 + xo;
+        return (1);
+    }
+    pRun[1] = x1 + xi - 1;
+    pRun[2] = x2 - xi + 1;
+    pRun[3] = x2 + xo;
+    return (2);
+}
+
+#ifndef GFX_CONFIG_ALPHABLEND_DISABLE
+
+// *****************************************************************************
+/*  Function:
+    void GFX_BevelRunBlend(
+                                int16_t x1,
+                                int16_t y1,
+                                int16_t x2,
+                                int16_t y2,
+                                int16_t rad,
+                                int16_t left,
+                                int16_t right,
+                                int16_t y)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Blends a run of an anti-aliased bevel outline. The coverage of
+        each pixel is found from its distance to the rectangle
+        x1,y1,x2,y2, in 1/64 of a pixel.
+
+*/
+// *****************************************************************************
+static void GFX_BevelRunBlend(
+                                int16_t x1,
+                                int16_t y1,
+                                int16_t x2,
+                                int16_t y2,
+                                int16_t rad,
+                                int16_t left,
+                                int16_t right,
+                                int16_t y)
+{
+    GFX_COLOR   *pPixel;
+    int32_t     x, dy, distance, low, high, halfWidth;
+
+    if (GFX_CoverageRowGet(&left, &right, y) == GFX_STATUS_FAILURE)
+        return;
+
+    halfWidth = (GFX_LineStyleGet() & GFX_LINE_THICKNESS_MASK) ? 96 : 32;
+
+    if (y < y1)
+        dy = y1 - y;
+    else if (y > y2)
+        dy = y - y2;
+    else
+        dy = 0;
+
+    pPixel = gfxLineBuffer0;
+    for (x = left; x <= right; x++)
+    {
+        if (x < x1)
+            distance = x1 - x;
+        else if (x > x2)
+            distance = x - x2;
+        else
+            distance = 0;
+        distance = GFX_SquareRootGet((uint32_t)(distance * distance + dy * dy) << 12);
+
+        low  = distance - 32;
+        high = distance + 32;
+        if (low < ((int32_t)rad << 6) - halfWidth)
+            low = ((int32_t)rad << 6) - halfWidth;
+        if (high > ((int32_t)rad << 6) + halfWidth)
+            high = ((int32_t)rad << 6) + halfWidth;
+
+        if (high > low)
+            GFX_CoveragePixelBlend(pPixel, (uint16_t)(high - low));
+        pPixel++;
+    }
+    GFX_PixelArrayPut(left, y, gfxLineBuffer0, right - left + 1);
+}
+
+#endif // #ifndef GFX_CONFIG_ALPHABLEND_DISABLE
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_BevelDraw(
+                    uint16_t x1,
+                    uint16_t y1,
+                    uint16_t x2,
+                    uint16_t y2,
+                    uint16_t rad)
+
+    Summary:
+        This function renders an unfilled bevel shape using the currently
+        set line style (see GFX_LineStyleSet()).
+
+    Description:
+        This is an internal function. Application should not call this
+        function directly.
+
+        This function renders an unfilled bevel shape using the given
         x1, y1, x2, y2 and rad parameters to define the shape dimension.
         rad defines the rounded corner shape. The bevel is rendered using the
         currently set line style by GFX_LineStyleSet(). The color used is the
@@ -2485,70 +4584,80 @@ GFX_STATUS __attribute__((weak)) GFX_BevelDraw(   uint16_t x1, uint16_t y1,
      *       be called by the application.
      */
 
-    typedef enum
-    {
-        GFX_BEVEL_IDLE_STATE = 0x0DA0,
-        GFX_BEVEL_RADIUS_EVAL_STATE,
-        GFX_BEVEL_RADIUS_ERROR_EVAL_STATE,
-        GFX_BEVEL_RADIUS_DRAW_STATE,
-        GFX_BEVEL_LINE_TOP_DRAW_STATE,
-        GFX_BEVEL_LINE_BOTTOM_DRAW_STATE,
-        GFX_BEVEL_LINE_RIGHT_DRAW_STATE,
-        GFX_BEVEL_LINE_LEFT_DRAW_STATE,
-
-
-    } GFX_BEVEL_DRAW_STATE;
-
-    static GFX_BEVEL_DRAW_STATE state = GFX_BEVEL_IDLE_STATE;
-    static uint16_t             lineType, lineThickness;
-    static int16_t              style, type, xLimit, xPos, yPos, error;
+    GFX_BEVEL_DRAW_PARAM        *pState = &(pGfxContext->bevel);
     PRIMITIVE_UINT32_UNION      temp;
+    int16_t                     run[4], bottom;
+    uint16_t                    runCount;
 
     while(1)
     {
-        switch(state)
+        switch(pState->state)
         {
             case GFX_BEVEL_IDLE_STATE:
 
+                pState->lineType      = (GFX_LineStyleGet() & GFX_LINE_TYPE_MASK);
+                pState->lineThickness = (GFX_LineStyleGet() & GFX_LINE_THICKNESS_MASK);
+
+                pState->type = 0;
+#ifndef GFX_CONFIG_ALPHABLEND_DISABLE
+                if (GFX_LineStyleGet() & GFX_LINE_ANTIALIAS_MASK)
+                    pState->type = 1;
+#endif
+                if (rad && (pState->lineType == 0) &&
+                    (pState->lineThickness || pState->type))
+                {
+                    // thick and anti-aliased outlines are rendered
+                    // as runs of pixels, row by row
+#ifndef GFX_CONFIG_ALPHABLEND_DISABLE
+                    GFX_AlphaBlendingValueSet(100);
+#endif
+                    pState->yPos   = y1 - rad - 2;
+                    pState->xLimit = y2 + rad + 2;
+                    pState->xPos   = 0;
+                    pState->state  = GFX_BEVEL_SPAN_DRAW_STATE;
+                    break;
+                }
+
                 if(rad)
                 {
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+                    // the corners are drawn with pixels
+                    GFX_DisplayListFlush();
+#endif
                     temp.uint32Value = SIN45 * rad;
-                    xLimit = temp.uint3216BitValue[1] + 1;
+                    pState->xLimit = temp.uint3216BitValue[1] + 1;
                     temp.uint32Value = (uint32_t) (ONEP25 - ((int32_t) rad << 16));
-                    error = (int16_t) (temp.uint3216BitValue[1]);
-                    yPos = rad;
-                    style = 0;
-                    type = 1;
-
-                    lineType      = (GFX_LineStyleGet() & GFX_LINE_TYPE_MASK);
-                    lineThickness = (GFX_LineStyleGet() & GFX_LINE_THICKNESS_MASK);
-                    state = GFX_BEVEL_RADIUS_EVAL_STATE;
-                    xPos = 0;
+                    pState->error = (int16_t) (temp.uint3216BitValue[1]);
+                    pState->yPos = rad;
+                    pState->style = 0;
+                    pState->type = 1;
+                    pState->state = GFX_BEVEL_RADIUS_EVAL_STATE;
+                    pState->xPos = 0;
                     // no break here, to go through the next state
                 }
                 else
                 {
-                    state = GFX_BEVEL_LINE_TOP_DRAW_STATE;
+                    pState->state = GFX_BEVEL_LINE_TOP_DRAW_STATE;
                     break;
                 }
 
             case GFX_BEVEL_RADIUS_EVAL_STATE:
 
-                if (xPos <= xLimit)
+                if (pState->xPos <= pState->xLimit)
                 {
-                    if((++style) == lineType)
+                    if((++pState->style) == pState->lineType)
                     {
-                        type ^= 1;
-                        style = 0;
+                        pState->type ^= 1;
+                        pState->style = 0;
                     }
-                    if (type)
+                    if (pState->type)
                     {
-                        state = GFX_BEVEL_RADIUS_DRAW_STATE;
+                        pState->state = GFX_BEVEL_RADIUS_DRAW_STATE;
                         // no break here, to go through the next state
                     }
                     else
                     {
-                        state = GFX_BEVEL_RADIUS_ERROR_EVAL_STATE;
+                        pState->state = GFX_BEVEL_RADIUS_ERROR_EVAL_STATE;
                         break;
 
                     }
@@ -2557,59 +4666,59 @@ GFX_STATUS __attribute__((weak)) GFX_BevelDraw(   uint16_t x1, uint16_t y1,
                 {
                     // rounded corner is done
                     // go to rendering the lines
-                    state = GFX_BEVEL_LINE_TOP_DRAW_STATE;
+                    pState->state = GFX_BEVEL_LINE_TOP_DRAW_STATE;
                     break;
                 }
                 // no break here, to go through the next state
 
             case GFX_BEVEL_RADIUS_DRAW_STATE:
 
-                GFX_PixelPut(x2 + xPos, y1 - yPos);         // 1st quadrant
-                GFX_PixelPut(x2 + yPos, y1 - xPos);
-                GFX_PixelPut(x2 + xPos, y2 + yPos);         // 2nd quadrant
-                GFX_PixelPut(x2 + yPos, y2 + xPos);
-                GFX_PixelPut(x1 - xPos, y2 + yPos);         // 3rd quadrant
-                GFX_PixelPut(x1 - yPos, y2 + xPos);
-                GFX_PixelPut(x1 - yPos, y1 - xPos);         // 4th quadrant
-                GFX_PixelPut(x1 - xPos, y1 - yPos);
+                GFX_ClippedPixelPut(x2 + pState->xPos, y1 - pState->yPos);         // 1st quadrant
+                GFX_ClippedPixelPut(x2 + pState->yPos, y1 - pState->xPos);
+                GFX_ClippedPixelPut(x2 + pState->xPos, y2 + pState->yPos);         // 2nd quadrant
+                GFX_ClippedPixelPut(x2 + pState->yPos, y2 + pState->xPos);
+                GFX_ClippedPixelPut(x1 - pState->xPos, y2 + pState->yPos);         // 3rd quadrant
+                GFX_ClippedPixelPut(x1 - pState->yPos, y2 + pState->xPos);
+                GFX_ClippedPixelPut(x1 - pState->yPos, y1 - pState->xPos);         // 4th quadrant
+                GFX_ClippedPixelPut(x1 - pState->xPos, y1 - pState->yPos);
 
-                if(lineThickness)
+                if(pState->lineThickness)
                 {
-                    GFX_PixelPut(x2 + xPos, y1 - yPos - 1); // 1st quadrant
-                    GFX_PixelPut(x2 + xPos, y1 - yPos + 1);
-                    GFX_PixelPut(x2 + yPos + 1, y1 - xPos);
-                    GFX_PixelPut(x2 + yPos - 1, y1 - xPos);
-
-                    GFX_PixelPut(x2 + xPos, y2 + yPos - 1); // 2nd quadrant
-                    GFX_PixelPut(x2 + xPos, y2 + yPos + 1);
-                    GFX_PixelPut(x2 + yPos + 1, y2 + xPos);
-                    GFX_PixelPut(x2 + yPos - 1, y2 + xPos);
-
-                    GFX_PixelPut(x1 - xPos, y2 + yPos - 1); // 3rd quadrant
-                    GFX_PixelPut(x1 - xPos, y2 + yPos + 1);
-                    GFX_PixelPut(x1 - yPos + 1, y2 + xPos);
-                    GFX_PixelPut(x1 - yPos - 1, y2 + xPos);
-
-                    GFX_PixelPut(x1 - yPos + 1, y1 - xPos); // 4th quadrant
-                    GFX_PixelPut(x1 - yPos - 1, y1 - xPos);
-                    GFX_PixelPut(x1 - xPos, y1 - yPos + 1);
-                    GFX_PixelPut(x1 - xPos, y1 - yPos - 1);                    
+                    GFX_ClippedPixelPut(x2 + pState->xPos, y1 - pState->yPos - 1); // 1st quadrant
+                    GFX_ClippedPixelPut(x2 + pState->xPos, y1 - pState->yPos + 1);
+                    GFX_ClippedPixelPut(x2 + pState->yPos + 1, y1 - pState->xPos);
+                    GFX_ClippedPixelPut(x2 + pState->yPos - 1, y1 - pState->xPos);
+
+                    GFX_ClippedPixelPut(x2 + pState->xPos, y2 + pState->yPos - 1); // 2nd quadrant
+                    GFX_ClippedPixelPut(x2 + pState->xPos, y2 + pState->yPos + 1);
+                    GFX_ClippedPixelPut(x2 + pState->yPos + 1, y2 + pState->xPos);
+                    GFX_ClippedPixelPut(x2 + pState->yPos - 1, y2 + pState->xPos);
+
+                    GFX_ClippedPixelPut(x1 - pState->xPos, y2 + pState->yPos - 1); // 3rd quadrant
+                    GFX_ClippedPixelPut(x1 - pState->xPos, y2 + pState->yPos + 1);
+                    GFX_ClippedPixelPut(x1 - pState->yPos + 1, y2 + pState->xPos);
+                    GFX_ClippedPixelPut(x1 - pState->yPos - 1, y2 + pState->xPos);
+
+                    GFX_ClippedPixelPut(x1 - pState->yPos + 1, y1 - pState->xPos); // 4th quadrant
+                    GFX_ClippedPixelPut(x1 - pState->yPos - 1, y1 - pState->xPos);
+                    GFX_ClippedPixelPut(x1 - pState->xPos, y1 - pState->yPos + 1);
+                    GFX_ClippedPixelPut(x1 - pState->xPos, y1 - pState->yPos - 1);                    
                 }
-                state = GFX_BEVEL_RADIUS_ERROR_EVAL_STATE;
+                pState->state = GFX_BEVEL_RADIUS_ERROR_EVAL_STATE;
                 // no break here, to go through the next state
 
             case GFX_BEVEL_RADIUS_ERROR_EVAL_STATE:
-                if(error > 0)
+                if(pState->error > 0)
                 {
-                    yPos--;
-                    error += 5 + ((xPos - yPos) << 1);
+                    pState->yPos--;
+                    pState->error += 5 + ((pState->xPos - pState->yPos) * 2);
                 }
                 else
                 {
-                    error += 3 + (xPos << 1);
+                    pState->error += 3 + (pState->xPos << 1);
                 }
-                xPos++;
-                state = GFX_BEVEL_RADIUS_EVAL_STATE;
+                pState->xPos++;
+                pState->state = GFX_BEVEL_RADIUS_EVAL_STATE;
                 break;
 
             /* &&&&&&&&&&&&&&&&&&&&&&&&&&&& */
@@ -2623,12 +4732,12 @@ GFX_STATUS __attribute__((weak)) GFX_BevelDraw(   uint16_t x1, uint16_t y1,
                     // draw top
                     if (GFX_LineDraw(x1, y1 - rad, x2, y1 - rad) == GFX_STATUS_FAILURE)
                         return (GFX_STATUS_FAILURE);
-                    state = GFX_BEVEL_LINE_BOTTOM_DRAW_STATE;
+                    pState->state = GFX_BEVEL_LINE_BOTTOM_DRAW_STATE;
                     // no break here, to go through the next state
                 }
                 else
                 {
-                    state = GFX_BEVEL_LINE_LEFT_DRAW_STATE;
+                    pState->state = GFX_BEVEL_LINE_LEFT_DRAW_STATE;
                     break;
                 }
 
@@ -2636,7 +4745,7 @@ GFX_STATUS __attribute__((weak)) GFX_BevelDraw(   uint16_t x1, uint16_t y1,
                 // draw bottom
                 if (GFX_LineDraw(x1, y2 + rad, x2, y2 + rad) == GFX_STATUS_FAILURE)
                     return (GFX_STATUS_FAILURE);
-                state = GFX_BEVEL_LINE_LEFT_DRAW_STATE;
+                pState->state = GFX_BEVEL_LINE_LEFT_DRAW_STATE;
                 // no break here, to go through the next state
 
             case GFX_BEVEL_LINE_LEFT_DRAW_STATE:
@@ -2645,7 +4754,7 @@ GFX_STATUS __attribute__((weak)) GFX_BevelDraw(   uint16_t x1, uint16_t y1,
                     // draw left
                     if (GFX_LineDraw(x1 - rad, y1, x1 - rad, y2) == GFX_STATUS_FAILURE)
                         return (GFX_STATUS_FAILURE);
-                    state = GFX_BEVEL_LINE_RIGHT_DRAW_STATE;
+                    pState->state = GFX_BEVEL_LINE_RIGHT_DRAW_STATE;
                     // no break here, to go through the next state
                 }
 
@@ -2653,7 +4762,48 @@ GFX_STATUS __attribute__((weak)) GFX_BevelDraw(   uint16_t x1, uint16_t y1,
                 // draw right
                 if (GFX_LineDraw(x2 + rad, y1, x2 + rad, y2) == GFX_STATUS_FAILURE)
                     return (GFX_STATUS_FAILURE);
-                state = GFX_BEVEL_IDLE_STATE;
+                pState->state = GFX_BEVEL_IDLE_STATE;
+                return (GFX_STATUS_SUCCESS);
+
+            case GFX_BEVEL_SPAN_DRAW_STATE:
+                // xPos counts the runs of the row already rendered
+                while (pState->yPos <= pState->xLimit)
+                {
+                    runCount = GFX_BevelRowRunsGet(x1, y1, x2, y2, rad, pState->yPos, run);
+
+                    // the rows between y1 and y2 are the same when the
+                    // hole follows the ring, the solid runs are rendered
+                    // once for all of them
+                    bottom = pState->yPos;
+                    if ((pState->type == 0) && (rad >= 2) && (bottom == (int16_t)y1))
+                        bottom = y2;
+
+                    for (; pState->xPos < runCount; pState->xPos++)
+                    {
+#ifndef GFX_CONFIG_ALPHABLEND_DISABLE
+                        if (pState->type)
+                        {
+                            GFX_BevelRunBlend(
+                                    x1, y1, x2, y2, rad,
+                                    run[pState->xPos << 1],
+                                    run[(pState->xPos << 1) + 1],
+                                    pState->yPos);
+                            continue;
+                        }
+#endif
+                        if (GFX_SpanBarDraw(
+                                    run[pState->xPos << 1],
+                                    pState->yPos,
+                                    run[(pState->xPos << 1) + 1],
+                                    bottom) == GFX_STATUS_FAILURE)
+                        {
+                            return (GFX_STATUS_FAILURE);
+                        }
+                    }
+                    pState->xPos = 0;
+                    pState->yPos = bottom + 1;
+                }
+                pState->state = GFX_BEVEL_IDLE_STATE;
                 return (GFX_STATUS_SUCCESS);
 
             default:
@@ -2684,7 +4834,7 @@ GFX_STATUS __attribute__((weak)) GFX_BevelDraw(   uint16_t x1, uint16_t y1,
 // *****************************************************************************
 void __attribute__ ((always_inline)) GFX_BevelDrawTypeSet(GFX_BEVEL_RENDER_TYPE type)
 {
-    gfxBevelDrawType = type;
+    pGfxContext->bevelDrawType = type;
 }
 
 // *****************************************************************************
@@ -2702,7 +4852,7 @@ void __attribute__ ((always_inline)) GFX_BevelDrawTypeSet(GFX_BEVEL_RENDER_TYPE
 // *****************************************************************************
 GFX_BEVEL_RENDER_TYPE __attribute__ ((always_inline)) GFX_BevelDrawTypeGet(void)
 {
-    return (gfxBevelDrawType);
+    return (pGfxContext->bevelDrawType);
 }
 
 // *****************************************************************************
@@ -2916,7 +5066,7 @@ GFX_STATUS GFX_BevelFillDraw(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2,
             if(err > 0)
             {
                 xPos--;
-                err += 5 + ((yPos - xPos) << 1);
+                err += 5 + ((yPos - xPos) * 2);
             }
             else
                 err += 3 + (yPos << 1);
@@ -2996,35 +5146,15 @@ GFX_STATUS GFX_BevelFillDraw(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2,
 
 #else
 
-
-    typedef enum
-    {
-        FB_BEGIN,
-        FB_INIT_FILL,
-        FB_CHECK,
-        FB_Q8TOQ1,
-        FB_Q7TOQ2,
-        FB_Q6TOQ3,
-        FB_Q5TOQ4,
-        FB_DRAW_MISSING_1,
-        FB_DRAW_MISSING_2,
-        FB_WAITFORDONE,
-    } FB_FILLCIRCLE_STATES;
-
-    static int16_t err;
-    static int16_t yLimit, xPos, yPos;
-    static int16_t xCur, yCur, yNew;
-    static int16_t last54Y, last18Y;
+    GFX_BEVEL_FILL_DRAW_PARAM *pState = &(pGfxContext->bevelFill);
     PRIMITIVE_UINT32_UNION temp;
 
-    static FB_FILLCIRCLE_STATES state = FB_BEGIN;
-
     while(1)
     {
         if(GFX_RenderStatusGet() == GFX_STATUS_BUSY_BIT)
             return (GFX_STATUS_FAILURE);
 
-        switch(state)
+        switch(pState->state)
         {
             case FB_BEGIN:
 
@@ -3044,14 +5174,14 @@ GFX_STATUS GFX_BevelFillDraw(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2,
                     if (GFX_BarDraw(x1 - rad, y1 + ((y2 - y1) >> 1), x2 + rad, y2) == GFX_STATUS_FAILURE)
                         return (GFX_STATUS_FAILURE);
                 }
-                state = FB_INIT_FILL;
+                pState->state = FB_INIT_FILL;
                 break;
 
             case FB_INIT_FILL:
 
                 if(!rad)
                 {   // no radius object is a filled rectangle
-                    state = FB_WAITFORDONE;
+                    pState->state = FB_WAITFORDONE;
                     break;
                 }
 
@@ -3059,77 +5189,77 @@ GFX_STATUS GFX_BevelFillDraw(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2,
                 temp.uint32Value = SIN45 * rad;
                 // The + 1 in the limit is added to make the circle look less jagged
                 // when rendering with small radius
-                yLimit = temp.uint3216BitValue[1] + 1;
+                pState->yLimit = temp.uint3216BitValue[1] + 1;
                 temp.uint32Value = (uint32_t) (ONEP25 - ((int32_t) rad << 16));
-                err = (int16_t) (temp.uint3216BitValue[1]);
-                xPos = rad;
-                yPos = 0;
+                pState->err = (int16_t) (temp.uint3216BitValue[1]);
+                pState->xPos = rad;
+                pState->yPos = 0;
 
                 // yCur starts at 1 so the center line is not drawn and will be drawn separately
                 // this is to avoid rendering twice on the same line
-                yCur = 1;
-                xCur = xPos;
-                yNew = yPos;
+                pState->yCur = 1;
+                pState->xCur = pState->xPos;
+                pState->yNew = pState->yPos;
 
                 // note initial values are important
-                last54Y = GFX_MaxYGet();
-                last18Y = 0;
+                pState->last54Y = GFX_MaxYGet();
+                pState->last18Y = 0;
 
-                state = FB_CHECK;
+                pState->state = FB_CHECK;
 
             case FB_CHECK:
 
                 // check first for limits
-                if(yPos > yLimit)
+                if(pState->yPos > pState->yLimit)
                 {
                     if (rad)
-                        state = FB_DRAW_MISSING_1;
+                        pState->state = FB_DRAW_MISSING_1;
                     else
-                        state = FB_WAITFORDONE;
+                        pState->state = FB_WAITFORDONE;
                     break;
                 }
 
                 // yNew records the last y position
-                yNew = yPos;
+                pState->yNew = pState->yPos;
 
                 // calculate the next value of x and y
-                if(err > 0)
+                if(pState->err > 0)
                 {
-                    xPos--;
-                    err += 5 + ((yPos - xPos) << 1);
+                    pState->xPos--;
+                    pState->err += 5 + ((pState->yPos - pState->xPos) * 2);
                 }
                 else
-                    err += 3 + (yPos << 1);
-                yPos++;
-                state = FB_Q6TOQ3;
+                    pState->err += 3 + (pState->yPos << 1);
+                pState->yPos++;
+                pState->state = FB_Q6TOQ3;
 
             case FB_Q6TOQ3:
 
-                if (xCur != xPos)
+                if (pState->xCur != pState->xPos)
                 {
                     // 6th octant to 3rd octant
                     if (GFX_BevelDrawTypeGet() & GFX_DRAW_BOTTOMBEVEL)
                     {
                         // check first if there will be an overlap
-                        if (y2 + yNew >= last54Y)
+                        if (y2 + pState->yNew >= pState->last54Y)
                         {
-                            if ((y2 + yCur) <= (last54Y - 1))
+                            if ((y2 + pState->yCur) <= (pState->last54Y - 1))
                             {
-                                if (GFX_BarDraw(x1 - xCur, y2 + yCur, x2 + xCur, last54Y - 1) == GFX_STATUS_FAILURE)
+                                if (GFX_BarDraw(x1 - pState->xCur, y2 + pState->yCur, x2 + pState->xCur, pState->last54Y - 1) == GFX_STATUS_FAILURE)
                                     return (GFX_STATUS_FAILURE);
                             }
                         }
                         else
                         {
-                            if (GFX_BarDraw(x1 - xCur, y2 + yCur, x2 + xCur, y2 + yNew) == GFX_STATUS_FAILURE)
+                            if (GFX_BarDraw(x1 - pState->xCur, y2 + pState->yCur, x2 + pState->xCur, y2 + pState->yNew) == GFX_STATUS_FAILURE)
                                 return (GFX_STATUS_FAILURE);
                         }
                     }
-                    state = FB_Q5TOQ4;
+                    pState->state = FB_Q5TOQ4;
                     break;
                 }
 
-                state = FB_CHECK;
+                pState->state = FB_CHECK;
                 break;
 
             case FB_Q5TOQ4:
@@ -3139,15 +5269,15 @@ GFX_STATUS GFX_BevelFillDraw(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2,
 
    	            // 5th octant to 4th octant
                     // check: if overlapping then no need to proceed
-                    if ((y2 + xCur) > (y2 + yNew))
+                    if ((y2 + pState->xCur) > (y2 + pState->yNew))
                     {
-                        if (GFX_BarDraw(x1 - yNew, y2 + xCur, x2 + yNew, y2 + xCur) == GFX_STATUS_FAILURE)
+                        if (GFX_BarDraw(x1 - pState->yNew, y2 + pState->xCur, x2 + pState->yNew, y2 + pState->xCur) == GFX_STATUS_FAILURE)
                             return (GFX_STATUS_FAILURE);
-                        last54Y = (y2 + xCur);
+                        pState->last54Y = (y2 + pState->xCur);
                     }
                 }
 
-                state = FB_Q7TOQ2;
+                pState->state = FB_Q7TOQ2;
                 break;
 
             case FB_Q7TOQ2:
@@ -3156,21 +5286,21 @@ GFX_STATUS GFX_BevelFillDraw(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2,
 	        if (GFX_BevelDrawTypeGet() & GFX_DRAW_TOPBEVEL)
 		{
                     // check: if overlapping then no need to proceed
-                    if (y1 - yNew <= last18Y)
+                    if (y1 - pState->yNew <= pState->last18Y)
                     {
-                        if ((last18Y + 1) <= (y1 - yCur))
+                        if ((pState->last18Y + 1) <= (y1 - pState->yCur))
                         {
-                            if (GFX_BarDraw(x1 - xCur, last18Y + 1, x2 + xCur, y1 - yCur) == GFX_STATUS_FAILURE)
+                            if (GFX_BarDraw(x1 - pState->xCur, pState->last18Y + 1, x2 + pState->xCur, y1 - pState->yCur) == GFX_STATUS_FAILURE)
                                 return (GFX_STATUS_FAILURE);
                         }
                     }
                     else
                     {
-                        if (GFX_BarDraw(x1 - xCur, y1 - yNew, x2 + xCur, y1 - yCur) == GFX_STATUS_FAILURE)
+                        if (GFX_BarDraw(x1 - pState->xCur, y1 - pState->yNew, x2 + pState->xCur, y1 - pState->yCur) == GFX_STATUS_FAILURE)
                             return (GFX_STATUS_FAILURE);
                     }
                 }
-                state = FB_Q8TOQ1;
+                pState->state = FB_Q8TOQ1;
                 break;
 
             case FB_Q8TOQ1:
@@ -3179,50 +5309,50 @@ GFX_STATUS GFX_BevelFillDraw(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2,
                 if (GFX_BevelDrawTypeGet() & GFX_DRAW_TOPBEVEL)
 		{
                     // check first if there will be an overlap
-                    if ((y1 - xCur) < (y1 - yNew))
+                    if ((y1 - pState->xCur) < (y1 - pState->yNew))
                     {
-    	                if (GFX_BarDraw(x1 - yNew, y1 - xCur, x2 + yNew, y1 - xCur) == GFX_STATUS_FAILURE)
+    	                if (GFX_BarDraw(x1 - pState->yNew, y1 - pState->xCur, x2 + pState->yNew, y1 - pState->xCur) == GFX_STATUS_FAILURE)
                             return (GFX_STATUS_FAILURE);
-                        last18Y = y1 - xCur;
+                        pState->last18Y = y1 - pState->xCur;
                     }
 
                 }
                 // update current values
-                xCur = xPos;
-                yCur = yPos;
+                pState->xCur = pState->xPos;
+                pState->yCur = pState->yPos;
 
-                state = FB_CHECK;
+                pState->state = FB_CHECK;
                 break;
 
             case FB_DRAW_MISSING_1:
                 // check only one side since they are the same
-                if ((y1 - yNew) > (y1 - xPos))
+                if ((y1 - pState->yNew) > (y1 - pState->xPos))
                 {
                     // there is a missing line, draw that line
                     if (GFX_BevelDrawTypeGet() & GFX_DRAW_TOPBEVEL)
-                        if (GFX_BarDraw(x1 - yNew, y1 - xPos, x2 + yNew, y1 - xPos) == GFX_STATUS_FAILURE)
+                        if (GFX_BarDraw(x1 - pState->yNew, y1 - pState->xPos, x2 + pState->yNew, y1 - pState->xPos) == GFX_STATUS_FAILURE)
                             return (GFX_STATUS_FAILURE);
 
-                    state = FB_DRAW_MISSING_2;
+                    pState->state = FB_DRAW_MISSING_2;
                 }
                 else
-                    state = FB_WAITFORDONE;
+                    pState->state = FB_WAITFORDONE;
                 break;
 
             case FB_DRAW_MISSING_2:
-                if ((y2 + yNew) < (y2 + xPos))
+                if ((y2 + pState->yNew) < (y2 + pState->xPos))
                 {
                     if (GFX_BevelDrawTypeGet() & GFX_DRAW_BOTTOMBEVEL)
-                        if (GFX_BarDraw(x1 - yNew, y2 + xPos, x2 + yNew, y2 + xPos) == GFX_STATUS_FAILURE)
+                        if (GFX_BarDraw(x1 - pState->yNew, y2 + pState->xPos, x2 + pState->yNew, y2 + pState->xPos) == GFX_STATUS_FAILURE)
                             return (GFX_STATUS_FAILURE);
                 }
-                state = FB_WAITFORDONE;
+                pState->state = FB_WAITFORDONE;
 
             case FB_WAITFORDONE:
                 if(GFX_RenderStatusGet() == GFX_STATUS_BUSY_BIT)
                     return (GFX_STATUS_FAILURE);
 
-                state = FB_BEGIN;
+                pState->state = FB_BEGIN;
                 return (GFX_STATUS_SUCCESS);
 
         }           // end of switch
@@ -3297,7 +5427,7 @@ GFX_STATUS __attribute__((weak)) GFX_DRV_TextCharRender(GFX_XCHAR ch)
 // *****************************************************************************
 GFX_STATUS __attribute__((weak)) GFX_FontSet(GFX_RESOURCE_HDR *pFont)
 {
-    pGfxCurrentFont = pFont;
+    pGfxContext->pFont = pFont;
     GFX_DRV_FontSet (pFont);
     return (GFX_STATUS_SUCCESS);
 }
@@ -3318,7 +5448,7 @@ GFX_STATUS __attribute__((weak)) GFX_FontSet(GFX_RESOURCE_HDR *pFont)
 // *****************************************************************************
 inline GFX_RESOURCE_HDR* __attribute__ ((always_inline)) GFX_FontGet(void)
 {
-    return (pGfxCurrentFont);
+    return (pGfxContext->pFont);
 }
 
 // *****************************************************************************
@@ -3336,7 +5466,7 @@ inline GFX_RESOURCE_HDR* __attribute__ ((always_inline)) GFX_FontGet(void)
 // *****************************************************************************
 inline GFX_STATUS __attribute__ ((always_inline)) GFX_FontAntiAliasSet(GFX_FONT_ANTIALIAS_TYPE type)
 {
-    gfxTextAntiAliasType = type;
+    pGfxContext->textAntiAliasType = type;
     return (GFX_STATUS_SUCCESS);
 }
 
@@ -3356,7 +5486,7 @@ inline GFX_STATUS __attribute__ ((always_inline)) GFX_FontAntiAliasSet(GFX_FONT_
 // *****************************************************************************
 inline GFX_FONT_ANTIALIAS_TYPE __attribute__ ((always_inline)) GFX_FontAntiAliasGet(void)
 {
-    return gfxTextAntiAliasType;
+    return pGfxContext->textAntiAliasType;
 }
 
 #ifndef GFX_CONFIG_FONT_ANTIALIASED_DISABLE
@@ -3384,27 +5514,27 @@ static void __attribute__((always_inline)) GFX_CalculateColors(void)
     
 #if (GFX_CONFIG_COLOR_DEPTH == 16) || (GFX_CONFIG_COLOR_DEPTH == 24)
 
-    gfx_TextForegroundColor50  = GFX_Color50Convert(gfx_TextForegroundColor100);
-    gfx_TextForegroundColor25  = GFX_Color25Convert(gfx_TextForegroundColor100);
-    gfx_TextForegroundColor75  = gfx_TextForegroundColor50 +
-                                 gfx_TextForegroundColor25;
+    gfx_TextForegroundColor50  = GFX_Color50Convert(pGfxContext->textForegroundColor100);
+    pGfxContext->textForegroundColor25  = GFX_Color25Convert(pGfxContext->textForegroundColor100);
+    pGfxContext->textForegroundColor75  = gfx_TextForegroundColor50 +
+                                 pGfxContext->textForegroundColor25;
 
-    gfx_TextBackgroundColor50  = GFX_Color50Convert(gfx_TextBackgroundColor100);
-    gfx_TextBackgroundColor25  = GFX_Color25Convert(gfx_TextBackgroundColor100);
-    gfx_TextBackgroundColor75  = gfx_TextBackgroundColor50 +
-                                 gfx_TextBackgroundColor25;
+    gfx_TextBackgroundColor50  = GFX_Color50Convert(pGfxContext->textBackgroundColor100);
+    pGfxContext->textBackgroundColor25  = GFX_Color25Convert(pGfxContext->textBackgroundColor100);
+    pGfxContext->textBackgroundColor75  = gfx_TextBackgroundColor50 +
+                                 pGfxContext->textBackgroundColor25;
 
 #elif ((GFX_CONFIG_COLOR_DEPTH == 8) || (GFX_CONFIG_COLOR_DEPTH == 4))
         
-    gfx_TextForegroundColor50  = gfx_TextForegroundColor100 >> 1;
-    gfx_TextForegroundColor25  = gfx_TextForegroundColor50  >> 1;
-    gfx_TextForegroundColor75  = gfx_TextForegroundColor50 +
-                                 gfx_TextForegroundColor25;
+    gfx_TextForegroundColor50  = pGfxContext->textForegroundColor100 >> 1;
+    pGfxContext->textForegroundColor25  = gfx_TextForegroundColor50  >> 1;
+    pGfxContext->textForegroundColor75  = gfx_TextForegroundColor50 +
+                                 pGfxContext->textForegroundColor25;
 
-    gfx_TextBackgroundColor50  = gfx_TextBackgroundColor100 >> 1;
-    gfx_TextBackgroundColor25  = gfx_TextBackgroundColor50  >> 1;
-    gfx_TextBackgroundColor75  = gfx_TextBackgroundColor50 +
-                                 gfx_TextBackgroundColor25;
+    gfx_TextBackgroundColor50  = pGfxContext->textBackgroundColor100 >> 1;
+    pGfxContext->textBackgroundColor25  = gfx_TextBackgroundColor50  >> 1;
+    pGfxContext->textBackgroundColor75  = gfx_TextBackgroundColor50 +
+                                 pGfxContext->textBackgroundColor25;
 
     #warning "Antialiasing at 8BPP and 4BPP is supported only for Grayscale mode"
         
@@ -3413,8 +5543,8 @@ static void __attribute__((always_inline)) GFX_CalculateColors(void)
     #error "Anit-aliasing is currently supported only in 8BPP Grayscale and 16BPP, 24BPP color modes"
     
 #endif
-    gfx_TextForegroundColor25 += gfx_TextBackgroundColor75;
-    gfx_TextForegroundColor75 += gfx_TextBackgroundColor25;
+    pGfxContext->textForegroundColor25 += pGfxContext->textBackgroundColor75;
+    pGfxContext->textForegroundColor75 += pGfxContext->textBackgroundColor25;
 }
 
 #endif //#ifndef GFX_CONFIG_FONT_ANTIALIASED_DISABLE
@@ -3445,24 +5575,24 @@ void GFX_TextCharInfoFlashGet(
 
     // set color depth of font,
     // based on 2^bpp where bpp is the color depth setting in the GFX_FONT_HEADER
-    pParam->bpp = 1 << pGfxCurrentFont->resource.font.header.bpp;
+    pParam->bpp = 1 << pGfxContext->pFont->resource.font.header.bpp;
 
-    if(pGfxCurrentFont->resource.font.header.extendedGlyphEntry)
+    if(pGfxContext->pFont->resource.font.header.extendedGlyphEntry)
     {
         // font used has extended glyph, get info on the character
         pChTableExtended = (GFX_FONT_SPACE GFX_FONT_GLYPH_ENTRY_EXTENDED *)
                            (
-                                pGfxCurrentFont->resource.font.location.progByteAddress +
+                                pGfxContext->pFont->resource.font.location.progByteAddress +
                                 sizeof(GFX_FONT_HEADER)
                            ) 
                            +
                            (
                                 (GFX_UXCHAR)ch -
-                                (GFX_UXCHAR)pGfxCurrentFont->resource.font.header.firstChar
+                                (GFX_UXCHAR)pGfxContext->pFont->resource.font.header.firstChar
                            );
         pParam->pChImage = (GFX_FONT_SPACE uint8_t *)
                            (
-                                pGfxCurrentFont->resource.font.location.progByteAddress +
+                                pGfxContext->pFont->resource.font.location.progByteAddress +
                                 pChTableExtended->offset
                            );
 
@@ -3489,16 +5619,16 @@ void GFX_TextCharInfoFlashGet(
         // font used is normal font, get info on the character
         pChTable = (GFX_FONT_SPACE GFX_FONT_GLYPH_ENTRY *) 
                         (
-                            pGfxCurrentFont->resource.font.location.progByteAddress +
+                            pGfxContext->pFont->resource.font.location.progByteAddress +
                             sizeof(GFX_FONT_HEADER)
                         ) +
                         (
                             (GFX_UXCHAR)ch -
-                            (GFX_UXCHAR)pGfxCurrentFont->resource.font.header.firstChar
+                            (GFX_UXCHAR)pGfxContext->pFont->resource.font.header.firstChar
                         );
 
         pParam->pChImage = (GFX_FONT_SPACE uint8_t *) 
-                        ( pGfxCurrentFont->resource.font.location.progByteAddress +
+                        ( pGfxContext->pFont->resource.font.location.progByteAddress +
                         (
                             (uint32_t)(pChTable->offsetMSB) << 8) +
                             pChTable->offsetLSB
@@ -3541,17 +5671,17 @@ void GFX_TextCharInfoExternalGet(
 
     // set color depth of font,
     // based on 2^bpp where bpp is the color depth setting in the GFX_FONT_HEADER
-    pParam->bpp = 1 << pGfxCurrentFont->resource.font.header.bpp;
+    pParam->bpp = 1 << pGfxContext->pFont->resource.font.header.bpp;
        
-    if(pGfxCurrentFont->resource.font.header.extendedGlyphEntry)
+    if(pGfxContext->pFont->resource.font.header.extendedGlyphEntry)
     {
-        temp  = (GFX_UXCHAR)ch - (GFX_UXCHAR)pGfxCurrentFont->resource.font.header.firstChar;
+        temp  = (GFX_UXCHAR)ch - (GFX_UXCHAR)pGfxContext->pFont->resource.font.header.firstChar;
         temp *= sizeof(GFX_FONT_GLYPH_ENTRY_EXTENDED);
         temp += sizeof(GFX_FONT_HEADER);
 
-        GFX_ExternalResourceCallback
+        GFX_ExternalResourceRead
         (
-            pGfxCurrentFont,
+            pGfxContext->pFont,
             temp,
 //            sizeof(GFX_FONT_HEADER) +
 //                    (((GFX_UXCHAR)ch - (GFX_UXCHAR)pGfxCurrentFont->resource.font.header.firstChar) * sizeof(GFX_FONT_GLYPH_ENTRY_EXTENDED)),
@@ -3577,10 +5707,10 @@ void GFX_TextCharInfoExternalGet(
     else
     {
         // get glyph entry
-        GFX_ExternalResourceCallback
+        GFX_ExternalResourceRead
         (
-            pGfxCurrentFont,
-            sizeof(GFX_FONT_HEADER) + ((GFX_UXCHAR)ch - (GFX_UXCHAR)pGfxCurrentFont->resource.font.header.firstChar) * sizeof(GFX_FONT_GLYPH_ENTRY),
+            pGfxContext->pFont,
+            sizeof(GFX_FONT_HEADER) + ((GFX_UXCHAR)ch - (GFX_UXCHAR)pGfxContext->pFont->resource.font.header.firstChar) * sizeof(GFX_FONT_GLYPH_ENTRY),
             sizeof(GFX_FONT_GLYPH_ENTRY),
             &chTable
         );
@@ -3595,9 +5725,9 @@ void GFX_TextCharInfoExternalGet(
     imageSize += (pParam->chEffectiveGlyphWidth >> 3);
 
     // glyph image size
-    imageSize *= pGfxCurrentFont->resource.font.header.height;
+    imageSize *= pGfxContext->pFont->resource.font.header.height;
 
-    if(pGfxCurrentFont->resource.font.header.extendedGlyphEntry)
+    if(pGfxContext->pFont->resource.font.header.extendedGlyphEntry)
     {
         glyphOffset.uint32Value = chTableExtended.offset;
     }
@@ -3608,7 +5738,7 @@ void GFX_TextCharInfoExternalGet(
         glyphOffset.uint3216BitValue[0] = (chTable.offsetMSB << 8) + (chTable.offsetLSB);
     }
             
-    GFX_ExternalResourceCallback(pGfxCurrentFont, glyphOffset.uint32Value, imageSize, &(pParam->chImage));
+    GFX_ExternalResourceRead(pGfxContext->pFont, glyphOffset.uint32Value, imageSize, &(pParam->chImage));
     pParam->pChImage = (uint8_t *) &(pParam->chImage);
 
 #endif //#ifndef GFX_CONFIG_FONT_EXTERNAL_DISABLE
@@ -3627,7 +5757,12 @@ void GFX_TextCharInfoExternalGet(
 *
 * Side Effects: none
 *
-* Overview: Performs the actual rendering of the character using PutPixel().
+* Overview: Performs the actual rendering of the character. Each glyph
+*           row is clipped once to the text area and the frame buffer,
+*           then decoded into spans of pixels that are rendered using
+*           GFX_PixelArrayPut(). For anti-aliased glyphs in translucent
+*           mode the background of the row is retrieved once with
+*           GFX_PixelArrayGet() and the glyph is blended into it.
 *
 * Note: Application should not call this function. This function is for 
 *       versatility of implementing hardware accelerated text rendering
@@ -3638,12 +5773,12 @@ GFX_STATUS GFX_TextCharRender(
                                 GFX_XCHAR ch,
                                 GFX_FONT_OUTCHAR *pParam)
 {
-    uint8_t     temp = 0;
-    uint8_t     mask;
-    uint8_t     restoremask;
+    GFX_FONT_SPACE uint8_t *pRow;
+    uint8_t     restoremask, val;
+    uint16_t    rowBytes;
     int16_t     xCnt, yCnt, x = 0, y, fontHeight;
+    int16_t     xStart, xFirst, xLast, spanStart, spanLength;
 #ifndef GFX_CONFIG_FONT_ANTIALIASED_DISABLE
-    uint8_t     val, shift;
     GFX_COLOR   bgcolor;
 #endif
 
@@ -3669,118 +5804,206 @@ GFX_STATUS GFX_TextCharRender(
                                 GFX_TextCursorPositionYGet() + (fontHeight >> 1)
                               );
         
-        if((gfx_TextForegroundColor100 != GFX_ColorGet()) ||
-           (gfx_TextBackgroundColor100 != bgcolor))
+        if((pGfxContext->textForegroundColor100 != GFX_ColorGet()) ||
+           (pGfxContext->textBackgroundColor100 != bgcolor))
         {
-            gfx_TextForegroundColor100 = GFX_ColorGet();
-            gfx_TextBackgroundColor100 = bgcolor;
+            pGfxContext->textForegroundColor100 = GFX_ColorGet();
+            pGfxContext->textBackgroundColor100 = bgcolor;
             GFX_CalculateColors();
         }
     }
 #else
     restoremask = 0x01;
 #endif
-    
+
+    // glyph rows are byte aligned
+    rowBytes = (pParam->chGlyphWidth * pParam->bpp + 7) >> 3;
+
+    // clip the glyph columns to the text region and the frame buffer,
+    // the clipping is the same for all the rows of the glyph
+    xStart = GFX_TextCursorPositionXGet() + pParam->xAdjust;
+    xFirst = 0;
+    xLast  = pParam->chGlyphWidth - 1;
+
+    if (xStart + xFirst <= (int16_t)GFX_TextAreaLeftGet())
+        xFirst = (int16_t)GFX_TextAreaLeftGet() + 1 - xStart;
+    if (xStart + xFirst < 0)
+        xFirst = -xStart;
+    if (xStart + xLast >= (int16_t)GFX_TextAreaRightGet())
+        xLast = (int16_t)GFX_TextAreaRightGet() - 1 - xStart;
+    if (xStart + xLast > (int16_t)GFX_MaxXGet())
+        xLast = (int16_t)GFX_MaxXGet() - xStart;
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+    if (xStart + xFirst < (int16_t)GFX_ClipGet()->left)
+        xFirst = (int16_t)GFX_ClipGet()->left - xStart;
+    if (xStart + xLast > (int16_t)GFX_ClipGet()->right)
+        xLast = (int16_t)GFX_ClipGet()->right - xStart;
+#endif
+
+#ifndef GFX_CONFIG_FONT_ANTIALIASED_DISABLE
+    if (pParam->bpp == 1)
+#endif
+    {
+        // 1 bpp spans are all rendered with the current color
+        for(xCnt = xFirst; xCnt <= xLast; xCnt++)
+            gfxLineBuffer0[xCnt - xFirst] = GFX_ColorGet();
+    }
+
     y = GFX_TextCursorPositionYGet() + pParam->yAdjust;
 
     for(yCnt = 0; yCnt < fontHeight + pParam->heightOvershoot; yCnt++)
     {
-
-        x = GFX_TextCursorPositionXGet() + pParam->xAdjust;
-        mask = 0;
+        pRow = pParam->pChImage;
+        pParam->pChImage += rowBytes;
+        x = xStart + pParam->chGlyphWidth;
+
+        // check if the row is in the text region
+        if (    (GFX_TextAreaTopGet()    >= y) ||
+                (GFX_TextAreaBottomGet() <= y) ||
+                (y < 0) || (y > (int16_t)GFX_MaxYGet())
+           )
+        {
+            y++;
+            continue;
+        }
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+        if ((y < (int16_t)GFX_ClipGet()->top) || (y > (int16_t)GFX_ClipGet()->bottom))
+        {
+            y++;
+            continue;
+        }
+#endif
 
 #ifndef GFX_CONFIG_FONT_ANTIALIASED_DISABLE
-        shift = 0;
+        if (pParam->bpp == 1)
 #endif
-
-        for(xCnt = 0; xCnt < pParam->chGlyphWidth; xCnt++)
         {
-
-            if(mask == 0)
+            // render the runs of set pixels
+            for(xCnt = xFirst; xCnt <= xLast; )
             {
-                temp = *(pParam->pChImage)++;
-                mask = restoremask;
+                if ((pRow[xCnt >> 3] & (0x01 << (xCnt & 0x07))) == 0)
+                {
+                    xCnt++;
+                    continue;
+                }
+
+                spanStart = xCnt;
+                while ((xCnt <= xLast) &&
+                       (pRow[xCnt >> 3] & (0x01 << (xCnt & 0x07))))
+                {
+                    xCnt++;
+                }
+                spanLength = xCnt - spanStart;
 
+                if (spanLength == 1)
+                    GFX_PixelPut(xStart + spanStart, y);
+                else
+                    GFX_PixelArrayPut(  xStart + spanStart, y,
+                                        gfxLineBuffer0, spanLength);
+            }
+        }
 #ifndef GFX_CONFIG_FONT_ANTIALIASED_DISABLE
-                shift = 0;
-#endif
+        else if(GFX_FontAntiAliasGet() == GFX_FONT_ANTIALIAS_TRANSLUCENT)
+        {
+            // the span is bounded by the first and last non-zero pixels
+            for(spanStart = xFirst; spanStart <= xLast; spanStart++)
+            {
+                if ((pRow[spanStart >> 2] >> ((spanStart & 0x03) << 1)) & restoremask)
+                    break;
             }
+            for(xCnt = xLast; xCnt >= spanStart; xCnt--)
+            {
+                if ((pRow[xCnt >> 2] >> ((xCnt & 0x03) << 1)) & restoremask)
+                    break;
+            }
+            spanLength = xCnt - spanStart + 1;
 
-            // check if the pixel is in the text region
-            if (
-                    (   (GFX_TextAreaLeftGet()   < x) &&
-                        (GFX_TextAreaRightGet()  > x)
-                    )
-                    &&
-                    (   (GFX_TextAreaTopGet()    < y) &&
-                        (GFX_TextAreaBottomGet() > y)
-                    )
-               )
+            if (spanLength > 0)
             {
+                // retrieve the background once and blend the glyph into it
+                GFX_PixelArrayGet(  xStart + spanStart, y,
+                                    gfxLineBuffer0, spanLength);
 
-#ifndef GFX_CONFIG_FONT_ANTIALIASED_DISABLE
-                if (pParam->bpp == 1)
+                for(xCnt = 0; xCnt < spanLength; xCnt++)
                 {
-                    if (temp & mask)
+                    val = (pRow[(spanStart + xCnt) >> 2] >>
+                            (((spanStart + xCnt) & 0x03) << 1)) & restoremask;
+                    if (val == 0)
+                        continue;
+
+                    bgcolor = gfxLineBuffer0[xCnt];
+                    if(pGfxContext->textBackgroundColor100 != bgcolor)
+                    {
+                        pGfxContext->textBackgroundColor100 = bgcolor;
+                        GFX_CalculateColors();
+                    }
+
+                    switch(val)
                     {
-                        GFX_PixelPut(x, y);
+                        case 1:
+                            gfxLineBuffer0[xCnt] = pGfxContext->textForegroundColor25;
+                            break;
+                        case 2:
+                            gfxLineBuffer0[xCnt] = pGfxContext->textForegroundColor75;
+                            break;
+                        default:
+                            gfxLineBuffer0[xCnt] = pGfxContext->textForegroundColor100;
+                            break;
                     }
                 }
-                else
+
+                GFX_PixelArrayPut(  xStart + spanStart, y,
+                                    gfxLineBuffer0, spanLength);
+            }
+        }
+        else
+        {
+            // render the runs of non-zero pixels, the background
+            // color is fixed so no retrieval is needed
+            for(xCnt = xFirst; xCnt <= xLast; )
+            {
+                val = (pRow[xCnt >> 2] >> ((xCnt & 0x03) << 1)) & restoremask;
+                if (val == 0)
+                {
+                    xCnt++;
+                    continue;
+                }
+
+                spanStart = xCnt;
+                while (val != 0)
                 {
-                    val = (temp & mask) >> shift;
-                    if (val)
+                    switch(val)
                     {
-                        if(GFX_FontAntiAliasGet() == GFX_FONT_ANTIALIAS_TRANSLUCENT)
-                        {
-                            bgcolor = GFX_PixelGet(x, y);
-                            if(gfx_TextBackgroundColor100 != bgcolor)
-                            {
-                                gfx_TextBackgroundColor100 = bgcolor;
-                                GFX_CalculateColors();
-                            }
-                        }
+                        case 1:
+                            gfxLineBuffer0[xCnt - spanStart] = pGfxContext->textForegroundColor25;
+                            break;
+                        case 2:
+                            gfxLineBuffer0[xCnt - spanStart] = pGfxContext->textForegroundColor75;
+                            break;
+                        default:
+                            gfxLineBuffer0[xCnt - spanStart] = pGfxContext->textForegroundColor100;
+                            break;
+                    }
 
-                        switch(val)
-                        {
-                            case 1:
-                                GFX_ColorSet(gfx_TextForegroundColor25);
-                                break;
-
-                            case 2:
-                                GFX_ColorSet(gfx_TextForegroundColor75);
-                                break;
-
-                            case 3:
-                                GFX_ColorSet(gfx_TextForegroundColor100);
-                                break;
-                            default:
-                                // should not happen since this switch statement
-                                // is within if(val) statement.
-                                break;
-                        }
+                    if (++xCnt > xLast)
+                        break;
+                    val = (pRow[xCnt >> 2] >> ((xCnt & 0x03) << 1)) & restoremask;
+                }
+                spanLength = xCnt - spanStart;
 
-                        GFX_PixelPut(x, y);
-                    }
+                if (spanLength == 1)
+                {
+                    GFX_ColorSet(gfxLineBuffer0[0]);
+                    GFX_PixelPut(xStart + spanStart, y);
                 }
-#else
-                if(temp & mask)
+                else
                 {
-                    GFX_PixelPut(x, y);
+                    GFX_PixelArrayPut(  xStart + spanStart, y,
+                                        gfxLineBuffer0, spanLength);
                 }
+            }
+        }
 #endif
-            } // end of if statement to check if in rendering area
-
-#ifndef GFX_CONFIG_FONT_ANTIALIASED_DISABLE
-            mask  <<=  pParam->bpp;
-            shift  +=  pParam->bpp;
-#else
-            mask <<= 1;
-#endif
-            x++;
-
-        } // for(xCnt = 0; xCnt < pParam->chGlyphWidth; xCnt++)...
-
         y++;
     } // end of for(yCnt = 0; yCnt...
 
@@ -3794,21 +6017,384 @@ GFX_STATUS GFX_TextCharRender(
 #ifndef GFX_CONFIG_FONT_ANTIALIASED_DISABLE
     if(pParam->bpp > 1)
     {
-        GFX_ColorSet(gfx_TextForegroundColor100);
+        GFX_ColorSet(pGfxContext->textForegroundColor100);
     }
 #endif
     return (GFX_STATUS_SUCCESS);
 
 }
 
+#ifdef GFX_CONFIG_FONT_GLYPH_CACHE_SIZE
+
 // *****************************************************************************
 /*  Function:
-    GFX_STATUS GFX_TextCharDraw(
-                                GFX_XCHAR ch
-                               )
+    void GFX_FontGlyphCacheClear(void)
 
     Summary:
-        This function renders the given character using the
+        Removes all the glyphs from the glyph cache.
+
+    Description:
+        Removes all the glyphs from the glyph cache. Glyphs are
+        cached by font, character and colors. The application must
+        call this function when the contents of a font resource that
+        was already rendered is changed.
+
+*/
+// *****************************************************************************
+void GFX_FontGlyphCacheClear(void)
+{
+    uint16_t    i;
+
+    for(i = 0; i < GFX_CONFIG_FONT_GLYPH_CACHE_SIZE; i++)
+    {
+        gfxGlyphCache[i].pFont = NULL;
+        gfxGlyphCache[i].candidate = 0;
+    }
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_FONT_GLYPH_CACHE_ENTRY *GFX_TextCharCacheFind(
+                                GFX_RESOURCE_HDR *pFont,
+                                GFX_XCHAR ch)
+
+    Summary:
+        Looks up the glyph of the character in the glyph cache.
+
+    Description:
+        Looks up the glyph of the character rendered with the current
+        color. Anti-aliased glyphs are also looked up by the background
+        color at the text cursor position, since the colors of the
+        cached pixels are blended with it.
+
+        The cache is direct mapped: the font, character and colors are
+        hashed into a key and the glyph can only be kept in the entry
+        selected by the key, so a single entry is compared.
+
+        Returns the cached glyph or NULL when the glyph is not cached.
+
+*/
+// *****************************************************************************
+static GFX_FONT_GLYPH_CACHE_ENTRY *GFX_TextCharCacheFind(
+                                GFX_RESOURCE_HDR *pFont,
+                                GFX_XCHAR ch)
+{
+    GFX_FONT_GLYPH_CACHE_ENTRY *pEntry;
+
+    gfxGlyphCacheBackground = 0;
+
+#ifndef GFX_CONFIG_FONT_ANTIALIASED_DISABLE
+    if (pFont->resource.font.header.bpp != 0)
+    {
+        gfxGlyphCacheBackground = GFX_PixelGet(
+                                GFX_TextCursorPositionXGet(),
+                                GFX_TextCursorPositionYGet() +
+                                (GFX_TextStringHeightGet(pFont) >> 1));
+    }
+#endif
+
+    gfxGlyphCacheKey = (uint16_t)((size_t)pFont >> 1) +
+                       (uint16_t)ch * 31 +
+                       (uint16_t)GFX_ColorGet() * 7 +
+                       (uint16_t)gfxGlyphCacheBackground;
+
+    pEntry = &gfxGlyphCache[gfxGlyphCacheKey % GFX_CONFIG_FONT_GLYPH_CACHE_SIZE];
+    if (    (pEntry->pFont == pFont) &&
+            (pEntry->ch == ch) &&
+            (pEntry->foreground == GFX_ColorGet()) &&
+            (pEntry->background == gfxGlyphCacheBackground)
+       )
+    {
+        return (pEntry);
+    }
+    return (NULL);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_FONT_GLYPH_CACHE_ENTRY *GFX_TextCharCacheFill(
+                                GFX_RESOURCE_HDR *pFont,
+                                GFX_XCHAR ch,
+                                GFX_FONT_OUTCHAR *pParam)
+
+    Summary:
+        Decodes the glyph of the character into the glyph cache.
+
+    Description:
+        Decodes the glyph retrieved by GFX_TextCharInfoFlashGet() or
+        GFX_TextCharInfoExternalGet() into pixel rows rendered with
+        the current color and the background color found by
+        GFX_TextCharCacheFind(). The glyph is only decoded when the
+        entry selected by its key is free or when the same glyph
+        already missed that entry the last time it was looked up.
+        Glyphs drawn once are therefore not decoded, they are rendered
+        with GFX_TextCharRender() and do not evict the cached glyphs.
+
+        Returns the cached glyph or NULL when the glyph is not decoded
+        or is larger than GFX_CONFIG_FONT_GLYPH_CACHE_PIXELS.
+
+*/
+// *****************************************************************************
+static GFX_FONT_GLYPH_CACHE_ENTRY *GFX_TextCharCacheFill(
+                                GFX_RESOURCE_HDR *pFont,
+                                GFX_XCHAR ch,
+                                GFX_FONT_OUTCHAR *pParam)
+{
+    GFX_FONT_GLYPH_CACHE_ENTRY *pEntry;
+    GFX_FONT_SPACE uint8_t *pRow;
+    GFX_COLOR   color[4];
+    uint16_t    i, rowBytes;
+    int16_t     xCnt, yCnt, height;
+    uint8_t     val;
+
+    pEntry = &gfxGlyphCache[gfxGlyphCacheKey % GFX_CONFIG_FONT_GLYPH_CACHE_SIZE];
+
+    // keep the cached glyph until the new glyph is looked up again
+    if ((pEntry->pFont != NULL) && (pEntry->candidate != gfxGlyphCacheKey))
+    {
+        pEntry->candidate = gfxGlyphCacheKey;
+        return (NULL);
+    }
+
+    height = GFX_TextStringHeightGet(pFont) + pParam->heightOvershoot;
+
+    if ((pParam->bpp > 2) ||
+        ((int32_t)pParam->chGlyphWidth * height > GFX_CONFIG_FONT_GLYPH_CACHE_PIXELS))
+        return (NULL);
+
+    pEntry->pFont        = pFont;
+    pEntry->ch           = ch;
+    pEntry->foreground   = GFX_ColorGet();
+    pEntry->background   = gfxGlyphCacheBackground;
+    pEntry->bpp          = pParam->bpp;
+    pEntry->width        = pParam->chGlyphWidth;
+    pEntry->height       = height;
+    pEntry->xAdjust      = pParam->xAdjust;
+    pEntry->yAdjust      = pParam->yAdjust;
+    pEntry->xWidthAdjust = pParam->xWidthAdjust;
+
+    color[0] = pEntry->background;
+    color[1] = color[2] = color[3] = pEntry->foreground;
+
+#ifndef GFX_CONFIG_FONT_ANTIALIASED_DISABLE
+    if (pEntry->bpp == 2)
+    {
+        if((pGfxContext->textForegroundColor100 != pEntry->foreground) ||
+           (pGfxContext->textBackgroundColor100 != pEntry->background))
+        {
+            pGfxContext->textForegroundColor100 = pEntry->foreground;
+            pGfxContext->textBackgroundColor100 = pEntry->background;
+            GFX_CalculateColors();
+        }
+        color[1] = pGfxContext->textForegroundColor25;
+        color[2] = pGfxContext->textForegroundColor75;
+    }
+#endif
+
+    // glyph rows are byte aligned
+    rowBytes = (pEntry->width * pEntry->bpp + 7) >> 3;
+    pRow = pParam->pChImage;
+    i = 0;
+
+    for(yCnt = 0; yCnt < pEntry->height; yCnt++)
+    {
+        for(xCnt = 0; xCnt < pEntry->width; xCnt++)
+        {
+            if (pEntry->bpp == 1)
+                val = (pRow[xCnt >> 3] & (0x01 << (xCnt & 0x07))) ? 3 : 0;
+            else
+                val = (pRow[xCnt >> 2] >> ((xCnt & 0x03) << 1)) & 0x03;
+
+            pEntry->coverage[i] = val;
+            pEntry->pixel[i]    = color[val];
+            i++;
+        }
+        pRow += rowBytes;
+    }
+
+    return (pEntry);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_TextCharCacheRender(GFX_FONT_GLYPH_CACHE_ENTRY *pEntry)
+
+    Summary:
+        Renders a cached glyph at the text cursor position.
+
+    Description:
+        Renders a cached glyph at the text cursor position and moves
+        the text cursor. Each row is clipped to the text region and
+        the frame buffer and the runs of pixels are rendered directly
+        from the cache with GFX_PixelArrayPut(). In translucent
+        anti-aliasing mode the row is blended with the background
+        retrieved with GFX_PixelArrayGet().
+
+*/
+// *****************************************************************************
+static GFX_STATUS GFX_TextCharCacheRender(GFX_FONT_GLYPH_CACHE_ENTRY *pEntry)
+{
+    uint8_t     *pCoverage;
+    GFX_COLOR   *pPixel;
+    int16_t     xCnt, yCnt, y;
+    int16_t     xStart, xFirst, xLast, spanStart, spanLength;
+
+#ifndef GFX_CONFIG_FONT_ANTIALIASED_DISABLE
+    if (pEntry->bpp == 2)
+    {
+        if((pGfxContext->textForegroundColor100 != pEntry->foreground) ||
+           (pGfxContext->textBackgroundColor100 != pEntry->background))
+        {
+            pGfxContext->textForegroundColor100 = pEntry->foreground;
+            pGfxContext->textBackgroundColor100 = pEntry->background;
+            GFX_CalculateColors();
+        }
+    }
+#endif
+
+    // clip the glyph columns to the text region and the frame buffer
+    xStart = GFX_TextCursorPositionXGet() + pEntry->xAdjust;
+    xFirst = 0;
+    xLast  = pEntry->width - 1;
+
+    if (xStart + xFirst <= (int16_t)GFX_TextAreaLeftGet())
+        xFirst = (int16_t)GFX_TextAreaLeftGet() + 1 - xStart;
+    if (xStart + xFirst < 0)
+        xFirst = -xStart;
+    if (xStart + xLast >= (int16_t)GFX_TextAreaRightGet())
+        xLast = (int16_t)GFX_TextAreaRightGet() - 1 - xStart;
+    if (xStart + xLast > (int16_t)GFX_MaxXGet())
+        xLast = (int16_t)GFX_MaxXGet() - xStart;
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+    if (xStart + xFirst < (int16_t)GFX_ClipGet()->left)
+        xFirst = (int16_t)GFX_ClipGet()->left - xStart;
+    if (xStart + xLast > (int16_t)GFX_ClipGet()->right)
+        xLast = (int16_t)GFX_ClipGet()->right - xStart;
+#endif
+
+    y = GFX_TextCursorPositionYGet() + pEntry->yAdjust;
+
+    for(yCnt = 0; yCnt < pEntry->height; yCnt++, y++)
+    {
+        // check if the row is in the text region
+        if (    (GFX_TextAreaTopGet()    >= y) ||
+                (GFX_TextAreaBottomGet() <= y) ||
+                (y < 0) || (y > (int16_t)GFX_MaxYGet())
+           )
+        {
+            continue;
+        }
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+        if ((y < (int16_t)GFX_ClipGet()->top) || (y > (int16_t)GFX_ClipGet()->bottom))
+            continue;
+#endif
+
+        pCoverage = &pEntry->coverage[yCnt * pEntry->width];
+        pPixel    = &pEntry->pixel[yCnt * pEntry->width];
+
+#ifndef GFX_CONFIG_FONT_ANTIALIASED_DISABLE
+        if ((pEntry->bpp == 2) &&
+            (GFX_FontAntiAliasGet() == GFX_FONT_ANTIALIAS_TRANSLUCENT))
+        {
+            // the span is bounded by the first and last rendered pixels
+            for(spanStart = xFirst; spanStart <= xLast; spanStart++)
+            {
+                if (pCoverage[spanStart])
+                    break;
+            }
+            for(xCnt = xLast; xCnt >= spanStart; xCnt--)
+            {
+                if (pCoverage[xCnt])
+                    break;
+            }
+            spanLength = xCnt - spanStart + 1;
+
+            if (spanLength > 0)
+            {
+                // retrieve the background once and blend the glyph into it
+                GFX_PixelArrayGet(  xStart + spanStart, y,
+                                    gfxLineBuffer0, spanLength);
+
+                for(xCnt = 0; xCnt < spanLength; xCnt++)
+                {
+                    if (pCoverage[spanStart + xCnt] == 0)
+                        continue;
+
+                    if(pGfxContext->textBackgroundColor100 != gfxLineBuffer0[xCnt])
+                    {
+                        pGfxContext->textBackgroundColor100 = gfxLineBuffer0[xCnt];
+                        GFX_CalculateColors();
+                    }
+
+                    switch(pCoverage[spanStart + xCnt])
+                    {
+                        case 1:
+                            gfxLineBuffer0[xCnt] = pGfxContext->textForegroundColor25;
+                            break;
+                        case 2:
+                            gfxLineBuffer0[xCnt] = pGfxContext->textForegroundColor75;
+                            break;
+                        default:
+                            gfxLineBuffer0[xCnt] = pGfxContext->textForegroundColor100;
+                            break;
+                    }
+                }
+
+                GFX_PixelArrayPut(  xStart + spanStart, y,
+                                    gfxLineBuffer0, spanLength);
+            }
+            continue;
+        }
+#endif
+        // render the runs of pixels directly from the cache
+        for(xCnt = xFirst; xCnt <= xLast; )
+        {
+            if (pCoverage[xCnt] == 0)
+            {
+                xCnt++;
+                continue;
+            }
+
+            spanStart = xCnt;
+            while ((xCnt <= xLast) && (pCoverage[xCnt] != 0))
+                xCnt++;
+            spanLength = xCnt - spanStart;
+
+            if (spanLength == 1)
+            {
+                GFX_ColorSet(pPixel[spanStart]);
+                GFX_PixelPut(xStart + spanStart, y);
+            }
+            else
+            {
+                GFX_PixelArrayPut(  xStart + spanStart, y,
+                                    &pPixel[spanStart], spanLength);
+            }
+        }
+    }
+
+    // move cursor
+    GFX_TextCursorPositionSet(
+                                (xStart + pEntry->width - pEntry->xAdjust - pEntry->xWidthAdjust),
+                                GFX_TextCursorPositionYGet()
+                             );
+
+    // restore color
+    GFX_ColorSet(pEntry->foreground);
+
+    return (GFX_STATUS_SUCCESS);
+}
+
+#endif // #ifdef GFX_CONFIG_FONT_GLYPH_CACHE_SIZE
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_TextCharDraw(
+                                GFX_XCHAR ch
+                               )
+
+    Summary:
+        This function renders the given character using the
         currently set color using the currently set font.
 
     Description:
@@ -3829,59 +6415,49 @@ GFX_STATUS __attribute__((weak)) GFX_TextCharDraw(
                                 GFX_XCHAR ch)
 {
 
-    typedef enum
-    {
-        TC_IDLE,
-        TC_GET_INFO,
-        TC_CHECK_RENDER_STATUS,
-        TC_RENDER_CHAR,
-        TC_RENDER_CHAR_DRIVER,
-        TC_RENDER_STATUS_CHECK,
-        TC_RENDER_NEWLINE_CHAR,
-    } TEXTCHAR_RENDER_STATES;
-
-    static TEXTCHAR_RENDER_STATES state = TC_IDLE, renderState;
-    static GFX_FONT_OUTCHAR OutCharParam;
-    static GFX_STATUS status;
-    static GFX_STATUS_BIT statusBit;
-    static GFX_RESOURCE_HDR *pFont;
+    GFX_TEXT_CHAR_DRAW_PARAM *pState = &(pGfxContext->textChar);
 
     while(1)
     {
-        switch (state)
+        switch (pState->state)
         {
             case TC_IDLE:
 
-                status = GFX_STATUS_SUCCESS_BIT;
+                pState->status = GFX_STATUS_SUCCESS_BIT;
                 // check for error conditions
                 // since we cannot predict that the font table is always valid we
                 // cannot allow the program to hang. So intead of returning
                 // GFX_STATUS_FAILURE we will return a GFX_STATUS_SUCCESS.
                 // When the character is not in the table, it will just be
                 // ignored and not printed.
-                pFont = GFX_FontGet();
+                pState->pFont = GFX_FontGet();
 
                 // check if new line character, if yes just go and adjust
                 // the text cursor position.
                 if (ch == (GFX_UXCHAR)0x0A)
                 {
-                   state = TC_RENDER_NEWLINE_CHAR;
+                   pState->state = TC_RENDER_NEWLINE_CHAR;
                    break;
                 }
 
                 // make sure characters are printable
-                if((GFX_UXCHAR)ch < (GFX_UXCHAR)pFont->resource.font.header.firstChar)
-                    statusBit = GFX_STATUS_ERROR_BIT;
-                else if((GFX_UXCHAR)ch > (GFX_UXCHAR)pFont->resource.font.header.lastChar)
-                    statusBit = GFX_STATUS_ERROR_BIT;
+                if((GFX_UXCHAR)ch < (GFX_UXCHAR)pState->pFont->resource.font.header.firstChar)
+                    pState->statusBit = GFX_STATUS_ERROR_BIT;
+                else if((GFX_UXCHAR)ch > (GFX_UXCHAR)pState->pFont->resource.font.header.lastChar)
+                    pState->statusBit = GFX_STATUS_ERROR_BIT;
 #ifdef  GFX_CONFIG_FONT_ANTIALIASED_DISABLE
-                else if(pFont->resource.font.header.bpp > 1)
-                    statusBit = GFX_STATUS_ERROR_BIT;
+                else if(pState->pFont->resource.font.header.bpp > 1)
+                    pState->statusBit = GFX_STATUS_ERROR_BIT;
 #endif
-                if (statusBit == GFX_STATUS_ERROR_BIT)
+                if (pState->statusBit == GFX_STATUS_ERROR_BIT)
                     return GFX_STATUS_SUCCESS;
                 else
-                    state = TC_GET_INFO;
+                    pState->state = TC_GET_INFO;
+
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+                // the recorded commands are drawn before the pixels are read or written
+                GFX_DisplayListFlush();
+#endif
 
                 // no break here since the next state is what we want
 
@@ -3889,13 +6465,13 @@ GFX_STATUS __attribute__((weak)) GFX_TextCharDraw(
 
                 // initialize variables
 #ifndef GFX_CONFIG_FONT_EXTERNAL_DISABLE
-                OutCharParam.pChImage = NULL;
+                pState->OutCharParam.pChImage = NULL;
 #endif
-                OutCharParam.xAdjust = 0;
-                OutCharParam.yAdjust = 0;
-                OutCharParam.xWidthAdjust = 0;
-                OutCharParam.heightOvershoot = 0;
-                state = TC_CHECK_RENDER_STATUS;
+                pState->OutCharParam.xAdjust = 0;
+                pState->OutCharParam.yAdjust = 0;
+                pState->OutCharParam.xWidthAdjust = 0;
+                pState->OutCharParam.heightOvershoot = 0;
+                pState->state = TC_CHECK_RENDER_STATUS;
 
                 // no break here since the next state is what we want
 
@@ -3903,51 +6479,86 @@ GFX_STATUS __attribute__((weak)) GFX_TextCharDraw(
 
                 if (GFX_RenderStatusCheck() == GFX_STATUS_BUSY_BIT)
                 {
-                    state = TC_IDLE;
+                    pState->state = TC_IDLE;
                     return (GFX_STATUS_FAILURE);
                 }
 
+#ifdef GFX_CONFIG_FONT_GLYPH_CACHE_SIZE
+                // glyphs in the cache need no character information
+                if ((pState->pFont->type == GFX_RESOURCE_FONT_FLASH_NONE) ||
+                    (pState->pFont->type == GFX_RESOURCE_FONT_EXTERNAL_NONE))
+                {
+                    pState->pCacheEntry = GFX_TextCharCacheFind(pState->pFont, ch);
+                    if (pState->pCacheEntry != NULL)
+                    {
+                        pState->state = TC_RENDER_CHAR_CACHE;
+                        pState->renderState = TC_RENDER_CHAR_CACHE;
+                        break;
+                    }
+                }
+#endif
+
                 // get the character information
-                switch (pFont->type)
+                switch (pState->pFont->type)
                 {
 
                     case GFX_RESOURCE_FONT_FLASH_NONE:
-                        GFX_TextCharInfoFlashGet(ch, &OutCharParam);
-                        state = TC_RENDER_CHAR;
-                        renderState = TC_RENDER_CHAR;
+                        GFX_TextCharInfoFlashGet(ch, &pState->OutCharParam);
+                        pState->state = TC_RENDER_CHAR;
+                        pState->renderState = TC_RENDER_CHAR;
                         break;
 
                     case GFX_RESOURCE_FONT_EXTERNAL_NONE:
-                        GFX_TextCharInfoExternalGet(ch, &OutCharParam);
-                        state = TC_RENDER_CHAR;
-                        renderState = TC_RENDER_CHAR;
+                        GFX_TextCharInfoExternalGet(ch, &pState->OutCharParam);
+                        pState->state = TC_RENDER_CHAR;
+                        pState->renderState = TC_RENDER_CHAR;
                         break;
 
                     case GFX_RESOURCE_FONT_EDS_NONE:
-                        state = TC_RENDER_CHAR_DRIVER;
-                        renderState = TC_RENDER_CHAR_DRIVER;
+                        pState->state = TC_RENDER_CHAR_DRIVER;
+                        pState->renderState = TC_RENDER_CHAR_DRIVER;
                         break;
 
                     default:
-                        state = TC_IDLE;
+                        pState->state = TC_IDLE;
                         return (GFX_STATUS_SUCCESS);
                 } // end of switch
 
+#ifdef GFX_CONFIG_FONT_GLYPH_CACHE_SIZE
+                // decode the glyph into the cache and render it from there
+                if (pState->renderState == TC_RENDER_CHAR)
+                {
+                    pState->pCacheEntry = GFX_TextCharCacheFill(pState->pFont, ch, &pState->OutCharParam);
+                    if (pState->pCacheEntry != NULL)
+                    {
+                        pState->state = TC_RENDER_CHAR_CACHE;
+                        pState->renderState = TC_RENDER_CHAR_CACHE;
+                    }
+                }
+#endif
+                break;
+
+#ifdef GFX_CONFIG_FONT_GLYPH_CACHE_SIZE
+            case TC_RENDER_CHAR_CACHE:
+
+                pState->status = GFX_TextCharCacheRender(pState->pCacheEntry);
+                pState->state = TC_RENDER_STATUS_CHECK;
                 break;
+#endif
 
             case TC_RENDER_CHAR_DRIVER:
 
                 // this is the case when the driver layer implements
                 // code to render the characters
 
-                status = GFX_DRV_TextCharRender(ch);
-                state = TC_RENDER_STATUS_CHECK;
+                pState->status = GFX_DRV_TextCharRender(ch);
+                pState->state = TC_RENDER_STATUS_CHECK;
                 break;
 
             case TC_RENDER_CHAR:
 
-                status = GFX_TextCharRender(ch, &OutCharParam);
-                state = TC_RENDER_STATUS_CHECK;
+                pState->status = GFX_TextCharRender(ch, &pState->OutCharParam);
+                pState->state = TC_RENDER_STATUS_CHECK;
 
                 // no break here since the next state is what we want
 
@@ -3958,15 +6569,15 @@ GFX_STATUS __attribute__((weak)) GFX_TextCharDraw(
                 // and not re-do the initialization done on the previous
                 // states above. So the state only changes to TC_IDLE
                 // when it is a success or an error.
-                if(status == GFX_STATUS_SUCCESS)
+                if(pState->status == GFX_STATUS_SUCCESS)
                 {
-                    state = TC_IDLE;
+                    pState->state = TC_IDLE;
                 }
                 else
                 {
-                    state = renderState;
+                    pState->state = pState->renderState;
                 }
-                return (status);
+                return (pState->status);
 
             case TC_RENDER_NEWLINE_CHAR:
                 // since the character is a newline character, just
@@ -3976,16 +6587,16 @@ GFX_STATUS __attribute__((weak)) GFX_TextCharDraw(
                                 GFX_TextCursorPositionXGet(),
                                 (   
                                     GFX_TextCursorPositionYGet() +
-                                    pFont->resource.font.header.height
+                                    pState->pFont->resource.font.header.height
                                 ));
-                status = GFX_STATUS_SUCCESS;
-                state = TC_IDLE;
-                return (status);
+                pState->status = GFX_STATUS_SUCCESS;
+                pState->state = TC_IDLE;
+                return (pState->status);
 
             default:
 
                 // this state should never happen
-                state = TC_IDLE;
+                pState->state = TC_IDLE;
                 return GFX_STATUS_FAILURE;
         } // end of switch ...
     } // end of while(1) ...
@@ -4040,22 +6651,21 @@ GFX_STATUS __attribute__((weak)) GFX_TextStringDraw(
                                 uint16_t length)
 {
 
-    static uint8_t      start = 1;
-    static uint16_t     counter = 0;
-           GFX_XCHAR    ch;
-           GFX_STATUS   status;
+    GFX_TEXT_STRING_DRAW_PARAM  *pState = &(pGfxContext->textString);
+    GFX_XCHAR                   ch;
+    GFX_STATUS                  status;
 
-    if(start)
+    if(pState->start)
     {
         GFX_TextCursorPositionSet(x, y);
-        start = 0;
+        pState->start = 0;
     }
 
 
     while(1)
     {
 
-        ch = *(pString + counter);
+        ch = *(pString + pState->counter);
 
         if ( ((GFX_UXCHAR)ch == (GFX_UXCHAR)0x0A) ||
              ((GFX_UXCHAR)ch >  (GFX_UXCHAR)15  )
@@ -4081,12 +6691,12 @@ GFX_STATUS __attribute__((weak)) GFX_TextStringDraw(
 
         // if rendering of that character is a success go to
         // the next character
-        counter++;
+        pState->counter++;
 
         // check if the total rendered character has reached length
         // when length is 0, ignore length and use the string null
         // terminator instead to exit the function
-        if ((length > 0) && (counter == length))
+        if ((length > 0) && (pState->counter == length))
         {
             status = GFX_STATUS_SUCCESS;
             break;
@@ -4094,8 +6704,8 @@ GFX_STATUS __attribute__((weak)) GFX_TextStringDraw(
 
     }
 
-    counter = 0;
-    start = 1;
+    pState->counter = 0;
+    pState->start = 1;
 
     return (status);
 
@@ -4188,79 +6798,61 @@ GFX_STATUS __attribute__((weak)) GFX_TextStringBoxDraw(
 
      */
 
-    typedef enum
-    {
-        TB_IDLE,
-        TB_GET_LINE_INFO,
-        TB_CHECK_NEWLINE_OR_END,
-        TB_RENDER_CHARS,
-        TB_EXIT,
-    } TEXTSTRINGBOX_RENDER_STATES;
-
-    static TEXTSTRINGBOX_RENDER_STATES state = TB_IDLE;
-    static GFX_STATUS status;
-    static uint16_t numLines;
-    static GFX_XCHAR *pChar;
-    static uint16_t  left, top, right, bottom;
-    static uint16_t textHeight, textWidth, count;
-    static bool ignoreCount;
-    
-    // note: these two are signed variables
-    static int16_t  lineXPos, lineYPos;
+    GFX_TEXT_STRING_BOX_DRAW_PARAM *pState = &(pGfxContext->textStringBox);
 
     while(1)
     {
-        switch (state)
+        switch (pState->state)
         {
             case TB_IDLE:
                 // initialize the dimensions
-                left  = x;
-                top   = y;
+                pState->left  = x;
+                pState->top   = y;
                 if (length == 0)
                 {
-                    ignoreCount = true;
+                    pState->ignoreCount = true;
                 }
                 else
                 {
-                    ignoreCount = false;
+                    pState->ignoreCount = false;
                 }
 
-                right    = x + width  - 1;
-                if (right > GFX_MaxXGet())
-                    right = GFX_MaxXGet();
+                pState->right    = x + width  - 1;
+                if (pState->right > GFX_MaxXGet())
+                    pState->right = GFX_MaxXGet();
 
-                bottom   = y + height - 1;
-                if (bottom > GFX_MaxYGet())
-                        bottom = GFX_MaxYGet();
+                pState->bottom   = y + height - 1;
+                if (pState->bottom > GFX_MaxYGet())
+                        pState->bottom = GFX_MaxYGet();
                 
-                lineXPos = 0;
-                lineYPos = 0;
-                status   = GFX_STATUS_SUCCESS;
+                pState->lineXPos = 0;
+                pState->lineYPos = 0;
+                pState->status   = GFX_STATUS_SUCCESS;
 
                 // set the clipping area first
-                GFX_TextAreaLeftSet(left);
-                GFX_TextAreaTopSet(top);
-                GFX_TextAreaRightSet(right);
-                GFX_TextAreaBottomSet(bottom);
+                GFX_TextAreaLeftSet(pState->left);
+                GFX_TextAreaTopSet(pState->top);
+                GFX_TextAreaRightSet(pState->right);
+                GFX_TextAreaBottomSet(pState->bottom);
 
                 // get the font height, width will be used to get the
                 // length of each line
-                textHeight = GFX_TextStringHeightGet(GFX_FontGet());
+                pState->textHeight = GFX_TextStringHeightGet(GFX_FontGet());
 
                 // search for new line characters, if none is found
                 // the number of lines is 1.
-                numLines = 1;
-                pChar = pString;
-                count = 0;
+                pState->numLines = 1;
+                pState->pChar = pString;
+                pState->count = 0;
 
-                while(*(pChar+count) != 0)
+                while(*(pState->pChar+pState->count) != 0)
                 {
-                    if (*(pChar+count) == 0x0A)
-                        numLines++;
-                    count++;
-                    if (ignoreCount == false)
+                    if (*(pState->pChar+pState->count) == 0x0A)
+                        pState->numLines++;
+                    pState->count++;
+                    if (pState->ignoreCount == false)
                     {
-                        if (count == length)
+                        if (pState->count == length)
                             break;
                     }
                 }
@@ -4273,13 +6865,13 @@ GFX_STATUS __attribute__((weak)) GFX_TextStringBoxDraw(
                     case GFX_ALIGN_TOP:
                         // text is aligned top, render the first line
                         // immediately after the top location
-                        lineYPos = top + 1;
+                        pState->lineYPos = pState->top + 1;
                         break;
                     case GFX_ALIGN_BOTTOM:
                         // text is aligned bottom, starting position of the
                         // first line is calculated from the bottom position subtracted by
                         // the (number of lines * height) of the string
-                        lineYPos = (int16_t)(bottom - (textHeight * numLines));
+                        pState->lineYPos = (int16_t)(pState->bottom - (pState->textHeight * pState->numLines));
                         break;
                     case GFX_ALIGN_VCENTER:
                     default:
@@ -4288,19 +6880,19 @@ GFX_STATUS __attribute__((weak)) GFX_TextStringBoxDraw(
                         // text is aligned vertical center, starting position of the
                         // first line is dependent on the number of lines and height
                         // of the font
-                        lineYPos = (int16_t)(top + ((height - 1) >> 1)) -  \
-                                   (int16_t)((textHeight * numLines) >> 1);
+                        pState->lineYPos = (int16_t)(pState->top + ((height - 1) >> 1)) -  \
+                                   (int16_t)((pState->textHeight * pState->numLines) >> 1);
                         break;
                 };
 
-                state = TB_GET_LINE_INFO;
+                pState->state = TB_GET_LINE_INFO;
 
                 // no break here since the next state is what we want
 
             case TB_GET_LINE_INFO:
 
                 // get the width of the current string
-                textWidth = GFX_TextStringWidthGet(pString, GFX_FontGet());
+                pState->textWidth = GFX_TextStringWidthGet(pString, GFX_FontGet());
 
                 // calculate the starting position of the current
                 // string in the horizntal direction
@@ -4310,13 +6902,13 @@ GFX_STATUS __attribute__((weak)) GFX_TextStringBoxDraw(
                     case GFX_ALIGN_LEFT:
                         // text is aligned left, render the first character
                         // immediately after the left location
-                        lineXPos = left + 1;
+                        pState->lineXPos = pState->left + 1;
                         break;
                     case GFX_ALIGN_RIGHT:
                         // text is aligned right, starting position of the
                         // first character is calculated from the right position
                         // subtracted by the width of the string
-                        lineXPos = (int16_t)(right - textWidth);
+                        pState->lineXPos = (int16_t)(pState->right - pState->textWidth);
                         break;
                     case GFX_ALIGN_HCENTER:
                     default:
@@ -4325,15 +6917,15 @@ GFX_STATUS __attribute__((weak)) GFX_TextStringBoxDraw(
                         // text is aligned horizontal center, starting position of
                         // the first character is dependent on the width of the string
                         // and the width of the box.
-                        lineXPos = (int16_t)((left + (width >> 1)) - (textWidth >> 1));
+                        pState->lineXPos = (int16_t)((pState->left + (width >> 1)) - (pState->textWidth >> 1));
                         break;
                 }
 
-                GFX_TextCursorPositionSet(lineXPos, lineYPos);
-                pChar = pString;
+                GFX_TextCursorPositionSet(pState->lineXPos, pState->lineYPos);
+                pState->pChar = pString;
 
-                count = 0;
-                state = TB_CHECK_NEWLINE_OR_END;
+                pState->count = 0;
+                pState->state = TB_CHECK_NEWLINE_OR_END;
 
                 // no break here since the next state is what we want
 
@@ -4342,48 +6934,48 @@ GFX_STATUS __attribute__((weak)) GFX_TextStringBoxDraw(
                 // since this function needs to know when the current line
                 // ends, it implements its own GFX_TextStringDraw() function
 
-                if (ignoreCount == false)
+                if (pState->ignoreCount == false)
                 {
-                    if (count == length)
+                    if (pState->count == length)
                     {
                     // end of string
-                    state = TB_EXIT;
-                    status = GFX_STATUS_SUCCESS;
+                    pState->state = TB_EXIT;
+                    pState->status = GFX_STATUS_SUCCESS;
                     break;
                     }
                 }
 
-                if (*pChar == 0x0A)
+                if (*pState->pChar == 0x0A)
                 {
-                    pString = ++pChar;
-                    count++;
-                    lineYPos += textHeight;
-                    state = TB_GET_LINE_INFO;
+                    pString = ++pState->pChar;
+                    pState->count++;
+                    pState->lineYPos += pState->textHeight;
+                    pState->state = TB_GET_LINE_INFO;
                     break;
                 }
-                else if ((GFX_UXCHAR)*pChar == 0)
+                else if ((GFX_UXCHAR)*pState->pChar == 0)
                 {
                     // end of string
-                    state = TB_EXIT;
-                    status = GFX_STATUS_SUCCESS;
+                    pState->state = TB_EXIT;
+                    pState->status = GFX_STATUS_SUCCESS;
                     break;
                 }
-                else if ((GFX_UXCHAR)*pChar <  (GFX_UXCHAR)15)
+                else if ((GFX_UXCHAR)*pState->pChar <  (GFX_UXCHAR)15)
                 {
-                    pChar++;
-                    count++;
-                    state = TB_CHECK_NEWLINE_OR_END;
+                    pState->pChar++;
+                    pState->count++;
+                    pState->state = TB_CHECK_NEWLINE_OR_END;
                     break;
                 }
                 
-                state = TB_RENDER_CHARS;
+                pState->state = TB_RENDER_CHARS;
 
                 // no break here since the next state is what we want
 
             case TB_RENDER_CHARS:
 
-                status = GFX_TextCharDraw(*pChar);
-                if (status == GFX_STATUS_FAILURE)
+                pState->status = GFX_TextCharDraw(*pState->pChar);
+                if (pState->status == GFX_STATUS_FAILURE)
                 {
                     return (GFX_STATUS_FAILURE);
                 }
@@ -4392,9 +6984,9 @@ GFX_STATUS __attribute__((weak)) GFX_TextStringBoxDraw(
 
                 // if rendering of that character is a success go to
                 // the next character
-                pChar++;
-                count++;
-                state = TB_CHECK_NEWLINE_OR_END;
+                pState->pChar++;
+                pState->count++;
+                pState->state = TB_CHECK_NEWLINE_OR_END;
                 break;
 
             case TB_EXIT:
@@ -4404,8 +6996,8 @@ GFX_STATUS __attribute__((weak)) GFX_TextStringBoxDraw(
                 GFX_TextAreaTopSet(0);
                 GFX_TextAreaRightSet(GFX_MaxXGet());
                 GFX_TextAreaBottomSet(GFX_MaxYGet());
-                state = TB_IDLE;
-                return (status);
+                pState->state = TB_IDLE;
+                return (pState->status);
 
             default:
                 // this should never happen
@@ -4416,89 +7008,300 @@ GFX_STATUS __attribute__((weak)) GFX_TextStringBoxDraw(
 
 }
 
+#ifdef GFX_CONFIG_FONT_WIDTH_TABLE_SIZE
+
 // *****************************************************************************
 /*  Function:
-    uint16_t GFX_TextStringWidthGet(
-                                GFX_XCHAR* pString,
-                                GFX_RESOURCE_HDR *pFont);
+    void GFX_FontWidthTableClear(void)
 
     Summary:
-        This function returns the width of the given string using the
-        given font.
+        Removes all the character widths from the font width tables.
 
     Description:
-        This function returns the width of the given string using the
-        given font in pixels. The given font must be present in the system.
-
-        The width is calculated by adding the width of each character in
-        the string sampled from the first character until control character
-        is sampled. The control characters are those characters with ID that
-        are less than 15 (0x0F). This includes the new line character
-        (9 or 0x0A).
-
-        Therefore, using this function to find the length of a string with
-        a new line character included in the string, the length returned
-        will be the first line of the string. If the string used do not
-        have a new line character and is a terminated string, the length
-        returned is the actual length of the string.
+        Removes all the character widths from the font width tables.
+        The application must call this function when the contents of
+        a font resource that was already measured is changed.
 
-        This function return value is undefined if the given pointer does
-        not point to a valid font or one or more characters in the given
-        string does not exist on the given font. The function will also
-        return an undefined value if the string has no new line
-        character and not terminated.
-    
 */
 // *****************************************************************************
-uint16_t GFX_TextStringWidthGet(GFX_XCHAR *pString, GFX_RESOURCE_HDR *pFont)
+void GFX_FontWidthTableClear(void)
 {
-    switch(*((int16_t *)pFont))
-    {
-        case GFX_RESOURCE_FONT_RAM_NONE:
-            return GFX_TextStringWidthRamGet(pString, pFont);
-
-        case GFX_RESOURCE_FONT_FLASH_NONE:
-            return GFX_TextStringWidthFlashGet(pString, pFont);
-
-        case GFX_RESOURCE_FONT_EXTERNAL_NONE:
-            return GFX_TextStringWidthExternalGet(pString, pFont);
+    uint16_t    i;
 
-        case GFX_RESOURCE_FONT_EDS_NONE:
-            return GFX_DRV_TextStringWidthGet(pString, pFont);
-
-        default:
-            return (0);
-    }
+    for(i = 0; i < GFX_CONFIG_FONT_WIDTH_TABLE_SIZE; i++)
+        gfxFontWidthTable[i].pFont = NULL;
+    gfxFontWidthTableNext = 0;
 }
 
 // *****************************************************************************
 /*  Function:
-    uint16_t GFX_TextStringWidthRamGet(
-                                GFX_XCHAR *pString,
-                                GFX_RESOURCE_HDR *pFont)
+    uint16_t GFX_TextCharWidthGet(
+                                GFX_RESOURCE_HDR *pFont,
+                                uint16_t index)
 
     Summary:
-        This function is an internal function and should not
-        be called by the application.
+        Reads the advance width of a character from the font.
 
     Description:
-        Calculates and returns the string width in pixels. The string length
-        is based on the given font located in RAM.
-
+        Reads the glyph entry of the character at the given index
+        from the first character of the font and returns the width
+        used to advance the text cursor. The glyph entry is read from
+        flash memory or external memory.
 
 */
 // *****************************************************************************
-uint16_t __attribute__((weak)) GFX_TextStringWidthRamGet(
-                                GFX_XCHAR* pString,
-                                GFX_RESOURCE_HDR* pFont)
+static uint16_t GFX_TextCharWidthGet(
+                                GFX_RESOURCE_HDR *pFont,
+                                uint16_t index)
 {
-#ifndef GFX_CONFIG_FONT_RAM_DISABLE
-    GFX_FONT_GLYPH_ENTRY *pChTable = NULL;
-    GFX_FONT_GLYPH_ENTRY_EXTENDED *pChTableExtended = NULL;
-    GFX_FONT_HEADER *pHeader;
-
-    int16_t       textWidth;
-    GFX_XCHAR       ch;
+#ifndef GFX_CONFIG_FONT_EXTERNAL_DISABLE
+    GFX_FONT_GLYPH_ENTRY            chTable;
+    GFX_FONT_GLYPH_ENTRY_EXTENDED   chTableExtended;
+#endif
+
+#ifndef GFX_CONFIG_FONT_FLASH_DISABLE
+    if (pFont->type == GFX_RESOURCE_FONT_FLASH_NONE)
+    {
+        if(pFont->resource.font.header.extendedGlyphEntry)
+        {
+            return ((   (GFX_FONT_SPACE GFX_FONT_GLYPH_ENTRY_EXTENDED *)
+                        (pFont->resource.font.location.progByteAddress + sizeof(GFX_FONT_HEADER))
+                        + index)->cursorAdvance);
+        }
+        else
+        {
+            return ((   (GFX_FONT_SPACE GFX_FONT_GLYPH_ENTRY *)
+                        (pFont->resource.font.location.progByteAddress + sizeof(GFX_FONT_HEADER))
+                        + index)->width);
+        }
+    }
+#endif
+
+#ifndef GFX_CONFIG_FONT_EXTERNAL_DISABLE
+    if (pFont->type == GFX_RESOURCE_FONT_EXTERNAL_NONE)
+    {
+        if(pFont->resource.font.header.extendedGlyphEntry)
+        {
+            GFX_ExternalResourceRead
+            (
+                pFont,
+                sizeof(GFX_FONT_HEADER) + sizeof(GFX_FONT_GLYPH_ENTRY_EXTENDED) * index,
+                sizeof(GFX_FONT_GLYPH_ENTRY_EXTENDED),
+                &chTableExtended
+            );
+            return (chTableExtended.cursorAdvance);
+        }
+        else
+        {
+            GFX_ExternalResourceRead
+            (
+                pFont,
+                sizeof(GFX_FONT_HEADER) + sizeof(GFX_FONT_GLYPH_ENTRY) * index,
+                sizeof(GFX_FONT_GLYPH_ENTRY),
+                &chTable
+            );
+            return (chTable.width);
+        }
+    }
+#endif
+
+    return (0);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_FONT_WIDTH_TABLE *GFX_FontWidthTableGet(GFX_RESOURCE_HDR *pFont)
+
+    Summary:
+        Returns the width table of the font.
+
+    Description:
+        Returns the width table of the font. When the font has no
+        table yet, a free table is assigned to it, or the tables are
+        reused in turn when all of them are used. The widths are not
+        read here, they are filled in as the characters are measured.
+
+*/
+// *****************************************************************************
+static GFX_FONT_WIDTH_TABLE *GFX_FontWidthTableGet(GFX_RESOURCE_HDR *pFont)
+{
+    GFX_FONT_WIDTH_TABLE    *pTable;
+    uint16_t                i;
+
+    for(i = 0; i < GFX_CONFIG_FONT_WIDTH_TABLE_SIZE; i++)
+    {
+        if (gfxFontWidthTable[i].pFont == pFont)
+            return (&gfxFontWidthTable[i]);
+    }
+
+    pTable = &gfxFontWidthTable[gfxFontWidthTableNext];
+    if (++gfxFontWidthTableNext == GFX_CONFIG_FONT_WIDTH_TABLE_SIZE)
+        gfxFontWidthTableNext = 0;
+
+    pTable->pFont = pFont;
+    for(i = 0; i < GFX_CONFIG_FONT_WIDTH_TABLE_CHARS; i++)
+        pTable->width[i] = GFX_FONT_WIDTH_UNKNOWN;
+
+    return (pTable);
+}
+
+// *****************************************************************************
+/*  Function:
+    uint16_t GFX_TextStringWidthTableGet(
+                                GFX_XCHAR *pString,
+                                GFX_RESOURCE_HDR *pFont)
+
+    Summary:
+        Calculates the string width using the width table of the font.
+
+    Description:
+        Calculates and returns the string width in pixels of a string
+        rendered with a font located in flash or external memory. The
+        width of each character is taken from the width table of the
+        font and read from the font only on the first use. Characters
+        beyond GFX_CONFIG_FONT_WIDTH_TABLE_CHARS from the first
+        character of the font and characters 255 pixels wide or more
+        are always read from the font.
+
+*/
+// *****************************************************************************
+static uint16_t GFX_TextStringWidthTableGet(
+                                GFX_XCHAR *pString,
+                                GFX_RESOURCE_HDR *pFont)
+{
+    GFX_FONT_WIDTH_TABLE    *pTable;
+    uint16_t                textWidth, width, index;
+    GFX_XCHAR               ch;
+    GFX_XCHAR               fontFirstChar;
+    GFX_XCHAR               fontLastChar;
+
+    pTable = GFX_FontWidthTableGet(pFont);
+    fontFirstChar = pFont->resource.font.header.firstChar;
+    fontLastChar = pFont->resource.font.header.lastChar;
+
+    textWidth = 0;
+    while((GFX_UXCHAR)15 < (GFX_UXCHAR)(ch = *pString++))
+    {
+        if((GFX_UXCHAR)ch < (GFX_UXCHAR)fontFirstChar)
+            continue;
+        if((GFX_UXCHAR)ch > (GFX_UXCHAR)fontLastChar)
+            continue;
+
+        index = (GFX_UXCHAR)ch - (GFX_UXCHAR)fontFirstChar;
+        if (index < GFX_CONFIG_FONT_WIDTH_TABLE_CHARS)
+        {
+            if (pTable->width[index] == GFX_FONT_WIDTH_UNKNOWN)
+            {
+                width = GFX_TextCharWidthGet(pFont, index);
+                if (width < GFX_FONT_WIDTH_UNKNOWN)
+                    pTable->width[index] = width;
+            }
+            else
+            {
+                width = pTable->width[index];
+            }
+        }
+        else
+        {
+            width = GFX_TextCharWidthGet(pFont, index);
+        }
+        textWidth += width;
+    }
+
+    return (textWidth);
+}
+
+#endif // #ifdef GFX_CONFIG_FONT_WIDTH_TABLE_SIZE
+
+// *****************************************************************************
+/*  Function:
+    uint16_t GFX_TextStringWidthGet(
+                                GFX_XCHAR* pString,
+                                GFX_RESOURCE_HDR *pFont);
+
+    Summary:
+        This function returns the width of the given string using the
+        given font.
+
+    Description:
+        This function returns the width of the given string using the
+        given font in pixels. The given font must be present in the system.
+
+        The width is calculated by adding the width of each character in
+        the string sampled from the first character until control character
+        is sampled. The control characters are those characters with ID that
+        are less than 15 (0x0F). This includes the new line character
+        (9 or 0x0A).
+
+        Therefore, using this function to find the length of a string with
+        a new line character included in the string, the length returned
+        will be the first line of the string. If the string used do not
+        have a new line character and is a terminated string, the length
+        returned is the actual length of the string.
+
+        This function return value is undefined if the given pointer does
+        not point to a valid font or one or more characters in the given
+        string does not exist on the given font. The function will also
+        return an undefined value if the string has no new line
+        character and not terminated.
+    
+*/
+// *****************************************************************************
+uint16_t GFX_TextStringWidthGet(GFX_XCHAR *pString, GFX_RESOURCE_HDR *pFont)
+{
+    switch(*((int16_t *)pFont))
+    {
+        case GFX_RESOURCE_FONT_RAM_NONE:
+            return GFX_TextStringWidthRamGet(pString, pFont);
+
+#ifdef GFX_CONFIG_FONT_WIDTH_TABLE_SIZE
+        case GFX_RESOURCE_FONT_FLASH_NONE:
+        case GFX_RESOURCE_FONT_EXTERNAL_NONE:
+            return GFX_TextStringWidthTableGet(pString, pFont);
+#else
+        case GFX_RESOURCE_FONT_FLASH_NONE:
+            return GFX_TextStringWidthFlashGet(pString, pFont);
+
+        case GFX_RESOURCE_FONT_EXTERNAL_NONE:
+            return GFX_TextStringWidthExternalGet(pString, pFont);
+#endif
+
+        case GFX_RESOURCE_FONT_EDS_NONE:
+            return GFX_DRV_TextStringWidthGet(pString, pFont);
+
+        default:
+            return (0);
+    }
+}
+
+// *****************************************************************************
+/*  Function:
+    uint16_t GFX_TextStringWidthRamGet(
+                                GFX_XCHAR *pString,
+                                GFX_RESOURCE_HDR *pFont)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Calculates and returns the string width in pixels. The string length
+        is based on the given font located in RAM.
+
+
+*/
+// *****************************************************************************
+uint16_t __attribute__((weak)) GFX_TextStringWidthRamGet(
+                                GFX_XCHAR* pString,
+                                GFX_RESOURCE_HDR* pFont)
+{
+#ifndef GFX_CONFIG_FONT_RAM_DISABLE
+    GFX_FONT_GLYPH_ENTRY *pChTable = NULL;
+    GFX_FONT_GLYPH_ENTRY_EXTENDED *pChTableExtended = NULL;
+    GFX_FONT_HEADER *pHeader;
+
+    int16_t       textWidth;
+    GFX_XCHAR       ch;
     GFX_XCHAR       fontFirstChar;
     GFX_XCHAR       fontLastChar;
 
@@ -4637,7 +7440,7 @@ uint16_t __attribute__((weak)) GFX_TextStringWidthExternalGet(
     GFX_XCHAR       fontLastChar;
 
 
-    GFX_ExternalResourceCallback((void*)pFont, 0, sizeof(GFX_FONT_HEADER), &header);
+    GFX_ExternalResourceRead((void*)pFont, 0, sizeof(GFX_FONT_HEADER), &header);
     fontFirstChar = header.firstChar;
     fontLastChar = header.lastChar;
     textWidth = 0;
@@ -4649,7 +7452,7 @@ uint16_t __attribute__((weak)) GFX_TextStringWidthExternalGet(
             continue;
         if(header.extendedGlyphEntry)
         {
-            GFX_ExternalResourceCallback
+            GFX_ExternalResourceRead
             (
                 (void*)pFont,
                 sizeof(GFX_FONT_HEADER) + sizeof(GFX_FONT_GLYPH_ENTRY_EXTENDED) * ((GFX_UXCHAR)ch - (GFX_UXCHAR)fontFirstChar),
@@ -4660,7 +7463,7 @@ uint16_t __attribute__((weak)) GFX_TextStringWidthExternalGet(
         }
         else
         {
-            GFX_ExternalResourceCallback
+            GFX_ExternalResourceRead
             (
                 (void*)pFont,
                 sizeof(GFX_FONT_HEADER) + sizeof(GFX_FONT_GLYPH_ENTRY) * ((GFX_UXCHAR)ch - (GFX_UXCHAR)fontFirstChar),
@@ -4705,6 +7508,127 @@ uint16_t __attribute__((weak)) GFX_DRV_TextStringWidthGet(GFX_XCHAR* textString,
     return 0;
 }
 
+// *****************************************************************************
+/*  Function:
+    uint16_t GFX_ImageLineRender(
+                                uint16_t left,
+                                uint16_t top,
+                                uint16_t width)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Delivers the image line decoded in gfxLineBuffer0. The line
+        is passed to the line callback when one is set by
+        GFX_ImagePartialLinesGet(), otherwise it is rendered to the
+        frame buffer. Returns 0 when the image draw function must
+        stop after the current line, this is the case when rendering
+        to the display buffer is disabled (see
+        GFX_RenderToDisplayBufferDisable()).
+
+*/
+// *****************************************************************************
+static uint16_t GFX_ImageLineRender(
+                                uint16_t left,
+                                uint16_t top,
+                                uint16_t width)
+{
+    if (gfxImageLineCallback != NULL)
+    {
+        gfxImageLineCallback(left, top, gfxLineBuffer0, width);
+        return (1);
+    }
+
+    if (GFX_RenderToDisplayBufferDisableFlagGet() == 1)
+        return (0);
+
+    // render the current line
+    GFX_PixelArrayPut(left, top, gfxLineBuffer0, width);
+    return (1);
+}
+
+#if !defined (GFX_CONFIG_IMAGE_FLASH_DISABLE) || !defined (GFX_CONFIG_IMAGE_EXTERNAL_DISABLE)
+// *****************************************************************************
+/*  Function:
+    uint16_t *GFX_ImagePaletteGet(
+                                GFX_RESOURCE_HDR *pImage,
+                                uint16_t entries)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Returns the palette of an uncompressed flash or external
+        image. The palette is read only when it is not the palette
+        of the last image that used this function, so an image
+        rendered one portion at a time reads its palette only once.
+
+*/
+// *****************************************************************************
+static uint16_t *GFX_ImagePaletteGet(
+                                GFX_RESOURCE_HDR *pImage,
+                                uint16_t entries)
+{
+#ifndef GFX_CONFIG_IMAGE_FLASH_DISABLE
+    uint16_gfx_image_prog   *pFlashPalette;
+    uint16_t                counter;
+#endif
+
+    if ((pImage == pGfxImagePaletteImage) && (entries == gfxImagePaletteEntries))
+        return (gfxImagePalette);
+
+    switch(pImage->type)
+    {
+#ifndef GFX_CONFIG_IMAGE_FLASH_DISABLE
+        case GFX_RESOURCE_MCHP_MBITMAP_FLASH_NONE:
+            pFlashPalette = (uint16_gfx_image_prog *)pImage->resource.image.location.progByteAddress;
+            for(counter = 0; counter < entries; counter++)
+                gfxImagePalette[counter] = pFlashPalette[counter];
+            break;
+#endif
+#ifndef GFX_CONFIG_IMAGE_EXTERNAL_DISABLE
+        case GFX_RESOURCE_MCHP_MBITMAP_EXTERNAL_NONE:
+            GFX_ExternalResourceRead(
+                    pImage,
+                    0,
+                    entries * sizeof(uint16_t),
+                    gfxImagePalette);
+            break;
+#endif
+        default:
+            break;
+    }
+
+    pGfxImagePaletteImage = pImage;
+    gfxImagePaletteEntries = entries;
+    return (gfxImagePalette);
+}
+
+// *****************************************************************************
+/*  Function:
+    void GFX_ImagePaletteCacheClear(void)
+
+    Summary:
+        Removes the cached image palette.
+
+    Description:
+        Removes the cached image palette. The palette of the last
+        rendered image is kept by the image pointer. The application
+        must call this function when the contents of an image
+        resource that was already rendered is changed.
+
+*/
+// *****************************************************************************
+void GFX_ImagePaletteCacheClear(void)
+{
+    pGfxImagePaletteImage = NULL;
+    gfxImagePaletteEntries = 0;
+}
+#endif
+
 #ifndef GFX_CONFIG_IMAGE_FLASH_DISABLE
 // *****************************************************************************
 /*  Function:
@@ -4734,7 +7658,9 @@ void __attribute__((weak)) GFX_ImageFlash1BPPDraw(
     GFX_MCHP_BITMAP_HEADER          bitmapHdr;
     uint16_t                        sizeX, sizeY;
     uint8_t                         temp = 0, mask;
-    uint16_t                        palette[2];
+#ifdef GFX_CONFIG_PALETTE_DISABLE
+    uint16_t                        *palette;
+#endif
     uint16_t                        addressOffset = 0, adjOffset;
     uint16_t                        OffsetFlag = 0x01;     //Offset from byte color bit0 for the partial image
     GFX_COLOR                       useColor;
@@ -4744,10 +7670,11 @@ void __attribute__((weak)) GFX_ImageFlash1BPPDraw(
     // Move pointer image data
     flashAddress = pImage->resource.image.location.progByteAddress;
 
-    palette[0] = *((uint16_gfx_image_prog *)flashAddress);
-    flashAddress += 2;
-    palette[1] = *((uint16_gfx_image_prog *)flashAddress);
-    flashAddress += 2;
+    // Read palette
+#ifdef GFX_CONFIG_PALETTE_DISABLE
+    palette = GFX_ImagePaletteGet(pImage, 2);
+#endif
+    flashAddress += 2 * sizeof(uint16_t);
 
     if (bitmapHdr.width & 0x07)
         adjOffset = 1;
@@ -4837,13 +7764,9 @@ void __attribute__((weak)) GFX_ImageFlash1BPPDraw(
 
         }
 
-        if (GFX_RenderToDisplayBufferDisableFlagGet() == 1)
+        // render the current line
+        if (GFX_ImageLineRender(left, top + y, sizeX) == 0)
             return;
-        else
-        {        
-            // render the current line
-            GFX_PixelArrayPut(left, top + y, gfxLineBuffer0, sizeX);
-        }
 
         y++;
 
@@ -4883,7 +7806,9 @@ void __attribute__((weak)) GFX_ImageFlash4BPPDraw(
     uint16_t                        temp, mask;
     uint16_t                        addressOffset = 0, adjOffset, nibbleOffset = 0x00;
 
-    uint16_t                        palette[16], counter;
+#ifdef GFX_CONFIG_PALETTE_DISABLE
+    uint16_t                        *palette;
+#endif
 
     GFX_COLOR                       useColor;
 
@@ -4894,11 +7819,10 @@ void __attribute__((weak)) GFX_ImageFlash4BPPDraw(
     flashAddress = pImage->resource.image.location.progByteAddress;
 
     // Read palette
-    for(counter = 0; counter < 16; counter++)
-    {
-        palette[counter] = *((uint16_gfx_image_prog *)flashAddress);
-        flashAddress += 2;
-    }
+#ifdef GFX_CONFIG_PALETTE_DISABLE
+    palette = GFX_ImagePaletteGet(pImage, 16);
+#endif
+    flashAddress += 16 * sizeof(uint16_t);
 
     // this takes care of the padding
     if (bitmapHdr.width & 0x01)
@@ -4926,7 +7850,7 @@ void __attribute__((weak)) GFX_ImageFlash4BPPDraw(
         flashAddress += ((pPartialImageData->xoffset - nibbleOffset) >> 1);
 
         sizeY = pPartialImageData->height;
-        sizeX = pPartialImageData->width + nibbleOffset;
+        sizeX = pPartialImageData->width;
     }
 
     // store current line data address
@@ -4985,13 +7909,9 @@ void __attribute__((weak)) GFX_ImageFlash4BPPDraw(
                 mask += 1;
         }
 
-        if (GFX_RenderToDisplayBufferDisableFlagGet() == 1)
+        // render the current line
+        if (GFX_ImageLineRender(left, top + y, sizeX) == 0)
             return;
-        else
-        {
-            // render the current line
-            GFX_PixelArrayPut(left, top + y, gfxLineBuffer0, sizeX);
-        }
         y++;
 
         pTempFlashAddress += (addressOffset);
@@ -5029,8 +7949,9 @@ void __attribute__((weak)) GFX_ImageFlash8BPPDraw(
     int16_t                         x, y;
     uint16_t                        sizeX, sizeY;
     uint8_t                         temp;
-    uint16_t                        palette[256];
-    uint16_t                        counter;
+#ifdef GFX_CONFIG_PALETTE_DISABLE
+    uint16_t                        *palette;
+#endif
     uint16_t                        addressOffset = 0;
 
    GFX_COLOR                        useColor;
@@ -5041,11 +7962,10 @@ void __attribute__((weak)) GFX_ImageFlash8BPPDraw(
     flashAddress = pImage->resource.image.location.progByteAddress;
 
     // Read palette
-    for(counter = 0; counter < 256; counter++)
-    {
-        palette[counter] = *((uint16_gfx_image_prog *)flashAddress);
-        flashAddress += 2;
-    }
+#ifdef GFX_CONFIG_PALETTE_DISABLE
+    palette = GFX_ImagePaletteGet(pImage, 256);
+#endif
+    flashAddress += 256 * sizeof(uint16_t);
 
     // Read image size
     sizeY = bitmapHdr.height;
@@ -5087,13 +8007,9 @@ void __attribute__((weak)) GFX_ImageFlash8BPPDraw(
 
         }
 
-        if (GFX_RenderToDisplayBufferDisableFlagGet() == 1)
+        // render the current line
+        if (GFX_ImageLineRender(left, top + y, sizeX) == 0)
             return;
-        else
-        {
-            // render the current line
-            GFX_PixelArrayPut(left, top + y, gfxLineBuffer0, sizeX);
-        }
 
         y++;
 
@@ -5169,13 +8085,9 @@ void __attribute__((weak)) GFX_ImageFlash16BPPDraw(
 #endif
         }
                     
-        if (GFX_RenderToDisplayBufferDisableFlagGet() == 1)
+        // render the current line
+        if (GFX_ImageLineRender(left, top + y, sizeX) == 0)
             return;
-        else
-        {
-            // render the current line
-            GFX_PixelArrayPut(left, top + y, gfxLineBuffer0, sizeX);
-        }
 
         y++;
         flashAddress += addressOffset;
@@ -5221,7 +8133,7 @@ void __attribute__((weak)) GFX_ImageExternal1BPPDraw(
 
     uint16_t                        sizeX, sizeY;
     uint8_t                         temp = 0, mask;
-    uint16_t                        palette[2];
+    uint16_t                        *palette = gfxImagePalette;
     uint16_t                        addressOffset = 0, adjOffset;
     //Offset from byte color bit0 for the partial image
     uint16_t                        OffsetFlag = 0x01;
@@ -5242,11 +8154,7 @@ void __attribute__((weak)) GFX_ImageExternal1BPPDraw(
 #endif
         {
             // Get palette (2 entries)
-            GFX_ExternalResourceCallback(
-                    pImage,
-                    0,
-                    2 * sizeof(uint16_t),
-                    palette);
+            palette = GFX_ImagePaletteGet(pImage, 2);
             // Set offset to the image data (header size + palette
             memOffset = 2 * (sizeof(uint16_t));
         }
@@ -5289,7 +8197,7 @@ void __attribute__((weak)) GFX_ImageExternal1BPPDraw(
     for(y = 0; y < sizeY; )
     {
         // Get a line
-        GFX_ExternalResourceCallback(
+        GFX_ExternalResourceRead(
                 pImage,
                 memOffset,
                 lineLength,
@@ -5350,17 +8258,9 @@ void __attribute__((weak)) GFX_ImageExternal1BPPDraw(
 
         }
         
-        if (GFX_RenderToDisplayBufferDisableFlagGet() == 1)
+        // render the current line
+        if (GFX_ImageLineRender(left, top + y, sizeX) == 0)
             return;
-        else
-        {        
-            // render a copy of the current line
-            GFX_PixelArrayPut(
-                    left,
-                    top + y,
-                    gfxLineBuffer0,
-                    sizeX);
-        }
         y++;
 
     }
@@ -5403,7 +8303,7 @@ void __attribute__((weak)) GFX_ImageExternal4BPPDraw(
     uint16_t                        temp, mask;
     uint16_t                        addressOffset = 0, adjOffset;
     uint16_t                        nibbleOffset = 0x00;
-    uint16_t                        palette[16];
+    uint16_t                        *palette = gfxImagePalette;
     GFX_COLOR                       useColor;
 
 
@@ -5424,11 +8324,7 @@ void __attribute__((weak)) GFX_ImageExternal4BPPDraw(
 #endif
         {
             // Get palette (16 entries)
-            GFX_ExternalResourceCallback(
-                    pImage,
-                    0,
-                    16 * sizeof(uint16_t),
-                    palette);
+            palette = GFX_ImagePaletteGet(pImage, 16);
             // Set offset to the image data
             memOffset = 16 * (sizeof(uint16_t));
         }
@@ -5463,7 +8359,7 @@ void __attribute__((weak)) GFX_ImageExternal4BPPDraw(
         memOffset += (pPartialImageData->xoffset) >> 1;
 
         sizeY = pPartialImageData->height;
-        sizeX = pPartialImageData->width + nibbleOffset;
+        sizeX = pPartialImageData->width;
     }
 
     // calculate the length of bytes needed per line
@@ -5477,7 +8373,7 @@ void __attribute__((weak)) GFX_ImageExternal4BPPDraw(
     {
 
         // Get line
-        GFX_ExternalResourceCallback(
+        GFX_ExternalResourceRead(
                 pImage,
                 memOffset,
                 lineLength,
@@ -5531,13 +8427,9 @@ void __attribute__((weak)) GFX_ImageExternal4BPPDraw(
                 mask += 1;
         }
         
-        if (GFX_RenderToDisplayBufferDisableFlagGet() == 1)
+        // render the current line
+        if (GFX_ImageLineRender(left, top + y, sizeX) == 0)
             return;
-        else
-        {        
-            // render a copy of the current line
-            GFX_PixelArrayPut(left, top + y, gfxLineBuffer0, sizeX);
-        }
         y++;
 
     }
@@ -5581,7 +8473,7 @@ void __attribute__((weak)) GFX_ImageExternal8BPPDraw(
     int16_t                         x, y;
     uint16_t                        sizeX, sizeY;
     uint8_t                         temp;
-    uint16_t                        palette[256];
+    uint16_t                        *palette = gfxImagePalette;
     uint16_t                        addressOffset = 0;
 
    GFX_COLOR                        useColor;
@@ -5602,11 +8494,7 @@ void __attribute__((weak)) GFX_ImageExternal8BPPDraw(
 #endif
         {
             // Get palette (256 entries)
-            GFX_ExternalResourceCallback(
-                    pImage,
-                    0,
-                    256 * sizeof(uint16_t),
-                    palette);
+            palette = GFX_ImagePaletteGet(pImage, 256);
             // Set offset to the image data
             memOffset = 256 * sizeof(uint16_t);
         }
@@ -5641,7 +8529,7 @@ void __attribute__((weak)) GFX_ImageExternal8BPPDraw(
     {
 
         // Get line
-        GFX_ExternalResourceCallback(
+        GFX_ExternalResourceRead(
                 pImage,
                 memOffset,
                 lineLength,
@@ -5673,17 +8561,9 @@ void __attribute__((weak)) GFX_ImageExternal8BPPDraw(
 
         }
 
-        if (GFX_RenderToDisplayBufferDisableFlagGet() == 1)
+        // render the current line
+        if (GFX_ImageLineRender(left, top + y, sizeX) == 0)
             return;
-        else
-        {
-            // render a copy of the current line
-            GFX_PixelArrayPut(
-                    left,
-                    top + y,
-                    gfxLineBuffer0,
-                    sizeX);
-        }
 
         y++;
     }
@@ -5756,7 +8636,7 @@ void __attribute__((weak)) GFX_ImageExternal16BPPDraw(
     {
 
         // Get line
-        GFX_ExternalResourceCallback(
+        GFX_ExternalResourceRead(
                 pImage,
                 memOffset,
                 lineLength,
@@ -5779,17 +8659,9 @@ void __attribute__((weak)) GFX_ImageExternal16BPPDraw(
 #endif
         }
         
-        if (GFX_RenderToDisplayBufferDisableFlagGet() == 1)
+        // render the current line
+        if (GFX_ImageLineRender(left, top + y, sizeX) == 0)
             return;
-        else
-        {        
-            // render a copy of the current line
-            GFX_PixelArrayPut(
-                    left,
-                    top + y,
-                    gfxLineBuffer0,
-                    sizeX);
-        }
         y++;
 
     }
@@ -5849,6 +8721,68 @@ GFX_STATUS GFX_ImagePartialDraw(
     GFX_PARTIAL_IMAGE_PARAM partialImage;
     uint8_t        colorDepth;
     uint16_t       colorTemp;
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+    GFX_RECTANGULAR_AREA *pClip = GFX_ClipGet();
+    uint16_t       clipped;
+#endif
+
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+    // only the part of the image in the clip rectangle is decoded, the
+    // lines of GFX_ImagePartialLinesGet() and GFX_BarAlphaDraw() are not
+    // rendered on the screen and are not clipped
+    if ((gfxImageLineCallback == NULL) && (GFX_RenderToDisplayBufferDisableFlagGet() == 0))
+    {
+        if (source_width == 0)
+        {
+            source_x_offset = 0;
+            source_y_offset = 0;
+            source_width  = pImage->resource.image.width;
+            source_height = pImage->resource.image.height;
+        }
+
+        if ((pClip->left > pClip->right) || (pClip->top > pClip->bottom) ||
+            (destination_x > pClip->right) || (destination_y > pClip->bottom) ||
+            ((uint32_t)destination_x + source_width <= pClip->left) ||
+            ((uint32_t)destination_y + source_height <= pClip->top))
+            return (GFX_STATUS_SUCCESS);
+
+        if (destination_x < pClip->left)
+        {
+            clipped = pClip->left - destination_x;
+            source_x_offset += clipped;
+            source_width    -= clipped;
+            destination_x    = pClip->left;
+        }
+        if (destination_y < pClip->top)
+        {
+            clipped = pClip->top - destination_y;
+            source_y_offset += clipped;
+            source_height   -= clipped;
+            destination_y    = pClip->top;
+        }
+        if (destination_x + source_width - 1 > pClip->right)
+            source_width = pClip->right - destination_x + 1;
+        if (destination_y + source_height - 1 > pClip->bottom)
+            source_height = pClip->bottom - destination_y + 1;
+
+        // an image that is not clipped is still drawn as a whole image
+        if ((source_x_offset == 0) && (source_y_offset == 0) &&
+            (source_width == pImage->resource.image.width) &&
+            (source_height == pImage->resource.image.height))
+            source_width = 0;
+    }
+#endif
+
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    if (GFX_DisplayListImageAdd(destination_x,
+                                destination_y,
+                                source_x_offset,
+                                source_y_offset,
+                                source_width,
+                                source_height,
+                                pImage) == GFX_STATUS_SUCCESS)
+        return (GFX_STATUS_SUCCESS);
+#endif
 
     if (GFX_RenderStatusCheck() == GFX_STATUS_BUSY_BIT)
         return (GFX_STATUS_FAILURE);
@@ -6007,6 +8941,40 @@ GFX_STATUS GFX_ImagePartialDraw(
             break;
 
 #endif // #if defined (GFX_USE_DISPLAY_CONTROLLER_MCHP_DA210)
+
+#ifdef GFX_IMAGE_IPU_SOFTWARE_DECODE
+#ifndef GFX_CONFIG_IMAGE_FLASH_DISABLE
+        case GFX_RESOURCE_MCHP_MBITMAP_FLASH_IPU:
+#endif
+#ifndef GFX_CONFIG_IMAGE_EXTERNAL_DISABLE
+        case GFX_RESOURCE_MCHP_MBITMAP_EXTERNAL_IPU:
+#endif
+
+            // without the inflate unit the image is decoded in software
+            GFX_ImageInflateDraw(
+                            destination_x,
+                            destination_y,
+                            pImage, &partialImage);
+            break;
+#endif
+
+#ifdef GFX_CONFIG_JPEG_DECODE_ENABLE
+        case GFX_RESOURCE_JPEG_FILE_NONE:
+            GFX_ImageJpegDraw(
+                            destination_x,
+                            destination_y,
+                            pImage, &partialImage);
+            break;
+#endif
+
+#ifdef GFX_CONFIG_PNG_DECODE_ROW_SIZE
+        case GFX_RESOURCE_PNG_FILE_NONE:
+            GFX_ImagePngDraw(
+                            destination_x,
+                            destination_y,
+                            pImage, &partialImage);
+            break;
+#endif
             
         default:
             break;
@@ -6017,6 +8985,116 @@ GFX_STATUS GFX_ImagePartialDraw(
     return (GFX_STATUS_SUCCESS);
 }
 
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_ImagePartialLinesGet(
+                                uint16_t destination_x,
+                                uint16_t destination_y,
+                                uint16_t source_x_offset,
+                                uint16_t source_y_offset,
+                                uint16_t source_width,
+                                uint16_t source_height,
+                                GFX_RESOURCE_HDR *pImage,
+                                GFX_IMAGE_LINE_CALLBACK pCallback)
+
+    Summary:
+        This function decodes a portion of an image and passes each
+        line to a callback function.
+
+    Description:
+        This function decodes the same portion of the image as
+        GFX_ImagePartialDraw() but instead of rendering the lines to
+        the frame buffer, each decoded line is passed to pCallback
+        with the frame buffer position where it would have been
+        rendered. All the lines are decoded in one pass, the image
+        header and palette are read once and compressed images are
+        not searched again for every line.
+
+        Only the images decoded by the library (uncompressed and
+        RLE compressed images in flash or external memory) are
+        supported. GFX_STATUS_FAILURE is returned for the other
+        images, these can still be decoded one line at a time with
+        GFX_ImagePartialDraw() and GFX_RenderToDisplayBufferDisable().
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_ImagePartialLinesGet(
+                                uint16_t destination_x,
+                                uint16_t destination_y,
+                                uint16_t source_x_offset,
+                                uint16_t source_y_offset,
+                                uint16_t source_width,
+                                uint16_t source_height,
+                                GFX_RESOURCE_HDR *pImage,
+                                GFX_IMAGE_LINE_CALLBACK pCallback)
+{
+    GFX_STATUS  status;
+
+    switch(pImage->type)
+    {
+#if defined (GFX_USE_DISPLAY_CONTROLLER_MCHP_DA210)
+#ifndef GFX_CONFIG_IMAGE_FLASH_DISABLE
+        case GFX_RESOURCE_MCHP_MBITMAP_FLASH_NONE:
+#endif
+#ifndef GFX_CONFIG_IMAGE_EXTERNAL_DISABLE
+        case GFX_RESOURCE_MCHP_MBITMAP_EXTERNAL_NONE:
+#endif
+            // the driver renders the 1, 4 and 8 bpp images with the
+            // RCC, the lines are not decoded
+            if (pImage->resource.image.colorDepth < 16)
+                return (GFX_STATUS_FAILURE);
+            break;
+#ifndef GFX_CONFIG_RLE_DECODE_DISABLE
+#ifndef GFX_CONFIG_IMAGE_FLASH_DISABLE
+        case GFX_RESOURCE_MCHP_MBITMAP_FLASH_RLE:
+#endif
+#ifndef GFX_CONFIG_IMAGE_EXTERNAL_DISABLE
+        case GFX_RESOURCE_MCHP_MBITMAP_EXTERNAL_RLE:
+#endif
+#endif
+#else
+#ifndef GFX_CONFIG_IMAGE_FLASH_DISABLE
+        case GFX_RESOURCE_MCHP_MBITMAP_FLASH_NONE:
+#ifndef GFX_CONFIG_RLE_DECODE_DISABLE
+        case GFX_RESOURCE_MCHP_MBITMAP_FLASH_RLE:
+#endif
+#endif
+#ifndef GFX_CONFIG_IMAGE_EXTERNAL_DISABLE
+        case GFX_RESOURCE_MCHP_MBITMAP_EXTERNAL_NONE:
+#ifndef GFX_CONFIG_RLE_DECODE_DISABLE
+        case GFX_RESOURCE_MCHP_MBITMAP_EXTERNAL_RLE:
+#endif
+#endif
+#endif // #if defined (GFX_USE_DISPLAY_CONTROLLER_MCHP_DA210)
+#ifdef GFX_IMAGE_IPU_SOFTWARE_DECODE
+#ifndef GFX_CONFIG_IMAGE_FLASH_DISABLE
+        case GFX_RESOURCE_MCHP_MBITMAP_FLASH_IPU:
+#endif
+#ifndef GFX_CONFIG_IMAGE_EXTERNAL_DISABLE
+        case GFX_RESOURCE_MCHP_MBITMAP_EXTERNAL_IPU:
+#endif
+#endif
+#ifdef GFX_CONFIG_PNG_DECODE_ROW_SIZE
+        case GFX_RESOURCE_PNG_FILE_NONE:
+#endif
+            break;
+
+        default:
+            return (GFX_STATUS_FAILURE);
+    }
+
+    gfxImageLineCallback = pCallback;
+    status = GFX_ImagePartialDraw(  destination_x,
+                                    destination_y,
+                                    source_x_offset,
+                                    source_y_offset,
+                                    source_width,
+                                    source_height,
+                                    pImage);
+    gfxImageLineCallback = NULL;
+
+    return (status);
+}
 
 // *****************************************************************************
 /*  Function:
@@ -6115,230 +9193,483 @@ int16_t GFX_SineCosineGet(int16_t v, GFX_TRIG_FUNCTION_TYPE type)
     #error "Gradient feature is not currently supported when palette is enabled."
 #endif
 
+#if defined (GFX_CONFIG_GRADIENT_DITHER_ENABLE) && (GFX_CONFIG_COLOR_DEPTH == 16)
+    // the gradient colors are dithered when rendered
+    #define GFX_GRADIENT_DITHER
+
+    // 4x4 ordered dither thresholds
+    static const uint8_t gfxGradientDither[4][4] =
+    {
+        {  0,  8,  2, 10 },
+        { 12,  4, 14,  6 },
+        {  3, 11,  1,  9 },
+        { 15,  7, 13,  5 },
+    };
+#endif
+
 // *****************************************************************************
 /*  Function:
-    GFX_STATUS GFX_BarGradientDraw(
-                                uint16_t left,
-                                uint16_t top,
-                                uint16_t right,
-                                uint16_t bottom)
+    void GFX_GradientDDAInitialize(
+                                GFX_GRADIENT_DDA *pDDA,
+                                GFX_COLOR startColor,
+                                GFX_COLOR endColor,
+                                uint16_t steps)
 
     Summary:
-        This function renders a bar filled gradient colors.
+        This function is an internal function and should not
+        be called by the application.
 
     Description:
-        This function renders a bar filled gradient colors. The gradient
-        start and end colors are set by GFX_GradientColorSet().
-         <img name="BarGradient.jpg" />
-
-        The rendering of this shape becomes undefined when any one of the
-        following is true:
-        - Any of the following pixel locations left,top or right,bottom
-          falls outside the frame buffer.
-        - Fill style is not set (GFX_FillStyleSet(), before this function
-          is called.
-        - Gradient colors are not set before this function is called.
-        - When right < left
-        - When bottom < top
-        - When pixel locations defined by left, top and/or right, bottom
-          are not on the frame buffer.
+        Sets up the color components of a gradient that changes
+        from startColor to endColor in the given number of steps.
+        The gradient has only the start color when steps is 0.
 
 */
 // *****************************************************************************
-GFX_STATUS GFX_BarGradientDraw(
-                                uint16_t left,
-                                uint16_t top,
-                                uint16_t right,
-                                uint16_t bottom)
+static void GFX_GradientDDAInitialize(
+                                GFX_GRADIENT_DDA *pDDA,
+                                GFX_COLOR startColor,
+                                GFX_COLOR endColor,
+                                uint16_t steps)
 {
+    pDDA->red   = (int32_t)GFX_ComponentRedGet(startColor) << 16;
+    pDDA->green = (int32_t)GFX_ComponentGreenGet(startColor) << 16;
+    pDDA->blue  = (int32_t)GFX_ComponentBlueGet(startColor) << 16;
 
-    typedef enum
+    if (steps == 0)
     {
-        BAR_GRADIENT_IDLE,
-        BAR_GRADIENT_FILL_CHECK,
-        BAR_GRADIENT_FILL,
-        BAR_GRADIENT_FILL_DOUBLE,
-        BAR_GRADIENT_FILL_CALC,
-    } BAR_GRADIENT_FILL_STATES;
+        pDDA->redStep   = 0;
+        pDDA->greenStep = 0;
+        pDDA->blueStep  = 0;
+        return;
+    }
 
-    static uint16_t  x1,  y1,  x2,  y2;
-    static uint16_t doDraw = 0, doDouble;
-    static uint16_t px1, py1, px2, py2;
-    static GFX_COLOR color1, color2;
+    pDDA->redStep   = (((int32_t)GFX_ComponentRedGet(endColor) << 16) - pDDA->red) / steps;
+    pDDA->greenStep = (((int32_t)GFX_ComponentGreenGet(endColor) << 16) - pDDA->green) / steps;
+    pDDA->blueStep  = (((int32_t)GFX_ComponentBlueGet(endColor) << 16) - pDDA->blue) / steps;
+}
 
-    static uint16_t startRed, startBlue, startGreen;
-    static uint16_t endRed, endBlue, endGreen;
-    static int32_t rdiff=0,gdiff=0,bdiff=0;
-    static int16_t steps;
+// *****************************************************************************
+/*  Function:
+    GFX_COLOR GFX_GradientColorGet(
+                                GFX_GRADIENT_DDA *pDDA,
+                                uint16_t step)
 
-    static uint16_t  i, barSize = 1;
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
 
-    static GFX_FILL_STYLE direction;
+    Description:
+        Returns the color of the gradient at the given step. The
+        color components are rounded to the nearest value.
 
-    x1 = px1 = left;
-    y1 = py1 = top;
-    x2 = px2 = right;
-    y2 = py2 = bottom;
+*/
+// *****************************************************************************
+static GFX_COLOR GFX_GradientColorGet(
+                                GFX_GRADIENT_DDA *pDDA,
+                                uint16_t step)
+{
+    return (GFX_RGBConvert(
+                ((pDDA->red   + (pDDA->redStep   * step) + 0x8000) >> 16),
+                ((pDDA->green + (pDDA->greenStep * step) + 0x8000) >> 16),
+                ((pDDA->blue  + (pDDA->blueStep  * step) + 0x8000) >> 16)));
+}
 
-    color1    = GFX_GradientStartColorGet();
-    color2    = GFX_GradientEndColorGet();
-    direction = GFX_FillStyleGet();
-    doDouble  = 0;
+// *****************************************************************************
+/*  Function:
+    void GFX_GradientLineFill(
+                                GFX_GRADIENT_DDA *pDDA,
+                                GFX_COLOR *pBuffer,
+                                uint16_t count,
+                                uint16_t step,
+                                int16_t increment,
+                                uint16_t x,
+                                uint16_t y)
 
-    switch(direction)
-    {
-        case GFX_FILL_STYLE_GRADIENT_UP:
-        case GFX_FILL_STYLE_GRADIENT_DOWN:
-            steps = (bottom - top);
-            break;
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
 
-        case GFX_FILL_STYLE_GRADIENT_LEFT:
-        case GFX_FILL_STYLE_GRADIENT_RIGHT:
-            steps = (right - left);
-            break;
+    Description:
+        Fills the buffer with the colors of count pixels of a row
+        starting at pixel x,y. The first pixel has the color of the
+        given step and the step changes by increment (1, -1 or 0)
+        from pixel to pixel. The colors are dithered with the
+        position of the pixels when GFX_CONFIG_GRADIENT_DITHER_ENABLE
+        is defined.
 
-        case GFX_FILL_STYLE_GRADIENT_DOUBLE_VER:
-            steps = (right - left) >> 1;
-            doDouble = 1;
-            break;
+*/
+// *****************************************************************************
+static void GFX_GradientLineFill(
+                                GFX_GRADIENT_DDA *pDDA,
+                                GFX_COLOR *pBuffer,
+                                uint16_t count,
+                                uint16_t step,
+                                int16_t increment,
+                                uint16_t x,
+                                uint16_t y)
+{
+    int32_t     red, green, blue;
+    int32_t     redStep, greenStep, blueStep;
+#ifdef GFX_GRADIENT_DITHER
+    int32_t     r, g, b, threshold;
+    const uint8_t *pDither = gfxGradientDither[y & 3];
+#endif
 
-        case GFX_FILL_STYLE_GRADIENT_DOUBLE_HOR:
-            steps = (bottom - top) >> 1;
-            doDouble = 1;
-            break;
+    red       = pDDA->red   + (pDDA->redStep   * step);
+    green     = pDDA->green + (pDDA->greenStep * step);
+    blue      = pDDA->blue  + (pDDA->blueStep  * step);
+    redStep   = pDDA->redStep   * increment;
+    greenStep = pDDA->greenStep * increment;
+    blueStep  = pDDA->blueStep  * increment;
 
-        default:
-            // this should not happen
-            return (GFX_STATUS_FAILURE);
+    while(count--)
+    {
+#ifdef GFX_GRADIENT_DITHER
+        // the threshold is spread over the values dropped by
+        // the 5 bits of red and blue and the 6 bits of green
+        threshold = ((int32_t)pDither[x & 3] << 1) + 1;
+        r = (red   + (threshold << 14)) >> 16;
+        g = (green + (threshold << 13)) >> 16;
+        b = (blue  + (threshold << 14)) >> 16;
+        if (r > 0xFF)
+            r = 0xFF;
+        if (g > 0xFF)
+            g = 0xFF;
+        if (b > 0xFF)
+            b = 0xFF;
+        *pBuffer++ = GFX_RGBConvert(r, g, b);
+        x++;
+#else
+        *pBuffer++ = GFX_RGBConvert(
+                        ((red   + 0x8000) >> 16),
+                        ((green + 0x8000) >> 16),
+                        ((blue  + 0x8000) >> 16));
+#endif
+        red   += redStep;
+        green += greenStep;
+        blue  += blueStep;
     }
-    
-    startRed    = GFX_ComponentRedGet(color1);
-    startGreen  = GFX_ComponentGreenGet(color1);
-    startBlue   = GFX_ComponentBlueGet(color1);
-
-    endRed      = GFX_ComponentRedGet(color2);
-    endGreen    = GFX_ComponentGreenGet(color2);
-    endBlue     = GFX_ComponentBlueGet(color2);
-
-    ///////////////////////////////////
+}
 
-    //Find the step size for the red portion
-    rdiff = ((int32_t)endRed - (int32_t)startRed) << 8;
-    rdiff /= steps;
+// *****************************************************************************
+/*  Function:
+    void GFX_GradientRowFill(
+                                GFX_GRADIENT_DDA *pDDA,
+                                GFX_FILL_STYLE direction,
+                                uint16_t left,
+                                uint16_t right,
+                                uint16_t x1,
+                                uint16_t x2,
+                                uint16_t y)
 
-    //Find the step size for the green portion
-    gdiff = ((int32_t)endGreen - (int32_t)startGreen) << 8;
-    gdiff /= steps;
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
 
-    //Find the step size for the blue portion
-    bdiff = ((int32_t)endBlue - (int32_t)startBlue) << 8;
-    bdiff /= steps;
+    Description:
+        Fills the line buffer with the pixels x1 to x2 of row y of a
+        gradient that changes from column to column between left
+        and right.
 
-    color1 = GFX_RGBConvert(startRed, startGreen, startBlue);
-    i = 0;
-    barSize = 1;
-    doDraw = 1;
+*/
+// *****************************************************************************
+static void GFX_GradientRowFill(
+                                GFX_GRADIENT_DDA *pDDA,
+                                GFX_FILL_STYLE direction,
+                                uint16_t left,
+                                uint16_t right,
+                                uint16_t x1,
+                                uint16_t x2,
+                                uint16_t y)
+{
+    GFX_COLOR   *pBuffer = gfxLineBuffer0;
+    uint16_t    middle, count;
 
-    while(i <= steps)
+    switch(direction)
     {
-        if (doDraw)
-        {
-            GFX_ColorSet(color2);
-            while(GFX_BarDraw(x1, y1, x2, y2) == GFX_STATUS_FAILURE);
+        case GFX_FILL_STYLE_GRADIENT_RIGHT:
+            GFX_GradientLineFill(pDDA, pBuffer, x2 - x1 + 1, x1 - left, 1, x1, y);
+            break;
+
+        case GFX_FILL_STYLE_GRADIENT_LEFT:
+            GFX_GradientLineFill(pDDA, pBuffer, x2 - x1 + 1, right - x1, -1, x1, y);
+            break;
 
-            if (doDouble)
+        default:
+            // the end color is in the middle, the left half
+            // of the gradient is mirrored on the right half
+            middle = left + ((right - left) >> 1);
+            if (x1 <= middle)
             {
-                while(GFX_BarDraw(px1, py1, px2, py2) == GFX_STATUS_FAILURE);
+                count = ((x2 < middle) ? x2 : middle) - x1 + 1;
+                GFX_GradientLineFill(pDDA, pBuffer, count, x1 - left, 1, x1, y);
+                pBuffer += count;
+                x1 += count;
             }
-            barSize = 1;
-            doDraw = 0;
-        }
+            if (x1 <= x2)
+            {
+                GFX_GradientLineFill(pDDA, pBuffer, x2 - x1 + 1, right - x1, -1, x1, y);
+            }
+            break;
+    }
+}
 
-        //Calculate the new RGB values
-        endRed      = startRed   + ((int32_t)(rdiff*i) >> 8);
-        endGreen    = startGreen + ((int32_t)(gdiff*i) >> 8);
-        endBlue     = startBlue  + ((int32_t)(bdiff*i) >> 8);
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_GradientRowColorGet(
+                                GFX_GRADIENT_DDA *pDDA,
+                                uint16_t step,
+                                uint16_t x,
+                                uint16_t width,
+                                uint16_t y,
+                                GFX_COLOR *pColor)
 
-        color2 = GFX_RGBConvert(endRed, endGreen, endBlue);
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
 
-        // if color matches increase the bar size so we only call one
-        // bar call to lines with the same color
-        if(color2 == color1)
-        {
-            barSize++;
-        }
-        else
-        {
-            doDraw = 1;
-            color1 = color2;
+    Description:
+        Gets the color of a row of a gradient that changes from row
+        to row. Returns GFX_STATUS_FAILURE when the dithered row has
+        more than one color, the pixels of the row are then in the
+        line buffer.
 
-            switch(direction)
-            {
-                case GFX_FILL_STYLE_GRADIENT_DOWN:
-                    y1 = top;
-                    y2 = top + barSize;
-                    if (y2 > bottom)
-                        y2 = bottom;
-                    top += (barSize);
-                    break;
+*/
+// *****************************************************************************
+static GFX_STATUS GFX_GradientRowColorGet(
+                                GFX_GRADIENT_DDA *pDDA,
+                                uint16_t step,
+                                uint16_t x,
+                                uint16_t width,
+                                uint16_t y,
+                                GFX_COLOR *pColor)
+{
+#ifdef GFX_GRADIENT_DITHER
+    uint16_t    i, count;
 
-                case GFX_FILL_STYLE_GRADIENT_UP:
-                case GFX_FILL_STYLE_GRADIENT_DOUBLE_HOR:
-                    y1 = bottom - barSize;
-                    y2 = bottom;
-                    if (y1 < top)
-                        y1 = top;
-                    bottom -= (barSize);
-                    if (doDouble)
-                    {
-                        py1 = top;
-                        py2 = top + barSize;
-                        if (py2 > bottom)
-                            py2 = bottom;
-                        top += (barSize);
-                    }
-                    break;
+    // the dither pattern repeats every 4 pixels
+    count = (width < 4) ? width : 4;
+    GFX_GradientLineFill(pDDA, gfxLineBuffer0, count, step, 0, x, y);
 
-                case GFX_FILL_STYLE_GRADIENT_RIGHT:
-                    x1 = left;
-                    x2 = left + barSize;
-                    if (x2 > right)
-                        x2 = right;
-                    left += (barSize);
-                    break;
+    *pColor = gfxLineBuffer0[0];
+    for(i = 1; i < count; i++)
+    {
+        if (gfxLineBuffer0[i] != *pColor)
+            break;
+    }
+    if (i == count)
+        return (GFX_STATUS_SUCCESS);
 
-                case GFX_FILL_STYLE_GRADIENT_LEFT:
-                case GFX_FILL_STYLE_GRADIENT_DOUBLE_VER:
-                    x1 = right - barSize;
-                    x2 = right;
-                    if (x1 < left)
-                        x1 = left;
-                    right -= (barSize);
+    for(i = count; i < width; i++)
+        gfxLineBuffer0[i] = gfxLineBuffer0[i - 4];
+    return (GFX_STATUS_FAILURE);
+#else
+    *pColor = GFX_GradientColorGet(pDDA, step);
+    return (GFX_STATUS_SUCCESS);
+#endif
+}
 
-                    if (doDouble)
-                    {
-                        px1 = left;
-                        px2 = left + barSize;
-                        if (px2 > right)
-                            px2 = right;
-                        left += (barSize);
-                    }
-                    break;
+// *****************************************************************************
+/*  Function:
+    void GFX_GradientRowPut(
+                                uint16_t x,
+                                uint16_t y,
+                                uint16_t width)
 
-                default:
-                    break;
-            } // end of switch
-        } // end of else...
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Renders the pixels of a gradient row from the line buffer.
+        The pixels are not compared with the transparent color.
+
+*/
+// *****************************************************************************
+static void GFX_GradientRowPut(
+                                uint16_t x,
+                                uint16_t y,
+                                uint16_t width)
+{
+#ifndef GFX_CONFIG_TRANSPARENT_COLOR_DISABLE
+    GFX_FEATURE_STATUS transparentStatus = GFX_TransparentColorStatusGet();
 
-        // update the counter
-        i++;
+    GFX_TransparentColorDisable();
+#endif
 
-    } // end of while ...
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // the recorded commands are drawn before the pixels are written
+    GFX_DisplayListFlush();
+#endif
 
-    return (GFX_STATUS_SUCCESS);
+    GFX_PixelArrayPut(x, y, gfxLineBuffer0, width);
 
+#ifndef GFX_CONFIG_TRANSPARENT_COLOR_DISABLE
+    if (transparentStatus == GFX_FEATURE_ENABLED)
+        GFX_TransparentColorEnable(GFX_TransparentColorGet());
+#endif
 }
 
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_BarGradientDraw(
+                                uint16_t left,
+                                uint16_t top,
+                                uint16_t right,
+                                uint16_t bottom)
+
+    Summary:
+        This function renders a bar filled gradient colors.
+
+    Description:
+        This function renders a bar filled gradient colors. The gradient
+        start and end colors are set by GFX_GradientColorSet().
+         <img name="BarGradient.jpg" />
+
+        Rows of one color are rendered as bars. When the color
+        changes from column to column, the row is computed once and
+        every row is rendered with GFX_PixelArrayPut(). The colors
+        of 16 bpp gradients are dithered when
+        GFX_CONFIG_GRADIENT_DITHER_ENABLE is defined.
+
+        The rendering of this shape becomes undefined when any one of the
+        following is true:
+        - Any of the following pixel locations left,top or right,bottom
+          falls outside the frame buffer.
+        - Fill style is not set (GFX_FillStyleSet(), before this function
+          is called.
+        - Gradient colors are not set before this function is called.
+        - When right < left
+        - When bottom < top
+        - When pixel locations defined by left, top and/or right, bottom
+          are not on the frame buffer.
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_BarGradientDraw(
+                                uint16_t left,
+                                uint16_t top,
+                                uint16_t right,
+                                uint16_t bottom)
+{
+    GFX_GRADIENT_DDA    dda;
+    GFX_FILL_STYLE      direction;
+    GFX_STATUS          status;
+    GFX_COLOR           color, barColor = 0;
+    uint16_t            x1, y1, x2, y2, y, barTop;
+    uint16_t            steps, i, width;
+
+    direction = GFX_FillStyleGet();
+
+    switch(direction)
+    {
+        case GFX_FILL_STYLE_GRADIENT_UP:
+        case GFX_FILL_STYLE_GRADIENT_DOWN:
+            steps = (bottom - top);
+            break;
+
+        case GFX_FILL_STYLE_GRADIENT_LEFT:
+        case GFX_FILL_STYLE_GRADIENT_RIGHT:
+            steps = (right - left);
+            break;
+
+        case GFX_FILL_STYLE_GRADIENT_DOUBLE_VER:
+            steps = (right - left) >> 1;
+            break;
+
+        case GFX_FILL_STYLE_GRADIENT_DOUBLE_HOR:
+            steps = (bottom - top) >> 1;
+            break;
+
+        default:
+            // this should not happen
+            return (GFX_STATUS_FAILURE);
+    }
+
+    // the colors are computed from the position in the whole bar,
+    // only the visible part of the bar is rendered
+    x1 = left;
+    y1 = top;
+    x2 = right;
+    y2 = bottom;
+
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+    if (GFX_ClipAreaAdjust(&x1, &y1, &x2, &y2) == GFX_STATUS_FAILURE)
+        return (GFX_STATUS_SUCCESS);
+#endif
+
+    GFX_GradientDDAInitialize(
+                                &dda,
+                                GFX_GradientStartColorGet(),
+                                GFX_GradientEndColorGet(),
+                                steps);
+    width = x2 - x1 + 1;
+
+    if (    (direction == GFX_FILL_STYLE_GRADIENT_RIGHT) ||
+            (direction == GFX_FILL_STYLE_GRADIENT_LEFT)  ||
+            (direction == GFX_FILL_STYLE_GRADIENT_DOUBLE_VER))
+    {
+        // the color changes from column to column, the rows are
+        // the same and are written from the line buffer
+        for(y = y1; y <= y2; y++)
+        {
+#ifndef GFX_GRADIENT_DITHER
+            if (y == y1)
+#endif
+            {
+                GFX_GradientRowFill(&dda, direction, left, right, x1, x2, y);
+            }
+            GFX_GradientRowPut(x1, y, width);
+        }
+        return (GFX_STATUS_SUCCESS);
+    }
+
+    // the color changes from row to row, the rows of one color
+    // are rendered as one bar
+    barTop = y1;
+    for(y = y1; y <= y2; y++)
+    {
+        if (direction == GFX_FILL_STYLE_GRADIENT_DOWN)
+            i = y - top;
+        else if (direction == GFX_FILL_STYLE_GRADIENT_UP)
+            i = bottom - y;
+        else
+            i = ((y - top) < (bottom - y)) ? (y - top) : (bottom - y);
+
+        status = GFX_GradientRowColorGet(&dda, i, x1, width, y, &color);
+        if ((status == GFX_STATUS_SUCCESS) && (y != barTop) && (color == barColor))
+            continue;
+
+        // the rows before this one have one color
+        if (y != barTop)
+        {
+            GFX_ColorSet(barColor);
+            while(GFX_BarDraw(x1, barTop, x2, y - 1) == GFX_STATUS_FAILURE);
+        }
+
+        if (status == GFX_STATUS_SUCCESS)
+        {
+            barTop = y;
+            barColor = color;
+        }
+        else
+        {
+            // the dithered row has more than one color
+            GFX_GradientRowPut(x1, y, width);
+            barTop = y + 1;
+        }
+    }
+
+    if (barTop <= y2)
+    {
+        GFX_ColorSet(barColor);
+        while(GFX_BarDraw(x1, barTop, x2, y2) == GFX_STATUS_FAILURE);
+    }
+
+    return (GFX_STATUS_SUCCESS);
+
+}
 
 // *****************************************************************************
 /*  Function:
@@ -6380,40 +9711,9 @@ GFX_STATUS GFX_BevelGradientDraw(
                                 uint16_t bottom,
                                 uint16_t rad)
 {
-    typedef enum
-    {
-        BEVEL_GRADIENT_IDLE,
-        BEVEL_GRADIENT_BEGIN,
-        BEVEL_GRADIENT_CHECK,
-        BEVEL_GRADIENT_CALC_Q8TOQ1,
-        BEVEL_GRADIENT_Q8TOQ1,
-        BEVEL_GRADIENT_CALC_Q7TOQ2,
-        BEVEL_GRADIENT_Q7TOQ2,
-        BEVEL_GRADIENT_CALC_Q6TOQ3,
-        BEVEL_GRADIENT_Q6TOQ3,
-        BEVEL_GRADIENT_CALC_Q5TOQ4,
-        BEVEL_GRADIENT_Q5TOQ4,
-        BEVEL_GRADIENT_FACE_CHECK,
-        BEVEL_GRADIENT_FACE,
-    } BEVEL_GRADIENT_FILL_STATES;
-
+    GFX_BEVEL_GRADIENT_DRAW_PARAM *pState = &(pGfxContext->bevelGradient);
     PRIMITIVE_UINT32_UNION temp;
-    static int32_t err;
-    static int16_t yLimit, xPos, yPos;
-    static int16_t xCur, yCur, yNew;
-
-    static int16_t x1, y1, x2, y2, doDouble;
-
-    static BEVEL_GRADIENT_FILL_STATES state = BEVEL_GRADIENT_IDLE;
-
-    static int16_t sred = 0, sblue = 0, sgreen = 0;
-    static int16_t ered = 0, eblue = 0, egreen = 0;
-    static int32_t rdiff = 0, gdiff = 0, bdiff = 0;
-    static int16_t steps;
-
-    static GFX_FILL_STYLE direction = 0;
-    static GFX_COLOR      color1, color2;
-    static GFX_COLOR      sStart = 0, sEnd = 0;
+    uint16_t steps;
 
     uint16_t i;
     GFX_COLOR EndColor = 0;
@@ -6423,163 +9723,143 @@ GFX_STATUS GFX_BevelGradientDraw(
         if (GFX_RenderStatusCheck() == GFX_STATUS_BUSY_BIT)
             return (GFX_STATUS_FAILURE);
 
-        switch (state)
+        switch (pState->state)
         {
             case BEVEL_GRADIENT_IDLE:
 
-                EndColor  = color2 = GFX_GradientEndColorGet();
-                color1    = GFX_GradientStartColorGet();
-                direction = GFX_FillStyleGet();
-                doDouble  = 0;
+                EndColor  = pState->color2 = GFX_GradientEndColorGet();
+                pState->color1    = GFX_GradientStartColorGet();
+                pState->direction = GFX_FillStyleGet();
+                pState->doDouble  = 0;
 
                 //This switch statement calculates the amount of transitions needed
-                switch (direction)
+                switch (pState->direction)
                 {
                     case GFX_FILL_STYLE_GRADIENT_UP:
                     case GFX_FILL_STYLE_GRADIENT_DOWN:
-                        steps = (bottom - top + 1 + (rad << 1));
+                        pState->extent = bottom - top;
+                        steps = (pState->extent + 1 + (rad << 1));
                         break;
 
                     case GFX_FILL_STYLE_GRADIENT_RIGHT:
                     case GFX_FILL_STYLE_GRADIENT_LEFT:
-                        steps = (right - left + 1 + (rad << 1));
+                        pState->extent = right - left;
+                        steps = (pState->extent + 1 + (rad << 1));
                         break;
 
                     case GFX_FILL_STYLE_GRADIENT_DOUBLE_VER:
-                        steps = (right - left + 1 + (rad << 1)) >> 1;
-                        doDouble = 1;
+                        pState->extent = right - left;
+                        steps = (pState->extent + 1 + (rad << 1)) >> 1;
+                        pState->doDouble = 1;
                         break;
 
                     case GFX_FILL_STYLE_GRADIENT_DOUBLE_HOR:
-                        steps = (bottom - top + 1 + (rad << 1)) >> 1;
-                        doDouble = 1;
+                        pState->extent = bottom - top;
+                        steps = (pState->extent + 1 + (rad << 1)) >> 1;
+                        pState->doDouble = 1;
                         break;
 
                     default:
                         return (GFX_STATUS_SUCCESS);
                 }
 
-                //Calculate the starting RGB values
-                sred    = GFX_ComponentRedGet(color1);
-                sgreen  = GFX_ComponentGreenGet(color1);
-                sblue   = GFX_ComponentBlueGet(color1);
-
-                ered    = GFX_ComponentRedGet(color2);
-                egreen  = GFX_ComponentGreenGet(color2);
-                eblue   = GFX_ComponentBlueGet(color2);
-
-                ///////////////////////////////////
-
-                //Find the step size for the red portion//
-                rdiff = ((int32_t)ered - (int32_t)sred) << 8;
-                rdiff /= steps;
+                GFX_GradientDDAInitialize(&pState->dda, pState->color1, pState->color2, steps);
 
-                //Find the step size for the green portion//
-                gdiff = ((int32_t)egreen - (int32_t)sgreen) << 8;
-                gdiff /= steps;
+                pState->sStart = GFX_GradientStartColorGet();
+                pState->sEnd   = GFX_GradientEndColorGet();
 
-                //Find the step size for the blue portion//
-                bdiff = ((int32_t)eblue - (int32_t)sblue) << 8;
-                bdiff /= steps;
-
-                sStart = GFX_GradientStartColorGet();
-                sEnd   = GFX_GradientEndColorGet();
-
-                state = BEVEL_GRADIENT_BEGIN;
+                pState->state = BEVEL_GRADIENT_BEGIN;
                 // no break here since we want the next state anyway
 
             case BEVEL_GRADIENT_BEGIN:
                 if (rad == 0)
                 {   // no radius object is a filled rectangle
-                    state = BEVEL_GRADIENT_FACE_CHECK;
+                    pState->state = BEVEL_GRADIENT_FACE_CHECK;
                     break;
                 }
 
                 // compute variables
                 temp.uint32Value = SIN45 * rad;
-                yLimit = temp.uint3216BitValue[1];
+                pState->yLimit = temp.uint3216BitValue[1];
                 temp.uint32Value = (uint32_t) (ONEP25 - ((int32_t) rad << 16));
-                err = (int16_t) (temp.uint3216BitValue[1]);
-                xPos = rad;
-                yPos = 0;
-                xCur = xPos;
-                yCur = yPos;
-                yNew = yPos;
-                state = BEVEL_GRADIENT_CHECK;
+                pState->err = (int16_t) (temp.uint3216BitValue[1]);
+                pState->xPos = rad;
+                pState->yPos = 0;
+                pState->xCur = pState->xPos;
+                pState->yCur = pState->yPos;
+                pState->yNew = pState->yPos;
+                pState->state = BEVEL_GRADIENT_CHECK;
                 // no break here since we want the next state anyway
 
             case BEVEL_GRADIENT_CHECK:
 
                 //bevel_fill_check : if (yPos > yLimit)
                 // check if we have reached our limit
-                if (yPos > yLimit)
+                if (pState->yPos > pState->yLimit)
                 {
-                    state = BEVEL_GRADIENT_FACE_CHECK;
+                    pState->state = BEVEL_GRADIENT_FACE_CHECK;
                     break;
                 }
                 else
                 {
 
                     // New records the last y position
-                    yNew = yPos;
+                    pState->yNew = pState->yPos;
 
                     // calculate the next value of x and y
-                    if (err > 0)
+                    if (pState->err > 0)
                     {
-                        xPos--;
-                        err += 5 + ((yPos - xPos) << 1);
+                        pState->xPos--;
+                        pState->err += 5 + ((pState->yPos - pState->xPos) * 2);
                     }
                     else
-                        err += 3 + (yPos << 1);
-                    yPos++;
-                    state = BEVEL_GRADIENT_CALC_Q6TOQ3;
+                        pState->err += 3 + (pState->yPos << 1);
+                    pState->yPos++;
+                    pState->state = BEVEL_GRADIENT_CALC_Q6TOQ3;
                 }
                 // no break here since we want the next state anyway
 
             case BEVEL_GRADIENT_CALC_Q6TOQ3:
 
                 // 6th octant to 3rd octant
-                if ( doDouble == 1)
-                    i = (top - yCur) - top + rad;
+                if ( pState->doDouble == 1)
+                    i = (top - pState->yCur) - top + rad;
                 else
-                    i = (bottom + yCur) - top + rad;
+                    i = pState->extent + pState->yCur + rad;
 
-                ered   = sred   + ((int32_t)(rdiff * i) >> 8);
-                egreen = sgreen + ((int32_t)(gdiff * i) >> 8);
-                eblue  = sblue  + ((int32_t)(bdiff * i) >> 8);
-                color2 = GFX_RGBConvert(ered, egreen, eblue);
-                GFX_ColorSet(color2);
+                pState->color2 = GFX_GradientColorGet(&pState->dda, i);
+                GFX_ColorSet(pState->color2);
 
-                switch (direction)    //Direction matter because different portions of the circle are drawn
+                switch (pState->direction)    //Direction matter because different portions of the circle are drawn
                 {
                     case GFX_FILL_STYLE_GRADIENT_LEFT:
-                        x1 = left - yNew;
-                        y1 = top - xCur;
-                        x2 = left - yCur;
-                        y2 = bottom + xCur;
+                        pState->x1 = left - pState->yNew;
+                        pState->y1 = top - pState->xCur;
+                        pState->x2 = left - pState->yCur;
+                        pState->y2 = bottom + pState->xCur;
                         break;
 
                     case GFX_FILL_STYLE_GRADIENT_RIGHT:
                     case GFX_FILL_STYLE_GRADIENT_DOUBLE_VER:
-                        x1 = right + yCur;
-                        y1 = top - xCur;
-                        x2 = right + yNew;
-                        y2 = bottom + xCur;
+                        pState->x1 = right + pState->yCur;
+                        pState->y1 = top - pState->xCur;
+                        pState->x2 = right + pState->yNew;
+                        pState->y2 = bottom + pState->xCur;
                         break;
 
                     case GFX_FILL_STYLE_GRADIENT_UP:
-                        x1 = left - xCur;
-                        y1 = top - yNew;
-                        x2 = right + xCur;
-                        y2 = top - yCur;
+                        pState->x1 = left - pState->xCur;
+                        pState->y1 = top - pState->yNew;
+                        pState->x2 = right + pState->xCur;
+                        pState->y2 = top - pState->yCur;
                         break;
 
                     case GFX_FILL_STYLE_GRADIENT_DOWN:
                     case GFX_FILL_STYLE_GRADIENT_DOUBLE_HOR:
-                        x1 = left - xCur;
-                        y1 = bottom + yCur;
-                        x2 = right + xCur;
-                        y2 = bottom + yNew;
+                        pState->x1 = left - pState->xCur;
+                        pState->y1 = bottom + pState->yCur;
+                        pState->x2 = right + pState->xCur;
+                        pState->y2 = bottom + pState->yNew;
                         break;
 
                     default:
@@ -6587,64 +9867,59 @@ GFX_STATUS GFX_BevelGradientDraw(
                         break;
                 } // end of switch...
                 
-                state = BEVEL_GRADIENT_Q6TOQ3;
+                pState->state = BEVEL_GRADIENT_Q6TOQ3;
                 // no break here since the next state is what we want
 
             case BEVEL_GRADIENT_Q6TOQ3:
 
-                if (GFX_BarDraw(x1, y1, x2, y2) != GFX_STATUS_SUCCESS)
+                if (GFX_BarDraw(pState->x1, pState->y1, pState->x2, pState->y2) != GFX_STATUS_SUCCESS)
                     return GFX_STATUS_FAILURE;
 
-                state = BEVEL_GRADIENT_CALC_Q5TOQ4;
+                pState->state = BEVEL_GRADIENT_CALC_Q5TOQ4;
                 // no break here since the next state is what we want
 
             case BEVEL_GRADIENT_CALC_Q5TOQ4:
                 // 5th octant to 4th octant
-                if ( doDouble == 1)
+                if ( pState->doDouble == 1)
                     //i = top + xPos - top + rad;
-                    i = (top - xCur) - top + rad;
+                    i = (top - pState->xCur) - top + rad;
                 else
                     // 5th octant to 4th octant
-                    i = (bottom + xPos) - top + rad ;
+                    i = pState->extent + pState->xPos + rad;
 
-                //Calculate the starting RGB values
-                ered   = sred   + ((int32_t)(rdiff * i) >> 8);
-                egreen = sgreen + ((int32_t)(gdiff * i) >> 8);
-                eblue   = sblue + ((int32_t)(bdiff * i) >> 8);
-
-                color2 = GFX_RGBConvert(ered, egreen, eblue);
-                GFX_ColorSet(color2);
+                pState->color2 = GFX_GradientColorGet(&pState->dda, i);
+                GFX_ColorSet(pState->color2);
                 
-                switch (direction)    //Direction matter because different portions of the circle are drawn
+                switch (pState->direction)    //Direction matter because different portions of the circle are drawn
                 {
                     case GFX_FILL_STYLE_GRADIENT_LEFT:
-                        x1 = left - xCur;
-                        y1 = top - yNew;
-                        x2 = left - xPos;
-                        y2 = bottom + yNew;
+                        pState->x1 = left - pState->xCur;
+                        pState->y1 = top - pState->yNew;
+                        pState->x2 = left - pState->xPos;
+                        pState->y2 = bottom + pState->yNew;
                         break;
 
                     case GFX_FILL_STYLE_GRADIENT_RIGHT:
                     case GFX_FILL_STYLE_GRADIENT_DOUBLE_VER:
-                        x1 = right + xPos;
-                        y1 = top - yNew;
-                        x2 = right + xCur;
-                        y2 = bottom + yNew;
+                        pState->x1 = right + pState->xPos;
+                        pState->y1 = top - pState->yNew;
+                        pState->x2 = right + pState->xCur;
+                        pState->y2 = bottom + pState->yNew;
                         break;
 
                     case GFX_FILL_STYLE_GRADIENT_UP:
-                        x1 = left - yNew;
-                        y1 = top - xCur;
-                        x2 = right + yNew;
-                        y2 = top - xPos;
+                        pState->x1 = left - pState->yNew;
+                        pState->y1 = top - pState->xCur;
+                        pState->x2 = right + pState->yNew;
+                        pState->y2 = top - pState->xPos;
                         break;
 
                     case GFX_FILL_STYLE_GRADIENT_DOWN:
                     case GFX_FILL_STYLE_GRADIENT_DOUBLE_HOR:
-                        x1 = left - yNew;
-                        y1 = bottom + xPos;
-                        x2 = right + yNew;
-                        y2 = bottom + xCur;
+                        pState->x1 = left - pState->yNew;
+                        pState->y1 = bottom + pState->xPos;
+                        pState->x2 = right + pState->yNew;
+                        pState->y2 = bottom + pState->xCur;
                         break;
                         
                     default:
@@ -6652,62 +9927,57 @@ GFX_STATUS GFX_BevelGradientDraw(
                         break;
                 }                
                 
-                state = BEVEL_GRADIENT_Q5TOQ4;
+                pState->state = BEVEL_GRADIENT_Q5TOQ4;
                 // no break here since the next state is what we want
 
             case BEVEL_GRADIENT_Q5TOQ4:
 
-                if (GFX_BarDraw(x1, y1, x2, y2) != GFX_STATUS_SUCCESS)
+                if (GFX_BarDraw(pState->x1, pState->y1, pState->x2, pState->y2) != GFX_STATUS_SUCCESS)
                     return GFX_STATUS_FAILURE;
-                state = BEVEL_GRADIENT_CALC_Q8TOQ1;
+                pState->state = BEVEL_GRADIENT_CALC_Q8TOQ1;
                 // no break here since the next state is what we want
 
             case BEVEL_GRADIENT_CALC_Q8TOQ1:
                 // 8th octant to 1st octant
                 //if (doDouble == 0)
                 {
-                    i = (top - xCur) - top + rad;
+                    i = (top - pState->xCur) - top + rad;
 
-                    //Calculate the starting RGB values
-                    ered   = sred   + ((int32_t)(rdiff * i) >> 8);
-                    egreen = sgreen + ((int32_t)(gdiff * i) >> 8);
-                    eblue  = sblue  + ((int32_t)(bdiff * i) >> 8);
-                    
-                    color2 = GFX_RGBConvert(ered, egreen, eblue);
-                    GFX_ColorSet(color2);
+                    pState->color2 = GFX_GradientColorGet(&pState->dda, i);
+                    GFX_ColorSet(pState->color2);
                 }
                 
-                switch (direction)    //Direction matter because different portions of the circle are drawn
+                switch (pState->direction)    //Direction matter because different portions of the circle are drawn
                 {
                     case GFX_FILL_STYLE_GRADIENT_LEFT:
-                        x1 = right + xPos;
-                        y1 = top - yNew;
-                        x2 = right + xCur;
-                        y2 = bottom + yNew;
+                        pState->x1 = right + pState->xPos;
+                        pState->y1 = top - pState->yNew;
+                        pState->x2 = right + pState->xCur;
+                        pState->y2 = bottom + pState->yNew;
                         break;
 
                     case GFX_FILL_STYLE_GRADIENT_RIGHT:
                     case GFX_FILL_STYLE_GRADIENT_DOUBLE_VER:
-                        x1 = left - xCur;
-                        y1 = top - yNew;
-                        x2 = left - xPos;
-                        y2 = bottom + yNew;
+                        pState->x1 = left - pState->xCur;
+                        pState->y1 = top - pState->yNew;
+                        pState->x2 = left - pState->xPos;
+                        pState->y2 = bottom + pState->yNew;
                         break;
 
                     case GFX_FILL_STYLE_GRADIENT_UP:
 
-                        x1 = left - yNew;
-                        y1 = bottom + xPos;
-                        x2 = right + yNew;
-                        y2 = bottom + xCur;
+                        pState->x1 = left - pState->yNew;
+                        pState->y1 = bottom + pState->xPos;
+                        pState->x2 = right + pState->yNew;
+                        pState->y2 = bottom + pState->xCur;
                         break;
 
                     case GFX_FILL_STYLE_GRADIENT_DOWN:
                     case GFX_FILL_STYLE_GRADIENT_DOUBLE_HOR:
-                        x1 = left - yNew;
-                        y1 = top - xCur;
-                        x2 = right + yNew;
-                        y2 = top - xPos;
+                        pState->x1 = left - pState->yNew;
+                        pState->y1 = top - pState->xCur;
+                        pState->x2 = right + pState->yNew;
+                        pState->y2 = top - pState->xPos;
                         break;
 
                     default:
@@ -6715,60 +9985,55 @@ GFX_STATUS GFX_BevelGradientDraw(
                         break;
                 }
                                 
-                state = BEVEL_GRADIENT_Q8TOQ1;
+                pState->state = BEVEL_GRADIENT_Q8TOQ1;
                 // no break here since the next state is what we want
 
             case BEVEL_GRADIENT_Q8TOQ1:
 
-                if (GFX_BarDraw(x1, y1, x2, y2) != GFX_STATUS_SUCCESS)
+                if (GFX_BarDraw(pState->x1, pState->y1, pState->x2, pState->y2) != GFX_STATUS_SUCCESS)
                     return GFX_STATUS_FAILURE;
                         
-                state = BEVEL_GRADIENT_CALC_Q7TOQ2;
+                pState->state = BEVEL_GRADIENT_CALC_Q7TOQ2;
                 // no break here since the next state is what we want
 
             case BEVEL_GRADIENT_CALC_Q7TOQ2:
 
                 // 7th octant to 2nd octant
-                i = (top - yNew) - top + rad;
+                i = (top - pState->yNew) - top + rad;
 
-                //Calculate the starting RGB values
-                ered   = sred   + ((int32_t)(rdiff * i) >> 8);
-                egreen = sgreen + ((int32_t)(gdiff * i) >> 8);
-                eblue  = sblue  + ((int32_t)(bdiff * i) >> 8);
+                pState->color2 = GFX_GradientColorGet(&pState->dda, i);
+                GFX_ColorSet(pState->color2);
 
-                color2 = GFX_RGBConvert(ered, egreen, eblue);
-                GFX_ColorSet(color2);
-
-                switch (direction)    //Direction matter because different portions of the circle are drawn
+                switch (pState->direction)    //Direction matter because different portions of the circle are drawn
                 {
                     case GFX_FILL_STYLE_GRADIENT_LEFT:
-                        x1 = right + yCur;
-                        y1 = top - xCur;
-                        x2 = right + yNew;
-                        y2 = bottom + xCur;
+                        pState->x1 = right + pState->yCur;
+                        pState->y1 = top - pState->xCur;
+                        pState->x2 = right + pState->yNew;
+                        pState->y2 = bottom + pState->xCur;
                         break;
 
                     case GFX_FILL_STYLE_GRADIENT_RIGHT:
                     case GFX_FILL_STYLE_GRADIENT_DOUBLE_VER:
-                        x1 = left - yNew;
-                        y1 = top - xCur;
-                        x2 = left - yCur;
-                        y2 = bottom + xCur;
+                        pState->x1 = left - pState->yNew;
+                        pState->y1 = top - pState->xCur;
+                        pState->x2 = left - pState->yCur;
+                        pState->y2 = bottom + pState->xCur;
                         break;
 
                     case GFX_FILL_STYLE_GRADIENT_UP:
-                        x1 = left - xCur;
-                        y1 = bottom + yCur;
-                        x2 = right + xCur;
-                        y2 = bottom + yNew;
+                        pState->x1 = left - pState->xCur;
+                        pState->y1 = bottom + pState->yCur;
+                        pState->x2 = right + pState->xCur;
+                        pState->y2 = bottom + pState->yNew;
                         break;
 
                     case GFX_FILL_STYLE_GRADIENT_DOWN:
                     case GFX_FILL_STYLE_GRADIENT_DOUBLE_HOR:
-                        x1 = left - xCur;
-                        y1 = top - yNew;
-                        x2 = right + xCur;
-                        y2 = top - yCur;
+                        pState->x1 = left - pState->xCur;
+                        pState->y1 = top - pState->yNew;
+                        pState->x2 = right + pState->xCur;
+                        pState->y2 = top - pState->yCur;
                         break;
 
                     default:
@@ -6776,19 +10041,19 @@ GFX_STATUS GFX_BevelGradientDraw(
                         break;
                 }
                 
-                state = BEVEL_GRADIENT_Q7TOQ2;
+                pState->state = BEVEL_GRADIENT_Q7TOQ2;
                 // no break here since the next state is what we want
 
 
             case BEVEL_GRADIENT_Q7TOQ2:
 
-                if (GFX_BarDraw(x1, y1, x2, y2) != GFX_STATUS_SUCCESS)
+                if (GFX_BarDraw(pState->x1, pState->y1, pState->x2, pState->y2) != GFX_STATUS_SUCCESS)
                     return GFX_STATUS_FAILURE;
 
                 // update current values
-                xCur = xPos;
-                yCur = yPos;
-                state = BEVEL_GRADIENT_CHECK;
+                pState->xCur = pState->xPos;
+                pState->yCur = pState->yPos;
+                pState->state = BEVEL_GRADIENT_CHECK;
                 break;
 
             case BEVEL_GRADIENT_FACE_CHECK:
@@ -6796,65 +10061,54 @@ GFX_STATUS GFX_BevelGradientDraw(
                 // call the basic rectangle fill for this one.
                 if ((right - left) || (bottom - top))
                 {
-                    i = (top) - top + rad;
-                    //Calculate the starting RGB values
-                    ered   = sred   + ((rdiff * i) >> 8);
-                    egreen = sgreen + ((gdiff * i) >> 8);
-                    eblue  = sblue  + ((bdiff * i) >> 8);
-
-                    color1 = GFX_RGBConvert(ered, egreen, eblue);
+                    pState->color1 = GFX_GradientColorGet(&pState->dda, rad);
 
-                    if (doDouble == 1)
-                        color2 = GFX_GradientEndColorGet();
+                    if (pState->doDouble == 1)
+                        pState->color2 = GFX_GradientEndColorGet();
                     else    
                     {
-                        i = (bottom) - top + rad;
-                        //Calculate the ending RGB values
-                        ered   = sred   + ((rdiff * i) >> 8);
-                        egreen = sgreen + ((gdiff * i) >> 8);
-                        eblue  = sblue  + ((bdiff * i) >> 8);
-                        color2 = GFX_RGBConvert(ered, egreen, eblue);
+                        pState->color2 = GFX_GradientColorGet(&pState->dda, pState->extent + rad);
                     }
 
-                    if ( direction == GFX_FILL_STYLE_GRADIENT_UP   ||  \
-                         direction == GFX_FILL_STYLE_GRADIENT_DOWN ||  \
-                         direction == GFX_FILL_STYLE_GRADIENT_DOUBLE_HOR
+                    if ( pState->direction == GFX_FILL_STYLE_GRADIENT_UP   ||  \
+                         pState->direction == GFX_FILL_STYLE_GRADIENT_DOWN ||  \
+                         pState->direction == GFX_FILL_STYLE_GRADIENT_DOUBLE_HOR
                         )
                     {
-                        x1 = left - rad;
-                        y1 = top;
-                        x2 = right + rad;
-                        y2 = bottom;
+                        pState->x1 = left - rad;
+                        pState->y1 = top;
+                        pState->x2 = right + rad;
+                        pState->y2 = bottom;
                     }
                     else
                     {
-                        x1 = left; 
-                        y1 = top - rad;
-                        x2 = right;
-                        y2 = bottom + rad;
+                        pState->x1 = left; 
+                        pState->y1 = top - rad;
+                        pState->x2 = right;
+                        pState->y2 = bottom + rad;
                     }
-                    GFX_GradientColorSet(color1, color2);
+                    GFX_GradientColorSet(pState->color1, pState->color2);
 
-                    state = BEVEL_GRADIENT_FACE;
+                    pState->state = BEVEL_GRADIENT_FACE;
                 }
                 else
                 {
                     // this is more of a check when parameters
                     // do not define a rectangular area
-                    state = BEVEL_GRADIENT_IDLE;
+                    pState->state = BEVEL_GRADIENT_IDLE;
                     return (GFX_STATUS_SUCCESS);
                 }
                 // no break here since the next state is what we want
 
             case BEVEL_GRADIENT_FACE:
 
-                if (GFX_BarGradientDraw(x1, y1, x2, y2) != GFX_STATUS_SUCCESS)
+                if (GFX_BarGradientDraw(pState->x1, pState->y1, pState->x2, pState->y2) != GFX_STATUS_SUCCESS)
                     return GFX_STATUS_FAILURE;
 
                 // all done! return to idle
-                state = BEVEL_GRADIENT_IDLE;
+                pState->state = BEVEL_GRADIENT_IDLE;
                 // reset the original gradient colors
-                GFX_GradientColorSet(sStart, sEnd);
+                GFX_GradientColorSet(pState->sStart, pState->sEnd);
 
                 return (GFX_STATUS_SUCCESS);
                 
@@ -6873,141 +10127,274 @@ GFX_STATUS GFX_BevelGradientDraw(
 
 // *****************************************************************************
 /*  Function:
-    uint32_t GFX_RLEBlockFind(
-                                GFX_RESOURCE_HDR *pImage,
-                                uint16_t size,
-                                uint16_t height,
-                                uint16_t rleType)
+    uint8_t GFX_RLEStreamByteGet(
+                                GFX_RLE_STREAM *pStream,
+                                uint32_t address)
 
     Summary:
         This function is an internal function and should not
         be called by the application.
 
     Description:
-        This function searches for an RLE block.
+        Returns the byte at the given offset of an RLE image. Images
+        in external memory are read GFX_RLE_STREAM_BLOCK_SIZE bytes
+        at a time, so the codes of the compressed stream are read
+        from RAM. The last block of the image is shortened so the
+        external memory is not read past the compressed size.
 
 */
 // *****************************************************************************
-uint32_t GFX_RLEBlockFind(  GFX_RESOURCE_HDR *image,
-                            uint16_t size,
-                            uint16_t height,
-                            uint16_t rleType)
+static uint8_t GFX_RLEStreamByteGet(
+                                GFX_RLE_STREAM *pStream,
+                                uint32_t address)
 {
-    uint16_t sourceOffset = 0;
-    uint16_t decodeSize = 0;
-#ifndef GFX_CONFIG_IMAGE_FLASH_DISABLE
-    uint8_gfx_image_prog *flashAddress = 0;
-#endif
-    uint32_t addressOffset = 0;
-
-    if (image->resource.image.type == MCHP_BITMAP_NORMAL)
-    {
-        // this is the offset to skip the header and the palette portion
-        switch(rleType)
-        {
-            case 4:
-                addressOffset = 16 * sizeof(uint16_t);
-                break;
-            case 8:
-                addressOffset = 256 * sizeof(uint16_t);
-                break;
-            default:
-                break;
-        }
-    }
-    else
-    {
-        // if image is stripped of its palette then skip the id
-        addressOffset = sizeof(uint16_t);
-    }
-
-#ifndef GFX_CONFIG_IMAGE_FLASH_DISABLE
-    if(image->type == GFX_RESOURCE_MCHP_MBITMAP_FLASH_RLE)
-        flashAddress = (image->resource.image.location.progByteAddress + addressOffset);
+#ifndef GFX_CONFIG_IMAGE_EXTERNAL_DISABLE
+    uint32_t    length;
 #endif
 
-    while(height)
+    switch(pStream->pImage->type)
     {
-        //pRow = pixelrow;
-        decodeSize = 0;
-        while(decodeSize < size)
-        {
-            uint8_t code = 0, value = 0;
-
-            switch(image->type)
-            {
 #ifndef GFX_CONFIG_IMAGE_FLASH_DISABLE
-                case GFX_RESOURCE_MCHP_MBITMAP_FLASH_RLE:
-                    code = *flashAddress++;
-                    value = *flashAddress++;
-                    break;
+        case GFX_RESOURCE_MCHP_MBITMAP_FLASH_RLE:
+            return (pStream->pImage->resource.image.location.progByteAddress[address]);
 #endif
 #ifndef GFX_CONFIG_IMAGE_EXTERNAL_DISABLE
-                case GFX_RESOURCE_MCHP_MBITMAP_EXTERNAL_RLE:
-                    GFX_ExternalResourceCallback(image, addressOffset, sizeof(uint8_t), &code);
-                    addressOffset++;
-                    GFX_ExternalResourceCallback(image, addressOffset, sizeof(uint8_t), &value);
-                    addressOffset++;
-                    break;
-#endif
-                default:
-                    // this should not happen, in case it does it will return 0
-                    return 0;
-            } // switch (image->type)
-            sourceOffset += 2;
-
-            if(code > 0)
+        case GFX_RESOURCE_MCHP_MBITMAP_EXTERNAL_RLE:
+            if ((address < pStream->blockAddress) ||
+                (address >= (pStream->blockAddress + pStream->blockLength)))
             {
-                decodeSize += code;
+                // the last block stops at the end of the image
+                length = GFX_RLE_STREAM_BLOCK_SIZE;
+                if ((address < pStream->pImage->resource.image.parameter1.compressedSize) &&
+                    ((pStream->pImage->resource.image.parameter1.compressedSize - address) < length))
+                    length = pStream->pImage->resource.image.parameter1.compressedSize - address;
+
+                GFX_ExternalResourceRead(
+                        pStream->pImage,
+                        address,
+                        length,
+                        pStream->block);
+                pStream->blockAddress = address;
+                pStream->blockLength = length;
             }
-            else
-            {
-                decodeSize += value;
-                if (rleType == 4)
-                {
-                    sourceOffset += ((value + 1) >> 1);
-                    switch (image->type)
-                    {
-#ifndef GFX_CONFIG_IMAGE_FLASH_DISABLE
-                        case GFX_RESOURCE_MCHP_MBITMAP_FLASH_RLE:
-                            flashAddress += (value >> 1);
-                            break;
+            return (pStream->block[address - pStream->blockAddress]);
 #endif
-#ifndef GFX_CONFIG_IMAGE_EXTERNAL_DISABLE
-                        case GFX_RESOURCE_MCHP_MBITMAP_EXTERNAL_RLE:
-                            addressOffset += (value >> 1);
-                            break;
+        default:
+            return (0);
+    }
+}
+
+// *****************************************************************************
+/*  Function:
+    uint32_t GFX_RLERowSkip(
+                                GFX_RLE_STREAM *pStream,
+                                uint32_t address,
+                                uint16_t size,
+                                uint16_t rleType)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Returns the number of compressed bytes of the row of size
+        pixels that starts at the given image offset. The codes are
+        walked the same way as the RLE decode functions walk them,
+        so the next row starts where the decode functions start it.
+
+*/
+// *****************************************************************************
+static uint32_t GFX_RLERowSkip(
+                                GFX_RLE_STREAM *pStream,
+                                uint32_t address,
+                                uint16_t size,
+                                uint16_t rleType)
+{
+    uint32_t    rowLength = 0;
+    uint16_t    decodeSize = 0;
+    uint8_t     code, value;
+
+    while(decodeSize < size)
+    {
+        code  = GFX_RLEStreamByteGet(pStream, address++);
+        value = GFX_RLEStreamByteGet(pStream, address++);
+        rowLength += 2;
+
+        if(code > 0)
+        {
+            decodeSize += code;
+        }
+        else
+        {
+            decodeSize += value;
+            if (rleType == 4)
+            {
+                rowLength += ((value + 1) >> 1);
+                address += (value >> 1);
+            }
+            else
+            {
+                rowLength += value;
+                address += value;
+            }
+        }
+    }
+
+    return (rowLength);
+}
+
+#ifdef GFX_CONFIG_RLE_ROW_INDEX_SIZE
+// *****************************************************************************
+/*  Function:
+    void GFX_ImageRLERowIndexClear(void)
+
+    Summary:
+        Removes all the RLE row indexes.
+
+    Description:
+        Removes all the RLE row indexes. The indexes are kept by
+        image pointer. The application must call this function
+        when the contents of an RLE image that was already rendered
+        is changed.
+
+*/
+// *****************************************************************************
+void GFX_ImageRLERowIndexClear(void)
+{
+    uint16_t    i;
+
+    for(i = 0; i < GFX_CONFIG_RLE_ROW_INDEX_SIZE; i++)
+        gfxRLERowIndex[i].pImage = NULL;
+    gfxRLERowIndexNext = 0;
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_RLE_ROW_INDEX *GFX_RLERowIndexGet(GFX_RESOURCE_HDR *pImage)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Returns the row index of the image. When the image has no
+        index, the next index is assigned to the image. The index is
+        filled while the rows are skipped by GFX_RLEBlockFind().
+
+*/
+// *****************************************************************************
+static GFX_RLE_ROW_INDEX *GFX_RLERowIndexGet(GFX_RESOURCE_HDR *pImage)
+{
+    GFX_RLE_ROW_INDEX   *pIndex;
+    uint16_t            i;
+
+    for(i = 0; i < GFX_CONFIG_RLE_ROW_INDEX_SIZE; i++)
+    {
+        if (gfxRLERowIndex[i].pImage == pImage)
+            return (&gfxRLERowIndex[i]);
+    }
+
+    pIndex = &gfxRLERowIndex[gfxRLERowIndexNext];
+    if (++gfxRLERowIndexNext >= GFX_CONFIG_RLE_ROW_INDEX_SIZE)
+        gfxRLERowIndexNext = 0;
+
+    // the entries are spread over the image height
+    pIndex->pImage = pImage;
+    pIndex->step = (GFX_ImageHeightGet(pImage) + GFX_CONFIG_RLE_ROW_INDEX_ENTRIES - 1) /
+                   GFX_CONFIG_RLE_ROW_INDEX_ENTRIES;
+    if (pIndex->step == 0)
+        pIndex->step = 1;
+    pIndex->entries = 1;
+    pIndex->offset[0] = 0;
+
+    return (pIndex);
+}
 #endif
-                        default:
-                            break;
-                    } // switch (image->type)
-                }
-                else
-                {
-                    sourceOffset += value;
-                    switch (image->type)
-                    {
-#ifndef GFX_CONFIG_IMAGE_FLASH_DISABLE
-                        case GFX_RESOURCE_MCHP_MBITMAP_FLASH_RLE:
-                            flashAddress += value;
-                            break;
+
+// *****************************************************************************
+/*  Function:
+    uint32_t GFX_RLEBlockFind(
+                                GFX_RESOURCE_HDR *pImage,
+                                uint16_t size,
+                                uint16_t height,
+                                uint16_t rleType)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        This function returns the offset of the compressed row at
+        the given height, from the start of the compressed rows.
+        When GFX_CONFIG_RLE_ROW_INDEX_SIZE is defined, the rows are
+        skipped from the closest row in the index of the image and
+        the rows skipped are added to the index.
+
+*/
+// *****************************************************************************
+uint32_t GFX_RLEBlockFind(  GFX_RESOURCE_HDR *image,
+                            uint16_t size,
+                            uint16_t height,
+                            uint16_t rleType)
+{
+    GFX_RLE_STREAM  stream;
+    uint32_t        dataOffset = 0, rowOffset = 0;
+    uint16_t        row = 0;
+#ifdef GFX_CONFIG_RLE_ROW_INDEX_SIZE
+    GFX_RLE_ROW_INDEX *pIndex;
+    uint16_t        entry;
 #endif
-#ifndef GFX_CONFIG_IMAGE_EXTERNAL_DISABLE
-                        case GFX_RESOURCE_MCHP_MBITMAP_EXTERNAL_RLE:
-                            addressOffset += value;
-                            break;
+
+    if (image->resource.image.type == MCHP_BITMAP_NORMAL)
+    {
+        // this is the offset to skip the header and the palette portion
+        switch(rleType)
+        {
+            case 4:
+                dataOffset = 16 * sizeof(uint16_t);
+                break;
+            case 8:
+                dataOffset = 256 * sizeof(uint16_t);
+                break;
+            default:
+                break;
+        }
+    }
+    else
+    {
+        // if image is stripped of its palette then skip the id
+        dataOffset = sizeof(uint16_t);
+    }
+
+    stream.pImage = image;
+    stream.blockAddress = 0;
+    stream.blockLength = 0;
+
+#ifdef GFX_CONFIG_RLE_ROW_INDEX_SIZE
+    // start from the closest known row
+    pIndex = GFX_RLERowIndexGet(image);
+    entry = height / pIndex->step;
+    if (entry >= pIndex->entries)
+        entry = pIndex->entries - 1;
+    row = entry * pIndex->step;
+    rowOffset = pIndex->offset[entry];
 #endif
-                        default:
-                            break;
-                    } // switch (image->type)
-                }
-            }
-        } // while(decodeSize < size)
-        height--;
 
-    } // while(height)
+    while(row < height)
+    {
+        rowOffset += GFX_RLERowSkip(&stream, dataOffset + rowOffset, size, rleType);
+        row++;
 
-    return (sourceOffset);
+#ifdef GFX_CONFIG_RLE_ROW_INDEX_SIZE
+        if ((row == (pIndex->entries * pIndex->step)) &&
+            (pIndex->entries < GFX_CONFIG_RLE_ROW_INDEX_ENTRIES))
+        {
+            pIndex->offset[pIndex->entries++] = rowOffset;
+        }
+#endif
+    }
+
+    return (rowOffset);
 
 }
 
@@ -7136,7 +10523,7 @@ void GFX_ImageRLE8BPPDraw(
                     // when system palette is used, the image palette is assumed to be
                     // the same as the system palette so we do not fetch it
 #if (GFX_CONFIG_COLOR_DEPTH == 16) || (GFX_CONFIG_COLOR_DEPTH == 24)
-                    GFX_ExternalResourceCallback(pImage, 0, 256 * sizeof(GFX_COLOR), imagePalette);
+                    GFX_ExternalResourceRead(pImage, 0, 256 * sizeof(GFX_COLOR), imagePalette);
                     memOffset = 256 * sizeof (GFX_COLOR);
 #endif
                 }
@@ -7166,15 +10553,13 @@ void GFX_ImageRLE8BPPDraw(
 #ifndef GFX_CONFIG_IMAGE_FLASH_DISABLE
             case GFX_RESOURCE_MCHP_MBITMAP_FLASH_RLE:
                 // adjust the address to the correct starting line
-                addressOffset = GFX_RLEBlockFind(pImage, sizeX, pPartialImageData->yoffset, 8);
-                flashAddress += addressOffset;
+                flashAddress += GFX_RLEBlockFind(pImage, sizeX, pPartialImageData->yoffset, 8);
                 break;
 #endif //#ifndef GFX_CONFIG_IMAGE_FLASH_DISABLE
 
 #ifndef GFX_CONFIG_IMAGE_EXTERNAL_DISABLE
             case GFX_RESOURCE_MCHP_MBITMAP_EXTERNAL_RLE:
-                addressOffset = (GFX_RLEBlockFind(pImage, sizeX, pPartialImageData->yoffset, 8));
-                memOffset += addressOffset;
+                memOffset += GFX_RLEBlockFind(pImage, sizeX, pPartialImageData->yoffset, 8);
                 break;
 #endif // #ifndef GFX_CONFIG_IMAGE_EXTERNAL_DISABLE
             default:
@@ -7234,7 +10619,8 @@ void GFX_ImageRLE8BPPDraw(
         }
 
         // render the current line
-        GFX_PixelArrayPut(left, top + y, gfxLineBuffer0, sizeX);
+        if (GFX_ImageLineRender(left, top + y, sizeX) == 0)
+            return;
 
         y++;
 
@@ -7374,7 +10760,7 @@ void GFX_ImageRLE4BPPDraw(
                     // Get image palette, since this will be used to render the pixels
                     // when system palette is used, the image palette is assumed to be
                     // the same as the system palette so we do not fetch it
-                    GFX_ExternalResourceCallback(pImage, 0, 16 * sizeof (GFX_COLOR), imagePalette);
+                    GFX_ExternalResourceRead(pImage, 0, 16 * sizeof (GFX_COLOR), imagePalette);
                     memOffset = 16 * sizeof (GFX_COLOR);
 #endif
                 }
@@ -7403,15 +10789,13 @@ void GFX_ImageRLE4BPPDraw(
 #ifndef GFX_CONFIG_IMAGE_FLASH_DISABLE
             case GFX_RESOURCE_MCHP_MBITMAP_FLASH_RLE:
                 // adjust the address to the correct starting line
-                addressOffset = GFX_RLEBlockFind(pImage, bitmapHdr.width, pPartialImageData->yoffset, 4);
-                flashAddress += addressOffset;
+                flashAddress += GFX_RLEBlockFind(pImage, bitmapHdr.width, pPartialImageData->yoffset, 4);
                 break;
 #endif //#ifndef GFX_CONFIG_IMAGE_FLASH_DISABLE
 
 #ifndef GFX_CONFIG_IMAGE_EXTERNAL_DISABLE
             case GFX_RESOURCE_MCHP_MBITMAP_EXTERNAL_RLE:
-                addressOffset = (GFX_RLEBlockFind(pImage, bitmapHdr.width, pPartialImageData->yoffset, 4));
-                memOffset += addressOffset;
+                memOffset += GFX_RLEBlockFind(pImage, bitmapHdr.width, pPartialImageData->yoffset, 4);
                 break;
 #endif // #ifndef GFX_CONFIG_IMAGE_EXTERNAL_DISABLE
 
@@ -7523,7 +10907,8 @@ void GFX_ImageRLE4BPPDraw(
         
 #endif
         // render the current line
-        GFX_PixelArrayPut(left, top + y, gfxLineBuffer0, sizeX);
+        if (GFX_ImageLineRender(left, top + y, sizeX) == 0)
+            return;
         y++;
 
     }
@@ -7728,7 +11113,7 @@ uint16_t GFX_ImageFlashExternal8BPPDecode(
 
     while(decodeSize < size)
     {
-        GFX_ExternalResourceCallback(image, memAddress, sizeof(uint8_t) * 2, &codePair);
+        GFX_ExternalResourceRead(image, memAddress, sizeof(uint8_t) * 2, &codePair);
         memAddress += 2;
         sourceOffset += 2;
         
@@ -7757,7 +11142,7 @@ uint16_t GFX_ImageFlashExternal8BPPDecode(
                 codePair.value -= (decodeSize - size);
             }
             
-            GFX_ExternalResourceCallback(image, memAddress, codePair.value * sizeof(uint8_t), pixel_row);
+            GFX_ExternalResourceRead(image, memAddress, codePair.value * sizeof(uint8_t), pixel_row);
             pixel_row += codePair.value;
             memAddress += codePair.value;
         }
@@ -7808,7 +11193,7 @@ uint16_t GFX_ImageFlashExternal4BPPDecode(
     {
         uint8_t ctr, temp = 0, nibbleCount;
 
-        GFX_ExternalResourceCallback(image, memAddress, sizeof(uint8_t) * 2, &codePair);
+        GFX_ExternalResourceRead(image, memAddress, sizeof(uint8_t) * 2, &codePair);
         memAddress += 2;
         sourceOffset += 2;
         
@@ -7850,7 +11235,7 @@ uint16_t GFX_ImageFlashExternal4BPPDecode(
             nibbleCount = (codePair.value >> 1) + (codePair.value & 0x01);
 
             // get the data
-            GFX_ExternalResourceCallback(image, memAddress, sizeof(uint8_t) * nibbleCount, pRawSource);
+            GFX_ExternalResourceRead(image, memAddress, sizeof(uint8_t) * nibbleCount, pRawSource);
             // adjust the address correctly, if nibbleCount is odd, then the memAddress
             // should update to the location of the last nibble since the next nibble
             // still needs to be processed.
@@ -7888,105 +11273,2244 @@ uint16_t GFX_ImageFlashExternal4BPPDecode(
     
 #endif //#ifndef GFX_CONFIG_RLE_DECODE_DISABLE
 
-#ifndef GFX_CONFIG_DOUBLE_BUFFERING_DISABLE
+#ifdef GFX_IMAGE_INFLATE
+
+// base and number of extra bits of the length symbols 257 to 285
+static const uint16_t gfxInflateLengthBase[29] =
+{
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const uint8_t gfxInflateLengthExtra[29] =
+{
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+// base and number of extra bits of the distance symbols 0 to 29
+static const uint16_t gfxInflateDistanceBase[30] =
+{
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+    8193, 12289, 16385, 24577
+};
+static const uint8_t gfxInflateDistanceExtra[30] =
+{
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+// order of the code lengths of the code length codes of a dynamic block
+static const uint8_t gfxInflateCodeLengthOrder[19] =
+{
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
 
 // *****************************************************************************
 /*  Function:
-    void GFX_DRV_DoubleBufferDisable(void)
+    uint8_t GFX_InflateByteGet(GFX_INFLATE_STREAM *pStream)
 
     Summary:
-        This function is the driver specific double buffering disabling
-        steps to initialize buffers to a state where double buffering
-        is disabled.
+        This function is an internal function and should not
+        be called by the application.
 
     Description:
-        This function is the driver specific double buffering disabling
-        steps to initialize buffers to a state where double buffering
-        is disabled.
+        Returns the next byte of the compressed data of an IPU or
+        PNG image. IPU images in external memory are read
+        GFX_INFLATE_STREAM_BLOCK_SIZE bytes at a time. A valid stream
+        never reads past the compressed size of the image, the stream
+        is set in error when it does.
 
 */
 // *****************************************************************************
-void __attribute__((weak)) GFX_DRV_DoubleBufferDisable(void)
-{ }
+static uint8_t GFX_InflateByteGet(GFX_INFLATE_STREAM *pStream)
+{
+    GFX_RESOURCE_HDR    *pImage = pStream->pImage;
+    uint32_t            address = pStream->address;
+#if defined (GFX_IMAGE_IPU_SOFTWARE_DECODE) && !defined (GFX_CONFIG_IMAGE_EXTERNAL_DISABLE)
+    uint32_t            length;
+#endif
+
+#ifdef GFX_CONFIG_PNG_DECODE_ROW_SIZE
+    // the data of PNG images is split in chunks in the file
+    if (pImage->type == GFX_RESOURCE_PNG_FILE_NONE)
+        return (GFX_PngDataByteGet(pStream));
+#endif
+
+    if (address >= pImage->resource.image.parameter1.compressedSize)
+    {
+        pStream->state = GFX_INFLATE_ERROR;
+        return (0);
+    }
+    pStream->address++;
+
+    switch(pImage->type)
+    {
+#ifdef GFX_IMAGE_IPU_SOFTWARE_DECODE
+#ifndef GFX_CONFIG_IMAGE_FLASH_DISABLE
+        case GFX_RESOURCE_MCHP_MBITMAP_FLASH_IPU:
+            return (pImage->resource.image.location.progByteAddress[address]);
+#endif
+#ifndef GFX_CONFIG_IMAGE_EXTERNAL_DISABLE
+        case GFX_RESOURCE_MCHP_MBITMAP_EXTERNAL_IPU:
+            if (address >= (pStream->blockAddress + pStream->blockLength))
+            {
+                length = pImage->resource.image.parameter1.compressedSize - address;
+                if (length > GFX_INFLATE_STREAM_BLOCK_SIZE)
+                    length = GFX_INFLATE_STREAM_BLOCK_SIZE;
+
+                GFX_ExternalResourceRead(
+                        pImage,
+                        address,
+                        length,
+                        pStream->block);
+                pStream->blockAddress = address;
+                pStream->blockLength = length;
+            }
+            return (pStream->block[address - pStream->blockAddress]);
+#endif
+#endif // #ifdef GFX_IMAGE_IPU_SOFTWARE_DECODE
+        default:
+            pStream->state = GFX_INFLATE_ERROR;
+            return (0);
+    }
+}
 
 // *****************************************************************************
 /*  Function:
-    GFX_STATUS GFX_DrawBufferInitialize(
-                                int index,
-                                uint32_t address)
+    uint16_t GFX_InflateBitsGet(
+                                GFX_INFLATE_STREAM *pStream,
+                                uint16_t count)
 
     Summary:
-        This function initializes the address of the draw buffer
-        specified by the given index.
+        This function is an internal function and should not
+        be called by the application.
 
     Description:
-        For system with multiple buffers, this function is used to
-        initialize the array of buffers. The address of the draw buffer
-        will be associated with the specified index. Use this function
-        to initialize or modify the array of frame buffers in the system
-        at run time.
-        For systems with single buffer this function will have no effect.
-        The size of the buffer is defined by the dimension of the screen
-        and the color depth used.
+        Returns the next count (up to 16) bits of the compressed data,
+        the first bit in bit 0.
 
 */
 // *****************************************************************************
-GFX_STATUS __attribute__((weak)) GFX_DrawBufferInitialize(
-                                uint16_t index,
-                                uint32_t address)
+static uint16_t GFX_InflateBitsGet(
+                                GFX_INFLATE_STREAM *pStream,
+                                uint16_t count)
 {
-    return (GFX_STATUS_SUCCESS);
+    uint16_t    bits;
+
+    while (pStream->bitCount < count)
+    {
+        pStream->bitBuffer |= (uint32_t)GFX_InflateByteGet(pStream) << pStream->bitCount;
+        pStream->bitCount += 8;
+    }
+
+    bits = pStream->bitBuffer & ((1UL << count) - 1);
+    pStream->bitBuffer >>= count;
+    pStream->bitCount -= count;
+    return (bits);
 }
 
 // *****************************************************************************
 /*  Function:
-    GFX_STATUS GFX_DrawBufferSet(uint16_t index)
+    int16_t GFX_InflateSymbolGet(
+                                GFX_INFLATE_STREAM *pStream,
+                                const uint16_t *pCount,
+                                const uint16_t *pSymbol)
 
     Summary:
-        This function sets the draw buffer with the given index number.
+        This function is an internal function and should not
+        be called by the application.
 
     Description:
-        This function sets the draw buffer with the given index number.
-        For systems with single buffer, frame buffer and draw buffer are
-        the same buffer. Calls to this function will have no effect and
-        will always return GFX_STATUS_SUCCESS.
+        Decodes the next symbol of the compressed data with the given
+        canonical Huffman code. The code is read one bit at a time
+        and compared with the first code of each length, so the
+        tables only hold the number of codes of each length and the
+        symbols sorted by code. Returns -1 for an unused code.
 
 */
 // *****************************************************************************
-GFX_STATUS __attribute__((weak)) GFX_DrawBufferSet(uint16_t index)
+static int16_t GFX_InflateSymbolGet(
+                                GFX_INFLATE_STREAM *pStream,
+                                const uint16_t *pCount,
+                                const uint16_t *pSymbol)
 {
-    return (GFX_STATUS_SUCCESS);
+    uint16_t    code = 0, first = 0, index = 0, length;
+
+    for (length = 1; length < 16; length++)
+    {
+        if (pStream->bitCount == 0)
+        {
+            pStream->bitBuffer = GFX_InflateByteGet(pStream);
+            pStream->bitCount = 8;
+        }
+        code |= pStream->bitBuffer & 0x01;
+        pStream->bitBuffer >>= 1;
+        pStream->bitCount--;
+
+        // the codes of this length are first to first + count - 1
+        if (code < first + pCount[length])
+            return (pSymbol[index + code - first]);
+
+        index += pCount[length];
+        first  = (first + pCount[length]) << 1;
+        code <<= 1;
+    }
+
+    return (-1);
 }
 
 // *****************************************************************************
 /*  Function:
-    uint16_t GFX_DrawBufferGet(void)
+    GFX_STATUS GFX_InflateTableBuild(
+                                uint16_t *pCount,
+                                uint16_t *pSymbol,
+                                const uint8_t *pLength,
+                                uint16_t symbols)
 
     Summary:
-        This function returns the index of the current draw buffer.
+        This function is an internal function and should not
+        be called by the application.
 
     Description:
-        This function returns the index of the current draw buffer.
-        Draw buffer is the buffer where rendering is performed.
-        For systems with single buffer this function will always
-        return 0.
+        Builds the tables of a canonical Huffman code from the code
+        length of each symbol. Returns GFX_STATUS_FAILURE when the
+        lengths describe more codes than the code space holds.
 
 */
 // *****************************************************************************
-uint16_t __attribute__((weak)) GFX_DrawBufferGet(void)
+static GFX_STATUS GFX_InflateTableBuild(
+                                uint16_t *pCount,
+                                uint16_t *pSymbol,
+                                const uint8_t *pLength,
+                                uint16_t symbols)
 {
-    return (0);
+    uint16_t    offset[16], length, symbol;
+    int32_t     left = 1;
+
+    for (length = 0; length < 16; length++)
+        pCount[length] = 0;
+    for (symbol = 0; symbol < symbols; symbol++)
+        pCount[pLength[symbol]]++;
+
+    // codes left of each length, incomplete codes decode to -1
+    for (length = 1; length < 16; length++)
+    {
+        left = (left << 1) - pCount[length];
+        if (left < 0)
+            return (GFX_STATUS_FAILURE);
+    }
+
+    offset[1] = 0;
+    for (length = 1; length < 15; length++)
+        offset[length + 1] = offset[length] + pCount[length];
+
+    for (symbol = 0; symbol < symbols; symbol++)
+    {
+        if (pLength[symbol] != 0)
+            pSymbol[offset[pLength[symbol]]++] = symbol;
+    }
+    return (GFX_STATUS_SUCCESS);
 }
 
 // *****************************************************************************
 /*  Function:
-    GFX_STATUS GFX_FrameBufferSet(uint16_t index)
+    void GFX_InflateBlockHeaderRead(GFX_INFLATE_STREAM *pStream)
 
     Summary:
-        This function sets the frame buffer with the given index number.
+        This function is an internal function and should not
+        be called by the application.
 
     Description:
-        This function sets the frame buffer with the given index number.
+        Reads the header of the next block of the compressed data.
+        The length of a stored block is read, the Huffman codes of
+        a block with fixed or dynamic codes are built. The stream
+        is done after the last block.
+
+*/
+// *****************************************************************************
+static void GFX_InflateBlockHeaderRead(GFX_INFLATE_STREAM *pStream)
+{
+    uint8_t     length[288 + 32];
+    uint16_t    lengthCodes, distanceCodes, codeLengthCodes, i, repeat, value;
+    int16_t     symbol;
+
+    if (pStream->lastBlock)
+    {
+        pStream->state = GFX_INFLATE_DONE;
+        return;
+    }
+
+    pStream->lastBlock = GFX_InflateBitsGet(pStream, 1);
+
+    switch (GFX_InflateBitsGet(pStream, 2))
+    {
+        case 0:
+            // stored block, the length starts on the next byte
+            pStream->bitBuffer >>= (pStream->bitCount & 0x07);
+            pStream->bitCount -= (pStream->bitCount & 0x07);
+
+            pStream->storedLength = GFX_InflateBitsGet(pStream, 16);
+            if (GFX_InflateBitsGet(pStream, 16) != (pStream->storedLength ^ 0xFFFF))
+            {
+                pStream->state = GFX_INFLATE_ERROR;
+                return;
+            }
+            if (pStream->state != GFX_INFLATE_ERROR)
+                pStream->state = GFX_INFLATE_BLOCK_STORED;
+            return;
+
+        case 1:
+            // fixed codes
+            for (i = 0; i < 144; i++)
+                length[i] = 8;
+            for (; i < 256; i++)
+                length[i] = 9;
+            for (; i < 280; i++)
+                length[i] = 7;
+            for (; i < 288; i++)
+                length[i] = 8;
+            for (i = 0; i < 30; i++)
+                length[288 + i] = 5;
+
+            lengthCodes = 288;
+            distanceCodes = 30;
+            break;
+
+        case 2:
+            // dynamic codes, the code lengths are compressed with
+            // the code length codes
+            lengthCodes     = GFX_InflateBitsGet(pStream, 5) + 257;
+            distanceCodes   = GFX_InflateBitsGet(pStream, 5) + 1;
+            codeLengthCodes = GFX_InflateBitsGet(pStream, 4) + 4;
+            if ((lengthCodes > 286) || (distanceCodes > 30))
+            {
+                pStream->state = GFX_INFLATE_ERROR;
+                return;
+            }
+
+            for (i = 0; i < 19; i++)
+            {
+                if (i < codeLengthCodes)
+                    length[gfxInflateCodeLengthOrder[i]] = GFX_InflateBitsGet(pStream, 3);
+                else
+                    length[gfxInflateCodeLengthOrder[i]] = 0;
+            }
+
+            // the distance tables hold the code length codes for now
+            if (GFX_InflateTableBuild(
+                    pStream->distanceCount,
+                    pStream->distanceSymbol,
+                    length,
+                    19) == GFX_STATUS_FAILURE)
+            {
+                pStream->state = GFX_INFLATE_ERROR;
+                return;
+            }
+
+            for (i = 0; i < lengthCodes + distanceCodes; )
+            {
+                symbol = GFX_InflateSymbolGet(
+                                pStream,
+                                pStream->distanceCount,
+                                pStream->distanceSymbol);
+
+                if ((symbol >= 0) && (symbol < 16))
+                {
+                    length[i++] = symbol;
+                    continue;
+                }
+
+                value = 0;
+                if ((symbol == 16) && (i > 0))
+                {
+                    // repeat the previous length
+                    value = length[i - 1];
+                    repeat = 3 + GFX_InflateBitsGet(pStream, 2);
+                }
+                else if (symbol == 17)
+                {
+                    repeat = 3 + GFX_InflateBitsGet(pStream, 3);
+                }
+                else if (symbol == 18)
+                {
+                    repeat = 11 + GFX_InflateBitsGet(pStream, 7);
+                }
+                else
+                {
+                    pStream->state = GFX_INFLATE_ERROR;
+                    return;
+                }
+
+                if (i + repeat > lengthCodes + distanceCodes)
+                {
+                    pStream->state = GFX_INFLATE_ERROR;
+                    return;
+                }
+                while (repeat--)
+                    length[i++] = value;
+            }
+
+            // a block without end code cannot be decoded
+            if (length[256] == 0)
+            {
+                pStream->state = GFX_INFLATE_ERROR;
+                return;
+            }
+            break;
+
+        default:
+            pStream->state = GFX_INFLATE_ERROR;
+            return;
+    }
+
+    if ((GFX_InflateTableBuild(
+            pStream->lengthCount,
+            pStream->lengthSymbol,
+            length,
+            lengthCodes) == GFX_STATUS_FAILURE) ||
+        (GFX_InflateTableBuild(
+            pStream->distanceCount,
+            pStream->distanceSymbol,
+            &length[lengthCodes],
+            distanceCodes) == GFX_STATUS_FAILURE))
+    {
+        pStream->state = GFX_INFLATE_ERROR;
+        return;
+    }
+
+    if (pStream->state != GFX_INFLATE_ERROR)
+        pStream->state = GFX_INFLATE_BLOCK_HUFFMAN;
+}
+
+// *****************************************************************************
+/*  Function:
+    void GFX_InflateStart(
+                                GFX_INFLATE_STREAM *pStream,
+                                GFX_RESOURCE_HDR *pImage)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Starts the decoding of the DEFLATE data of an image.
+
+*/
+// *****************************************************************************
+static void GFX_InflateStart(
+                                GFX_INFLATE_STREAM *pStream,
+                                GFX_RESOURCE_HDR *pImage)
+{
+    pStream->pImage = pImage;
+    pStream->address = 0;
+    pStream->blockAddress = 0;
+    pStream->blockLength = 0;
+    pStream->bitBuffer = 0;
+    pStream->bitCount = 0;
+    pStream->state = GFX_INFLATE_BLOCK_HEADER;
+    pStream->lastBlock = 0;
+    pStream->copyLength = 0;
+    pStream->total = 0;
+}
+
+// *****************************************************************************
+/*  Function:
+    uint16_t GFX_InflateRead(
+                                GFX_INFLATE_STREAM *pStream,
+                                uint8_t *pBuffer,
+                                uint16_t count)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Decodes the next count bytes of an IPU or PNG image into pBuffer,
+        the bytes are dropped when pBuffer is NULL. The decoded bytes
+        are kept in the window of the stream for the matches of the
+        following bytes. Returns the number of decoded bytes, this is
+        less than count at the end of the data or when the data
+        cannot be decoded, for example when a match is farther than
+        GFX_CONFIG_IPU_DECODE_WINDOW_SIZE bytes.
+
+*/
+// *****************************************************************************
+static uint16_t GFX_InflateRead(
+                                GFX_INFLATE_STREAM *pStream,
+                                uint8_t *pBuffer,
+                                uint16_t count)
+{
+    uint16_t    done = 0;
+    int16_t     symbol;
+    uint8_t     value;
+
+    while ((done < count) && (pStream->state < GFX_INFLATE_DONE))
+    {
+        if (pStream->copyLength != 0)
+        {
+            // copy of the bytes of a match
+            value = pStream->window[(pStream->total - pStream->copyDistance) & (GFX_CONFIG_IPU_DECODE_WINDOW_SIZE - 1)];
+            pStream->copyLength--;
+        }
+        else
+        {
+            switch (pStream->state)
+            {
+                case GFX_INFLATE_BLOCK_HEADER:
+                    GFX_InflateBlockHeaderRead(pStream);
+                    continue;
+
+                case GFX_INFLATE_BLOCK_STORED:
+                    if (pStream->storedLength == 0)
+                    {
+                        pStream->state = GFX_INFLATE_BLOCK_HEADER;
+                        continue;
+                    }
+                    value = GFX_InflateBitsGet(pStream, 8);
+                    pStream->storedLength--;
+                    break;
+
+                default:
+                    symbol = GFX_InflateSymbolGet(
+                                    pStream,
+                                    pStream->lengthCount,
+                                    pStream->lengthSymbol);
+
+                    if ((symbol >= 0) && (symbol < 256))
+                    {
+                        value = symbol;
+                        break;
+                    }
+                    if (symbol == 256)
+                    {
+                        pStream->state = GFX_INFLATE_BLOCK_HEADER;
+                        continue;
+                    }
+
+                    symbol -= 257;
+                    if ((symbol < 0) || (symbol >= 29))
+                    {
+                        pStream->state = GFX_INFLATE_ERROR;
+                        continue;
+                    }
+                    pStream->copyLength = gfxInflateLengthBase[symbol] +
+                            GFX_InflateBitsGet(pStream, gfxInflateLengthExtra[symbol]);
+
+                    symbol = GFX_InflateSymbolGet(
+                                    pStream,
+                                    pStream->distanceCount,
+                                    pStream->distanceSymbol);
+                    if ((symbol < 0) || (symbol >= 30))
+                    {
+                        pStream->state = GFX_INFLATE_ERROR;
+                        continue;
+                    }
+                    pStream->copyDistance = gfxInflateDistanceBase[symbol] +
+                            GFX_InflateBitsGet(pStream, gfxInflateDistanceExtra[symbol]);
+
+                    // only the bytes of the window can be copied
+                    if ((pStream->copyDistance > pStream->total) ||
+                        (pStream->copyDistance > GFX_CONFIG_IPU_DECODE_WINDOW_SIZE))
+                    {
+                        pStream->state = GFX_INFLATE_ERROR;
+                    }
+                    continue;
+            }
+
+            // the byte is not valid when the data ended before it
+            if (pStream->state == GFX_INFLATE_ERROR)
+                break;
+        }
+
+        pStream->window[pStream->total & (GFX_CONFIG_IPU_DECODE_WINDOW_SIZE - 1)] = value;
+        pStream->total++;
+
+        if (pBuffer != NULL)
+            pBuffer[done] = value;
+        done++;
+    }
+
+    return (done);
+}
+
+#endif // #ifdef GFX_IMAGE_INFLATE
+
+#ifdef GFX_IMAGE_IPU_SOFTWARE_DECODE
+// *****************************************************************************
+/*  Function:
+    void GFX_ImageInflateDraw(
+                                uint16_t left,
+                                uint16_t top,
+                                GFX_RESOURCE_HDR *pImage,
+                                GFX_PARTIAL_IMAGE_PARAM *pPartialImageData)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Renders an IPU image in internal flash or external memory
+        without the inflate unit of the display controller. The
+        DEFLATE data holds the image in the uncompressed format, it
+        is decoded GFX_INFLATE_ROW_CHUNK_SIZE bytes at a time and
+        each row is rendered when it is complete. The rows above a
+        portion of the image are decoded and dropped, the rows below
+        it are not decoded.
+
+*/
+// *****************************************************************************
+static void GFX_ImageInflateDraw(
+                                uint16_t left,
+                                uint16_t top,
+                                GFX_RESOURCE_HDR *pImage,
+                                GFX_PARTIAL_IMAGE_PARAM *pPartialImageData)
+{
+    GFX_INFLATE_STREAM      *pStream = &gfxInflateStream;
+    GFX_MCHP_BITMAP_HEADER  bitmapHdr;
+    uint8_t                 data[GFX_INFLATE_ROW_CHUNK_SIZE];
+    uint8_t                 bpp, mask, temp;
+    uint16_t                rowLength, length, offset, i, j;
+    uint16_t                sizeX, sizeY, xOffset = 0, yOffset = 0, x, y, column;
+    GFX_COLOR               useColor;
+#ifdef GFX_CONFIG_PALETTE_DISABLE
+    uint16_t                *pPalette = NULL;
+#endif
+
+    GFX_ImageHeaderGet(pImage, (GFX_MCHP_BITMAP_HEADER *)&bitmapHdr);
+    bpp = bitmapHdr.colorDepth;
+
+    // the color depths rendered for the uncompressed images
+    if ((bpp > GFX_CONFIG_COLOR_DEPTH) || ((bpp == 16) && (GFX_CONFIG_COLOR_DEPTH != 16)))
+        return;
+    mask = (1 << bpp) - 1;
+
+    GFX_InflateStart(pStream, pImage);
+
+    if (bpp < 16)
+    {
+        if (pImage->resource.image.type == MCHP_BITMAP_NORMAL)
+        {
+            length = (1 << bpp) * sizeof(uint16_t);
+#ifdef GFX_CONFIG_PALETTE_DISABLE
+            // the palette is decoded into the palette cache
+            GFX_ImagePaletteCacheClear();
+            pPalette = gfxImagePalette;
+            if (GFX_InflateRead(pStream, (uint8_t *)pPalette, length) != length)
+                return;
+#else
+            // the system palette is used, skip the palette of the image
+            if (GFX_InflateRead(pStream, NULL, length) != length)
+                return;
+#endif
+        }
+        else
+        {
+            // palette is stripped so skip the id
+            if (GFX_InflateRead(pStream, NULL, sizeof(uint16_t)) != sizeof(uint16_t))
+                return;
+        }
+    }
+
+    // rows are padded to a byte
+    rowLength = (((uint32_t)bitmapHdr.width * bpp) + 7) >> 3;
+
+    sizeX = bitmapHdr.width;
+    sizeY = bitmapHdr.height;
+
+    if (pPartialImageData->width != 0)
+    {
+        xOffset = pPartialImageData->xoffset;
+        yOffset = pPartialImageData->yoffset;
+        sizeX = pPartialImageData->width;
+        sizeY = pPartialImageData->height;
+    }
+
+    for (y = 0; y < yOffset; y++)
+    {
+        if (GFX_InflateRead(pStream, NULL, rowLength) != rowLength)
+            return;
+    }
+
+    for (y = 0; y < sizeY; y++)
+    {
+        x = 0;
+
+        for (offset = 0; offset < rowLength; offset += length)
+        {
+            length = rowLength - offset;
+            if (length > GFX_INFLATE_ROW_CHUNK_SIZE)
+                length = GFX_INFLATE_ROW_CHUNK_SIZE;
+
+            if (GFX_InflateRead(pStream, data, length) != length)
+                return;
+
+            for (i = 0; i < length; i++)
+            {
+                temp = data[i];
+
+                // the first pixel of a byte is in the lowest bits
+                for (j = 0; j < 8; j += bpp, x++)
+                {
+                    if (bpp == 16)
+                    {
+                        useColor = temp | ((uint16_t)data[++i] << 8);
+                    }
+                    else
+                    {
+#ifndef GFX_CONFIG_PALETTE_DISABLE
+                        useColor = temp & mask;
+#else
+                        useColor = (pPalette != NULL) ? pPalette[temp & mask] : (temp & mask);
+#endif
+                        temp >>= bpp;
+                    }
+
+                    // only the pixels of the portion are rendered
+                    column = x - xOffset;
+                    if (column < sizeX)
+                    {
+#ifdef GFX_CONFIG_PIXEL_ARRAY_NO_SWAP_DISABLE
+                        gfxLineBuffer0[sizeX - 1 - column] = useColor;
+#else
+                        gfxLineBuffer0[column] = useColor;
+#endif
+                    }
+                }
+            }
+        }
+
+        // render the current line
+        if (GFX_ImageLineRender(left, top + y, sizeX) == 0)
+            return;
+    }
+}
+
+#endif // #ifdef GFX_IMAGE_IPU_SOFTWARE_DECODE
+
+#if defined (GFX_CONFIG_JPEG_DECODE_ENABLE) || defined (GFX_CONFIG_PNG_DECODE_ROW_SIZE)
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_ImageFileStart(
+                                GFX_IMAGE_FILE_STREAM *pStream,
+                                GFX_RESOURCE_HDR *pImage)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Moves the file of a JPEG or PNG image to the start of the
+        image. Returns GFX_STATUS_FAILURE when the file cannot be read.
+
+*/
+// *****************************************************************************
+static GFX_STATUS GFX_ImageFileStart(
+                                GFX_IMAGE_FILE_STREAM *pStream,
+                                GFX_RESOURCE_HDR *pImage)
+{
+    pStream->pFile = pImage->resource.image.location.pFile;
+    pStream->position = 0;
+    pStream->length = 0;
+    pStream->error = 0;
+
+    if (FILEIO_Seek(
+            pStream->pFile,
+            pImage->resource.image.parameter1.fileOffset,
+            FILEIO_SEEK_SET) != FILEIO_RESULT_SUCCESS)
+        return (GFX_STATUS_FAILURE);
+
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    uint8_t GFX_ImageFileByteGet(GFX_IMAGE_FILE_STREAM *pStream)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Returns the next byte of an image file. The file is read
+        GFX_IMAGE_FILE_BUFFER_SIZE bytes at a time. At the end of the
+        file 0 is returned and the error of the stream is set.
+
+*/
+// *****************************************************************************
+static uint8_t GFX_ImageFileByteGet(GFX_IMAGE_FILE_STREAM *pStream)
+{
+    if (pStream->position >= pStream->length)
+    {
+        pStream->position = 0;
+        pStream->length = FILEIO_Read(
+                                pStream->buffer,
+                                1,
+                                GFX_IMAGE_FILE_BUFFER_SIZE,
+                                pStream->pFile);
+        if (pStream->length == 0)
+        {
+            pStream->error = 1;
+            return (0);
+        }
+    }
+
+    return (pStream->buffer[pStream->position++]);
+}
+
+// *****************************************************************************
+/*  Function:
+    uint32_t GFX_ImageFileValueGet(
+                                GFX_IMAGE_FILE_STREAM *pStream,
+                                uint16_t count)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Returns the next count (up to 4) bytes of an image file as
+        a big endian value, the byte order of JPEG and PNG files.
+
+*/
+// *****************************************************************************
+static uint32_t GFX_ImageFileValueGet(
+                                GFX_IMAGE_FILE_STREAM *pStream,
+                                uint16_t count)
+{
+    uint32_t    value = 0;
+
+    while (count--)
+        value = (value << 8) | GFX_ImageFileByteGet(pStream);
+    return (value);
+}
+
+// *****************************************************************************
+/*  Function:
+    void GFX_ImageFileSkip(
+                                GFX_IMAGE_FILE_STREAM *pStream,
+                                uint32_t count)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Skips count bytes of an image file. The bytes that are not
+        read yet are skipped by moving the file position.
+
+*/
+// *****************************************************************************
+static void GFX_ImageFileSkip(
+                                GFX_IMAGE_FILE_STREAM *pStream,
+                                uint32_t count)
+{
+    uint16_t    buffered = pStream->length - pStream->position;
+
+    if (count <= buffered)
+    {
+        pStream->position += count;
+        return;
+    }
+
+    pStream->position = pStream->length;
+    if (FILEIO_Seek(pStream->pFile, count - buffered, FILEIO_SEEK_CUR) != FILEIO_RESULT_SUCCESS)
+        pStream->error = 1;
+}
+
+#endif // #if defined (GFX_CONFIG_JPEG_DECODE_ENABLE) || defined (GFX_CONFIG_PNG_DECODE_ROW_SIZE)
+
+#ifdef GFX_CONFIG_JPEG_DECODE_ENABLE
+
+// position in the 8x8 block of each coefficient in the zigzag order
+static const uint8_t gfxJpegZigzag[64] =
+{
+     0,  1,  8, 16,  9,  2,  3, 10, 17, 24, 32, 25, 18, 11,  4,  5,
+    12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13,  6,  7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63
+};
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_JpegHeaderRead(GFX_JPEG_DECODER *pJpeg)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Reads the markers of a JPEG image up to the entropy coded
+        data of the first scan. The quantization and Huffman tables,
+        the restart interval and the frame and scan headers are kept
+        in pJpeg. Returns GFX_STATUS_FAILURE when the image is not a
+        supported baseline image.
+
+*/
+// *****************************************************************************
+static GFX_STATUS GFX_JpegHeaderRead(GFX_JPEG_DECODER *pJpeg)
+{
+    GFX_IMAGE_FILE_STREAM   *pStream = &gfxImageFile;
+    GFX_JPEG_HUFFMAN_TABLE  *pTable;
+    GFX_JPEG_COMPONENT      *pComponent;
+    uint16_t                marker, length, value, count, i;
+    uint16_t                frame = 0, blocks;
+
+    if ((GFX_ImageFileByteGet(pStream) != 0xFF) || (GFX_ImageFileByteGet(pStream) != 0xD8))
+        return (GFX_STATUS_FAILURE);
+
+    pJpeg->restartInterval = 0;
+
+    while (pStream->error == 0)
+    {
+        // markers can be preceded by fill bytes
+        if (GFX_ImageFileByteGet(pStream) != 0xFF)
+            return (GFX_STATUS_FAILURE);
+        do
+        {
+            marker = GFX_ImageFileByteGet(pStream);
+        } while ((marker == 0xFF) && (pStream->error == 0));
+
+        length = GFX_ImageFileValueGet(pStream, 2);
+        if (length < 2)
+            return (GFX_STATUS_FAILURE);
+        length -= 2;
+
+        switch (marker)
+        {
+            case 0xDB:
+                // quantization tables, 8 bit values only
+                while (length >= 65)
+                {
+                    value = GFX_ImageFileByteGet(pStream);
+                    if (value > 3)
+                        return (GFX_STATUS_FAILURE);
+                    for (i = 0; i < 64; i++)
+                        pJpeg->quant[value][i] = GFX_ImageFileByteGet(pStream);
+                    length -= 65;
+                }
+                if (length != 0)
+                    return (GFX_STATUS_FAILURE);
+                break;
+
+            case 0xC4:
+                // Huffman tables
+                while (length >= 17)
+                {
+                    value = GFX_ImageFileByteGet(pStream);
+                    if ((value & 0x0F) > 1)
+                        return (GFX_STATUS_FAILURE);
+                    if (value & 0xF0)
+                        pTable = &pJpeg->acTable[value & 0x0F];
+                    else
+                        pTable = &pJpeg->dcTable[value & 0x0F];
+
+                    pTable->count[0] = 0;
+                    for (count = 0, i = 1; i < 17; i++)
+                    {
+                        pTable->count[i] = GFX_ImageFileByteGet(pStream);
+                        count += pTable->count[i];
+                    }
+                    if ((count > GFX_JPEG_HUFFMAN_SYMBOLS) || (count > length - 17))
+                        return (GFX_STATUS_FAILURE);
+                    for (i = 0; i < count; i++)
+                        pTable->symbol[i] = GFX_ImageFileByteGet(pStream);
+                    length -= 17 + count;
+                }
+                if (length != 0)
+                    return (GFX_STATUS_FAILURE);
+                break;
+
+            case 0xDD:
+                // restart interval
+                if (length != 2)
+                    return (GFX_STATUS_FAILURE);
+                pJpeg->restartInterval = GFX_ImageFileValueGet(pStream, 2);
+                break;
+
+            case 0xC0:
+            case 0xC1:
+                // baseline and extended Huffman coded frames with 8 bit samples
+                if ((GFX_ImageFileByteGet(pStream) != 8) || (length < 6))
+                    return (GFX_STATUS_FAILURE);
+                pJpeg->height = GFX_ImageFileValueGet(pStream, 2);
+                pJpeg->width = GFX_ImageFileValueGet(pStream, 2);
+                pJpeg->componentCount = GFX_ImageFileByteGet(pStream);
+
+                if ((pJpeg->width == 0) || (pJpeg->height == 0) ||
+                    ((pJpeg->componentCount != 1) && (pJpeg->componentCount != 3)) ||
+                    (length != 6 + (pJpeg->componentCount * 3)))
+                    return (GFX_STATUS_FAILURE);
+
+                pJpeg->horizontalMax = 1;
+                pJpeg->verticalMax = 1;
+                blocks = 0;
+                for (i = 0; i < pJpeg->componentCount; i++)
+                {
+                    pComponent = &pJpeg->component[i];
+                    pComponent->id = GFX_ImageFileByteGet(pStream);
+                    value = GFX_ImageFileByteGet(pStream);
+                    pComponent->horizontal = value >> 4;
+                    pComponent->vertical = value & 0x0F;
+                    pComponent->quantTable = GFX_ImageFileByteGet(pStream);
+
+                    // the MCU of a single component is one block
+                    if (pJpeg->componentCount == 1)
+                    {
+                        pComponent->horizontal = 1;
+                        pComponent->vertical = 1;
+                    }
+
+                    if ((pComponent->horizontal < 1) || (pComponent->horizontal > 2) ||
+                        (pComponent->vertical < 1) || (pComponent->vertical > 2) ||
+                        (pComponent->quantTable > 3))
+                        return (GFX_STATUS_FAILURE);
+
+                    if (pComponent->horizontal > pJpeg->horizontalMax)
+                        pJpeg->horizontalMax = pComponent->horizontal;
+                    if (pComponent->vertical > pJpeg->verticalMax)
+                        pJpeg->verticalMax = pComponent->vertical;
+                    blocks += pComponent->horizontal * pComponent->vertical;
+                }
+                if (blocks > GFX_JPEG_MCU_BLOCKS)
+                    return (GFX_STATUS_FAILURE);
+                frame = 1;
+                break;
+
+            case 0xDA:
+                // start of scan, all the components must be in the scan
+                value = GFX_ImageFileByteGet(pStream);
+                if ((frame == 0) || (value != pJpeg->componentCount) ||
+                    (length != 4 + (value * 2)))
+                    return (GFX_STATUS_FAILURE);
+
+                for (i = 0; i < pJpeg->componentCount; i++)
+                {
+                    pComponent = &pJpeg->component[i];
+                    if (GFX_ImageFileByteGet(pStream) != pComponent->id)
+                        return (GFX_STATUS_FAILURE);
+                    value = GFX_ImageFileByteGet(pStream);
+                    pComponent->dcTable = value >> 4;
+                    pComponent->acTable = value & 0x0F;
+                    if ((pComponent->dcTable > 1) || (pComponent->acTable > 1))
+                        return (GFX_STATUS_FAILURE);
+                    pComponent->dcPrevious = 0;
+                }
+
+                // spectral selection and successive approximation of a baseline scan
+                if ((GFX_ImageFileByteGet(pStream) != 0) ||
+                    (GFX_ImageFileByteGet(pStream) != 63) ||
+                    (GFX_ImageFileByteGet(pStream) != 0))
+                    return (GFX_STATUS_FAILURE);
+
+                pJpeg->bitBuffer = 0;
+                pJpeg->bitCount = 0;
+                pJpeg->marker = 0;
+                return ((pStream->error == 0) ? GFX_STATUS_SUCCESS : GFX_STATUS_FAILURE);
+
+            case 0xC2:  case 0xC3:  case 0xC5:  case 0xC6:  case 0xC7:
+            case 0xC9:  case 0xCA:  case 0xCB:  case 0xCD:  case 0xCE:
+            case 0xCF:  case 0xD9:
+                // progressive, lossless, hierarchical and arithmetic
+                // coded frames are not supported
+                return (GFX_STATUS_FAILURE);
+
+            default:
+                // application data and comments
+                GFX_ImageFileSkip(pStream, length);
+                break;
+        }
+    }
+
+    return (GFX_STATUS_FAILURE);
+}
+
+// *****************************************************************************
+/*  Function:
+    uint16_t GFX_JpegBitsGet(
+                                GFX_JPEG_DECODER *pJpeg,
+                                uint16_t count)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Returns the next count (up to 16) bits of the entropy coded
+        data, the first bit in the highest bit. The 0x00 byte that
+        follows each 0xFF byte of the data is removed. When a marker
+        is found, the marker is kept and 0 bits are returned until
+        the marker is handled.
+
+*/
+// *****************************************************************************
+static uint16_t GFX_JpegBitsGet(
+                                GFX_JPEG_DECODER *pJpeg,
+                                uint16_t count)
+{
+    GFX_IMAGE_FILE_STREAM   *pStream = &gfxImageFile;
+    uint16_t                bits;
+    uint32_t                value;
+
+    if (count == 0)
+        return (0);
+
+    while (pJpeg->bitCount < count)
+    {
+        value = 0;
+        if (pJpeg->marker == 0)
+        {
+            value = GFX_ImageFileByteGet(pStream);
+            if (value == 0xFF)
+            {
+                do
+                {
+                    pJpeg->marker = GFX_ImageFileByteGet(pStream);
+                } while ((pJpeg->marker == 0xFF) && (pStream->error == 0));
+
+                // stuffed byte
+                if (pJpeg->marker == 0)
+                    value = 0xFF;
+                else
+                    value = 0;
+            }
+            if (pStream->error)
+                pJpeg->marker = 0xD9;
+        }
+
+        pJpeg->bitBuffer |= value << (24 - pJpeg->bitCount);
+        pJpeg->bitCount += 8;
+    }
+
+    bits = pJpeg->bitBuffer >> (32 - count);
+    pJpeg->bitBuffer <<= count;
+    pJpeg->bitCount -= count;
+    return (bits);
+}
+
+// *****************************************************************************
+/*  Function:
+    int16_t GFX_JpegSymbolGet(
+                                GFX_JPEG_DECODER *pJpeg,
+                                const GFX_JPEG_HUFFMAN_TABLE *pTable)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Decodes the next symbol of the entropy coded data with a
+        Huffman table. The code is read one bit at a time as in
+        GFX_InflateSymbolGet() but the first bit of the code is the
+        highest bit. Returns -1 for an unused code.
+
+*/
+// *****************************************************************************
+static int16_t GFX_JpegSymbolGet(
+                                GFX_JPEG_DECODER *pJpeg,
+                                const GFX_JPEG_HUFFMAN_TABLE *pTable)
+{
+    uint16_t    code = 0, first = 0, index = 0, length;
+
+    for (length = 1; length < 17; length++)
+    {
+        code |= GFX_JpegBitsGet(pJpeg, 1);
+
+        // the codes of this length are first to first + count - 1
+        if (code < first + pTable->count[length])
+            return (pTable->symbol[index + code - first]);
+
+        index += pTable->count[length];
+        first  = (first + pTable->count[length]) << 1;
+        code <<= 1;
+    }
+
+    return (-1);
+}
+
+// *****************************************************************************
+/*  Function:
+    int16_t GFX_JpegValueGet(
+                                GFX_JPEG_DECODER *pJpeg,
+                                uint16_t size)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Returns the signed value of size bits that follows a DC or
+        AC symbol. Values with the highest bit cleared are negative.
+
+*/
+// *****************************************************************************
+static int16_t GFX_JpegValueGet(
+                                GFX_JPEG_DECODER *pJpeg,
+                                uint16_t size)
+{
+    int16_t     value;
+
+    if (size == 0)
+        return (0);
+
+    value = GFX_JpegBitsGet(pJpeg, size);
+    if (value < (1 << (size - 1)))
+        value -= (1 << size) - 1;
+    return (value);
+}
+
+// *****************************************************************************
+/*  Function:
+    void GFX_JpegIdct1D(int32_t *pData, uint16_t stride)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Computes the inverse DCT of 8 values spaced by stride with
+        the integer algorithm of Loeffler, Ligtenberg and Moschytz.
+        The results are scaled by 4096.
+
+*/
+// *****************************************************************************
+static void GFX_JpegIdct1D(int32_t *pData, uint16_t stride)
+{
+    int32_t     t0, t1, t2, t3, p1, p2, p3, p4, p5, x0, x1, x2, x3;
+
+    // even part
+    p2 = pData[2 * stride];
+    p3 = pData[6 * stride];
+    p1 = (p2 + p3) * 2217;
+    t2 = p1 + (p3 * -7567);
+    t3 = p1 + (p2 * 3135);
+
+    p2 = pData[0];
+    p3 = pData[4 * stride];
+    t0 = (p2 + p3) * 4096;
+    t1 = (p2 - p3) * 4096;
+
+    x0 = t0 + t3;
+    x3 = t0 - t3;
+    x1 = t1 + t2;
+    x2 = t1 - t2;
+
+    // odd part
+    t0 = pData[7 * stride];
+    t1 = pData[5 * stride];
+    t2 = pData[3 * stride];
+    t3 = pData[1 * stride];
+
+    p3 = t0 + t2;
+    p4 = t1 + t3;
+    p1 = t0 + t3;
+    p2 = t1 + t2;
+    p5 = (p3 + p4) * 4816;
+
+    t0 = t0 * 1223;
+    t1 = t1 * 8410;
+    t2 = t2 * 12586;
+    t3 = t3 * 6149;
+    p1 = p5 + (p1 * -3685);
+    p2 = p5 + (p2 * -10497);
+    p3 = p3 * -8034;
+    p4 = p4 * -1597;
+
+    t3 += p1 + p4;
+    t2 += p2 + p3;
+    t1 += p2 + p4;
+    t0 += p1 + p3;
+
+    pData[0]          = x0 + t3;
+    pData[7 * stride] = x0 - t3;
+    pData[1 * stride] = x1 + t2;
+    pData[6 * stride] = x1 - t2;
+    pData[2 * stride] = x2 + t1;
+    pData[5 * stride] = x2 - t1;
+    pData[3 * stride] = x3 + t0;
+    pData[4 * stride] = x3 - t0;
+}
+
+// *****************************************************************************
+/*  Function:
+    void GFX_JpegBlockSamplesGet(
+                                GFX_JPEG_DECODER *pJpeg,
+                                uint8_t *pSample,
+                                uint16_t scale)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Computes the samples of the decoded block from its
+        coefficients. The block is reduced to (8 >> scale) by
+        (8 >> scale) samples by averaging the samples, at 1/8 the
+        sample is the DC coefficient and the inverse DCT is skipped.
+
+*/
+// *****************************************************************************
+static void GFX_JpegBlockSamplesGet(
+                                GFX_JPEG_DECODER *pJpeg,
+                                uint8_t *pSample,
+                                uint16_t scale)
+{
+    int32_t     data[64], value;
+    uint16_t    i, j, x, y, size, step;
+
+    if (scale == 3)
+    {
+        // the DC coefficient is 8 times the average of the samples
+        value = (pJpeg->coefficient[0] + 1024 + 4) >> 3;
+        pSample[0] = (value < 0) ? 0 : ((value > 255) ? 255 : value);
+        return;
+    }
+
+    for (i = 0; i < 64; i++)
+        data[i] = pJpeg->coefficient[i];
+
+    // columns, the results keep 2 bits of fraction
+    for (i = 0; i < 8; i++)
+    {
+        if ((data[i + 8] | data[i + 16] | data[i + 24] | data[i + 32] |
+             data[i + 40] | data[i + 48] | data[i + 56]) == 0)
+        {
+            // only the DC coefficient, frequent after quantization
+            value = data[i] * 4;
+            for (j = i; j < 64; j += 8)
+                data[j] = value;
+            continue;
+        }
+
+        GFX_JpegIdct1D(&data[i], 8);
+        for (j = i; j < 64; j += 8)
+            data[j] = (data[j] + 512) >> 10;
+    }
+
+    // rows, the samples are offset by 128
+    for (i = 0; i < 64; i += 8)
+    {
+        GFX_JpegIdct1D(&data[i], 1);
+        for (j = i; j < i + 8; j++)
+        {
+            value = (data[j] + 65536 + (128L << 17)) >> 17;
+            data[j] = (value < 0) ? 0 : ((value > 255) ? 255 : value);
+        }
+    }
+
+    // average each step by step square of samples
+    size = 8 >> scale;
+    step = 1 << scale;
+    for (y = 0; y < size; y++)
+    {
+        for (x = 0; x < size; x++)
+        {
+            value = 0;
+            for (j = 0; j < step; j++)
+                for (i = 0; i < step; i++)
+                    value += data[(((y * step) + j) << 3) + (x * step) + i];
+            pSample[(y * size) + x] = (value + ((step * step) >> 1)) >> (scale * 2);
+        }
+    }
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_JpegBlockDecode(
+                                GFX_JPEG_DECODER *pJpeg,
+                                GFX_JPEG_COMPONENT *pComponent,
+                                uint8_t *pSample,
+                                uint16_t scale)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Decodes the next block of a component. When pSample is NULL
+        the block is outside of the rendered portion of the image,
+        the coefficients are decoded to reach the next block and
+        the samples are not computed.
+
+*/
+// *****************************************************************************
+static GFX_STATUS GFX_JpegBlockDecode(
+                                GFX_JPEG_DECODER *pJpeg,
+                                GFX_JPEG_COMPONENT *pComponent,
+                                uint8_t *pSample,
+                                uint16_t scale)
+{
+    const uint8_t   *pQuant = pJpeg->quant[pComponent->quantTable];
+    int16_t         symbol, value;
+    uint16_t        k;
+
+    // the DC coefficient is coded as the difference with the previous block
+    symbol = GFX_JpegSymbolGet(pJpeg, &pJpeg->dcTable[pComponent->dcTable]);
+    if ((symbol < 0) || (symbol > 11))
+        return (GFX_STATUS_FAILURE);
+    pComponent->dcPrevious += GFX_JpegValueGet(pJpeg, symbol);
+
+    // only the DC coefficient is used at 1/8
+    if ((pSample != NULL) && (scale != 3))
+    {
+        for (k = 1; k < 64; k++)
+            pJpeg->coefficient[k] = 0;
+    }
+    pJpeg->coefficient[0] = pComponent->dcPrevious * pQuant[0];
+
+    for (k = 1; k < 64; k++)
+    {
+        // a symbol is a run of zero coefficients and the size of the next value
+        symbol = GFX_JpegSymbolGet(pJpeg, &pJpeg->acTable[pComponent->acTable]);
+        if (symbol < 0)
+            return (GFX_STATUS_FAILURE);
+
+        if ((symbol & 0x0F) == 0)
+        {
+            // end of block or 16 zero coefficients
+            if (symbol != 0xF0)
+                break;
+            k += 15;
+            continue;
+        }
+
+        k += symbol >> 4;
+        if (k > 63)
+            return (GFX_STATUS_FAILURE);
+
+        value = GFX_JpegValueGet(pJpeg, symbol & 0x0F);
+        if ((pSample != NULL) && (scale != 3))
+            pJpeg->coefficient[gfxJpegZigzag[k]] = value * pQuant[k];
+    }
+
+    if (pSample != NULL)
+        GFX_JpegBlockSamplesGet(pJpeg, pSample, scale);
+
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_JpegRestart(GFX_JPEG_DECODER *pJpeg)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Reads the restart marker that follows each restart interval.
+        The entropy coded data starts again on a byte and the DC
+        coefficients start again from 0.
+
+*/
+// *****************************************************************************
+static GFX_STATUS GFX_JpegRestart(GFX_JPEG_DECODER *pJpeg)
+{
+    GFX_IMAGE_FILE_STREAM   *pStream = &gfxImageFile;
+    uint16_t                i;
+
+    // the marker is usually found while reading the last bits
+    while ((pJpeg->marker == 0) && (pStream->error == 0))
+    {
+        if (GFX_ImageFileByteGet(pStream) == 0xFF)
+        {
+            do
+            {
+                pJpeg->marker = GFX_ImageFileByteGet(pStream);
+            } while ((pJpeg->marker == 0xFF) && (pStream->error == 0));
+        }
+    }
+
+    if ((pJpeg->marker < 0xD0) || (pJpeg->marker > 0xD7))
+        return (GFX_STATUS_FAILURE);
+
+    pJpeg->bitBuffer = 0;
+    pJpeg->bitCount = 0;
+    pJpeg->marker = 0;
+    for (i = 0; i < pJpeg->componentCount; i++)
+        pJpeg->component[i].dcPrevious = 0;
+
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    void GFX_ImageJpegDraw(
+                                uint16_t left,
+                                uint16_t top,
+                                GFX_RESOURCE_HDR *pImage,
+                                GFX_PARTIAL_IMAGE_PARAM *pPartialImageData)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Renders a baseline JPEG image from a file. The image is
+        decoded one MCU at a time and the lines of each MCU that
+        are in the rendered portion are rendered. The portion is
+        limited to the screen, so the columns right of the screen
+        are not rendered. The coefficients of the MCUs outside of
+        the portion are decoded without computing the samples and
+        the MCU rows below the portion are not decoded.
+
+*/
+// *****************************************************************************
+static void GFX_ImageJpegDraw(
+                                uint16_t left,
+                                uint16_t top,
+                                GFX_RESOURCE_HDR *pImage,
+                                GFX_PARTIAL_IMAGE_PARAM *pPartialImageData)
+{
+    GFX_JPEG_DECODER    *pJpeg = &gfxJpeg;
+    GFX_JPEG_COMPONENT  *pComponent;
+    uint16_t            scale = pImage->resource.image.parameter2.scale;
+    uint16_t            blockSize, blockShift, mcuWidth, mcuHeight, mcuColumns, mcuRows;
+    uint16_t            xOffset = 0, yOffset = 0, sizeX, sizeY;
+    uint16_t            mcuX, mcuY, mcuLeft, mcuTop, x, y, first, last;
+    uint16_t            c, h, v, block, restartCount;
+    uint16_t            firstBlock[3], horizontalShift[3], verticalShift[3];
+    uint8_t             *pSample, *pBlock, sample[3];
+    int16_t             red, green, blue, cb, cr;
+
+    sizeX = pImage->resource.image.width;
+    sizeY = pImage->resource.image.height;
+    if (pPartialImageData->width != 0)
+    {
+        xOffset = pPartialImageData->xoffset;
+        yOffset = pPartialImageData->yoffset;
+        sizeX = pPartialImageData->width;
+        sizeY = pPartialImageData->height;
+    }
+
+    // the portion is limited to the screen, the clip rectangle is
+    // already applied to the portion by GFX_ImagePartialDraw()
+    if ((left > GFX_MaxXGet()) || (top > GFX_MaxYGet()))
+        return;
+    if ((uint32_t)left + sizeX > (uint32_t)GFX_MaxXGet() + 1)
+        sizeX = GFX_MaxXGet() + 1 - left;
+    if ((uint32_t)top + sizeY > (uint32_t)GFX_MaxYGet() + 1)
+        sizeY = GFX_MaxYGet() + 1 - top;
+
+    if (GFX_ImageFileStart(&gfxImageFile, pImage) != GFX_STATUS_SUCCESS)
+        return;
+    if (GFX_JpegHeaderRead(pJpeg) != GFX_STATUS_SUCCESS)
+        return;
+
+    // size of the reduced blocks and MCUs
+    blockSize = 8 >> scale;
+    blockShift = 3 - scale;
+    mcuWidth = (pJpeg->horizontalMax * 8) >> scale;
+    mcuHeight = (pJpeg->verticalMax * 8) >> scale;
+    mcuColumns = (pJpeg->width + (pJpeg->horizontalMax * 8) - 1) / (pJpeg->horizontalMax * 8);
+    mcuRows = (pJpeg->height + (pJpeg->verticalMax * 8) - 1) / (pJpeg->verticalMax * 8);
+
+    // blocks of each component in the MCU, the subsampled
+    // components are scaled up by repeating the samples
+    block = 0;
+    for (c = 0; c < pJpeg->componentCount; c++)
+    {
+        pComponent = &pJpeg->component[c];
+        firstBlock[c] = block;
+        horizontalShift[c] = (pComponent->horizontal == pJpeg->horizontalMax) ? 0 : 1;
+        verticalShift[c] = (pComponent->vertical == pJpeg->verticalMax) ? 0 : 1;
+        block += pComponent->horizontal * pComponent->vertical;
+    }
+
+    restartCount = 0;
+    for (mcuY = 0; mcuY < mcuRows; mcuY++)
+    {
+        mcuTop = mcuY * mcuHeight;
+        if (mcuTop >= yOffset + sizeY)
+            break;
+
+        for (mcuX = 0; mcuX < mcuColumns; mcuX++)
+        {
+            if ((pJpeg->restartInterval != 0) && (restartCount == pJpeg->restartInterval))
+            {
+                if (GFX_JpegRestart(pJpeg) != GFX_STATUS_SUCCESS)
+                    return;
+                restartCount = 0;
+            }
+            restartCount++;
+
+            mcuLeft = mcuX * mcuWidth;
+
+            // the samples are computed only for the MCUs in the portion
+            pSample = NULL;
+            if ((mcuTop + mcuHeight > yOffset) &&
+                (mcuLeft + mcuWidth > xOffset) && (mcuLeft < xOffset + sizeX))
+                pSample = pJpeg->sample[0];
+
+            block = 0;
+            for (c = 0; c < pJpeg->componentCount; c++)
+            {
+                pComponent = &pJpeg->component[c];
+                for (v = 0; v < pComponent->vertical; v++)
+                {
+                    for (h = 0; h < pComponent->horizontal; h++, block++)
+                    {
+                        if (GFX_JpegBlockDecode(
+                                pJpeg,
+                                pComponent,
+                                (pSample != NULL) ? pJpeg->sample[block] : NULL,
+                                scale) != GFX_STATUS_SUCCESS)
+                            return;
+                    }
+                }
+            }
+
+            if (gfxImageFile.error)
+                return;
+            if (pSample == NULL)
+                continue;
+
+            // columns of the MCU in the portion
+            first = (mcuLeft < xOffset) ? (xOffset - mcuLeft) : 0;
+            last = mcuWidth;
+            if (mcuLeft + last > xOffset + sizeX)
+                last = xOffset + sizeX - mcuLeft;
+
+            for (y = 0; y < mcuHeight; y++)
+            {
+                if ((mcuTop + y < yOffset) || (mcuTop + y >= yOffset + sizeY))
+                    continue;
+
+                for (x = first; x < last; x++)
+                {
+                    for (c = 0; c < pJpeg->componentCount; c++)
+                    {
+                        h = x >> horizontalShift[c];
+                        v = y >> verticalShift[c];
+                        pBlock = pJpeg->sample[firstBlock[c] +
+                                ((v >> blockShift) * pJpeg->component[c].horizontal) +
+                                (h >> blockShift)];
+                        sample[c] = pBlock[((v & (blockSize - 1)) << blockShift) + (h & (blockSize - 1))];
+                    }
+
+                    if (pJpeg->componentCount == 1)
+                    {
+                        red = green = blue = sample[0];
+                    }
+                    else
+                    {
+                        // YCbCr to RGB with 8 bits of fraction
+                        cb = sample[1] - 128;
+                        cr = sample[2] - 128;
+                        red   = sample[0] + ((359 * cr) >> 8);
+                        green = sample[0] - (((88 * cb) + (183 * cr)) >> 8);
+                        blue  = sample[0] + ((454 * cb) >> 8);
+
+                        red   = (red < 0) ? 0 : ((red > 255) ? 255 : red);
+                        green = (green < 0) ? 0 : ((green > 255) ? 255 : green);
+                        blue  = (blue < 0) ? 0 : ((blue > 255) ? 255 : blue);
+                    }
+
+#ifdef GFX_CONFIG_PIXEL_ARRAY_NO_SWAP_DISABLE
+                    gfxLineBuffer0[last - 1 - x] = GFX_RGBConvert(red, green, blue);
+#else
+                    gfxLineBuffer0[x - first] = GFX_RGBConvert(red, green, blue);
+#endif
+                }
+
+                // render the line of the MCU
+                if (GFX_ImageLineRender(
+                            left + mcuLeft + first - xOffset,
+                            top + mcuTop + y - yOffset,
+                            last - first) == 0)
+                    return;
+            }
+        }
+    }
+}
+
+#endif // #ifdef GFX_CONFIG_JPEG_DECODE_ENABLE
+
+#ifdef GFX_CONFIG_PNG_DECODE_ROW_SIZE
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_PngHeaderRead(GFX_PNG_DECODER *pPng)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Reads the chunks of a PNG image up to the data of the first
+        IDAT chunk. The header is checked and the palette is kept
+        in pPng. Returns GFX_STATUS_FAILURE when the image is not
+        supported.
+
+*/
+// *****************************************************************************
+static GFX_STATUS GFX_PngHeaderRead(GFX_PNG_DECODER *pPng)
+{
+    GFX_IMAGE_FILE_STREAM   *pStream = &gfxImageFile;
+    uint32_t                length, type, width, height;
+    uint16_t                i, red, green, blue;
+
+    if ((GFX_ImageFileValueGet(pStream, 4) != 0x89504E47UL) ||
+        (GFX_ImageFileValueGet(pStream, 4) != 0x0D0A1A0AUL))
+        return (GFX_STATUS_FAILURE);
+
+    // the header is the first chunk
+    if ((GFX_ImageFileValueGet(pStream, 4) != 13) ||
+        (GFX_ImageFileValueGet(pStream, 4) != 0x49484452UL))
+        return (GFX_STATUS_FAILURE);
+
+    width = GFX_ImageFileValueGet(pStream, 4);
+    height = GFX_ImageFileValueGet(pStream, 4);
+    pPng->bitDepth = GFX_ImageFileByteGet(pStream);
+    pPng->colorType = GFX_ImageFileByteGet(pStream);
+
+    // compression, filter and interlace methods, only non interlaced images
+    if ((GFX_ImageFileByteGet(pStream) != 0) ||
+        (GFX_ImageFileByteGet(pStream) != 0) ||
+        (GFX_ImageFileByteGet(pStream) != 0))
+        return (GFX_STATUS_FAILURE);
+    GFX_ImageFileSkip(pStream, 4);
+
+    if ((width == 0) || (width > 0xFFFF) || (height == 0) || (height > 0xFFFF))
+        return (GFX_STATUS_FAILURE);
+    pPng->width = width;
+    pPng->height = height;
+
+    switch (pPng->colorType)
+    {
+        case 0:
+            // grayscale
+            pPng->channels = 1;
+            if ((pPng->bitDepth != 1) && (pPng->bitDepth != 2) && (pPng->bitDepth != 4) &&
+                (pPng->bitDepth != 8) && (pPng->bitDepth != 16))
+                return (GFX_STATUS_FAILURE);
+            break;
+        case 3:
+            // palette
+            pPng->channels = 1;
+            if ((pPng->bitDepth != 1) && (pPng->bitDepth != 2) && (pPng->bitDepth != 4) &&
+                (pPng->bitDepth != 8))
+                return (GFX_STATUS_FAILURE);
+            break;
+        case 2:
+        case 4:
+        case 6:
+            // RGB, grayscale with alpha and RGB with alpha
+            pPng->channels = (pPng->colorType == 2) ? 3 : ((pPng->colorType == 4) ? 2 : 4);
+            if ((pPng->bitDepth != 8) && (pPng->bitDepth != 16))
+                return (GFX_STATUS_FAILURE);
+            break;
+        default:
+            return (GFX_STATUS_FAILURE);
+    }
+
+    length = (((uint32_t)width * pPng->channels * pPng->bitDepth) + 7) >> 3;
+    if (length > GFX_CONFIG_PNG_DECODE_ROW_SIZE)
+        return (GFX_STATUS_FAILURE);
+    pPng->rowLength = length;
+    pPng->pixelBytes = (pPng->channels * pPng->bitDepth) >> 3;
+    if (pPng->pixelBytes == 0)
+        pPng->pixelBytes = 1;
+
+    pPng->paletteEntries = 0;
+    while (pStream->error == 0)
+    {
+        length = GFX_ImageFileValueGet(pStream, 4);
+        type = GFX_ImageFileValueGet(pStream, 4);
+
+        if (type == 0x49444154UL)
+        {
+            // IDAT, the data follows
+            if ((pPng->colorType == 3) && (pPng->paletteEntries == 0))
+                return (GFX_STATUS_FAILURE);
+            pPng->chunkLength = length;
+            return ((pStream->error == 0) ? GFX_STATUS_SUCCESS : GFX_STATUS_FAILURE);
+        }
+
+        if ((type == 0x504C5445UL) && (length <= 768) && ((length % 3) == 0))
+        {
+            // PLTE
+            pPng->paletteEntries = length / 3;
+            for (i = 0; i < pPng->paletteEntries; i++)
+            {
+                red = GFX_ImageFileByteGet(pStream);
+                green = GFX_ImageFileByteGet(pStream);
+                blue = GFX_ImageFileByteGet(pStream);
+                pPng->palette[i] = GFX_RGBConvert(red, green, blue);
+            }
+            length = 0;
+        }
+        else if (type == 0x49454E44UL)
+        {
+            // IEND before the data
+            return (GFX_STATUS_FAILURE);
+        }
+
+        // the other chunks and the CRCs are not used
+        GFX_ImageFileSkip(pStream, length + 4);
+    }
+
+    return (GFX_STATUS_FAILURE);
+}
+
+// *****************************************************************************
+/*  Function:
+    uint8_t GFX_PngDataByteGet(GFX_INFLATE_STREAM *pStream)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Returns the next byte of the compressed data of a PNG image.
+        The data continues in the next IDAT chunk at the end of each
+        chunk. The stream is set in error when the data ends before
+        the image.
+
+*/
+// *****************************************************************************
+static uint8_t GFX_PngDataByteGet(GFX_INFLATE_STREAM *pStream)
+{
+    GFX_IMAGE_FILE_STREAM   *pFileStream = &gfxImageFile;
+    uint8_t                 value;
+
+    while (gfxPng.chunkLength == 0)
+    {
+        // CRC of the chunk, length and type of the next chunk
+        GFX_ImageFileSkip(pFileStream, 4);
+        gfxPng.chunkLength = GFX_ImageFileValueGet(pFileStream, 4);
+        if ((GFX_ImageFileValueGet(pFileStream, 4) != 0x49444154UL) || pFileStream->error)
+        {
+            pStream->state = GFX_INFLATE_ERROR;
+            return (0);
+        }
+    }
+
+    value = GFX_ImageFileByteGet(pFileStream);
+    if (pFileStream->error)
+    {
+        pStream->state = GFX_INFLATE_ERROR;
+        return (0);
+    }
+    gfxPng.chunkLength--;
+    pStream->address++;
+    return (value);
+}
+
+// *****************************************************************************
+/*  Function:
+    void GFX_PngRowUnfilter(
+                                GFX_PNG_DECODER *pPng,
+                                uint8_t filter,
+                                uint8_t *pRow,
+                                const uint8_t *pPrevious)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Removes the filter of a decoded row. Each byte is predicted
+        from the byte of the previous pixel, the byte above or both.
+
+*/
+// *****************************************************************************
+static void GFX_PngRowUnfilter(
+                                GFX_PNG_DECODER *pPng,
+                                uint8_t filter,
+                                uint8_t *pRow,
+                                const uint8_t *pPrevious)
+{
+    uint16_t    i, bpp = pPng->pixelBytes;
+    int16_t     a, b, c, p, pa, pb, pc;
+
+    for (i = 0; i < pPng->rowLength; i++)
+    {
+        // bytes on the left, above and above on the left
+        a = (i >= bpp) ? pRow[i - bpp] : 0;
+        b = pPrevious[i];
+        c = (i >= bpp) ? pPrevious[i - bpp] : 0;
+
+        switch (filter)
+        {
+            case 1:
+                pRow[i] += a;
+                break;
+            case 2:
+                pRow[i] += b;
+                break;
+            case 3:
+                pRow[i] += (a + b) >> 1;
+                break;
+            case 4:
+                // Paeth, the closest of a, b and c to a + b - c
+                p = a + b - c;
+                pa = (p > a) ? (p - a) : (a - p);
+                pb = (p > b) ? (p - b) : (b - p);
+                pc = (p > c) ? (p - c) : (c - p);
+                if ((pa <= pb) && (pa <= pc))
+                    pRow[i] += a;
+                else if (pb <= pc)
+                    pRow[i] += b;
+                else
+                    pRow[i] += c;
+                break;
+            default:
+                return;
+        }
+    }
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_COLOR GFX_PngPixelGet(
+                                GFX_PNG_DECODER *pPng,
+                                const uint8_t *pRow,
+                                uint16_t x)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Returns the color of pixel x of a decoded row. 16 bit samples
+        use the most significant byte, grayscale samples of less
+        than 8 bits are scaled to 8 bits and alpha is ignored.
+
+*/
+// *****************************************************************************
+static GFX_COLOR GFX_PngPixelGet(
+                                GFX_PNG_DECODER *pPng,
+                                const uint8_t *pRow,
+                                uint16_t x)
+{
+    const uint8_t   *pPixel;
+    uint16_t        red, green, blue, mask, shift;
+    uint32_t        bit;
+
+    if (pPng->bitDepth < 8)
+    {
+        // the pixels are packed from the highest bits
+        bit = (uint32_t)x * pPng->bitDepth;
+        mask = (1 << pPng->bitDepth) - 1;
+        shift = 8 - pPng->bitDepth - (bit & 7);
+        red = (pRow[bit >> 3] >> shift) & mask;
+
+        if (pPng->colorType == 3)
+            return ((red < pPng->paletteEntries) ? pPng->palette[red] : 0);
+
+        red = (red * 255) / mask;
+        return (GFX_RGBConvert(red, red, red));
+    }
+
+    pPixel = pRow + ((uint32_t)x * pPng->channels * (pPng->bitDepth >> 3));
+    shift = (pPng->bitDepth == 16) ? 1 : 0;
+
+    red = pPixel[0];
+    if (pPng->colorType == 3)
+        return ((red < pPng->paletteEntries) ? pPng->palette[red] : 0);
+
+    if ((pPng->colorType == 2) || (pPng->colorType == 6))
+    {
+        green = pPixel[1 << shift];
+        blue = pPixel[2 << shift];
+    }
+    else
+    {
+        green = blue = red;
+    }
+
+    return (GFX_RGBConvert(red, green, blue));
+}
+
+// *****************************************************************************
+/*  Function:
+    void GFX_ImagePngDraw(
+                                uint16_t left,
+                                uint16_t top,
+                                GFX_RESOURCE_HDR *pImage,
+                                GFX_PARTIAL_IMAGE_PARAM *pPartialImageData)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Renders a PNG image from a file one row at a time. The rows
+        are decompressed with the DEFLATE decoder of the IPU images
+        and unfiltered with the previous row. The image is reduced by
+        using one pixel of each square of pixels. The portion is
+        limited to the screen and the rows below it are not decoded.
+
+*/
+// *****************************************************************************
+static void GFX_ImagePngDraw(
+                                uint16_t left,
+                                uint16_t top,
+                                GFX_RESOURCE_HDR *pImage,
+                                GFX_PARTIAL_IMAGE_PARAM *pPartialImageData)
+{
+    GFX_PNG_DECODER     *pPng = &gfxPng;
+    GFX_INFLATE_STREAM  *pStream = &gfxInflateStream;
+    uint16_t            scale = pImage->resource.image.parameter2.scale;
+    uint16_t            xOffset = 0, yOffset = 0, sizeX, sizeY;
+    uint16_t            x, y, i, current = 0;
+    uint16_t            header;
+    uint8_t             filter;
+
+    sizeX = pImage->resource.image.width;
+    sizeY = pImage->resource.image.height;
+    if (pPartialImageData->width != 0)
+    {
+        xOffset = pPartialImageData->xoffset;
+        yOffset = pPartialImageData->yoffset;
+        sizeX = pPartialImageData->width;
+        sizeY = pPartialImageData->height;
+    }
+
+    // the portion is limited to the screen, the clip rectangle is
+    // already applied to the portion by GFX_ImagePartialDraw()
+    if ((left > GFX_MaxXGet()) || (top > GFX_MaxYGet()))
+        return;
+    if ((uint32_t)left + sizeX > (uint32_t)GFX_MaxXGet() + 1)
+        sizeX = GFX_MaxXGet() + 1 - left;
+    if ((uint32_t)top + sizeY > (uint32_t)GFX_MaxYGet() + 1)
+        sizeY = GFX_MaxYGet() + 1 - top;
+
+    if (GFX_ImageFileStart(&gfxImageFile, pImage) != GFX_STATUS_SUCCESS)
+        return;
+    if (GFX_PngHeaderRead(pPng) != GFX_STATUS_SUCCESS)
+        return;
+
+    GFX_InflateStart(pStream, pImage);
+
+    // zlib header, DEFLATE without preset dictionary
+    header = GFX_InflateBitsGet(pStream, 8) << 8;
+    header |= GFX_InflateBitsGet(pStream, 8);
+    if (((header & 0x0F00) != 0x0800) || ((header % 31) != 0) || (header & 0x0020))
+        return;
+
+    // the first row is unfiltered with a row of 0
+    for (i = 0; i < pPng->rowLength; i++)
+        pPng->row[1][i] = 0;
+
+    for (y = 0; y < pPng->height; y++)
+    {
+        // rendered rows of the reduced image
+        if ((y >> scale) >= yOffset + sizeY)
+            break;
+
+        if ((GFX_InflateRead(pStream, &filter, 1) != 1) ||
+            (GFX_InflateRead(pStream, pPng->row[current], pPng->rowLength) != pPng->rowLength) ||
+            (filter > 4))
+            return;
+
+        GFX_PngRowUnfilter(pPng, filter, pPng->row[current], pPng->row[current ^ 1]);
+
+        if (((y & ((1 << scale) - 1)) == 0) && ((y >> scale) >= yOffset))
+        {
+            for (x = 0; x < sizeX; x++)
+            {
+#ifdef GFX_CONFIG_PIXEL_ARRAY_NO_SWAP_DISABLE
+                gfxLineBuffer0[sizeX - 1 - x] =
+#else
+                gfxLineBuffer0[x] =
+#endif
+                        GFX_PngPixelGet(pPng, pPng->row[current], (xOffset + x) << scale);
+            }
+
+            if (GFX_ImageLineRender(left, top + (y >> scale) - yOffset, sizeX) == 0)
+                return;
+        }
+
+        current ^= 1;
+    }
+}
+
+#endif // #ifdef GFX_CONFIG_PNG_DECODE_ROW_SIZE
+
+#if defined (GFX_CONFIG_JPEG_DECODE_ENABLE) || defined (GFX_CONFIG_PNG_DECODE_ROW_SIZE)
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_ImageFileCreate(
+                                GFX_RESOURCE_HDR *pImage,
+                                FILEIO_OBJECT *pFile,
+                                uint16_t scale)
+
+    Summary:
+        Creates the resource header of a JPEG or PNG image in a file.
+
+    Description:
+        Refer to gfx_primitive.h for details.
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_ImageFileCreate(
+                                GFX_RESOURCE_HDR *pImage,
+                                FILEIO_OBJECT *pFile,
+                                uint16_t scale)
+{
+    GFX_IMAGE_FILE_STREAM   *pStream = &gfxImageFile;
+    uint16_t                width, height, colorDepth;
+    uint16_t                type;
+    long                    offset;
+
+    if ((pImage == NULL) || (pFile == NULL) || (scale > 3))
+        return (GFX_STATUS_FAILURE);
+
+    offset = FILEIO_Tell(pFile);
+    if (offset < 0)
+        return (GFX_STATUS_FAILURE);
+
+    pImage->resource.image.location.pFile = pFile;
+    pImage->resource.image.parameter1.fileOffset = offset;
+    pImage->resource.image.parameter2.scale = scale;
+
+    // the first byte tells the type of image
+    pStream->pFile = pFile;
+    pStream->position = 0;
+    pStream->length = 0;
+    pStream->error = 0;
+    type = GFX_ImageFileByteGet(pStream);
+
+    if (GFX_ImageFileStart(pStream, pImage) != GFX_STATUS_SUCCESS)
+        return (GFX_STATUS_FAILURE);
+
+    switch (type)
+    {
+#ifdef GFX_CONFIG_JPEG_DECODE_ENABLE
+        case 0xFF:
+            if (GFX_JpegHeaderRead(&gfxJpeg) != GFX_STATUS_SUCCESS)
+                return (GFX_STATUS_FAILURE);
+            type = GFX_RESOURCE_JPEG_FILE_NONE;
+            width = gfxJpeg.width;
+            height = gfxJpeg.height;
+            colorDepth = gfxJpeg.componentCount * 8;
+            break;
+#endif
+#ifdef GFX_CONFIG_PNG_DECODE_ROW_SIZE
+        case 0x89:
+            if (GFX_PngHeaderRead(&gfxPng) != GFX_STATUS_SUCCESS)
+                return (GFX_STATUS_FAILURE);
+            type = GFX_RESOURCE_PNG_FILE_NONE;
+            width = gfxPng.width;
+            height = gfxPng.height;
+            colorDepth = gfxPng.channels * gfxPng.bitDepth;
+            break;
+#endif
+        default:
+            return (GFX_STATUS_FAILURE);
+    }
+
+    pImage->type = type;
+    pImage->ID = 0;
+    pImage->resource.image.width = ((uint32_t)width + (1 << scale) - 1) >> scale;
+    pImage->resource.image.height = ((uint32_t)height + (1 << scale) - 1) >> scale;
+    pImage->resource.image.colorDepth = colorDepth;
+
+    return (GFX_STATUS_SUCCESS);
+}
+
+#endif // #if defined (GFX_CONFIG_JPEG_DECODE_ENABLE) || defined (GFX_CONFIG_PNG_DECODE_ROW_SIZE)
+
+#ifndef GFX_CONFIG_DOUBLE_BUFFERING_DISABLE
+
+// *****************************************************************************
+/*  Function:
+    void GFX_DRV_DoubleBufferDisable(void)
+
+    Summary:
+        This function is the driver specific double buffering disabling
+        steps to initialize buffers to a state where double buffering
+        is disabled.
+
+    Description:
+        This function is the driver specific double buffering disabling
+        steps to initialize buffers to a state where double buffering
+        is disabled.
+
+*/
+// *****************************************************************************
+void __attribute__((weak)) GFX_DRV_DoubleBufferDisable(void)
+{ }
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_DrawBufferInitialize(
+                                int index,
+                                uint32_t address)
+
+    Summary:
+        This function initializes the address of the draw buffer
+        specified by the given index.
+
+    Description:
+        For system with multiple buffers, this function is used to
+        initialize the array of buffers. The address of the draw buffer
+        will be associated with the specified index. Use this function
+        to initialize or modify the array of frame buffers in the system
+        at run time.
+        For systems with single buffer this function will have no effect.
+        The size of the buffer is defined by the dimension of the screen
+        and the color depth used.
+
+*/
+// *****************************************************************************
+GFX_STATUS __attribute__((weak)) GFX_DrawBufferInitialize(
+                                uint16_t index,
+                                uint32_t address)
+{
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_DrawBufferSet(uint16_t index)
+
+    Summary:
+        This function sets the draw buffer with the given index number.
+
+    Description:
+        This function sets the draw buffer with the given index number.
+        For systems with single buffer, frame buffer and draw buffer are
+        the same buffer. Calls to this function will have no effect and
+        will always return GFX_STATUS_SUCCESS.
+
+*/
+// *****************************************************************************
+GFX_STATUS __attribute__((weak)) GFX_DrawBufferSet(uint16_t index)
+{
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    uint16_t GFX_DrawBufferGet(void)
+
+    Summary:
+        This function returns the index of the current draw buffer.
+
+    Description:
+        This function returns the index of the current draw buffer.
+        Draw buffer is the buffer where rendering is performed.
+        For systems with single buffer this function will always
+        return 0.
+
+*/
+// *****************************************************************************
+uint16_t __attribute__((weak)) GFX_DrawBufferGet(void)
+{
+    return (0);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_FrameBufferSet(uint16_t index)
+
+    Summary:
+        This function sets the frame buffer with the given index number.
+
+    Description:
+        This function sets the frame buffer with the given index number.
         This is the buffer that is displayed on the screen.
         For systems with single buffer, frame buffer and draw buffer are
         the same buffer. Calls to this function will have no effect and
@@ -7994,423 +13518,1523 @@ uint16_t __attribute__((weak)) GFX_DrawBufferGet(void)
 
 */
 // *****************************************************************************
-GFX_STATUS __attribute__((weak)) GFX_FrameBufferSet(uint16_t index)
+GFX_STATUS __attribute__((weak)) GFX_FrameBufferSet(uint16_t index)
+{
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    uint16_t GFX_FrameBufferGet(void)
+
+    Summary:
+        This function returns the index of the current frame buffer.
+
+    Description:
+        This function returns the index of the current frame buffer.
+        Frame buffer is the buffer that is currently displayed in the screen.
+        For systems with single buffer this function will always
+        return 0.
+
+*/
+// *****************************************************************************
+uint16_t __attribute__((weak)) GFX_FrameBufferGet(void)
+{
+    return (0);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_DoubleBufferEnable(void)
+
+    Summary:
+        This function enables the double buffering feature of the graphics
+        library.
+
+    Description:
+
+        Double buffering is a feature where two buffers are utilized to
+        perform rendering on one buffer while displaying the other buffer.
+        The frame buffer is the buffer that is being displayed while the
+        draw buffer is used for rendering.
+
+        When this function is called, the buffer with index number 0 is
+        set as the draw buffer while the buffer with index number 1 is
+        set as the frame buffer. Synchronization of the two buffers is
+        scheduled and sets the count of unsynchronized areas to zero.
+
+*/
+// *****************************************************************************
+GFX_STATUS __attribute__ ((weak)) GFX_DoubleBufferEnable(void)
+{
+    if (GFX_DoubleBufferStatusGet() == GFX_FEATURE_DISABLED)
+    {
+        // set the default draw and frame buffers
+        // default are:
+        //  index 0 - frame buffer
+        //  index 1 - draw buffer
+        GFX_FrameBufferSet(0);
+        GFX_DrawBufferSet(1);
+
+        // set the area count to zero
+        GFX_DoubleBufferSyncAreaCountSet(0);
+
+        // enable the feature
+        gfxDoubleBufferParam.gfxDoubleBufferFeature = GFX_FEATURE_ENABLED;
+        
+        // make sure the two buffers are synchronized 
+        // after this function exits.
+        GFX_DoubleBufferSynchronize();
+    }
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_DoubleBufferDisable(void)
+
+    Summary:
+        This function disables the double buffering feature of the graphics
+        library.
+
+    Description:
+        Double buffering is a feature where two buffers are utilized to
+        perform rendering on one buffer while displaying the other buffer.
+        The frame buffer is the buffer that is being displayed while the
+        draw buffer is used for rendering.
+
+        When this function is called, synchronization of the frame buffer
+        and the draw buffer is performed then draw buffer is set to the
+        frame buffer index. After this function is called, the frame buffer
+        and the draw buffer are the same.
+   
+*/
+// *****************************************************************************
+inline GFX_STATUS __attribute__ ((always_inline)) GFX_DoubleBufferDisable(void)
+{
+    if (GFX_DoubleBufferStatusGet() == GFX_FEATURE_ENABLED)
+    {
+        GFX_DoubleBufferSynchronize();
+
+        // set the draw and frame buffer to be the same
+        GFX_DrawBufferSet(GFX_FrameBufferGet());
+        GFX_DRV_DoubleBufferDisable();
+
+        // set the area count to zero
+        GFX_DoubleBufferSyncAreaCountSet(0);
+
+        // disable the feature
+        gfxDoubleBufferParam.gfxDoubleBufferFeature = GFX_FEATURE_DISABLED;
+    }
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_FEATURE_STATUS GFX_DoubleBufferStatusGet(void)
+
+    Summary:
+        This function returns the status of the double buffering feature
+        of the graphics library if enabled or not.
+
+    Description:
+        This function returns the status of the double buffering feature
+        of the graphics library if enabled or not.
+
+*/
+// *****************************************************************************
+inline GFX_FEATURE_STATUS __attribute__ ((always_inline)) GFX_DoubleBufferStatusGet(void)
+{
+    return (gfxDoubleBufferParam.gfxDoubleBufferFeature);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_DoubleBufferSynchronize(void)
+
+    Summary:
+        This function synchronizes the contents of the draw and
+        frame buffer immediately.
+
+    Description:
+        This function synchronizes the contents of the draw and
+        frame buffer immediately. Contents of both frame and draw
+        buffer will be the same after the function exits.
+
+*/
+// *****************************************************************************
+GFX_STATUS __attribute__ ((weak)) GFX_DoubleBufferSynchronize(void)
+{
+    // synchronization will be performed immediately.
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_DoubleBufferSynchronizeRequest(void)
+
+    Summary:
+        This function requests synchronization of the contents
+        of the draw and frame buffer.
+
+    Description:
+        This function requests synchronization of the contents
+        of the draw and frame buffer. The contents will be synchronized
+        on the next vertical blanking period.
+
+*/
+// *****************************************************************************
+GFX_STATUS __attribute__ ((weak)) GFX_DoubleBufferSynchronizeRequest(void)
+{
+    GFX_STATUS status = GFX_STATUS_SUCCESS;
+
+    if (GFX_DoubleBufferStatusGet() == GFX_FEATURE_ENABLED)
+    {
+        // schedule synchronization
+        GFX_DoubleBufferSynchronizeSet();
+    }
+    return (status);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_FEATURE_STATUS GFX_DoubleBufferSynchronizeStatusGet(void)
+
+    Summary:
+        This function returns the status of the synchronization request
+        of the draw and frame buffer.
+
+    Description:
+        This function returns the status of the synchronization request
+        of the draw and frame buffer.
+
+*/
+// *****************************************************************************
+inline GFX_FEATURE_STATUS __attribute__ ((always_inline)) GFX_DoubleBufferSynchronizeStatusGet(void)
+{
+    return (gfxDoubleBufferParam.gfxDoubleBufferRequestSync);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_DoubleBufferSynchronizeCancel(void)
+
+    Summary:
+        This function cancels the request for synchronization of the contents
+        of the draw and frame buffer.
+
+    Description:
+        This function cancels the requests synchronization of the contents
+        of the draw and frame buffer. The contents will be synchronized
+        on the next vertical blanking period.
+
+*/
+// *****************************************************************************
+inline GFX_STATUS __attribute__ ((always_inline)) GFX_DoubleBufferSynchronizeCancel(void)
+{
+    gfxDoubleBufferParam.gfxDoubleBufferRequestSync = GFX_FEATURE_DISABLED;
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_DoubleBufferSynchronizeSet(void)
+
+    Summary:
+        This function sets the synchronization request flag.
+
+    Description:
+        This function sets the synchronization request flag.
+        This function is internal to the library and should not be
+        called by the application.
+
+*/
+// *****************************************************************************
+inline GFX_STATUS __attribute__ ((always_inline)) GFX_DoubleBufferSynchronizeSet(void)
+{
+    gfxDoubleBufferParam.gfxDoubleBufferRequestSync = GFX_FEATURE_ENABLED;
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    uint16_t GFX_DoubleBufferSyncAreaCountGet(void)
+
+    Summary:
+        This function returns the current count of rectangular areas
+        that needs to be synchronized.
+
+    Description:
+        This function returns the current count of rectangular areas
+        that needs to be synchronized. 
+
+*/
+// *****************************************************************************
+inline uint16_t __attribute__ ((always_inline)) GFX_DoubleBufferSyncAreaCountGet(void)
+{
+    return (gfxDoubleBufferParam.gfxUnsyncedAreaCount);
+}
+
+// *****************************************************************************
+/*  Function:
+    void GFX_DoubleBufferSyncAreaCountSet(uint16_t count)
+
+    Summary:
+        This function sets the current count of rectangular areas
+        that needs to be synchronized.
+
+    Description:
+        This function sts the current count of rectangular areas
+        that needs to be synchronized.
+
+*/
+// *****************************************************************************
+inline void __attribute__ ((always_inline)) GFX_DoubleBufferSyncAreaCountSet(uint16_t count)
+{
+    gfxDoubleBufferParam.gfxUnsyncedAreaCount = count;
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_DoubleBufferSyncAllStatusSet(void)
+
+    Summary:
+        This function sets the whole draw buffer to be unsynchronized.
+
+    Description:
+        This function sets the whole draw buffer to be unsynchronized.
+        The next synchronization will copy all pixels of the
+        draw buffer to the frame buffer.
+
+*/
+// *****************************************************************************
+inline GFX_STATUS __attribute__ ((always_inline)) GFX_DoubleBufferSyncAllStatusSet(void)
+{
+    gfxDoubleBufferParam.gfxDoubleBufferFullSync = GFX_FEATURE_ENABLED;
+    GFX_DoubleBufferSynchronizeRequest();
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_DoubleBufferSyncAllStatusClear(void)
+
+    Summary:
+        This function clears the synchronize all status.
+
+    Description:
+        This function clears the synchronize all status.
+
+*/
+// *****************************************************************************
+inline GFX_STATUS __attribute__ ((always_inline)) GFX_DoubleBufferSyncAllStatusClear(void)
+{
+    gfxDoubleBufferParam.gfxDoubleBufferFullSync = GFX_FEATURE_DISABLED;
+    GFX_DoubleBufferSynchronizeCancel();
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_FEATURE_STATUS GFX_DoubleBufferSyncAllStatusGet(void)
+
+    Summary:
+        This function returns the status of the synchronize all flag.
+
+    Description:
+        This function returns the status of the synchronize all flag.
+
+*/
+// *****************************************************************************
+inline GFX_FEATURE_STATUS __attribute__ ((always_inline)) GFX_DoubleBufferSyncAllStatusGet(void)
+{
+    return (gfxDoubleBufferParam.gfxDoubleBufferFullSync);
+}
+
+// *****************************************************************************
+/*  Function:
+    uint32_t GFX_DoubleBufferAreaCostGet(
+                                uint16_t left,
+                                uint16_t top,
+                                uint16_t right,
+                                uint16_t bottom)
+
+    Summary:
+        This function returns the cost of synchronizing the given
+        rectangular area.
+
+    Description:
+        This function returns the cost of synchronizing the given
+        rectangular area. The cost is the number of pixels copied plus
+        GFX_INVALIDATE_AREA_COST for the setup of the copy.
+
+*/
+// *****************************************************************************
+static uint32_t GFX_DoubleBufferAreaCostGet(
+                                uint16_t left,
+                                uint16_t top,
+                                uint16_t right,
+                                uint16_t bottom)
+{
+    return (((uint32_t)(right - left + 1) * (uint32_t)(bottom - top + 1)) +
+            GFX_INVALIDATE_AREA_COST);
+}
+
+// *****************************************************************************
+/*  Function:
+    void GFX_DoubleBufferAreaMark(
+                                uint16_t left,
+                                uint16_t top,
+                                uint16_t right,
+                                uint16_t bottom)
+
+    Summary:
+        This function adds the given rectangular area as an area that
+        will be included in the list of areas for synchronization.
+
+    Description:
+        This function adds the given rectangular area into the list of
+        rectangular areas for synchronization. When this function is called,
+        the given rectangular area is assumed to contain new pixel information
+        and is added into the list to be synchronized.
+
+        The new area is merged with the areas already in the list when
+        copying their bounding rectangle costs no more than copying
+        the areas separately (see GFX_DoubleBufferAreaCostGet()). This
+        merges overlapping and adjacent areas. When the list is full,
+        the new area is merged with the area that adds the least cost.
+        Full frame synchronization is scheduled only when it costs no
+        more than copying the areas in the list.
+
+        Synchronization can be scheduled using the
+        GFX_DoubleBufferSynchronizeRequest() or immediately performed
+        using GFX_DoubleBufferSynchronize().
+
+*/
+// *****************************************************************************
+void __attribute__ ((weak)) GFX_DoubleBufferAreaMark(
+                                uint16_t left,
+                                uint16_t top,
+                                uint16_t right,
+                                uint16_t bottom)
+{
+    GFX_RECTANGULAR_AREA    *pArea;
+    uint16_t                count, index, best;
+    uint16_t                unionLeft, unionTop, unionRight, unionBottom;
+    uint32_t                cost, unionCost, addedCost, bestCost;
+
+    if ((GFX_DoubleBufferSyncAllStatusGet() == GFX_FEATURE_ENABLED) ||
+        (GFX_DoubleBufferStatusGet()        == GFX_FEATURE_DISABLED)
+       )
+    {
+        // double buffering feature is disabled, or full synchronization
+        // is scheduled already, don't do anything.
+        return;
+    }
+
+    count = gfxDoubleBufferParam.gfxUnsyncedAreaCount;
+
+    while(1)
+    {
+        // merge the new area with every area in the list that is
+        // cheaper to copy together with the new area than separately.
+        // Start over after each merge since the bigger area may now
+        // merge with areas checked before.
+        cost  = GFX_DoubleBufferAreaCostGet(left, top, right, bottom);
+        index = 0;
+        while(index < count)
+        {
+            pArea = &(gfxDoubleBufferParam.gfxDoubleBufferAreas[index]);
+
+            unionLeft   = (pArea->left   < left)   ? pArea->left   : left;
+            unionTop    = (pArea->top    < top)    ? pArea->top    : top;
+            unionRight  = (pArea->right  > right)  ? pArea->right  : right;
+            unionBottom = (pArea->bottom > bottom) ? pArea->bottom : bottom;
+
+            unionCost = GFX_DoubleBufferAreaCostGet(
+                                unionLeft, unionTop, unionRight, unionBottom);
+
+            if (unionCost <= cost +
+                    GFX_DoubleBufferAreaCostGet(
+                                pArea->left, pArea->top,
+                                pArea->right, pArea->bottom))
+            {
+                // the merged area replaces the new area, remove the
+                // old one from the list
+                left   = unionLeft;
+                top    = unionTop;
+                right  = unionRight;
+                bottom = unionBottom;
+                cost   = unionCost;
+
+                count--;
+                *pArea = gfxDoubleBufferParam.gfxDoubleBufferAreas[count];
+                index  = 0;
+            }
+            else
+            {
+                index++;
+            }
+        }
+
+        if (count < GFX_MAX_INVALIDATE_AREAS)
+            break;
+
+        // the list is full, merge the new area with the area that adds
+        // the least pixels to copy
+        best     = 0;
+        bestCost = 0xFFFFFFFF;
+        for(index = 0; index < count; index++)
+        {
+            pArea = &(gfxDoubleBufferParam.gfxDoubleBufferAreas[index]);
+
+            unionLeft   = (pArea->left   < left)   ? pArea->left   : left;
+            unionTop    = (pArea->top    < top)    ? pArea->top    : top;
+            unionRight  = (pArea->right  > right)  ? pArea->right  : right;
+            unionBottom = (pArea->bottom > bottom) ? pArea->bottom : bottom;
+
+            addedCost = GFX_DoubleBufferAreaCostGet(
+                                unionLeft, unionTop, unionRight, unionBottom) -
+                        GFX_DoubleBufferAreaCostGet(
+                                pArea->left, pArea->top,
+                                pArea->right, pArea->bottom);
+
+            if (addedCost < bestCost)
+            {
+                bestCost = addedCost;
+                best     = index;
+            }
+        }
+
+        pArea = &(gfxDoubleBufferParam.gfxDoubleBufferAreas[best]);
+
+        if (pArea->left   < left)   left   = pArea->left;
+        if (pArea->top    < top)    top    = pArea->top;
+        if (pArea->right  > right)  right  = pArea->right;
+        if (pArea->bottom > bottom) bottom = pArea->bottom;
+
+        count--;
+        *pArea = gfxDoubleBufferParam.gfxDoubleBufferAreas[count];
+    }
+
+    pArea = &(gfxDoubleBufferParam.gfxDoubleBufferAreas[count]);
+    pArea->left   = left;
+    pArea->top    = top;
+    pArea->right  = right;
+    pArea->bottom = bottom;
+    count++;
+
+    gfxDoubleBufferParam.gfxUnsyncedAreaCount = count;
+
+    // schedule a full frame synchronization when it is not more
+    // expensive than copying the areas
+    cost = 0;
+    for(index = 0; index < count; index++)
+    {
+        pArea = &(gfxDoubleBufferParam.gfxDoubleBufferAreas[index]);
+        cost += GFX_DoubleBufferAreaCostGet(
+                                pArea->left, pArea->top,
+                                pArea->right, pArea->bottom);
+    }
+
+    if (cost >= GFX_DoubleBufferAreaCostGet(
+                                0, 0, GFX_MaxXGet(), GFX_MaxYGet()))
+    {
+        GFX_DoubleBufferSyncAllStatusSet();
+    }
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_RECTANGULAR_AREA GFX_DoubleBufferAreaGet(uint16_t index)
+
+    Summary:
+        This function returns rectangular area position on the
+        draw buffer.
+
+    Description:
+        This function returns rectangular area position on the
+        draw buffer. The index ranges from 1 to
+        GFX_DoubleBufferSyncAreaCountGet().
+
+*/
+// *****************************************************************************
+GFX_RECTANGULAR_AREA __attribute__ ((weak)) *GFX_DoubleBufferAreaGet(
+                                uint16_t count)
 {
-    return (GFX_STATUS_SUCCESS);
+    return (&(gfxDoubleBufferParam.gfxDoubleBufferAreas[count - 1]));
 }
 
+#endif // #ifndef GFX_CONFIG_DOUBLE_BUFFERING_DISABLE
+
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+
 // *****************************************************************************
 /*  Function:
-    uint16_t GFX_FrameBufferGet(void)
+    void GFX_DisplayListBegin(void)
 
     Summary:
-        This function returns the index of the current frame buffer.
+        Starts recording the bars and images into the display list.
 
     Description:
-        This function returns the index of the current frame buffer.
-        Frame buffer is the buffer that is currently displayed in the screen.
-        For systems with single buffer this function will always
-        return 0.
+        Starts recording the bars and images into the display list.
+        Calls can be nested, the recorded commands are drawn when
+        the outermost GFX_DisplayListEnd() is called.
 
 */
 // *****************************************************************************
-uint16_t __attribute__((weak)) GFX_FrameBufferGet(void)
+void GFX_DisplayListBegin(void)
 {
-    return (0);
+    gfxDisplayListNesting++;
 }
 
 // *****************************************************************************
 /*  Function:
-    GFX_STATUS GFX_DoubleBufferEnable(void)
+    GFX_STATUS GFX_DisplayListEnd(void)
 
     Summary:
-        This function enables the double buffering feature of the graphics
-        library.
+        Stops recording and draws the recorded commands.
 
     Description:
+        Stops recording and draws the recorded commands. When calls
+        to GFX_DisplayListBegin() are nested, the commands are kept
+        until the outermost GFX_DisplayListEnd() is called.
 
-        Double buffering is a feature where two buffers are utilized to
-        perform rendering on one buffer while displaying the other buffer.
-        The frame buffer is the buffer that is being displayed while the
-        draw buffer is used for rendering.
+*/
+// *****************************************************************************
+GFX_STATUS GFX_DisplayListEnd(void)
+{
+    if (gfxDisplayListNesting > 0)
+        gfxDisplayListNesting--;
 
-        When this function is called, the buffer with index number 0 is
-        set as the draw buffer while the buffer with index number 1 is
-        set as the frame buffer. Synchronization of the two buffers is
-        scheduled and sets the count of unsynchronized areas to zero.
+    if (gfxDisplayListNesting == 0)
+        return (GFX_DisplayListFlush());
+
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_DisplayListFlush(void)
+
+    Summary:
+        Draws the recorded commands and empties the display list.
+
+    Description:
+        Draws the recorded commands in the order they were recorded
+        and empties the display list. Recording continues if it
+        was started. The current color, fill style, transparent
+        color and image rendering settings are restored when the
+        commands are drawn.
+
+        The bars and images are limited to the clip rectangle when
+        they are recorded. Each command is drawn with the clip
+        rectangle set to its recorded area, so a list flushed inside
+        GFX_ClipPush() and GFX_ClipPop() (for example by an object
+        of GFX_GOL_ObjectListDraw() that is redrawn only in the
+        redrawn area) draws the commands recorded before the push
+        completely.
 
 */
 // *****************************************************************************
-GFX_STATUS __attribute__ ((weak)) GFX_DoubleBufferEnable(void)
+GFX_STATUS GFX_DisplayListFlush(void)
 {
-    if (GFX_DoubleBufferStatusGet() == GFX_FEATURE_DISABLED)
+    GFX_DISPLAY_LIST_COMMAND    *pCommand;
+    GFX_IMAGE_LINE_CALLBACK     callback;
+    GFX_COLOR                   color, transparentColor;
+    GFX_FILL_STYLE              fillStyle;
+    GFX_FEATURE_STATUS          transparentStatus;
+    uint16_t                    renderDisable, i;
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+    GFX_RECTANGULAR_AREA        clip;
+#endif
+
+    if ((gfxDisplayListCount == 0) || (gfxDisplayListReplay != 0))
+        return (GFX_STATUS_SUCCESS);
+
+    // the commands are drawn with the settings they were recorded with
+    color = GFX_ColorGet();
+    fillStyle = GFX_FillStyleGet();
+    transparentStatus = GFX_TransparentColorStatusGet();
+    transparentColor = GFX_TransparentColorGet();
+    renderDisable = GFX_RenderToDisplayBufferDisableFlagGet();
+    callback = gfxImageLineCallback;
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+    clip = *GFX_ClipGet();
+#endif
+
+    GFX_FillStyleSet(GFX_FILL_STYLE_COLOR);
+    GFX_TransparentColorDisable();
+    GFX_RenderToDisplayBufferEnable();
+    gfxImageLineCallback = NULL;
+
+    gfxDisplayListReplay = 1;
+    for(i = 0; i < gfxDisplayListCount; i++)
     {
-        // set the default draw and frame buffers
-        // default are:
-        //  index 0 - frame buffer
-        //  index 1 - draw buffer
-        GFX_FrameBufferSet(0);
-        GFX_DrawBufferSet(1);
+        pCommand = &gfxDisplayList[i];
+
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+        // the command is already clipped, the current clip rectangle
+        // can be smaller than the one it was recorded with
+        pGfxContext->clip.left   = pCommand->left;
+        pGfxContext->clip.top    = pCommand->top;
+        pGfxContext->clip.right  = pCommand->right;
+        pGfxContext->clip.bottom = pCommand->bottom;
+#endif
 
-        // set the area count to zero
-        GFX_DoubleBufferSyncAreaCountSet(0);
+        switch(pCommand->type)
+        {
+            case GFX_DISPLAY_LIST_BAR:
+                GFX_ColorSet(pCommand->color);
+                while(GFX_BarDraw(  pCommand->left,
+                                    pCommand->top,
+                                    pCommand->right,
+                                    pCommand->bottom) != GFX_STATUS_SUCCESS);
+                break;
 
-        // enable the feature
-        gfxDoubleBufferParam.gfxDoubleBufferFeature = GFX_FEATURE_ENABLED;
-        
-        // make sure the two buffers are synchronized 
-        // after this function exits.
-        GFX_DoubleBufferSynchronize();
+            case GFX_DISPLAY_LIST_IMAGE:
+                while(GFX_ImagePartialDraw( pCommand->left,
+                                            pCommand->top,
+                                            pCommand->xOffset,
+                                            pCommand->yOffset,
+                                            pCommand->width,
+                                            pCommand->height,
+                                            pCommand->pImage) != GFX_STATUS_SUCCESS);
+                break;
+
+            default:
+                break;
+        }
     }
+    gfxDisplayListReplay = 0;
+    gfxDisplayListCount = 0;
+
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+    pGfxContext->clip = clip;
+#endif
+    GFX_ColorSet(color);
+    GFX_FillStyleSet(fillStyle);
+    if (transparentStatus == GFX_FEATURE_ENABLED)
+        GFX_TransparentColorEnable(transparentColor);
+    if (renderDisable)
+        GFX_RenderToDisplayBufferDisable();
+    gfxImageLineCallback = callback;
+
     return (GFX_STATUS_SUCCESS);
 }
 
 // *****************************************************************************
 /*  Function:
-    GFX_STATUS GFX_DoubleBufferDisable(void)
+    void GFX_DisplayListCommandAdd(
+                                GFX_DISPLAY_LIST_COMMAND *pCommand)
 
     Summary:
-        This function disables the double buffering feature of the graphics
-        library.
+        This function is an internal function and should not
+        be called by the application.
 
     Description:
-        Double buffering is a feature where two buffers are utilized to
-        perform rendering on one buffer while displaying the other buffer.
-        The frame buffer is the buffer that is being displayed while the
-        draw buffer is used for rendering.
+        Appends the command to the display list. The recorded
+        commands hidden by the new command are removed and a bar
+        that extends the last recorded bar of the same color into
+        a larger rectangle is merged with it. The list is drawn
+        first when it is full.
 
-        When this function is called, synchronization of the frame buffer
-        and the draw buffer is performed then draw buffer is set to the
-        frame buffer index. After this function is called, the frame buffer
-        and the draw buffer are the same.
-   
 */
 // *****************************************************************************
-inline GFX_STATUS __attribute__ ((always_inline)) GFX_DoubleBufferDisable(void)
+static void GFX_DisplayListCommandAdd(
+                                GFX_DISPLAY_LIST_COMMAND *pCommand)
 {
-    if (GFX_DoubleBufferStatusGet() == GFX_FEATURE_ENABLED)
+    GFX_DISPLAY_LIST_COMMAND    *pRecorded;
+    uint16_t                    i, count;
+
+    while(1)
     {
-        GFX_DoubleBufferSynchronize();
+        // remove the commands that the new command hides
+        if (pCommand->cover)
+        {
+            count = 0;
+            for(i = 0; i < gfxDisplayListCount; i++)
+            {
+                pRecorded = &gfxDisplayList[i];
 
-        // set the draw and frame buffer to be the same
-        GFX_DrawBufferSet(GFX_FrameBufferGet());
-        GFX_DRV_DoubleBufferDisable();
+                if ((pRecorded->left   >= pCommand->left)  &&
+                    (pRecorded->top    >= pCommand->top)   &&
+                    (pRecorded->right  <= pCommand->right) &&
+                    (pRecorded->bottom <= pCommand->bottom))
+                    continue;
 
-        // set the area count to zero
-        GFX_DoubleBufferSyncAreaCountSet(0);
+                if (count != i)
+                    gfxDisplayList[count] = *pRecorded;
+                count++;
+            }
+            gfxDisplayListCount = count;
+        }
 
-        // disable the feature
-        gfxDoubleBufferParam.gfxDoubleBufferFeature = GFX_FEATURE_DISABLED;
+        if ((pCommand->type != GFX_DISPLAY_LIST_BAR) || (gfxDisplayListCount == 0))
+            break;
+
+        // the last bar is drawn again as part of the merged bar, nothing
+        // recorded after it is left that could overlap it
+        pRecorded = &gfxDisplayList[gfxDisplayListCount - 1];
+        if ((pRecorded->type != GFX_DISPLAY_LIST_BAR) ||
+            (pRecorded->color != pCommand->color))
+            break;
+
+        if ((pRecorded->top == pCommand->top) &&
+            (pRecorded->bottom == pCommand->bottom) &&
+            (pCommand->left <= pRecorded->right + 1) &&
+            (pRecorded->left <= pCommand->right + 1))
+        {
+            if (pRecorded->left < pCommand->left)
+                pCommand->left = pRecorded->left;
+            if (pRecorded->right > pCommand->right)
+                pCommand->right = pRecorded->right;
+        }
+        else if ((pRecorded->left == pCommand->left) &&
+            (pRecorded->right == pCommand->right) &&
+            (pCommand->top <= pRecorded->bottom + 1) &&
+            (pRecorded->top <= pCommand->bottom + 1))
+        {
+            if (pRecorded->top < pCommand->top)
+                pCommand->top = pRecorded->top;
+            if (pRecorded->bottom > pCommand->bottom)
+                pCommand->bottom = pRecorded->bottom;
+        }
+        else
+        {
+            break;
+        }
+
+        // the merged bar can hide more of the recorded commands
+        gfxDisplayListCount--;
+    }
+
+    if (gfxDisplayListCount == GFX_CONFIG_DISPLAY_LIST_SIZE)
+        GFX_DisplayListFlush();
+
+    gfxDisplayList[gfxDisplayListCount++] = *pCommand;
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_DisplayListBarAdd(
+                                uint16_t left,
+                                uint16_t top,
+                                uint16_t right,
+                                uint16_t bottom)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Records the bar in the display list. GFX_STATUS_SUCCESS is
+        returned when the bar is recorded. GFX_STATUS_FAILURE is
+        returned when the display list is not recording or the bar
+        cannot be recorded, the caller then draws the bar. In the
+        latter case the recorded commands are drawn first.
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_DisplayListBarAdd(
+                                uint16_t left,
+                                uint16_t top,
+                                uint16_t right,
+                                uint16_t bottom)
+{
+    GFX_DISPLAY_LIST_COMMAND    command;
+
+    if ((gfxDisplayListNesting == 0) || (gfxDisplayListReplay != 0))
+        return (GFX_STATUS_FAILURE);
+
+#ifndef GFX_CONFIG_ALPHABLEND_DISABLE
+    // blended bars depend on what is drawn below them
+    if ((GFX_FillStyleGet() == GFX_FILL_STYLE_ALPHA_COLOR) &&
+        (GFX_AlphaBlendingValueGet() != 100))
+    {
+        GFX_DisplayListFlush();
+        return (GFX_STATUS_FAILURE);
+    }
+#endif
+
+    command.type   = GFX_DISPLAY_LIST_BAR;
+    command.cover  = 1;
+    command.left   = left;
+    command.top    = top;
+    command.right  = right;
+    command.bottom = bottom;
+    command.color  = GFX_ColorGet();
+
+    GFX_DisplayListCommandAdd(&command);
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_DisplayListImageAdd(
+                                uint16_t destination_x,
+                                uint16_t destination_y,
+                                uint16_t source_x_offset,
+                                uint16_t source_y_offset,
+                                uint16_t source_width,
+                                uint16_t source_height,
+                                GFX_RESOURCE_HDR *pImage)
+
+    Summary:
+        This function is an internal function and should not
+        be called by the application.
+
+    Description:
+        Records the image in the display list. Only the opaque
+        images decoded by the library are recorded, the recorded
+        commands are drawn first for the other images. Returns
+        GFX_STATUS_SUCCESS when the image is recorded.
+
+*/
+// *****************************************************************************
+static GFX_STATUS GFX_DisplayListImageAdd(
+                                uint16_t destination_x,
+                                uint16_t destination_y,
+                                uint16_t source_x_offset,
+                                uint16_t source_y_offset,
+                                uint16_t source_width,
+                                uint16_t source_height,
+                                GFX_RESOURCE_HDR *pImage)
+{
+    GFX_DISPLAY_LIST_COMMAND    command;
+
+    if ((gfxDisplayListNesting == 0) || (gfxDisplayListReplay != 0))
+        return (GFX_STATUS_FAILURE);
+
+    switch(pImage->type)
+    {
+#ifndef GFX_CONFIG_IMAGE_FLASH_DISABLE
+        case GFX_RESOURCE_MCHP_MBITMAP_FLASH_NONE:
+#ifndef GFX_CONFIG_RLE_DECODE_DISABLE
+        case GFX_RESOURCE_MCHP_MBITMAP_FLASH_RLE:
+#endif
+#endif
+#ifndef GFX_CONFIG_IMAGE_EXTERNAL_DISABLE
+        case GFX_RESOURCE_MCHP_MBITMAP_EXTERNAL_NONE:
+#ifndef GFX_CONFIG_RLE_DECODE_DISABLE
+        case GFX_RESOURCE_MCHP_MBITMAP_EXTERNAL_RLE:
+#endif
+#endif
+            if ((GFX_TransparentColorStatusGet() == GFX_FEATURE_DISABLED) &&
+                (GFX_RenderToDisplayBufferDisableFlagGet() == 0) &&
+                (gfxImageLineCallback == NULL))
+                break;
+
+            // fall through, the image is not drawn as recorded
+
+        default:
+            GFX_DisplayListFlush();
+            return (GFX_STATUS_FAILURE);
+    }
+
+    command.type    = GFX_DISPLAY_LIST_IMAGE;
+    command.pImage  = pImage;
+    command.xOffset = source_x_offset;
+    command.yOffset = source_y_offset;
+    command.width   = source_width;
+    command.height  = source_height;
+
+    // only a whole image is known to hide what is below it
+    command.cover = 0;
+    if (source_width == 0)
+    {
+        source_width = pImage->resource.image.width;
+        source_height = pImage->resource.image.height;
+
+        if ((source_x_offset == 0) && (source_y_offset == 0))
+            command.cover = 1;
     }
+
+    command.left   = destination_x;
+    command.top    = destination_y;
+    command.right  = destination_x + source_width - 1;
+    command.bottom = destination_y + source_height - 1;
+
+    GFX_DisplayListCommandAdd(&command);
     return (GFX_STATUS_SUCCESS);
 }
 
+#endif // #ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+
 // *****************************************************************************
 /*  Function:
-    GFX_FEATURE_STATUS GFX_DoubleBufferStatusGet(void)
+    GFX_STATUS GFX_SurfaceCreate(
+                                GFX_SURFACE *pSurface,
+                                GFX_COLOR *pBuffer,
+                                uint16_t width,
+                                uint16_t height)
 
     Summary:
-        This function returns the status of the double buffering feature
-        of the graphics library if enabled or not.
+        Initializes a RAM surface.
 
     Description:
-        This function returns the status of the double buffering feature
-        of the graphics library if enabled or not.
+        Initializes a surface whose pixels are stored row by row in
+        pBuffer. The buffer must hold width * height pixels. The lines
+        of a surface are rendered through gfxLineBuffer0, a surface
+        larger than the line buffer is not created.
 
 */
 // *****************************************************************************
-inline GFX_FEATURE_STATUS __attribute__ ((always_inline)) GFX_DoubleBufferStatusGet(void)
+GFX_STATUS GFX_SurfaceCreate(
+                                GFX_SURFACE *pSurface,
+                                GFX_COLOR *pBuffer,
+                                uint16_t width,
+                                uint16_t height)
 {
-    return (gfxDoubleBufferParam.gfxDoubleBufferFeature);
+    if ((pBuffer == NULL) || (width == 0) || (height == 0))
+        return (GFX_STATUS_FAILURE);
+
+    if ((width  > (sizeof(gfxLineBuffer0) / sizeof(GFX_COLOR))) ||
+        (height > (sizeof(gfxLineBuffer0) / sizeof(GFX_COLOR))))
+        return (GFX_STATUS_FAILURE);
+
+    pSurface->pBuffer = pBuffer;
+    pSurface->index   = 0;
+    pSurface->width   = width;
+    pSurface->height  = height;
+    return (GFX_STATUS_SUCCESS);
 }
 
 // *****************************************************************************
 /*  Function:
-    GFX_STATUS GFX_DoubleBufferSynchronize(void)
+    GFX_STATUS GFX_SurfaceDrawBufferCreate(
+                                GFX_SURFACE *pSurface,
+                                uint16_t index)
 
     Summary:
-        This function synchronizes the contents of the draw and
-        frame buffer immediately.
+        Initializes a surface on a draw buffer of the display driver.
 
     Description:
-        This function synchronizes the contents of the draw and
-        frame buffer immediately. Contents of both frame and draw
-        buffer will be the same after the function exits.
+        Initializes a surface on the draw buffer of the display driver
+        with the given index (see GFX_DrawBufferSet()). The surface has
+        the size of the screen.
 
 */
 // *****************************************************************************
-GFX_STATUS __attribute__ ((weak)) GFX_DoubleBufferSynchronize(void)
+GFX_STATUS GFX_SurfaceDrawBufferCreate(
+                                GFX_SURFACE *pSurface,
+                                uint16_t index)
 {
-    // synchronization will be performed immediately.
+    pSurface->pBuffer = NULL;
+    pSurface->index   = index;
+    pSurface->width   = GFX_MaxXGet() + 1;
+    pSurface->height  = GFX_MaxYGet() + 1;
     return (GFX_STATUS_SUCCESS);
 }
 
 // *****************************************************************************
 /*  Function:
-    GFX_STATUS GFX_DoubleBufferSynchronizeRequest(void)
+    GFX_STATUS GFX_SurfaceSet(GFX_SURFACE *pSurface)
 
     Summary:
-        This function requests synchronization of the contents
-        of the draw and frame buffer.
+        Sets the surface the primitives render to.
 
     Description:
-        This function requests synchronization of the contents
-        of the draw and frame buffer. The contents will be synchronized
-        on the next vertical blanking period.
+        Sets the target of the primitives of the active context. NULL
+        sets the display back as the target. The commands recorded in
+        the display list are drawn to the previous target first. The
+        draw buffer of the display is saved when a surface is set and
+        restored when the display is set back.
 
 */
 // *****************************************************************************
-GFX_STATUS __attribute__ ((weak)) GFX_DoubleBufferSynchronizeRequest(void)
+GFX_STATUS GFX_SurfaceSet(GFX_SURFACE *pSurface)
 {
-    GFX_STATUS status = GFX_STATUS_SUCCESS;
+    GFX_SURFACE *pCurrent = pGfxContext->pSurface;
+#ifndef GFX_CONFIG_DOUBLE_BUFFERING_DISABLE
+    uint16_t    drawBuffer;
+#endif
 
-    if (GFX_DoubleBufferStatusGet() == GFX_FEATURE_ENABLED)
+    if (pSurface == pCurrent)
+        return (GFX_STATUS_SUCCESS);
+
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // the recorded commands are drawn to the target they were recorded for
+    if (GFX_DisplayListFlush() == GFX_STATUS_FAILURE)
+        return (GFX_STATUS_FAILURE);
+#endif
+
+#ifndef GFX_CONFIG_DOUBLE_BUFFERING_DISABLE
+    if (pCurrent == NULL)
+        pGfxContext->surfaceDrawBuffer = GFX_DrawBufferGet();
+
+    // RAM surfaces are rendered by the primitive layer, the driver
+    // keeps the draw buffer of the display
+    if ((pSurface != NULL) && (pSurface->pBuffer == NULL))
+        drawBuffer = pSurface->index;
+    else
+        drawBuffer = pGfxContext->surfaceDrawBuffer;
+
+    if (drawBuffer != GFX_DrawBufferGet())
     {
-        // schedule synchronization
-        GFX_DoubleBufferSynchronizeSet();
+        if (GFX_DrawBufferSet(drawBuffer) == GFX_STATUS_FAILURE)
+            return (GFX_STATUS_FAILURE);
     }
-    return (status);
+#endif
+
+    pGfxContext->pSurface = pSurface;
+    return (GFX_STATUS_SUCCESS);
 }
 
 // *****************************************************************************
 /*  Function:
-    GFX_FEATURE_STATUS GFX_DoubleBufferSynchronizeStatusGet(void)
+    GFX_SURFACE *GFX_SurfaceGet(void)
 
     Summary:
-        This function returns the status of the synchronization request
-        of the draw and frame buffer.
+        Returns the surface the primitives render to.
 
     Description:
-        This function returns the status of the synchronization request
-        of the draw and frame buffer.
+        Returns the target of the primitives of the active context,
+        NULL when the primitives render to the display.
 
 */
 // *****************************************************************************
-inline GFX_FEATURE_STATUS __attribute__ ((always_inline)) GFX_DoubleBufferSynchronizeStatusGet(void)
+inline GFX_SURFACE * __attribute__ ((always_inline)) GFX_SurfaceGet(void)
 {
-    return (gfxDoubleBufferParam.gfxDoubleBufferRequestSync);
+    return (pGfxContext->pSurface);
 }
 
 // *****************************************************************************
 /*  Function:
-    GFX_STATUS GFX_DoubleBufferSynchronizeCancel(void)
+    GFX_FEATURE_STATUS GFX_SurfaceStatusGet(void)
 
     Summary:
-        This function cancels the request for synchronization of the contents
-        of the draw and frame buffer.
+        Returns GFX_FEATURE_ENABLED when the primitives render to a
+        RAM surface.
 
     Description:
-        This function cancels the requests synchronization of the contents
-        of the draw and frame buffer. The contents will be synchronized
-        on the next vertical blanking period.
+        The display drivers pass their pixel functions to the
+        GFX_SurfaceXXX() functions when a RAM surface is the target.
 
 */
 // *****************************************************************************
-inline GFX_STATUS __attribute__ ((always_inline)) GFX_DoubleBufferSynchronizeCancel(void)
+inline GFX_FEATURE_STATUS __attribute__ ((always_inline)) GFX_SurfaceStatusGet(void)
 {
-    gfxDoubleBufferParam.gfxDoubleBufferRequestSync = GFX_FEATURE_DISABLED;
-    return (GFX_STATUS_SUCCESS);
+    if ((pGfxContext->pSurface != NULL) && (pGfxContext->pSurface->pBuffer != NULL))
+        return (GFX_FEATURE_ENABLED);
+    return (GFX_FEATURE_DISABLED);
 }
 
 // *****************************************************************************
 /*  Function:
-    GFX_STATUS GFX_DoubleBufferSynchronizeSet(void)
+    GFX_STATUS GFX_SurfacePixelPut(uint16_t x, uint16_t y)
 
     Summary:
-        This function sets the synchronization request flag.
+        Renders a pixel of the current color to the RAM surface.
 
     Description:
-        This function sets the synchronization request flag.
-        This function is internal to the library and should not be
-        called by the application.
+        Renders a pixel of the current color to the RAM surface that
+        is the target of the primitives. Pixels outside the surface
+        are ignored.
 
 */
 // *****************************************************************************
-inline GFX_STATUS __attribute__ ((always_inline)) GFX_DoubleBufferSynchronizeSet(void)
+GFX_STATUS GFX_SurfacePixelPut(uint16_t x, uint16_t y)
 {
-    gfxDoubleBufferParam.gfxDoubleBufferRequestSync = GFX_FEATURE_ENABLED;
+    GFX_SURFACE *pSurface = pGfxContext->pSurface;
+
+    if ((x < pSurface->width) && (y < pSurface->height))
+        pSurface->pBuffer[((uint32_t)y * pSurface->width) + x] = GFX_ColorGet();
+
     return (GFX_STATUS_SUCCESS);
 }
 
 // *****************************************************************************
 /*  Function:
-    uint16_t GFX_DoubleBufferSyncAreaCountGet(void)
+    GFX_COLOR GFX_SurfacePixelGet(uint16_t x, uint16_t y)
 
     Summary:
-        This function returns the current count of rectangular areas
-        that needs to be synchronized.
+        Returns a pixel of the RAM surface.
 
     Description:
-        This function returns the current count of rectangular areas
-        that needs to be synchronized. 
+        Returns the pixel of the RAM surface that is the target of the
+        primitives. Pixels outside the surface return 0.
 
 */
 // *****************************************************************************
-inline uint16_t __attribute__ ((always_inline)) GFX_DoubleBufferSyncAreaCountGet(void)
+GFX_COLOR GFX_SurfacePixelGet(uint16_t x, uint16_t y)
 {
-    return (gfxDoubleBufferParam.gfxUnsyncedAreaCount);
+    GFX_SURFACE *pSurface = pGfxContext->pSurface;
+
+    if ((x < pSurface->width) && (y < pSurface->height))
+        return (pSurface->pBuffer[((uint32_t)y * pSurface->width) + x]);
+
+    return (0);
 }
 
 // *****************************************************************************
 /*  Function:
-    void GFX_DoubleBufferSyncAreaCountSet(uint16_t count)
+    uint16_t GFX_SurfacePixelArrayPut(
+                                uint16_t x,
+                                uint16_t y,
+                                GFX_COLOR *pPixel,
+                                uint16_t numPixels)
 
     Summary:
-        This function sets the current count of rectangular areas
-        that needs to be synchronized.
+        Renders an array of pixels to a row of the RAM surface.
 
     Description:
-        This function sts the current count of rectangular areas
-        that needs to be synchronized.
+        Renders an array of pixels to the RAM surface that is the
+        target of the primitives. Pixels past the end of the row are
+        dropped. The pixels with the transparent color are skipped
+        when the transparent color is enabled. Returns the number of
+        pixels in the surface.
 
 */
 // *****************************************************************************
-inline void __attribute__ ((always_inline)) GFX_DoubleBufferSyncAreaCountSet(uint16_t count)
+uint16_t GFX_SurfacePixelArrayPut(
+                                uint16_t x,
+                                uint16_t y,
+                                GFX_COLOR *pPixel,
+                                uint16_t numPixels)
 {
-    gfxDoubleBufferParam.gfxUnsyncedAreaCount = count;
+    GFX_SURFACE *pSurface = pGfxContext->pSurface;
+    GFX_COLOR   *pDest;
+    uint16_t    count, z;
+
+    if ((x >= pSurface->width) || (y >= pSurface->height))
+        return (0);
+
+    count = numPixels;
+    if (count > pSurface->width - x)
+        count = pSurface->width - x;
+
+    pDest = &pSurface->pBuffer[((uint32_t)y * pSurface->width) + x];
+
+#ifndef GFX_CONFIG_TRANSPARENT_COLOR_DISABLE
+    if (GFX_TransparentColorStatusGet() == GFX_FEATURE_ENABLED)
+    {
+        GFX_COLOR   transparentColor = GFX_TransparentColorGet();
+
+        for (z = 0; z < count; z++)
+        {
+            if (pPixel[z] != transparentColor)
+                pDest[z] = pPixel[z];
+        }
+        return (count);
+    }
+#endif
+
+    for (z = 0; z < count; z++)
+        pDest[z] = pPixel[z];
+    return (count);
 }
 
 // *****************************************************************************
 /*  Function:
-    GFX_STATUS GFX_DoubleBufferSyncAllStatusSet(void)
+    uint16_t GFX_SurfacePixelArrayGet(
+                                uint16_t x,
+                                uint16_t y,
+                                GFX_COLOR *pPixel,
+                                uint16_t numPixels)
 
     Summary:
-        This function sets the whole draw buffer to be unsynchronized.
+        Reads an array of pixels from a row of the RAM surface.
 
     Description:
-        This function sets the whole draw buffer to be unsynchronized.
-        The next synchronization will copy all pixels of the
-        draw buffer to the frame buffer.
+        Reads an array of pixels from the RAM surface that is the
+        target of the primitives. Returns the number of pixels read,
+        the pixels past the end of the row are not read.
 
 */
 // *****************************************************************************
-inline GFX_STATUS __attribute__ ((always_inline)) GFX_DoubleBufferSyncAllStatusSet(void)
+uint16_t GFX_SurfacePixelArrayGet(
+                                uint16_t x,
+                                uint16_t y,
+                                GFX_COLOR *pPixel,
+                                uint16_t numPixels)
 {
-    gfxDoubleBufferParam.gfxDoubleBufferFullSync = GFX_FEATURE_ENABLED;
-    GFX_DoubleBufferSynchronizeRequest();
-    return (GFX_STATUS_SUCCESS);
+    GFX_SURFACE *pSurface = pGfxContext->pSurface;
+    GFX_COLOR   *pSource;
+    uint16_t    count, z;
+
+    if ((x >= pSurface->width) || (y >= pSurface->height))
+        return (0);
+
+    count = numPixels;
+    if (count > pSurface->width - x)
+        count = pSurface->width - x;
+
+    pSource = &pSurface->pBuffer[((uint32_t)y * pSurface->width) + x];
+    for (z = 0; z < count; z++)
+        pPixel[z] = pSource[z];
+    return (count);
 }
 
 // *****************************************************************************
 /*  Function:
-    GFX_STATUS GFX_DoubleBufferSyncAllStatusClear(void)
+    GFX_STATUS GFX_SurfaceBarDraw(
+                                uint16_t left,
+                                uint16_t top,
+                                uint16_t right,
+                                uint16_t bottom)
 
     Summary:
-        This function clears the synchronize all status.
+        Fills a bar of the RAM surface with the current color.
 
     Description:
-        This function clears the synchronize all status.
+        Fills the part of the bar inside the RAM surface that is the
+        target of the primitives with the current color.
 
 */
 // *****************************************************************************
-inline GFX_STATUS __attribute__ ((always_inline)) GFX_DoubleBufferSyncAllStatusClear(void)
+GFX_STATUS GFX_SurfaceBarDraw(
+                                uint16_t left,
+                                uint16_t top,
+                                uint16_t right,
+                                uint16_t bottom)
 {
-    gfxDoubleBufferParam.gfxDoubleBufferFullSync = GFX_FEATURE_DISABLED;
-    GFX_DoubleBufferSynchronizeCancel();
+    GFX_SURFACE *pSurface = pGfxContext->pSurface;
+    GFX_COLOR   color = GFX_ColorGet(), *pDest;
+    uint16_t    x, y, width;
+
+    if (right >= pSurface->width)
+        right = pSurface->width - 1;
+    if (bottom >= pSurface->height)
+        bottom = pSurface->height - 1;
+    if ((left > right) || (top > bottom))
+        return (GFX_STATUS_SUCCESS);
+
+    width = right - left + 1;
+    for (y = top; y <= bottom; y++)
+    {
+        pDest = &pSurface->pBuffer[((uint32_t)y * pSurface->width) + left];
+        for (x = 0; x < width; x++)
+            pDest[x] = color;
+    }
     return (GFX_STATUS_SUCCESS);
 }
 
 // *****************************************************************************
 /*  Function:
-    GFX_FEATURE_STATUS GFX_DoubleBufferSyncAllStatusGet(void)
+    GFX_COLOR *GFX_SurfaceRowGet(
+                                GFX_SURFACE *pSurface,
+                                uint16_t x,
+                                uint16_t y,
+                                uint16_t width)
 
     Summary:
-        This function returns the status of the synchronize all flag.
+        This function is an internal function and should not
+        be called by the application.
 
     Description:
-        This function returns the status of the synchronize all flag.
+        Returns width pixels of the row y of the surface starting at
+        x. The rows of a RAM surface are used in place, the rows of a
+        draw buffer of the driver are read into gfxSurfaceLineBuffer.
 
 */
 // *****************************************************************************
-inline GFX_FEATURE_STATUS __attribute__ ((always_inline)) GFX_DoubleBufferSyncAllStatusGet(void)
+static GFX_COLOR *GFX_SurfaceRowGet(
+                                GFX_SURFACE *pSurface,
+                                uint16_t x,
+                                uint16_t y,
+                                uint16_t width)
 {
-    return (gfxDoubleBufferParam.gfxDoubleBufferFullSync);
+    GFX_SURFACE *pTarget;
+#ifndef GFX_CONFIG_DOUBLE_BUFFERING_DISABLE
+    uint16_t    drawBuffer;
+#endif
+
+    if (pSurface->pBuffer != NULL)
+        return (&pSurface->pBuffer[((uint32_t)y * pSurface->width) + x]);
+
+    // the driver reads its own draw buffer, not the target surface
+    pTarget = pGfxContext->pSurface;
+    pGfxContext->pSurface = NULL;
+
+#ifndef GFX_CONFIG_DOUBLE_BUFFERING_DISABLE
+    drawBuffer = GFX_DrawBufferGet();
+    GFX_DrawBufferSet(pSurface->index);
+    GFX_PixelArrayGet(x, y, gfxSurfaceLineBuffer, width);
+    GFX_DrawBufferSet(drawBuffer);
+#else
+    // the only buffer of the driver is the display
+    GFX_PixelArrayGet(x, y, gfxSurfaceLineBuffer, width);
+#endif
+
+    pGfxContext->pSurface = pTarget;
+    return (gfxSurfaceLineBuffer);
 }
 
 // *****************************************************************************
 /*  Function:
-    void GFX_DoubleBufferAreaMark(
+    GFX_STATUS GFX_SurfacePartialDraw(
                                 uint16_t left,
                                 uint16_t top,
-                                uint16_t right,
-                                uint16_t bottom)
+                                uint16_t xOffset,
+                                uint16_t yOffset,
+                                uint16_t width,
+                                uint16_t height,
+                                GFX_SURFACE *pSurface)
 
     Summary:
-        This function adds the given rectangular area as an area that
-        will be included in the list of areas for synchronization.
+        Draws a part of a surface to the current target.
 
     Description:
-        This function adds the given rectangular area into the list of
-        rectangular areas for synchronization. When this function is called,
-        the given rectangular area is assumed to contain new pixel information
-        and is added into the list to be synchronized.
-
-        Synchronization can be scheduled using the
-        GFX_DoubleBufferSynchronizeRequest() or immediately performed
-        using GFX_DoubleBufferSynchronize().
+        Copies the width x height pixels of the surface at xOffset,
+        yOffset to left, top of the current target (the display or
+        the surface set by GFX_SurfaceSet()) row by row. Pixels with
+        the transparent color are skipped when the transparent color
+        is enabled. When the fill style is GFX_FILL_STYLE_ALPHA_COLOR
+        the pixels are blended with the target using the alpha value
+        (see GFX_AlphaBlendingValueSet()).
 
 */
 // *****************************************************************************
-void __attribute__ ((weak)) GFX_DoubleBufferAreaMark(
+GFX_STATUS GFX_SurfacePartialDraw(
                                 uint16_t left,
                                 uint16_t top,
-                                uint16_t right,
-                                uint16_t bottom)
+                                uint16_t xOffset,
+                                uint16_t yOffset,
+                                uint16_t width,
+                                uint16_t height,
+                                GFX_SURFACE *pSurface)
 {
-    uint16_t count;
+    GFX_SURFACE *pTarget = pGfxContext->pSurface;
+    GFX_COLOR   *pRow;
+    uint16_t    right, bottom, maxX, maxY, x1, y1, y;
+#ifndef GFX_CONFIG_ALPHABLEND_DISABLE
+    uint16_t    alpha = 100, x;
+#endif
+#ifndef GFX_CONFIG_TRANSPARENT_COLOR_DISABLE
+    GFX_FEATURE_STATUS transparentStatus = GFX_TransparentColorStatusGet();
+    GFX_COLOR   transparentColor = GFX_TransparentColorGet();
+#endif
 
-    if ((GFX_DoubleBufferSyncAllStatusGet() == GFX_FEATURE_ENABLED) ||
-        (GFX_DoubleBufferStatusGet()        == GFX_FEATURE_DISABLED)
-       )
+    if ((xOffset >= pSurface->width) || (yOffset >= pSurface->height) ||
+        (width == 0) || (height == 0))
     {
-        // double buffering feature is disabled, or full synchronization
-        // is scheduled already, don't do anything.
-        return;
+        return (GFX_STATUS_SUCCESS);
     }
 
-    else if((gfxDoubleBufferParam.gfxUnsyncedAreaCount >= GFX_MAX_INVALIDATE_AREAS) ||
-            (gfxDoubleBufferParam.gfxDoubleBufferFullSync == GFX_FEATURE_ENABLED)
-           )
+    if (width > pSurface->width - xOffset)
+        width = pSurface->width - xOffset;
+    if (height > pSurface->height - yOffset)
+        height = pSurface->height - yOffset;
+
+    // only the part inside the target is drawn
+    if (pTarget != NULL)
     {
-        // full frame synchronization is requested or number of unsynchronized
-        // area reached the max size. Set the synchronization request
-        // flag.
-        GFX_DoubleBufferSyncAllStatusSet();
-        return;
+        maxX = pTarget->width - 1;
+        maxY = pTarget->height - 1;
     }
     else
     {
-        // update the count then get the area parameters
-        count = ++(gfxDoubleBufferParam.gfxUnsyncedAreaCount);
+        maxX = GFX_MaxXGet();
+        maxY = GFX_MaxYGet();
+    }
+
+    right  = left + width - 1;
+    bottom = top + height - 1;
+    if ((right < left) || (right > maxX))
+        right = maxX;
+    if ((bottom < top) || (bottom > maxY))
+        bottom = maxY;
+
+    x1 = left;
+    y1 = top;
+
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+    if (GFX_ClipAreaAdjust(&left, &top, &right, &bottom) == GFX_STATUS_FAILURE)
+        return (GFX_STATUS_SUCCESS);
+#endif
+
+    if ((left > right) || (top > bottom))
+        return (GFX_STATUS_SUCCESS);
+
+    // offsets of the first visible pixel
+    xOffset += left - x1;
+    yOffset += top - y1;
+    width = right - left + 1;
+
+#ifndef GFX_CONFIG_ALPHABLEND_DISABLE
+    if (GFX_FillStyleGet() == GFX_FILL_STYLE_ALPHA_COLOR)
+    {
+        alpha = GFX_AlphaBlendingValueGet();
+        if (alpha == 0)
+            return (GFX_STATUS_SUCCESS);
+    }
+#endif
+
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    // the recorded commands are drawn before the pixels are written
+    GFX_DisplayListFlush();
+#endif
+
+    for (y = top; y <= bottom; y++, yOffset++)
+    {
+        pRow = GFX_SurfaceRowGet(pSurface, xOffset, yOffset, width);
+
+#ifndef GFX_CONFIG_ALPHABLEND_DISABLE
+        if (alpha != 100)
+        {
+            // blend the row of the surface with the row of the target
+            GFX_PixelArrayGet(left, y, gfxLineBuffer0, width);
+            for (x = 0; x < width; x++)
+            {
+#ifndef GFX_CONFIG_TRANSPARENT_COLOR_DISABLE
+                if ((transparentStatus == GFX_FEATURE_ENABLED) && (pRow[x] == transparentColor))
+                    continue;
+#endif
+                GFX_AlphaLineBlend(&gfxLineBuffer0[x], pRow[x], alpha, 1);
+            }
+            pRow = gfxLineBuffer0;
 
-        gfxDoubleBufferParam.gfxDoubleBufferAreas[count].left   = left;
-        gfxDoubleBufferParam.gfxDoubleBufferAreas[count].top    = top;
-        gfxDoubleBufferParam.gfxDoubleBufferAreas[count].right  = right;
-        gfxDoubleBufferParam.gfxDoubleBufferAreas[count].bottom = bottom;
+#ifndef GFX_CONFIG_TRANSPARENT_COLOR_DISABLE
+            // the skipped pixels are the pixels of the target
+            GFX_TransparentColorDisable();
+            GFX_PixelArrayPut(left, y, pRow, width);
+            if (transparentStatus == GFX_FEATURE_ENABLED)
+                GFX_TransparentColorEnable(transparentColor);
+            continue;
+#endif
+        }
+#endif
+        GFX_PixelArrayPut(left, y, pRow, width);
     }
+
+    return (GFX_STATUS_SUCCESS);
 }
 
 // *****************************************************************************
 /*  Function:
-    GFX_RECTANGULAR_AREA GFX_DoubleBufferAreaGet(uint16_t index)
+    GFX_STATUS GFX_SurfaceDraw(
+                                uint16_t left,
+                                uint16_t top,
+                                GFX_SURFACE *pSurface)
 
     Summary:
-        This function returns rectangular area position on the
-        draw buffer.
+        Draws a surface to the current target.
 
     Description:
-        This function returns rectangular area position on the
-        draw buffer.
+        Draws the whole surface with its left, top corner at left,
+        top (see GFX_SurfacePartialDraw()).
 
 */
 // *****************************************************************************
-GFX_RECTANGULAR_AREA __attribute__ ((weak)) *GFX_DoubleBufferAreaGet(
-                                uint16_t count)
+GFX_STATUS GFX_SurfaceDraw(
+                                uint16_t left,
+                                uint16_t top,
+                                GFX_SURFACE *pSurface)
 {
-    return (&(gfxDoubleBufferParam.gfxDoubleBufferAreas[count]));
+    return (GFX_SurfacePartialDraw(
+                                left,
+                                top,
+                                0,
+                                0,
+                                pSurface->width,
+                                pSurface->height,
+                                pSurface));
 }
 
-#endif // #ifndef GFX_CONFIG_DOUBLE_BUFFERING_DISABLE
+#endif // #ifdef GFX_CONFIG_SURFACE_ENABLE
 
 // *****************************************************************************
 /*  Function:
@@ -8439,10 +15063,10 @@ void GFX_BackgroundSet(
                                 GFX_RESOURCE_HDR *pImage,
                                 GFX_COLOR color)
 {
-    gfxBackground.left   = left;
-    gfxBackground.top    = top;
-    gfxBackground.color  = color;
-    gfxBackground.pImage = pImage;
+    pGfxContext->background.left   = left;
+    pGfxContext->background.top    = top;
+    pGfxContext->background.color  = color;
+    pGfxContext->background.pImage = pImage;
 }
 
 // *****************************************************************************
@@ -8461,7 +15085,7 @@ void GFX_BackgroundSet(
 void __attribute__ ((always_inline)) GFX_BackgroundTypeSet(
                                 GFX_BACKGROUND_TYPE type)
 {
-    gfxBackground.type = type;
+    pGfxContext->background.type = type;
 }
 
 // *****************************************************************************
@@ -8478,7 +15102,7 @@ void __attribute__ ((always_inline)) GFX_BackgroundTypeSet(
 // *****************************************************************************
 GFX_BACKGROUND_TYPE __attribute__ ((always_inline)) GFX_BackgroundTypeGet(void)
 {
-    return (gfxBackground.type);
+    return (pGfxContext->background.type);
 }
 
 // *****************************************************************************
@@ -8496,7 +15120,7 @@ GFX_BACKGROUND_TYPE __attribute__ ((always_inline)) GFX_BackgroundTypeGet(void)
 // *****************************************************************************
 GFX_RESOURCE_HDR __attribute__ ((always_inline)) *GFX_BackgroundImageGet(void)
 {
-    return (gfxBackground.pImage);
+    return (pGfxContext->background.pImage);
 }
 
 // *****************************************************************************
@@ -8513,7 +15137,7 @@ GFX_RESOURCE_HDR __attribute__ ((always_inline)) *GFX_BackgroundImageGet(void)
 // *****************************************************************************
 GFX_COLOR __attribute__ ((always_inline)) GFX_BackgroundColorGet(void)
 {
-    return (gfxBackground.color);
+    return (pGfxContext->background.color);
 }
 
 // *****************************************************************************
@@ -8533,7 +15157,7 @@ GFX_COLOR __attribute__ ((always_inline)) GFX_BackgroundColorGet(void)
 // *****************************************************************************
 uint16_t __attribute__ ((always_inline)) GFX_BackgroundImageLeftGet(void)
 {
-    return (gfxBackground.left);
+    return (pGfxContext->background.left);
 }
 
 // *****************************************************************************
@@ -8553,7 +15177,7 @@ uint16_t __attribute__ ((always_inline)) GFX_BackgroundImageLeftGet(void)
 // *****************************************************************************
 uint16_t __attribute__ ((always_inline)) GFX_BackgroundImageTopGet(void)
 {
-    return (gfxBackground.top);
+    return (pGfxContext->background.top);
 }
 
 /* &&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&& */
@@ -8641,7 +15265,7 @@ void GFX_CirclePointGet(int16_t radius, int16_t angle, int16_t *x, int16_t *y)
 // *****************************************************************************
 inline void __attribute__ ((always_inline)) GFX_RenderToDisplayBufferDisable(void)
 {
-    gfxImageDrawRenderDisableFlag = 1;
+    pGfxContext->imageDrawRenderDisableFlag = 1;
 }
 
 // *****************************************************************************
@@ -8665,7 +15289,7 @@ inline void __attribute__ ((always_inline)) GFX_RenderToDisplayBufferDisable(voi
 // *****************************************************************************
 inline void __attribute__ ((always_inline)) GFX_RenderToDisplayBufferEnable(void)
 {
-    gfxImageDrawRenderDisableFlag = 0;
+    pGfxContext->imageDrawRenderDisableFlag = 0;
 }
 
 // *****************************************************************************
@@ -8688,7 +15312,7 @@ inline void __attribute__ ((always_inline)) GFX_RenderToDisplayBufferEnable(void
 // *****************************************************************************
 inline uint16_t __attribute__ ((always_inline)) GFX_RenderToDisplayBufferDisableFlagGet(void)
 {
-    return (gfxImageDrawRenderDisableFlag);
+    return (pGfxContext->imageDrawRenderDisableFlag);
 }
 
 // *****************************************************************************
@@ -8789,7 +15413,7 @@ GFX_STATUS __attribute__((weak)) GFX_ThickBevelDraw(
                 {
                     x1--;
                     err1 += 5;
-                    err1 += (y1 - x1) << 1;
+                    err1 += (y1 - x1) * 2;
                 }
                 else
                 {
@@ -8811,7 +15435,7 @@ GFX_STATUS __attribute__((weak)) GFX_ThickBevelDraw(
         {
             x2--;
             err2 += 5;
-            err2 += (y2 - x2) << 1;
+            err2 += (y2 - x2) * 2;
         }
         else
         {
@@ -8976,144 +15600,116 @@ GFX_STATUS __attribute__((weak)) GFX_ThickBevelDraw(
 
 #else
 
-    typedef enum
-    {
-        BEGIN,
-        QUAD11,
-        BARRIGHT1,
-        QUAD12,
-        BARRIGHT2,
-        QUAD21,
-        BARLEFT1,
-        QUAD22,
-        BARLEFT2,
-        QUAD31,
-        BARTOP1,
-        QUAD32,
-        BARTOP2,
-        QUAD41,
-        BARBOTTOM1,
-        QUAD42,
-        BARBOTTOM2,
-        CHECK,
-    } OCTANTARC_STATES;
-
     PRIMITIVE_UINT32_UNION temp;
 
     //	int32_t temp1;
-    static uint16_t y1Limit, y2Limit;
-    static uint16_t x1, x2, y1, y2, ovrlap;
-    static int16_t  err1, err2;
-    static uint16_t x1Cur, y1Cur, y1New;
-    static uint16_t x2Cur, y2Cur, y2New;
-    static int16_t  width, height;
-    static OCTANTARC_STATES state = BEGIN;
+    GFX_THICK_BEVEL_DRAW_PARAM *pState = &(pGfxContext->thickBevel);
 
     while(1)
     {
         if(GFX_RenderStatusGet() == GFX_STATUS_BUSY_BIT)
             return (GFX_STATUS_FAILURE);
 
-        switch(state)
+        switch(pState->state)
         {
             case BEGIN:
                 temp.uint32Value = SIN45 * r1;
-                y1Limit = temp.uint3216BitValue[1];
+                pState->y1Limit = temp.uint3216BitValue[1];
                 temp.uint32Value = SIN45 * r2;
-                y2Limit = temp.uint3216BitValue[1];
+                pState->y2Limit = temp.uint3216BitValue[1];
 
                 temp.uint32Value = (uint32_t) (ONEP25 - ((int32_t) r1 << 16));
-                err1 = (int16_t) (temp.uint3216BitValue[1]);
+                pState->err1 = (int16_t) (temp.uint3216BitValue[1]);
 
                 temp.uint32Value = (uint32_t) (ONEP25 - ((int32_t) r2 << 16));
-                err2 = (int16_t) (temp.uint3216BitValue[1]);
+                pState->err2 = (int16_t) (temp.uint3216BitValue[1]);
 
-                x1 = r1;
-                x2 = r2;
-                y1 = 0;
-                y2 = 0;
+                pState->x1 = r1;
+                pState->x2 = r2;
+                pState->y1 = 0;
+                pState->y2 = 0;
 
-                x1Cur = x1;
-                y1Cur = y1 + 1;
-                y1New = y1;
-                x2Cur = x2;
-                y2Cur = y2;
-                y2New = y2;
-                state = CHECK;
+                pState->x1Cur = pState->x1;
+                pState->y1Cur = pState->y1 + 1;
+                pState->y1New = pState->y1;
+                pState->x2Cur = pState->x2;
+                pState->y2Cur = pState->y2;
+                pState->y2New = pState->y2;
+                pState->state = CHECK;
 
             case CHECK:
-                arc_check_state : if(y2 > y2Limit)
+                arc_check_state : if(pState->y2 > pState->y2Limit)
                 {
                     // draw the width and height
-                    width  = (int16_t)(xR - xL);
-                    height = (int16_t)(yB - yT);
+                    pState->width  = (int16_t)(xR - xL);
+                    pState->height = (int16_t)(yB - yT);
 
-                    state = BARRIGHT1;
+                    pState->state = BARRIGHT1;
                     goto arc_draw_width_height_state;
                 }
 
                 // y1New & y2New records the last y positions
-                y1New = y1;
-                y2New = y2;
+                pState->y1New = pState->y1;
+                pState->y2New = pState->y2;
 
-                if(y1 <= y1Limit)
+                if(pState->y1 <= pState->y1Limit)
                 {
-                    if(err1 > 0)
+                    if(pState->err1 > 0)
                     {
-                        x1--;
-                        err1 += 5;
-                        err1 += (y1 - x1) << 1;
+                        pState->x1--;
+                        pState->err1 += 5;
+                        pState->err1 += (pState->y1 - pState->x1) << 1;
                     }
                     else
                     {
-                        err1 += 3;
-                        err1 += y1 << 1;
+                        pState->err1 += 3;
+                        pState->err1 += pState->y1 << 1;
                     }
 
-                    y1++;
+                    pState->y1++;
                 }
                 else
                 {
-                    y1++;
-                    if(x1 < y1)
-                        x1 = y1;
+                    pState->y1++;
+                    if(pState->x1 < pState->y1)
+                        pState->x1 = pState->y1;
                 }
 
-                if(err2 > 0)
+                if(pState->err2 > 0)
                 {
-                    x2--;
-                    err2 += 5;
-                    err2 += (y2 - x2) << 1;
+                    pState->x2--;
+                    pState->err2 += 5;
+                    pState->err2 += (pState->y2 - pState->x2) << 1;
                 }
                 else
                 {
-                    err2 += 3;
-                    err2 += y2 << 1;
+                    pState->err2 += 3;
+                    pState->err2 += pState->y2 << 1;
                 }
 
-                y2++;
+                pState->y2++;
 
-                state = QUAD11;
+                pState->state = QUAD11;
 
                 //break;
 
             case QUAD11:
-                if((x1Cur != x1) || (x2Cur != x2))
+                if((pState->x1Cur != pState->x1) || (pState->x2Cur != pState->x2))
                 {
 
                     // 1st octant
                     if(octant & 0x01)
                     {
                         // check overlaps
-                        if (yT - x1Cur < yT - y1New)
-                            ovrlap = yT - x1Cur;
+                        if (yT - pState->x1Cur < yT - pState->y1New)
+                            pState->ovrlap = yT - pState->x1Cur;
                         else
-                            ovrlap = yT - y1New;
+                            pState->ovrlap = yT - pState->y1New;
 
-                        if(GFX_BarDraw( xR + y2Cur,
-                                        yT - x2Cur,
-                                        xR + y1New,
-                                        ovrlap) == GFX_STATUS_FAILURE)
+                        if(GFX_BarDraw( xR + pState->y2Cur,
+                                        yT - pState->x2Cur,
+                                        xR + pState->y1New,
+                                        pState->ovrlap) == GFX_STATUS_FAILURE)
                         {
                             return (GFX_STATUS_FAILURE);
                         }
@@ -9121,11 +15717,11 @@ GFX_STATUS __attribute__((weak)) GFX_ThickBevelDraw(
                 }
                 else
                 {
-                    state = CHECK;
+                    pState->state = CHECK;
                     goto arc_check_state;
                 }
 
-                state = QUAD12;
+                pState->state = QUAD12;
                 break;
 
             case QUAD12:
@@ -9134,21 +15730,21 @@ GFX_STATUS __attribute__((weak)) GFX_ThickBevelDraw(
                 if(octant & 0x02)
                 {
                     // check overlaps
-                    if (xR + x1Cur > xR + y1New)
-                        ovrlap = xR + x1Cur;
+                    if (xR + pState->x1Cur > xR + pState->y1New)
+                        pState->ovrlap = xR + pState->x1Cur;
                     else
-                        ovrlap = xR + y1New;
+                        pState->ovrlap = xR + pState->y1New;
                     if(GFX_BarDraw(
-                                ovrlap,
-                                yT - y1New,
-                                xR + x2Cur,
-                                yT - y2Cur) == GFX_STATUS_FAILURE)
+                                pState->ovrlap,
+                                yT - pState->y1New,
+                                xR + pState->x2Cur,
+                                yT - pState->y2Cur) == GFX_STATUS_FAILURE)
                     {
                         return (GFX_STATUS_FAILURE);
                     }
                 }
 
-                state = QUAD21;
+                pState->state = QUAD21;
                 break;
 
             case QUAD21:
@@ -9157,21 +15753,21 @@ GFX_STATUS __attribute__((weak)) GFX_ThickBevelDraw(
                 if(octant & 0x04)
                 {
                     // check overlaps
-                    if (xR + x1Cur > xR + y2New)
-                        ovrlap = xR + x1Cur;
+                    if (xR + pState->x1Cur > xR + pState->y2New)
+                        pState->ovrlap = xR + pState->x1Cur;
                     else
-                        ovrlap = xR + y2New;
+                        pState->ovrlap = xR + pState->y2New;
                     if(GFX_BarDraw(
-                            ovrlap,
-                            yB + y1Cur,
-                            xR + x2Cur,
-                            yB + y2New) == GFX_STATUS_FAILURE)
+                            pState->ovrlap,
+                            yB + pState->y1Cur,
+                            xR + pState->x2Cur,
+                            yB + pState->y2New) == GFX_STATUS_FAILURE)
                     {
                         return (GFX_STATUS_FAILURE);
                     }
                 }
 
-                state = QUAD22;
+                pState->state = QUAD22;
                 break;
 
             case QUAD22:
@@ -9181,21 +15777,21 @@ GFX_STATUS __attribute__((weak)) GFX_ThickBevelDraw(
                 {
 
                     // check overlaps
-                    if (yB + x1Cur > yB + y2New)
-                        ovrlap = yB + x1Cur;
+                    if (yB + pState->x1Cur > yB + pState->y2New)
+                        pState->ovrlap = yB + pState->x1Cur;
                     else
-                        ovrlap = yB + y2New;
+                        pState->ovrlap = yB + pState->y2New;
                     if(GFX_BarDraw(
-                            xR + y1Cur,
-                            ovrlap,
-                            xR + y2New,
-                            yB + x2Cur) == GFX_STATUS_FAILURE)
+                            xR + pState->y1Cur,
+                            pState->ovrlap,
+                            xR + pState->y2New,
+                            yB + pState->x2Cur) == GFX_STATUS_FAILURE)
                     {
                         return (GFX_STATUS_FAILURE);
                     }
                 }
 
-                state = QUAD31;
+                pState->state = QUAD31;
                 break;
 
             case QUAD31:
@@ -9204,21 +15800,21 @@ GFX_STATUS __attribute__((weak)) GFX_ThickBevelDraw(
                 if(octant & 0x10)
                 {
                     // check overlaps
-                    if (yB + x1Cur > yB + y1New)
-                        ovrlap = yB + x1Cur;
+                    if (yB + pState->x1Cur > yB + pState->y1New)
+                        pState->ovrlap = yB + pState->x1Cur;
                     else
-                        ovrlap = yB + y1New;
+                        pState->ovrlap = yB + pState->y1New;
                     if(GFX_BarDraw(
-                            xL - y1New,
-                            ovrlap,
-                            xL - y2Cur,
-                            yB + x2Cur) == GFX_STATUS_FAILURE)
+                            xL - pState->y1New,
+                            pState->ovrlap,
+                            xL - pState->y2Cur,
+                            yB + pState->x2Cur) == GFX_STATUS_FAILURE)
                     {
                         return (GFX_STATUS_FAILURE);
                     }
                 }
 
-                state = QUAD32;
+                pState->state = QUAD32;
                 break;
 
             case QUAD32:
@@ -9227,21 +15823,21 @@ GFX_STATUS __attribute__((weak)) GFX_ThickBevelDraw(
                 if(octant & 0x20)
                 {
                     // check overlaps
-                    if (xL - x1Cur < xL - y1New)
-                        ovrlap = xL - x1Cur;
+                    if (xL - pState->x1Cur < xL - pState->y1New)
+                        pState->ovrlap = xL - pState->x1Cur;
                     else
-                        ovrlap = xL - y1New;
+                        pState->ovrlap = xL - pState->y1New;
                     if(GFX_BarDraw(
-                            xL - x2Cur,
-                            yB + y2Cur,
-                            ovrlap,
-                            yB + y1New) == GFX_STATUS_FAILURE)
+                            xL - pState->x2Cur,
+                            yB + pState->y2Cur,
+                            pState->ovrlap,
+                            yB + pState->y1New) == GFX_STATUS_FAILURE)
                     {
                         return (GFX_STATUS_FAILURE);
                     }
                 }
 
-                state = QUAD41;
+                pState->state = QUAD41;
                 break;
 
             case QUAD41:
@@ -9250,21 +15846,21 @@ GFX_STATUS __attribute__((weak)) GFX_ThickBevelDraw(
                 if(octant & 0x40)
                 {
                     // check overlaps
-                    if (xL - x1Cur < xL - y2New)
-                        ovrlap = xL - x1Cur;
+                    if (xL - pState->x1Cur < xL - pState->y2New)
+                        pState->ovrlap = xL - pState->x1Cur;
                     else
-                        ovrlap = xL - y2New;
+                        pState->ovrlap = xL - pState->y2New;
                     if(GFX_BarDraw(
-                            xL - x2Cur,
-                            yT - y2New,
-                            ovrlap,
-                            yT - y1Cur) == GFX_STATUS_FAILURE)
+                            xL - pState->x2Cur,
+                            yT - pState->y2New,
+                            pState->ovrlap,
+                            yT - pState->y1Cur) == GFX_STATUS_FAILURE)
                     {
                         return (GFX_STATUS_FAILURE);
                     }
                 }
 
-                state = QUAD42;
+                pState->state = QUAD42;
                 break;
 
             case QUAD42:
@@ -9273,33 +15869,33 @@ GFX_STATUS __attribute__((weak)) GFX_ThickBevelDraw(
                 if(octant & 0x80)
                 {
                     // check overlaps
-                    if (yT - x1Cur < yT - y2New)
-                        ovrlap = yT - x1Cur;
+                    if (yT - pState->x1Cur < yT - pState->y2New)
+                        pState->ovrlap = yT - pState->x1Cur;
                     else
-                        ovrlap = yT - y2New;
+                        pState->ovrlap = yT - pState->y2New;
                     if(GFX_BarDraw(
-                            xL - y2New,
-                            yT - x2Cur,
-                            xL - y1Cur,
-                            ovrlap) == GFX_STATUS_FAILURE)
+                            xL - pState->y2New,
+                            yT - pState->x2Cur,
+                            xL - pState->y1Cur,
+                            pState->ovrlap) == GFX_STATUS_FAILURE)
                     {
                         return (GFX_STATUS_FAILURE);
                     }
                 }
 
                 // update current values
-                x1Cur = x1;
-                y1Cur = y1;
-                x2Cur = x2;
-                y2Cur = y2;
-                state = CHECK;
+                pState->x1Cur = pState->x1;
+                pState->y1Cur = pState->y1;
+                pState->x2Cur = pState->x2;
+                pState->y2Cur = pState->y2;
+                pState->state = CHECK;
                 break;
 
             case BARRIGHT1:     // draw upper right
                 arc_draw_width_height_state :
-                if ((width > 1) || (height > 1))
+                if ((pState->width > 1) || (pState->height > 1))
                 {
-                    if (height > 1)
+                    if (pState->height > 1)
                     {
                         // draw right
                         if(octant & 0x02)
@@ -9316,17 +15912,17 @@ GFX_STATUS __attribute__((weak)) GFX_ThickBevelDraw(
                     }
                     else
                     {
-                        state = BARBOTTOM1;
+                        pState->state = BARBOTTOM1;
                         break;
                     }
                 }
                 else
                 {
-                    state = BEGIN;
+                    pState->state = BEGIN;
                     return (GFX_STATUS_SUCCESS);
                 }
 
-                state = BARRIGHT2;
+                pState->state = BARRIGHT2;
                 break;
 
             case BARRIGHT2:     // draw lower right
@@ -9342,7 +15938,7 @@ GFX_STATUS __attribute__((weak)) GFX_ThickBevelDraw(
                     }
                 }
 
-                state = BARLEFT1;
+                pState->state = BARLEFT1;
                 break;
 
             case BARLEFT1:              // draw upper left
@@ -9358,7 +15954,7 @@ GFX_STATUS __attribute__((weak)) GFX_ThickBevelDraw(
                     }
                 }
 
-                state = BARLEFT2;
+                pState->state = BARLEFT2;
                 break;
 
             case BARLEFT2:              // draw lower left
@@ -9371,11 +15967,11 @@ GFX_STATUS __attribute__((weak)) GFX_ThickBevelDraw(
                         return (GFX_STATUS_FAILURE);
                     }
                 }
-                if (width > 1)
-                    state = BARBOTTOM1;
+                if (pState->width > 1)
+                    pState->state = BARBOTTOM1;
                 else
                 {
-                    state = BEGIN;
+                    pState->state = BEGIN;
                     return (GFX_STATUS_SUCCESS);
                 }
 
@@ -9392,7 +15988,7 @@ GFX_STATUS __attribute__((weak)) GFX_ThickBevelDraw(
                     }
                 }
 
-                state = BARBOTTOM2;
+                pState->state = BARBOTTOM2;
                 break;
 
             case BARBOTTOM2:    // draw right bottom
@@ -9406,7 +16002,7 @@ GFX_STATUS __attribute__((weak)) GFX_ThickBevelDraw(
                     }
                 }
 
-                state = BARTOP1;
+                pState->state = BARTOP1;
                 break;
 
             case BARTOP1:       // draw left top
@@ -9421,7 +16017,7 @@ GFX_STATUS __attribute__((weak)) GFX_ThickBevelDraw(
                     }
                 }
 
-                state = BARTOP2;
+                pState->state = BARTOP2;
 
             case BARTOP2:               // draw right top
                 if(octant & 0x01)
@@ -9433,7 +16029,7 @@ GFX_STATUS __attribute__((weak)) GFX_ThickBevelDraw(
                         return (GFX_STATUS_FAILURE);
                     }
                 }
-                state = BEGIN;
+                pState->state = BEGIN;
                 return (GFX_STATUS_SUCCESS);
         }                               // end of switch
     }   // end of while
@@ -0,0 +1,2203 @@
+/*******************************************************************************
+ Graphics Library Benchmark
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    gfx_benchmark.c
+
+  Summary:
+    Host benchmark of the Graphics Library Primitive Layer and GOL.
+
+  Description:
+    This program runs the Primitive Layer and the Graphics Object Layer on
+    a host computer against the RAM frame buffer display driver and
+    measures the throughput of each primitive. For every benchmark case it
+    reports the number of primitive calls per second, the number of
+    rendered pixels per second and the number of display driver calls and
+    pixels per primitive call, as well as the number of external memory
+    reads per call, so changes to the default implementations of the
+    primitives can be compared.
+
+    The fonts and images used are generated at start up, so the program
+    does not depend on resources converted by the Graphics Resource
+    Converter. External memory resources are served from a RAM buffer by
+    GFX_ExternalResourceCallback().
+
+    Build (from the root of the library):
+
+        gcc -O2 -fgnu89-inline -I gfx/utilities/benchmark -I .
+            gfx/utilities/benchmark/gfx_benchmark.c
+            driver/gfx/src/drv_gfx_framebuffer.c
+            gfx/src/gfx_primitive.c gfx/src/gfx_gol*.c
+            -lm -o gfx_benchmark
+
+    The default build uses the configuration of system_config.h in this
+    directory, which leaves the optional features disabled. Add these
+    options to the build line to benchmark them:
+
+        -DGFX_CONFIG_IPU_DECODE_WINDOW_SIZE=4096    IPU image cases
+        -DGFX_CONFIG_JPEG_DECODE_ENABLE             JPEG file cases
+        -DGFX_CONFIG_PNG_DECODE_ROW_SIZE=512        PNG file cases, needs
+                                                    the IPU window
+        -DGFX_CONFIG_POLYGON_FILL_POINTS=32         polygon fill cases
+        -DGFX_CONFIG_SURFACE_ENABLE                 off-screen surface cases
+        -DGFX_CONFIG_DISPLAY_LIST_SIZE=32           display list cases
+        -DGFX_CONFIG_CLIP_STACK_SIZE=4              clip rectangle stack
+        -DGFX_CONFIG_FONT_GLYPH_CACHE_SIZE=32       font glyph cache
+        -DGFX_CONFIG_FONT_WIDTH_TABLE_SIZE=4        font width tables
+        -DGFX_CONFIG_RLE_ROW_INDEX_SIZE=2           RLE image row index
+        -DGFX_CONFIG_EXTERNAL_CACHE_BLOCKS=4        external memory cache
+
+    The first six add benchmark cases, the others change the speed of
+    the existing text, image and external memory cases.
+
+    Usage:
+
+        gfx_benchmark [-t milliseconds] [-n calls] [-p directory] [case name]
+
+        -t  minimum run time of each case, default 200 ms
+        -n  runs each case exactly this many times (rounded up to a batch
+            of 16) instead of for a minimum time, so runs can be compared
+            call for call
+        -p  saves the frame of each case as <directory>/<case>.ppm
+        Only the cases whose name contains the given string are run.
+
+    The saved frame does not depend on the run time: after the timed run
+    each case is started again and rendered with a fixed pass of
+    BENCHMARK_FRAME_CALLS calls, so the frames can be compared between
+    builds as reference images.
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+Copyright (c) 2013 released Microchip Technology Inc.  All rights reserved.
+
+Microchip licenses to you the right to use, modify, copy and distribute
+Software only when embedded on a Microchip microcontroller or digital signal
+controller that is integrated into your product or third party product
+(pursuant to the sublicense terms in the accompanying license agreement).
+
+You should refer to the license agreement accompanying this Software for
+additional information regarding your rights and obligations.
+
+SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR PURPOSE.
+IN NO EVENT SHALL MICROCHIP OR ITS LICENSORS BE LIABLE OR OBLIGATED UNDER
+CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH OF WARRANTY, OR
+OTHER LEGAL EQUITABLE THEORY ANY DIRECT OR INDIRECT DAMAGES OR EXPENSES
+INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL, INDIRECT, PUNITIVE OR
+CONSEQUENTIAL DAMAGES, LOST PROFITS OR LOST DATA, COST OF PROCUREMENT OF
+SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
+(INCLUDING BUT NOT LIMITED TO ANY DEFENSE THEREOF), OR OTHER SIMILAR COSTS.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "system.h"
+#include "gfx/gfx.h"
+#include "driver/gfx/drv_gfx_framebuffer.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Benchmark Resources
+// *****************************************************************************
+// *****************************************************************************
+
+#define BENCHMARK_FONT_FIRST_CHAR       32
+#define BENCHMARK_FONT_LAST_CHAR        126
+#define BENCHMARK_FONT_HEIGHT           16
+#define BENCHMARK_FONT_SIZE             8192
+
+#define BENCHMARK_IMAGE_WIDTH           96
+#define BENCHMARK_IMAGE_HEIGHT          64
+#define BENCHMARK_IMAGE_SIZE            (1024 + (BENCHMARK_IMAGE_WIDTH * BENCHMARK_IMAGE_HEIGHT * 2))
+
+#define BENCHMARK_EXTERNAL_MEMORY_SIZE  (64 * 1024)
+
+typedef enum
+{
+    BENCHMARK_IMAGE_1BPP = 0,
+    BENCHMARK_IMAGE_4BPP,
+    BENCHMARK_IMAGE_8BPP,
+    BENCHMARK_IMAGE_16BPP,
+    BENCHMARK_IMAGE_RLE4,
+    BENCHMARK_IMAGE_RLE8,
+#ifndef GFX_CONFIG_IPU_DECODE_DISABLE
+    BENCHMARK_IMAGE_IPU8,
+    BENCHMARK_IMAGE_IPU16,
+#endif
+    BENCHMARK_IMAGE_COUNT
+} BENCHMARK_IMAGE;
+
+static uint8_t          fontData[2][BENCHMARK_FONT_SIZE];
+static uint8_t          imageData[BENCHMARK_IMAGE_COUNT][BENCHMARK_IMAGE_SIZE];
+static uint8_t          externalMemory[BENCHMARK_EXTERNAL_MEMORY_SIZE];
+static uint32_t         externalMemoryUsed;
+static uint32_t         externalReads;      // calls to GFX_ExternalResourceCallback()
+
+static GFX_RESOURCE_HDR fontFlash1BPP, fontFlash2BPP, fontExternal1BPP;
+static GFX_RESOURCE_HDR imageFlash[BENCHMARK_IMAGE_COUNT];
+static GFX_RESOURCE_HDR imageExternal[BENCHMARK_IMAGE_COUNT];
+
+static GFX_XCHAR        benchmarkText[] = "The quick brown fox jumps over the lazy dog 0123456789";
+
+extern const GFX_GOL_OBJ_SCHEME GOLSchemeDefault;
+static GFX_GOL_OBJ_SCHEME       benchmarkScheme;
+
+/*********************************************************************
+* Function: uint32_t BenchmarkExternalCopy(const void *pData, uint32_t size)
+*
+* Overview: Copies a resource to the emulated external memory and returns
+*           its address.
+*
+********************************************************************/
+static uint32_t BenchmarkExternalCopy(const void *pData, uint32_t size)
+{
+    uint32_t address = externalMemoryUsed;
+
+    if((address + size) > sizeof(externalMemory))
+    {
+        fprintf(stderr, "external memory too small\n");
+        exit(EXIT_FAILURE);
+    }
+
+    memcpy(&externalMemory[address], pData, size);
+    externalMemoryUsed += size;
+
+    return (address);
+}
+
+/*********************************************************************
+* Function: uint32_t BenchmarkFontCreate(uint8_t *pData, uint8_t bpp)
+*
+* Overview: Builds a font table with generated glyphs of 1 or 2 bpp.
+*           The glyph widths vary from 5 to 10 pixels. Returns the size
+*           of the table.
+*
+********************************************************************/
+static uint32_t BenchmarkFontCreate(uint8_t *pData, uint8_t bpp)
+{
+    GFX_FONT_HEADER         *pHeader = (GFX_FONT_HEADER *)pData;
+    GFX_FONT_GLYPH_ENTRY    *pGlyph = (GFX_FONT_GLYPH_ENTRY *)(pHeader + 1);
+    uint32_t                offset;
+    uint16_t                ch, x, y, width, rowBytes;
+    uint8_t                 value, *pRow;
+
+    memset(pData, 0, BENCHMARK_FONT_SIZE);
+
+    pHeader->fontID = bpp;
+    pHeader->bpp = (bpp == 1) ? 0 : 1;
+    pHeader->firstChar = BENCHMARK_FONT_FIRST_CHAR;
+    pHeader->lastChar = BENCHMARK_FONT_LAST_CHAR;
+    pHeader->height = BENCHMARK_FONT_HEIGHT;
+
+    offset = sizeof(GFX_FONT_HEADER) +
+             sizeof(GFX_FONT_GLYPH_ENTRY) * (BENCHMARK_FONT_LAST_CHAR - BENCHMARK_FONT_FIRST_CHAR + 1);
+
+    for(ch = BENCHMARK_FONT_FIRST_CHAR; ch <= BENCHMARK_FONT_LAST_CHAR; ch++, pGlyph++)
+    {
+        width = 5 + (ch % 6);
+        rowBytes = ((width * bpp) + 7) >> 3;
+
+        pGlyph->width = width;
+        pGlyph->offsetLSB = offset & 0xFF;
+        pGlyph->offsetMSB = offset >> 8;
+
+        for(y = 0; y < BENCHMARK_FONT_HEIGHT; y++)
+        {
+            pRow = &pData[offset + (y * rowBytes)];
+
+            // an outlined block with a diagonal, spaces stay empty
+            for(x = 0; (ch != ' ') && (x < width - 1); x++)
+            {
+                if((y < 3) || (y > BENCHMARK_FONT_HEIGHT - 4))
+                    continue;
+
+                if((x == 0) || (x == width - 2) || (y == 3) || (y == BENCHMARK_FONT_HEIGHT - 4))
+                    value = (1 << bpp) - 1;
+                else if(((x + y + ch) % 4) == 0)
+                    value = (bpp == 1) ? 1 : ((x + y) % 3) + 1;
+                else
+                    continue;
+
+                pRow[(x * bpp) >> 3] |= value << ((x * bpp) & 0x07);
+            }
+        }
+
+        offset += rowBytes * BENCHMARK_FONT_HEIGHT;
+    }
+
+    return (offset);
+}
+
+/*********************************************************************
+* Function: uint8_t BenchmarkImageIndexGet(uint16_t x, uint16_t y, uint8_t bpp)
+*
+* Overview: Returns the palette index of an image pixel. The pattern
+*           has long runs in the upper half and noise in the lower half
+*           so the RLE images contain both kinds of codes.
+*
+********************************************************************/
+static uint8_t BenchmarkImageIndexGet(uint16_t x, uint16_t y, uint8_t bpp)
+{
+    uint16_t index;
+
+    if(y < (BENCHMARK_IMAGE_HEIGHT / 2))
+        index = (x / 12) + (y / 8);
+    else
+        index = (x * 7) ^ (y * 13);
+
+    return (index & ((1 << bpp) - 1));
+}
+
+/*********************************************************************
+* Function: uint32_t BenchmarkRLEEncode(uint8_t *pDest, uint8_t bpp)
+*
+* Overview: Encodes the image rows in the RLE format of the library.
+*           A code byte greater than zero repeats the value byte, a zero
+*           code is followed by the number of literal pixels and the
+*           pixels. Literal 4 bpp runs are kept even inside a row since
+*           the decoder continues with a fresh byte after them.
+*
+********************************************************************/
+static uint32_t BenchmarkRLEEncode(uint8_t *pDest, uint8_t bpp)
+{
+    uint8_t     row[BENCHMARK_IMAGE_WIDTH];
+    uint32_t    size = 0;
+    uint16_t    x, y, run, literal, i;
+
+    for(y = 0; y < BENCHMARK_IMAGE_HEIGHT; y++)
+    {
+        for(x = 0; x < BENCHMARK_IMAGE_WIDTH; x++)
+            row[x] = BenchmarkImageIndexGet(x, y, bpp);
+
+        x = 0;
+        while(x < BENCHMARK_IMAGE_WIDTH)
+        {
+            for(run = 1; ((x + run) < BENCHMARK_IMAGE_WIDTH) && (row[x + run] == row[x]) && (run < 254); run++);
+
+            if(run >= 3)
+            {
+                pDest[size++] = run;
+                pDest[size++] = (bpp == 4) ? (row[x] | (row[x] << 4)) : row[x];
+                x += run;
+                continue;
+            }
+
+            // collect literal pixels up to the next run of 3
+            for(literal = 1; (x + literal) < BENCHMARK_IMAGE_WIDTH; literal++)
+            {
+                i = x + literal;
+                if(((i + 2) < BENCHMARK_IMAGE_WIDTH) && (row[i] == row[i + 1]) && (row[i] == row[i + 2]))
+                    break;
+                if(literal == 254)
+                    break;
+            }
+            if((bpp == 4) && (literal & 0x01) && ((x + literal) < BENCHMARK_IMAGE_WIDTH))
+                literal++;
+
+            pDest[size++] = 0;
+            pDest[size++] = literal;
+            for(i = 0; i < literal; i++)
+            {
+                if(bpp == 8)
+                    pDest[size++] = row[x + i];
+                else if(i & 0x01)
+                    pDest[size - 1] |= row[x + i] << 4;
+                else
+                    pDest[size++] = row[x + i];
+            }
+            x += literal;
+        }
+    }
+
+    return (size);
+}
+
+#ifndef GFX_CONFIG_IPU_DECODE_DISABLE
+
+#define BENCHMARK_DEFLATE_WINDOW_SIZE   1024
+
+static uint8_t          *pDeflateDest;
+static uint32_t         deflateSize;        // number of bytes written to pDeflateDest
+static uint32_t         deflateBits;        // bits not written yet, first bit in bit 0
+static uint8_t          deflateBitCount;
+
+/*********************************************************************
+* Function: void BenchmarkDeflateBitsPut(uint16_t bits, uint8_t count)
+*
+* Overview: Appends count bits to the DEFLATE data, first bit in bit 0.
+*
+********************************************************************/
+static void BenchmarkDeflateBitsPut(uint16_t bits, uint8_t count)
+{
+    deflateBits |= (uint32_t)bits << deflateBitCount;
+    deflateBitCount += count;
+
+    while(deflateBitCount >= 8)
+    {
+        pDeflateDest[deflateSize++] = deflateBits & 0xFF;
+        deflateBits >>= 8;
+        deflateBitCount -= 8;
+    }
+}
+
+/*********************************************************************
+* Function: void BenchmarkDeflateSymbolPut(uint16_t symbol)
+*
+* Overview: Appends a literal/length symbol with the fixed Huffman
+*           code. Huffman codes are stored from their highest bit.
+*
+********************************************************************/
+static void BenchmarkDeflateSymbolPut(uint16_t symbol)
+{
+    uint16_t    code, reversed = 0;
+    uint8_t     count, i;
+
+    if(symbol < 144)
+        code = 0x30 + symbol, count = 8;
+    else if(symbol < 256)
+        code = 0x190 + (symbol - 144), count = 9;
+    else if(symbol < 280)
+        code = symbol - 256, count = 7;
+    else
+        code = 0xC0 + (symbol - 280), count = 8;
+
+    for(i = 0; i < count; i++)
+        reversed |= ((code >> i) & 0x01) << (count - 1 - i);
+
+    BenchmarkDeflateBitsPut(reversed, count);
+}
+
+/*********************************************************************
+* Function: uint32_t BenchmarkDeflateEncode(uint8_t *pDest, const uint8_t *pSource, uint32_t size)
+*
+* Overview: Compresses the data in a single DEFLATE block with fixed
+*           Huffman codes, taking the longest match of the last
+*           BENCHMARK_DEFLATE_WINDOW_SIZE bytes at each position.
+*           This is the format of the IPU images.
+*
+********************************************************************/
+static uint32_t BenchmarkDeflateEncode(uint8_t *pDest, const uint8_t *pSource, uint32_t size)
+{
+    static const uint16_t lengthBase[29] = {
+        3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+        35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+    static const uint8_t lengthExtra[29] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+        3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+    static const uint16_t distanceBase[30] = {
+        1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+        257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+        8193, 12289, 16385, 24577 };
+    static const uint8_t distanceExtra[30] = {
+        0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+        7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+    uint32_t    position = 0, distance, length, bestDistance, bestLength;
+    uint8_t     code, i;
+
+    pDeflateDest = pDest;
+    deflateSize = 0;
+    deflateBits = 0;
+    deflateBitCount = 0;
+
+    // last block with fixed codes
+    BenchmarkDeflateBitsPut(1, 1);
+    BenchmarkDeflateBitsPut(1, 2);
+
+    while(position < size)
+    {
+        bestLength = 0;
+        bestDistance = 0;
+        for(distance = 1; (distance <= position) && (distance <= BENCHMARK_DEFLATE_WINDOW_SIZE); distance++)
+        {
+            for(length = 0; (length < 258) && ((position + length) < size) &&
+                    (pSource[position + length] == pSource[position + length - distance]); length++);
+            if(length > bestLength)
+            {
+                bestLength = length;
+                bestDistance = distance;
+            }
+        }
+
+        if(bestLength < 3)
+        {
+            BenchmarkDeflateSymbolPut(pSource[position++]);
+            continue;
+        }
+
+        for(code = 28; lengthBase[code] > bestLength; code--);
+        BenchmarkDeflateSymbolPut(257 + code);
+        BenchmarkDeflateBitsPut(bestLength - lengthBase[code], lengthExtra[code]);
+
+        for(code = 29; distanceBase[code] > bestDistance; code--);
+        for(i = 0, length = 0; i < 5; i++)
+            length |= ((code >> i) & 0x01) << (4 - i);
+        BenchmarkDeflateBitsPut(length, 5);
+        BenchmarkDeflateBitsPut(bestDistance - distanceBase[code], distanceExtra[code]);
+
+        position += bestLength;
+    }
+
+    // end of block, the last byte is padded
+    BenchmarkDeflateSymbolPut(256);
+    BenchmarkDeflateBitsPut(0, 7);
+
+    return (deflateSize);
+}
+
+#endif
+
+/*********************************************************************
+* Function: void BenchmarkImageCreate(BENCHMARK_IMAGE image)
+*
+* Overview: Builds one image in the internal flash format and copies
+*           it to the emulated external memory.
+*
+********************************************************************/
+static void BenchmarkImageCreate(BENCHMARK_IMAGE image)
+{
+#ifndef GFX_CONFIG_IPU_DECODE_DISABLE
+    static const uint8_t    colorDepth[BENCHMARK_IMAGE_COUNT] = { 1, 4, 8, 16, 4, 8, 8, 16 };
+    static uint8_t          rawData[BENCHMARK_IMAGE_SIZE];
+    bool                    ipu = (image == BENCHMARK_IMAGE_IPU8) || (image == BENCHMARK_IMAGE_IPU16);
+#else
+    static const uint8_t    colorDepth[BENCHMARK_IMAGE_COUNT] = { 1, 4, 8, 16, 4, 8 };
+#endif
+    uint8_t                 *pData = imageData[image];
+    uint8_t                 bpp = colorDepth[image];
+    uint16_t                *pPalette = (uint16_t *)pData;
+    uint16_t                x, y, entries = 0;
+    uint32_t                size, rawSize;
+    bool                    rle = (image == BENCHMARK_IMAGE_RLE4) || (image == BENCHMARK_IMAGE_RLE8);
+
+    memset(pData, 0, BENCHMARK_IMAGE_SIZE);
+
+    // palette
+    if(bpp < 16)
+    {
+        entries = 1 << bpp;
+        for(x = 0; x < entries; x++)
+            pPalette[x] = GFX_RGBConvert(x * 255 / (entries - 1), 255 - (x * 255 / (entries - 1)), (x * 97) & 0xFF);
+    }
+    size = entries * sizeof(uint16_t);
+
+    if(rle)
+    {
+        size += BenchmarkRLEEncode(pData + size, bpp);
+    }
+    else if(bpp == 16)
+    {
+        for(y = 0; y < BENCHMARK_IMAGE_HEIGHT; y++)
+            for(x = 0; x < BENCHMARK_IMAGE_WIDTH; x++)
+                ((uint16_t *)pData)[(y * BENCHMARK_IMAGE_WIDTH) + x] = GFX_RGBConvert(x * 2, y * 4, (x ^ y) * 2);
+        size = BENCHMARK_IMAGE_WIDTH * BENCHMARK_IMAGE_HEIGHT * 2;
+    }
+    else
+    {
+        uint16_t rowBytes = ((BENCHMARK_IMAGE_WIDTH * bpp) + 7) >> 3;
+
+        for(y = 0; y < BENCHMARK_IMAGE_HEIGHT; y++)
+            for(x = 0; x < BENCHMARK_IMAGE_WIDTH; x++)
+                pData[size + (y * rowBytes) + ((x * bpp) >> 3)] |=
+                    BenchmarkImageIndexGet(x, y, bpp) << ((x * bpp) & 0x07);
+        size += rowBytes * BENCHMARK_IMAGE_HEIGHT;
+    }
+
+    rawSize = size;
+#ifndef GFX_CONFIG_IPU_DECODE_DISABLE
+    if(ipu)
+    {
+        // the uncompressed image is compressed as a whole
+        memcpy(rawData, pData, rawSize);
+        size = BenchmarkDeflateEncode(pData, rawData, rawSize);
+    }
+#endif
+
+    imageFlash[image].type = rle ? GFX_RESOURCE_MCHP_MBITMAP_FLASH_RLE : GFX_RESOURCE_MCHP_MBITMAP_FLASH_NONE;
+    imageFlash[image].ID = image;
+    imageFlash[image].resource.image.location.progByteAddress = pData;
+    imageFlash[image].resource.image.width = BENCHMARK_IMAGE_WIDTH;
+    imageFlash[image].resource.image.height = BENCHMARK_IMAGE_HEIGHT;
+    imageFlash[image].resource.image.parameter1.compressedSize = size;
+    imageFlash[image].resource.image.parameter2.rawSize = rawSize;
+    imageFlash[image].resource.image.colorDepth = bpp;
+    imageFlash[image].resource.image.type = MCHP_BITMAP_NORMAL;
+
+    imageExternal[image] = imageFlash[image];
+    imageExternal[image].type = rle ? GFX_RESOURCE_MCHP_MBITMAP_EXTERNAL_RLE : GFX_RESOURCE_MCHP_MBITMAP_EXTERNAL_NONE;
+    imageExternal[image].resource.image.location.extAddress = BenchmarkExternalCopy(pData, size);
+
+#ifndef GFX_CONFIG_IPU_DECODE_DISABLE
+    if(ipu)
+    {
+        imageFlash[image].type = GFX_RESOURCE_MCHP_MBITMAP_FLASH_IPU;
+        imageExternal[image].type = GFX_RESOURCE_MCHP_MBITMAP_EXTERNAL_IPU;
+    }
+#endif
+}
+
+#if defined (GFX_CONFIG_JPEG_DECODE_ENABLE) || defined (GFX_CONFIG_PNG_DECODE_ROW_SIZE)
+
+#define BENCHMARK_FILE_SIZE             (32 * 1024)
+
+// the wide images are wider than the screen and are always clipped
+#define BENCHMARK_WIDE_WIDTH            (DISP_HOR_RESOLUTION + 48)
+#define BENCHMARK_WIDE_HEIGHT           32
+
+typedef enum
+{
+#ifdef GFX_CONFIG_JPEG_DECODE_ENABLE
+    BENCHMARK_FILE_JPEG = 0,        // color, 2x2 subsampled chroma, restart intervals
+    BENCHMARK_FILE_JPEG_WIDE,       // grayscale
+#endif
+#ifdef GFX_CONFIG_PNG_DECODE_ROW_SIZE
+    BENCHMARK_FILE_PNG,             // RGB, all the row filters
+    BENCHMARK_FILE_PNG_WIDE,        // 8 bit palette
+#endif
+    BENCHMARK_FILE_COUNT
+} BENCHMARK_FILE;
+
+static uint8_t          fileData[BENCHMARK_FILE_COUNT][BENCHMARK_FILE_SIZE];
+static FILEIO_OBJECT    benchmarkFile[BENCHMARK_FILE_COUNT];
+static GFX_RESOURCE_HDR imageFile[BENCHMARK_FILE_COUNT];
+#ifdef GFX_CONFIG_JPEG_DECODE_ENABLE
+static GFX_RESOURCE_HDR imageFileJpegHalf;
+#endif
+static uint8_t          fileBuffer[BENCHMARK_FILE_SIZE];
+
+/*********************************************************************
+* Function: void BenchmarkFileColorGet(uint16_t x, uint16_t y, uint8_t *pColor)
+*
+* Overview: Returns the red, green and blue values of a pixel of the
+*           JPEG and PNG images. Gradients fill the upper half and
+*           stripes the lower half, so the JPEG blocks have both low
+*           and high frequencies.
+*
+********************************************************************/
+static void BenchmarkFileColorGet(uint16_t x, uint16_t y, uint8_t *pColor)
+{
+    pColor[0] = x * 2;
+    pColor[1] = y * 4;
+    pColor[2] = (x ^ y) * 2;
+
+    if((y >= (BENCHMARK_IMAGE_HEIGHT / 2)) && ((x / 3) & 0x01))
+    {
+        pColor[0] >>= 2;
+        pColor[1] = 255 - pColor[1];
+    }
+}
+
+#ifdef GFX_CONFIG_JPEG_DECODE_ENABLE
+
+#define BENCHMARK_JPEG_QUALITY          75
+#define BENCHMARK_JPEG_RESTART_INTERVAL 4
+
+static uint8_t          *pJpegDest;
+static uint32_t         jpegSize;           // number of bytes written to pJpegDest
+static uint32_t         jpegBits;           // bits not written yet, last bit in bit 0
+static uint8_t          jpegBitCount;
+static uint8_t          jpegZigzag[64];     // position in the block of each coefficient
+static uint8_t          jpegQuant[2][64];   // luminance and chrominance, in the zigzag order
+static uint8_t          jpegDCSymbols[12];
+static uint8_t          jpegDCBits[17];     // number of codes of each length
+static uint8_t          jpegACSymbols[162];
+static uint8_t          jpegACBits[17];
+static uint16_t         jpegDCCode[256], jpegACCode[256];
+static uint8_t          jpegDCLength[256], jpegACLength[256];
+
+/*********************************************************************
+* Function: void BenchmarkJpegBytePut(uint8_t value)
+*
+* Overview: Appends a byte to the JPEG file.
+*
+********************************************************************/
+static void BenchmarkJpegBytePut(uint8_t value)
+{
+    pJpegDest[jpegSize++] = value;
+}
+
+/*********************************************************************
+* Function: void BenchmarkJpegMarkerPut(uint8_t marker, uint16_t length)
+*
+* Overview: Appends a marker and the length of its segment, the length
+*           does not count the 2 bytes of the length itself.
+*
+********************************************************************/
+static void BenchmarkJpegMarkerPut(uint8_t marker, uint16_t length)
+{
+    BenchmarkJpegBytePut(0xFF);
+    BenchmarkJpegBytePut(marker);
+    BenchmarkJpegBytePut((length + 2) >> 8);
+    BenchmarkJpegBytePut((length + 2) & 0xFF);
+}
+
+/*********************************************************************
+* Function: void BenchmarkJpegBitsPut(uint16_t bits, uint8_t count)
+*
+* Overview: Appends count bits to the entropy coded data, first bit in
+*           the highest bit. A 0 byte is stuffed after each 0xFF byte.
+*
+********************************************************************/
+static void BenchmarkJpegBitsPut(uint16_t bits, uint8_t count)
+{
+    uint8_t value;
+
+    jpegBits = (jpegBits << count) | (bits & ((1UL << count) - 1));
+    jpegBitCount += count;
+
+    while(jpegBitCount >= 8)
+    {
+        value = (jpegBits >> (jpegBitCount - 8)) & 0xFF;
+        BenchmarkJpegBytePut(value);
+        if(value == 0xFF)
+            BenchmarkJpegBytePut(0x00);
+        jpegBitCount -= 8;
+    }
+}
+
+/*********************************************************************
+* Function: void BenchmarkJpegBitsFlush(void)
+*
+* Overview: Pads the entropy coded data to a byte with 1 bits.
+*
+********************************************************************/
+static void BenchmarkJpegBitsFlush(void)
+{
+    if(jpegBitCount != 0)
+        BenchmarkJpegBitsPut(0xFF, 8 - jpegBitCount);
+    jpegBits = 0;
+}
+
+/*********************************************************************
+* Function: void BenchmarkJpegCodesCreate(const uint8_t *pBits,
+*                const uint8_t *pSymbols, uint16_t *pCode, uint8_t *pLength)
+*
+* Overview: Assigns the canonical Huffman codes of a table to its
+*           symbols.
+*
+********************************************************************/
+static void BenchmarkJpegCodesCreate(const uint8_t *pBits, const uint8_t *pSymbols, uint16_t *pCode, uint8_t *pLength)
+{
+    uint16_t code = 0, index = 0, length, i;
+
+    for(length = 1; length <= 16; length++)
+    {
+        for(i = 0; i < pBits[length]; i++, index++)
+        {
+            pCode[pSymbols[index]] = code++;
+            pLength[pSymbols[index]] = length;
+        }
+        code <<= 1;
+    }
+}
+
+/*********************************************************************
+* Function: void BenchmarkJpegTablesCreate(void)
+*
+* Overview: Builds the zigzag order, the quantization tables and the
+*           Huffman tables. The quantization tables are the example
+*           tables of the standard scaled to BENCHMARK_JPEG_QUALITY.
+*           The Huffman tables give short codes to the small values
+*           and the end of block, and codes of 10 bits to the rest, so
+*           codes of several lengths are decoded.
+*
+********************************************************************/
+static void BenchmarkJpegTablesCreate(void)
+{
+    static const uint8_t luminance[64] = {
+        16, 11, 10, 16, 24, 40, 51, 61,     12, 12, 14, 19, 26, 58, 60, 55,
+        14, 13, 16, 24, 40, 57, 69, 56,     14, 17, 22, 29, 51, 87, 80, 62,
+        18, 22, 37, 56, 68, 109, 103, 77,   24, 35, 55, 64, 81, 104, 113, 92,
+        49, 64, 78, 87, 103, 121, 120, 101, 72, 92, 95, 98, 112, 100, 103, 99 };
+    static const uint8_t chrominance[8] = { 17, 18, 24, 47, 66, 99, 99, 99 };
+    uint16_t    i, x = 0, y = 0, sum, run, quant;
+
+    // the coefficients go along the diagonals of the block
+    for(i = 0; i < 64; i++)
+    {
+        jpegZigzag[i] = (y * 8) + x;
+        if(((x + y) & 0x01) == 0)
+        {
+            if(x == 7)
+                y++;
+            else if(y == 0)
+                x++;
+            else
+                x++, y--;
+        }
+        else
+        {
+            if(y == 7)
+                x++;
+            else if(x == 0)
+                y++;
+            else
+                x--, y++;
+        }
+    }
+
+    for(i = 0; i < 64; i++)
+    {
+        x = jpegZigzag[i] & 0x07;
+        y = jpegZigzag[i] >> 3;
+
+        quant = ((luminance[jpegZigzag[i]] * (200 - (2 * BENCHMARK_JPEG_QUALITY))) + 50) / 100;
+        jpegQuant[0][i] = (quant < 1) ? 1 : quant;
+        quant = ((chrominance[(x > y) ? x : y] * (200 - (2 * BENCHMARK_JPEG_QUALITY))) + 50) / 100;
+        jpegQuant[1][i] = (quant < 1) ? 1 : quant;
+    }
+
+    // DC: sizes 0 and 1 with 2 bits, 2 and 3 with 3 bits, the rest with 6 bits
+    memset(jpegDCBits, 0, sizeof(jpegDCBits));
+    jpegDCBits[2] = 2;
+    jpegDCBits[3] = 2;
+    jpegDCBits[6] = 8;
+    for(i = 0; i < 12; i++)
+        jpegDCSymbols[i] = i;
+
+    // AC: the end of block, then the runs and sizes by their sum, then 16 zeros
+    i = 0;
+    jpegACSymbols[i++] = 0x00;
+    for(sum = 1; sum <= 25; sum++)
+        for(run = 0; run < 16; run++)
+            if((sum > run) && ((sum - run) <= 10))
+                jpegACSymbols[i++] = (run << 4) | (sum - run);
+    jpegACSymbols[i++] = 0xF0;
+
+    memset(jpegACBits, 0, sizeof(jpegACBits));
+    jpegACBits[2] = 1;
+    jpegACBits[3] = 3;
+    jpegACBits[5] = 4;
+    jpegACBits[10] = 162 - 8;
+
+    BenchmarkJpegCodesCreate(jpegDCBits, jpegDCSymbols, jpegDCCode, jpegDCLength);
+    BenchmarkJpegCodesCreate(jpegACBits, jpegACSymbols, jpegACCode, jpegACLength);
+}
+
+/*********************************************************************
+* Function: void BenchmarkJpegValuePut(int16_t value, uint16_t *pCode,
+*                uint8_t *pLength, uint8_t run)
+*
+* Overview: Appends the symbol of a value, preceded by run zero
+*           coefficients for the AC values, and the bits of the value.
+*           Negative values are stored minus one.
+*
+********************************************************************/
+static void BenchmarkJpegValuePut(int16_t value, uint16_t *pCode, uint8_t *pLength, uint8_t run)
+{
+    uint16_t    magnitude = (value < 0) ? -value : value;
+    uint8_t     size = 0, symbol;
+
+    while(magnitude >> size)
+        size++;
+
+    symbol = (run << 4) | size;
+    BenchmarkJpegBitsPut(pCode[symbol], pLength[symbol]);
+    if(size)
+        BenchmarkJpegBitsPut((value < 0) ? (value - 1) : value, size);
+}
+
+/*********************************************************************
+* Function: void BenchmarkJpegBlockPut(const uint8_t *pSample,
+*                uint8_t table, int16_t *pDCPrevious)
+*
+* Overview: Transforms, quantizes and codes an 8x8 block of samples.
+*
+********************************************************************/
+static void BenchmarkJpegBlockPut(const uint8_t *pSample, uint8_t table, int16_t *pDCPrevious)
+{
+    static double   cosine[8][8];
+    int16_t         coefficient[64];
+    double          sum;
+    uint16_t        u, v, x, y, k, run;
+
+    if(cosine[0][0] == 0)
+    {
+        for(u = 0; u < 8; u++)
+            for(x = 0; x < 8; x++)
+                cosine[u][x] = cos(((2 * x) + 1) * u * 3.14159265358979 / 16) * ((u == 0) ? sqrt(0.5) : 1.0);
+    }
+
+    for(k = 0; k < 64; k++)
+    {
+        u = jpegZigzag[k] & 0x07;
+        v = jpegZigzag[k] >> 3;
+
+        sum = 0;
+        for(y = 0; y < 8; y++)
+            for(x = 0; x < 8; x++)
+                sum += (pSample[(y * 8) + x] - 128) * cosine[u][x] * cosine[v][y];
+
+        coefficient[k] = (int16_t)floor((sum / 4 / jpegQuant[table][k]) + 0.5);
+    }
+
+    BenchmarkJpegValuePut(coefficient[0] - *pDCPrevious, jpegDCCode, jpegDCLength, 0);
+    *pDCPrevious = coefficient[0];
+
+    for(k = 1, run = 0; k < 64; k++)
+    {
+        if(coefficient[k] == 0)
+        {
+            run++;
+            continue;
+        }
+        for(; run >= 16; run -= 16)
+            BenchmarkJpegBitsPut(jpegACCode[0xF0], jpegACLength[0xF0]);
+        BenchmarkJpegValuePut(coefficient[k], jpegACCode, jpegACLength, run);
+        run = 0;
+    }
+    if(run)
+        BenchmarkJpegBitsPut(jpegACCode[0x00], jpegACLength[0x00]);
+}
+
+/*********************************************************************
+* Function: uint32_t BenchmarkJpegEncode(uint8_t *pDest, uint16_t width,
+*                uint16_t height, bool color)
+*
+* Overview: Encodes a baseline JPEG file. Color images have 2x2 MCUs of
+*           luminance with one block of each chrominance, averaged over
+*           2x2 pixels, and a restart marker every
+*           BENCHMARK_JPEG_RESTART_INTERVAL MCUs. Grayscale images use
+*           BenchmarkImageIndexGet() as the samples. Returns the size
+*           of the file.
+*
+********************************************************************/
+static uint32_t BenchmarkJpegEncode(uint8_t *pDest, uint16_t width, uint16_t height, bool color)
+{
+    uint8_t     sample[6][64], rgb[3];
+    int16_t     dcPrevious[3], luma, cb, cr;
+    uint16_t    mcuSize = color ? 16 : 8;
+    uint16_t    mcuX, mcuY, x, y, px, py, i, table, count = 0;
+    uint8_t     components = color ? 3 : 1;
+
+    pJpegDest = pDest;
+    jpegSize = 0;
+    jpegBits = 0;
+    jpegBitCount = 0;
+
+    BenchmarkJpegBytePut(0xFF);
+    BenchmarkJpegBytePut(0xD8);
+
+    BenchmarkJpegMarkerPut(0xDB, 65 * (color ? 2 : 1));
+    for(table = 0; table < (color ? 2 : 1); table++)
+    {
+        BenchmarkJpegBytePut(table);
+        for(i = 0; i < 64; i++)
+            BenchmarkJpegBytePut(jpegQuant[table][i]);
+    }
+
+    BenchmarkJpegMarkerPut(0xC0, 6 + (components * 3));
+    BenchmarkJpegBytePut(8);
+    BenchmarkJpegBytePut(height >> 8);
+    BenchmarkJpegBytePut(height & 0xFF);
+    BenchmarkJpegBytePut(width >> 8);
+    BenchmarkJpegBytePut(width & 0xFF);
+    BenchmarkJpegBytePut(components);
+    for(i = 0; i < components; i++)
+    {
+        BenchmarkJpegBytePut(i + 1);
+        BenchmarkJpegBytePut((color && (i == 0)) ? 0x22 : 0x11);
+        BenchmarkJpegBytePut((i == 0) ? 0 : 1);
+    }
+
+    // the same codes are stored as table 0 and table 1
+    BenchmarkJpegMarkerPut(0xC4, (17 + 12 + 17 + 162) * 2);
+    for(table = 0; table < 4; table++)
+    {
+        BenchmarkJpegBytePut(((table & 0x01) << 4) | (table >> 1));
+        for(i = 1; i <= 16; i++)
+            BenchmarkJpegBytePut((table & 0x01) ? jpegACBits[i] : jpegDCBits[i]);
+        for(i = 0; i < ((table & 0x01) ? 162 : 12); i++)
+            BenchmarkJpegBytePut((table & 0x01) ? jpegACSymbols[i] : jpegDCSymbols[i]);
+    }
+
+    if(color)
+    {
+        BenchmarkJpegMarkerPut(0xDD, 2);
+        BenchmarkJpegBytePut(0);
+        BenchmarkJpegBytePut(BENCHMARK_JPEG_RESTART_INTERVAL);
+    }
+
+    BenchmarkJpegMarkerPut(0xDA, 4 + (components * 2));
+    BenchmarkJpegBytePut(components);
+    for(i = 0; i < components; i++)
+    {
+        BenchmarkJpegBytePut(i + 1);
+        BenchmarkJpegBytePut((i == 0) ? 0x00 : 0x11);
+    }
+    BenchmarkJpegBytePut(0);
+    BenchmarkJpegBytePut(63);
+    BenchmarkJpegBytePut(0);
+
+    dcPrevious[0] = dcPrevious[1] = dcPrevious[2] = 0;
+    for(mcuY = 0; mcuY < height; mcuY += mcuSize)
+    {
+        for(mcuX = 0; mcuX < width; mcuX += mcuSize)
+        {
+            if(color && (count == BENCHMARK_JPEG_RESTART_INTERVAL))
+            {
+                BenchmarkJpegBitsFlush();
+                BenchmarkJpegBytePut(0xFF);
+                BenchmarkJpegBytePut(0xD0 + (((mcuY / mcuSize) * ((width + mcuSize - 1) / mcuSize) +
+                                              (mcuX / mcuSize)) / BENCHMARK_JPEG_RESTART_INTERVAL - 1) % 8);
+                dcPrevious[0] = dcPrevious[1] = dcPrevious[2] = 0;
+                count = 0;
+            }
+            count++;
+
+            memset(sample[4], 0, sizeof(sample[4]) * 2);
+            for(y = 0; y < mcuSize; y++)
+            {
+                for(x = 0; x < mcuSize; x++)
+                {
+                    // the edge pixels are repeated past the image
+                    px = ((mcuX + x) < width) ? (mcuX + x) : (width - 1);
+                    py = ((mcuY + y) < height) ? (mcuY + y) : (height - 1);
+
+                    if(!color)
+                    {
+                        sample[0][(y * 8) + x] = BenchmarkImageIndexGet(px % BENCHMARK_IMAGE_WIDTH, py * 2, 8);
+                        continue;
+                    }
+
+                    BenchmarkFileColorGet(px, py, rgb);
+                    luma = ((77 * rgb[0]) + (150 * rgb[1]) + (29 * rgb[2]) + 128) >> 8;
+                    cb = ((-43 * rgb[0]) - (85 * rgb[1]) + (128 * rgb[2]) + 128) >> 8;
+                    cr = ((128 * rgb[0]) - (107 * rgb[1]) - (21 * rgb[2]) + 128) >> 8;
+
+                    sample[((y >> 3) * 2) + (x >> 3)][((y & 0x07) * 8) + (x & 0x07)] = luma;
+                    sample[4][((y >> 1) * 8) + (x >> 1)] += (cb + 128 + 2) >> 2;
+                    sample[5][((y >> 1) * 8) + (x >> 1)] += (cr + 128 + 2) >> 2;
+                }
+            }
+
+            for(i = 0; i < (color ? 6 : 1); i++)
+                BenchmarkJpegBlockPut(sample[i], (i < 4) ? 0 : 1, &dcPrevious[(i < 4) ? 0 : (i - 3)]);
+        }
+    }
+
+    BenchmarkJpegBitsFlush();
+    BenchmarkJpegBytePut(0xFF);
+    BenchmarkJpegBytePut(0xD9);
+
+    return (jpegSize);
+}
+
+#endif // #ifdef GFX_CONFIG_JPEG_DECODE_ENABLE
+
+#ifdef GFX_CONFIG_PNG_DECODE_ROW_SIZE
+
+#define BENCHMARK_PNG_CHUNK_SIZE        1024
+
+/*********************************************************************
+* Function: uint32_t BenchmarkPngCrcGet(const uint8_t *pData, uint32_t size)
+*
+* Overview: Returns the CRC-32 of a PNG chunk.
+*
+********************************************************************/
+static uint32_t BenchmarkPngCrcGet(const uint8_t *pData, uint32_t size)
+{
+    uint32_t    crc = 0xFFFFFFFFUL;
+    uint8_t     i;
+
+    while(size--)
+    {
+        crc ^= *pData++;
+        for(i = 0; i < 8; i++)
+            crc = (crc >> 1) ^ ((crc & 0x01) ? 0xEDB88320UL : 0);
+    }
+    return (crc ^ 0xFFFFFFFFUL);
+}
+
+/*********************************************************************
+* Function: uint32_t BenchmarkPngValuePut(uint8_t *pDest, uint32_t value)
+*
+* Overview: Stores a big endian 32 bit value, returns its size.
+*
+********************************************************************/
+static uint32_t BenchmarkPngValuePut(uint8_t *pDest, uint32_t value)
+{
+    pDest[0] = value >> 24;
+    pDest[1] = (value >> 16) & 0xFF;
+    pDest[2] = (value >> 8) & 0xFF;
+    pDest[3] = value & 0xFF;
+    return (4);
+}
+
+/*********************************************************************
+* Function: uint32_t BenchmarkPngChunkPut(uint8_t *pDest, const char *pType,
+*                const uint8_t *pData, uint32_t length)
+*
+* Overview: Stores a chunk with its length, type and CRC, returns its
+*           size.
+*
+********************************************************************/
+static uint32_t BenchmarkPngChunkPut(uint8_t *pDest, const char *pType, const uint8_t *pData, uint32_t length)
+{
+    BenchmarkPngValuePut(pDest, length);
+    memcpy(&pDest[4], pType, 4);
+    if(length)
+        memcpy(&pDest[8], pData, length);
+    BenchmarkPngValuePut(&pDest[8 + length], BenchmarkPngCrcGet(&pDest[4], length + 4));
+    return (length + 12);
+}
+
+/*********************************************************************
+* Function: uint8_t BenchmarkPngPredictorGet(uint8_t filter, uint8_t left,
+*                uint8_t above, uint8_t aboveLeft)
+*
+* Overview: Returns the prediction of a byte by a PNG row filter.
+*
+********************************************************************/
+static uint8_t BenchmarkPngPredictorGet(uint8_t filter, uint8_t left, uint8_t above, uint8_t aboveLeft)
+{
+    int16_t estimate, distanceLeft, distanceAbove, distanceAboveLeft;
+
+    switch(filter)
+    {
+        case 1:     return (left);
+        case 2:     return (above);
+        case 3:     return ((left + above) >> 1);
+        case 4:
+            estimate = left + above - aboveLeft;
+            distanceLeft = abs(estimate - left);
+            distanceAbove = abs(estimate - above);
+            distanceAboveLeft = abs(estimate - aboveLeft);
+            if((distanceLeft <= distanceAbove) && (distanceLeft <= distanceAboveLeft))
+                return (left);
+            return ((distanceAbove <= distanceAboveLeft) ? above : aboveLeft);
+        default:    return (0);
+    }
+}
+
+/*********************************************************************
+* Function: uint32_t BenchmarkPngEncode(uint8_t *pDest, uint16_t width,
+*                uint16_t height, bool palette)
+*
+* Overview: Encodes a PNG file of RGB pixels from BenchmarkFileColorGet()
+*           or of 8 bit palette indexes from BenchmarkImageIndexGet().
+*           The rows use the five filters in turn and the compressed
+*           data is split into IDAT chunks of BENCHMARK_PNG_CHUNK_SIZE
+*           bytes. Returns the size of the file.
+*
+********************************************************************/
+static uint32_t BenchmarkPngEncode(uint8_t *pDest, uint16_t width, uint16_t height, bool palette)
+{
+    static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+    static uint8_t  compressed[BENCHMARK_FILE_SIZE];
+    uint8_t         header[13], colors[256 * 3], *pRow, *pAbove;
+    uint16_t        pixelBytes = palette ? 1 : 3, rowBytes = width * pixelBytes;
+    uint16_t        x, y, i;
+    uint32_t        size, compressedSize, adler1 = 1, adler2 = 0, offset;
+
+    // the rows are built and filtered in place from the last one
+    for(y = 0; y < height; y++)
+    {
+        pRow = &fileBuffer[(y * (rowBytes + 1)) + 1];
+        for(x = 0; x < width; x++)
+        {
+            if(palette)
+                pRow[x] = BenchmarkImageIndexGet(x % BENCHMARK_IMAGE_WIDTH, y * 2, 8);
+            else
+                BenchmarkFileColorGet(x, y, &pRow[x * 3]);
+        }
+    }
+    for(y = height; y-- > 0; )
+    {
+        pRow = &fileBuffer[(y * (rowBytes + 1)) + 1];
+        pAbove = pRow - (rowBytes + 1);
+        pRow[-1] = y % 5;
+
+        for(i = rowBytes; i-- > 0; )
+        {
+            pRow[i] -= BenchmarkPngPredictorGet(
+                            pRow[-1],
+                            (i >= pixelBytes) ? pRow[i - pixelBytes] : 0,
+                            (y > 0) ? pAbove[i] : 0,
+                            ((y > 0) && (i >= pixelBytes)) ? pAbove[i - pixelBytes] : 0);
+        }
+    }
+
+    size = height * (rowBytes + 1);
+    for(offset = 0; offset < size; offset++)
+    {
+        adler1 = (adler1 + fileBuffer[offset]) % 65521;
+        adler2 = (adler2 + adler1) % 65521;
+    }
+
+    // zlib stream with a window of 1024 bytes
+    compressed[0] = 0x28;
+    compressed[1] = 0x15;
+    compressedSize = 2 + BenchmarkDeflateEncode(&compressed[2], fileBuffer, size);
+    compressedSize += BenchmarkPngValuePut(&compressed[compressedSize], (adler2 << 16) | adler1);
+
+    memcpy(pDest, signature, sizeof(signature));
+    size = sizeof(signature);
+
+    BenchmarkPngValuePut(&header[0], width);
+    BenchmarkPngValuePut(&header[4], height);
+    header[8] = 8;
+    header[9] = palette ? 3 : 2;
+    header[10] = header[11] = header[12] = 0;
+    size += BenchmarkPngChunkPut(&pDest[size], "IHDR", header, sizeof(header));
+
+    if(palette)
+    {
+        for(i = 0; i < 256; i++)
+        {
+            colors[(i * 3)] = i;
+            colors[(i * 3) + 1] = 255 - i;
+            colors[(i * 3) + 2] = (i * 97) & 0xFF;
+        }
+        size += BenchmarkPngChunkPut(&pDest[size], "PLTE", colors, sizeof(colors));
+    }
+
+    for(offset = 0; offset < compressedSize; offset += BENCHMARK_PNG_CHUNK_SIZE)
+    {
+        size += BenchmarkPngChunkPut(&pDest[size], "IDAT", &compressed[offset],
+                    ((compressedSize - offset) < BENCHMARK_PNG_CHUNK_SIZE) ? (compressedSize - offset) : BENCHMARK_PNG_CHUNK_SIZE);
+    }
+    size += BenchmarkPngChunkPut(&pDest[size], "IEND", NULL, 0);
+
+    return (size);
+}
+
+#endif // #ifdef GFX_CONFIG_PNG_DECODE_ROW_SIZE
+
+/*********************************************************************
+* Function: void BenchmarkFileCreate(BENCHMARK_FILE file)
+*
+* Overview: Builds a JPEG or PNG file in RAM and creates its image
+*           resource with GFX_ImageFileCreate().
+*
+********************************************************************/
+static void BenchmarkFileCreate(BENCHMARK_FILE file)
+{
+    uint32_t    size = 0;
+
+    switch(file)
+    {
+#ifdef GFX_CONFIG_JPEG_DECODE_ENABLE
+        case BENCHMARK_FILE_JPEG:
+            size = BenchmarkJpegEncode(fileData[file], BENCHMARK_IMAGE_WIDTH, BENCHMARK_IMAGE_HEIGHT, true);
+            break;
+        case BENCHMARK_FILE_JPEG_WIDE:
+            size = BenchmarkJpegEncode(fileData[file], BENCHMARK_WIDE_WIDTH, BENCHMARK_WIDE_HEIGHT, false);
+            break;
+#endif
+#ifdef GFX_CONFIG_PNG_DECODE_ROW_SIZE
+        case BENCHMARK_FILE_PNG:
+            size = BenchmarkPngEncode(fileData[file], BENCHMARK_IMAGE_WIDTH, BENCHMARK_IMAGE_HEIGHT, false);
+            break;
+        case BENCHMARK_FILE_PNG_WIDE:
+            size = BenchmarkPngEncode(fileData[file], BENCHMARK_WIDE_WIDTH, BENCHMARK_WIDE_HEIGHT, true);
+            break;
+#endif
+        default:
+            break;
+    }
+
+    benchmarkFile[file].disk = fileData[file];
+    benchmarkFile[file].size = size;
+    benchmarkFile[file].absoluteOffset = 0;
+
+    if(GFX_ImageFileCreate(&imageFile[file], &benchmarkFile[file], 0) != GFX_STATUS_SUCCESS)
+    {
+        fprintf(stderr, "image file %d not supported\n", file);
+        exit(EXIT_FAILURE);
+    }
+}
+
+/*********************************************************************
+* Function: size_t FILEIO_Read(void *buffer, size_t size, size_t count, FILEIO_OBJECT *handle)
+*
+* Overview: Reads the JPEG and PNG files of the benchmark from RAM,
+*           the fileio library is not linked.
+*
+********************************************************************/
+size_t FILEIO_Read(void *buffer, size_t size, size_t count, FILEIO_OBJECT *handle)
+{
+    uint32_t available = handle->size - handle->absoluteOffset;
+
+    if((size == 0) || (count > (available / size)))
+        count = (size == 0) ? 0 : (available / size);
+
+    memcpy(buffer, (uint8_t *)handle->disk + handle->absoluteOffset, size * count);
+    handle->absoluteOffset += size * count;
+
+    return (count);
+}
+
+/*********************************************************************
+* Function: int FILEIO_Seek(FILEIO_OBJECT *handle, int32_t offset, int base)
+*
+* Overview: Moves the position in a RAM file.
+*
+********************************************************************/
+int FILEIO_Seek(FILEIO_OBJECT *handle, int32_t offset, int base)
+{
+    int32_t position;
+
+    if(base == FILEIO_SEEK_SET)
+        position = offset;
+    else if(base == FILEIO_SEEK_CUR)
+        position = handle->absoluteOffset + offset;
+    else
+        position = handle->size - offset;
+
+    if((position < 0) || (position > (int32_t)handle->size))
+        return (FILEIO_RESULT_FAILURE);
+
+    handle->absoluteOffset = position;
+    return (FILEIO_RESULT_SUCCESS);
+}
+
+/*********************************************************************
+* Function: long FILEIO_Tell(FILEIO_OBJECT *handle)
+*
+* Overview: Returns the position in a RAM file.
+*
+********************************************************************/
+long FILEIO_Tell(FILEIO_OBJECT *handle)
+{
+    return (handle->absoluteOffset);
+}
+
+#endif // #if defined (GFX_CONFIG_JPEG_DECODE_ENABLE) || defined (GFX_CONFIG_PNG_DECODE_ROW_SIZE)
+
+/*********************************************************************
+* Function: void BenchmarkResourcesCreate(void)
+*
+* Overview: Builds the fonts, images and GOL scheme of the benchmark.
+*
+********************************************************************/
+static void BenchmarkResourcesCreate(void)
+{
+    BENCHMARK_IMAGE image;
+#if defined (GFX_CONFIG_JPEG_DECODE_ENABLE) || defined (GFX_CONFIG_PNG_DECODE_ROW_SIZE)
+    BENCHMARK_FILE  file;
+#endif
+    uint32_t        size;
+
+    BenchmarkFontCreate(fontData[0], 1);
+    fontFlash1BPP.type = GFX_RESOURCE_FONT_FLASH_NONE;
+    fontFlash1BPP.resource.font.location.progByteAddress = (GFX_FONT_SPACE char *)fontData[0];
+    fontFlash1BPP.resource.font.header = *(GFX_FONT_HEADER *)fontData[0];
+
+    BenchmarkFontCreate(fontData[1], 2);
+    fontFlash2BPP.type = GFX_RESOURCE_FONT_FLASH_NONE;
+    fontFlash2BPP.resource.font.location.progByteAddress = (GFX_FONT_SPACE char *)fontData[1];
+    fontFlash2BPP.resource.font.header = *(GFX_FONT_HEADER *)fontData[1];
+
+    size = BenchmarkFontCreate(fontData[0], 1);
+    fontExternal1BPP.type = GFX_RESOURCE_FONT_EXTERNAL_NONE;
+    fontExternal1BPP.resource.font.location.extAddress = BenchmarkExternalCopy(fontData[0], size);
+    fontExternal1BPP.resource.font.header = *(GFX_FONT_HEADER *)fontData[0];
+
+    for(image = 0; image < BENCHMARK_IMAGE_COUNT; image++)
+        BenchmarkImageCreate(image);
+
+#if defined (GFX_CONFIG_JPEG_DECODE_ENABLE) || defined (GFX_CONFIG_PNG_DECODE_ROW_SIZE)
+#ifdef GFX_CONFIG_JPEG_DECODE_ENABLE
+    BenchmarkJpegTablesCreate();
+#endif
+    for(file = 0; file < BENCHMARK_FILE_COUNT; file++)
+        BenchmarkFileCreate(file);
+#ifdef GFX_CONFIG_JPEG_DECODE_ENABLE
+    benchmarkFile[BENCHMARK_FILE_JPEG].absoluteOffset = 0;
+    GFX_ImageFileCreate(&imageFileJpegHalf, &benchmarkFile[BENCHMARK_FILE_JPEG], 1);
+#endif
+#endif
+
+    benchmarkScheme = GOLSchemeDefault;
+    benchmarkScheme.pFont = &fontFlash1BPP;
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_ExternalResourceCallback(
+                                GFX_RESOURCE_HDR *pResource,
+                                uint32_t offset,
+                                uint16_t nCount,
+                                void *pBuffer)
+
+    Summary:
+        Reads resources from the emulated external memory.
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_ExternalResourceCallback(
+                                GFX_RESOURCE_HDR *pResource,
+                                uint32_t offset,
+                                uint16_t nCount,
+                                void *pBuffer)
+{
+    uint32_t address;
+
+    if((pResource->type & GFX_TYPE_MASK) == GFX_RESOURCE_TYPE_FONT)
+        address = pResource->resource.font.location.extAddress;
+    else
+        address = pResource->resource.image.location.extAddress;
+
+    externalReads++;
+    address += offset;
+    if((address + nCount) > externalMemoryUsed)
+        return (GFX_STATUS_FAILURE);
+
+    memcpy(pBuffer, &externalMemory[address], nCount);
+
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Benchmark Cases
+// *****************************************************************************
+// *****************************************************************************
+
+typedef struct
+{
+    const char  *name;                          // name of the case
+    void        (*pSetup)(void);                // sets the rendering state, not timed
+    void        (*pRun)(uint32_t iteration);    // renders one primitive
+} BENCHMARK_CASE;
+
+static uint32_t randomSeed;
+
+/*********************************************************************
+* Function: uint16_t BenchmarkRandomGet(uint16_t range)
+*
+* Overview: Deterministic pseudo random numbers, every case renders the
+*           same frame on every run.
+*
+********************************************************************/
+static uint16_t BenchmarkRandomGet(uint16_t range)
+{
+    randomSeed = (randomSeed * 1103515245UL) + 12345UL;
+
+    return ((uint16_t)((randomSeed >> 16) % range));
+}
+
+static void BenchmarkColorNext(void)
+{
+    GFX_ColorSet(GFX_RGBConvert(BenchmarkRandomGet(256), BenchmarkRandomGet(256), BenchmarkRandomGet(256)));
+}
+
+static void BenchmarkLineRun(uint32_t iteration)
+{
+    BenchmarkColorNext();
+    GFX_LineDraw(   BenchmarkRandomGet(GFX_MaxXGet() - 2) + 1,
+                    BenchmarkRandomGet(GFX_MaxYGet() - 2) + 1,
+                    BenchmarkRandomGet(GFX_MaxXGet() - 2) + 1,
+                    BenchmarkRandomGet(GFX_MaxYGet() - 2) + 1);
+}
+
+static void BenchmarkLineHorVerRun(uint32_t iteration)
+{
+    uint16_t position;
+
+    BenchmarkColorNext();
+    if(iteration & 0x01)
+    {
+        position = BenchmarkRandomGet(GFX_MaxYGet() - 2) + 1;
+        GFX_LineDraw(1, position, GFX_MaxXGet() - 1, position);
+    }
+    else
+    {
+        position = BenchmarkRandomGet(GFX_MaxXGet() - 2) + 1;
+        GFX_LineDraw(position, 1, position, GFX_MaxYGet() - 1);
+    }
+}
+
+static void BenchmarkThinSolidSetup(void)   { GFX_LineStyleSet(GFX_LINE_STYLE_THIN_SOLID); }
+static void BenchmarkThickSolidSetup(void)  { GFX_LineStyleSet(GFX_LINE_STYLE_THICK_SOLID); }
+static void BenchmarkThinDashedSetup(void)  { GFX_LineStyleSet(GFX_LINE_STYLE_THIN_DASHED); }
+static void BenchmarkThickDottedSetup(void) { GFX_LineStyleSet(GFX_LINE_STYLE_THICK_DOTTED); }
+static void BenchmarkAntiAliasedSetup(void) { GFX_LineStyleSet(GFX_LINE_STYLE_ANTI_ALIASED); }
+static void BenchmarkThickAntiAliasedSetup(void) { GFX_LineStyleSet(GFX_LINE_STYLE_THICK_ANTI_ALIASED); }
+
+static void BenchmarkCircleRun(uint32_t iteration)
+{
+    uint16_t radius = BenchmarkRandomGet(40) + 4;
+
+    BenchmarkColorNext();
+    GFX_CircleDraw( BenchmarkRandomGet(GFX_MaxXGet() - 100) + 50,
+                    BenchmarkRandomGet(GFX_MaxYGet() - 100) + 50,
+                    radius);
+}
+
+static void BenchmarkBarRun(uint32_t iteration)
+{
+    uint16_t left = BenchmarkRandomGet(GFX_MaxXGet() - 64);
+    uint16_t top = BenchmarkRandomGet(GFX_MaxYGet() - 48);
+
+    BenchmarkColorNext();
+    GFX_RectangleFillDraw(left, top, left + 63, top + 47);
+}
+
+static void BenchmarkRoundRun(uint32_t iteration)
+{
+    uint16_t left = BenchmarkRandomGet(GFX_MaxXGet() - 96) + 8;
+    uint16_t top = BenchmarkRandomGet(GFX_MaxYGet() - 64) + 8;
+
+    BenchmarkColorNext();
+    GFX_RectangleRoundFillDraw(left, top, left + 63, top + 31, 8);
+}
+
+static void BenchmarkSolidSetup(void)
+{
+    GFX_FillStyleSet(GFX_FILL_STYLE_COLOR);
+}
+
+static void BenchmarkAlphaSetup(void)
+{
+    GFX_FillStyleSet(GFX_FILL_STYLE_ALPHA_COLOR);
+    GFX_AlphaBlendingValueSet(50);
+    GFX_BackgroundTypeSet(GFX_BACKGROUND_DISPLAY_BUFFER);
+}
+
+static void BenchmarkAlphaFadeSetup(void)
+{
+    GFX_FillStyleSet(GFX_FILL_STYLE_ALPHA_COLOR);
+    GFX_BackgroundTypeSet(GFX_BACKGROUND_DISPLAY_BUFFER);
+}
+
+static void BenchmarkAlphaFadeRun(uint32_t iteration)
+{
+    // steps through all the alpha values as a fade does
+    GFX_AlphaBlendingValueSet((iteration % 99) + 1);
+    BenchmarkBarRun(iteration);
+}
+
+static void BenchmarkGradientSetup(void)
+{
+    GFX_FillStyleSet(GFX_FILL_STYLE_GRADIENT_DOWN);
+    GFX_GradientColorSet(GFX_RGBConvert(0x20, 0x40, 0xC0), GFX_RGBConvert(0xF0, 0xF0, 0x40));
+}
+
+static void BenchmarkGradientDoubleSetup(void)
+{
+    GFX_FillStyleSet(GFX_FILL_STYLE_GRADIENT_DOUBLE_HOR);
+    GFX_GradientColorSet(GFX_RGBConvert(0x20, 0x40, 0xC0), GFX_RGBConvert(0xF0, 0xF0, 0x40));
+}
+
+static void BenchmarkGradientRightSetup(void)
+{
+    GFX_FillStyleSet(GFX_FILL_STYLE_GRADIENT_RIGHT);
+    GFX_GradientColorSet(GFX_RGBConvert(0x20, 0x40, 0xC0), GFX_RGBConvert(0xF0, 0xF0, 0x40));
+}
+
+static void BenchmarkTextRun(uint32_t iteration)
+{
+    BenchmarkColorNext();
+    GFX_TextStringDraw( BenchmarkRandomGet(16),
+                        BenchmarkRandomGet(GFX_MaxYGet() - BENCHMARK_FONT_HEIGHT),
+                        benchmarkText, 0);
+}
+
+static void BenchmarkText1BPPSetup(void)
+{
+    GFX_FontSet(&fontFlash1BPP);
+}
+
+static void BenchmarkTextExternalSetup(void)
+{
+    GFX_FontSet(&fontExternal1BPP);
+}
+
+static void BenchmarkTextOpaqueSetup(void)
+{
+    GFX_FontSet(&fontFlash2BPP);
+    GFX_FontAntiAliasSet(GFX_FONT_ANTIALIAS_OPAQUE);
+}
+
+static void BenchmarkTextTranslucentSetup(void)
+{
+    GFX_FontSet(&fontFlash2BPP);
+    GFX_FontAntiAliasSet(GFX_FONT_ANTIALIAS_TRANSLUCENT);
+}
+
+static void BenchmarkTextMeterSetup(void)
+{
+    GFX_FontSet(&fontExternal1BPP);
+    GFX_ColorSet(GFX_RGBConvert(0x40, 0xFF, 0x40));
+}
+
+static void BenchmarkTextMeterRun(uint32_t iteration)
+{
+    GFX_XCHAR   meterText[8];
+    int16_t     i;
+
+    // redraw a counter in a fixed color, as a digital meter does
+    meterText[7] = 0;
+    meterText[4] = '.';
+    for(i = 6; i >= 0; i--)
+    {
+        if (i == 4)
+            continue;
+        meterText[i] = '0' + (iteration % 10);
+        iteration /= 10;
+    }
+    GFX_TextStringDraw(16, 16 + (BENCHMARK_FONT_HEIGHT * (iteration % 8)), meterText, 0);
+}
+
+static void BenchmarkTextWidthRun(uint32_t iteration)
+{
+    static uint16_t width;
+
+    // measures the string, as the objects do to align their text
+    width += GFX_TextStringWidthGet(&benchmarkText[iteration % 16], GFX_FontGet());
+}
+
+static GFX_RESOURCE_HDR *pBenchmarkImage;
+
+static void BenchmarkImageRun(uint32_t iteration)
+{
+    GFX_ImageDraw(  BenchmarkRandomGet(GFX_MaxXGet() - BENCHMARK_IMAGE_WIDTH),
+                    BenchmarkRandomGet(GFX_MaxYGet() - BENCHMARK_IMAGE_HEIGHT),
+                    pBenchmarkImage);
+}
+
+static void BenchmarkImagePartialRun(uint32_t iteration)
+{
+    GFX_ImagePartialDraw(   BenchmarkRandomGet(GFX_MaxXGet() - BENCHMARK_IMAGE_WIDTH),
+                            BenchmarkRandomGet(GFX_MaxYGet() - BENCHMARK_IMAGE_HEIGHT),
+                            8, BENCHMARK_IMAGE_HEIGHT / 2, BENCHMARK_IMAGE_WIDTH / 2, BENCHMARK_IMAGE_HEIGHT / 4,
+                            pBenchmarkImage);
+}
+
+static void BenchmarkImageScrollRun(uint32_t iteration)
+{
+    // a window over the image that moves down one row per call
+    GFX_ImagePartialDraw(   16, 16,
+                            0, iteration % ((BENCHMARK_IMAGE_HEIGHT * 3 / 4) + 1),
+                            BENCHMARK_IMAGE_WIDTH, BENCHMARK_IMAGE_HEIGHT / 4,
+                            pBenchmarkImage);
+}
+
+#if defined (GFX_CONFIG_JPEG_DECODE_ENABLE) || defined (GFX_CONFIG_PNG_DECODE_ROW_SIZE)
+static void BenchmarkImageWideRun(uint32_t iteration)
+{
+    // the image is wider than the screen and runs past its right edge
+    GFX_ImageDraw(  BenchmarkRandomGet(GFX_MaxXGet()),
+                    BenchmarkRandomGet(GFX_MaxYGet()),
+                    pBenchmarkImage);
+}
+
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+static void BenchmarkImageClipRun(uint32_t iteration)
+{
+    uint16_t left = BenchmarkRandomGet(GFX_MaxXGet() - BENCHMARK_IMAGE_WIDTH);
+    uint16_t top = BenchmarkRandomGet(GFX_MaxYGet() - BENCHMARK_WIDE_HEIGHT);
+
+    // only a window of the image is decoded
+    GFX_ClipPush(left, top, left + BENCHMARK_IMAGE_WIDTH - 1, top + BENCHMARK_WIDE_HEIGHT - 1);
+    GFX_ImageDraw(0, top, pBenchmarkImage);
+    GFX_ClipPop();
+}
+#endif
+#endif
+
+#define BENCHMARK_IMAGE_SETUP(name, resource)       \
+    static void name(void) { pBenchmarkImage = &(resource); }
+
+BENCHMARK_IMAGE_SETUP(BenchmarkFlash1BPPSetup,     imageFlash[BENCHMARK_IMAGE_1BPP])
+BENCHMARK_IMAGE_SETUP(BenchmarkFlash4BPPSetup,     imageFlash[BENCHMARK_IMAGE_4BPP])
+BENCHMARK_IMAGE_SETUP(BenchmarkFlash8BPPSetup,     imageFlash[BENCHMARK_IMAGE_8BPP])
+BENCHMARK_IMAGE_SETUP(BenchmarkFlash16BPPSetup,    imageFlash[BENCHMARK_IMAGE_16BPP])
+BENCHMARK_IMAGE_SETUP(BenchmarkFlashRLE4Setup,     imageFlash[BENCHMARK_IMAGE_RLE4])
+BENCHMARK_IMAGE_SETUP(BenchmarkFlashRLE8Setup,     imageFlash[BENCHMARK_IMAGE_RLE8])
+BENCHMARK_IMAGE_SETUP(BenchmarkExternal1BPPSetup,  imageExternal[BENCHMARK_IMAGE_1BPP])
+BENCHMARK_IMAGE_SETUP(BenchmarkExternal4BPPSetup,  imageExternal[BENCHMARK_IMAGE_4BPP])
+BENCHMARK_IMAGE_SETUP(BenchmarkExternal8BPPSetup,  imageExternal[BENCHMARK_IMAGE_8BPP])
+BENCHMARK_IMAGE_SETUP(BenchmarkExternal16BPPSetup, imageExternal[BENCHMARK_IMAGE_16BPP])
+BENCHMARK_IMAGE_SETUP(BenchmarkExternalRLE4Setup,  imageExternal[BENCHMARK_IMAGE_RLE4])
+BENCHMARK_IMAGE_SETUP(BenchmarkExternalRLE8Setup,  imageExternal[BENCHMARK_IMAGE_RLE8])
+#ifndef GFX_CONFIG_IPU_DECODE_DISABLE
+BENCHMARK_IMAGE_SETUP(BenchmarkFlashIPU8Setup,     imageFlash[BENCHMARK_IMAGE_IPU8])
+BENCHMARK_IMAGE_SETUP(BenchmarkFlashIPU16Setup,    imageFlash[BENCHMARK_IMAGE_IPU16])
+BENCHMARK_IMAGE_SETUP(BenchmarkExternalIPU8Setup,  imageExternal[BENCHMARK_IMAGE_IPU8])
+BENCHMARK_IMAGE_SETUP(BenchmarkExternalIPU16Setup, imageExternal[BENCHMARK_IMAGE_IPU16])
+#endif
+#ifdef GFX_CONFIG_JPEG_DECODE_ENABLE
+BENCHMARK_IMAGE_SETUP(BenchmarkFileJpegSetup,      imageFile[BENCHMARK_FILE_JPEG])
+BENCHMARK_IMAGE_SETUP(BenchmarkFileJpegHalfSetup,  imageFileJpegHalf)
+BENCHMARK_IMAGE_SETUP(BenchmarkFileJpegWideSetup,  imageFile[BENCHMARK_FILE_JPEG_WIDE])
+#endif
+#ifdef GFX_CONFIG_PNG_DECODE_ROW_SIZE
+BENCHMARK_IMAGE_SETUP(BenchmarkFilePngSetup,       imageFile[BENCHMARK_FILE_PNG])
+BENCHMARK_IMAGE_SETUP(BenchmarkFilePngWideSetup,   imageFile[BENCHMARK_FILE_PNG_WIDE])
+#endif
+
+#define BENCHMARK_BACKGROUND_LEFT       16
+#define BENCHMARK_BACKGROUND_TOP        16
+
+static void BenchmarkAlphaImageSetup(GFX_RESOURCE_HDR *pImage)
+{
+    GFX_ImageDraw(BENCHMARK_BACKGROUND_LEFT, BENCHMARK_BACKGROUND_TOP, pImage);
+    GFX_BackgroundSet(BENCHMARK_BACKGROUND_LEFT, BENCHMARK_BACKGROUND_TOP, pImage, 0);
+    GFX_BackgroundTypeSet(GFX_BACKGROUND_IMAGE);
+    GFX_FillStyleSet(GFX_FILL_STYLE_ALPHA_COLOR);
+    GFX_AlphaBlendingValueSet(40);
+}
+
+static void BenchmarkAlphaFlash8BPPSetup(void)      { BenchmarkAlphaImageSetup(&imageFlash[BENCHMARK_IMAGE_8BPP]); }
+static void BenchmarkAlphaExternal8BPPSetup(void)   { BenchmarkAlphaImageSetup(&imageExternal[BENCHMARK_IMAGE_8BPP]); }
+static void BenchmarkAlphaExternalRLE8Setup(void)   { BenchmarkAlphaImageSetup(&imageExternal[BENCHMARK_IMAGE_RLE8]); }
+
+static void BenchmarkAlphaImageRun(uint32_t iteration)
+{
+    // the bar stays within the background image, as a translucent panel does
+    uint16_t left = BENCHMARK_BACKGROUND_LEFT + BenchmarkRandomGet(BENCHMARK_IMAGE_WIDTH - 48);
+    uint16_t top = BENCHMARK_BACKGROUND_TOP + BenchmarkRandomGet(BENCHMARK_IMAGE_HEIGHT - 32);
+
+    BenchmarkColorNext();
+    GFX_RectangleFillDraw(left, top, left + 47, top + 31);
+}
+
+static GFX_CONTEXT benchmarkLineContext, benchmarkTextContext;
+
+static void BenchmarkContextSetup(void)
+{
+    GFX_ContextInitialize(&benchmarkLineContext);
+    GFX_ContextSet(&benchmarkLineContext);
+    GFX_LineStyleSet(GFX_LINE_STYLE_THICK_SOLID);
+
+    GFX_ContextInitialize(&benchmarkTextContext);
+    GFX_ContextSet(&benchmarkTextContext);
+    GFX_FontSet(&fontFlash1BPP);
+}
+
+static void BenchmarkContextRun(uint32_t iteration)
+{
+    // each context keeps its own style, nothing is set again on a switch
+    GFX_ContextSet(&benchmarkLineContext);
+    BenchmarkLineRun(iteration);
+
+    GFX_ContextSet(&benchmarkTextContext);
+    BenchmarkTextRun(iteration);
+}
+
+#define BENCHMARK_PANEL_ROWS            8
+#define BENCHMARK_PANEL_ROW_HEIGHT      4
+
+static void BenchmarkPanelRun(uint32_t iteration)
+{
+    uint16_t i, row;
+    uint16_t left = BenchmarkRandomGet(GFX_MaxXGet() - BENCHMARK_IMAGE_WIDTH);
+    uint16_t top = BenchmarkRandomGet(GFX_MaxYGet() - BENCHMARK_IMAGE_HEIGHT -
+                                      (BENCHMARK_PANEL_ROWS * BENCHMARK_PANEL_ROW_HEIGHT));
+
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    GFX_DisplayListBegin();
+#endif
+
+    // the panel background is hidden by the image drawn over it
+    BenchmarkColorNext();
+    GFX_BarDraw(left, top, left + BENCHMARK_IMAGE_WIDTH - 1, top + BENCHMARK_IMAGE_HEIGHT - 1);
+    GFX_ImageDraw(left, top, &imageFlash[BENCHMARK_IMAGE_8BPP]);
+
+    // the rows below the image have one color, as the items of a list
+    for(i = 0; i < BENCHMARK_PANEL_ROWS; i++)
+    {
+        row = top + BENCHMARK_IMAGE_HEIGHT + (i * BENCHMARK_PANEL_ROW_HEIGHT);
+        GFX_BarDraw(left, row, left + BENCHMARK_IMAGE_WIDTH - 1, row + BENCHMARK_PANEL_ROW_HEIGHT - 1);
+    }
+
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    GFX_DisplayListEnd();
+#endif
+}
+
+static void BenchmarkPanelPixelsRun(uint32_t iteration)
+{
+    GFX_COLOR row[BENCHMARK_IMAGE_WIDTH];
+    uint16_t i;
+    uint16_t left = BenchmarkRandomGet(GFX_MaxXGet() - BENCHMARK_IMAGE_WIDTH);
+    uint16_t top = BenchmarkRandomGet(GFX_MaxYGet() - BENCHMARK_IMAGE_HEIGHT);
+
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    GFX_DisplayListBegin();
+#endif
+
+    // the pixels are drawn over the recorded background
+    BenchmarkColorNext();
+    GFX_BarDraw(left, top, left + BENCHMARK_IMAGE_WIDTH - 1, top + BENCHMARK_IMAGE_HEIGHT - 1);
+
+    BenchmarkColorNext();
+    for(i = 0; i < BENCHMARK_IMAGE_HEIGHT; i++)
+        GFX_PixelPut(left + i, top + i);
+
+    for(i = 0; i < BENCHMARK_IMAGE_WIDTH; i++)
+        row[i] = (i & 0x01) ? GFX_ColorGet() : GFX_RGBConvert(0, 0, 0);
+    GFX_PixelArrayPut(left, top + (BENCHMARK_IMAGE_HEIGHT >> 1), row, BENCHMARK_IMAGE_WIDTH);
+
+    // the bar recorded after the pixels hides part of them
+    BenchmarkColorNext();
+    GFX_BarDraw(left + (BENCHMARK_IMAGE_WIDTH >> 1), top + (BENCHMARK_IMAGE_HEIGHT >> 2),
+                left + BENCHMARK_IMAGE_WIDTH - 1, top + (BENCHMARK_IMAGE_HEIGHT >> 1) + 4);
+
+#ifdef GFX_CONFIG_DISPLAY_LIST_SIZE
+    GFX_DisplayListEnd();
+#endif
+}
+
+#define BENCHMARK_NEEDLE_LENGTH         80
+#define BENCHMARK_NEEDLE_WIDTH          6
+
+/*********************************************************************
+* Function: void BenchmarkNeedleGet(uint32_t iteration, uint16_t *pPoints)
+*
+* Overview: Returns the 4 points of a meter needle, turning 10 degrees
+*           at each iteration.
+*
+********************************************************************/
+static void BenchmarkNeedleGet(uint32_t iteration, uint16_t *pPoints)
+{
+    int16_t  angle = (iteration * 10) % 360;
+    int16_t  cosine = GFX_SineCosineGet(angle, GFX_TRIG_COSINE_TYPE);
+    int16_t  sine = GFX_SineCosineGet(angle, GFX_TRIG_SINE_TYPE);
+    uint16_t x = GFX_MaxXGet() >> 1, y = GFX_MaxYGet() >> 1;
+
+    // tip, side, tail and side of the needle
+    pPoints[0] = x + ((cosine * BENCHMARK_NEEDLE_LENGTH) >> 8);
+    pPoints[1] = y - ((sine * BENCHMARK_NEEDLE_LENGTH) >> 8);
+    pPoints[2] = x - ((sine * BENCHMARK_NEEDLE_WIDTH) >> 8);
+    pPoints[3] = y - ((cosine * BENCHMARK_NEEDLE_WIDTH) >> 8);
+    pPoints[4] = x - ((cosine * BENCHMARK_NEEDLE_WIDTH) >> 8);
+    pPoints[5] = y + ((sine * BENCHMARK_NEEDLE_WIDTH) >> 8);
+    pPoints[6] = x + ((sine * BENCHMARK_NEEDLE_WIDTH) >> 8);
+    pPoints[7] = y + ((cosine * BENCHMARK_NEEDLE_WIDTH) >> 8);
+}
+
+static void BenchmarkNeedleLinesRun(uint32_t iteration)
+{
+    uint16_t points[8];
+    int16_t  i;
+
+    BenchmarkNeedleGet(iteration, points);
+    BenchmarkColorNext();
+
+    // the needle is filled with lines from the tip to the points of the tail
+    for(i = -BENCHMARK_NEEDLE_WIDTH; i <= BENCHMARK_NEEDLE_WIDTH; i++)
+    {
+        GFX_LineDraw(   points[0], points[1],
+                        points[4] + (((int16_t)points[6] - (int16_t)points[2]) * i) / (2 * BENCHMARK_NEEDLE_WIDTH),
+                        points[5] + (((int16_t)points[7] - (int16_t)points[3]) * i) / (2 * BENCHMARK_NEEDLE_WIDTH));
+    }
+}
+
+#ifdef GFX_CONFIG_POLYGON_FILL_POINTS
+static void BenchmarkNeedleFillRun(uint32_t iteration)
+{
+    uint16_t points[10];
+
+    // the first point is repeated to close the outline
+    BenchmarkNeedleGet(iteration, points);
+    points[8] = points[0];
+    points[9] = points[1];
+    BenchmarkColorNext();
+
+    GFX_PolygonFillDraw(4, points);
+}
+#endif
+
+#define BENCHMARK_DIAL_SIZE             ((BENCHMARK_NEEDLE_LENGTH + 8) * 2)
+
+/*********************************************************************
+* Function: void BenchmarkDialDraw(uint16_t left, uint16_t top)
+*
+* Overview: Draws the static part of a meter: face, rim and 36 ticks.
+*
+********************************************************************/
+static void BenchmarkDialDraw(uint16_t left, uint16_t top)
+{
+    uint16_t x = left + (BENCHMARK_DIAL_SIZE >> 1), y = top + (BENCHMARK_DIAL_SIZE >> 1);
+    int16_t  angle, cosine, sine;
+
+    GFX_FillStyleSet(GFX_FILL_STYLE_COLOR);
+    GFX_ColorSet(GFX_RGBConvert(0x20, 0x30, 0x40));
+    GFX_CircleFillDraw(x, y, BENCHMARK_NEEDLE_LENGTH + 6);
+
+    GFX_LineStyleSet(GFX_LINE_STYLE_THICK_SOLID);
+    GFX_ColorSet(GFX_RGBConvert(0xC0, 0xC0, 0xC0));
+    GFX_CircleDraw(x, y, BENCHMARK_NEEDLE_LENGTH + 6);
+
+    GFX_LineStyleSet(GFX_LINE_STYLE_THIN_SOLID);
+    for(angle = 0; angle < 360; angle += 10)
+    {
+        cosine = GFX_SineCosineGet(angle, GFX_TRIG_COSINE_TYPE);
+        sine = GFX_SineCosineGet(angle, GFX_TRIG_SINE_TYPE);
+        GFX_LineDraw(   x + ((cosine * (BENCHMARK_NEEDLE_LENGTH - 8)) >> 8),
+                        y - ((sine * (BENCHMARK_NEEDLE_LENGTH - 8)) >> 8),
+                        x + ((cosine * BENCHMARK_NEEDLE_LENGTH) >> 8),
+                        y - ((sine * BENCHMARK_NEEDLE_LENGTH) >> 8));
+    }
+}
+
+static void BenchmarkDialRun(uint32_t iteration)
+{
+    // the dial is drawn again under the needle on every update
+    BenchmarkDialDraw(  (GFX_MaxXGet() - BENCHMARK_DIAL_SIZE + 1) >> 1,
+                        (GFX_MaxYGet() - BENCHMARK_DIAL_SIZE + 1) >> 1);
+    BenchmarkNeedleLinesRun(iteration);
+}
+
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+static GFX_COLOR    benchmarkDialPixels[BENCHMARK_DIAL_SIZE * BENCHMARK_DIAL_SIZE];
+static GFX_SURFACE  benchmarkDial;
+
+static void BenchmarkDialSurfaceSetup(void)
+{
+    // the dial is rendered once, off-screen
+    GFX_SurfaceCreate(&benchmarkDial, benchmarkDialPixels, BENCHMARK_DIAL_SIZE, BENCHMARK_DIAL_SIZE);
+    GFX_SurfaceSet(&benchmarkDial);
+    GFX_ColorSet(GFX_RGBConvert(0x10, 0x10, 0x10));
+    GFX_ScreenClear();
+    BenchmarkDialDraw(0, 0);
+    GFX_SurfaceSet(NULL);
+
+    GFX_LineStyleSet(GFX_LINE_STYLE_THIN_SOLID);
+}
+
+static void BenchmarkDialSurfaceRun(uint32_t iteration)
+{
+    GFX_SurfaceDraw(    (GFX_MaxXGet() - BENCHMARK_DIAL_SIZE + 1) >> 1,
+                        (GFX_MaxYGet() - BENCHMARK_DIAL_SIZE + 1) >> 1,
+                        &benchmarkDial);
+    BenchmarkNeedleLinesRun(iteration);
+}
+
+static void BenchmarkDialKeyedSetup(void)
+{
+    BenchmarkDialSurfaceSetup();
+
+    // the corners of the dial keep the content of the screen
+    GFX_TransparentColorEnable(GFX_RGBConvert(0x10, 0x10, 0x10));
+}
+
+static void BenchmarkDialAlphaSetup(void)
+{
+    BenchmarkDialSurfaceSetup();
+
+    GFX_FillStyleSet(GFX_FILL_STYLE_ALPHA_COLOR);
+    GFX_AlphaBlendingValueSet(50);
+}
+
+static void BenchmarkDialBlitRun(uint32_t iteration)
+{
+    // dials at random positions, partly off the screen
+    GFX_SurfaceDraw(    BenchmarkRandomGet(GFX_MaxXGet() - (BENCHMARK_DIAL_SIZE >> 1)),
+                        BenchmarkRandomGet(GFX_MaxYGet() - (BENCHMARK_DIAL_SIZE >> 1)),
+                        &benchmarkDial);
+}
+#endif
+
+static bool BenchmarkDrawCallback(void)
+{
+    return (true);
+}
+
+/*********************************************************************
+* Function: void BenchmarkScreenSetup(void)
+*
+* Overview: Creates a screen with the common GOL objects.
+*
+********************************************************************/
+static void BenchmarkScreenSetup(void)
+{
+    uint16_t i, left, width = (GFX_MaxXGet() - 10) / 3;
+
+    GFX_GOL_ObjectListFree();
+    GFX_GOL_DrawCallbackSet(BenchmarkDrawCallback);
+
+    GFX_GOL_WindowCreate(   1, 0, 0, GFX_MaxXGet(), GFX_MaxYGet(),
+                            GFX_GOL_WINDOW_DRAW_STATE, NULL,
+                            (GFX_XCHAR *)"Benchmark", GFX_ALIGN_LEFT, &benchmarkScheme);
+
+    for(i = 0; i < 3; i++)
+    {
+        left = 10 + (i * width);
+        GFX_GOL_ButtonCreate(   10 + i, left, 40, left + width - 10, 80, 10,
+                                GFX_GOL_BUTTON_DRAW_STATE, NULL, NULL,
+                                (GFX_XCHAR *)"Button", GFX_ALIGN_CENTER, &benchmarkScheme);
+        GFX_GOL_CheckBoxCreate( 20 + i, left, 90, left + width - 10, 115,
+                                GFX_GOL_CHECKBOX_DRAW_STATE,
+                                (GFX_XCHAR *)"Check", GFX_ALIGN_LEFT | GFX_ALIGN_VCENTER, &benchmarkScheme);
+    }
+
+    GFX_GOL_StaticTextCreate(   30, 10, 125, GFX_MaxXGet() - 10, 150,
+                                GFX_GOL_STATICTEXT_DRAW_STATE | GFX_GOL_STATICTEXT_FRAME_STATE,
+                                (GFX_XCHAR *)"Static text in a frame", GFX_ALIGN_LEFT, &benchmarkScheme);
+    GFX_GOL_ProgressBarCreate(  31, 10, 160, GFX_MaxXGet() - 10, 185,
+                                GFX_GOL_PROGRESSBAR_DRAW_STATE, 60, 100, &benchmarkScheme);
+    GFX_GOL_ScrollBarCreate(    32, 10, 195, GFX_MaxXGet() - 10, 220,
+                                GFX_GOL_SCROLLBAR_DRAW_STATE | GFX_GOL_SCROLLBAR_SLIDER_MODE_STATE,
+                                100, 10, 30, &benchmarkScheme);
+}
+
+static void BenchmarkScreenRun(uint32_t iteration)
+{
+    GFX_GOL_ObjectRectangleRedraw(0, 0, GFX_MaxXGet(), GFX_MaxYGet());
+
+    while(GFX_GOL_ObjectListDraw() != GFX_STATUS_SUCCESS);
+}
+
+static void BenchmarkAreaSetup(void)
+{
+    BenchmarkScreenSetup();
+
+    while(GFX_GOL_ObjectListDraw() != GFX_STATUS_SUCCESS);
+}
+
+static void BenchmarkAreaRun(uint32_t iteration)
+{
+    uint16_t left = 20 + (iteration % 16) * 8;
+
+    // a text cursor blinking in the static text
+    GFX_GOL_ObjectRectangleRedraw(left, 130, left + 1, 145);
+
+    while(GFX_GOL_ObjectListDraw() != GFX_STATUS_SUCCESS);
+}
+
+static const BENCHMARK_CASE benchmarkCases[] =
+{
+    { "line_thin_solid",            BenchmarkThinSolidSetup,        BenchmarkLineRun },
+    { "line_thin_solid_horver",     BenchmarkThinSolidSetup,        BenchmarkLineHorVerRun },
+    { "line_thick_solid",           BenchmarkThickSolidSetup,       BenchmarkLineRun },
+    { "line_thin_dashed",           BenchmarkThinDashedSetup,       BenchmarkLineRun },
+    { "line_thick_dotted",          BenchmarkThickDottedSetup,      BenchmarkLineRun },
+    { "line_antialiased",           BenchmarkAntiAliasedSetup,      BenchmarkLineRun },
+    { "line_thick_antialiased",     BenchmarkThickAntiAliasedSetup, BenchmarkLineRun },
+    { "circle_thin_solid",          BenchmarkThinSolidSetup,        BenchmarkCircleRun },
+    { "circle_thick_solid",         BenchmarkThickSolidSetup,       BenchmarkCircleRun },
+    { "circle_antialiased",         BenchmarkAntiAliasedSetup,      BenchmarkCircleRun },
+    { "circle_thick_antialiased",   BenchmarkThickAntiAliasedSetup, BenchmarkCircleRun },
+    { "bar_solid",                  BenchmarkSolidSetup,            BenchmarkBarRun },
+    { "bar_alpha",                  BenchmarkAlphaSetup,            BenchmarkBarRun },
+    { "bar_alpha_fade",             BenchmarkAlphaFadeSetup,        BenchmarkAlphaFadeRun },
+    { "bar_gradient",               BenchmarkGradientSetup,         BenchmarkBarRun },
+    { "bar_gradient_double",        BenchmarkGradientDoubleSetup,   BenchmarkBarRun },
+    { "bar_gradient_right",         BenchmarkGradientRightSetup,    BenchmarkBarRun },
+    { "round_rect_solid",           BenchmarkSolidSetup,            BenchmarkRoundRun },
+    { "round_rect_gradient",        BenchmarkGradientSetup,         BenchmarkRoundRun },
+    { "round_rect_gradient_right",  BenchmarkGradientRightSetup,    BenchmarkRoundRun },
+    { "text_1bpp",                  BenchmarkText1BPPSetup,         BenchmarkTextRun },
+    { "text_1bpp_external",         BenchmarkTextExternalSetup,     BenchmarkTextRun },
+    { "text_aa_opaque",             BenchmarkTextOpaqueSetup,       BenchmarkTextRun },
+    { "text_aa_translucent",        BenchmarkTextTranslucentSetup,  BenchmarkTextRun },
+    { "text_meter_external",        BenchmarkTextMeterSetup,        BenchmarkTextMeterRun },
+    { "text_width_flash",           BenchmarkText1BPPSetup,         BenchmarkTextWidthRun },
+    { "text_width_external",        BenchmarkTextExternalSetup,     BenchmarkTextWidthRun },
+    { "image_flash_1bpp",           BenchmarkFlash1BPPSetup,        BenchmarkImageRun },
+    { "image_flash_4bpp",           BenchmarkFlash4BPPSetup,        BenchmarkImageRun },
+    { "image_flash_8bpp",           BenchmarkFlash8BPPSetup,        BenchmarkImageRun },
+    { "image_flash_16bpp",          BenchmarkFlash16BPPSetup,       BenchmarkImageRun },
+    { "image_flash_rle4",           BenchmarkFlashRLE4Setup,        BenchmarkImageRun },
+    { "image_flash_rle8",           BenchmarkFlashRLE8Setup,        BenchmarkImageRun },
+    { "image_flash_rle8_partial",   BenchmarkFlashRLE8Setup,        BenchmarkImagePartialRun },
+    { "image_external_1bpp",        BenchmarkExternal1BPPSetup,     BenchmarkImageRun },
+    { "image_external_4bpp",        BenchmarkExternal4BPPSetup,     BenchmarkImageRun },
+    { "image_external_8bpp",        BenchmarkExternal8BPPSetup,     BenchmarkImageRun },
+    { "image_external_16bpp",       BenchmarkExternal16BPPSetup,    BenchmarkImageRun },
+    { "image_external_rle4",        BenchmarkExternalRLE4Setup,     BenchmarkImageRun },
+    { "image_external_rle8",        BenchmarkExternalRLE8Setup,     BenchmarkImageRun },
+    { "image_flash_rle4_scroll",    BenchmarkFlashRLE4Setup,        BenchmarkImageScrollRun },
+    { "image_external_rle4_scroll", BenchmarkExternalRLE4Setup,     BenchmarkImageScrollRun },
+    { "image_external_rle8_scroll", BenchmarkExternalRLE8Setup,     BenchmarkImageScrollRun },
+#ifndef GFX_CONFIG_IPU_DECODE_DISABLE
+    { "image_flash_ipu8",           BenchmarkFlashIPU8Setup,        BenchmarkImageRun },
+    { "image_flash_ipu16",          BenchmarkFlashIPU16Setup,       BenchmarkImageRun },
+    { "image_flash_ipu8_partial",   BenchmarkFlashIPU8Setup,        BenchmarkImagePartialRun },
+    { "image_external_ipu8",        BenchmarkExternalIPU8Setup,     BenchmarkImageRun },
+    { "image_external_ipu16",       BenchmarkExternalIPU16Setup,    BenchmarkImageRun },
+    { "image_external_ipu8_scroll", BenchmarkExternalIPU8Setup,     BenchmarkImageScrollRun },
+#endif
+#ifdef GFX_CONFIG_JPEG_DECODE_ENABLE
+    { "image_file_jpeg",            BenchmarkFileJpegSetup,         BenchmarkImageRun },
+    { "image_file_jpeg_half",       BenchmarkFileJpegHalfSetup,     BenchmarkImageRun },
+    { "image_file_jpeg_partial",    BenchmarkFileJpegSetup,         BenchmarkImagePartialRun },
+    { "image_file_jpeg_wide",       BenchmarkFileJpegWideSetup,     BenchmarkImageWideRun },
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+    { "image_file_jpeg_clip",       BenchmarkFileJpegWideSetup,     BenchmarkImageClipRun },
+#endif
+#endif
+#ifdef GFX_CONFIG_PNG_DECODE_ROW_SIZE
+    { "image_file_png",             BenchmarkFilePngSetup,          BenchmarkImageRun },
+    { "image_file_png_partial",     BenchmarkFilePngSetup,          BenchmarkImagePartialRun },
+    { "image_file_png_wide",        BenchmarkFilePngWideSetup,      BenchmarkImageWideRun },
+#ifdef GFX_CONFIG_CLIP_STACK_SIZE
+    { "image_file_png_clip",        BenchmarkFilePngWideSetup,      BenchmarkImageClipRun },
+#endif
+#endif
+    { "bar_alpha_image_flash_8bpp", BenchmarkAlphaFlash8BPPSetup,   BenchmarkAlphaImageRun },
+    { "bar_alpha_image_ext_8bpp",   BenchmarkAlphaExternal8BPPSetup, BenchmarkAlphaImageRun },
+    { "bar_alpha_image_ext_rle8",   BenchmarkAlphaExternalRLE8Setup, BenchmarkAlphaImageRun },
+    { "context_line_text",          BenchmarkContextSetup,          BenchmarkContextRun },
+    { "display_list_panel",         BenchmarkSolidSetup,            BenchmarkPanelRun },
+    { "display_list_pixels",        BenchmarkSolidSetup,            BenchmarkPanelPixelsRun },
+    { "needle_lines",               BenchmarkThinSolidSetup,        BenchmarkNeedleLinesRun },
+#ifdef GFX_CONFIG_POLYGON_FILL_POINTS
+    { "needle_polygon_fill",        BenchmarkSolidSetup,            BenchmarkNeedleFillRun },
+    { "needle_polygon_alpha",       BenchmarkAlphaSetup,            BenchmarkNeedleFillRun },
+    { "needle_polygon_gradient",    BenchmarkGradientSetup,         BenchmarkNeedleFillRun },
+#endif
+    { "dial_primitives",            BenchmarkThinSolidSetup,        BenchmarkDialRun },
+#ifdef GFX_CONFIG_SURFACE_ENABLE
+    { "dial_surface",               BenchmarkDialSurfaceSetup,      BenchmarkDialSurfaceRun },
+    { "dial_surface_keyed",         BenchmarkDialKeyedSetup,        BenchmarkDialBlitRun },
+    { "dial_surface_alpha",         BenchmarkDialAlphaSetup,        BenchmarkDialBlitRun },
+#endif
+    { "gol_screen_redraw",          BenchmarkScreenSetup,           BenchmarkScreenRun },
+    { "gol_area_redraw",            BenchmarkAreaSetup,             BenchmarkAreaRun },
+};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Benchmark Runner
+// *****************************************************************************
+// *****************************************************************************
+
+// number of calls of the fixed pass that renders the saved frame
+#define BENCHMARK_FRAME_CALLS       16
+
+static double BenchmarkTimeGet(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((double)now.tv_sec + ((double)now.tv_nsec * 1e-9));
+}
+
+/*********************************************************************
+* Function: void BenchmarkCaseStart(const BENCHMARK_CASE *pCase)
+*
+* Overview: Puts the library, the frame and the random numbers in the
+*           initial state and sets the case up.
+*
+********************************************************************/
+static void BenchmarkCaseStart(const BENCHMARK_CASE *pCase)
+{
+    GFX_Initialize();
+    GFX_ColorSet(GFX_RGBConvert(0x10, 0x10, 0x10));
+    GFX_ScreenClear();
+    randomSeed = 1;
+    pCase->pSetup();
+}
+
+/*********************************************************************
+* Function: void BenchmarkCaseRun(const BENCHMARK_CASE *pCase,
+*                                 double minimumTime,
+*                                 uint32_t minimumCalls,
+*                                 const char *pDirectory)
+*
+* Overview: Runs the case in batches until the minimum time has elapsed,
+*           or for the given number of calls when it is not 0, and
+*           prints one line of the report. The saved frame is rendered
+*           by a separate fixed pass.
+*
+********************************************************************/
+static void BenchmarkCaseRun(const BENCHMARK_CASE *pCase, double minimumTime, uint32_t minimumCalls, const char *pDirectory)
+{
+    DRV_GFX_FRAMEBUFFER_STATISTICS  *pStatistics = DRV_GFX_FramebufferStatisticsGet();
+    uint32_t                        calls = 0, batch, driverCalls, pixels;
+    double                          start, elapsed;
+    char                            fileName[256];
+
+    // every case starts from the same state and frame
+    BenchmarkCaseStart(pCase);
+
+    DRV_GFX_FramebufferStatisticsClear();
+    externalReads = 0;
+    start = BenchmarkTimeGet();
+    do
+    {
+        for(batch = 0; batch < 16; batch++, calls++)
+            pCase->pRun(calls);
+        elapsed = BenchmarkTimeGet() - start;
+    } while((minimumCalls != 0) ? (calls < minimumCalls) : (elapsed < minimumTime));
+
+    driverCalls =   pStatistics->pixelPut.calls + pStatistics->pixelGet.calls +
+                    pStatistics->pixelArrayPut.calls + pStatistics->pixelArrayGet.calls +
+                    pStatistics->barDraw.calls + pStatistics->screenClear.calls;
+    pixels =        pStatistics->pixelPut.pixels + pStatistics->pixelArrayPut.pixels +
+                    pStatistics->barDraw.pixels + pStatistics->screenClear.pixels;
+
+    printf("%-26s %10.0f %10.3f %12.1f %10.1f %10.1f %10.1f %10.1f\n",
+            pCase->name,
+            calls / elapsed,
+            pixels / elapsed / 1e6,
+            (double)pixels / calls,
+            (double)driverCalls / calls,
+            (double)pStatistics->pixelPut.calls / calls,
+            (double)pStatistics->pixelGet.calls / calls,
+            (double)externalReads / calls);
+
+    if(pDirectory != NULL)
+    {
+        // the frame of the timed run depends on its number of calls
+        BenchmarkCaseStart(pCase);
+        for(calls = 0; calls < BENCHMARK_FRAME_CALLS; calls++)
+            pCase->pRun(calls);
+
+        snprintf(fileName, sizeof(fileName), "%s/%s.ppm", pDirectory, pCase->name);
+        if(DRV_GFX_FramebufferPPMWrite(fileName) == false)
+            fprintf(stderr, "cannot write %s\n", fileName);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const char  *pDirectory = NULL, *pFilter = NULL;
+    double      minimumTime = 0.2;
+    uint32_t    minimumCalls = 0;
+    uint16_t    i;
+
+    for(i = 1; i < argc; i++)
+    {
+        if((strcmp(argv[i], "-t") == 0) && ((i + 1) < argc))
+            minimumTime = atof(argv[++i]) / 1000.0;
+        else if((strcmp(argv[i], "-n") == 0) && ((i + 1) < argc))
+            minimumCalls = strtoul(argv[++i], NULL, 10);
+        else if((strcmp(argv[i], "-p") == 0) && ((i + 1) < argc))
+            pDirectory = argv[++i];
+        else if(argv[i][0] != '-')
+            pFilter = argv[i];
+        else
+        {
+            fprintf(stderr, "usage: %s [-t milliseconds] [-n calls] [-p directory] [case name]\n", argv[0]);
+            return (EXIT_FAILURE);
+        }
+    }
+
+    DRV_GFX_Initialize();
+    BenchmarkResourcesCreate();
+
+    printf("%d x %d, %d bpp\n\n", GFX_MaxXGet() + 1, GFX_MaxYGet() + 1, GFX_CONFIG_COLOR_DEPTH);
+    printf("%-26s %10s %10s %12s %10s %10s %10s %10s\n",
+            "case", "calls/s", "Mpixels/s", "pixels/call", "drv/call", "put/call", "get/call", "ext/call");
+
+    for(i = 0; i < sizeof(benchmarkCases) / sizeof(benchmarkCases[0]); i++)
+    {
+        if((pFilter != NULL) && (strstr(benchmarkCases[i].name, pFilter) == NULL))
+            continue;
+
+        BenchmarkCaseRun(&benchmarkCases[i], minimumTime, minimumCalls, pDirectory);
+    }
+
+    return (EXIT_SUCCESS);
+}
@@ -0,0 +1,98 @@
+/*******************************************************************************
+ Graphics Library Benchmark - System Configuration
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    system_config.h
+
+  Summary:
+    Graphics Library configuration of the host benchmark.
+
+  Description:
+    This file configures the Graphics Library for the host benchmark. The
+    library renders into the RAM frame buffer display driver with its
+    statistics enabled, so every primitive can be measured in pixels and
+    driver calls. Features that are benchmarked (alpha blending, gradients,
+    anti-aliased fonts, RLE images, external resources) are left enabled.
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+Copyright (c) 2013 released Microchip Technology Inc.  All rights reserved.
+
+Microchip licenses to you the right to use, modify, copy and distribute
+Software only when embedded on a Microchip microcontroller or digital signal
+controller that is integrated into your product or third party product
+(pursuant to the sublicense terms in the accompanying license agreement).
+
+You should refer to the license agreement accompanying this Software for
+additional information regarding your rights and obligations.
+
+SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR PURPOSE.
+IN NO EVENT SHALL MICROCHIP OR ITS LICENSORS BE LIABLE OR OBLIGATED UNDER
+CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH OF WARRANTY, OR
+OTHER LEGAL EQUITABLE THEORY ANY DIRECT OR INDIRECT DAMAGES OR EXPENSES
+INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL, INDIRECT, PUNITIVE OR
+CONSEQUENTIAL DAMAGES, LOST PROFITS OR LOST DATA, COST OF PROCUREMENT OF
+SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
+(INCLUDING BUT NOT LIMITED TO ANY DEFENSE THEREOF), OR OTHER SIMILAR COSTS.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef _SYSTEM_CONFIG_H
+    #define _SYSTEM_CONFIG_H
+
+#include <stdlib.h>
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Host Compiler Adaptation
+// *****************************************************************************
+// *****************************************************************************
+// The program space qualifiers of XC16 have no meaning on the host,
+// constant resources are ordinary constant data.
+#define __prog__
+#define __pack_upper_byte
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Display Configuration
+// *****************************************************************************
+// *****************************************************************************
+#define GFX_USE_DISPLAY_CONTROLLER_FRAMEBUFFER
+#define GFX_CONFIG_FRAMEBUFFER_STATISTICS_ENABLE
+#define GFX_CONFIG_FRAMEBUFFER_PPM_ENABLE
+
+#define DISP_ORIENTATION                        0
+#define DISP_HOR_RESOLUTION                     320
+#define DISP_VER_RESOLUTION                     240
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Graphics Library Configuration
+// *****************************************************************************
+// *****************************************************************************
+#define GFX_CONFIG_COLOR_DEPTH                  16
+#define GFX_CONFIG_FONT_CHAR_SIZE               8
+#define GFX_EXTERNAL_FONT_RASTER_BUFFER_SIZE    64
+
+#define GFX_CONFIG_NONBLOCKING_DISABLE
+#define GFX_CONFIG_PALETTE_DISABLE
+#define GFX_CONFIG_PALETTE_EXTERNAL_DISABLE
+#define GFX_CONFIG_DOUBLE_BUFFERING_DISABLE
+#ifndef GFX_CONFIG_IPU_DECODE_WINDOW_SIZE
+#define GFX_CONFIG_IPU_DECODE_DISABLE
+#endif
+#define GFX_CONFIG_FONT_RAM_DISABLE
+#define GFX_CONFIG_IMAGE_RAM_DISABLE
+#define GFX_CONFIG_USE_KEYBOARD_DISABLE
+#define GFX_CONFIG_USE_TOUCHSCREEN_DISABLE
+
+#define GFX_malloc(size)                        malloc(size)
+#define GFX_free(pObj)                          free(pObj)
+
+#endif // _SYSTEM_CONFIG_H